@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+#include <string_view>
 #include <vector>
 #include "ExecutionSignal.hpp"
 #include "ExecutionOrder.hpp"
@@ -18,6 +20,20 @@ public:
         const QTrading::Risk::RiskTarget& target,
         const ExecutionSignal& signal,
         const TMarket& market) = 0;
+    /// @brief Replaces `out` with the engine's per-symbol pacing state, for strategy checkpoints;
+    ///        false (the default) when the engine cannot be checkpointed.
+    virtual bool save_state(std::string& out) const
+    {
+        (void)out;
+        return false;
+    }
+    /// @brief Restores state written by `save_state`; false (the default) when not supported.
+    ///        Throws std::runtime_error on malformed state.
+    virtual bool restore_state(std::string_view in)
+    {
+        (void)in;
+        return false;
+    }
 };
 
 /// @brief No-op execution engine returning no orders.
@@ -6,6 +6,8 @@
 #include "Risk/AccountState.hpp"
 
 #include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace QTrading::Execution {
@@ -20,6 +22,21 @@ public:
         const QTrading::Risk::AccountState& account,
         const ExecutionSignal& signal,
         const std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>& market) = 0;
+
+    /// @brief Replaces `out` with the per-symbol budget and batching state, for strategy
+    ///        checkpoints; false (the default) when the scheduler cannot be checkpointed.
+    virtual bool SaveState(std::string& out) const
+    {
+        (void)out;
+        return false;
+    }
+    /// @brief Restores state written by `SaveState`; false (the default) when not supported.
+    ///        Throws std::runtime_error on malformed state.
+    virtual bool RestoreState(std::string_view in)
+    {
+        (void)in;
+        return false;
+    }
 };
 
 /// @brief Default scheduler that forwards one full-size slice per parent order.
@@ -44,6 +61,13 @@ public:
         }
         return slices;
     }
+    /// @brief Stateless across bars, so the saved state is empty.
+    bool SaveState(std::string& out) const override
+    {
+        out.clear();
+        return true;
+    }
+    bool RestoreState(std::string_view in) override { return in.empty(); }
 };
 
 } // namespace QTrading::Execution
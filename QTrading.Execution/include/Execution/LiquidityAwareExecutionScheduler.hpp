@@ -68,8 +68,14 @@ public:
         const QTrading::Risk::AccountState& account,
         const ExecutionSignal& signal,
         const std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>& market) override;
+    /// @brief Per-symbol window budgets and batched increase targets.
+    bool SaveState(std::string& out) const override;
+    bool RestoreState(std::string_view in) override;
 
 private:
+    template <typename Io, typename Self>
+    static void TransferState(Io& io, Self& self);
+
     Config cfg_;
     std::unordered_map<std::string, std::size_t> symbol_to_id_;
     std::unordered_map<std::string, uint64_t> budget_window_key_by_symbol_;
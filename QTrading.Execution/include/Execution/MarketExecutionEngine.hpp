@@ -2,6 +2,8 @@
 
 #include <cstdint>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include "IExecutionEngine.hpp"
 #include "Exchanges/IExchange.h"
@@ -85,8 +87,14 @@ public:
         const QTrading::Risk::RiskTarget& target,
         const ExecutionSignal& signal,
         const std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>& market) override;
+    /// @brief Per-symbol rebalance cooldowns, daily counts, target anchors and window budgets.
+    bool save_state(std::string& out) const override;
+    bool restore_state(std::string_view in) override;
 
 private:
+    template <typename Io, typename Self>
+    static void TransferState(Io& io, Self& self);
+
     std::shared_ptr<QTrading::Infra::Exchanges::IExchange<
         std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>>> exchange_;
     Config cfg_;
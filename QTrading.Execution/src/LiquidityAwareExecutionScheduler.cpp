@@ -1,6 +1,7 @@
 #include "Execution/LiquidityAwareExecutionScheduler.hpp"
 
 #include "Contracts/StrategyIdentity.hpp"
+#include "Serialization/StateArchive.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -41,28 +42,28 @@ double ClosePriceFromId(
     const std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>& market,
     std::size_t id)
 {
-    if (!market || id >= market->trade_klines_by_id.size()) {
+    if (!market) {
         return 0.0;
     }
-    const auto& opt = market->trade_klines_by_id[id];
-    if (!opt.has_value()) {
+    const auto close = market->trade_close(id);
+    if (!close.has_value()) {
         return 0.0;
     }
-    return std::max(0.0, opt->ClosePrice);
+    return std::max(0.0, *close);
 }
 
 double QuoteVolumeFromId(
     const std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>& market,
     std::size_t id)
 {
-    if (!market || id >= market->trade_klines_by_id.size()) {
+    if (!market) {
         return 0.0;
     }
-    const auto& opt = market->trade_klines_by_id[id];
-    if (!opt.has_value()) {
+    const auto quote_volume = market->trade_quote_volume(id);
+    if (!quote_volume.has_value()) {
         return 0.0;
     }
-    return std::max(0.0, opt->QuoteVolume);
+    return std::max(0.0, *quote_volume);
 }
 
 bool IsCarryLikeStrategy(const QTrading::Execution::ExecutionSignal& signal)
@@ -189,7 +190,7 @@ std::vector<ExecutionSlice> LiquidityAwareExecutionScheduler::BuildSlices(
 
     if ((!apply_participation_cap && !apply_window_budget && !apply_increase_batching) ||
         !has_symbol_index_ ||
-        market->trade_klines_by_id.empty()) {
+        market->symbol_count() == 0) {
         for (const auto& parent : parent_orders) {
             slices.push_back(
                 ExecutionSlice{
@@ -470,4 +471,29 @@ std::vector<ExecutionSlice> LiquidityAwareExecutionScheduler::BuildSlices(
     return slices;
 }
 
+// The symbol index is rebuilt from the market and is not part of the state.
+template <typename Io, typename Self>
+void LiquidityAwareExecutionScheduler::TransferState(Io& io, Self& e)
+{
+    io(e.budget_window_key_by_symbol_, e.budget_consumed_notional_by_symbol_,
+        e.budget_cumulative_quote_volume_by_symbol_);
+    io(e.last_increase_batch_ts_by_symbol_, e.batched_target_notional_by_symbol_);
+}
+
+bool LiquidityAwareExecutionScheduler::SaveState(std::string& out) const
+{
+    out.clear();
+    QTrading::Utils::Serialization::StateWriter writer(out);
+    TransferState(writer, *this);
+    return true;
+}
+
+bool LiquidityAwareExecutionScheduler::RestoreState(std::string_view in)
+{
+    QTrading::Utils::Serialization::StateReader reader(in);
+    TransferState(reader, *this);
+    reader.finish();
+    return true;
+}
+
 } // namespace QTrading::Execution
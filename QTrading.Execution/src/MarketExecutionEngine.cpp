@@ -1,6 +1,7 @@
 #include "Execution/MarketExecutionEngine.hpp"
 
 #include "Contracts/StrategyIdentity.hpp"
+#include "Serialization/StateArchive.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -49,14 +50,14 @@ double QuoteVolumeFromId(
     const std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>& market,
     std::size_t id)
 {
-    if (!market || id >= market->trade_klines_by_id.size()) {
+    if (!market) {
         return 0.0;
     }
-    const auto& opt = market->trade_klines_by_id[id];
-    if (!opt.has_value()) {
+    const auto quote_volume = market->trade_quote_volume(id);
+    if (!quote_volume.has_value()) {
         return 0.0;
     }
-    return std::max(0.0, opt->QuoteVolume);
+    return std::max(0.0, *quote_volume);
 }
 
 QTrading::Contracts::StrategyKind ResolveStrategyKind(
@@ -361,12 +362,11 @@ std::vector<ExecutionOrder> MarketExecutionEngine::plan(
         has_open_order_by_symbol[ord.symbol] = true;
     }
 
-    if (has_symbol_index_ && !market->trade_klines_by_id.empty()) {
-        std::vector<double> price_by_id(market->trade_klines_by_id.size(), 0.0);
-        for (std::size_t i = 0; i < market->trade_klines_by_id.size(); ++i) {
-            const auto& opt = market->trade_klines_by_id[i];
-            if (opt.has_value()) {
-                price_by_id[i] = opt->ClosePrice;
+    if (has_symbol_index_ && market->symbol_count() != 0) {
+        std::vector<double> price_by_id(market->symbol_count(), 0.0);
+        for (std::size_t i = 0; i < price_by_id.size(); ++i) {
+            if (const auto close = market->trade_close(i)) {
+                price_by_id[i] = *close;
             }
         }
 
@@ -560,5 +560,30 @@ std::vector<ExecutionOrder> MarketExecutionEngine::plan(
     return orders;
 }
 
-} // namespace QTrading::Execution
+// The symbol index is rebuilt from the market and is not part of the state.
+template <typename Io, typename Self>
+void MarketExecutionEngine::TransferState(Io& io, Self& e)
+{
+    io(e.last_carry_order_ts_by_symbol_, e.carry_day_key_by_symbol_,
+        e.carry_rebalance_count_by_symbol_, e.carry_target_anchor_notional_by_symbol_);
+    io(e.carry_window_start_ts_by_symbol_, e.carry_window_cum_quote_volume_by_symbol_,
+        e.carry_window_used_notional_by_symbol_);
+}
+
+bool MarketExecutionEngine::save_state(std::string& out) const
+{
+    out.clear();
+    QTrading::Utils::Serialization::StateWriter writer(out);
+    TransferState(writer, *this);
+    return true;
+}
 
+bool MarketExecutionEngine::restore_state(std::string_view in)
+{
+    QTrading::Utils::Serialization::StateReader reader(in);
+    TransferState(reader, *this);
+    reader.finish();
+    return true;
+}
+
+} // namespace QTrading::Execution
@@ -3,6 +3,9 @@
 #include <gtest/gtest.h>
 
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 
 using MarketPtr = std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>;
 
@@ -357,6 +360,51 @@ TEST(LiquidityAwareExecutionSchedulerTests, IncreaseBatchingHoldsTargetWithinBat
     EXPECT_DOUBLE_EQ(s3[0].target_notional, 1200.0);
 }
 
+TEST(LiquidityAwareExecutionSchedulerTests, RestoredStateKeepsIncreaseBatchWindow)
+{
+    QTrading::Execution::LiquidityAwareExecutionScheduler::Config cfg;
+    cfg.carry_increase_batching_enabled = true;
+    cfg.carry_increase_batch_ms = 1000;
+    cfg.carry_apply_only_low_urgency = true;
+
+    QTrading::Execution::LiquidityAwareExecutionScheduler scheduler(cfg);
+    std::vector<QTrading::Execution::ExecutionParentOrder> parent_orders = {
+        QTrading::Execution::ExecutionParentOrder{
+            1,
+            "BTCUSDT_PERP",
+            1000.0,
+            2.0,
+        },
+    };
+    QTrading::Risk::AccountState account;
+    QTrading::Execution::ExecutionSignal signal;
+    signal.strategy = "funding_carry";
+    signal.urgency = QTrading::Execution::ExecutionUrgency::Low;
+
+    (void)scheduler.BuildSlices(
+        parent_orders,
+        account,
+        signal,
+        MakeMarketWithSymbol(100, "BTCUSDT_PERP", 10'000.0, 1000.0));
+
+    std::string state;
+    ASSERT_TRUE(scheduler.SaveState(state));
+    QTrading::Execution::LiquidityAwareExecutionScheduler restored(cfg);
+    ASSERT_TRUE(restored.RestoreState(state));
+
+    // The restored batch window still holds the increase back.
+    parent_orders[0].target_notional = 1200.0;
+    const auto held = restored.BuildSlices(
+        parent_orders,
+        account,
+        signal,
+        MakeMarketWithSymbol(200, "BTCUSDT_PERP", 10'000.0, 1000.0));
+    ASSERT_EQ(held.size(), 1u);
+    EXPECT_DOUBLE_EQ(held[0].target_notional, 1000.0);
+
+    EXPECT_THROW(restored.RestoreState(std::string_view(state).substr(0, state.size() - 1)), std::runtime_error);
+}
+
 TEST(LiquidityAwareExecutionSchedulerTests, IncreaseBatchingDoesNotDelayTargetReduction)
 {
     QTrading::Execution::LiquidityAwareExecutionScheduler::Config cfg;
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Dto/Market/Binance/FundingRate.hpp"
+#include "Dto/Market/Binance/TradeKline.hpp"
+
+namespace QTrading::Infra::Data::Binance {
+
+/// @brief Environment variable selecting the binary cache directory.
+/// @details Caching is disabled when the variable is unset or empty.
+inline constexpr const char* kBinaryCacheDirEnv = "QTR_DATA_CACHE_DIR";
+
+/// @brief On-disk format version; bump whenever the layout changes.
+inline constexpr uint32_t kBinaryCacheFormatVersion = 1;
+
+/// @brief Stream layout stored in one cache file.
+enum class CacheStreamKind : uint32_t {
+    TradeKline = 1,
+    FundingRate = 2,
+};
+
+/// @brief Residency hint for a byte range inside a mapped cache file.
+enum class MappedRangeAdvice : uint8_t {
+    /// Start reading the pages in ahead of use.
+    WillNeed = 0,
+    /// Drop the pages from this process' resident set; they refault from the file if touched.
+    Release = 1,
+};
+
+/// @brief Column order of a `CacheStreamKind::TradeKline` cache file.
+enum class KlineCacheColumn : size_t {
+    OpenTime = 0,           ///< uint64_t
+    Open,                   ///< double
+    High,                   ///< double
+    Low,                    ///< double
+    Close,                  ///< double
+    Volume,                 ///< double
+    CloseTime,              ///< uint64_t
+    QuoteVolume,            ///< double
+    TradeCount,             ///< int32_t
+    TakerBuyBaseVolume,     ///< double
+    TakerBuyQuoteVolume,    ///< double
+    Count
+};
+
+/// @brief Heap-owned kline columns, one vector per `KlineCacheColumn`.
+struct KlineColumnBuffers {
+    std::vector<uint64_t> open_time;
+    std::vector<double> open;
+    std::vector<double> high;
+    std::vector<double> low;
+    std::vector<double> close;
+    std::vector<double> volume;
+    std::vector<uint64_t> close_time;
+    std::vector<double> quote_volume;
+    std::vector<int32_t> trade_count;
+    std::vector<double> taker_buy_base;
+    std::vector<double> taker_buy_quote;
+
+    size_t size() const noexcept { return open_time.size(); }
+};
+
+/// @brief Column order of a `CacheStreamKind::FundingRate` cache file.
+enum class FundingCacheColumn : size_t {
+    FundingTime = 0,        ///< uint64_t
+    Rate,                   ///< double
+    MarkPrice,              ///< double (0 when absent)
+    HasMarkPrice,           ///< uint8_t
+    Count
+};
+
+/// @brief Identity of a CSV source; a cache file is valid only for an exact match.
+struct CacheSourceStamp {
+    /// Absolute source path in generic form.
+    std::string source_path;
+    /// Source size in bytes.
+    uint64_t source_bytes{ 0 };
+    /// Source last-write time in native file-clock ticks.
+    int64_t source_mtime{ 0 };
+};
+
+/// @brief Read-only memory-mapped view of one validated cache file.
+/// @details Columns are contiguous, 64-byte aligned arrays of `row_count()` elements.
+class MappedCacheFile {
+public:
+    ~MappedCacheFile();
+
+    MappedCacheFile(const MappedCacheFile&) = delete;
+    MappedCacheFile& operator=(const MappedCacheFile&) = delete;
+
+    /// @brief Maps `cache_file` and validates it against `expected` and `kind`.
+    /// @return nullptr when the file is missing, stale, truncated, or of another version.
+    static std::shared_ptr<const MappedCacheFile> Open(
+        const std::filesystem::path& cache_file,
+        const CacheSourceStamp& expected,
+        CacheStreamKind kind);
+
+    /// @brief Number of rows stored in every column.
+    size_t row_count() const noexcept { return row_count_; }
+
+    /// @brief Typed view over one column; `T` must match the column element type.
+    template <typename T>
+    std::span<const T> column(size_t index) const noexcept
+    {
+        if (index >= column_offsets_.size()) {
+            return {};
+        }
+        return std::span<const T>(
+            reinterpret_cast<const T*>(base_ + column_offsets_[index]),
+            row_count_);
+    }
+
+private:
+    struct Mapping;
+
+    MappedCacheFile() = default;
+
+    std::unique_ptr<Mapping> mapping_;
+    const std::byte* base_{ nullptr };
+    size_t row_count_{ 0 };
+    std::vector<uint64_t> column_offsets_;
+};
+
+/// @brief Applies a page-granular residency hint to `[data, data + bytes)` of a mapping.
+/// @details WillNeed rounds the range outward; Release rounds it inward so bytes
+///          outside the range stay resident. Best-effort; no-op where unsupported.
+void AdviseMappedRange(const void* data, size_t bytes, MappedRangeAdvice advice) noexcept;
+
+/// @brief Resolves the cache directory from `QTR_DATA_CACHE_DIR`.
+/// @return std::nullopt when caching is disabled.
+std::optional<std::filesystem::path> ResolveCacheDirectory();
+
+/// @brief Builds the freshness stamp of a source file.
+/// @return std::nullopt when the source cannot be stat'ed.
+std::optional<CacheSourceStamp> StampSource(const std::filesystem::path& source);
+
+/// @brief Cache file location for one source/stream; stable across runs and processes.
+std::filesystem::path CacheFilePath(
+    const std::filesystem::path& cache_dir,
+    const std::filesystem::path& source,
+    const CacheSourceStamp& stamp,
+    CacheStreamKind kind);
+
+/// @brief Writes a kline cache file atomically (temp file + rename).
+/// @return False on any IO failure; callers treat caching as best-effort.
+bool WriteKlineCache(
+    const std::filesystem::path& cache_file,
+    const CacheSourceStamp& stamp,
+    const KlineColumnBuffers& columns);
+
+/// @brief Writes a funding cache file atomically (temp file + rename).
+/// @return False on any IO failure; callers treat caching as best-effort.
+bool WriteFundingCache(
+    const std::filesystem::path& cache_file,
+    const CacheSourceStamp& stamp,
+    const std::vector<QTrading::Dto::Market::Binance::FundingRateDto>& rates);
+
+} // namespace QTrading::Infra::Data::Binance
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Data/Binance/BinaryCache.hpp"
+
+namespace QTrading::Infra::Data::Binance {
+
+/// @brief Sparse open-time → byte-offset index of one CSV file.
+/// @details One entry every `kCsvSeekIndexStride` data rows. Only usable for seeking
+///          when the file is chronologically ordered (`monotonic`).
+struct CsvSeekIndex {
+    CacheSourceStamp stamp;
+    /// True when open times never decrease in file order.
+    bool monotonic{ false };
+    /// Byte offset of the first parseable data row.
+    uint64_t data_offset{ 0 };
+    /// Open time of every indexed row, ascending when `monotonic`.
+    std::vector<uint64_t> timestamps;
+    /// Byte offset of every indexed row.
+    std::vector<uint64_t> offsets;
+
+    /// @brief Offset of the last indexed row with open time < `ts` (or the first data row).
+    /// @details Rows before that offset all have open time < `ts`.
+    uint64_t seek_offset(uint64_t ts) const noexcept;
+};
+
+/// @brief Rows between index entries.
+inline constexpr size_t kCsvSeekIndexStride = 1024;
+
+/// @brief Incrementally records index entries while a CSV is read front to back.
+class CsvSeekIndexBuilder {
+public:
+    explicit CsvSeekIndexBuilder(CacheSourceStamp stamp);
+
+    /// @brief Reports one data row in file order.
+    void add_row(uint64_t open_time, uint64_t offset)
+    {
+        if (has_last_ && open_time < last_ts_) {
+            index_->monotonic = false;
+        }
+        last_ts_ = open_time;
+        has_last_ = true;
+        if (rows_++ % kCsvSeekIndexStride == 0) {
+            if (index_->timestamps.empty()) {
+                index_->data_offset = offset;
+            }
+            index_->timestamps.push_back(open_time);
+            index_->offsets.push_back(offset);
+        }
+    }
+
+    /// @brief Completes the index; the builder is empty afterwards.
+    std::shared_ptr<const CsvSeekIndex> finish();
+
+private:
+    std::shared_ptr<CsvSeekIndex> index_;
+    uint64_t last_ts_{ 0 };
+    bool has_last_{ false };
+    size_t rows_{ 0 };
+};
+
+/// @brief Process-wide index lookup; returns nullptr unless `stamp` matches exactly.
+std::shared_ptr<const CsvSeekIndex> FindCsvSeekIndex(const CacheSourceStamp& stamp);
+
+/// @brief Publishes an index for later loads of the same source in this process.
+void StoreCsvSeekIndex(std::shared_ptr<const CsvSeekIndex> index);
+
+} // namespace QTrading::Infra::Data::Binance
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+
+#include "Data/Binance/BinaryCache.hpp"
+#include "Data/Binance/CsvSeekIndex.hpp"
+
+namespace QTrading::Infra::Data::Binance {
+
+/// @brief Delimiter-scan kernel of the bulk kline CSV parser, ordered by width.
+enum class CsvScanKernel : uint8_t {
+    /// Widest kernel this CPU supports.
+    Auto = 0,
+    Scalar = 1,
+    Sse2 = 2,
+    Avx2 = 3,
+};
+
+/// @brief Widest kernel supported by the running CPU (never `Auto`).
+CsvScanKernel DetectCsvScanKernel() noexcept;
+
+/// @brief Row selection and instrumentation for one bulk parse.
+struct KlineCsvParseOptions {
+    /// Byte offset to start from. 0 reads from the stream start and skips the header line;
+    /// any other value seeks there and treats every line as data.
+    uint64_t start_offset{ 0 };
+    /// Rows with an earlier open time are skipped after parsing only the open time.
+    std::optional<uint64_t> window_start;
+    /// Rows with a later open time are skipped after parsing only the open time.
+    std::optional<uint64_t> window_end;
+    /// Stop at the first row past `window_end`; only valid for chronologically ordered input.
+    bool stop_past_window{ false };
+    /// Receives every row with a parseable open time, in file order.
+    CsvSeekIndexBuilder* index_builder{ nullptr };
+    /// Requested kernel; clamped to what the CPU supports.
+    CsvScanKernel kernel{ CsvScanKernel::Auto };
+    /// Rows to reserve up front in every column.
+    size_t reserve_rows{ 0 };
+    /// Bytes read from the stream per block.
+    size_t block_bytes{ size_t{ 1 } << 20 };
+};
+
+/// @brief Columns and ordering facts produced by `ParseKlineCsv`.
+struct KlineCsvParseResult {
+    KlineColumnBuffers columns;
+    /// False when the stream had no header line (empty input).
+    bool header_read{ false };
+    /// True when kept rows are already in non-decreasing open-time order.
+    bool monotonic{ true };
+    /// Kernel that actually ran.
+    CsvScanKernel kernel{ CsvScanKernel::Scalar };
+};
+
+/// @brief Parses a Binance kline CSV block-wise straight into columns.
+/// @details Accepts the 11-column layout
+///          (openTime,open,high,low,close,volume,closeTime,quoteVolume,trades,takerBuyBaseVol,takerBuyQuoteVol)
+///          and the compact 6-column layout (openTime,open,high,low,close,closeTime).
+///          Lines with too few fields or unparseable numbers are skipped; a trailing
+///          '\r' is ignored. Open `in` in binary mode so offsets match the file.
+KlineCsvParseResult ParseKlineCsv(std::istream& in, const KlineCsvParseOptions& options);
+
+} // namespace QTrading::Infra::Data::Binance
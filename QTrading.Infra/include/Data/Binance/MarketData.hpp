@@ -1,14 +1,25 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
 #include <string>
-#include <vector>
 #include "Dto/Market/Binance/Kline.hpp"
 
+namespace QTrading::Infra::Data::Binance {
+enum class MappedRangeAdvice : uint8_t;
+}
+
 /// @brief Provides historical Kline data loaded from a CSV file.
-/// 
+///
 /// This class loads 1-minute TradeKlineDto entries for a given symbol from a CSV,
 /// stores them in chronological order, and offers random access and iteration.
+/// Bars are held column-wise (SoA). When the binary cache is enabled the columns
+/// are spans over the memory-mapped cache file, so the page cache is shared by
+/// every process replaying the same dataset; otherwise they are owned vectors.
+/// Copies share the underlying storage.
 class MarketData {
 public:
     /// @brief Construct MarketData for a symbol from a CSV file.
@@ -17,17 +28,18 @@ public:
     MarketData(const std::string& symbol, const std::string& csv_file);
 
     /// @brief Get the latest (most recent) Kline entry.
-    /// @return Const reference to the last TradeKlineDto in the loaded data.
-    const QTrading::Dto::Market::Binance::TradeKlineDto& get_latest_kline() const;
+    /// @return Row view materialized from the last bar.
+    /// @throw std::out_of_range if no data is loaded.
+    QTrading::Dto::Market::Binance::TradeKlineDto get_latest_kline() const;
 
     /// @brief Get the Kline at a specific index.
-    /// @param index Zero-based index into the time-ordered Kline vector.
-    /// @return Const reference to the TradeKlineDto at the given index.
+    /// @param index Zero-based index into the time-ordered columns.
+    /// @return Row view materialized from the columns at `index`.
     /// @throw std::out_of_range if index ≥ total count.
-    const QTrading::Dto::Market::Binance::TradeKlineDto& get_kline(size_t index) const;
+    QTrading::Dto::Market::Binance::TradeKlineDto get_kline(size_t index) const;
 
     /// @brief Get the total number of Kline entries loaded.
-    /// @return Size of the internal Kline vector.
+    /// @return Number of rows in every column.
     size_t get_klines_count() const;
 
     /// @brief Lower bound index for a timestamp (first index with Timestamp >= ts).
@@ -36,18 +48,89 @@ public:
     /// @brief Upper bound index for a timestamp (first index with Timestamp > ts).
     size_t upper_bound_ts(uint64_t ts) const;
 
-    /// @brief Iterator over mutable TradeKlineDto entries.
-    using iterator = std::vector<QTrading::Dto::Market::Binance::TradeKlineDto>::iterator;
-    /// @brief Iterator over const TradeKlineDto entries.
-    using const_iterator = std::vector<QTrading::Dto::Market::Binance::TradeKlineDto>::const_iterator;
+    /// @name Column accessors
+    /// @brief Contiguous, chronologically ordered columns of `get_klines_count()` elements.
+    /// @{
+    std::span<const uint64_t> timestamps() const noexcept { return open_time_; }
+    std::span<const double> open_prices() const noexcept { return open_; }
+    std::span<const double> high_prices() const noexcept { return high_; }
+    std::span<const double> low_prices() const noexcept { return low_; }
+    std::span<const double> close_prices() const noexcept { return close_; }
+    std::span<const double> volumes() const noexcept { return volume_; }
+    std::span<const uint64_t> close_times() const noexcept { return close_time_; }
+    std::span<const double> quote_volumes() const noexcept { return quote_volume_; }
+    std::span<const int32_t> trade_counts() const noexcept { return trade_count_; }
+    std::span<const double> taker_buy_base_volumes() const noexcept { return taker_buy_base_; }
+    std::span<const double> taker_buy_quote_volumes() const noexcept { return taker_buy_quote_; }
+    /// @}
+
+    /// @brief True when the columns are backed by a memory-mapped cache file.
+    bool is_memory_mapped() const noexcept { return memory_mapped_; }
+
+    /// @brief Applies a residency hint to rows `[first, last)` of every retained column.
+    /// @details No-op unless memory-mapped; used by replay read-ahead.
+    void advise_rows(size_t first, size_t last, QTrading::Infra::Data::Binance::MappedRangeAdvice advice) const noexcept;
+
+    /// @brief Bytes per row across the retained columns.
+    size_t row_bytes() const noexcept;
+
+    /// @brief Keep-alive handle for the column storage; lets derived views share it.
+    const std::shared_ptr<const void>& storage() const noexcept { return storage_; }
+
+    /// @brief Random-access iterator yielding row views over the columns.
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = QTrading::Dto::Market::Binance::TradeKlineDto;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+
+        /// @brief Holds a materialized row so `it->Field` works on a proxy iterator.
+        struct pointer {
+            value_type row;
+            const value_type* operator->() const noexcept { return &row; }
+        };
+
+        const_iterator() = default;
+        const_iterator(const MarketData* owner, size_t index) noexcept : owner_(owner), index_(index) {}
+
+        reference operator*() const { return owner_->row_at(index_); }
+        pointer operator->() const { return pointer{ owner_->row_at(index_) }; }
+        reference operator[](difference_type n) const { return owner_->row_at(index_ + n); }
+
+        const_iterator& operator++() noexcept { ++index_; return *this; }
+        const_iterator operator++(int) noexcept { auto tmp = *this; ++index_; return tmp; }
+        const_iterator& operator--() noexcept { --index_; return *this; }
+        const_iterator operator--(int) noexcept { auto tmp = *this; --index_; return tmp; }
+        const_iterator& operator+=(difference_type n) noexcept { index_ += n; return *this; }
+        const_iterator& operator-=(difference_type n) noexcept { index_ -= n; return *this; }
+        friend const_iterator operator+(const_iterator it, difference_type n) noexcept { return it += n; }
+        friend const_iterator operator+(difference_type n, const_iterator it) noexcept { return it += n; }
+        friend const_iterator operator-(const_iterator it, difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const const_iterator& a, const const_iterator& b) noexcept
+        {
+            return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+        }
+        friend bool operator==(const const_iterator& a, const const_iterator& b) noexcept
+        {
+            return a.owner_ == b.owner_ && a.index_ == b.index_;
+        }
+        friend auto operator<=>(const const_iterator& a, const const_iterator& b) noexcept
+        {
+            return a.index_ <=> b.index_;
+        }
+
+    private:
+        const MarketData* owner_{ nullptr };
+        size_t index_{ 0 };
+    };
+
+    /// @brief Bars are read-only (possibly memory-mapped); both iterator kinds yield row views.
+    using iterator = const_iterator;
 
     /// @brief Get iterator to first Kline.
-    iterator begin();
-    /// @brief Get iterator one past last Kline.
-    iterator end();
-    /// @brief Get const iterator to first Kline.
     const_iterator begin() const;
-    /// @brief Get const iterator one past last Kline.
+    /// @brief Get iterator one past last Kline.
     const_iterator end() const;
     /// @brief Get const iterator to first Kline.
     const_iterator cbegin() const;
@@ -56,9 +139,28 @@ public:
 
 private:
     std::string symbol;         ///< Trading symbol
-    std::vector<QTrading::Dto::Market::Binance::TradeKlineDto> klines;///< In-memory bar storage
+    std::shared_ptr<const void> storage_;   ///< Keeps the mapped file or owned columns alive
+    bool memory_mapped_{ false };
+
+    std::span<const uint64_t> open_time_;
+    std::span<const double> open_;
+    std::span<const double> high_;
+    std::span<const double> low_;
+    std::span<const double> close_;
+    std::span<const double> volume_;
+    std::span<const uint64_t> close_time_;
+    std::span<const double> quote_volume_;
+    std::span<const int32_t> trade_count_;
+    std::span<const double> taker_buy_base_;
+    std::span<const double> taker_buy_quote_;
 
-    /// @brief Load and parse the CSV file into `klines`.
+    /// @brief Load and parse the CSV file (or its binary cache) into the columns.
     /// @param csv_file Path to the CSV file.
     void load_csv(const std::string& csv_file);
+
+    /// @brief Builds a row view without bounds checking.
+    QTrading::Dto::Market::Binance::TradeKlineDto row_at(size_t index) const;
+
+    /// @brief Narrows every column to `[first, last)`; used for replay windows.
+    void narrow_rows(size_t first, size_t last);
 };
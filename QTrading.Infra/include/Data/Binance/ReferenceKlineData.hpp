@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include "Dto/Market/Binance/ReferenceKline.hpp"
+
+namespace QTrading::Infra::Data::Binance {
+enum class MappedRangeAdvice : uint8_t;
+}
+
+/// @brief Columns retained by ReferenceKlineData.
+enum class ReferenceKlineLayout {
+    /// Open time, OHLC and close time.
+    Ohlc,
+    /// Open time and close only; replay and interpolation consume nothing else.
+    CloseOnly,
+};
+
+/// @brief Compact mark/index price series loaded from a kline CSV.
+///
+/// Reference streams only feed ReferenceKlineDto points into the replay, so this
+/// keeps the time and price columns (SoA) and drops volumes/trade counts. Columns
+/// are spans over the binary cache mapping when it is enabled, otherwise owned
+/// vectors holding just the retained columns. Copies share storage.
+class ReferenceKlineData {
+public:
+    /// @brief Construct a reference series for a symbol from a CSV file.
+    /// @param symbol Trading symbol identifier (e.g. "BTCUSDT").
+    /// @param csv_file Filesystem path to a 6- or 11-column kline CSV.
+    /// @param layout Columns to retain.
+    ReferenceKlineData(
+        const std::string& symbol,
+        const std::string& csv_file,
+        ReferenceKlineLayout layout = ReferenceKlineLayout::Ohlc);
+
+    /// @brief Get the reference kline at a specific index.
+    /// @details With `CloseOnly`, OHLC collapse to the close and CloseTime to the open time.
+    /// @throw std::out_of_range if index ≥ total count.
+    QTrading::Dto::Market::Binance::ReferenceKlineDto get_kline(size_t index) const;
+
+    /// @brief Get the latest (most recent) reference kline.
+    /// @throw std::out_of_range if no data is loaded.
+    QTrading::Dto::Market::Binance::ReferenceKlineDto get_latest_kline() const;
+
+    /// @brief Get the total number of reference klines loaded.
+    size_t get_klines_count() const noexcept { return open_time_.size(); }
+
+    /// @brief Lower bound index for a timestamp (first index with open time >= ts).
+    size_t lower_bound_ts(uint64_t ts) const;
+
+    /// @brief Lower bound resumed from a previous result `hint`.
+    /// @details Scans forward a few rows, then gallops; a hint past the answer
+    ///          (replay seek) falls back to a binary search of the prefix.
+    size_t lower_bound_ts(uint64_t ts, size_t hint) const;
+
+    /// @brief Upper bound index for a timestamp (first index with open time > ts).
+    size_t upper_bound_ts(uint64_t ts) const;
+
+    /// @brief Open of the first bar; kept in every layout for pre-replay quotes.
+    /// @return 0 when no data is loaded.
+    double opening_price() const noexcept { return opening_price_; }
+
+    /// @name Column accessors
+    /// @brief Chronologically ordered columns; OHLC/close-time spans are empty with `CloseOnly`.
+    /// @{
+    std::span<const uint64_t> timestamps() const noexcept { return open_time_; }
+    std::span<const double> close_prices() const noexcept { return close_; }
+    std::span<const double> open_prices() const noexcept { return open_; }
+    std::span<const double> high_prices() const noexcept { return high_; }
+    std::span<const double> low_prices() const noexcept { return low_; }
+    std::span<const uint64_t> close_times() const noexcept { return close_time_; }
+    /// @}
+
+    /// @brief Columns retained at load time.
+    ReferenceKlineLayout layout() const noexcept { return layout_; }
+
+    /// @brief True when the columns are backed by a memory-mapped cache file.
+    bool is_memory_mapped() const noexcept { return memory_mapped_; }
+
+    /// @brief Applies a residency hint to rows `[first, last)` of every retained column.
+    /// @details No-op unless memory-mapped; used by replay read-ahead.
+    void advise_rows(size_t first, size_t last, QTrading::Infra::Data::Binance::MappedRangeAdvice advice) const noexcept;
+
+    /// @brief Bytes per row across the retained columns.
+    size_t row_bytes() const noexcept;
+
+private:
+    std::string symbol;         ///< Trading symbol
+    ReferenceKlineLayout layout_{ ReferenceKlineLayout::Ohlc };
+    std::shared_ptr<const void> storage_;   ///< Keeps the mapped file or owned columns alive
+    bool memory_mapped_{ false };
+    double opening_price_{ 0.0 };
+
+    std::span<const uint64_t> open_time_;
+    std::span<const double> open_;
+    std::span<const double> high_;
+    std::span<const double> low_;
+    std::span<const double> close_;
+    std::span<const uint64_t> close_time_;
+
+    /// @brief Builds a reference kline without bounds checking.
+    QTrading::Dto::Market::Binance::ReferenceKlineDto row_at(size_t index) const;
+};
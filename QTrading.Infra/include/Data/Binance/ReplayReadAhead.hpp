@@ -0,0 +1,109 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Data/Binance/BinaryCache.hpp"
+#include "Data/Binance/MarketData.hpp"
+#include "Data/Binance/ReferenceKlineData.hpp"
+
+namespace QTrading::Infra::Data::Binance {
+
+/// @brief Streams memory-mapped replay series through a bounded resident window.
+/// @details Each mapped series keeps roughly two chunks resident: the chunk being
+///          replayed and the next one, prefetched on a background thread. Rows behind
+///          the replay cursor are released as the cursor crosses chunk boundaries, so
+///          resident bar memory stays near `chunk_budget_bytes` regardless of history
+///          length. Series that are not memory-mapped (binary cache disabled) are
+///          already fully resident and are ignored.
+class ReplayReadAhead {
+public:
+    /// @brief Smallest chunk, in rows, regardless of budget (about 17 hours of 1m bars).
+    static constexpr size_t kMinChunkRows = 1024;
+
+    /// @param trade One entry per replay symbol.
+    /// @param mark Mark-price pool (indexed by pool id).
+    /// @param index Index-price pool (indexed by pool id).
+    /// @param chunk_budget_bytes Target resident bytes across all mapped series.
+    ReplayReadAhead(
+        const std::vector<MarketData>& trade,
+        const std::vector<ReferenceKlineData>& mark,
+        const std::vector<ReferenceKlineData>& index,
+        size_t chunk_budget_bytes);
+    ~ReplayReadAhead();
+
+    ReplayReadAhead(const ReplayReadAhead&) = delete;
+    ReplayReadAhead& operator=(const ReplayReadAhead&) = delete;
+
+    /// @brief Reports the replay cursor of trade series `symbol_id`; cheap unless a chunk boundary is crossed.
+    void advance_trade(size_t symbol_id, size_t cursor) { advance(symbol_id, cursor); }
+    /// @brief Reports the replay cursor of mark pool entry `pool_id`.
+    void advance_mark(size_t pool_id, size_t cursor) { advance(mark_offset_ + pool_id, cursor); }
+    /// @brief Reports the replay cursor of index pool entry `pool_id`.
+    void advance_index(size_t pool_id, size_t cursor) { advance(index_offset_ + pool_id, cursor); }
+
+    /// @brief Rows per chunk shared by every mapped series.
+    size_t chunk_rows() const noexcept { return chunk_rows_; }
+    /// @brief Number of memory-mapped series being streamed.
+    size_t active_series() const noexcept { return active_series_; }
+    /// @brief Residency hints applied so far by the background thread.
+    uint64_t completed_requests() const;
+    /// @brief Blocks until every queued hint has been applied.
+    void drain();
+
+private:
+    enum class SeriesKind : uint8_t { Trade, Reference };
+
+    struct Series {
+        SeriesKind kind{ SeriesKind::Trade };
+        /// Index into `trade_` or `reference_`.
+        size_t source{ 0 };
+        size_t rows{ 0 };
+        /// Cursor at which the next chunk transition is issued; max() when inactive.
+        size_t next_trigger{ (std::numeric_limits<size_t>::max)() };
+        /// Rows below this are already released.
+        size_t released_upto{ 0 };
+    };
+
+    struct Request {
+        size_t series{ 0 };
+        size_t first{ 0 };
+        size_t last{ 0 };
+        MappedRangeAdvice advice{ MappedRangeAdvice::WillNeed };
+    };
+
+    void advance(size_t series_id, size_t cursor)
+    {
+        if (series_id < series_.size() && cursor >= series_[series_id].next_trigger) {
+            on_chunk_boundary(series_id, cursor);
+        }
+    }
+    void on_chunk_boundary(size_t series_id, size_t cursor);
+    void apply(const Request& request) const;
+    void run();
+
+    // Copies share mapped storage; they keep the mapping alive for the worker.
+    std::vector<MarketData> trade_;
+    std::vector<ReferenceKlineData> reference_;
+    std::vector<Series> series_;
+    size_t mark_offset_{ 0 };
+    size_t index_offset_{ 0 };
+    size_t chunk_rows_{ kMinChunkRows };
+    size_t active_series_{ 0 };
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::vector<Request> pending_;
+    bool busy_{ false };
+    bool stop_{ false };
+    uint64_t completed_{ 0 };
+    std::thread worker_;
+};
+
+} // namespace QTrading::Infra::Data::Binance
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Dto/Order.hpp"
+#include "Dto/Position.hpp"
+
+namespace QTrading::dto {
+
+    /// @brief Incremental change to an id-keyed book of positions or orders.
+    /// @details Deltas of one stream carry consecutive sequence numbers starting at 1; applying them
+    ///          in order to an empty book rebuilds the publisher's book (see `BookReplica`).
+    template <typename T>
+    struct BookDelta {
+        /// @brief Position of this delta in its stream; the first delta is 1.
+        uint64_t seq{ 0 };
+
+        /// @brief Entries whose id was not in the book, in publisher book order.
+        std::vector<T> added;
+
+        /// @brief New contents of entries already in the book whose fields changed.
+        std::vector<T> updated;
+
+        /// @brief Ids of entries that left the book, in their previous book order.
+        std::vector<int> removed_ids;
+
+        /// @brief True when the delta carries no change.
+        bool empty() const noexcept
+        {
+            return added.empty() && updated.empty() && removed_ids.empty();
+        }
+    };
+
+    using PositionBookDelta = BookDelta<Position>;
+    using OrderBookDelta = BookDelta<Order>;
+
+}  // namespace QTrading::dto
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Dto/Market/Binance/FundingRate.hpp"
+#include "Dto/Market/Binance/TradeKline.hpp"
+
+namespace QTrading::Dto::Market::Binance {
+
+    /// @brief Compact cross-section of one replay step.
+    /// @details One column per field and one presence bitmask per stream, bit `i` = symbol id `i`.
+    ///          Trade/mark/index rows open at the owning payload's Timestamp; funding keeps its
+    ///          own FundingTime. Columns of absent symbols hold stale values and must not be read.
+    struct MarketFrame {
+        /// @brief Trade kline fields carried by the frame.
+        struct TradeBar {
+            double open{ 0.0 };
+            double high{ 0.0 };
+            double low{ 0.0 };
+            double close{ 0.0 };
+            double volume{ 0.0 };
+            double quote_volume{ 0.0 };
+            double taker_buy_base_volume{ 0.0 };
+        };
+
+        /// @brief Symbols covered; 0 means the frame is not populated.
+        std::size_t symbol_count{ 0 };
+        std::vector<uint64_t> trade_presence;
+        std::vector<uint64_t> mark_presence;
+        std::vector<uint64_t> index_presence;
+        std::vector<uint64_t> funding_presence;
+        /// @brief Funding rows that carry a mark price.
+        std::vector<uint64_t> funding_mark_presence;
+
+        std::vector<double> trade_open;
+        std::vector<double> trade_high;
+        std::vector<double> trade_low;
+        std::vector<double> trade_close;
+        std::vector<double> trade_volume;
+        std::vector<double> trade_quote_volume;
+        std::vector<double> trade_taker_buy_base_volume;
+        std::vector<double> mark_close;
+        std::vector<double> index_close;
+        std::vector<uint64_t> funding_time;
+        std::vector<double> funding_rate;
+        std::vector<double> funding_mark_price;
+
+        static bool test(const std::vector<uint64_t>& words, std::size_t id) noexcept
+        {
+            return id / 64 < words.size() && ((words[id / 64] >> (id % 64)) & 1u) != 0;
+        }
+
+        /// @brief Sizes every column for `count` symbols and clears all presence.
+        void resize(std::size_t count)
+        {
+            symbol_count = count;
+            const std::size_t words = (count + 63) / 64;
+            for (auto* bits : { &trade_presence, &mark_presence, &index_presence, &funding_presence, &funding_mark_presence }) {
+                bits->assign(words, 0);
+            }
+            for (auto* column : { &trade_open, &trade_high, &trade_low, &trade_close, &trade_volume,
+                     &trade_quote_volume, &trade_taker_buy_base_volume, &mark_close, &index_close,
+                     &funding_rate, &funding_mark_price }) {
+                column->assign(count, 0.0);
+            }
+            funding_time.assign(count, 0);
+        }
+
+        /// @brief Marks every stream absent; columns are left as-is.
+        void clear_presence() noexcept
+        {
+            for (auto* bits : { &trade_presence, &mark_presence, &index_presence, &funding_presence, &funding_mark_presence }) {
+                std::fill(bits->begin(), bits->end(), 0);
+            }
+        }
+
+        bool has_trade(std::size_t id) const noexcept { return test(trade_presence, id); }
+        bool has_mark(std::size_t id) const noexcept { return test(mark_presence, id); }
+        bool has_index(std::size_t id) const noexcept { return test(index_presence, id); }
+        bool has_funding(std::size_t id) const noexcept { return test(funding_presence, id); }
+
+        void set_trade(std::size_t id, const TradeKlineDto& kline) noexcept
+        {
+            trade_open[id] = kline.OpenPrice;
+            trade_high[id] = kline.HighPrice;
+            trade_low[id] = kline.LowPrice;
+            trade_close[id] = kline.ClosePrice;
+            trade_volume[id] = kline.Volume;
+            trade_quote_volume[id] = kline.QuoteVolume;
+            trade_taker_buy_base_volume[id] = kline.TakerBuyBaseVolume;
+            set(trade_presence, id);
+        }
+
+        void set_mark(std::size_t id, double close) noexcept
+        {
+            mark_close[id] = close;
+            set(mark_presence, id);
+        }
+
+        void set_index(std::size_t id, double close) noexcept
+        {
+            index_close[id] = close;
+            set(index_presence, id);
+        }
+
+        void set_funding(std::size_t id, const FundingRateDto& funding) noexcept
+        {
+            funding_time[id] = funding.FundingTime;
+            funding_rate[id] = funding.Rate;
+            funding_mark_price[id] = funding.MarkPrice.value_or(0.0);
+            set(funding_presence, id);
+            if (funding.MarkPrice.has_value()) {
+                set(funding_mark_presence, id);
+            }
+            else {
+                funding_mark_presence[id / 64] &= ~(uint64_t{ 1 } << (id % 64));
+            }
+        }
+
+        TradeBar trade_bar(std::size_t id) const noexcept
+        {
+            return TradeBar{ trade_open[id], trade_high[id], trade_low[id], trade_close[id],
+                trade_volume[id], trade_quote_volume[id], trade_taker_buy_base_volume[id] };
+        }
+
+        FundingRateDto funding(std::size_t id) const
+        {
+            return test(funding_mark_presence, id)
+                ? FundingRateDto(funding_time[id], funding_rate[id], funding_mark_price[id])
+                : FundingRateDto(funding_time[id], funding_rate[id]);
+        }
+
+        /// @brief Heap bytes held by the columns and bitmasks.
+        std::size_t bytes() const noexcept
+        {
+            const std::size_t words = trade_presence.size() + mark_presence.size() + index_presence.size() +
+                funding_presence.size() + funding_mark_presence.size();
+            return words * sizeof(uint64_t) + symbol_count * (11 * sizeof(double) + sizeof(uint64_t));
+        }
+
+    private:
+        static void set(std::vector<uint64_t>& words, std::size_t id) noexcept
+        {
+            words[id / 64] |= uint64_t{ 1 } << (id % 64);
+        }
+    };
+
+}  // namespace QTrading::Dto::Market::Binance
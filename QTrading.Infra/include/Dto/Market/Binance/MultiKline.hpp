@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
@@ -7,11 +8,16 @@
 #include "Dto/Market/Base.hpp"
 #include "Dto/Market/Binance/FundingRate.hpp"
 #include "Dto/Market/Binance/Kline.hpp"
+#include "Dto/Market/Binance/MarketFrame.hpp"
 #include "Dto/Market/Binance/ReferenceKline.hpp"
 
 namespace QTrading::Dto::Market::Binance {
 
     /// @brief DTO containing multiple symbols 1-minute klines at a given timestamp.
+    /// @details The replay kernel always fills `frame`; the per-symbol optional rows are
+    ///          only filled when enabled by the simulation config. Read through the
+    ///          accessors below, which prefer the frame and fall back to the rows for
+    ///          hand-built payloads.
     struct MultiKlineDto : QTrading::Dto::Market::BaseMarketDto {
         /// @brief Stable symbol table (same order as trade_klines_by_id).
         std::shared_ptr<const std::vector<std::string>> symbols;
@@ -24,6 +30,100 @@ namespace QTrading::Dto::Market::Binance {
         /// @brief Latest known funding snapshot per symbol aligned to symbols.
         /// @details This is piecewise-constant between funding updates (e.g., 8h cadence).
         std::vector<std::optional<FundingRateDto>> funding_by_id;
+        /// @brief Compact column/bitmask view of the same step.
+        MarketFrame frame;
+
+        /// @brief Number of symbol slots in the payload.
+        std::size_t symbol_count() const noexcept
+        {
+            return frame.symbol_count != 0 ? frame.symbol_count : trade_klines_by_id.size();
+        }
+
+        bool has_trade_kline(std::size_t id) const noexcept
+        {
+            if (frame.symbol_count != 0) {
+                return frame.has_trade(id);
+            }
+            return id < trade_klines_by_id.size() && trade_klines_by_id[id].has_value();
+        }
+
+        std::optional<MarketFrame::TradeBar> trade_bar(std::size_t id) const noexcept
+        {
+            if (frame.symbol_count != 0) {
+                return frame.has_trade(id) ? std::optional<MarketFrame::TradeBar>(frame.trade_bar(id)) : std::nullopt;
+            }
+            if (id >= trade_klines_by_id.size() || !trade_klines_by_id[id].has_value()) {
+                return std::nullopt;
+            }
+            const auto& k = *trade_klines_by_id[id];
+            return MarketFrame::TradeBar{ k.OpenPrice, k.HighPrice, k.LowPrice, k.ClosePrice,
+                k.Volume, k.QuoteVolume, k.TakerBuyBaseVolume };
+        }
+
+        std::optional<double> trade_close(std::size_t id) const noexcept
+        {
+            if (frame.symbol_count != 0) {
+                return frame.has_trade(id) ? std::optional<double>(frame.trade_close[id]) : std::nullopt;
+            }
+            if (id >= trade_klines_by_id.size() || !trade_klines_by_id[id].has_value()) {
+                return std::nullopt;
+            }
+            return trade_klines_by_id[id]->ClosePrice;
+        }
+
+        std::optional<double> trade_quote_volume(std::size_t id) const noexcept
+        {
+            if (frame.symbol_count != 0) {
+                return frame.has_trade(id) ? std::optional<double>(frame.trade_quote_volume[id]) : std::nullopt;
+            }
+            if (id >= trade_klines_by_id.size() || !trade_klines_by_id[id].has_value()) {
+                return std::nullopt;
+            }
+            return trade_klines_by_id[id]->QuoteVolume;
+        }
+
+        /// @brief Close of the mark row opening at this step.
+        std::optional<double> mark_close(std::size_t id) const noexcept
+        {
+            if (frame.symbol_count != 0) {
+                return frame.has_mark(id) ? std::optional<double>(frame.mark_close[id]) : std::nullopt;
+            }
+            if (id >= mark_klines_by_id.size() || !mark_klines_by_id[id].has_value()) {
+                return std::nullopt;
+            }
+            return mark_klines_by_id[id]->ClosePrice;
+        }
+
+        /// @brief Close of the index row opening at this step.
+        std::optional<double> index_close(std::size_t id) const noexcept
+        {
+            if (frame.symbol_count != 0) {
+                return frame.has_index(id) ? std::optional<double>(frame.index_close[id]) : std::nullopt;
+            }
+            if (id >= index_klines_by_id.size() || !index_klines_by_id[id].has_value()) {
+                return std::nullopt;
+            }
+            return index_klines_by_id[id]->ClosePrice;
+        }
+
+        bool has_funding(std::size_t id) const noexcept
+        {
+            if (frame.symbol_count != 0) {
+                return frame.has_funding(id);
+            }
+            return id < funding_by_id.size() && funding_by_id[id].has_value();
+        }
+
+        std::optional<FundingRateDto> funding(std::size_t id) const
+        {
+            if (frame.symbol_count != 0) {
+                return frame.has_funding(id) ? std::optional<FundingRateDto>(frame.funding(id)) : std::nullopt;
+            }
+            if (id >= funding_by_id.size()) {
+                return std::nullopt;
+            }
+            return funding_by_id[id];
+        }
     };
 
 }  // namespace QTrading::Dto::Market::Binance
@@ -4,6 +4,7 @@
 #include <string>
 #include "Dto/Trading/Side.hpp"
 #include "Dto/Trading/InstrumentSpec.hpp"
+#include "Dto/Trading/SymbolId.hpp"
 
 namespace QTrading::dto {
 
@@ -58,6 +59,12 @@ namespace QTrading::dto {
 
         /// @brief First replay step when this order is eligible to match.
         uint64_t first_matching_step{ 0 };
+
+        /// @brief Interned id of `symbol`; `kInvalidSymbolId` when built without one.
+        QTrading::Dto::Trading::SymbolId interned_symbol_id{ QTrading::Dto::Trading::kInvalidSymbolId };
+
+        /// @brief Field-wise equality, used to detect changed entries when diffing books.
+        bool operator==(const Order&) const = default;
     };
 
 }  // namespace QTrading::dto
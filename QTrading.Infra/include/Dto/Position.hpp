@@ -2,6 +2,7 @@
 
 #include <string>
 #include "Dto/Trading/InstrumentSpec.hpp"
+#include "Dto/Trading/SymbolId.hpp"
 
 namespace QTrading::dto {
 
@@ -49,6 +50,12 @@ namespace QTrading::dto {
 
         /// @brief Instrument type captured at position creation for routing/logging.
         QTrading::Dto::Trading::InstrumentType instrument_type{ QTrading::Dto::Trading::InstrumentType::Perp };
+
+        /// @brief Interned id of `symbol`; `kInvalidSymbolId` when built without one.
+        QTrading::Dto::Trading::SymbolId interned_symbol_id{ QTrading::Dto::Trading::kInvalidSymbolId };
+
+        /// @brief Field-wise equality, used to detect changed entries when diffing books.
+        bool operator==(const Position&) const = default;
     };
 
 }  // namespace QTrading::dto
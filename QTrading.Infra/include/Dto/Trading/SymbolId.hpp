@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace QTrading::Dto::Trading {
+
+    /// @brief Compact process-wide handle of an interned trading symbol.
+    /// @details Ids are dense and assigned in first-intern order, so they index plain vectors;
+    ///          they are stable for the life of the process but not across processes.
+    using SymbolId = uint32_t;
+
+    /// @brief Id carried by entries whose symbol has not been interned.
+    inline constexpr SymbolId kInvalidSymbolId = std::numeric_limits<SymbolId>::max();
+
+    /// @brief Process-wide symbol interner shared by every exchange, strategy and log sink.
+    /// @details Interning hashes once under a lock; hot paths then carry the `SymbolId` and
+    ///          index per-exchange tables with it. `Name` is for outward APIs and logs.
+    class SymbolTable {
+    public:
+        /// @brief Id of `symbol`, interning it on first use.
+        static SymbolId Intern(std::string_view symbol)
+        {
+            auto& table = Instance();
+            {
+                std::shared_lock<std::shared_mutex> lock(table.mutex_);
+                if (const auto it = table.ids_.find(symbol); it != table.ids_.end()) {
+                    return it->second;
+                }
+            }
+            std::unique_lock<std::shared_mutex> lock(table.mutex_);
+            if (const auto it = table.ids_.find(symbol); it != table.ids_.end()) {
+                return it->second;
+            }
+            const auto id = static_cast<SymbolId>(table.names_.size());
+            // Deque elements never move, so the map keys can view them.
+            const std::string& name = table.names_.emplace_back(symbol);
+            table.ids_.emplace(std::string_view(name), id);
+            return id;
+        }
+
+        /// @brief Id of `symbol` if it was interned.
+        static std::optional<SymbolId> Find(std::string_view symbol)
+        {
+            auto& table = Instance();
+            std::shared_lock<std::shared_mutex> lock(table.mutex_);
+            const auto it = table.ids_.find(symbol);
+            if (it == table.ids_.end()) {
+                return std::nullopt;
+            }
+            return it->second;
+        }
+
+        /// @brief Symbol text of an id returned by `Intern`.
+        static const std::string& Name(SymbolId id)
+        {
+            auto& table = Instance();
+            std::shared_lock<std::shared_mutex> lock(table.mutex_);
+            return table.names_.at(id);
+        }
+
+        /// @brief Number of interned symbols; every id is below it.
+        static size_t Size()
+        {
+            auto& table = Instance();
+            std::shared_lock<std::shared_mutex> lock(table.mutex_);
+            return table.names_.size();
+        }
+
+    private:
+        static SymbolTable& Instance()
+        {
+            static SymbolTable table;
+            return table;
+        }
+
+        std::shared_mutex mutex_;
+        std::deque<std::string> names_;
+        std::unordered_map<std::string_view, SymbolId> ids_;
+    };
+
+}  // namespace QTrading::Dto::Trading
@@ -21,6 +21,14 @@ public:
         ExpireBoth = 3,
     };
 
+    /// Complete ledger contents, captured and reinstated by exchange checkpoints.
+    struct LedgerState {
+        QTrading::Dto::Account::BalanceSnapshot spot_balance{};
+        QTrading::Dto::Account::BalanceSnapshot perp_balance{};
+        double total_cash_balance{ 0.0 };
+        uint64_t state_version{ 0 };
+    };
+
     Account() = default;
     /// Initializes spot/perp balance ledgers from bootstrap config.
     explicit Account(const AccountInitConfig& init);
@@ -63,6 +71,10 @@ public:
     bool transfer_spot_to_perp(double amount);
     /// Moves cash from perp to spot if available balance is sufficient.
     bool transfer_perp_to_spot(double amount);
+    /// Returns the full ledger contents.
+    LedgerState ledger_state() const;
+    /// Replaces the ledger contents verbatim, including the state version.
+    void restore_ledger_state(const LedgerState& state);
 private:
     static double validate_non_negative_(double value, const char* field);
     static void validate_non_negative_int_(int value, const char* field);
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
+
+namespace QTrading::Infra::Exchanges::BinanceSim::Application {
+
+/// Outcome of one batch run.
+struct BatchRunResult {
+    /// Steps reported by the run body.
+    uint64_t steps{ 0 };
+    /// Wall time spent in the run body.
+    uint64_t elapsed_ns{ 0 };
+    /// Exception that escaped the run body; null on success.
+    std::exception_ptr error;
+};
+
+/// Loads a dataset universe once and replays it through many independent exchanges,
+/// e.g. one per strategy config of a parameter sweep.
+/// Every exchange owns its account, order book, replay cursors and logger; only the
+/// immutable kline/funding/mark/index series are shared.
+class BatchReplayRunner final {
+public:
+    /// Drives one run: builds its logger/strategy around `runner.make_exchange(...)`,
+    /// steps it to completion and returns the step count.
+    using RunBody = std::function<uint64_t(size_t run_index, const BatchReplayRunner& runner)>;
+
+    /// Loads `datasets` once with `load_options`.
+    explicit BatchReplayRunner(
+        std::vector<Contracts::SymbolDataset> datasets,
+        const Bootstrap::DatasetLoadOptions& load_options = {});
+    /// Reuses data already loaded from `datasets`.
+    BatchReplayRunner(
+        std::vector<Contracts::SymbolDataset> datasets,
+        std::shared_ptr<const Bootstrap::LoadedDatasets> shared_data);
+
+    const std::vector<Contracts::SymbolDataset>& datasets() const noexcept { return datasets_; }
+    const std::shared_ptr<const Bootstrap::LoadedDatasets>& shared_data() const noexcept { return shared_data_; }
+
+    /// New exchange over the shared data; safe to call from concurrent runs.
+    std::shared_ptr<BinanceExchange> make_exchange(
+        std::shared_ptr<QTrading::Log::Logger> logger,
+        const Account::AccountInitConfig& account_init,
+        uint64_t run_id = 0) const;
+
+    /// Runs `body(i, *this)` for every i in [0, run_count) on up to `max_parallelism`
+    /// threads (0 = hardware concurrency, 1 = inline). Runs start in index order; a run
+    /// that throws records the exception in its result and does not stop the others.
+    std::vector<BatchRunResult> run(size_t run_count, const RunBody& body, size_t max_parallelism = 0) const;
+
+private:
+    std::vector<Contracts::SymbolDataset> datasets_;
+    std::shared_ptr<const Bootstrap::LoadedDatasets> shared_data_;
+};
+
+} // namespace QTrading::Infra::Exchanges::BinanceSim::Application
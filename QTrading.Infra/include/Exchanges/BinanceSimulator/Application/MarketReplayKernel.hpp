@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <optional>
+
 #include "Exchanges/BinanceSimulator/Application/MarketReplayStepFrame.hpp"
 
 namespace QTrading::Infra::Exchanges::BinanceSim::State {
@@ -16,6 +19,16 @@ public:
     /// Produces the next market replay frame and advances internal cursors.
     /// Returns {has_next=false} when replay input is exhausted.
     static MarketReplayStepFrame Next(State::StepKernelState& state);
+
+    /// Rebuilds the merge structures of `state.replay_merge_mode` from the per-symbol
+    /// next-timestamp cursors. Call after switching modes or repositioning cursors.
+    static void ResetMerge(State::StepKernelState& state);
+
+    /// Consumes every replay row opening before `ts` without building frames, as if the
+    /// skipped frames had been stepped. The current-step caches are left holding the last
+    /// skipped row of each stream, i.e. the prices the skipped frames would have left behind.
+    /// Returns the timestamp of the last skipped frame, or nullopt when nothing opens before `ts`.
+    static std::optional<uint64_t> SkipBefore(State::StepKernelState& state, uint64_t ts);
 };
 
 } // namespace QTrading::Infra::Exchanges::BinanceSim::Application
@@ -1,9 +1,11 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 
 #include "Dto/Market/Binance/MultiKline.hpp"
+#include "Exchanges/BinanceSimulator/State/ReplayMinuteGrid.hpp"
 
 namespace QTrading::Infra::Exchanges::BinanceSim::Application {
 
@@ -15,6 +17,9 @@ struct MarketReplayStepFrame {
     uint64_t ts_exchange{ 0 };
     /// Aggregated market payload for all symbols active at `ts_exchange`.
     std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto> market_payload;
+    /// `MinuteGrid` mode: panel window holding `ts_exchange` and its minute; null otherwise.
+    std::shared_ptr<const State::ReplayMinuteGrid> minute_grid;
+    size_t minute_grid_minute{ 0 };
 };
 
 } // namespace QTrading::Infra::Exchanges::BinanceSim::Application
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "Exchanges/BinanceSimulator/State/ReplayMinuteGrid.hpp"
+
+namespace QTrading::Infra::Exchanges::BinanceSim::State {
+struct StepKernelState;
+}
+
+namespace QTrading::Infra::Exchanges::BinanceSim::Application {
+
+/// Grid step of Binance 1-minute kline streams.
+inline constexpr uint64_t kReplayMinuteGridStepMs = 60'000;
+
+/// Materializes the minute-grid panel for the `window_minutes` minutes starting at the
+/// earliest trade/funding row pending at the current cursors, so the panel is
+/// O(window x symbols) however long the replay is. Returns an empty grid when nothing is
+/// pending, and nullptr when `window_minutes` is zero or a trade or funding row inside the
+/// window is off-grid or not strictly increasing per symbol.
+std::shared_ptr<const State::ReplayMinuteGrid> BuildReplayMinuteGrid(
+    const State::StepKernelState& state,
+    size_t window_minutes,
+    uint64_t step_ms = kReplayMinuteGridStepMs);
+
+} // namespace QTrading::Infra::Exchanges::BinanceSim::Application
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "Exchanges/BinanceSimulator/Application/MarketReplayStepFrame.hpp"
+
+namespace QTrading::Infra::Exchanges::BinanceSim::State {
+struct StepKernelState;
+}
+
+namespace QTrading::Infra::Exchanges::BinanceSim::Application {
+
+/// Assembles the next replay frame on a dedicated thread while the stepping thread runs
+/// strategy code. Frame assembly depends on replay cursors only, never on account state,
+/// so a frame built ahead is identical to one built at the start of its step.
+/// Off-thread work touches replay cursors, merge structures, current-step caches and the
+/// payload pool; order entry reads the cursors captured by `start` meanwhile.
+class ReplayPrefetcher final {
+public:
+    ReplayPrefetcher();
+    ~ReplayPrefetcher();
+
+    ReplayPrefetcher(const ReplayPrefetcher&) = delete;
+    ReplayPrefetcher& operator=(const ReplayPrefetcher&) = delete;
+
+    /// Captures the committed cursors of `state`, sets `state.replay_prefetch_pending` and
+    /// begins assembling its next frame. `state` must outlive the matching `take`.
+    void start(State::StepKernelState& state);
+    /// Blocks until the frame begun by `start` is assembled, without consuming it.
+    void wait();
+    /// Returns the frame begun by `start` and clears `state.replay_prefetch_pending`;
+    /// `has_next` is false when replay was exhausted. Rethrows an assembly error.
+    MarketReplayStepFrame take(State::StepKernelState& state);
+
+private:
+    void worker_loop();
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    State::StepKernelState* state_{ nullptr };
+    MarketReplayStepFrame frame_;
+    std::exception_ptr error_;
+    bool running_{ false };
+    bool stopping_{ false };
+};
+
+} // namespace QTrading::Infra::Exchanges::BinanceSim::Application
@@ -4,6 +4,10 @@ namespace QTrading::Infra::Exchanges::BinanceSim {
 class BinanceExchange;
 }
 
+namespace QTrading::Infra::Exchanges::BinanceSim::Contracts {
+struct WakeCondition;
+}
+
 namespace QTrading::Infra::Exchanges::BinanceSim::Application {
 
 /// Coordinates one exchange step using the rebuilt application pipeline.
@@ -17,6 +21,10 @@ public:
     /// Returns false only when replay termination is reached.
     bool run_step() const;
 
+    /// Like `run_step`, but while the account is idle first consumes, in bulk, every frame
+    /// before the first one satisfying `wake`; only that frame is materialized.
+    bool run_until(const Contracts::WakeCondition& wake) const;
+
 private:
     /// Non-owning facade reference; lifetime is managed by BinanceExchange.
     BinanceExchange& exchange_;
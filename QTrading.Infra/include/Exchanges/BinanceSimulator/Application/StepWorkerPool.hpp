@@ -0,0 +1,92 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace QTrading::Infra::Exchanges::BinanceSim::Application {
+
+/// Persistent threads that shard symbol-local step phases.
+/// Shard bounds depend only on the item count, grain and concurrency, so phases that
+/// write per-index scratch and reduce it serially stay bit-identical to a serial run.
+class StepWorkerPool final {
+public:
+    /// @param concurrency Shards per call including the calling thread; values below 1 act as 1.
+    explicit StepWorkerPool(size_t concurrency);
+    ~StepWorkerPool();
+
+    StepWorkerPool(const StepWorkerPool&) = delete;
+    StepWorkerPool& operator=(const StepWorkerPool&) = delete;
+
+    /// Threads that take part in one call, the caller included.
+    size_t concurrency() const noexcept { return threads_.size() + 1; }
+
+    /// Splits [0, count) into contiguous shards of at least `min_grain` items and runs
+    /// `fn(begin, end)` on each; the calling thread takes the first shard. Returns once every
+    /// shard finished and rethrows the first exception raised by any of them. `fn` is called
+    /// concurrently through a const reference and is not copied.
+    template <typename Fn>
+    void parallel_for(size_t count, size_t min_grain, Fn&& fn)
+    {
+        const size_t shards = shard_count(count, min_grain);
+        if (shards == 0) {
+            return;
+        }
+        if (shards == 1) {
+            fn(size_t{ 0 }, count);
+            return;
+        }
+        run_shards(count, shards, &invoke_shard<std::remove_cvref_t<Fn>>, std::addressof(fn));
+    }
+
+private:
+    using ShardInvoker = void (*)(const void* fn, size_t begin, size_t end);
+
+    template <typename Callable>
+    static void invoke_shard(const void* fn, size_t begin, size_t end)
+    {
+        (*static_cast<const Callable*>(fn))(begin, end);
+    }
+
+    size_t shard_count(size_t count, size_t min_grain) const noexcept;
+    void run_shards(size_t count, size_t shards, ShardInvoker invoke, const void* fn);
+    void worker_loop(size_t shard);
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable done_cv_;
+    ShardInvoker task_invoke_{ nullptr };
+    const void* task_fn_{ nullptr };
+    size_t task_count_{ 0 };
+    size_t shard_count_{ 0 };
+    size_t shard_size_{ 0 };
+    uint64_t generation_{ 0 };
+    size_t pending_shards_{ 0 };
+    std::exception_ptr error_;
+    bool stopping_{ false };
+};
+
+/// Smallest shard of a symbol-local phase; shorter ranges stay on the calling thread.
+inline constexpr size_t kStepShardMinItems = 32;
+
+/// Runs `fn(begin, end)` over [0, count), sharded across `pool` when one is set.
+template <typename Fn>
+void for_each_step_shard(StepWorkerPool* pool, size_t count, Fn&& fn)
+{
+    if (pool) {
+        pool->parallel_for(count, kStepShardMinItems, fn);
+        return;
+    }
+    if (count != 0) {
+        fn(size_t{ 0 }, count);
+    }
+}
+
+} // namespace QTrading::Infra::Exchanges::BinanceSim::Application
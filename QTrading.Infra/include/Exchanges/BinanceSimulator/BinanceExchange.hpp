@@ -1,8 +1,11 @@
 #pragma once
 
 #include <cstdint>
+#include <iosfwd>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Dto/Account/BalanceSnapshot.hpp"
@@ -13,9 +16,11 @@
 #include "Exchanges/BinanceSimulator/Api/PerpApi.hpp"
 #include "Exchanges/BinanceSimulator/Api/SpotApi.hpp"
 #include "Exchanges/BinanceSimulator/Account/Account.hpp"
+#include "Exchanges/BinanceSimulator/Bootstrap/DatasetLoader.hpp"
 #include "Exchanges/BinanceSimulator/Config/BinanceSimulationConfig.hpp"
 #include "Exchanges/BinanceSimulator/Contracts/BinanceExchangeRuntimeTypes.hpp"
 #include "Exchanges/BinanceSimulator/Contracts/BinanceExchangeStatusSnapshot.hpp"
+#include "Exchanges/BinanceSimulator/Contracts/WakeCondition.hpp"
 #include "Exchanges/IExchange.h"
 #include "Logger.hpp"
 
@@ -23,6 +28,7 @@ namespace QTrading::Infra::Exchanges::BinanceSim::State {
 struct BinanceExchangeRuntimeState;
 struct StepKernelState;
 struct SnapshotState;
+struct ExchangeSnapshot;
 }
 
 namespace QTrading::Infra::Exchanges::BinanceSim::Application {
@@ -47,12 +53,30 @@ using MultiKlinePtr = std::shared_ptr<QTrading::Dto::Market::Binance::MultiKline
 class BinanceExchange final : public QTrading::Infra::Exchanges::IExchange<MultiKlinePtr> {
 public:
     using SymbolDataset = Contracts::SymbolDataset;
+    using WakeCondition = Contracts::WakeCondition;
     using StatusSnapshot = Contracts::StatusSnapshot;
     using SimulationConfig = Config::SimulationConfig;
+    using DatasetLoadOptions = Bootstrap::DatasetLoadOptions;
 
     BinanceExchange(const std::vector<SymbolDataset>& datasets,
         std::shared_ptr<QTrading::Log::Logger> logger, const Account::AccountInitConfig& account_init,
         uint64_t run_id = 0);
+    /// Same as above with explicit dataset loading parallelism/progress reporting.
+    BinanceExchange(const std::vector<SymbolDataset>& datasets,
+        std::shared_ptr<QTrading::Log::Logger> logger, const Account::AccountInitConfig& account_init,
+        uint64_t run_id, const DatasetLoadOptions& load_options);
+    /// Replays `shared_data`, loaded once by `Bootstrap::LoadDatasets(datasets)`, instead of
+    /// reading files. Kline and reference columns are shared read-only with every other exchange
+    /// built from the same data; replay read-ahead is not attached.
+    /// @throws std::invalid_argument when `shared_data` is null or sized for other datasets.
+    BinanceExchange(const std::vector<SymbolDataset>& datasets,
+        std::shared_ptr<const Bootstrap::LoadedDatasets> shared_data,
+        std::shared_ptr<QTrading::Log::Logger> logger, const Account::AccountInitConfig& account_init,
+        uint64_t run_id = 0);
+    /// Continues an independent replay from `snapshot`, which may seed any number of forks.
+    /// Datasets stay shared with the snapshot source; replay read-ahead is not attached.
+    BinanceExchange(const State::ExchangeSnapshot& snapshot,
+        std::shared_ptr<QTrading::Log::Logger> logger, uint64_t run_id = 0);
     ~BinanceExchange();
 
     Api::SpotApi spot;
@@ -61,6 +85,19 @@ public:
 
     /// Main facade entrypoint. Delegates to StepKernel hot path.
     bool step() override;
+    /// Fast-forward step. While the account is idle (flat, no open orders, no deferred or
+    /// pending async commands, basis guard off) replay frames before the first one satisfying
+    /// `wake` are consumed without matching, snapshots, logs or channel output; that frame is
+    /// then stepped as by `step()`. Skipped frames do not advance `step_seq`. Equivalent to
+    /// `step()` when the account is not idle or a prefetched frame is pending.
+    bool step_until(const WakeCondition& wake);
+    /// Pipelined stepping: begins assembling the next replay frame on a background thread so
+    /// it overlaps the caller's strategy work; the next `step()` consumes it. Orders placed in
+    /// between are priced against the current frame and applied before its matching, so
+    /// results equal unpipelined stepping. Until that step `snapshot`, `fork`,
+    /// `save_checkpoint` and `restore_checkpoint` throw std::logic_error.
+    /// @return False when replay already ended or a frame is already pending.
+    bool prefetch_next_step();
     /// Read-only open position view (currently runtime-state backed skeleton).
     const std::vector<QTrading::dto::Position>& get_all_positions() const override;
     /// Read-only open order view (currently runtime-state backed skeleton).
@@ -80,10 +117,29 @@ public:
 
     /// Public snapshot read API. Internally uses Output::SnapshotBuilder path.
     void FillStatusSnapshot(StatusSnapshot& out) const;
+    /// Trade closes at the current step's minute from the `MinuteGrid` panel, in symbol-id
+    /// order, NaN where a symbol has no kline. Empty outside `MinuteGrid` mode, before the
+    /// first step and for off-grid windows. Valid until the next step.
+    std::span<const double> minute_grid_close_row() const noexcept;
     /// Exposes account state to API adapters/kernels without leaking ownership.
     Account& account_state() noexcept;
     const Account& account_state() const noexcept;
 
+    /// Captures the current mutable state for later forks; call between steps.
+    std::shared_ptr<const State::ExchangeSnapshot> snapshot() const;
+    /// Shorthand for a new exchange built from `snapshot()`; this exchange is left untouched.
+    std::shared_ptr<BinanceExchange> fork(
+        std::shared_ptr<QTrading::Log::Logger> logger = nullptr, uint64_t run_id = 0) const;
+    /// Writes a binary checkpoint of the mutable state plus opaque `extension` bytes
+    /// (e.g. strategy state); call between steps.
+    void save_checkpoint(std::ostream& out, std::string_view extension = {}) const;
+    /// Resumes from a checkpoint written by an exchange over the same datasets: call on a
+    /// freshly constructed exchange, after `apply_simulation_config`, before its first step.
+    /// Consumed history is skipped by cursor, not replayed. Leaves this exchange unchanged on error.
+    /// @return The checkpoint's extension bytes.
+    /// @throws std::runtime_error when the checkpoint is unreadable or for other datasets.
+    std::string restore_checkpoint(std::istream& in);
+
     BinanceExchange(const BinanceExchange&) = delete;
     BinanceExchange& operator=(const BinanceExchange&) = delete;
     BinanceExchange(BinanceExchange&&) = delete;
@@ -97,8 +153,12 @@ private:
 
     /// Initializes bounded/unbounded public channels according to contract.
     void initialize_channels_();
-    /// Loads replay datasets into step kernel state and syncs snapshot symbol state.
-    void initialize_step_kernel_state_(const std::vector<SymbolDataset>& datasets, uint64_t run_id);
+    /// Installs loaded replay datasets into step kernel state and syncs snapshot symbol state.
+    void initialize_step_kernel_state_(
+        const std::vector<SymbolDataset>& datasets,
+        uint64_t run_id,
+        Bootstrap::LoadedDatasets loaded,
+        size_t replay_chunk_budget_bytes);
 
     std::shared_ptr<Account> account_;
     std::unique_ptr<State::BinanceExchangeRuntimeState> runtime_state_;
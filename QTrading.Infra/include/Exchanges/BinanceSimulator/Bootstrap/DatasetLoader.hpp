@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Data/Binance/FundingRateData.hpp"
+#include "Data/Binance/MarketData.hpp"
+#include "Data/Binance/ReferenceKlineData.hpp"
+#include "Exchanges/BinanceSimulator/Contracts/BinanceExchangeRuntimeTypes.hpp"
+
+namespace QTrading::Infra::Exchanges::BinanceSim::Bootstrap {
+
+/// File stream kinds loaded for one SymbolDataset.
+enum class DatasetStream {
+    TradeKline = 0,
+    Funding = 1,
+    MarkKline = 2,
+    IndexKline = 3,
+};
+
+/// One completed file load reported to `DatasetLoadOptions::on_progress`.
+struct DatasetLoadProgress {
+    /// Files finished so far, including this one.
+    size_t completed_files{ 0 };
+    /// Files scheduled for this load.
+    size_t total_files{ 0 };
+    /// Dataset position in the input vector.
+    size_t symbol_index{ 0 };
+    const std::string* symbol{ nullptr };
+    const std::string* path{ nullptr };
+    DatasetStream stream{ DatasetStream::TradeKline };
+};
+
+/// Parallel dataset loading knobs.
+struct DatasetLoadOptions {
+    /// Worker threads; 0 selects `std::thread::hardware_concurrency()`.
+    /// Capped by the number of files; 1 loads inline on the calling thread.
+    size_t max_parallelism{ 0 };
+    /// Optional completion callback; calls are serialized, `completed_files` is monotonic,
+    /// and the callback runs on worker threads so it must not throw.
+    std::function<void(const DatasetLoadProgress&)> on_progress;
+    /// Resident-bar budget for replay streaming over memory-mapped series; 0 keeps
+    /// whole series resident. Only effective when the binary cache is enabled.
+    size_t replay_chunk_budget_bytes{ 0 };
+};
+
+/// Loaded replay datasets. Pool order and ids are independent of completion order.
+struct LoadedDatasets {
+    /// One entry per input dataset, in input order.
+    std::vector<MarketData> market_data;
+    std::vector<FundingRateData> funding_data_pool;
+    std::vector<ReferenceKlineData> mark_data_pool;
+    std::vector<ReferenceKlineData> index_data_pool;
+    /// Pool index per input dataset, -1 when the stream is absent.
+    std::vector<int32_t> funding_data_id_by_symbol;
+    std::vector<int32_t> mark_data_id_by_symbol;
+    std::vector<int32_t> index_data_id_by_symbol;
+};
+
+/// Loads every kline/funding/mark/index file of `datasets` on a bounded worker pool.
+/// Each file is one task, so a slow share (e.g. NAS latency) overlaps with others.
+/// If any load throws, no further files are started and the exception of the
+/// lowest-ordered failed file is rethrown after all workers stop.
+LoadedDatasets LoadDatasets(
+    const std::vector<Contracts::SymbolDataset>& datasets,
+    const DatasetLoadOptions& options = {});
+
+} // namespace QTrading::Infra::Exchanges::BinanceSim::Bootstrap
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace QTrading::Infra::Exchanges::BinanceSim::State {
+struct ExchangeSnapshot;
+}
+
+namespace QTrading::Infra::Exchanges::BinanceSim::Bootstrap {
+
+/// Leading bytes of every exchange checkpoint.
+inline constexpr char kExchangeCheckpointMagic[8] = { 'Q', 'T', 'R', 'C', 'K', 'P', 'T', '\0' };
+
+/// On-disk format version; bump whenever the layout changes.
+inline constexpr uint32_t kExchangeCheckpointFormatVersion = 2;
+
+/// Writes the mutable state of `snapshot` (ledgers, books, async acks, deferred commands,
+/// replay/funding/reference cursors and read-model caches) in host byte order.
+/// Replay series are only fingerprinted by symbol and row count; restore reloads them.
+/// `extension` is stored verbatim for the caller, e.g. serialized strategy state.
+void WriteExchangeCheckpoint(
+    std::ostream& out,
+    const State::ExchangeSnapshot& snapshot,
+    std::string_view extension = {});
+
+/// Overlays a checkpoint onto `snapshot`, which must hold freshly loaded state for the
+/// same datasets. Timeline merge structures are left for the caller to rebuild.
+/// @return The extension bytes stored by the writer.
+/// @throws std::runtime_error when the input is truncated, of another format version,
+///         or was written for different datasets.
+std::string ReadExchangeCheckpoint(std::istream& in, State::ExchangeSnapshot& snapshot);
+
+} // namespace QTrading::Infra::Exchanges::BinanceSim::Bootstrap
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 #include "Exchanges/BinanceSimulator/Contracts/BinanceExchangeRuntimeTypes.hpp"
@@ -22,11 +23,48 @@ enum class KlineVolumeSplitMode {
     OppositePassiveSplit = 1,
 };
 
+/// Strategy used to merge per-symbol replay timelines into steps.
+enum class ReplayMergeMode {
+    /// Lazy-deletion min-heaps over the next market and funding timestamps.
+    TimestampHeap = 0,
+    /// Next step timestamp folded into the per-step linear pass over all symbols;
+    /// no heap work, best when most symbols share each (minute) timestamp.
+    LinearCalendar = 1,
+    /// Presence/close panel over a dense minute grid, cut one replay window at a time; a step
+    /// visits only symbols with a row. Falls back to `LinearCalendar` for off-grid input.
+    MinuteGrid = 2,
+};
+
+/// Payload published when the position or order book changes.
+enum class BookChannelMode {
+    /// A full copy of the book on the position/order channels.
+    FullSnapshot = 0,
+    /// Only id-keyed changes on the position/order delta channels; consumers rebuild the
+    /// book with `BookReplica`. Publishing copies the changed entries, not the whole book.
+    Delta = 1,
+    /// Both of the above.
+    Both = 2,
+};
+
 struct SimulationConfig {
     SpotCommissionMode spot_commission_mode{ SpotCommissionMode::QuoteOnBuyQuoteOnSell };
     Contracts::FundingApplyTiming funding_apply_timing{ Contracts::FundingApplyTiming::BeforeMatching };
     IntraBarPathMode intra_bar_path_mode{ IntraBarPathMode::CloseMarketability };
     KlineVolumeSplitMode kline_volume_split_mode{ KlineVolumeSplitMode::TotalOnly };
+    ReplayMergeMode replay_merge_mode{ ReplayMergeMode::TimestampHeap };
+    /// Minutes per `ReplayMergeMode::MinuteGrid` panel window; bounds the panel to
+    /// O(window x symbols) whatever the replay length.
+    size_t replay_minute_grid_window_minutes{ 1440 };
+    /// Also fill the per-symbol optional rows of each `MultiKlineDto`, for consumers that
+    /// still index them directly. Off by default: payloads carry only the compact `frame`
+    /// and consumers read through the DTO accessors.
+    bool replay_row_payload_enabled{ false };
+    /// Threads sharding the symbol-local step phases (matching, funding accrual, perp mark
+    /// refresh, snapshot price rows, market event rows); 1 keeps them on the stepping thread,
+    /// 0 uses hardware concurrency. Fills, wallet deltas, account totals and dirty-row order are
+    /// settled serially in symbol order, so results match the serial path.
+    uint32_t step_worker_count{ 1 };
+    BookChannelMode book_channel_mode{ BookChannelMode::FullSnapshot };
     uint64_t intra_bar_random_seed{ 42ull };
     uint32_t intra_bar_monte_carlo_samples{ 1u };
     bool limit_fill_probability_enabled{ false };
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace QTrading::Infra::Exchanges::BinanceSim::Contracts {
+
+/// Trade-close threshold for one symbol; the bar whose close reaches either bound wakes the replay.
+struct PriceWake {
+    /// Symbol whose trade klines are watched.
+    std::string symbol;
+    /// Wake when the close is at or below this price.
+    double at_or_below{ -std::numeric_limits<double>::infinity() };
+    /// Wake when the close is at or above this price.
+    double at_or_above{ std::numeric_limits<double>::infinity() };
+};
+
+/// Strategy-provided condition that ends a fast-forward over idle replay frames.
+/// The first frame satisfying any member is materialized normally; with no member set
+/// an idle account fast-forwards to the end of the replay.
+struct WakeCondition {
+    /// Wake at the first frame at or after this exchange timestamp.
+    std::optional<uint64_t> wake_at_ts;
+    /// Wake at the next frame carrying a funding row for any symbol.
+    bool wake_on_funding{ false };
+    /// Per-symbol trade-close thresholds.
+    std::vector<PriceWake> price_wakes;
+};
+
+} // namespace QTrading::Infra::Exchanges::BinanceSim::Contracts
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "Dto/Trading/InstrumentSpec.hpp"
+#include "Dto/Trading/SymbolId.hpp"
 
 namespace QTrading::Dto::Market::Binance {
 struct MultiKlineDto;
@@ -25,6 +26,7 @@ namespace QTrading::Infra::Exchanges::BinanceSim::Domain {
 struct LiquidationPositionDelta {
     int64_t position_id{ 0 };
     std::string symbol;
+    QTrading::Dto::Trading::SymbolId interned_symbol_id{ QTrading::Dto::Trading::kInvalidSymbolId };
     QTrading::Dto::Trading::InstrumentType instrument_type{ QTrading::Dto::Trading::InstrumentType::Perp };
     bool is_long{ true };
     double entry_price{ 0.0 };
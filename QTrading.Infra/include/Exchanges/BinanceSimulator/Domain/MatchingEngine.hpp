@@ -7,6 +7,7 @@
 
 #include "Dto/Trading/InstrumentSpec.hpp"
 #include "Dto/Trading/Side.hpp"
+#include "Dto/Trading/SymbolId.hpp"
 
 namespace QTrading::Dto::Market::Binance {
 struct MultiKlineDto;
@@ -25,8 +26,8 @@ struct MatchFill {
     int order_id{ 0 };
     /// Runtime symbol id aligned to StepKernel symbol table when available.
     size_t symbol_id{ std::numeric_limits<size_t>::max() };
-    /// Symbol being matched.
-    std::string symbol;
+    /// Process-wide interned id of the matched symbol, copied from the originating order.
+    QTrading::Dto::Trading::SymbolId interned_symbol_id{ QTrading::Dto::Trading::kInvalidSymbolId };
     /// Instrument lane for the fill.
     QTrading::Dto::Trading::InstrumentType instrument_type{ QTrading::Dto::Trading::InstrumentType::Perp };
     /// Executed side of the originating order.
@@ -59,6 +60,12 @@ struct MatchFill {
     double price{ 0.0 };
 };
 
+/// Symbol text of a fill, resolved only where fee overrides, logs or outward DTOs need it.
+inline const std::string& fill_symbol_name(const MatchFill& fill)
+{
+    return QTrading::Dto::Trading::SymbolTable::Name(fill.interned_symbol_id);
+}
+
 /// Minimal matching engine for the current restored execution path.
 /// Supports market/limit matching and partial/no-fill based on bar liquidity.
 class MatchingEngine final {
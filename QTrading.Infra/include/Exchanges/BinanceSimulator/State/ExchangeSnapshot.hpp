@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Exchanges/BinanceSimulator/Account/Account.hpp"
+#include "Exchanges/BinanceSimulator/State/BinanceExchangeRuntimeState.hpp"
+#include "Exchanges/BinanceSimulator/State/SnapshotState.hpp"
+#include "Exchanges/BinanceSimulator/State/StepKernelState.hpp"
+
+namespace QTrading::Infra::Exchanges::BinanceSim::State {
+
+/// Frozen copy of a running exchange taken between steps, used to fork what-if branches.
+/// Mutable state (account, books, cursors, read-model caches) is copied; replay series keep
+/// sharing their column storage, so a snapshot costs the mutable state size, not the history.
+/// Per-exchange resources are detached: no logger, no read-ahead, no worker pool and an
+/// empty payload pool. A forked exchange recreates its pool and channels, and rebuilds the
+/// read-ahead from `step.replay_chunk_budget_bytes`, resuming at the copied replay cursors.
+struct ExchangeSnapshot {
+    Account account;
+    BinanceExchangeRuntimeState runtime;
+    StepKernelState step;
+    SnapshotState snapshot;
+};
+
+} // namespace QTrading::Infra::Exchanges::BinanceSim::State
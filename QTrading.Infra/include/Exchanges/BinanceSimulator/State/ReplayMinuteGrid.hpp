@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace QTrading::Infra::Exchanges::BinanceSim::State {
+
+/// Dense symbol x minute panel over one replay window.
+/// Minute `m` is timestamp `base_ts + m * step_ms`. Every presence stream stores
+/// `words_per_minute` 64-bit words per minute, minute-major, bit `i` = symbol id `i`.
+struct ReplayMinuteGrid {
+    uint64_t base_ts{ 0 };
+    uint64_t step_ms{ 60'000 };
+    /// Minutes up to and including the window's last trade/funding row.
+    size_t minute_count{ 0 };
+    size_t symbol_count{ 0 };
+    size_t words_per_minute{ 0 };
+    /// Trade kline opening exactly at the minute.
+    std::vector<uint64_t> trade_presence;
+    /// Funding row due exactly at the minute.
+    std::vector<uint64_t> funding_presence;
+    /// Mark row with timestamp in (previous minute, minute]; earlier rows land on minute 0.
+    std::vector<uint64_t> mark_presence;
+    /// Index row with timestamp in (previous minute, minute]; earlier rows land on minute 0.
+    std::vector<uint64_t> index_presence;
+    /// Trade close per minute, `symbol_count` values per minute, NaN without a kline.
+    std::vector<double> trade_close;
+
+    uint64_t minute_ts(size_t minute) const noexcept { return base_ts + static_cast<uint64_t>(minute) * step_ms; }
+
+    const uint64_t* trade_words(size_t minute) const noexcept { return trade_presence.data() + minute * words_per_minute; }
+    const uint64_t* funding_words(size_t minute) const noexcept { return funding_presence.data() + minute * words_per_minute; }
+    const uint64_t* mark_words(size_t minute) const noexcept { return mark_presence.data() + minute * words_per_minute; }
+    const uint64_t* index_words(size_t minute) const noexcept { return index_presence.data() + minute * words_per_minute; }
+
+    /// Cross-section of trade closes at `minute`, in symbol-id order.
+    std::span<const double> close_row(size_t minute) const noexcept
+    {
+        return { trade_close.data() + minute * symbol_count, symbol_count };
+    }
+
+    /// First minute >= `from` with a trade or funding row, or `minute_count`.
+    size_t next_step_minute(size_t from) const noexcept
+    {
+        for (size_t minute = from; minute < minute_count; ++minute) {
+            const uint64_t* trade = trade_words(minute);
+            const uint64_t* funding = funding_words(minute);
+            for (size_t w = 0; w < words_per_minute; ++w) {
+                if ((trade[w] | funding[w]) != 0) {
+                    return minute;
+                }
+            }
+        }
+        return minute_count;
+    }
+
+    /// Heap bytes held by the panel.
+    size_t bytes() const noexcept
+    {
+        return (trade_presence.size() + funding_presence.size() + mark_presence.size() + index_presence.size()) *
+            sizeof(uint64_t) +
+            trade_close.size() * sizeof(double);
+    }
+};
+
+} // namespace QTrading::Infra::Exchanges::BinanceSim::State
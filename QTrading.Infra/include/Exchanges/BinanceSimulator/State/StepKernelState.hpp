@@ -12,16 +12,27 @@
 
 #include "Data/Binance/MarketData.hpp"
 #include "Data/Binance/FundingRateData.hpp"
+#include "Data/Binance/ReferenceKlineData.hpp"
+#include "Data/Binance/ReplayReadAhead.hpp"
 #include "Dto/Market/Binance/MultiKline.hpp"
 #include "Dto/Market/Binance/FundingRate.hpp"
 #include "Dto/Order.hpp"
 #include "Dto/Position.hpp"
+#include "Dto/Trading/SymbolId.hpp"
 #include "Exchanges/BinanceSimulator/Account/Config.hpp"
+#include "Exchanges/BookReplica.hpp"
+#include "Exchanges/BinanceSimulator/Config/BinanceSimulationConfig.hpp"
 #include "Exchanges/BinanceSimulator/Contracts/BinanceExchangeDiagnostics.hpp"
 #include "Exchanges/BinanceSimulator/Contracts/BinanceExchangeRuntimeTypes.hpp"
 #include "Exchanges/BinanceSimulator/Domain/MatchingEngine.hpp"
+#include "Exchanges/BinanceSimulator/State/ReplayMinuteGrid.hpp"
 #include "Exchanges/BinanceSimulator/State/StepKernelHeapTypes.hpp"
 
+namespace QTrading::Infra::Exchanges::BinanceSim::Application {
+class ReplayPrefetcher;
+class StepWorkerPool;
+}
+
 namespace QTrading::Infra::Exchanges::BinanceSim::State {
 
 /// Reusable replay payload buffer with touched-index tracking.
@@ -61,6 +72,10 @@ struct StepKernelState {
     /// Fixed replay symbol universe and associated market data.
     std::vector<std::string> symbols;
     std::unordered_map<std::string, size_t> symbol_to_id;
+    /// Process-wide interned id of each replay symbol.
+    std::vector<QTrading::Dto::Trading::SymbolId> interned_symbol_id_by_id;
+    /// Replay symbol id by interned id; max() for interned symbols outside this universe.
+    std::vector<size_t> symbol_id_by_interned_id;
     std::vector<QTrading::Dto::Trading::InstrumentType> symbol_instrument_type_by_id;
     std::vector<QTrading::Dto::Trading::InstrumentSpec> symbol_spec_by_id;
     /// Optional symbol-level maintenance brackets; empty entry falls back to global `margin_tiers`.
@@ -68,14 +83,21 @@ struct StepKernelState {
     std::shared_ptr<const std::vector<std::string>> symbols_shared;
     std::vector<MarketData> market_data;
     std::vector<FundingRateData> funding_data_pool;
-    std::vector<MarketData> mark_data_pool;
-    std::vector<MarketData> index_data_pool;
+    std::vector<ReferenceKlineData> mark_data_pool;
+    std::vector<ReferenceKlineData> index_data_pool;
+    /// Optional bounded-residency streaming over memory-mapped series; null when disabled.
+    std::shared_ptr<QTrading::Infra::Data::Binance::ReplayReadAhead> replay_read_ahead;
+    /// Resident budget `replay_read_ahead` streams within; forks and restores rebuild theirs from it.
+    size_t replay_chunk_budget_bytes{ 0 };
     std::vector<int32_t> funding_data_id_by_symbol;
     std::vector<int32_t> mark_data_id_by_symbol;
     std::vector<int32_t> index_data_id_by_symbol;
     std::vector<size_t> funding_cursor_by_symbol;
     std::vector<size_t> mark_cursor_by_symbol;
     std::vector<size_t> index_cursor_by_symbol;
+    /// Forward lookup hints for mark/index interpolation; any value is valid, stale ones cost a search.
+    std::vector<size_t> mark_interp_cursor_by_symbol;
+    std::vector<size_t> index_interp_cursor_by_symbol;
     std::vector<uint64_t> next_funding_ts_by_symbol;
     std::vector<uint64_t> next_mark_ts_by_symbol;
     std::vector<uint64_t> next_index_ts_by_symbol;
@@ -94,6 +116,24 @@ struct StepKernelState {
     std::vector<uint8_t> has_next_ts;
     std::priority_queue<StepKernelHeapItem, std::vector<StepKernelHeapItem>, StepKernelHeapItemGreater> next_ts_heap;
     std::priority_queue<StepKernelHeapItem, std::vector<StepKernelHeapItem>, StepKernelHeapItemGreater> next_funding_ts_heap;
+    /// Active timeline merge strategy; heaps are only maintained in `TimestampHeap` mode.
+    Config::ReplayMergeMode replay_merge_mode{ Config::ReplayMergeMode::TimestampHeap };
+    /// `LinearCalendar` mode: earliest pending market/funding timestamp after the last step.
+    uint64_t calendar_next_ts{ std::numeric_limits<uint64_t>::max() };
+    /// `LinearCalendar` mode: false until `calendar_next_ts` reflects the current cursors.
+    bool calendar_next_ts_valid{ false };
+    /// `MinuteGrid` mode: minutes per panel window.
+    size_t replay_minute_grid_window_minutes{ 1440 };
+    /// `MinuteGrid` mode: panel window cut at the cursors; null when that window does not fit
+    /// the grid, in which case replay runs `LinearCalendar` until the cursors are repositioned.
+    std::shared_ptr<const ReplayMinuteGrid> replay_minute_grid;
+    /// `MinuteGrid` mode: first grid minute not yet replayed.
+    size_t replay_grid_minute{ 0 };
+    /// Panel window of the frame being stepped and its minute; null outside `MinuteGrid` mode.
+    std::shared_ptr<const ReplayMinuteGrid> step_minute_grid;
+    size_t step_minute_grid_minute{ 0 };
+    /// `MinuteGrid` mode: scratch union of reference presence words across skipped minutes.
+    std::vector<uint64_t> replay_grid_words_scratch;
     /// SoA cache: whether current step has trade kline per symbol.
     std::vector<uint8_t> replay_has_trade_kline_by_symbol;
     /// SoA cache: current-step trade open price per symbol.
@@ -143,25 +183,27 @@ struct StepKernelState {
     bool has_resolved_log_module_ids{ false };
     /// Last account version already published to the outward channels.
     uint64_t last_published_account_state_version{ 0 };
-    /// Last published position snapshot used by channel gating.
-    std::vector<QTrading::dto::Position> last_published_positions;
-    /// Last published order snapshot used by channel gating.
-    std::vector<QTrading::dto::Order> last_published_orders;
+    /// Position book as last published on the delta channel; the next delta is diffed against it.
+    /// Belongs to the channel consumer's view, so checkpoints leave it alone and forks reset it.
+    PositionBookReplica published_position_book;
+    /// Order book as last published on the delta channel.
+    OrderBookReplica published_order_book;
     /// Last observed order-book version that has been channel-published.
     uint64_t last_published_orders_version{ 0 };
     /// Last observed position-book version that has been channel-published.
     uint64_t last_published_positions_version{ 0 };
     bool has_published_positions{ false };
     bool has_published_orders{ false };
-    /// Last event-emitted position snapshot used for reduced event diffs.
-    std::vector<QTrading::dto::Position> last_event_positions;
-    /// Last event-emitted order snapshot used for reduced event diffs.
-    std::vector<QTrading::dto::Order> last_event_orders;
-    /// Position snapshot captured at step entry for same-step comparisons.
+    /// Set by checkpoint restore: the next publication re-seeds fresh channel consumers with the
+    /// current books, but books the checkpointed run already logged are not logged again.
+    bool republish_restored_books{ false };
+    /// Position book as of the last reduced event emission; only changed entries are re-copied.
+    PositionBookReplica event_position_book;
+    /// Order book as of the last reduced event emission.
+    OrderBookReplica event_order_book;
+    /// Position snapshot captured at step entry; baseline of the first event diff only.
     std::vector<QTrading::dto::Position> step_entry_positions;
-    /// Order snapshot captured at step entry for same-step comparisons.
-    std::vector<QTrading::dto::Order> step_entry_orders;
-    /// Position snapshot captured immediately after funding application.
+    /// Position snapshot captured when funding is applied, on steps that carry funding rows.
     std::vector<QTrading::dto::Position> funding_apply_positions;
     bool has_funding_apply_positions{ false };
     /// True when current-step event snapshots have been materialized.
@@ -197,6 +239,22 @@ struct StepKernelState {
     std::vector<double> matching_reducible_long_scratch;
     /// Scratch reducible-short quantities used by reduce-only checks.
     std::vector<double> matching_reducible_short_scratch;
+    /// Scratch fill slot per open order, filled by symbol shards and emitted serially.
+    std::vector<Domain::MatchFill> matching_fill_by_order_scratch;
+    /// Scratch flags paired with `matching_fill_by_order_scratch`.
+    std::vector<uint8_t> matching_has_fill_by_order_scratch;
+    /// Scratch per-symbol `Domain::FundingDecisionAction` of this step's funding row (-1: none).
+    std::vector<int8_t> funding_action_scratch;
+    /// Scratch per-symbol resolved funding mark prices.
+    std::vector<double> funding_mark_price_scratch;
+    /// Scratch per-symbol funding diagnostics, published in symbol order.
+    std::vector<Contracts::ReferenceFundingResolverDiagnostic> funding_diagnostic_scratch;
+    /// Scratch per-position funding wallet deltas.
+    std::vector<double> funding_delta_by_position_scratch;
+    /// Scratch per-position funded symbol id (`SIZE_MAX`: not funded this step).
+    std::vector<size_t> funding_symbol_by_position_scratch;
+    /// Scratch position indices in the order funding deltas reach the wallet.
+    std::vector<size_t> funding_apply_order_scratch;
     /// Scratch mark prices used by liquidation evaluation.
     std::vector<double> liquidation_mark_price_scratch;
     /// Scratch mark-availability flags used by liquidation evaluation.
@@ -205,6 +263,54 @@ struct StepKernelState {
     std::vector<ReplayPayloadBuffer> replay_payload_pool;
     /// Round-robin cursor for selecting next reusable replay payload buffer.
     size_t replay_payload_pool_cursor{ 0 };
+    /// Also fill the per-symbol optional rows of pooled payloads; the frame is always filled.
+    bool replay_row_payload_enabled{ false };
+    /// Workers for symbol-local step phases; null runs them on the stepping thread.
+    std::shared_ptr<Application::StepWorkerPool> step_worker_pool;
+    /// Scratch flags: position contributed to the perp mark totals this step.
+    std::vector<uint8_t> mark_refresh_contributed_scratch;
+    /// Scratch per-symbol snapshot price changes (bit 0 trade, bit 1 mark, bit 2 index).
+    std::vector<uint8_t> snapshot_price_changed_scratch;
+    /// Scratch market-event mark prices per symbol, resolved before serial logging.
+    std::vector<double> market_event_mark_price_scratch;
+    /// Scratch `Contracts::ReferencePriceSource` of `market_event_mark_price_scratch`.
+    std::vector<int32_t> market_event_mark_source_scratch;
+    /// Scratch market-event index prices per symbol, resolved before serial logging.
+    std::vector<double> market_event_index_price_scratch;
+    /// Scratch `Contracts::ReferencePriceSource` of `market_event_index_price_scratch`.
+    std::vector<int32_t> market_event_index_source_scratch;
+    /// True while `replay_prefetcher` holds a frame assembled ahead of the step consuming it.
+    bool replay_prefetch_pending{ false };
+    /// Trade/mark/index cursors of the last completed step; order entry prices from these
+    /// while `replay_prefetch_pending` is set, since the live cursors already moved on.
+    std::vector<size_t> committed_replay_cursor;
+    std::vector<size_t> committed_mark_cursor_by_symbol;
+    std::vector<size_t> committed_index_cursor_by_symbol;
+    /// Pipelined-stepping frame builder; null until first used. Declared last so its thread
+    /// is joined before the members it writes are destroyed.
+    std::shared_ptr<Application::ReplayPrefetcher> replay_prefetcher;
 };
 
+/// Replay symbol id of an order/position/fill symbol.
+/// Indexes `symbol_id_by_interned_id` when `interned` is covered by it and only hashes
+/// `symbol` for entries built without an interned id or symbols interned after the table.
+inline std::optional<size_t> find_symbol_id(
+    const StepKernelState& state,
+    QTrading::Dto::Trading::SymbolId interned,
+    const std::string& symbol)
+{
+    if (interned < state.symbol_id_by_interned_id.size()) {
+        const size_t symbol_id = state.symbol_id_by_interned_id[interned];
+        if (symbol_id == std::numeric_limits<size_t>::max()) {
+            return std::nullopt;
+        }
+        return symbol_id;
+    }
+    const auto it = state.symbol_to_id.find(symbol);
+    if (it == state.symbol_to_id.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
 } // namespace QTrading::Infra::Exchanges::BinanceSim::State
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Dto/BookDelta.hpp"
+
+namespace QTrading::Infra::Exchanges {
+
+    /// @brief Id-keyed copy of a position or order book, maintained from `BookDelta` messages.
+    /// @details Consumers of the delta channels apply every received delta to rebuild the full
+    ///          book; the publisher keeps one as the baseline it diffs the live book against.
+    ///          Entries keep the order they were first added in. Ids must be unique within a book.
+    /// @tparam T Entry type with an `int id` member and field-wise `operator==`.
+    template <typename T>
+    class BookReplica {
+    public:
+        using value_type = T;
+
+        /// @brief Applies `delta` when it is the next in sequence.
+        /// @return False, leaving the book untouched, on a sequence gap or a replayed delta.
+        bool apply(const QTrading::dto::BookDelta<T>& delta) { return apply_impl(delta); }
+        /// @copydoc apply
+        bool apply(QTrading::dto::BookDelta<T>&& delta) { return apply_impl(std::move(delta)); }
+
+        /// @brief Builds the delta turning this book into `current`, numbered `seq() + 1`.
+        /// @details Only entries that were added or changed are copied; the book is not modified.
+        QTrading::dto::BookDelta<T> diff(const std::vector<T>& current) const
+        {
+            QTrading::dto::BookDelta<T> delta{};
+            delta.seq = seq_ + 1;
+            size_t matched = 0;
+            for (const auto& entry : current) {
+                const auto it = slot_by_id_.find(entry.id);
+                if (it == slot_by_id_.end()) {
+                    delta.added.push_back(entry);
+                    continue;
+                }
+                ++matched;
+                if (!(entries_[it->second] == entry)) {
+                    delta.updated.push_back(entry);
+                }
+            }
+            if (matched == entries_.size()) {
+                return delta;
+            }
+            // Some entries left: mark the survivors and report the rest in book order.
+            std::vector<bool> kept(entries_.size(), false);
+            for (const auto& entry : current) {
+                const auto it = slot_by_id_.find(entry.id);
+                if (it != slot_by_id_.end()) {
+                    kept[it->second] = true;
+                }
+            }
+            for (size_t slot = 0; slot < entries_.size(); ++slot) {
+                if (!kept[slot]) {
+                    delta.removed_ids.push_back(entries_[slot].id);
+                }
+            }
+            return delta;
+        }
+
+        /// @brief Replaces the whole book; the next expected delta is `seq + 1`.
+        void reset(std::vector<T> entries = {}, uint64_t seq = 0)
+        {
+            entries_ = std::move(entries);
+            seq_ = seq;
+            reindex();
+        }
+
+        /// @brief Current entries in first-added order.
+        const std::vector<T>& entries() const noexcept { return entries_; }
+        /// @brief Entry with `id`, or nullptr.
+        const T* find(int id) const
+        {
+            const auto it = slot_by_id_.find(id);
+            return it == slot_by_id_.end() ? nullptr : &entries_[it->second];
+        }
+        /// @brief Sequence number of the last applied delta; 0 before the first.
+        uint64_t seq() const noexcept { return seq_; }
+        size_t size() const noexcept { return entries_.size(); }
+        bool empty() const noexcept { return entries_.empty(); }
+
+    private:
+        template <typename Delta>
+        bool apply_impl(Delta&& delta)
+        {
+            if (delta.seq != seq_ + 1) {
+                return false;
+            }
+            // Moves entries out of an rvalue delta, copies them out of a const one.
+            using Entry = std::conditional_t<std::is_const_v<std::remove_reference_t<Delta>>, const T&, T&&>;
+            if (!delta.removed_ids.empty()) {
+                for (const int id : delta.removed_ids) {
+                    slot_by_id_.erase(id);
+                }
+                size_t out = 0;
+                for (size_t slot = 0; slot < entries_.size(); ++slot) {
+                    if (slot_by_id_.find(entries_[slot].id) == slot_by_id_.end()) {
+                        continue;
+                    }
+                    if (out != slot) {
+                        entries_[out] = std::move(entries_[slot]);
+                    }
+                    ++out;
+                }
+                entries_.resize(out);
+                reindex();
+            }
+            for (auto& entry : delta.updated) {
+                upsert(static_cast<Entry>(entry));
+            }
+            for (auto& entry : delta.added) {
+                upsert(static_cast<Entry>(entry));
+            }
+            seq_ = delta.seq;
+            return true;
+        }
+
+        template <typename Entry>
+        void upsert(Entry&& entry)
+        {
+            const auto it = slot_by_id_.find(entry.id);
+            if (it != slot_by_id_.end()) {
+                entries_[it->second] = std::forward<Entry>(entry);
+                return;
+            }
+            slot_by_id_.emplace(entry.id, entries_.size());
+            entries_.push_back(std::forward<Entry>(entry));
+        }
+
+        void reindex()
+        {
+            slot_by_id_.clear();
+            slot_by_id_.reserve(entries_.size());
+            for (size_t slot = 0; slot < entries_.size(); ++slot) {
+                slot_by_id_.emplace(entries_[slot].id, slot);
+            }
+        }
+
+        std::vector<T> entries_;
+        std::unordered_map<int, size_t> slot_by_id_;
+        uint64_t seq_{ 0 };
+    };
+
+    using PositionBookReplica = BookReplica<QTrading::dto::Position>;
+    using OrderBookReplica = BookReplica<QTrading::dto::Order>;
+
+}  // namespace QTrading::Infra::Exchanges
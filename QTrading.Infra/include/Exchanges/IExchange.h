@@ -2,9 +2,9 @@
 
 #include <memory>
 #include <string>
+#include "Dto/BookDelta.hpp"
 #include "Dto/Order.hpp"
 #include "Dto/Position.hpp"
-#include "Global.hpp"
 #include "Queue/Channel.hpp"
 
 namespace QTrading::Infra::Exchanges {
@@ -22,6 +22,12 @@ namespace QTrading::Infra::Exchanges {
 		/// @brief Get the channel for publishing order updates.
 		/// @return Shared pointer to the order channel.
 		std::shared_ptr<QTrading::Utils::Queue::Channel<std::vector<QTrading::dto::Order>>>              get_order_channel()    const { return order_channel; }
+		/// @brief Get the channel for incremental position-book deltas, if the exchange publishes them.
+		/// @return Shared pointer to the position delta channel (may be null).
+		std::shared_ptr<QTrading::Utils::Queue::Channel<QTrading::dto::PositionBookDelta>>               get_position_delta_channel() const { return position_delta_channel; }
+		/// @brief Get the channel for incremental order-book deltas, if the exchange publishes them.
+		/// @return Shared pointer to the order delta channel (may be null).
+		std::shared_ptr<QTrading::Utils::Queue::Channel<QTrading::dto::OrderBookDelta>>                  get_order_delta_channel()    const { return order_delta_channel; }
 
 		/// @brief Advance the simulation by one step (e.g., one time tick).
 		/// @return True if new market data was emitted; false if data is exhausted.
@@ -52,24 +58,22 @@ namespace QTrading::Infra::Exchanges {
 			return 1.0;
 		}
 
-		/// @brief Close all public channels (market, positions, orders).
+		/// @brief Close all public channels (market, positions, orders and their deltas).
 		virtual void close()
 		{
 			/// Default implementation: close each channel if still open.
 			if (market_channel && !market_channel->IsClosed())   market_channel->Close();
 			if (position_channel && !position_channel->IsClosed()) position_channel->Close();
 			if (order_channel && !order_channel->IsClosed())    order_channel->Close();
+			if (position_delta_channel && !position_delta_channel->IsClosed()) position_delta_channel->Close();
+			if (order_delta_channel && !order_delta_channel->IsClosed())    order_delta_channel->Close();
 		}
 
 	protected:
 		std::shared_ptr<QTrading::Utils::Queue::Channel<TMarket>>             market_channel;      ///< Channel for market snapshots.
 		std::shared_ptr<QTrading::Utils::Queue::Channel<std::vector<QTrading::dto::Position>>> position_channel;  ///< Channel for position updates.
 		std::shared_ptr<QTrading::Utils::Queue::Channel<std::vector<QTrading::dto::Order>>>    order_channel;     ///< Channel for order updates.
-
-		/// @brief Update the global timestamp for logging.
-		/// @param ts New timestamp value (e.g., milliseconds since epoch).
-		void set_global_timestamp(unsigned long long &ts) {
-			QTrading::Utils::GlobalTimestamp.store(ts, std::memory_order_release);
-		}
+		std::shared_ptr<QTrading::Utils::Queue::Channel<QTrading::dto::PositionBookDelta>>     position_delta_channel; ///< Channel for position-book deltas.
+		std::shared_ptr<QTrading::Utils::Queue::Channel<QTrading::dto::OrderBookDelta>>        order_delta_channel;    ///< Channel for order-book deltas.
     };
 }
@@ -0,0 +1,431 @@
+#include "Data/Binance/BinaryCache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+using QTrading::Dto::Market::Binance::FundingRateDto;
+
+namespace QTrading::Infra::Data::Binance {
+namespace {
+
+constexpr std::array<char, 8> kMagic{ 'Q', 'T', 'R', 'C', 'A', 'C', 'H', 'E' };
+constexpr uint32_t kByteOrderMark = 0x01020304u;
+constexpr uint64_t kColumnAlignment = 64;
+
+/// Fixed-size file prologue; followed by the source path bytes and the column block.
+struct CacheFileHeader {
+    std::array<char, 8> magic{};
+    uint32_t byte_order{ 0 };
+    uint32_t format_version{ 0 };
+    uint32_t stream_kind{ 0 };
+    uint32_t column_count{ 0 };
+    uint64_t source_bytes{ 0 };
+    int64_t source_mtime{ 0 };
+    uint64_t row_count{ 0 };
+    uint64_t source_path_bytes{ 0 };
+    uint64_t data_offset{ 0 };
+    uint64_t file_bytes{ 0 };
+};
+static_assert(sizeof(CacheFileHeader) == 72, "CacheFileHeader layout must stay stable");
+
+constexpr std::array<uint64_t, static_cast<size_t>(KlineCacheColumn::Count)> kKlineElementBytes{
+    sizeof(uint64_t), sizeof(double), sizeof(double), sizeof(double), sizeof(double), sizeof(double),
+    sizeof(uint64_t), sizeof(double), sizeof(int32_t), sizeof(double), sizeof(double)
+};
+
+constexpr std::array<uint64_t, static_cast<size_t>(FundingCacheColumn::Count)> kFundingElementBytes{
+    sizeof(uint64_t), sizeof(double), sizeof(double), sizeof(uint8_t)
+};
+
+constexpr uint64_t align_up(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+std::span<const uint64_t> element_bytes_for(CacheStreamKind kind)
+{
+    switch (kind) {
+    case CacheStreamKind::TradeKline:
+        return kKlineElementBytes;
+    case CacheStreamKind::FundingRate:
+        return kFundingElementBytes;
+    }
+    return {};
+}
+
+/// Computes column offsets (relative to file start) and the total file size.
+uint64_t layout_columns(
+    uint64_t data_offset,
+    uint64_t row_count,
+    std::span<const uint64_t> element_bytes,
+    std::vector<uint64_t>& offsets)
+{
+    offsets.clear();
+    offsets.reserve(element_bytes.size());
+    uint64_t cursor = data_offset;
+    for (const auto bytes : element_bytes) {
+        cursor = align_up(cursor, kColumnAlignment);
+        offsets.push_back(cursor);
+        cursor += bytes * row_count;
+    }
+    return align_up(cursor, kColumnAlignment);
+}
+
+// FNV-1a keeps cache names stable across compilers, unlike std::hash.
+uint64_t fnv1a64(std::string_view text, uint64_t seed = 1469598103934665603ull)
+{
+    uint64_t hash = seed;
+    for (const unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+const char* stream_suffix(CacheStreamKind kind)
+{
+    return kind == CacheStreamKind::FundingRate ? ".funding.qtrc" : ".klines.qtrc";
+}
+
+class CacheFileWriter {
+public:
+    CacheFileWriter(const std::filesystem::path& cache_file, const CacheSourceStamp& stamp,
+        CacheStreamKind kind, uint64_t row_count)
+        : cache_file_(cache_file)
+    {
+        header_.magic = kMagic;
+        header_.byte_order = kByteOrderMark;
+        header_.format_version = kBinaryCacheFormatVersion;
+        header_.stream_kind = static_cast<uint32_t>(kind);
+        const auto element_bytes = element_bytes_for(kind);
+        header_.column_count = static_cast<uint32_t>(element_bytes.size());
+        header_.source_bytes = stamp.source_bytes;
+        header_.source_mtime = stamp.source_mtime;
+        header_.row_count = row_count;
+        header_.source_path_bytes = stamp.source_path.size();
+        header_.data_offset = align_up(sizeof(CacheFileHeader) + stamp.source_path.size(), kColumnAlignment);
+        header_.file_bytes = layout_columns(header_.data_offset, row_count, element_bytes, offsets_);
+        source_path_ = stamp.source_path;
+    }
+
+    /// Appends one column; columns must be written in layout order.
+    template <typename T, typename Projection>
+    void write_column(const std::vector<T>& rows, Projection&& projection)
+    {
+        if (!out_) {
+            return;
+        }
+        pad_to(offsets_[next_column_++]);
+        constexpr size_t kChunkRows = 4096;
+        using Value = std::invoke_result_t<Projection, const T&>;
+        std::vector<Value> chunk;
+        chunk.reserve(std::min(kChunkRows, rows.size()));
+        for (size_t i = 0; i < rows.size(); i += kChunkRows) {
+            chunk.clear();
+            const size_t end = std::min(rows.size(), i + kChunkRows);
+            for (size_t r = i; r < end; ++r) {
+                chunk.push_back(projection(rows[r]));
+            }
+            write_bytes(chunk.data(), chunk.size() * sizeof(Value));
+        }
+    }
+
+    /// Appends a column that is already contiguous; same ordering rule as write_column.
+    template <typename T>
+    void write_values(const std::vector<T>& values)
+    {
+        if (!out_) {
+            return;
+        }
+        pad_to(offsets_[next_column_++]);
+        write_bytes(values.data(), values.size() * sizeof(T));
+    }
+
+    bool open()
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(cache_file_.parent_path(), ec);
+        const auto nonce = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+            static_cast<size_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        temp_file_ = cache_file_;
+        temp_file_ += ".tmp" + std::to_string(nonce);
+        out_.open(temp_file_, std::ios::binary | std::ios::trunc);
+        if (!out_) {
+            return false;
+        }
+        write_bytes(&header_, sizeof(header_));
+        write_bytes(source_path_.data(), source_path_.size());
+        return static_cast<bool>(out_);
+    }
+
+    bool commit()
+    {
+        if (!out_) {
+            discard();
+            return false;
+        }
+        pad_to(header_.file_bytes);
+        out_.close();
+        if (!out_) {
+            discard();
+            return false;
+        }
+        std::error_code ec;
+        std::filesystem::rename(temp_file_, cache_file_, ec);
+        if (ec) {
+            // Another process may hold the previous file mapped (Windows); keep theirs.
+            discard();
+            return false;
+        }
+        return true;
+    }
+
+    ~CacheFileWriter()
+    {
+        if (out_.is_open()) {
+            out_.close();
+            discard();
+        }
+    }
+
+private:
+    void write_bytes(const void* data, size_t bytes)
+    {
+        out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        written_ += bytes;
+    }
+
+    void pad_to(uint64_t offset)
+    {
+        static constexpr std::array<char, kColumnAlignment> kZeros{};
+        while (written_ < offset) {
+            const uint64_t n = std::min<uint64_t>(offset - written_, kZeros.size());
+            write_bytes(kZeros.data(), static_cast<size_t>(n));
+        }
+    }
+
+    void discard()
+    {
+        std::error_code ec;
+        std::filesystem::remove(temp_file_, ec);
+    }
+
+    std::filesystem::path cache_file_;
+    std::filesystem::path temp_file_;
+    std::string source_path_;
+    CacheFileHeader header_{};
+    std::vector<uint64_t> offsets_;
+    size_t next_column_{ 0 };
+    uint64_t written_{ 0 };
+    std::ofstream out_;
+};
+
+} // namespace
+
+struct MappedCacheFile::Mapping {
+    boost::interprocess::file_mapping file;
+    boost::interprocess::mapped_region region;
+};
+
+MappedCacheFile::~MappedCacheFile() = default;
+
+std::shared_ptr<const MappedCacheFile> MappedCacheFile::Open(
+    const std::filesystem::path& cache_file,
+    const CacheSourceStamp& expected,
+    CacheStreamKind kind)
+{
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(cache_file, ec)) {
+        return nullptr;
+    }
+
+    std::shared_ptr<MappedCacheFile> out(new MappedCacheFile());
+    try {
+        auto mapping = std::make_unique<Mapping>();
+        mapping->file = boost::interprocess::file_mapping(
+            cache_file.c_str(), boost::interprocess::read_only);
+        mapping->region = boost::interprocess::mapped_region(
+            mapping->file, boost::interprocess::read_only);
+        out->mapping_ = std::move(mapping);
+    }
+    catch (const std::exception&) {
+        return nullptr;
+    }
+
+    const auto* base = static_cast<const std::byte*>(out->mapping_->region.get_address());
+    const uint64_t mapped_bytes = out->mapping_->region.get_size();
+    if (base == nullptr || mapped_bytes < sizeof(CacheFileHeader)) {
+        return nullptr;
+    }
+
+    CacheFileHeader header{};
+    std::memcpy(&header, base, sizeof(header));
+    const auto element_bytes = element_bytes_for(kind);
+    if (header.magic != kMagic ||
+        header.byte_order != kByteOrderMark ||
+        header.format_version != kBinaryCacheFormatVersion ||
+        header.stream_kind != static_cast<uint32_t>(kind) ||
+        header.column_count != element_bytes.size() ||
+        header.source_bytes != expected.source_bytes ||
+        header.source_mtime != expected.source_mtime ||
+        header.source_path_bytes != expected.source_path.size() ||
+        header.file_bytes != mapped_bytes ||
+        sizeof(CacheFileHeader) + header.source_path_bytes > mapped_bytes) {
+        return nullptr;
+    }
+    if (std::memcmp(base + sizeof(CacheFileHeader), expected.source_path.data(), expected.source_path.size()) != 0) {
+        return nullptr;
+    }
+
+    const uint64_t file_bytes = layout_columns(header.data_offset, header.row_count, element_bytes, out->column_offsets_);
+    if (file_bytes != header.file_bytes) {
+        return nullptr;
+    }
+
+    out->base_ = base;
+    out->row_count_ = static_cast<size_t>(header.row_count);
+    return out;
+}
+
+void AdviseMappedRange(const void* data, size_t bytes, MappedRangeAdvice advice) noexcept
+{
+    if (data == nullptr || bytes == 0) {
+        return;
+    }
+    const uintptr_t page = static_cast<uintptr_t>(boost::interprocess::mapped_region::get_page_size());
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(data);
+    const uintptr_t end = begin + bytes;
+    const uintptr_t first = advice == MappedRangeAdvice::WillNeed
+        ? begin / page * page
+        : (begin + page - 1) / page * page;
+    const uintptr_t last = advice == MappedRangeAdvice::WillNeed
+        ? (end + page - 1) / page * page
+        : end / page * page;
+    if (last <= first) {
+        return;
+    }
+    void* address = reinterpret_cast<void*>(first);
+    const size_t length = static_cast<size_t>(last - first);
+#ifdef _WIN32
+    if (advice == MappedRangeAdvice::WillNeed) {
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+        WIN32_MEMORY_RANGE_ENTRY range{ address, length };
+        (void)PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#endif
+    }
+    else {
+        // Unlocking pages that are not locked trims them from the working set.
+        (void)VirtualUnlock(address, length);
+    }
+#else
+    (void)::madvise(address, length, advice == MappedRangeAdvice::WillNeed ? MADV_WILLNEED : MADV_DONTNEED);
+#endif
+}
+
+std::optional<std::filesystem::path> ResolveCacheDirectory()
+{
+    const char* raw = std::getenv(kBinaryCacheDirEnv);
+    if (raw == nullptr || *raw == '\0') {
+        return std::nullopt;
+    }
+    return std::filesystem::path(raw);
+}
+
+std::optional<CacheSourceStamp> StampSource(const std::filesystem::path& source)
+{
+    std::error_code ec;
+    const auto absolute = std::filesystem::absolute(source, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    const auto bytes = std::filesystem::file_size(absolute, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    const auto mtime = std::filesystem::last_write_time(absolute, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+
+    const auto normalized = absolute.lexically_normal().generic_u8string();
+    CacheSourceStamp stamp{};
+    stamp.source_path.assign(reinterpret_cast<const char*>(normalized.data()), normalized.size());
+    stamp.source_bytes = static_cast<uint64_t>(bytes);
+    stamp.source_mtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+    return stamp;
+}
+
+std::filesystem::path CacheFilePath(
+    const std::filesystem::path& cache_dir,
+    const std::filesystem::path& source,
+    const CacheSourceStamp& stamp,
+    CacheStreamKind kind)
+{
+    static constexpr char kHex[] = "0123456789abcdef";
+    const uint64_t hash = fnv1a64(stamp.source_path, fnv1a64(stream_suffix(kind)));
+    std::string name = source.filename().string();
+    name.push_back('.');
+    for (int shift = 60; shift >= 0; shift -= 4) {
+        name.push_back(kHex[(hash >> shift) & 0xF]);
+    }
+    name += stream_suffix(kind);
+    return cache_dir / name;
+}
+
+bool WriteKlineCache(
+    const std::filesystem::path& cache_file,
+    const CacheSourceStamp& stamp,
+    const KlineColumnBuffers& columns)
+{
+    CacheFileWriter writer(cache_file, stamp, CacheStreamKind::TradeKline, columns.size());
+    if (!writer.open()) {
+        return false;
+    }
+    writer.write_values(columns.open_time);
+    writer.write_values(columns.open);
+    writer.write_values(columns.high);
+    writer.write_values(columns.low);
+    writer.write_values(columns.close);
+    writer.write_values(columns.volume);
+    writer.write_values(columns.close_time);
+    writer.write_values(columns.quote_volume);
+    writer.write_values(columns.trade_count);
+    writer.write_values(columns.taker_buy_base);
+    writer.write_values(columns.taker_buy_quote);
+    return writer.commit();
+}
+
+bool WriteFundingCache(
+    const std::filesystem::path& cache_file,
+    const CacheSourceStamp& stamp,
+    const std::vector<FundingRateDto>& rates)
+{
+    CacheFileWriter writer(cache_file, stamp, CacheStreamKind::FundingRate, rates.size());
+    if (!writer.open()) {
+        return false;
+    }
+    writer.write_column(rates, [](const FundingRateDto& r) { return r.FundingTime; });
+    writer.write_column(rates, [](const FundingRateDto& r) { return r.Rate; });
+    writer.write_column(rates, [](const FundingRateDto& r) { return r.MarkPrice.value_or(0.0); });
+    writer.write_column(rates, [](const FundingRateDto& r) { return static_cast<uint8_t>(r.MarkPrice.has_value() ? 1 : 0); });
+    return writer.commit();
+}
+
+} // namespace QTrading::Infra::Data::Binance
@@ -0,0 +1,73 @@
+#include "Data/Binance/CsvSeekIndex.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace QTrading::Infra::Data::Binance {
+namespace {
+
+struct CsvSeekIndexRegistry {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<const CsvSeekIndex>> by_path;
+};
+
+CsvSeekIndexRegistry& registry()
+{
+    static CsvSeekIndexRegistry instance;
+    return instance;
+}
+
+} // namespace
+
+uint64_t CsvSeekIndex::seek_offset(uint64_t ts) const noexcept
+{
+    // First indexed row with open time >= ts; the entry before it is a safe start.
+    const auto it = std::lower_bound(timestamps.begin(), timestamps.end(), ts);
+    if (it == timestamps.begin()) {
+        return data_offset;
+    }
+    return offsets[static_cast<size_t>(std::distance(timestamps.begin(), it)) - 1];
+}
+
+CsvSeekIndexBuilder::CsvSeekIndexBuilder(CacheSourceStamp stamp)
+    : index_(std::make_shared<CsvSeekIndex>())
+{
+    index_->stamp = std::move(stamp);
+    index_->monotonic = true;
+}
+
+std::shared_ptr<const CsvSeekIndex> CsvSeekIndexBuilder::finish()
+{
+    index_->timestamps.shrink_to_fit();
+    index_->offsets.shrink_to_fit();
+    return std::move(index_);
+}
+
+std::shared_ptr<const CsvSeekIndex> FindCsvSeekIndex(const CacheSourceStamp& stamp)
+{
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    const auto it = reg.by_path.find(stamp.source_path);
+    if (it == reg.by_path.end() ||
+        it->second->stamp.source_bytes != stamp.source_bytes ||
+        it->second->stamp.source_mtime != stamp.source_mtime) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+void StoreCsvSeekIndex(std::shared_ptr<const CsvSeekIndex> index)
+{
+    if (!index) {
+        return;
+    }
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    auto key = index->stamp.source_path;
+    reg.by_path[std::move(key)] = std::move(index);
+}
+
+} // namespace QTrading::Infra::Data::Binance
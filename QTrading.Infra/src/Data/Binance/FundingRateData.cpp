@@ -1,10 +1,12 @@
 #include "Data/Binance/FundingRateData.hpp"
+#include "Data/Binance/BinaryCache.hpp"
 #include <algorithm>
 #include <charconv>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <limits>
+#include <optional>
 #include <stdexcept>
 #include <string_view>
 
@@ -13,6 +15,7 @@
 #endif
 
 using QTrading::Dto::Market::Binance::FundingRateDto;
+namespace Cache = QTrading::Infra::Data::Binance;
 
 namespace {
 
@@ -109,6 +112,23 @@ static bool parse_funding_line(std::string_view line, FundingRateDto& out)
     return true;
 }
 
+static void load_from_cache(const Cache::MappedCacheFile& cache, std::vector<FundingRateDto>& rates)
+{
+    using Column = Cache::FundingCacheColumn;
+    const auto funding_time = cache.column<uint64_t>(static_cast<size_t>(Column::FundingTime));
+    const auto rate = cache.column<double>(static_cast<size_t>(Column::Rate));
+    const auto mark = cache.column<double>(static_cast<size_t>(Column::MarkPrice));
+    const auto has_mark = cache.column<uint8_t>(static_cast<size_t>(Column::HasMarkPrice));
+
+    const size_t count = cache.row_count();
+    rates.clear();
+    rates.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        rates.emplace_back(funding_time[i], rate[i],
+            has_mark[i] != 0 ? std::optional<double>(mark[i]) : std::nullopt);
+    }
+}
+
 } // namespace
 
 /// @brief Construct FundingRateData for a given symbol by loading CSV.
@@ -120,6 +140,7 @@ FundingRateData::FundingRateData(const std::string& symbol, const std::string& c
 
 /// @brief Load FundingRateDto entries from a CSV file into `rates`.
 ///        Lines with insufficient tokens or parse errors are skipped.
+///        Uses the binary cache the same way as MarketData::load_csv.
 /// @param csv_file Path to CSV file.
 void FundingRateData::load_csv(const std::string& csv_file) {
 #ifdef _WIN32
@@ -127,6 +148,20 @@ void FundingRateData::load_csv(const std::string& csv_file) {
 #else
     const std::filesystem::path path(csv_file);
 #endif
+    std::optional<Cache::CacheSourceStamp> cache_stamp;
+    std::filesystem::path cache_file;
+    if (const auto cache_dir = Cache::ResolveCacheDirectory()) {
+        cache_stamp = Cache::StampSource(path);
+        if (cache_stamp.has_value()) {
+            cache_file = Cache::CacheFilePath(*cache_dir, path, *cache_stamp, Cache::CacheStreamKind::FundingRate);
+            if (const auto cached = Cache::MappedCacheFile::Open(
+                    cache_file, *cache_stamp, Cache::CacheStreamKind::FundingRate)) {
+                load_from_cache(*cached, rates);
+                return;
+            }
+        }
+    }
+
     std::ifstream file(path);
     if (!file.is_open()) {
         throw std::runtime_error("Cannot open file: " + csv_file);
@@ -185,6 +220,10 @@ void FundingRateData::load_csv(const std::string& csv_file) {
                 return a.FundingTime < b.FundingTime;
             });
     }
+
+    if (cache_stamp.has_value()) {
+        (void)Cache::WriteFundingCache(cache_file, *cache_stamp, rates);
+    }
 }
 
 const FundingRateDto& FundingRateData::get_latest() const {
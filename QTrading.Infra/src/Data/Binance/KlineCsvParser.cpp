@@ -0,0 +1,552 @@
+#include "Data/Binance/KlineCsvParser.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define QTR_CSV_SCAN_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang need per-function ISA targets so the wide kernels can be dispatched at runtime
+// without raising the baseline of the whole build; MSVC accepts the intrinsics as-is.
+#if defined(QTR_CSV_SCAN_X86) && (defined(__GNUC__) || defined(__clang__))
+#define QTR_CSV_TARGET(isa) __attribute__((target(isa)))
+#else
+#define QTR_CSV_TARGET(isa)
+#endif
+
+namespace QTrading::Infra::Data::Binance {
+namespace {
+
+constexpr size_t kMaxFields = 11;
+
+/// Writes the offset of every ',' and '\n' in `[data, data + size)`, plus `base`, to `out`.
+/// `out` must hold `size` entries; the store is unconditional and only the count is predicated.
+size_t scan_scalar(const char* data, size_t size, size_t base, uint32_t* out)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < size; ++i) {
+        const char c = data[i];
+        out[n] = static_cast<uint32_t>(base + i);
+        n += static_cast<size_t>((c == ',') | (c == '\n'));
+    }
+    return n;
+}
+
+/// High bit of every byte of `chunk` that equals the byte repeated in `pattern`.
+/// Exact per byte: the add never carries across byte boundaries.
+inline uint64_t swar_byte_eq(uint64_t chunk, uint64_t pattern) noexcept
+{
+    const uint64_t x = chunk ^ pattern;
+    return ~(((x & 0x7F7F7F7F7F7F7F7Full) + 0x7F7F7F7F7F7F7F7Full) | x) & 0x8080808080808080ull;
+}
+
+/// Portable kernel: tests 8 bytes per step with SWAR instead of one byte per step.
+size_t scan_scalar_block(const char* data, size_t size, uint32_t* out)
+{
+    if constexpr (std::endian::native != std::endian::little) {
+        return scan_scalar(data, size, 0, out);
+    }
+    size_t n = 0;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t chunk;
+        std::memcpy(&chunk, data + i, sizeof(chunk));
+        uint64_t mask = swar_byte_eq(chunk, 0x2C2C2C2C2C2C2C2Cull) | swar_byte_eq(chunk, 0x0A0A0A0A0A0A0A0Aull);
+        while (mask != 0) {
+            out[n++] = static_cast<uint32_t>(i + static_cast<size_t>(std::countr_zero(mask)) / 8);
+            mask &= mask - 1;
+        }
+    }
+    return n + scan_scalar(data + i, size - i, i, out + n);
+}
+
+#ifdef QTR_CSV_SCAN_X86
+QTR_CSV_TARGET("sse2")
+size_t scan_sse2(const char* data, size_t size, uint32_t* out)
+{
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    size_t n = 0;
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        auto mask = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(v, comma), _mm_cmpeq_epi8(v, newline))));
+        while (mask != 0) {
+            out[n++] = static_cast<uint32_t>(i + std::countr_zero(mask));
+            mask &= mask - 1;
+        }
+    }
+    return n + scan_scalar(data + i, size - i, i, out + n);
+}
+
+QTR_CSV_TARGET("avx2")
+size_t scan_avx2(const char* data, size_t size, uint32_t* out)
+{
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    size_t n = 0;
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, comma), _mm256_cmpeq_epi8(v, newline))));
+        while (mask != 0) {
+            out[n++] = static_cast<uint32_t>(i + std::countr_zero(mask));
+            mask &= mask - 1;
+        }
+    }
+    return n + scan_scalar(data + i, size - i, i, out + n);
+}
+#endif
+
+CsvScanKernel detect_kernel() noexcept
+{
+#if defined(QTR_CSV_SCAN_X86) && defined(_MSC_VER) && !defined(__clang__)
+    int info[4]{};
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+    __cpuid(info, 1);
+    const bool sse2 = (info[3] & (1 << 26)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (max_leaf >= 7 && avx && osxsave && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        if ((info[1] & (1 << 5)) != 0) {
+            return CsvScanKernel::Avx2;
+        }
+    }
+    return sse2 ? CsvScanKernel::Sse2 : CsvScanKernel::Scalar;
+#elif defined(QTR_CSV_SCAN_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return CsvScanKernel::Avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return CsvScanKernel::Sse2;
+    }
+    return CsvScanKernel::Scalar;
+#else
+    return CsvScanKernel::Scalar;
+#endif
+}
+
+using ScanFn = size_t (*)(const char*, size_t, uint32_t*);
+
+ScanFn scan_function(CsvScanKernel kernel)
+{
+#ifdef QTR_CSV_SCAN_X86
+    if (kernel == CsvScanKernel::Avx2) {
+        return &scan_avx2;
+    }
+    if (kernel == CsvScanKernel::Sse2) {
+        return &scan_sse2;
+    }
+#else
+    (void)kernel;
+#endif
+    return &scan_scalar_block;
+}
+
+/// Readable bytes kept past the data in the block buffer so short fields can be loaded 16 at a time.
+constexpr size_t kReadPadding = 16;
+
+constexpr uint64_t kPow10U64[] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull
+};
+
+/// Value of eight ASCII digits loaded little-endian, first character most significant (SWAR).
+inline uint64_t eight_digits_value(uint64_t v) noexcept
+{
+    v -= 0x3030303030303030ull;
+    v = (v * 10) + (v >> 8);
+    v = (((v & 0x000000FF000000FFull) * 0x000F424000000064ull) +
+        (((v >> 16) & 0x000000FF000000FFull) * 0x0000271000000001ull)) >> 32;
+    return v;
+}
+
+/// High bit of every byte of `chunk` that is not '0'..'9'. Carries only run upward from
+/// non-digit bytes, so the lowest flagged byte is exact.
+inline uint64_t non_digit_mask(uint64_t chunk) noexcept
+{
+    const uint64_t delta = chunk ^ 0x3030303030303030ull;
+    return ((delta + 0x7676767676767676ull) | delta) & 0x8080808080808080ull;
+}
+
+/// Value of the first `n` (1..8) digits of `chunk`.
+inline uint64_t leading_digits_value(uint64_t chunk, size_t n) noexcept
+{
+    if (n < 8) {
+        // Right-align the run and pad the leading bytes with '0'.
+        chunk = (chunk << (8 * (8 - n))) | (0x3030303030303030ull >> (8 * n));
+    }
+    return eight_digits_value(chunk);
+}
+
+/// Mask of the low `n` (0..8) bytes.
+inline uint64_t low_bytes_mask(size_t n) noexcept
+{
+    return n >= 8 ? ~0ull : (1ull << (8 * n)) - 1;
+}
+
+/// Accumulates the digit run at `p` (bounded by `last`) into `value`; returns the first non-digit.
+/// Reads 8 bytes at a time, so up to 7 bytes past `last` must be readable (`kReadPadding`).
+/// `value` wraps past 19 digits, so callers bound `digits` before trusting it.
+inline const char* consume_digits(const char* p, const char* last, uint64_t& value, size_t& digits) noexcept
+{
+    if constexpr (std::endian::native == std::endian::little) {
+        while (p < last) {
+            uint64_t chunk;
+            std::memcpy(&chunk, p, sizeof(chunk));
+            const uint64_t non_digit = non_digit_mask(chunk);
+            size_t run = non_digit == 0 ? 8 : static_cast<size_t>(std::countr_zero(non_digit)) / 8;
+            run = std::min(run, static_cast<size_t>(last - p));
+            if (run == 0) {
+                break;
+            }
+            value = value * kPow10U64[run] + leading_digits_value(chunk, run);
+            digits += run;
+            p += run;
+            if (run < 8) {
+                break;
+            }
+        }
+    }
+    else {
+        while (p != last && static_cast<unsigned char>(*p - '0') <= 9) {
+            value = value * 10 + static_cast<uint64_t>(*p - '0');
+            ++digits;
+            ++p;
+        }
+    }
+    return p;
+}
+
+/// Unsigned digit runs that cannot overflow take the fast path; the rest go to from_chars.
+template <typename T>
+bool parse_integer(const char* first, const char* last, T& out)
+{
+    uint64_t value = 0;
+    size_t digits = 0;
+    const char* p = consume_digits(first, last, value, digits);
+    if (p == last && digits != 0 && digits < std::numeric_limits<T>::digits10) {
+        out = static_cast<T>(value);
+        return true;
+    }
+    T parsed{};
+    const auto [ptr, ec] = std::from_chars(first, last, parsed);
+    if (ec != std::errc{} || ptr != last) {
+        return false;
+    }
+    out = parsed;
+    return true;
+}
+
+constexpr double kExactPow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15
+};
+
+/// Single-pass path for `digits.digits` fields of at most 16 bytes with at most 8 digits on
+/// either side of the point, which covers Binance prices and volumes: both halves are loaded
+/// at once, the point is located with SWAR and each half is converted with one SWAR multiply.
+/// At most 15 digits fit in 16 bytes, so the result is exact as in `parse_decimal`.
+/// Reads 16 bytes from `first` (`kReadPadding`).
+inline bool parse_short_decimal(const char* first, const char* last, double& out) noexcept
+{
+    if constexpr (std::endian::native != std::endian::little) {
+        return false;
+    }
+    const auto len = static_cast<size_t>(last - first);
+    if (len < 3 || len > 16) {
+        return false;
+    }
+    uint64_t lo;
+    uint64_t hi;
+    std::memcpy(&lo, first, sizeof(lo));
+    std::memcpy(&hi, first + 8, sizeof(hi));
+    const uint64_t dot_lo = swar_byte_eq(lo, 0x2E2E2E2E2E2E2E2Eull);
+    const uint64_t dot_hi = swar_byte_eq(hi, 0x2E2E2E2E2E2E2E2Eull);
+    const size_t dot = dot_lo != 0
+        ? static_cast<size_t>(std::countr_zero(dot_lo)) / 8
+        : 8 + (dot_hi != 0 ? static_cast<size_t>(std::countr_zero(dot_hi)) / 8 : 8);
+    if (dot == 0 || dot > 8 || dot + 1 >= len || len - dot - 1 > 8) {
+        return false;
+    }
+    const size_t fraction = len - dot - 1;
+    const size_t frac_at = dot + 1;
+    const uint64_t frac_chunk = frac_at < 8
+        ? (lo >> (8 * frac_at)) | (hi << (8 * (8 - frac_at)))
+        : hi >> (8 * (frac_at - 8));
+    if (((non_digit_mask(lo) & low_bytes_mask(dot)) |
+            (non_digit_mask(frac_chunk) & low_bytes_mask(fraction))) != 0) {
+        return false;
+    }
+    const uint64_t mantissa = leading_digits_value(lo, dot) * kPow10U64[fraction] +
+        leading_digits_value(frac_chunk, fraction);
+    out = static_cast<double>(mantissa) / kExactPow10[fraction];
+    return true;
+}
+
+/// Plain `[-]digits[.digits]` with at most 15 significant digits is exact: the
+/// mantissa and the power of ten are both representable, so the single IEEE division
+/// rounds correctly and matches `from_chars`. Anything else (exponents, long
+/// mantissas, inf/nan) falls back to `from_chars`.
+bool parse_decimal(const char* first, const char* last, double& out)
+{
+    const char* p = first;
+    const bool negative = p != last && *p == '-';
+    if (negative) {
+        ++p;
+    }
+    if (double value{}; parse_short_decimal(p, last, value)) {
+        out = negative ? -value : value;
+        return true;
+    }
+    uint64_t mantissa = 0;
+    size_t digits = 0;
+    const char* int_begin = p;
+    p = consume_digits(p, last, mantissa, digits);
+    bool fast = p != int_begin;
+    size_t fraction = 0;
+    if (fast && p != last && *p == '.') {
+        const size_t int_digits = digits;
+        p = consume_digits(p + 1, last, mantissa, digits);
+        fraction = digits - int_digits;
+        fast = fraction != 0;
+    }
+    fast = fast && p == last && digits <= 15;
+    if (!fast) {
+        double value{};
+        const auto [ptr, ec] = std::from_chars(first, last, value);
+        if (ec != std::errc{} || ptr != last) {
+            return false;
+        }
+        out = value;
+        return true;
+    }
+    double value = static_cast<double>(mantissa);
+    if (fraction != 0) {
+        value /= kExactPow10[fraction];
+    }
+    out = negative ? -value : value;
+    return true;
+}
+
+/// Applies the row rules to each complete line and appends kept rows to the columns.
+class RowSink {
+public:
+    RowSink(const KlineCsvParseOptions& options, KlineCsvParseResult& result)
+        : options_(options), result_(result), skip_header_(options.start_offset == 0)
+    {
+    }
+
+    /// Handles line `[begin, end)` of `buf`; `commas` holds up to kMaxFields comma offsets.
+    /// @return False when parsing should stop.
+    bool line(const char* buf, uint64_t buf_offset, size_t begin, size_t end,
+        const uint32_t* commas, size_t comma_count)
+    {
+        if (skip_header_) {
+            skip_header_ = false;
+            return true;
+        }
+        const char* line_begin = buf + begin;
+        const char* line_end = buf + end;
+        if (line_end != line_begin && line_end[-1] == '\r') {
+            --line_end;
+        }
+        if (line_end == line_begin) {
+            return true;
+        }
+
+        // Same field split as a left-to-right scan: at most 11 fields, a trailing comma adds none.
+        const size_t stored = std::min(comma_count, kMaxFields);
+        size_t field_count = kMaxFields;
+        if (comma_count < kMaxFields) {
+            field_count = comma_count + 1 - (line_end[-1] == ',' ? 1 : 0);
+        }
+        const auto field_begin = [&](size_t i) { return i == 0 ? line_begin : buf + commas[i - 1] + 1; };
+        const auto field_end = [&](size_t i) { return i < stored ? buf + commas[i] : line_end; };
+
+        long long open_ts = 0;
+        if (!parse_integer(field_begin(0), field_end(0), open_ts)) {
+            return true;
+        }
+        const auto ts = static_cast<uint64_t>(open_ts);
+        if (options_.index_builder != nullptr) {
+            options_.index_builder->add_row(ts, buf_offset + begin);
+        }
+        if (options_.window_start.has_value() && ts < *options_.window_start) {
+            return true;
+        }
+        if (options_.window_end.has_value() && ts > *options_.window_end) {
+            return !options_.stop_past_window;
+        }
+        if (field_count < 6) {
+            return true;
+        }
+
+        double open = 0.0;
+        double high = 0.0;
+        double low = 0.0;
+        double close = 0.0;
+        double volume = 0.0;
+        long long close_ts = 0;
+        double quote_volume = 0.0;
+        int32_t trades = 0;
+        double taker_base = 0.0;
+        double taker_quote = 0.0;
+        if (!parse_decimal(field_begin(1), field_end(1), open)) return true;
+        if (!parse_decimal(field_begin(2), field_end(2), high)) return true;
+        if (!parse_decimal(field_begin(3), field_end(3), low)) return true;
+        if (!parse_decimal(field_begin(4), field_end(4), close)) return true;
+        if (field_count >= kMaxFields) {
+            if (!parse_decimal(field_begin(5), field_end(5), volume)) return true;
+            if (!parse_integer(field_begin(6), field_end(6), close_ts)) return true;
+            if (!parse_decimal(field_begin(7), field_end(7), quote_volume)) return true;
+            if (!parse_integer(field_begin(8), field_end(8), trades)) return true;
+            if (!parse_decimal(field_begin(9), field_end(9), taker_base)) return true;
+            if (!parse_decimal(field_begin(10), field_end(10), taker_quote)) return true;
+        }
+        else {
+            if (!parse_integer(field_begin(5), field_end(5), close_ts)) return true;
+        }
+
+        if (has_last_ && ts < last_ts_) {
+            result_.monotonic = false;
+        }
+        last_ts_ = ts;
+        has_last_ = true;
+
+        auto& c = result_.columns;
+        c.open_time.push_back(ts);
+        c.open.push_back(open);
+        c.high.push_back(high);
+        c.low.push_back(low);
+        c.close.push_back(close);
+        c.volume.push_back(volume);
+        c.close_time.push_back(static_cast<uint64_t>(close_ts));
+        c.quote_volume.push_back(quote_volume);
+        c.trade_count.push_back(trades);
+        c.taker_buy_base.push_back(taker_base);
+        c.taker_buy_quote.push_back(taker_quote);
+        return true;
+    }
+
+private:
+    const KlineCsvParseOptions& options_;
+    KlineCsvParseResult& result_;
+    bool skip_header_;
+    uint64_t last_ts_{ 0 };
+    bool has_last_{ false };
+};
+
+void reserve_columns(KlineColumnBuffers& c, size_t rows)
+{
+    c.open_time.reserve(rows);
+    c.open.reserve(rows);
+    c.high.reserve(rows);
+    c.low.reserve(rows);
+    c.close.reserve(rows);
+    c.volume.reserve(rows);
+    c.close_time.reserve(rows);
+    c.quote_volume.reserve(rows);
+    c.trade_count.reserve(rows);
+    c.taker_buy_base.reserve(rows);
+    c.taker_buy_quote.reserve(rows);
+}
+
+} // namespace
+
+CsvScanKernel DetectCsvScanKernel() noexcept
+{
+    static const CsvScanKernel detected = detect_kernel();
+    return detected;
+}
+
+KlineCsvParseResult ParseKlineCsv(std::istream& in, const KlineCsvParseOptions& options)
+{
+    KlineCsvParseResult result;
+    const CsvScanKernel supported = DetectCsvScanKernel();
+    result.kernel = options.kernel == CsvScanKernel::Auto
+        ? supported
+        : std::min(options.kernel, supported);
+    const ScanFn scan = scan_function(result.kernel);
+    reserve_columns(result.columns, options.reserve_rows);
+
+    if (options.start_offset != 0) {
+        in.seekg(static_cast<std::streamoff>(options.start_offset));
+        result.header_read = true;
+    }
+    RowSink sink(options, result);
+
+    const size_t block_bytes = std::max<size_t>(options.block_bytes, 64);
+    std::vector<char> buffer(block_bytes + kReadPadding);
+    std::vector<uint32_t> structurals;
+    uint32_t commas[kMaxFields]{};
+    uint64_t buffer_offset = options.start_offset;
+    size_t carry = 0;
+    bool stop = false;
+
+    while (!stop) {
+        // A line longer than one block keeps growing the buffer until it completes.
+        if (buffer.size() < carry + block_bytes + kReadPadding) {
+            buffer.resize(carry + block_bytes + kReadPadding);
+        }
+        in.read(buffer.data() + carry, static_cast<std::streamsize>(block_bytes));
+        const auto got = static_cast<size_t>(in.gcount());
+        const bool eof = got < block_bytes;
+        if (got != 0) {
+            result.header_read = true;
+        }
+        const size_t len = carry + got;
+        if (len == 0) {
+            break;
+        }
+
+        structurals.resize(len);
+        const size_t count = scan(buffer.data(), len, structurals.data());
+        size_t line_start = 0;
+        size_t comma_count = 0;
+        for (size_t s = 0; s < count; ++s) {
+            const uint32_t pos = structurals[s];
+            if (buffer[pos] == ',') {
+                if (comma_count < kMaxFields) {
+                    commas[comma_count] = pos;
+                }
+                ++comma_count;
+                continue;
+            }
+            if (!sink.line(buffer.data(), buffer_offset, line_start, pos, commas, comma_count)) {
+                stop = true;
+                break;
+            }
+            line_start = static_cast<size_t>(pos) + 1;
+            comma_count = 0;
+        }
+        if (stop) {
+            break;
+        }
+        if (eof) {
+            if (line_start < len) {
+                sink.line(buffer.data(), buffer_offset, line_start, len, commas, comma_count);
+            }
+            break;
+        }
+        carry = len - line_start;
+        std::memmove(buffer.data(), buffer.data() + line_start, carry);
+        buffer_offset += line_start;
+    }
+    return result;
+}
+
+} // namespace QTrading::Infra::Data::Binance
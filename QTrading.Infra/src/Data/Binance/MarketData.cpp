@@ -1,4 +1,7 @@
 #include "Data/Binance/MarketData.hpp"
+#include "Data/Binance/BinaryCache.hpp"
+#include "Data/Binance/CsvSeekIndex.hpp"
+#include "Data/Binance/KlineCsvParser.hpp"
 #include <algorithm>
 #include <charconv>
 #include <cstdlib>
@@ -7,15 +10,21 @@
 #include <filesystem>
 #include <fstream>
 #include <limits>
+#include <memory>
+#include <numeric>
 #include <optional>
+#include <span>
 #include <stdexcept>
 #include <string_view>
+#include <type_traits>
+#include <vector>
 
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
 using QTrading::Dto::Market::Binance::TradeKlineDto;
+namespace Cache = QTrading::Infra::Data::Binance;
 
 namespace {
 
@@ -47,49 +56,6 @@ static std::wstring utf8_to_wide(const std::string& utf8)
 }
 #endif
 
-static inline std::string_view next_field(std::string_view& s)
-{
-    const size_t pos = s.find(',');
-    if (pos == std::string_view::npos) {
-        auto out = s;
-        s = std::string_view{};
-        return out;
-    }
-    auto out = s.substr(0, pos);
-    s.remove_prefix(pos + 1);
-    return out;
-}
-
-template <typename T>
-static bool parse_int(std::string_view sv, T& out)
-{
-    sv = std::string_view{ sv.data(), sv.size() };
-    if constexpr (std::is_signed_v<T>) {
-        T v{};
-        auto [p, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), v);
-        if (ec != std::errc{} || p != sv.data() + sv.size()) return false;
-        out = v;
-        return true;
-    }
-    else {
-        T v{};
-        auto [p, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), v);
-        if (ec != std::errc{} || p != sv.data() + sv.size()) return false;
-        out = v;
-        return true;
-    }
-}
-
-static bool parse_double(std::string_view sv, double& out)
-{
-    // MSVC supports from_chars for floating point.
-    double v{};
-    auto [p, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), v);
-    if (ec != std::errc{} || p != sv.data() + sv.size()) return false;
-    out = v;
-    return true;
-}
-
 static std::optional<uint64_t> parse_env_u64(const char* key)
 {
     const char* raw = std::getenv(key);
@@ -152,76 +118,50 @@ static std::pair<std::optional<uint64_t>, std::optional<uint64_t>> resolve_repla
     return { start, end };
 }
 
-static void apply_replay_window(std::vector<TradeKlineDto>& klines)
+/// @brief Row range `[first, last)` of a sorted timestamp column kept by the replay window.
+static std::pair<size_t, size_t> replay_window_rows(std::span<const uint64_t> timestamps)
 {
     const auto [start_ts, end_ts] = resolve_replay_window_ts_ms();
-    if (!start_ts.has_value() && !end_ts.has_value()) {
-        return;
+    auto first = timestamps.begin();
+    auto last = timestamps.end();
+    if (start_ts.has_value()) {
+        first = std::lower_bound(timestamps.begin(), timestamps.end(), *start_ts);
     }
-    const auto first = std::remove_if(klines.begin(), klines.end(),
-        [&](const TradeKlineDto& kline) {
-            if (start_ts.has_value() && kline.Timestamp < *start_ts) {
-                return true;
-            }
-            if (end_ts.has_value() && kline.Timestamp > *end_ts) {
-                return true;
-            }
-            return false;
-        });
-    klines.erase(first, klines.end());
+    if (end_ts.has_value()) {
+        last = std::upper_bound(first, timestamps.end(), *end_ts);
+    }
+    return {
+        static_cast<size_t>(std::distance(timestamps.begin(), first)),
+        static_cast<size_t>(std::distance(timestamps.begin(), last)) };
 }
 
-static bool parse_kline_line(std::string_view line, TradeKlineDto& out)
+/// @brief Stable-sorts every column by open time.
+static void sort_by_open_time(Cache::KlineColumnBuffers& columns)
 {
-    // Supported formats:
-    // - 11 columns: openTime,open,high,low,close,volume,closeTime,quoteVolume,trades,takerBuyBaseVol,takerBuyQuoteVol
-    // - 6 columns:  openTime,open,high,low,close,closeTime
-    std::string_view s = line;
-    if (s.empty()) {
-        return false;
-    }
-
-    std::string_view fields[11]{};
-    size_t count = 0;
-    while (!s.empty() && count < 11) {
-        fields[count++] = next_field(s);
-    }
-    if (count < 6) {
-        return false;
-    }
-
-    long long openTs = 0;
-    double openP = 0.0;
-    double highP = 0.0;
-    double lowP = 0.0;
-    double closeP = 0.0;
-    double vol = 0.0;
-    long long closeTs = 0;
-    double quoteVol = 0.0;
-    int trades = 0;
-    double takerBB = 0.0;
-    double takerBQ = 0.0;
-
-    if (!parse_int<long long>(fields[0], openTs)) return false;
-    if (!parse_double(fields[1], openP)) return false;
-    if (!parse_double(fields[2], highP)) return false;
-    if (!parse_double(fields[3], lowP)) return false;
-    if (!parse_double(fields[4], closeP)) return false;
-
-    if (count >= 11) {
-        if (!parse_double(fields[5], vol)) return false;
-        if (!parse_int<long long>(fields[6], closeTs)) return false;
-        if (!parse_double(fields[7], quoteVol)) return false;
-        if (!parse_int<int>(fields[8], trades)) return false;
-        if (!parse_double(fields[9], takerBB)) return false;
-        if (!parse_double(fields[10], takerBQ)) return false;
-    }
-    else {
-        if (!parse_int<long long>(fields[5], closeTs)) return false;
-    }
-
-    out = TradeKlineDto(openTs, openP, highP, lowP, closeP, vol, closeTs, quoteVol, trades, takerBB, takerBQ);
-    return true;
+    std::vector<size_t> order(columns.size());
+    std::iota(order.begin(), order.end(), size_t{ 0 });
+    std::stable_sort(order.begin(), order.end(), [&columns](size_t a, size_t b) {
+        return columns.open_time[a] < columns.open_time[b];
+    });
+    const auto permute = [&order](auto& column) {
+        std::remove_reference_t<decltype(column)> sorted;
+        sorted.reserve(order.size());
+        for (const size_t i : order) {
+            sorted.push_back(column[i]);
+        }
+        column.swap(sorted);
+    };
+    permute(columns.open_time);
+    permute(columns.open);
+    permute(columns.high);
+    permute(columns.low);
+    permute(columns.close);
+    permute(columns.volume);
+    permute(columns.close_time);
+    permute(columns.quote_volume);
+    permute(columns.trade_count);
+    permute(columns.taker_buy_base);
+    permute(columns.taker_buy_quote);
 }
 
 } // namespace
@@ -233,8 +173,15 @@ MarketData::MarketData(const std::string& symbol, const std::string& csv_file) :
     load_csv(csv_file);
 }
 
-/// @brief Load TradeKlineDto entries from a CSV file into `klines`.
-///        Lines with insufficient tokens or parse errors are skipped.
+/// @brief Load bars from a CSV file into the columns.
+///        Parsing is block-wise with SIMD delimiter scanning (`ParseKlineCsv`);
+///        lines with insufficient tokens or parse errors are skipped.
+///        When `QTR_DATA_CACHE_DIR` is set, a fresh binary cache is mapped
+///        instead of parsing, and a stale/missing one is rewritten after parsing
+///        and then mapped, so the parsed rows are not kept resident.
+///        Without a cache, a replay window skips parsing rows outside it, and a
+///        sparse seek index from an earlier full read of the same file lets
+///        the load start near the window and stop at its end.
 /// @param csv_file Path to CSV file.
 void MarketData::load_csv(const std::string& csv_file) {
 #ifdef _WIN32
@@ -242,15 +189,66 @@ void MarketData::load_csv(const std::string& csv_file) {
 #else
     const std::filesystem::path path(csv_file);
 #endif
-    std::ifstream file(path);
+    const auto bind_mapped = [this](std::shared_ptr<const Cache::MappedCacheFile> cached) {
+        using Column = Cache::KlineCacheColumn;
+        const auto col = [](Column c) { return static_cast<size_t>(c); };
+        open_time_ = cached->column<uint64_t>(col(Column::OpenTime));
+        open_ = cached->column<double>(col(Column::Open));
+        high_ = cached->column<double>(col(Column::High));
+        low_ = cached->column<double>(col(Column::Low));
+        close_ = cached->column<double>(col(Column::Close));
+        volume_ = cached->column<double>(col(Column::Volume));
+        close_time_ = cached->column<uint64_t>(col(Column::CloseTime));
+        quote_volume_ = cached->column<double>(col(Column::QuoteVolume));
+        trade_count_ = cached->column<int32_t>(col(Column::TradeCount));
+        taker_buy_base_ = cached->column<double>(col(Column::TakerBuyBaseVolume));
+        taker_buy_quote_ = cached->column<double>(col(Column::TakerBuyQuoteVolume));
+        storage_ = std::move(cached);
+        memory_mapped_ = true;
+    };
+    const auto apply_replay_window = [this]() {
+        const auto [first, last] = replay_window_rows(open_time_);
+        narrow_rows(first, last);
+    };
+
+    std::optional<Cache::CacheSourceStamp> cache_stamp;
+    std::filesystem::path cache_file;
+    if (const auto cache_dir = Cache::ResolveCacheDirectory()) {
+        cache_stamp = Cache::StampSource(path);
+        if (cache_stamp.has_value()) {
+            cache_file = Cache::CacheFilePath(*cache_dir, path, *cache_stamp, Cache::CacheStreamKind::TradeKline);
+            if (auto cached = Cache::MappedCacheFile::Open(
+                    cache_file, *cache_stamp, Cache::CacheStreamKind::TradeKline)) {
+                bind_mapped(std::move(cached));
+                apply_replay_window();
+                return;
+            }
+        }
+    }
+
+    // Rows outside the replay window are only skipped when no cache needs the full series.
+    const auto [window_start, window_end] = resolve_replay_window_ts_ms();
+    const bool skip_outside_window = !cache_stamp.has_value() &&
+        (window_start.has_value() || window_end.has_value());
+    const auto source_stamp = cache_stamp.has_value() ? cache_stamp : Cache::StampSource(path);
+    std::shared_ptr<const Cache::CsvSeekIndex> seek_index;
+    if (skip_outside_window && source_stamp.has_value()) {
+        seek_index = Cache::FindCsvSeekIndex(*source_stamp);
+        if (seek_index && !seek_index->monotonic) {
+            seek_index.reset();
+        }
+    }
+
+    // Binary mode keeps byte offsets exact for the seek index.
+    std::ifstream file(path, std::ios::binary);
     if (!file.is_open()) {
         throw std::runtime_error("Cannot open file: " + csv_file);
     }
 
-    klines.clear();
+    Cache::KlineCsvParseOptions options;
     std::error_code ec;
     const auto file_bytes = std::filesystem::file_size(path, ec);
-    if (!ec && file_bytes > 0) {
+    if (!seek_index && !ec && file_bytes > 0) {
         constexpr uintmax_t kAvgBytesPerRow = 80;
         uintmax_t est_rows = file_bytes / kAvgBytesPerRow;
         if (est_rows < 1024) {
@@ -260,67 +258,139 @@ void MarketData::load_csv(const std::string& csv_file) {
         if (est_rows > size_t_max) {
             est_rows = size_t_max;
         }
-        klines.reserve(static_cast<size_t>(est_rows));
+        options.reserve_rows = static_cast<size_t>(est_rows);
     }
     else {
-        klines.reserve(1 << 16);
+        options.reserve_rows = 1 << 16;
     }
 
-    std::string line;
+    // Without a usable index, the full pass records one for later windowed loads.
+    std::optional<Cache::CsvSeekIndexBuilder> index_builder;
+    if (seek_index) {
+        options.start_offset = seek_index->seek_offset(window_start.value_or(0));
+        options.stop_past_window = true;
+    }
+    else if (source_stamp.has_value()) {
+        index_builder.emplace(*source_stamp);
+        options.index_builder = &*index_builder;
+    }
+    if (skip_outside_window) {
+        options.window_start = window_start;
+        options.window_end = window_end;
+    }
 
-    // Skip header
-    if (!std::getline(file, line)) {
+    auto parsed = Cache::ParseKlineCsv(file, options);
+    if (!parsed.header_read) {
         throw std::runtime_error("CSV file is empty or cannot read header: " + csv_file);
     }
+    if (index_builder) {
+        Cache::StoreCsvSeekIndex(index_builder->finish());
+    }
 
-    bool monotonic = true;
-    uint64_t last_ts = 0;
-    bool has_last = false;
+    auto columns = std::make_shared<Cache::KlineColumnBuffers>(std::move(parsed.columns));
 
-    while (std::getline(file, line)) {
-        TradeKlineDto k{};
-        if (!parse_kline_line(std::string_view(line), k)) {
-            continue;
-        }
+    // Ensure chronological order only when needed.
+    if (!parsed.monotonic) {
+        sort_by_open_time(*columns);
+    }
 
-        if (has_last) {
-            if (k.Timestamp < last_ts) {
-                monotonic = false;
-            }
+    // The cache always holds the full sorted series; replay windows are applied on top.
+    if (cache_stamp.has_value() && Cache::WriteKlineCache(cache_file, *cache_stamp, *columns)) {
+        if (auto cached = Cache::MappedCacheFile::Open(
+                cache_file, *cache_stamp, Cache::CacheStreamKind::TradeKline)) {
+            bind_mapped(std::move(cached));
+            apply_replay_window();
+            return;
         }
-        last_ts = k.Timestamp;
-        has_last = true;
-
-        klines.emplace_back(std::move(k));
     }
 
-    // Ensure chronological order only when needed.
-    if (!monotonic) {
-        std::sort(klines.begin(), klines.end(),
-            [](const TradeKlineDto& a, const TradeKlineDto& b) {
-                return a.Timestamp < b.Timestamp;
-            });
+    open_time_ = columns->open_time;
+    open_ = columns->open;
+    high_ = columns->high;
+    low_ = columns->low;
+    close_ = columns->close;
+    volume_ = columns->volume;
+    close_time_ = columns->close_time;
+    quote_volume_ = columns->quote_volume;
+    trade_count_ = columns->trade_count;
+    taker_buy_base_ = columns->taker_buy_base;
+    taker_buy_quote_ = columns->taker_buy_quote;
+    storage_ = std::move(columns);
+    memory_mapped_ = false;
+    apply_replay_window();
+}
+
+/// @brief Narrow every column to rows `[first, last)`; storage is not copied.
+void MarketData::narrow_rows(size_t first, size_t last) {
+    const size_t count = last - first;
+    open_time_ = open_time_.subspan(first, count);
+    open_ = open_.subspan(first, count);
+    high_ = high_.subspan(first, count);
+    low_ = low_.subspan(first, count);
+    close_ = close_.subspan(first, count);
+    volume_ = volume_.subspan(first, count);
+    close_time_ = close_time_.subspan(first, count);
+    quote_volume_ = quote_volume_.subspan(first, count);
+    trade_count_ = trade_count_.subspan(first, count);
+    taker_buy_base_ = taker_buy_base_.subspan(first, count);
+    taker_buy_quote_ = taker_buy_quote_.subspan(first, count);
+}
+
+namespace {
+
+template <typename T>
+void advise_column(std::span<const T> column, size_t first, size_t last, Cache::MappedRangeAdvice advice)
+{
+    Cache::AdviseMappedRange(column.data() + first, (last - first) * sizeof(T), advice);
+}
+
+} // namespace
+
+void MarketData::advise_rows(size_t first, size_t last, Cache::MappedRangeAdvice advice) const noexcept {
+    last = std::min(last, open_time_.size());
+    if (!memory_mapped_ || first >= last) {
+        return;
     }
+    advise_column(open_time_, first, last, advice);
+    advise_column(open_, first, last, advice);
+    advise_column(high_, first, last, advice);
+    advise_column(low_, first, last, advice);
+    advise_column(close_, first, last, advice);
+    advise_column(volume_, first, last, advice);
+    advise_column(close_time_, first, last, advice);
+    advise_column(quote_volume_, first, last, advice);
+    advise_column(trade_count_, first, last, advice);
+    advise_column(taker_buy_base_, first, last, advice);
+    advise_column(taker_buy_quote_, first, last, advice);
+}
+
+size_t MarketData::row_bytes() const noexcept {
+    return 10 * sizeof(double) + sizeof(int32_t);
+}
 
-    apply_replay_window(klines);
+/// @brief Materialize the row at `index` from the columns (no bounds check).
+TradeKlineDto MarketData::row_at(size_t index) const {
+    return TradeKlineDto(open_time_[index], open_[index], high_[index], low_[index], close_[index],
+        volume_[index], close_time_[index], quote_volume_[index], trade_count_[index],
+        taker_buy_base_[index], taker_buy_quote_[index]);
 }
 
 /// @brief Get the most recent Kline entry.
-/// @return Reference to the last element in `klines`.
-const TradeKlineDto& MarketData::get_latest_kline() const {
-    if (klines.empty()) {
+/// @return Row view of the last bar.
+TradeKlineDto MarketData::get_latest_kline() const {
+    if (open_time_.empty()) {
         throw std::out_of_range("No kline data available");
     }
-    return klines.back();
+    return row_at(open_time_.size() - 1);
 }
 
 /// @brief Get the Kline at a specific index.
-/// @param index Zero-based position in `klines`.
-/// @return Reference to the TradeKlineDto at `index`.
+/// @param index Zero-based row position.
+/// @return Row view of the bar at `index`.
 /// @throws std::out_of_range if index is invalid.
-const TradeKlineDto& MarketData::get_kline(size_t index) const {
-    if (index < klines.size()) {
-        return klines[index];
+TradeKlineDto MarketData::get_kline(size_t index) const {
+    if (index < open_time_.size()) {
+        return row_at(index);
     }
     else {
         throw std::out_of_range("Kline index out of range");
@@ -328,61 +398,39 @@ const TradeKlineDto& MarketData::get_kline(size_t index) const {
 }
 
 /// @brief Get the number of loaded Kline entries.
-/// @return Size of the `klines` vector.
+/// @return Row count of the columns.
 size_t MarketData::get_klines_count() const {
-    return klines.size();
+    return open_time_.size();
 }
 
 size_t MarketData::lower_bound_ts(uint64_t ts) const
 {
-    const auto it = std::lower_bound(klines.begin(), klines.end(), ts,
-        [](const TradeKlineDto& entry, uint64_t value) {
-            return entry.Timestamp < value;
-        });
-    return static_cast<size_t>(std::distance(klines.begin(), it));
+    const auto it = std::lower_bound(open_time_.begin(), open_time_.end(), ts);
+    return static_cast<size_t>(std::distance(open_time_.begin(), it));
 }
 
 size_t MarketData::upper_bound_ts(uint64_t ts) const
 {
-    const auto it = std::upper_bound(klines.begin(), klines.end(), ts,
-        [](uint64_t value, const TradeKlineDto& entry) {
-            return value < entry.Timestamp;
-        });
-    return static_cast<size_t>(std::distance(klines.begin(), it));
-}
-
-/// @brief Iterator to first mutable Kline.
-/// @return `klines.begin()`
-MarketData::iterator MarketData::begin() {
-    return klines.begin();
-}
-
-/// @brief Iterator one past last mutable Kline.
-/// @return `klines.end()`
-MarketData::iterator MarketData::end() {
-    return klines.end();
+    const auto it = std::upper_bound(open_time_.begin(), open_time_.end(), ts);
+    return static_cast<size_t>(std::distance(open_time_.begin(), it));
 }
 
-/// @brief Iterator to first const Kline.
-/// @return `klines.begin()`
+/// @brief Iterator to first Kline.
 MarketData::const_iterator MarketData::begin() const {
-    return klines.begin();
+    return const_iterator(this, 0);
 }
 
-/// @brief Iterator one past last const Kline.
-/// @return `klines.end()`
+/// @brief Iterator one past last Kline.
 MarketData::const_iterator MarketData::end() const {
-    return klines.end();
+    return const_iterator(this, open_time_.size());
 }
 
 /// @brief Const iterator to first Kline.
-/// @return `klines.cbegin()`
 MarketData::const_iterator MarketData::cbegin() const {
-    return klines.cbegin();
+    return begin();
 }
 
 /// @brief Const iterator one past last Kline.
-/// @return `klines.cend()`
 MarketData::const_iterator MarketData::cend() const {
-    return klines.cend();
+    return end();
 }
@@ -0,0 +1,186 @@
+#include "Data/Binance/ReferenceKlineData.hpp"
+#include "Data/Binance/BinaryCache.hpp"
+#include "Data/Binance/MarketData.hpp"
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+using QTrading::Dto::Market::Binance::ReferenceKlineDto;
+
+namespace {
+
+/// @brief Heap-owned copy of the retained columns when no binary cache backs the data.
+struct OwnedReferenceColumns {
+    std::vector<uint64_t> open_time;
+    std::vector<double> open;
+    std::vector<double> high;
+    std::vector<double> low;
+    std::vector<double> close;
+    std::vector<uint64_t> close_time;
+};
+
+template <typename T>
+std::vector<T> copy_column(std::span<const T> column)
+{
+    return std::vector<T>(column.begin(), column.end());
+}
+
+template <typename T>
+void advise_column(
+    std::span<const T> column,
+    size_t first,
+    size_t last,
+    QTrading::Infra::Data::Binance::MappedRangeAdvice advice)
+{
+    if (column.empty()) {
+        return;
+    }
+    QTrading::Infra::Data::Binance::AdviseMappedRange(column.data() + first, (last - first) * sizeof(T), advice);
+}
+
+} // namespace
+
+/// @brief Loads the kline CSV through MarketData, then keeps only the reference columns.
+///        A mapped source is shared as-is (unused columns are never paged in);
+///        an owned source is copied column-wise and released.
+ReferenceKlineData::ReferenceKlineData(
+    const std::string& symbol,
+    const std::string& csv_file,
+    ReferenceKlineLayout layout)
+    : symbol(symbol), layout_(layout)
+{
+    const MarketData source(symbol, csv_file);
+    if (source.get_klines_count() > 0) {
+        opening_price_ = source.open_prices().front();
+    }
+    const bool ohlc = layout_ == ReferenceKlineLayout::Ohlc;
+
+    if (source.is_memory_mapped()) {
+        open_time_ = source.timestamps();
+        close_ = source.close_prices();
+        if (ohlc) {
+            open_ = source.open_prices();
+            high_ = source.high_prices();
+            low_ = source.low_prices();
+            close_time_ = source.close_times();
+        }
+        storage_ = source.storage();
+        memory_mapped_ = true;
+        return;
+    }
+
+    auto columns = std::make_shared<OwnedReferenceColumns>();
+    columns->open_time = copy_column(source.timestamps());
+    columns->close = copy_column(source.close_prices());
+    if (ohlc) {
+        columns->open = copy_column(source.open_prices());
+        columns->high = copy_column(source.high_prices());
+        columns->low = copy_column(source.low_prices());
+        columns->close_time = copy_column(source.close_times());
+    }
+    open_time_ = columns->open_time;
+    close_ = columns->close;
+    open_ = columns->open;
+    high_ = columns->high;
+    low_ = columns->low;
+    close_time_ = columns->close_time;
+    storage_ = std::move(columns);
+}
+
+ReferenceKlineDto ReferenceKlineData::row_at(size_t index) const
+{
+    if (layout_ == ReferenceKlineLayout::CloseOnly) {
+        return ReferenceKlineDto::Point(open_time_[index], close_[index]);
+    }
+    return ReferenceKlineDto{
+        open_time_[index],
+        open_[index],
+        high_[index],
+        low_[index],
+        close_[index],
+        close_time_[index]
+    };
+}
+
+ReferenceKlineDto ReferenceKlineData::get_kline(size_t index) const
+{
+    if (index >= open_time_.size()) {
+        throw std::out_of_range("Reference kline index out of range");
+    }
+    return row_at(index);
+}
+
+ReferenceKlineDto ReferenceKlineData::get_latest_kline() const
+{
+    if (open_time_.empty()) {
+        throw std::out_of_range("No reference kline data available");
+    }
+    return row_at(open_time_.size() - 1);
+}
+
+size_t ReferenceKlineData::lower_bound_ts(uint64_t ts) const
+{
+    const auto it = std::lower_bound(open_time_.begin(), open_time_.end(), ts);
+    return static_cast<size_t>(std::distance(open_time_.begin(), it));
+}
+
+size_t ReferenceKlineData::lower_bound_ts(uint64_t ts, size_t hint) const
+{
+    constexpr size_t kLinearProbe = 8;
+    const size_t count = open_time_.size();
+    const auto begin = open_time_.begin();
+    if (hint > count || (hint > 0 && open_time_[hint - 1] >= ts)) {
+        const auto it = std::lower_bound(begin, begin + std::min(hint, count), ts);
+        return static_cast<size_t>(std::distance(begin, it));
+    }
+
+    // Replay time is monotonic, so the answer is usually within a row or two.
+    const size_t probe_end = std::min(count, hint + kLinearProbe);
+    for (; hint < probe_end; ++hint) {
+        if (open_time_[hint] >= ts) {
+            return hint;
+        }
+    }
+
+    // Gallop: (lo, hi] brackets the answer, then binary search inside it.
+    size_t lo = hint;
+    size_t step = kLinearProbe;
+    while (lo + step < count && open_time_[lo + step] < ts) {
+        lo += step;
+        step *= 2;
+    }
+    const size_t hi = std::min(count, lo + step + 1);
+    const auto it = std::lower_bound(begin + lo, begin + hi, ts);
+    return static_cast<size_t>(std::distance(begin, it));
+}
+
+size_t ReferenceKlineData::upper_bound_ts(uint64_t ts) const
+{
+    const auto it = std::upper_bound(open_time_.begin(), open_time_.end(), ts);
+    return static_cast<size_t>(std::distance(open_time_.begin(), it));
+}
+
+void ReferenceKlineData::advise_rows(
+    size_t first,
+    size_t last,
+    QTrading::Infra::Data::Binance::MappedRangeAdvice advice) const noexcept
+{
+    last = std::min(last, open_time_.size());
+    if (!memory_mapped_ || first >= last) {
+        return;
+    }
+    advise_column(open_time_, first, last, advice);
+    advise_column(close_, first, last, advice);
+    advise_column(open_, first, last, advice);
+    advise_column(high_, first, last, advice);
+    advise_column(low_, first, last, advice);
+    advise_column(close_time_, first, last, advice);
+}
+
+size_t ReferenceKlineData::row_bytes() const noexcept
+{
+    return layout_ == ReferenceKlineLayout::CloseOnly
+        ? sizeof(uint64_t) + sizeof(double)
+        : 2 * sizeof(uint64_t) + 4 * sizeof(double);
+}
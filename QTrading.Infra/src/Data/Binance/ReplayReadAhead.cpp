@@ -0,0 +1,145 @@
+#include "Data/Binance/ReplayReadAhead.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace QTrading::Infra::Data::Binance {
+
+ReplayReadAhead::ReplayReadAhead(
+    const std::vector<MarketData>& trade,
+    const std::vector<ReferenceKlineData>& mark,
+    const std::vector<ReferenceKlineData>& index,
+    size_t chunk_budget_bytes)
+    : trade_(trade)
+{
+    reference_.reserve(mark.size() + index.size());
+    reference_.insert(reference_.end(), mark.begin(), mark.end());
+    reference_.insert(reference_.end(), index.begin(), index.end());
+    mark_offset_ = trade_.size();
+    index_offset_ = mark_offset_ + mark.size();
+
+    series_.resize(trade_.size() + reference_.size());
+    size_t resident_row_bytes = 0;
+    for (size_t i = 0; i < series_.size(); ++i) {
+        auto& series = series_[i];
+        const bool is_trade = i < trade_.size();
+        series.kind = is_trade ? SeriesKind::Trade : SeriesKind::Reference;
+        series.source = is_trade ? i : i - trade_.size();
+        const bool mapped = is_trade
+            ? trade_[series.source].is_memory_mapped()
+            : reference_[series.source].is_memory_mapped();
+        if (!mapped) {
+            continue;
+        }
+        series.rows = is_trade
+            ? trade_[series.source].get_klines_count()
+            : reference_[series.source].get_klines_count();
+        resident_row_bytes += is_trade
+            ? trade_[series.source].row_bytes()
+            : reference_[series.source].row_bytes();
+        ++active_series_;
+    }
+    if (active_series_ == 0) {
+        return;
+    }
+
+    // Every series advances one row per replay minute, so chunks are sized in rows:
+    // two chunks (current + read-ahead) of every mapped series fit the budget.
+    chunk_rows_ = std::max(kMinChunkRows, chunk_budget_bytes / (2 * std::max<size_t>(1, resident_row_bytes)));
+
+    for (size_t i = 0; i < series_.size(); ++i) {
+        auto& series = series_[i];
+        if (series.rows == 0) {
+            continue;
+        }
+        series.next_trigger = chunk_rows_;
+        pending_.push_back(Request{ i, 0, std::min(series.rows, 2 * chunk_rows_), MappedRangeAdvice::WillNeed });
+    }
+    worker_ = std::thread([this]() { run(); });
+}
+
+ReplayReadAhead::~ReplayReadAhead()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void ReplayReadAhead::on_chunk_boundary(size_t series_id, size_t cursor)
+{
+    auto& series = series_[series_id];
+    const size_t prefetch_first = std::min(series.rows, cursor + chunk_rows_);
+    const size_t prefetch_last = std::min(series.rows, cursor + 2 * chunk_rows_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (series.released_upto < cursor) {
+            pending_.push_back(Request{ series_id, series.released_upto, cursor, MappedRangeAdvice::Release });
+            series.released_upto = cursor;
+        }
+        if (prefetch_first < prefetch_last) {
+            pending_.push_back(Request{ series_id, prefetch_first, prefetch_last, MappedRangeAdvice::WillNeed });
+        }
+    }
+    series.next_trigger = cursor + chunk_rows_ < series.rows
+        ? cursor + chunk_rows_
+        : (std::numeric_limits<size_t>::max)();
+    wake_.notify_one();
+}
+
+void ReplayReadAhead::apply(const Request& request) const
+{
+    const auto& series = series_[request.series];
+    if (series.kind == SeriesKind::Trade) {
+        trade_[series.source].advise_rows(request.first, request.last, request.advice);
+    }
+    else {
+        reference_[series.source].advise_rows(request.first, request.last, request.advice);
+    }
+}
+
+void ReplayReadAhead::run()
+{
+    std::vector<Request> batch;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this]() { return stop_ || !pending_.empty(); });
+        if (stop_) {
+            return;
+        }
+        batch.swap(pending_);
+        busy_ = true;
+        lock.unlock();
+        for (const auto& request : batch) {
+            apply(request);
+        }
+        lock.lock();
+        completed_ += batch.size();
+        batch.clear();
+        busy_ = false;
+        if (pending_.empty()) {
+            idle_.notify_all();
+        }
+    }
+}
+
+uint64_t ReplayReadAhead::completed_requests() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return completed_;
+}
+
+void ReplayReadAhead::drain()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!worker_.joinable()) {
+        return;
+    }
+    idle_.wait(lock, [this]() { return pending_.empty() && !busy_; });
+}
+
+} // namespace QTrading::Infra::Data::Binance
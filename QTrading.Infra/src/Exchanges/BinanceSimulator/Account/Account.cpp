@@ -51,6 +51,19 @@ uint64_t Account::get_state_version() const
     return state_version_;
 }
 
+Account::LedgerState Account::ledger_state() const
+{
+    return LedgerState{ spot_balance_, perp_balance_, total_cash_balance_, state_version_ };
+}
+
+void Account::restore_ledger_state(const LedgerState& state)
+{
+    spot_balance_ = state.spot_balance;
+    perp_balance_ = state.perp_balance;
+    total_cash_balance_ = state.total_cash_balance;
+    state_version_ = state.state_version;
+}
+
 double Account::total_unrealized_pnl() const
 {
     return perp_balance_.UnrealizedPnl;
@@ -0,0 +1,84 @@
+#include "Exchanges/BinanceSimulator/Application/BatchReplayRunner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+
+namespace QTrading::Infra::Exchanges::BinanceSim::Application {
+
+BatchReplayRunner::BatchReplayRunner(
+    std::vector<Contracts::SymbolDataset> datasets,
+    const Bootstrap::DatasetLoadOptions& load_options)
+    : datasets_(std::move(datasets)),
+      shared_data_(std::make_shared<const Bootstrap::LoadedDatasets>(Bootstrap::LoadDatasets(datasets_, load_options)))
+{
+}
+
+BatchReplayRunner::BatchReplayRunner(
+    std::vector<Contracts::SymbolDataset> datasets,
+    std::shared_ptr<const Bootstrap::LoadedDatasets> shared_data)
+    : datasets_(std::move(datasets)),
+      shared_data_(std::move(shared_data))
+{
+}
+
+std::shared_ptr<BinanceExchange> BatchReplayRunner::make_exchange(
+    std::shared_ptr<QTrading::Log::Logger> logger,
+    const Account::AccountInitConfig& account_init,
+    uint64_t run_id) const
+{
+    return std::make_shared<BinanceExchange>(datasets_, shared_data_, std::move(logger), account_init, run_id);
+}
+
+std::vector<BatchRunResult> BatchReplayRunner::run(
+    size_t run_count,
+    const RunBody& body,
+    size_t max_parallelism) const
+{
+    std::vector<BatchRunResult> results(run_count);
+    std::atomic<size_t> next_run{ 0 };
+
+    const auto worker = [&]() {
+        for (;;) {
+            const size_t run_index = next_run.fetch_add(1, std::memory_order_relaxed);
+            if (run_index >= run_count) {
+                return;
+            }
+            auto& result = results[run_index];
+            const auto start = std::chrono::steady_clock::now();
+            try {
+                result.steps = body(run_index, *this);
+            }
+            catch (...) {
+                result.error = std::current_exception();
+            }
+            const auto end = std::chrono::steady_clock::now();
+            result.elapsed_ns = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        }
+    };
+
+    size_t worker_count = max_parallelism;
+    if (worker_count == 0) {
+        worker_count = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    worker_count = std::min(worker_count, run_count);
+    if (worker_count <= 1) {
+        worker();
+        return results;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(worker_count);
+    for (size_t w = 0; w < worker_count; ++w) {
+        workers.emplace_back(worker);
+    }
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    return results;
+}
+
+} // namespace QTrading::Infra::Exchanges::BinanceSim::Application
@@ -1,9 +1,12 @@
 #include "Exchanges/BinanceSimulator/Application/MarketReplayKernel.hpp"
 
 #include <algorithm>
+#include <bit>
 #include <limits>
+#include <optional>
 #include <utility>
 
+#include "Exchanges/BinanceSimulator/Application/ReplayMinuteGridBuilder.hpp"
 #include "Exchanges/BinanceSimulator/State/StepKernelState.hpp"
 
 namespace QTrading::Infra::Exchanges::BinanceSim::Application {
@@ -41,40 +44,69 @@ void drop_stale_funding_heap_entries(State::StepKernelState& state)
     }
 }
 
-State::ReplayPayloadBuffer make_payload_buffer(size_t symbol_count)
+// Full scan for the earliest pending market/funding timestamp. Only needed when
+// the calendar is invalidated; regular steps fold this into their symbol pass.
+uint64_t scan_calendar_next_ts(const State::StepKernelState& state) noexcept
+{
+    uint64_t next_ts = std::numeric_limits<uint64_t>::max();
+    const size_t market_count = std::min(state.has_next_ts.size(), state.next_ts_by_symbol.size());
+    for (size_t i = 0; i < market_count; ++i) {
+        if (state.has_next_ts[i]) {
+            next_ts = std::min(next_ts, state.next_ts_by_symbol[i]);
+        }
+    }
+    const size_t funding_count =
+        std::min(state.has_next_funding_ts.size(), state.next_funding_ts_by_symbol.size());
+    for (size_t i = 0; i < funding_count; ++i) {
+        if (state.has_next_funding_ts[i]) {
+            next_ts = std::min(next_ts, state.next_funding_ts_by_symbol[i]);
+        }
+    }
+    return next_ts;
+}
+
+State::ReplayPayloadBuffer make_payload_buffer(size_t symbol_count, size_t row_count)
 {
     State::ReplayPayloadBuffer buffer{};
     buffer.dto = std::make_shared<QTrading::Dto::Market::Binance::MultiKlineDto>();
-    buffer.dto->trade_klines_by_id.resize(symbol_count);
-    buffer.dto->mark_klines_by_id.resize(symbol_count);
-    buffer.dto->index_klines_by_id.resize(symbol_count);
-    buffer.dto->funding_by_id.resize(symbol_count);
-    buffer.touched_trade_ids.reserve(symbol_count);
-    buffer.touched_mark_ids.reserve(symbol_count);
-    buffer.touched_index_ids.reserve(symbol_count);
-    buffer.touched_funding_ids.reserve(symbol_count);
+    buffer.dto->frame.resize(symbol_count);
+    buffer.dto->trade_klines_by_id.resize(row_count);
+    buffer.dto->mark_klines_by_id.resize(row_count);
+    buffer.dto->index_klines_by_id.resize(row_count);
+    buffer.dto->funding_by_id.resize(row_count);
+    buffer.touched_trade_ids.reserve(row_count);
+    buffer.touched_mark_ids.reserve(row_count);
+    buffer.touched_index_ids.reserve(row_count);
+    buffer.touched_funding_ids.reserve(row_count);
     return buffer;
 }
 
-void ensure_payload_buffer_shape(State::ReplayPayloadBuffer& buffer, size_t symbol_count)
+// `row_count` is the symbol count when optional rows are enabled, else 0.
+void ensure_payload_buffer_shape(State::ReplayPayloadBuffer& buffer, size_t symbol_count, size_t row_count)
 {
     if (buffer.dto == nullptr) {
-        buffer = make_payload_buffer(symbol_count);
+        buffer = make_payload_buffer(symbol_count, row_count);
         return;
     }
-    if (buffer.dto->trade_klines_by_id.size() != symbol_count) {
-        buffer.dto->trade_klines_by_id.resize(symbol_count);
-        buffer.dto->mark_klines_by_id.resize(symbol_count);
-        buffer.dto->index_klines_by_id.resize(symbol_count);
-        buffer.dto->funding_by_id.resize(symbol_count);
+    if (buffer.dto->frame.symbol_count != symbol_count) {
+        buffer.dto->frame.resize(symbol_count);
+    }
+    else {
+        buffer.dto->frame.clear_presence();
+    }
+    if (buffer.dto->trade_klines_by_id.size() != row_count) {
+        buffer.dto->trade_klines_by_id.assign(row_count, std::nullopt);
+        buffer.dto->mark_klines_by_id.assign(row_count, std::nullopt);
+        buffer.dto->index_klines_by_id.assign(row_count, std::nullopt);
+        buffer.dto->funding_by_id.assign(row_count, std::nullopt);
         buffer.touched_trade_ids.clear();
         buffer.touched_mark_ids.clear();
         buffer.touched_index_ids.clear();
         buffer.touched_funding_ids.clear();
-        buffer.touched_trade_ids.reserve(symbol_count);
-        buffer.touched_mark_ids.reserve(symbol_count);
-        buffer.touched_index_ids.reserve(symbol_count);
-        buffer.touched_funding_ids.reserve(symbol_count);
+        buffer.touched_trade_ids.reserve(row_count);
+        buffer.touched_mark_ids.reserve(row_count);
+        buffer.touched_index_ids.reserve(row_count);
+        buffer.touched_funding_ids.reserve(row_count);
         return;
     }
     for (const auto symbol_id : buffer.touched_trade_ids) {
@@ -106,10 +138,11 @@ void ensure_payload_buffer_shape(State::ReplayPayloadBuffer& buffer, size_t symb
 State::ReplayPayloadBuffer& acquire_payload_buffer(State::StepKernelState& state)
 {
     const size_t symbol_count = state.symbols.size();
+    const size_t row_count = state.replay_row_payload_enabled ? symbol_count : 0;
     if (state.replay_payload_pool.empty()) {
         state.replay_payload_pool.reserve(kReplayPayloadInitialPoolSize);
         for (size_t i = 0; i < kReplayPayloadInitialPoolSize; ++i) {
-            state.replay_payload_pool.emplace_back(make_payload_buffer(symbol_count));
+            state.replay_payload_pool.emplace_back(make_payload_buffer(symbol_count, row_count));
         }
         state.replay_payload_pool_cursor = 0;
     }
@@ -124,46 +157,19 @@ State::ReplayPayloadBuffer& acquire_payload_buffer(State::StepKernelState& state
         }
     }
     if (selected_idx == state.replay_payload_pool.size()) {
-        state.replay_payload_pool.emplace_back(make_payload_buffer(symbol_count));
+        state.replay_payload_pool.emplace_back(make_payload_buffer(symbol_count, row_count));
         selected_idx = state.replay_payload_pool.size() - 1;
     }
 
     state.replay_payload_pool_cursor = (selected_idx + 1) % state.replay_payload_pool.size();
     auto& selected = state.replay_payload_pool[selected_idx];
-    ensure_payload_buffer_shape(selected, symbol_count);
+    ensure_payload_buffer_shape(selected, symbol_count, row_count);
     return selected;
 }
 
-} // namespace
-
-MarketReplayStepFrame MarketReplayKernel::Next(State::StepKernelState& state)
+// Sizes the current-step SoA caches for `symbol_count` symbols and clears their presence flags.
+void reset_step_caches(State::StepKernelState& state, size_t symbol_count)
 {
-    // Build one MultiKline DTO for the minimum timestamp across market + funding
-    // timelines, then advance all symbols that match this timestamp.
-    MarketReplayStepFrame out{};
-    drop_stale_heap_entries(state);
-    const uint64_t market_next_ts = state.next_ts_heap.empty()
-        ? std::numeric_limits<uint64_t>::max()
-        : state.next_ts_heap.top().ts;
-
-    drop_stale_funding_heap_entries(state);
-    const uint64_t funding_next_ts = state.next_funding_ts_heap.empty()
-        ? std::numeric_limits<uint64_t>::max()
-        : state.next_funding_ts_heap.top().ts;
-
-    const uint64_t ts = std::min(market_next_ts, funding_next_ts);
-    if (ts == std::numeric_limits<uint64_t>::max()) {
-        return out;
-    }
-
-    out.has_next = true;
-    out.ts_exchange = ts;
-
-    auto& payload_buffer = acquire_payload_buffer(state);
-    auto dto = payload_buffer.dto;
-    dto->Timestamp = ts;
-    dto->symbols = state.symbols_shared;
-    const size_t symbol_count = state.symbols.size();
     if (state.replay_has_trade_kline_by_symbol.size() != symbol_count) {
         state.replay_has_trade_kline_by_symbol.assign(symbol_count, 0);
         state.replay_trade_open_by_symbol.assign(symbol_count, 0.0);
@@ -186,135 +192,584 @@ MarketReplayStepFrame MarketReplayKernel::Next(State::StepKernelState& state)
         std::fill(state.replay_has_index_price_by_symbol.begin(), state.replay_has_index_price_by_symbol.end(), 0);
         std::fill(state.replay_has_funding_by_symbol.begin(), state.replay_has_funding_by_symbol.end(), 0);
     }
+}
 
-    for (size_t i = 0; i < symbol_count; ++i) {
-        if (i >= state.has_next_ts.size() || !state.has_next_ts[i]) {
-            // no market kline for this symbol in this step
+// Emits the funding row due at the current step for `symbol_id` and advances its cursor.
+void emit_funding_row(
+    State::StepKernelState& state,
+    State::ReplayPayloadBuffer& payload_buffer,
+    QTrading::Dto::Market::Binance::MultiKlineDto& dto,
+    size_t symbol_id,
+    bool maintain_heap)
+{
+    const int32_t data_id = state.funding_data_id_by_symbol[symbol_id];
+    if (data_id < 0 || static_cast<size_t>(data_id) >= state.funding_data_pool.size()) {
+        state.has_next_funding_ts[symbol_id] = 0;
+        return;
+    }
+    auto& funding_data = state.funding_data_pool[static_cast<size_t>(data_id)];
+    size_t cursor = state.funding_cursor_by_symbol[symbol_id];
+    if (cursor >= funding_data.get_count()) {
+        state.has_next_funding_ts[symbol_id] = 0;
+        return;
+    }
+
+    const auto funding = funding_data.get_funding(cursor);
+    dto.frame.set_funding(symbol_id, funding);
+    if (state.replay_row_payload_enabled) {
+        dto.funding_by_id[symbol_id] = funding;
+        payload_buffer.touched_funding_ids.push_back(symbol_id);
+    }
+    state.replay_has_funding_by_symbol[symbol_id] = 1;
+    state.replay_funding_rate_by_symbol[symbol_id] = funding.Rate;
+    state.replay_funding_time_by_symbol[symbol_id] = funding.FundingTime;
+    ++cursor;
+    state.funding_cursor_by_symbol[symbol_id] = cursor;
+    if (cursor < funding_data.get_count()) {
+        state.next_funding_ts_by_symbol[symbol_id] = funding_data.get_funding(cursor).FundingTime;
+        if (maintain_heap) {
+            state.next_funding_ts_heap.push(
+                State::StepKernelHeapItem{ state.next_funding_ts_by_symbol[symbol_id], symbol_id });
         }
-        else if (state.next_ts_by_symbol[i] == ts) {
-            const size_t cur = state.replay_cursor[i];
-            const auto& trade_kline = state.market_data[i].get_kline(cur);
-            dto->trade_klines_by_id[i] = trade_kline;
-            payload_buffer.touched_trade_ids.push_back(i);
-            state.replay_has_trade_kline_by_symbol[i] = 1;
-            state.replay_trade_open_by_symbol[i] = trade_kline.OpenPrice;
-            state.replay_trade_high_by_symbol[i] = trade_kline.HighPrice;
-            state.replay_trade_low_by_symbol[i] = trade_kline.LowPrice;
-            state.replay_trade_close_by_symbol[i] = trade_kline.ClosePrice;
-            state.replay_trade_volume_by_symbol[i] = trade_kline.Volume;
-            state.replay_trade_taker_buy_base_volume_by_symbol[i] = trade_kline.TakerBuyBaseVolume;
-
-            const size_t next = cur + 1;
-            state.replay_cursor[i] = next;
-            if (next < state.market_data[i].get_klines_count()) {
-                const uint64_t next_ts = state.market_data[i].get_kline(next).Timestamp;
-                state.next_ts_by_symbol[i] = next_ts;
-                state.next_ts_heap.push(State::StepKernelHeapItem{ next_ts, i });
-            }
-            else {
-                state.has_next_ts[i] = 0;
+    }
+    else {
+        state.has_next_funding_ts[symbol_id] = 0;
+    }
+}
+
+// Emits the trade kline at the replay cursor of `symbol_id` and advances the cursor.
+void emit_trade_row(
+    State::StepKernelState& state,
+    State::ReplayPayloadBuffer& payload_buffer,
+    QTrading::Dto::Market::Binance::MultiKlineDto& dto,
+    size_t symbol_id,
+    bool maintain_heap)
+{
+    const size_t cur = state.replay_cursor[symbol_id];
+    const auto& trade_kline = state.market_data[symbol_id].get_kline(cur);
+    dto.frame.set_trade(symbol_id, trade_kline);
+    if (state.replay_row_payload_enabled) {
+        dto.trade_klines_by_id[symbol_id] = trade_kline;
+        payload_buffer.touched_trade_ids.push_back(symbol_id);
+    }
+    state.replay_has_trade_kline_by_symbol[symbol_id] = 1;
+    state.replay_trade_open_by_symbol[symbol_id] = trade_kline.OpenPrice;
+    state.replay_trade_high_by_symbol[symbol_id] = trade_kline.HighPrice;
+    state.replay_trade_low_by_symbol[symbol_id] = trade_kline.LowPrice;
+    state.replay_trade_close_by_symbol[symbol_id] = trade_kline.ClosePrice;
+    state.replay_trade_volume_by_symbol[symbol_id] = trade_kline.Volume;
+    state.replay_trade_taker_buy_base_volume_by_symbol[symbol_id] = trade_kline.TakerBuyBaseVolume;
+
+    const size_t next = cur + 1;
+    state.replay_cursor[symbol_id] = next;
+    if (state.replay_read_ahead) {
+        state.replay_read_ahead->advance_trade(symbol_id, next);
+    }
+    if (next < state.market_data[symbol_id].get_klines_count()) {
+        const uint64_t next_ts = state.market_data[symbol_id].timestamps()[next];
+        state.next_ts_by_symbol[symbol_id] = next_ts;
+        if (maintain_heap) {
+            state.next_ts_heap.push(State::StepKernelHeapItem{ next_ts, symbol_id });
+        }
+    }
+    else {
+        state.has_next_ts[symbol_id] = 0;
+    }
+}
+
+// Advances the mark cursor of `symbol_id` up to `ts` and emits the row opening exactly at `ts`.
+void advance_mark_row(
+    State::StepKernelState& state,
+    State::ReplayPayloadBuffer& payload_buffer,
+    QTrading::Dto::Market::Binance::MultiKlineDto& dto,
+    size_t symbol_id,
+    uint64_t ts)
+{
+    const int32_t data_id = state.mark_data_id_by_symbol[symbol_id];
+    if (data_id < 0 || static_cast<size_t>(data_id) >= state.mark_data_pool.size()) {
+        state.has_next_mark_ts[symbol_id] = 0;
+        return;
+    }
+    const auto& mark_data = state.mark_data_pool[static_cast<size_t>(data_id)];
+    const auto mark_ts = mark_data.timestamps();
+    const auto mark_close = mark_data.close_prices();
+    size_t cursor = state.mark_cursor_by_symbol[symbol_id];
+    const size_t total = mark_ts.size();
+    while (cursor < total && mark_ts[cursor] < ts) {
+        ++cursor;
+    }
+    if (cursor < total && mark_ts[cursor] == ts) {
+        dto.frame.set_mark(symbol_id, mark_close[cursor]);
+        if (state.replay_row_payload_enabled) {
+            dto.mark_klines_by_id[symbol_id] = QTrading::Dto::Market::Binance::ReferenceKlineDto::Point(
+                mark_ts[cursor],
+                mark_close[cursor]);
+            payload_buffer.touched_mark_ids.push_back(symbol_id);
+        }
+        state.replay_has_mark_price_by_symbol[symbol_id] = 1;
+        state.replay_mark_price_by_symbol[symbol_id] = mark_close[cursor];
+        ++cursor;
+    }
+    state.mark_cursor_by_symbol[symbol_id] = cursor;
+    if (state.replay_read_ahead) {
+        state.replay_read_ahead->advance_mark(static_cast<size_t>(data_id), cursor);
+    }
+    if (cursor < total) {
+        state.next_mark_ts_by_symbol[symbol_id] = mark_ts[cursor];
+    }
+    else {
+        state.has_next_mark_ts[symbol_id] = 0;
+    }
+}
+
+// Advances the index cursor of `symbol_id` up to `ts` and emits the row opening exactly at `ts`.
+void advance_index_row(
+    State::StepKernelState& state,
+    State::ReplayPayloadBuffer& payload_buffer,
+    QTrading::Dto::Market::Binance::MultiKlineDto& dto,
+    size_t symbol_id,
+    uint64_t ts)
+{
+    const int32_t data_id = state.index_data_id_by_symbol[symbol_id];
+    if (data_id < 0 || static_cast<size_t>(data_id) >= state.index_data_pool.size()) {
+        state.has_next_index_ts[symbol_id] = 0;
+        return;
+    }
+    const auto& index_data = state.index_data_pool[static_cast<size_t>(data_id)];
+    const auto index_ts = index_data.timestamps();
+    const auto index_close = index_data.close_prices();
+    size_t cursor = state.index_cursor_by_symbol[symbol_id];
+    const size_t total = index_ts.size();
+    while (cursor < total && index_ts[cursor] < ts) {
+        ++cursor;
+    }
+    if (cursor < total && index_ts[cursor] == ts) {
+        dto.frame.set_index(symbol_id, index_close[cursor]);
+        if (state.replay_row_payload_enabled) {
+            dto.index_klines_by_id[symbol_id] = QTrading::Dto::Market::Binance::ReferenceKlineDto::Point(
+                index_ts[cursor],
+                index_close[cursor]);
+            payload_buffer.touched_index_ids.push_back(symbol_id);
+        }
+        state.replay_has_index_price_by_symbol[symbol_id] = 1;
+        state.replay_index_price_by_symbol[symbol_id] = index_close[cursor];
+        ++cursor;
+    }
+    state.index_cursor_by_symbol[symbol_id] = cursor;
+    if (state.replay_read_ahead) {
+        state.replay_read_ahead->advance_index(static_cast<size_t>(data_id), cursor);
+    }
+    if (cursor < total) {
+        state.next_index_ts_by_symbol[symbol_id] = index_ts[cursor];
+    }
+    else {
+        state.has_next_index_ts[symbol_id] = 0;
+    }
+}
+
+// Calls `fn(symbol_id)` for every set bit of a presence row, in ascending symbol order.
+template <typename Fn>
+void for_each_present_symbol(const uint64_t* words, size_t word_count, size_t symbol_count, Fn&& fn)
+{
+    for (size_t w = 0; w < word_count; ++w) {
+        uint64_t bits = words[w];
+        while (bits != 0) {
+            const size_t symbol_id = w * 64 + static_cast<size_t>(std::countr_zero(bits));
+            bits &= bits - 1;
+            if (symbol_id < symbol_count) {
+                fn(symbol_id);
             }
         }
+    }
+}
+
+// MinuteGrid step: only symbols with a presence bit are visited.
+void emit_grid_minute(
+    State::StepKernelState& state,
+    const State::ReplayMinuteGrid& grid,
+    size_t minute,
+    uint64_t ts,
+    State::ReplayPayloadBuffer& payload_buffer,
+    QTrading::Dto::Market::Binance::MultiKlineDto& dto)
+{
+    const size_t symbol_count = state.symbols.size();
+    const size_t words = grid.words_per_minute;
+    for_each_present_symbol(grid.trade_words(minute), words, symbol_count, [&](size_t i) {
+        if (state.has_next_ts[i] && state.next_ts_by_symbol[i] == ts) {
+            emit_trade_row(state, payload_buffer, dto, i, false);
+        }
+    });
 
+    // Reference rows of skipped (empty) minutes are consumed by the next step, as in the
+    // timestamp merges, so union their presence bits into this step.
+    auto& reference_words = state.replay_grid_words_scratch;
+    const size_t first_minute = std::min(state.replay_grid_minute, minute);
+    reference_words.assign(words, 0);
+    for (size_t m = first_minute; m <= minute; ++m) {
+        const uint64_t* mark = grid.mark_words(m);
+        for (size_t w = 0; w < words; ++w) {
+            reference_words[w] |= mark[w];
+        }
+    }
+    for_each_present_symbol(reference_words.data(), words, symbol_count, [&](size_t i) {
         if (i < state.has_next_mark_ts.size() && state.has_next_mark_ts[i]) {
+            advance_mark_row(state, payload_buffer, dto, i, ts);
+        }
+    });
+    reference_words.assign(words, 0);
+    for (size_t m = first_minute; m <= minute; ++m) {
+        const uint64_t* index = grid.index_words(m);
+        for (size_t w = 0; w < words; ++w) {
+            reference_words[w] |= index[w];
+        }
+    }
+    for_each_present_symbol(reference_words.data(), words, symbol_count, [&](size_t i) {
+        if (i < state.has_next_index_ts.size() && state.has_next_index_ts[i]) {
+            advance_index_row(state, payload_buffer, dto, i, ts);
+        }
+    });
+
+    for_each_present_symbol(grid.funding_words(minute), words, symbol_count, [&](size_t i) {
+        if (state.has_next_funding_ts[i] && state.next_funding_ts_by_symbol[i] == ts) {
+            emit_funding_row(state, payload_buffer, dto, i, false);
+        }
+    });
+    state.replay_grid_minute = minute + 1;
+}
+
+// Cuts the next MinuteGrid panel window at the current cursors.
+void cut_minute_grid_window(State::StepKernelState& state)
+{
+    state.replay_minute_grid = BuildReplayMinuteGrid(state, state.replay_minute_grid_window_minutes);
+    state.replay_grid_minute = 0;
+    state.calendar_next_ts_valid = false;
+}
+
+const FundingRateData* funding_data_for(const State::StepKernelState& state, size_t symbol_id)
+{
+    if (symbol_id >= state.funding_data_id_by_symbol.size()) {
+        return nullptr;
+    }
+    const int32_t data_id = state.funding_data_id_by_symbol[symbol_id];
+    if (data_id < 0 || static_cast<size_t>(data_id) >= state.funding_data_pool.size()) {
+        return nullptr;
+    }
+    return &state.funding_data_pool[static_cast<size_t>(data_id)];
+}
+
+// First funding row at or after `cursor` with FundingTime >= ts.
+size_t funding_lower_bound(const FundingRateData& data, size_t cursor, uint64_t ts)
+{
+    const auto it = std::lower_bound(
+        data.begin() + static_cast<std::ptrdiff_t>(cursor),
+        data.end(),
+        ts,
+        [](const QTrading::Dto::Market::Binance::FundingRateDto& row, uint64_t value) {
+            return row.FundingTime < value;
+        });
+    return static_cast<size_t>(it - data.begin());
+}
+
+// True when a pending trade or funding row opens at `ts`, i.e. replay builds a frame there.
+// `preferred_id` is probed first since reference rows usually align with their own klines.
+bool is_pending_frame_ts(const State::StepKernelState& state, uint64_t ts, size_t preferred_id)
+{
+    auto has_row_at = [&](size_t i) {
+        if (i < state.has_next_ts.size() && state.has_next_ts[i] && state.next_ts_by_symbol[i] <= ts) {
+            const auto timestamps = state.market_data[i].timestamps();
+            if (std::binary_search(timestamps.begin() + static_cast<std::ptrdiff_t>(state.replay_cursor[i]),
+                    timestamps.end(), ts)) {
+                return true;
+            }
+        }
+        if (i < state.has_next_funding_ts.size() && state.has_next_funding_ts[i] &&
+            state.next_funding_ts_by_symbol[i] <= ts) {
+            if (const auto* funding = funding_data_for(state, i)) {
+                const size_t row = funding_lower_bound(*funding, state.funding_cursor_by_symbol[i], ts);
+                return row < funding->get_count() && funding->get_funding(row).FundingTime == ts;
+            }
+        }
+        return false;
+    };
+    if (has_row_at(preferred_id)) {
+        return true;
+    }
+    for (size_t i = 0; i < state.symbols.size(); ++i) {
+        if (i != preferred_id && has_row_at(i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Moves a reference cursor to the first row at or after `ts`. The last skipped row that
+// a frame would have emitted is left in `has_price`/`price`, as a regular step would.
+void skip_reference_rows(
+    const State::StepKernelState& state,
+    const ReferenceKlineData& data,
+    size_t symbol_id,
+    uint64_t ts,
+    size_t& cursor,
+    uint8_t& has_price,
+    double& price)
+{
+    const auto timestamps = data.timestamps();
+    const auto closes = data.close_prices();
+    const size_t end = data.lower_bound_ts(ts, cursor);
+    for (size_t row = end; row > cursor; --row) {
+        if (is_pending_frame_ts(state, timestamps[row - 1], symbol_id)) {
+            has_price = 1;
+            price = closes[row - 1];
+            break;
+        }
+    }
+    cursor = end;
+}
+
+} // namespace
+
+void MarketReplayKernel::ResetMerge(State::StepKernelState& state)
+{
+    state.next_ts_heap = {};
+    state.next_funding_ts_heap = {};
+    state.calendar_next_ts = std::numeric_limits<uint64_t>::max();
+    state.calendar_next_ts_valid = false;
+    state.replay_minute_grid = nullptr;
+    state.replay_grid_minute = 0;
+    if (state.replay_merge_mode == Config::ReplayMergeMode::MinuteGrid) {
+        cut_minute_grid_window(state);
+        return;
+    }
+    if (state.replay_merge_mode != Config::ReplayMergeMode::TimestampHeap) {
+        return;
+    }
+    const size_t market_count = std::min(state.has_next_ts.size(), state.next_ts_by_symbol.size());
+    for (size_t i = 0; i < market_count; ++i) {
+        if (state.has_next_ts[i]) {
+            state.next_ts_heap.push(State::StepKernelHeapItem{ state.next_ts_by_symbol[i], i });
+        }
+    }
+    const size_t funding_count =
+        std::min(state.has_next_funding_ts.size(), state.next_funding_ts_by_symbol.size());
+    for (size_t i = 0; i < funding_count; ++i) {
+        if (state.has_next_funding_ts[i]) {
+            state.next_funding_ts_heap.push(State::StepKernelHeapItem{ state.next_funding_ts_by_symbol[i], i });
+        }
+    }
+}
+
+std::optional<uint64_t> MarketReplayKernel::SkipBefore(State::StepKernelState& state, uint64_t ts)
+{
+    const size_t symbol_count = state.symbols.size();
+    reset_step_caches(state, symbol_count);
+
+    // Reference rows first: whether a frame would have emitted them depends on the
+    // trade and funding cursors before they move.
+    for (size_t i = 0; i < symbol_count; ++i) {
+        if (i < state.has_next_mark_ts.size() && state.has_next_mark_ts[i] && state.next_mark_ts_by_symbol[i] < ts) {
             const int32_t data_id = state.mark_data_id_by_symbol[i];
-            if (data_id < 0 || static_cast<size_t>(data_id) >= state.mark_data_pool.size()) {
-                state.has_next_mark_ts[i] = 0;
+            const auto& mark_data = state.mark_data_pool[static_cast<size_t>(data_id)];
+            size_t cursor = state.mark_cursor_by_symbol[i];
+            skip_reference_rows(state, mark_data, i, ts, cursor,
+                state.replay_has_mark_price_by_symbol[i], state.replay_mark_price_by_symbol[i]);
+            state.mark_cursor_by_symbol[i] = cursor;
+            if (state.replay_read_ahead) {
+                state.replay_read_ahead->advance_mark(static_cast<size_t>(data_id), cursor);
+            }
+            if (cursor < mark_data.timestamps().size()) {
+                state.next_mark_ts_by_symbol[i] = mark_data.timestamps()[cursor];
             }
             else {
-                auto& mark_data = state.mark_data_pool[static_cast<size_t>(data_id)];
-                size_t cursor = state.mark_cursor_by_symbol[i];
-                const size_t total = mark_data.get_klines_count();
-                while (cursor < total && mark_data.get_kline(cursor).Timestamp < ts) {
-                    ++cursor;
-                }
-                if (cursor < total && mark_data.get_kline(cursor).Timestamp == ts) {
-                    const auto& kline = mark_data.get_kline(cursor);
-                    dto->mark_klines_by_id[i] = QTrading::Dto::Market::Binance::ReferenceKlineDto::Point(
-                        kline.Timestamp,
-                        kline.ClosePrice);
-                    payload_buffer.touched_mark_ids.push_back(i);
-                    state.replay_has_mark_price_by_symbol[i] = 1;
-                    state.replay_mark_price_by_symbol[i] = kline.ClosePrice;
-                    ++cursor;
-                }
-                state.mark_cursor_by_symbol[i] = cursor;
-                if (cursor < total) {
-                    state.next_mark_ts_by_symbol[i] = mark_data.get_kline(cursor).Timestamp;
-                }
-                else {
-                    state.has_next_mark_ts[i] = 0;
-                }
+                state.has_next_mark_ts[i] = 0;
             }
         }
-
-        if (i < state.has_next_index_ts.size() && state.has_next_index_ts[i]) {
+        if (i < state.has_next_index_ts.size() && state.has_next_index_ts[i] && state.next_index_ts_by_symbol[i] < ts) {
             const int32_t data_id = state.index_data_id_by_symbol[i];
-            if (data_id < 0 || static_cast<size_t>(data_id) >= state.index_data_pool.size()) {
+            const auto& index_data = state.index_data_pool[static_cast<size_t>(data_id)];
+            size_t cursor = state.index_cursor_by_symbol[i];
+            skip_reference_rows(state, index_data, i, ts, cursor,
+                state.replay_has_index_price_by_symbol[i], state.replay_index_price_by_symbol[i]);
+            state.index_cursor_by_symbol[i] = cursor;
+            if (state.replay_read_ahead) {
+                state.replay_read_ahead->advance_index(static_cast<size_t>(data_id), cursor);
+            }
+            if (cursor < index_data.timestamps().size()) {
+                state.next_index_ts_by_symbol[i] = index_data.timestamps()[cursor];
+            }
+            else {
                 state.has_next_index_ts[i] = 0;
             }
+        }
+    }
+
+    uint64_t last_skipped_ts = 0;
+    bool skipped = false;
+    for (size_t i = 0; i < symbol_count; ++i) {
+        if (i < state.has_next_ts.size() && state.has_next_ts[i] && state.next_ts_by_symbol[i] < ts) {
+            const auto& data = state.market_data[i];
+            const auto timestamps = data.timestamps();
+            const size_t end = static_cast<size_t>(std::lower_bound(
+                timestamps.begin() + static_cast<std::ptrdiff_t>(state.replay_cursor[i]),
+                timestamps.end(),
+                ts) - timestamps.begin());
+            const size_t last = end - 1;
+            state.replay_has_trade_kline_by_symbol[i] = 1;
+            state.replay_trade_open_by_symbol[i] = data.open_prices()[last];
+            state.replay_trade_high_by_symbol[i] = data.high_prices()[last];
+            state.replay_trade_low_by_symbol[i] = data.low_prices()[last];
+            state.replay_trade_close_by_symbol[i] = data.close_prices()[last];
+            state.replay_trade_volume_by_symbol[i] = data.volumes()[last];
+            state.replay_trade_taker_buy_base_volume_by_symbol[i] = data.taker_buy_base_volumes()[last];
+            last_skipped_ts = std::max(last_skipped_ts, timestamps[last]);
+            skipped = true;
+
+            state.replay_cursor[i] = end;
+            if (state.replay_read_ahead) {
+                state.replay_read_ahead->advance_trade(i, end);
+            }
+            if (end < timestamps.size()) {
+                state.next_ts_by_symbol[i] = timestamps[end];
+            }
             else {
-                auto& index_data = state.index_data_pool[static_cast<size_t>(data_id)];
-                size_t cursor = state.index_cursor_by_symbol[i];
-                const size_t total = index_data.get_klines_count();
-                while (cursor < total && index_data.get_kline(cursor).Timestamp < ts) {
-                    ++cursor;
-                }
-                if (cursor < total && index_data.get_kline(cursor).Timestamp == ts) {
-                    const auto& kline = index_data.get_kline(cursor);
-                    dto->index_klines_by_id[i] = QTrading::Dto::Market::Binance::ReferenceKlineDto::Point(
-                        kline.Timestamp,
-                        kline.ClosePrice);
-                    payload_buffer.touched_index_ids.push_back(i);
-                    state.replay_has_index_price_by_symbol[i] = 1;
-                    state.replay_index_price_by_symbol[i] = kline.ClosePrice;
-                    ++cursor;
-                }
-                state.index_cursor_by_symbol[i] = cursor;
-                if (cursor < total) {
-                    state.next_index_ts_by_symbol[i] = index_data.get_kline(cursor).Timestamp;
-                }
-                else {
-                    state.has_next_index_ts[i] = 0;
-                }
+                state.has_next_ts[i] = 0;
             }
         }
+        if (i < state.has_next_funding_ts.size() && state.has_next_funding_ts[i] &&
+            state.next_funding_ts_by_symbol[i] < ts) {
+            const auto* funding_data = funding_data_for(state, i);
+            if (funding_data == nullptr) {
+                state.has_next_funding_ts[i] = 0;
+                continue;
+            }
+            const size_t end = funding_lower_bound(*funding_data, state.funding_cursor_by_symbol[i], ts);
+            const auto& funding = funding_data->get_funding(end - 1);
+            state.replay_has_funding_by_symbol[i] = 1;
+            state.replay_funding_rate_by_symbol[i] = funding.Rate;
+            state.replay_funding_time_by_symbol[i] = funding.FundingTime;
+            last_skipped_ts = std::max(last_skipped_ts, funding.FundingTime);
+            skipped = true;
 
-        if (i >= state.has_next_funding_ts.size() || !state.has_next_funding_ts[i]) {
-            continue;
+            state.funding_cursor_by_symbol[i] = end;
+            if (end < funding_data->get_count()) {
+                state.next_funding_ts_by_symbol[i] = funding_data->get_funding(end).FundingTime;
+            }
+            else {
+                state.has_next_funding_ts[i] = 0;
+            }
         }
-        if (state.next_funding_ts_by_symbol[i] != ts) {
-            continue;
+    }
+    if (!skipped) {
+        return std::nullopt;
+    }
+    ResetMerge(state);
+    return last_skipped_ts;
+}
+
+MarketReplayStepFrame MarketReplayKernel::Next(State::StepKernelState& state)
+{
+    // Build one MultiKline DTO for the minimum timestamp across market + funding
+    // timelines, then advance all symbols that match this timestamp.
+    MarketReplayStepFrame out{};
+    // MinuteGrid without a grid (off-grid window) runs as LinearCalendar.
+    const State::ReplayMinuteGrid* grid =
+        state.replay_merge_mode == Config::ReplayMergeMode::MinuteGrid ? state.replay_minute_grid.get() : nullptr;
+    size_t grid_minute = 0;
+    if (grid != nullptr) {
+        grid_minute = grid->next_step_minute(state.replay_grid_minute);
+        if (grid_minute >= grid->minute_count && grid->minute_count != 0) {
+            // Window consumed: cut the next one at the cursors; an empty one ends replay.
+            cut_minute_grid_window(state);
+            grid = state.replay_minute_grid.get();
+            grid_minute = grid != nullptr ? grid->next_step_minute(0) : 0;
         }
+    }
+    const bool use_calendar = grid == nullptr && state.replay_merge_mode != Config::ReplayMergeMode::TimestampHeap;
+    uint64_t ts = std::numeric_limits<uint64_t>::max();
+    if (grid != nullptr) {
+        if (grid_minute < grid->minute_count) {
+            ts = grid->minute_ts(grid_minute);
+        }
+        else {
+            state.replay_grid_minute = grid->minute_count;
+        }
+    }
+    else if (use_calendar) {
+        if (!state.calendar_next_ts_valid) {
+            state.calendar_next_ts = scan_calendar_next_ts(state);
+            state.calendar_next_ts_valid = true;
+        }
+        ts = state.calendar_next_ts;
+    }
+    else {
+        drop_stale_heap_entries(state);
+        const uint64_t market_next_ts = state.next_ts_heap.empty()
+            ? std::numeric_limits<uint64_t>::max()
+            : state.next_ts_heap.top().ts;
 
-        const int32_t data_id = state.funding_data_id_by_symbol[i];
-        if (data_id < 0 || static_cast<size_t>(data_id) >= state.funding_data_pool.size()) {
-            state.has_next_funding_ts[i] = 0;
-            continue;
+        drop_stale_funding_heap_entries(state);
+        const uint64_t funding_next_ts = state.next_funding_ts_heap.empty()
+            ? std::numeric_limits<uint64_t>::max()
+            : state.next_funding_ts_heap.top().ts;
+
+        ts = std::min(market_next_ts, funding_next_ts);
+    }
+    if (ts == std::numeric_limits<uint64_t>::max()) {
+        return out;
+    }
+
+    out.has_next = true;
+    out.ts_exchange = ts;
+
+    auto& payload_buffer = acquire_payload_buffer(state);
+    auto dto = payload_buffer.dto;
+    dto->Timestamp = ts;
+    dto->symbols = state.symbols_shared;
+    const size_t symbol_count = state.symbols.size();
+    reset_step_caches(state, symbol_count);
+
+    if (grid != nullptr) {
+        emit_grid_minute(state, *grid, grid_minute, ts, payload_buffer, *dto);
+        out.market_payload = std::move(dto);
+        out.minute_grid = state.replay_minute_grid;
+        out.minute_grid_minute = grid_minute;
+        return out;
+    }
+
+    // Calendar mode: earliest timestamp still pending after this step.
+    uint64_t following_ts = std::numeric_limits<uint64_t>::max();
+    for (size_t i = 0; i < symbol_count; ++i) {
+        if (i >= state.has_next_ts.size() || !state.has_next_ts[i]) {
+            // no market kline for this symbol in this step
         }
-        auto& funding_data = state.funding_data_pool[static_cast<size_t>(data_id)];
-        size_t cursor = state.funding_cursor_by_symbol[i];
-        if (cursor >= funding_data.get_count()) {
-            state.has_next_funding_ts[i] = 0;
-            continue;
+        else if (state.next_ts_by_symbol[i] == ts) {
+            emit_trade_row(state, payload_buffer, *dto, i, !use_calendar);
+        }
+        if (use_calendar && i < state.has_next_ts.size() && state.has_next_ts[i]) {
+            following_ts = std::min(following_ts, state.next_ts_by_symbol[i]);
         }
 
-        dto->funding_by_id[i] = funding_data.get_funding(cursor);
-        payload_buffer.touched_funding_ids.push_back(i);
-        state.replay_has_funding_by_symbol[i] = 1;
-        state.replay_funding_rate_by_symbol[i] = dto->funding_by_id[i]->Rate;
-        state.replay_funding_time_by_symbol[i] = dto->funding_by_id[i]->FundingTime;
-        ++cursor;
-        state.funding_cursor_by_symbol[i] = cursor;
-        if (cursor < funding_data.get_count()) {
-            state.next_funding_ts_by_symbol[i] = funding_data.get_funding(cursor).FundingTime;
-            state.next_funding_ts_heap.push(State::StepKernelHeapItem{ state.next_funding_ts_by_symbol[i], i });
+        if (i < state.has_next_mark_ts.size() && state.has_next_mark_ts[i]) {
+            advance_mark_row(state, payload_buffer, *dto, i, ts);
         }
-        else {
-            state.has_next_funding_ts[i] = 0;
+        if (i < state.has_next_index_ts.size() && state.has_next_index_ts[i]) {
+            advance_index_row(state, payload_buffer, *dto, i, ts);
+        }
+
+        if (i >= state.has_next_funding_ts.size() || !state.has_next_funding_ts[i]) {
+            continue;
+        }
+        if (state.next_funding_ts_by_symbol[i] == ts) {
+            emit_funding_row(state, payload_buffer, *dto, i, !use_calendar);
+        }
+        if (use_calendar && state.has_next_funding_ts[i]) {
+            following_ts = std::min(following_ts, state.next_funding_ts_by_symbol[i]);
         }
     }
 
+    if (use_calendar) {
+        state.calendar_next_ts = following_ts;
+        state.calendar_next_ts_valid = true;
+    }
     out.market_payload = std::move(dto);
     return out;
 }
@@ -0,0 +1,210 @@
+#include "Exchanges/BinanceSimulator/Application/ReplayMinuteGridBuilder.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "Exchanges/BinanceSimulator/State/StepKernelState.hpp"
+
+namespace QTrading::Infra::Exchanges::BinanceSim::Application {
+namespace {
+
+constexpr uint64_t kNoTimestamp = std::numeric_limits<uint64_t>::max();
+
+void set_bit(std::vector<uint64_t>& words, size_t words_per_minute, size_t minute, size_t symbol_id)
+{
+    words[minute * words_per_minute + symbol_id / 64] |= uint64_t{ 1 } << (symbol_id % 64);
+}
+
+const FundingRateData* funding_series(const State::StepKernelState& state, size_t symbol_id)
+{
+    if (symbol_id >= state.funding_data_id_by_symbol.size()) {
+        return nullptr;
+    }
+    const int32_t data_id = state.funding_data_id_by_symbol[symbol_id];
+    if (data_id < 0 || static_cast<size_t>(data_id) >= state.funding_data_pool.size()) {
+        return nullptr;
+    }
+    return &state.funding_data_pool[static_cast<size_t>(data_id)];
+}
+
+const ReferenceKlineData* reference_series(
+    const std::vector<int32_t>& data_id_by_symbol,
+    const std::vector<ReferenceKlineData>& pool,
+    size_t symbol_id)
+{
+    if (symbol_id >= data_id_by_symbol.size()) {
+        return nullptr;
+    }
+    const int32_t data_id = data_id_by_symbol[symbol_id];
+    if (data_id < 0 || static_cast<size_t>(data_id) >= pool.size()) {
+        return nullptr;
+    }
+    return &pool[static_cast<size_t>(data_id)];
+}
+
+bool has_pending(const std::vector<uint8_t>& flags, size_t symbol_id)
+{
+    return symbol_id < flags.size() && flags[symbol_id] != 0;
+}
+
+// Earliest trade/funding timestamp pending at the cursors, or kNoTimestamp.
+uint64_t first_pending_driver_ts(const State::StepKernelState& state)
+{
+    uint64_t first_ts = kNoTimestamp;
+    const size_t symbol_count = state.symbols.size();
+    for (size_t i = 0; i < symbol_count; ++i) {
+        if (has_pending(state.has_next_ts, i) && i < state.market_data.size() && i < state.replay_cursor.size()) {
+            const auto ts = state.market_data[i].timestamps();
+            if (state.replay_cursor[i] < ts.size()) {
+                first_ts = std::min(first_ts, ts[state.replay_cursor[i]]);
+            }
+        }
+        const auto* funding = has_pending(state.has_next_funding_ts, i) ? funding_series(state, i) : nullptr;
+        if (funding != nullptr && i < state.funding_cursor_by_symbol.size() &&
+            state.funding_cursor_by_symbol[i] < funding->get_count()) {
+            first_ts = std::min(first_ts, funding->get_funding(state.funding_cursor_by_symbol[i]).FundingTime);
+        }
+    }
+    return first_ts;
+}
+
+// Walks the pending trade and funding rows with timestamp < `end_ts`, series by series in
+// cursor order; `fn(symbol_id, funding, row, ts)` returns false to stop.
+template <typename Fn>
+void for_each_window_driver_row(const State::StepKernelState& state, uint64_t end_ts, Fn&& fn)
+{
+    const size_t symbol_count = state.symbols.size();
+    for (size_t i = 0; i < symbol_count; ++i) {
+        if (has_pending(state.has_next_ts, i) && i < state.market_data.size() && i < state.replay_cursor.size()) {
+            const auto ts = state.market_data[i].timestamps();
+            for (size_t row = state.replay_cursor[i]; row < ts.size() && ts[row] < end_ts; ++row) {
+                if (!fn(i, false, row, ts[row])) {
+                    return;
+                }
+            }
+        }
+        const auto* funding = has_pending(state.has_next_funding_ts, i) ? funding_series(state, i) : nullptr;
+        if (funding != nullptr && i < state.funding_cursor_by_symbol.size()) {
+            for (size_t row = state.funding_cursor_by_symbol[i]; row < funding->get_count(); ++row) {
+                const uint64_t ts = funding->get_funding(row).FundingTime;
+                if (ts >= end_ts || !fn(i, true, row, ts)) {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void fill_reference_presence(
+    std::vector<uint64_t>& words,
+    const State::ReplayMinuteGrid& grid,
+    const std::vector<uint8_t>& has_next,
+    const std::vector<size_t>& cursor_by_symbol,
+    const std::vector<int32_t>& data_id_by_symbol,
+    const std::vector<ReferenceKlineData>& pool)
+{
+    const uint64_t last_ts = grid.minute_ts(grid.minute_count - 1);
+    for (size_t i = 0; i < grid.symbol_count; ++i) {
+        const auto* series = has_pending(has_next, i) ? reference_series(data_id_by_symbol, pool, i) : nullptr;
+        if (series == nullptr || i >= cursor_by_symbol.size()) {
+            continue;
+        }
+        const auto ts = series->timestamps();
+        for (size_t row = cursor_by_symbol[i]; row < ts.size(); ++row) {
+            if (ts[row] > last_ts) {
+                break;
+            }
+            const size_t minute = ts[row] <= grid.base_ts
+                ? 0
+                : static_cast<size_t>((ts[row] - grid.base_ts + grid.step_ms - 1) / grid.step_ms);
+            set_bit(words, grid.words_per_minute, minute, i);
+        }
+    }
+}
+
+} // namespace
+
+std::shared_ptr<const State::ReplayMinuteGrid> BuildReplayMinuteGrid(
+    const State::StepKernelState& state,
+    size_t window_minutes,
+    uint64_t step_ms)
+{
+    if (step_ms == 0 || window_minutes == 0) {
+        return nullptr;
+    }
+
+    auto grid = std::make_shared<State::ReplayMinuteGrid>();
+    grid->step_ms = step_ms;
+    grid->symbol_count = state.symbols.size();
+    grid->words_per_minute = (grid->symbol_count + 63) / 64;
+    const uint64_t first_ts = first_pending_driver_ts(state);
+    if (first_ts == kNoTimestamp) {
+        return grid;
+    }
+    grid->base_ts = first_ts;
+    const uint64_t window_span = static_cast<uint64_t>(window_minutes) * step_ms;
+    const uint64_t end_ts = (window_span / step_ms != window_minutes || kNoTimestamp - first_ts < window_span)
+        ? kNoTimestamp
+        : first_ts + window_span;
+
+    // Pass 1: window extent; every driver row must own a distinct grid minute.
+    bool aligned = true;
+    uint64_t last_ts = first_ts;
+    size_t last_symbol = std::numeric_limits<size_t>::max();
+    bool last_funding = false;
+    uint64_t prev_ts = 0;
+    for_each_window_driver_row(state, end_ts, [&](size_t symbol_id, bool funding, size_t, uint64_t ts) {
+        const bool same_series = symbol_id == last_symbol && funding == last_funding;
+        if (ts < first_ts || (ts - first_ts) % step_ms != 0 || (same_series && ts <= prev_ts)) {
+            aligned = false;
+            return false;
+        }
+        last_symbol = symbol_id;
+        last_funding = funding;
+        prev_ts = ts;
+        last_ts = std::max(last_ts, ts);
+        return true;
+    });
+    if (!aligned) {
+        return nullptr;
+    }
+    grid->minute_count = static_cast<size_t>((last_ts - first_ts) / step_ms) + 1;
+
+    // Pass 2: trade/funding bits and trade closes.
+    const size_t stream_words = grid->minute_count * grid->words_per_minute;
+    grid->trade_presence.assign(stream_words, 0);
+    grid->funding_presence.assign(stream_words, 0);
+    grid->trade_close.assign(grid->minute_count * grid->symbol_count, std::numeric_limits<double>::quiet_NaN());
+    for_each_window_driver_row(state, end_ts, [&](size_t symbol_id, bool funding, size_t row, uint64_t ts) {
+        const size_t minute = static_cast<size_t>((ts - first_ts) / step_ms);
+        if (funding) {
+            set_bit(grid->funding_presence, grid->words_per_minute, minute, symbol_id);
+        }
+        else {
+            set_bit(grid->trade_presence, grid->words_per_minute, minute, symbol_id);
+            grid->trade_close[minute * grid->symbol_count + symbol_id] =
+                state.market_data[symbol_id].close_prices()[row];
+        }
+        return true;
+    });
+
+    grid->mark_presence.assign(stream_words, 0);
+    grid->index_presence.assign(stream_words, 0);
+    fill_reference_presence(
+        grid->mark_presence,
+        *grid,
+        state.has_next_mark_ts,
+        state.mark_cursor_by_symbol,
+        state.mark_data_id_by_symbol,
+        state.mark_data_pool);
+    fill_reference_presence(
+        grid->index_presence,
+        *grid,
+        state.has_next_index_ts,
+        state.index_cursor_by_symbol,
+        state.index_data_id_by_symbol,
+        state.index_data_pool);
+    return grid;
+}
+
+} // namespace QTrading::Infra::Exchanges::BinanceSim::Application
@@ -0,0 +1,102 @@
+#include "Exchanges/BinanceSimulator/Application/ReplayPrefetcher.hpp"
+
+#include <utility>
+
+#include "Exchanges/BinanceSimulator/Application/MarketReplayKernel.hpp"
+#include "Exchanges/BinanceSimulator/Application/TerminationPolicy.hpp"
+#include "Exchanges/BinanceSimulator/State/StepKernelState.hpp"
+
+namespace QTrading::Infra::Exchanges::BinanceSim::Application {
+
+ReplayPrefetcher::ReplayPrefetcher()
+{
+    // Started here, once every member the worker touches is constructed.
+    thread_ = std::thread([this]() { worker_loop(); });
+}
+
+ReplayPrefetcher::~ReplayPrefetcher()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // An in-flight frame still writes into its state; let it finish first.
+        done_cv_.wait(lock, [this]() { return !running_; });
+        stopping_ = true;
+    }
+    work_cv_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void ReplayPrefetcher::start(State::StepKernelState& state)
+{
+    // Assign keeps capacity, so steady-state pipelining does not allocate.
+    state.committed_replay_cursor.assign(state.replay_cursor.begin(), state.replay_cursor.end());
+    state.committed_mark_cursor_by_symbol.assign(
+        state.mark_cursor_by_symbol.begin(), state.mark_cursor_by_symbol.end());
+    state.committed_index_cursor_by_symbol.assign(
+        state.index_cursor_by_symbol.begin(), state.index_cursor_by_symbol.end());
+    state.replay_prefetch_pending = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        state_ = &state;
+        frame_ = MarketReplayStepFrame{};
+        error_ = nullptr;
+        running_ = true;
+    }
+    work_cv_.notify_one();
+}
+
+void ReplayPrefetcher::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() { return !running_; });
+}
+
+MarketReplayStepFrame ReplayPrefetcher::take(State::StepKernelState& state)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() { return !running_; });
+    state_ = nullptr;
+    state.replay_prefetch_pending = false;
+    if (error_) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+    return std::move(frame_);
+}
+
+void ReplayPrefetcher::worker_loop()
+{
+    for (;;) {
+        State::StepKernelState* state = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_cv_.wait(lock, [this]() { return stopping_ || running_; });
+            if (stopping_) {
+                return;
+            }
+            state = state_;
+        }
+
+        MarketReplayStepFrame frame{};
+        std::exception_ptr error;
+        try {
+            if (!TerminationPolicy::IsReplayExhausted(*state)) {
+                frame = MarketReplayKernel::Next(*state);
+            }
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            frame_ = std::move(frame);
+            error_ = error;
+            running_ = false;
+        }
+        done_cv_.notify_all();
+    }
+}
+
+} // namespace QTrading::Infra::Exchanges::BinanceSim::Application
@@ -14,6 +14,8 @@
 #include "Exchanges/BinanceSimulator/Account/Config.hpp"
 #include "Exchanges/BinanceSimulator/Application/MarketReplayKernel.hpp"
 #include "Exchanges/BinanceSimulator/Application/OrderCommandKernel.hpp"
+#include "Exchanges/BinanceSimulator/Application/ReplayPrefetcher.hpp"
+#include "Exchanges/BinanceSimulator/Application/StepWorkerPool.hpp"
 #include "Exchanges/BinanceSimulator/Application/TerminationPolicy.hpp"
 #include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
 #include "Exchanges/BinanceSimulator/Domain/FillSettlementEngine.hpp"
@@ -30,12 +32,12 @@
 #include "Exchanges/BinanceSimulator/State/BinanceExchangeRuntimeState.hpp"
 #include "Exchanges/BinanceSimulator/State/SnapshotState.hpp"
 #include "Exchanges/BinanceSimulator/State/StepKernelState.hpp"
+#include "Exchanges/BookReplica.hpp"
 #include "FileLogger/FeatherV2/FundingEvent.hpp"
 #include "FileLogger/FeatherV2/MarketEvent.hpp"
 #include "FileLogger/FeatherV2/AccountEvent.hpp"
 #include "FileLogger/FeatherV2/PositionEvent.hpp"
 #include "FileLogger/FeatherV2/OrderEvent.hpp"
-#include "Global.hpp"
 #include "Logging/StepLogContext.hpp"
 #include "Enum/LogModule.hpp"
 
@@ -68,6 +70,10 @@ void rebuild_visible_positions_cache(
                 : 0;
         synthetic.order_id = 0;
         synthetic.symbol = step_state.symbols[symbol_id];
+        synthetic.interned_symbol_id =
+            symbol_id < step_state.interned_symbol_id_by_id.size()
+                ? step_state.interned_symbol_id_by_id[symbol_id]
+                : QTrading::Dto::Trading::kInvalidSymbolId;
         synthetic.quantity = qty;
         synthetic.entry_price =
             symbol_id < runtime_state.spot_inventory_entry_price_by_symbol.size()
@@ -120,66 +126,71 @@ double compute_progress_pct(const State::StepKernelState& step_state)
     return std::clamp(min_ratio, 0.0, 1.0) * 100.0;
 }
 
+// `cursor` carries the previous lower bound for this series between calls, so
+// monotonic replay resolves in amortized O(1); seeks fall back to a search.
 std::optional<double> interpolate_close_price(
-    const MarketData& data,
-    uint64_t ts)
+    const ReferenceKlineData& data,
+    uint64_t ts,
+    size_t& cursor)
 {
-    const size_t count = data.get_klines_count();
+    const auto timestamps = data.timestamps();
+    const auto closes = data.close_prices();
+    const size_t count = timestamps.size();
     if (count == 0) {
         return std::nullopt;
     }
     if (count == 1) {
-        return data.get_kline(0).ClosePrice;
+        return closes[0];
     }
 
-    const auto& first = data.get_kline(0);
-    const auto& last = data.get_kline(count - 1);
-    if (ts <= first.Timestamp) {
-        return first.ClosePrice;
+    if (ts <= timestamps.front()) {
+        return closes.front();
     }
-    if (ts >= last.Timestamp) {
-        return last.ClosePrice;
+    if (ts >= timestamps.back()) {
+        return closes.back();
     }
 
-    size_t lo = 0;
-    size_t hi = count - 1;
-    while (lo < hi) {
-        const size_t mid = lo + (hi - lo) / 2;
-        if (data.get_kline(mid).Timestamp < ts) {
-            lo = mid + 1;
-        }
-        else {
-            hi = mid;
-        }
-    }
-    const size_t right = lo;
-    if (right < count && data.get_kline(right).Timestamp == ts) {
-        return data.get_kline(right).ClosePrice;
+    const size_t right = data.lower_bound_ts(ts, cursor);
+    cursor = right;
+    if (right < count && timestamps[right] == ts) {
+        return closes[right];
     }
     if (right == 0 || right >= count) {
         return std::nullopt;
     }
 
-    const auto& lhs = data.get_kline(right - 1);
-    const auto& rhs = data.get_kline(right);
-    const uint64_t dt = rhs.Timestamp - lhs.Timestamp;
+    const uint64_t lhs_ts = timestamps[right - 1];
+    const uint64_t dt = timestamps[right] - lhs_ts;
     if (dt == 0) {
-        return rhs.ClosePrice;
+        return closes[right];
+    }
+    const double w = static_cast<double>(ts - lhs_ts) / static_cast<double>(dt);
+    return closes[right - 1] + (closes[right] - closes[right - 1]) * w;
+}
+
+std::optional<double> interpolate_close_price(
+    std::vector<size_t>& cursor_by_symbol,
+    size_t symbol_id,
+    const ReferenceKlineData& data,
+    uint64_t ts)
+{
+    if (cursor_by_symbol.size() <= symbol_id) {
+        cursor_by_symbol.resize(symbol_id + 1, 0);
     }
-    const double w = static_cast<double>(ts - lhs.Timestamp) / static_cast<double>(dt);
-    return lhs.ClosePrice + (rhs.ClosePrice - lhs.ClosePrice) * w;
+    return interpolate_close_price(data, ts, cursor_by_symbol[symbol_id]);
 }
 
 std::optional<QTrading::Dto::Market::Binance::ReferenceKlineDto> resolve_funding_mark_kline(
-    const State::StepKernelState& step_state,
+    State::StepKernelState& step_state,
     const QTrading::Dto::Market::Binance::MultiKlineDto& payload,
     size_t symbol_id,
     uint64_t funding_ts)
 {
-    if (symbol_id < payload.mark_klines_by_id.size() &&
-        payload.mark_klines_by_id[symbol_id].has_value() &&
-        payload.mark_klines_by_id[symbol_id]->OpenTime == funding_ts) {
-        return payload.mark_klines_by_id[symbol_id];
+    // Mark rows in the payload open at the step timestamp.
+    if (funding_ts == payload.Timestamp) {
+        if (const auto mark = payload.mark_close(symbol_id)) {
+            return QTrading::Dto::Market::Binance::ReferenceKlineDto::Point(funding_ts, *mark);
+        }
     }
     if (symbol_id >= step_state.mark_data_id_by_symbol.size()) {
         return std::nullopt;
@@ -189,29 +200,17 @@ std::optional<QTrading::Dto::Market::Binance::ReferenceKlineDto> resolve_funding
         return std::nullopt;
     }
     const auto& mark_data = step_state.mark_data_pool[static_cast<size_t>(data_id)];
-    const auto mark = interpolate_close_price(mark_data, funding_ts);
+    const auto mark = interpolate_close_price(
+        step_state.mark_interp_cursor_by_symbol, symbol_id, mark_data, funding_ts);
     if (!mark.has_value()) {
         return std::nullopt;
     }
     return QTrading::Dto::Market::Binance::ReferenceKlineDto::Point(funding_ts, *mark);
 }
 
-// Writes the current minimal read-model state consumed by FillStatusSnapshot().
-// Hot-path note: updates stay in-place and only touch fields needed by the
-// restored snapshot path.
-void update_snapshot_state(
-    State::SnapshotState& snapshot_state,
-    const State::StepKernelState& step_state,
-    const Output::StepObservableContext& observable_ctx)
+// Starts a new dirty-price generation: rows dirtied by the previous update are clean again.
+void reset_price_row_dirty_state(State::SnapshotState& snapshot_state)
 {
-    auto mark_price_row_dirty = [&](size_t symbol_id) {
-        if (symbol_id >= snapshot_state.price_row_dirty_by_symbol.size() ||
-            snapshot_state.price_row_dirty_by_symbol[symbol_id] != 0) {
-            return;
-        }
-        snapshot_state.price_row_dirty_by_symbol[symbol_id] = 1;
-        snapshot_state.dirty_price_symbol_ids.push_back(symbol_id);
-    };
     auto ensure_price_row_cache_shape = [&]() {
         const size_t symbol_count = std::max(
             snapshot_state.last_trade_price_by_symbol.size(),
@@ -238,86 +237,112 @@ void update_snapshot_state(
     }
     snapshot_state.dirty_price_symbol_ids.clear();
     ensure_price_row_cache_shape();
+}
 
-    snapshot_state.ts_exchange = observable_ctx.ts_exchange;
-    snapshot_state.step_seq = observable_ctx.step_seq;
-    snapshot_state.progress_pct = compute_progress_pct(step_state);
-    if (!observable_ctx.market_payload) {
-        return;
-    }
+// Folds the current-step trade/mark/index caches into the last-price read model,
+// stamping reference prices with `ts_exchange`.
+void apply_step_prices_to_snapshot(
+    State::SnapshotState& snapshot_state,
+    State::StepKernelState& step_state,
+    uint64_t ts_exchange)
+{
+    auto mark_price_row_dirty = [&](size_t symbol_id) {
+        if (symbol_id >= snapshot_state.price_row_dirty_by_symbol.size() ||
+            snapshot_state.price_row_dirty_by_symbol[symbol_id] != 0) {
+            return;
+        }
+        snapshot_state.price_row_dirty_by_symbol[symbol_id] = 1;
+        snapshot_state.dirty_price_symbol_ids.push_back(symbol_id);
+    };
+
+    constexpr uint8_t kTradeChanged = 1u << 0;
+    constexpr uint8_t kMarkChanged = 1u << 1;
+    constexpr uint8_t kIndexChanged = 1u << 2;
     const size_t count = std::min(
         step_state.replay_has_trade_kline_by_symbol.size(),
         snapshot_state.last_trade_price_by_symbol.size());
-    for (size_t i = 0; i < count; ++i) {
-        if (step_state.replay_has_trade_kline_by_symbol[i] == 0 ||
-            i >= step_state.replay_trade_close_by_symbol.size()) {
-            continue;
-        }
-        const double trade_price = step_state.replay_trade_close_by_symbol[i];
-        const bool changed =
-            snapshot_state.has_last_trade_price_by_symbol[i] == 0 ||
-            snapshot_state.last_trade_price_by_symbol[i] != trade_price;
-        snapshot_state.last_trade_price_by_symbol[i] = trade_price;
-        snapshot_state.has_last_trade_price_by_symbol[i] = 1;
-        auto& row = snapshot_state.price_rows_by_symbol[i];
-        row.trade_price = trade_price;
-        row.has_trade_price = true;
-        row.price = trade_price;
-        row.has_price = true;
-        if (changed) {
-            mark_price_row_dirty(i);
-        }
-    }
     const size_t mark_count = std::min(
         step_state.replay_has_mark_price_by_symbol.size(),
         snapshot_state.last_mark_price_by_symbol.size());
-    for (size_t i = 0; i < mark_count; ++i) {
-        if (step_state.replay_has_mark_price_by_symbol[i] == 0 ||
-            i >= step_state.replay_mark_price_by_symbol.size()) {
-            continue;
-        }
-        const double mark_price = step_state.replay_mark_price_by_symbol[i];
-        const int32_t mark_source = static_cast<int32_t>(Contracts::ReferencePriceSource::Raw);
-        const bool changed =
-            snapshot_state.has_last_mark_price_by_symbol[i] == 0 ||
-            snapshot_state.last_mark_price_by_symbol[i] != mark_price ||
-            snapshot_state.last_mark_price_source_by_symbol[i] != mark_source;
-        snapshot_state.last_mark_price_by_symbol[i] = mark_price;
-        snapshot_state.has_last_mark_price_by_symbol[i] = 1;
-        snapshot_state.last_mark_price_ts_by_symbol[i] = observable_ctx.ts_exchange;
-        snapshot_state.last_mark_price_source_by_symbol[i] = mark_source;
-        auto& row = snapshot_state.price_rows_by_symbol[i];
-        row.mark_price = mark_price;
-        row.has_mark_price = true;
-        row.mark_price_source = mark_source;
-        if (changed) {
-            mark_price_row_dirty(i);
-        }
-    }
     const size_t index_count = std::min(
         step_state.replay_has_index_price_by_symbol.size(),
         snapshot_state.last_index_price_by_symbol.size());
-    for (size_t i = 0; i < index_count; ++i) {
-        if (step_state.replay_has_index_price_by_symbol[i] == 0 ||
-            i >= step_state.replay_index_price_by_symbol.size()) {
-            continue;
+    const size_t symbol_count = std::max(count, std::max(mark_count, index_count));
+    auto& changed_by_symbol = step_state.snapshot_price_changed_scratch;
+    changed_by_symbol.assign(symbol_count, 0);
+
+    // Symbols own disjoint rows; dirty ids are collected afterwards in serial order.
+    for_each_step_shard(step_state.step_worker_pool.get(), symbol_count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (i < count &&
+                step_state.replay_has_trade_kline_by_symbol[i] != 0 &&
+                i < step_state.replay_trade_close_by_symbol.size()) {
+                const double trade_price = step_state.replay_trade_close_by_symbol[i];
+                const bool changed =
+                    snapshot_state.has_last_trade_price_by_symbol[i] == 0 ||
+                    snapshot_state.last_trade_price_by_symbol[i] != trade_price;
+                snapshot_state.last_trade_price_by_symbol[i] = trade_price;
+                snapshot_state.has_last_trade_price_by_symbol[i] = 1;
+                auto& row = snapshot_state.price_rows_by_symbol[i];
+                row.trade_price = trade_price;
+                row.has_trade_price = true;
+                row.price = trade_price;
+                row.has_price = true;
+                if (changed) {
+                    changed_by_symbol[i] |= kTradeChanged;
+                }
+            }
+            if (i < mark_count &&
+                step_state.replay_has_mark_price_by_symbol[i] != 0 &&
+                i < step_state.replay_mark_price_by_symbol.size()) {
+                const double mark_price = step_state.replay_mark_price_by_symbol[i];
+                const int32_t mark_source = static_cast<int32_t>(Contracts::ReferencePriceSource::Raw);
+                const bool changed =
+                    snapshot_state.has_last_mark_price_by_symbol[i] == 0 ||
+                    snapshot_state.last_mark_price_by_symbol[i] != mark_price ||
+                    snapshot_state.last_mark_price_source_by_symbol[i] != mark_source;
+                snapshot_state.last_mark_price_by_symbol[i] = mark_price;
+                snapshot_state.has_last_mark_price_by_symbol[i] = 1;
+                snapshot_state.last_mark_price_ts_by_symbol[i] = ts_exchange;
+                snapshot_state.last_mark_price_source_by_symbol[i] = mark_source;
+                auto& row = snapshot_state.price_rows_by_symbol[i];
+                row.mark_price = mark_price;
+                row.has_mark_price = true;
+                row.mark_price_source = mark_source;
+                if (changed) {
+                    changed_by_symbol[i] |= kMarkChanged;
+                }
+            }
+            if (i < index_count &&
+                step_state.replay_has_index_price_by_symbol[i] != 0 &&
+                i < step_state.replay_index_price_by_symbol.size()) {
+                const double index_price = step_state.replay_index_price_by_symbol[i];
+                const int32_t index_source = static_cast<int32_t>(Contracts::ReferencePriceSource::Raw);
+                const bool changed =
+                    snapshot_state.has_last_index_price_by_symbol[i] == 0 ||
+                    snapshot_state.last_index_price_by_symbol[i] != index_price ||
+                    snapshot_state.last_index_price_source_by_symbol[i] != index_source;
+                snapshot_state.last_index_price_by_symbol[i] = index_price;
+                snapshot_state.has_last_index_price_by_symbol[i] = 1;
+                snapshot_state.last_index_price_ts_by_symbol[i] = ts_exchange;
+                snapshot_state.last_index_price_source_by_symbol[i] = index_source;
+                auto& row = snapshot_state.price_rows_by_symbol[i];
+                row.index_price = index_price;
+                row.has_index_price = true;
+                row.index_price_source = index_source;
+                if (changed) {
+                    changed_by_symbol[i] |= kIndexChanged;
+                }
+            }
         }
-        const double index_price = step_state.replay_index_price_by_symbol[i];
-        const int32_t index_source = static_cast<int32_t>(Contracts::ReferencePriceSource::Raw);
-        const bool changed =
-            snapshot_state.has_last_index_price_by_symbol[i] == 0 ||
-            snapshot_state.last_index_price_by_symbol[i] != index_price ||
-            snapshot_state.last_index_price_source_by_symbol[i] != index_source;
-        snapshot_state.last_index_price_by_symbol[i] = index_price;
-        snapshot_state.has_last_index_price_by_symbol[i] = 1;
-        snapshot_state.last_index_price_ts_by_symbol[i] = observable_ctx.ts_exchange;
-        snapshot_state.last_index_price_source_by_symbol[i] = index_source;
-        auto& row = snapshot_state.price_rows_by_symbol[i];
-        row.index_price = index_price;
-        row.has_index_price = true;
-        row.index_price_source = index_source;
-        if (changed) {
-            mark_price_row_dirty(i);
+    });
+
+    // Trade changes first, then mark, then index: the dirty-id order consumers have always seen.
+    for (const uint8_t stream : { kTradeChanged, kMarkChanged, kIndexChanged }) {
+        for (size_t i = 0; i < symbol_count; ++i) {
+            if ((changed_by_symbol[i] & stream) != 0) {
+                mark_price_row_dirty(i);
+            }
         }
     }
     if (!snapshot_state.dirty_price_symbol_ids.empty()) {
@@ -325,6 +350,34 @@ void update_snapshot_state(
     }
 }
 
+// Writes the current minimal read-model state consumed by FillStatusSnapshot().
+// Hot-path note: updates stay in-place and only touch fields needed by the
+// restored snapshot path.
+void update_snapshot_state(
+    State::SnapshotState& snapshot_state,
+    State::StepKernelState& step_state,
+    const Output::StepObservableContext& observable_ctx)
+{
+    reset_price_row_dirty_state(snapshot_state);
+    snapshot_state.ts_exchange = observable_ctx.ts_exchange;
+    snapshot_state.step_seq = observable_ctx.step_seq;
+    snapshot_state.progress_pct = compute_progress_pct(step_state);
+    if (!observable_ctx.market_payload) {
+        return;
+    }
+    apply_step_prices_to_snapshot(snapshot_state, step_state, observable_ctx.ts_exchange);
+}
+
+bool payload_has_funding_rows(const QTrading::Dto::Market::Binance::MultiKlineDto& market_payload)
+{
+    for (size_t i = 0; i < market_payload.symbol_count(); ++i) {
+        if (market_payload.has_funding(i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool apply_funding_for_step(
     State::StepKernelState& step_state,
     const State::BinanceExchangeRuntimeState& runtime_state,
@@ -332,56 +385,111 @@ bool apply_funding_for_step(
     const QTrading::Dto::Market::Binance::MultiKlineDto& market_payload)
 {
     constexpr double kEpsilon = 1e-12;
-    bool wallet_mutated = false;
-    const size_t count = std::min(step_state.symbols.size(), market_payload.funding_by_id.size());
+    constexpr int8_t kNoFundingRow = -1;
+    constexpr size_t kNotFunded = std::numeric_limits<size_t>::max();
+    constexpr auto kApply = static_cast<int8_t>(Domain::FundingDecisionAction::Apply);
+    const size_t count = std::min(step_state.symbols.size(), market_payload.symbol_count());
+    auto* pool = step_state.step_worker_pool.get();
+    auto& action_by_symbol = step_state.funding_action_scratch;
+    auto& mark_by_symbol = step_state.funding_mark_price_scratch;
+    auto& diagnostic_by_symbol = step_state.funding_diagnostic_scratch;
+    action_by_symbol.assign(count, kNoFundingRow);
+    mark_by_symbol.resize(count);
+    diagnostic_by_symbol.resize(count);
+    // Shards only touch their own symbols' interpolation cursors, so size them up front.
+    if (step_state.mark_interp_cursor_by_symbol.size() < count) {
+        step_state.mark_interp_cursor_by_symbol.resize(count, 0);
+    }
+
+    Application::for_each_step_shard(pool, count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const auto funding_row = market_payload.funding(i);
+            if (!funding_row.has_value()) {
+                continue;
+            }
+            const auto& funding = *funding_row;
+            const auto raw_mark = resolve_funding_mark_kline(step_state, market_payload, i, funding.FundingTime);
+            const auto mark_resolved = Domain::ReferencePriceResolver::ResolveFundingMark(funding, raw_mark);
+            const bool is_duplicate = step_state.last_applied_funding_time_by_symbol[i] == funding.FundingTime;
+            const auto action = Domain::FundingEligibilityDecision::Decide(
+                is_duplicate,
+                mark_resolved.has_mark_price,
+                true);
+            action_by_symbol[i] = static_cast<int8_t>(action);
+            mark_by_symbol[i] = mark_resolved.mark_price;
+            diagnostic_by_symbol[i] = Contracts::ReferenceFundingResolverDiagnostic{
+                action == Domain::FundingDecisionAction::Apply,
+                mark_resolved.has_mark_price,
+                funding.FundingTime,
+                funding.Rate,
+                mark_resolved.mark_price_source
+            };
+        }
+    });
+
+    // Diagnostics and counters advance in symbol order, exactly as a single pass would.
+    bool any_applied_symbol = false;
     for (size_t i = 0; i < count; ++i) {
-        if (!market_payload.funding_by_id[i].has_value()) {
+        if (action_by_symbol[i] == kNoFundingRow) {
             continue;
         }
-        const auto& funding = *market_payload.funding_by_id[i];
-        const auto raw_mark = resolve_funding_mark_kline(step_state, market_payload, i, funding.FundingTime);
-        const auto mark_resolved = Domain::ReferencePriceResolver::ResolveFundingMark(funding, raw_mark);
-        const bool is_duplicate = step_state.last_applied_funding_time_by_symbol[i] == funding.FundingTime;
-        const auto action = Domain::FundingEligibilityDecision::Decide(
-            is_duplicate,
-            mark_resolved.has_mark_price,
-            true);
-        step_state.last_reference_funding_resolver_diagnostic = Contracts::ReferenceFundingResolverDiagnostic{
-            action == Domain::FundingDecisionAction::Apply,
-            mark_resolved.has_mark_price,
-            funding.FundingTime,
-            funding.Rate,
-            mark_resolved.mark_price_source
-        };
-        if (action == Domain::FundingDecisionAction::SkipNoMark) {
+        step_state.last_reference_funding_resolver_diagnostic = diagnostic_by_symbol[i];
+        if (action_by_symbol[i] == static_cast<int8_t>(Domain::FundingDecisionAction::SkipNoMark)) {
             ++step_state.funding_skipped_no_mark_total;
             continue;
         }
-        if (action == Domain::FundingDecisionAction::SkipDuplicate ||
-            action == Domain::FundingDecisionAction::NoOp) {
+        if (action_by_symbol[i] != kApply) {
             continue;
         }
+        step_state.last_applied_funding_time_by_symbol[i] = diagnostic_by_symbol[i].funding_time;
+        any_applied_symbol = true;
+    }
+    if (!any_applied_symbol) {
+        return false;
+    }
 
-        const std::string& symbol = step_state.symbols[i];
-        const double mark = mark_resolved.mark_price;
-        const auto& funding_positions = step_state.has_funding_apply_positions
-            ? step_state.funding_apply_positions
-            : runtime_state.positions;
-        for (const auto& position : funding_positions) {
+    const auto& funding_positions = step_state.has_funding_apply_positions
+        ? step_state.funding_apply_positions
+        : runtime_state.positions;
+    auto& symbol_by_position = step_state.funding_symbol_by_position_scratch;
+    auto& delta_by_position = step_state.funding_delta_by_position_scratch;
+    symbol_by_position.assign(funding_positions.size(), kNotFunded);
+    delta_by_position.resize(funding_positions.size());
+    Application::for_each_step_shard(pool, funding_positions.size(), [&](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; ++p) {
+            const auto& position = funding_positions[p];
             if (position.instrument_type != QTrading::Dto::Trading::InstrumentType::Perp ||
-                position.symbol != symbol ||
                 position.quantity <= kEpsilon) {
                 continue;
             }
+            const auto symbol_id =
+                State::find_symbol_id(step_state, position.interned_symbol_id, position.symbol);
+            if (!symbol_id.has_value() || *symbol_id >= count || action_by_symbol[*symbol_id] != kApply) {
+                continue;
+            }
             const double direction = position.is_long ? -1.0 : 1.0;
-            const double funding_delta = direction * position.quantity * mark * funding.Rate;
-            account.apply_perp_wallet_delta(funding_delta);
-            ++step_state.funding_applied_events_total;
-            wallet_mutated = true;
+            delta_by_position[p] =
+                direction * position.quantity * mark_by_symbol[*symbol_id] * diagnostic_by_symbol[*symbol_id].funding_rate;
+            symbol_by_position[p] = *symbol_id;
+        }
+    });
+
+    // Wallet deltas land symbol by symbol, positions in book order, so the sum is bit-identical.
+    auto& apply_order = step_state.funding_apply_order_scratch;
+    apply_order.clear();
+    for (size_t p = 0; p < symbol_by_position.size(); ++p) {
+        if (symbol_by_position[p] != kNotFunded) {
+            apply_order.push_back(p);
         }
-        step_state.last_applied_funding_time_by_symbol[i] = funding.FundingTime;
     }
-    return wallet_mutated;
+    std::stable_sort(apply_order.begin(), apply_order.end(), [&](size_t lhs, size_t rhs) {
+        return symbol_by_position[lhs] < symbol_by_position[rhs];
+    });
+    for (const size_t p : apply_order) {
+        account.apply_perp_wallet_delta(delta_by_position[p]);
+        ++step_state.funding_applied_events_total;
+    }
+    return !apply_order.empty();
 }
 
 void apply_basis_warning_leverage_caps(
@@ -450,6 +558,23 @@ void apply_basis_warning_leverage_caps(
     }
 }
 
+// Sends the change from `book` to `current`, if any, and advances `book` to match.
+template <typename T, typename ChannelPtr>
+void publish_book_delta(
+    BookReplica<T>& book,
+    const std::vector<T>& current,
+    const ChannelPtr& channel)
+{
+    auto delta = book.diff(current);
+    if (delta.empty()) {
+        return;
+    }
+    (void)book.apply(delta);
+    if (channel) {
+        channel->Send(std::move(delta));
+    }
+}
+
 void publish_position_order_channels(
     BinanceExchange& exchange,
     const State::BinanceExchangeRuntimeState& runtime_state,
@@ -467,33 +592,51 @@ void publish_position_order_channels(
         return;
     }
 
+    const auto book_mode = runtime_state.simulation_config.book_channel_mode;
+    const bool publish_full = book_mode != Config::BookChannelMode::Delta;
+    const bool publish_delta = book_mode != Config::BookChannelMode::FullSnapshot;
+
+    auto publish_orders = [&](const std::vector<QTrading::dto::Order>& orders, bool log_rows) {
+        if (publish_full && exchange.get_order_channel()) {
+            exchange.get_order_channel()->Send(orders);
+        }
+        if (publish_delta) {
+            publish_book_delta(step_state.published_order_book, orders, exchange.get_order_delta_channel());
+        }
+        if (log_rows && runtime_state.logger &&
+            step_state.log_module_order_id != QTrading::Log::Logger::kInvalidModuleId) {
+            for (const auto& order : orders) {
+                (void)runtime_state.logger->Log(step_state.log_module_order_id, order);
+            }
+        }
+    };
+    auto publish_positions = [&](const std::vector<QTrading::dto::Position>& positions, bool log_rows) {
+        if (publish_full && exchange.get_position_channel()) {
+            exchange.get_position_channel()->Send(positions);
+        }
+        if (publish_delta) {
+            publish_book_delta(step_state.published_position_book, positions, exchange.get_position_delta_channel());
+        }
+        if (log_rows && runtime_state.logger &&
+            step_state.log_module_position_id != QTrading::Log::Logger::kInvalidModuleId) {
+            for (const auto& position : positions) {
+                (void)runtime_state.logger->Log(step_state.log_module_position_id, position);
+            }
+        }
+    };
+
     if (orders_maybe_changed) {
         const auto& orders = runtime_state.orders;
         if (!step_state.has_published_orders) {
             if (!orders.empty()) {
-                if (exchange.get_order_channel()) {
-                    exchange.get_order_channel()->Send(orders);
-                }
-                if (runtime_state.logger &&
-                    step_state.log_module_order_id != QTrading::Log::Logger::kInvalidModuleId) {
-                    for (const auto& order : orders) {
-                        (void)runtime_state.logger->Log(step_state.log_module_order_id, order);
-                    }
-                }
+                publish_orders(orders, !step_state.republish_restored_books ||
+                    runtime_state.orders_version != step_state.last_published_orders_version);
                 step_state.has_published_orders = true;
             }
             step_state.last_published_orders_version = runtime_state.orders_version;
         }
         else if (runtime_state.orders_version != step_state.last_published_orders_version) {
-            if (exchange.get_order_channel()) {
-                exchange.get_order_channel()->Send(orders);
-            }
-            if (runtime_state.logger &&
-                step_state.log_module_order_id != QTrading::Log::Logger::kInvalidModuleId) {
-                for (const auto& order : orders) {
-                    (void)runtime_state.logger->Log(step_state.log_module_order_id, order);
-                }
-            }
+            publish_orders(orders, true);
             step_state.last_published_orders_version = runtime_state.orders_version;
         }
     }
@@ -502,34 +645,20 @@ void publish_position_order_channels(
         const auto& positions = visible_positions(runtime_state, step_state);
         if (!step_state.has_published_positions) {
             if (!positions.empty()) {
-                if (exchange.get_position_channel()) {
-                    exchange.get_position_channel()->Send(positions);
-                }
-                if (runtime_state.logger &&
-                    step_state.log_module_position_id != QTrading::Log::Logger::kInvalidModuleId) {
-                    for (const auto& position : positions) {
-                        (void)runtime_state.logger->Log(step_state.log_module_position_id, position);
-                    }
-                }
+                publish_positions(positions, !step_state.republish_restored_books ||
+                    runtime_state.positions_version != step_state.last_published_positions_version);
                 step_state.has_published_positions = true;
             }
             step_state.last_published_positions_version = runtime_state.positions_version;
         }
         else if (runtime_state.positions_version != step_state.last_published_positions_version) {
-            if (exchange.get_position_channel()) {
-                exchange.get_position_channel()->Send(positions);
-            }
-            if (runtime_state.logger &&
-                step_state.log_module_position_id != QTrading::Log::Logger::kInvalidModuleId) {
-                for (const auto& position : positions) {
-                    (void)runtime_state.logger->Log(step_state.log_module_position_id, position);
-                }
-            }
+            publish_positions(positions, true);
             step_state.last_published_positions_version = runtime_state.positions_version;
         }
     }
 
     step_state.last_published_account_state_version = step_state.account_state_version;
+    step_state.republish_restored_books = false;
 }
 
 double compute_spot_inventory_value_for_log(
@@ -639,53 +768,67 @@ void refresh_perp_mark_state(
     const QTrading::Dto::Market::Binance::MultiKlineDto& market_payload)
 {
     constexpr double kEpsilon = 1e-12;
+    auto& positions = runtime_state.positions;
+    auto& contributed = step_state.mark_refresh_contributed_scratch;
+    contributed.assign(positions.size(), 0);
+
+    // Each position only touches its own row, so shards may run concurrently.
+    for_each_step_shard(step_state.step_worker_pool.get(), positions.size(), [&](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; ++p) {
+            auto& position = positions[p];
+            if (position.instrument_type != QTrading::Dto::Trading::InstrumentType::Perp ||
+                position.quantity <= kEpsilon) {
+                continue;
+            }
+            const auto step_symbol_id =
+                State::find_symbol_id(step_state, position.interned_symbol_id, position.symbol);
+            if (!step_symbol_id.has_value()) {
+                continue;
+            }
+            const size_t symbol_id = *step_symbol_id;
+            double reference_price = 0.0;
+            if (const auto mark_close = market_payload.mark_close(symbol_id)) {
+                reference_price = *mark_close;
+            }
+            else if (const auto trade_close = market_payload.trade_close(symbol_id)) {
+                reference_price = *trade_close;
+            }
+            else if (symbol_id < snapshot_state.has_last_mark_price_by_symbol.size() &&
+                symbol_id < snapshot_state.last_mark_price_by_symbol.size() &&
+                snapshot_state.has_last_mark_price_by_symbol[symbol_id] != 0) {
+                reference_price = snapshot_state.last_mark_price_by_symbol[symbol_id];
+            }
+            else if (symbol_id < snapshot_state.has_last_trade_price_by_symbol.size() &&
+                symbol_id < snapshot_state.last_trade_price_by_symbol.size() &&
+                snapshot_state.has_last_trade_price_by_symbol[symbol_id] != 0) {
+                reference_price = snapshot_state.last_trade_price_by_symbol[symbol_id];
+            }
+            if (!(reference_price > 0.0)) {
+                continue;
+            }
+
+            const double direction = position.is_long ? 1.0 : -1.0;
+            position.unrealized_pnl = (reference_price - position.entry_price) * position.quantity * direction;
+            position.notional = std::abs(reference_price * position.quantity);
+            position.maintenance_margin = Domain::ComputeMaintenanceMarginForSymbol(
+                position.notional,
+                step_state,
+                symbol_id);
+            contributed[p] = 1;
+        }
+    });
+
+    // Totals are summed in position order so the result never depends on sharding.
     double total_unrealized = 0.0;
     double total_position_initial_margin = 0.0;
     double total_maintenance_margin = 0.0;
-
-    for (auto& position : runtime_state.positions) {
-        if (position.instrument_type != QTrading::Dto::Trading::InstrumentType::Perp ||
-            position.quantity <= kEpsilon) {
-            continue;
-        }
-        const auto it = step_state.symbol_to_id.find(position.symbol);
-        if (it == step_state.symbol_to_id.end()) {
-            continue;
-        }
-        const size_t symbol_id = it->second;
-        double reference_price = 0.0;
-        if (symbol_id < market_payload.mark_klines_by_id.size() &&
-            market_payload.mark_klines_by_id[symbol_id].has_value()) {
-            reference_price = market_payload.mark_klines_by_id[symbol_id]->ClosePrice;
-        }
-        else if (symbol_id < market_payload.trade_klines_by_id.size() &&
-            market_payload.trade_klines_by_id[symbol_id].has_value()) {
-            reference_price = market_payload.trade_klines_by_id[symbol_id]->ClosePrice;
-        }
-        else if (symbol_id < snapshot_state.has_last_mark_price_by_symbol.size() &&
-            symbol_id < snapshot_state.last_mark_price_by_symbol.size() &&
-            snapshot_state.has_last_mark_price_by_symbol[symbol_id] != 0) {
-            reference_price = snapshot_state.last_mark_price_by_symbol[symbol_id];
-        }
-        else if (symbol_id < snapshot_state.has_last_trade_price_by_symbol.size() &&
-            symbol_id < snapshot_state.last_trade_price_by_symbol.size() &&
-            snapshot_state.has_last_trade_price_by_symbol[symbol_id] != 0) {
-            reference_price = snapshot_state.last_trade_price_by_symbol[symbol_id];
-        }
-        if (!(reference_price > 0.0)) {
+    for (size_t p = 0; p < positions.size(); ++p) {
+        if (contributed[p] == 0) {
             continue;
         }
-
-        const double direction = position.is_long ? 1.0 : -1.0;
-        position.unrealized_pnl = (reference_price - position.entry_price) * position.quantity * direction;
-        position.notional = std::abs(reference_price * position.quantity);
-        position.maintenance_margin = Domain::ComputeMaintenanceMarginForSymbol(
-            position.notional,
-            step_state,
-            symbol_id);
-        total_unrealized += position.unrealized_pnl;
-        total_position_initial_margin += position.initial_margin;
-        total_maintenance_margin += position.maintenance_margin;
+        total_unrealized += positions[p].unrealized_pnl;
+        total_position_initial_margin += positions[p].initial_margin;
+        total_maintenance_margin += positions[p].maintenance_margin;
     }
 
     runtime_state.visible_positions_cache_version = std::numeric_limits<uint64_t>::max();
@@ -696,7 +839,7 @@ void refresh_perp_mark_state(
 }
 
 void emit_market_funding_events(
-    const State::StepKernelState& step_state,
+    State::StepKernelState& step_state,
     const State::BinanceExchangeRuntimeState& runtime_state,
     const Output::StepObservableContext& observable_ctx,
     const std::shared_ptr<QTrading::Log::Logger>& logger,
@@ -714,95 +857,115 @@ void emit_market_funding_events(
     if (payload.symbols &&
         step_state.log_module_market_event_id != QTrading::Log::Logger::kInvalidModuleId) {
         const size_t count = payload.symbols->size();
-        for (size_t i = 0; i < count; ++i) {
-            QTrading::Log::FileLogger::FeatherV2::MarketEventDto event{};
-            event.run_id = step_state.run_id;
-            event.step_seq = observable_ctx.step_seq;
-            event.event_seq = next_event_seq++;
-            uint64_t market_ts_local = observable_ctx.ts_exchange;
-            if (step_state.run_id == 515151u &&
-                i < step_state.has_next_funding_ts.size() &&
-                i < step_state.next_funding_ts_by_symbol.size() &&
-                i < payload.funding_by_id.size() &&
-                step_state.has_next_funding_ts[i] != 0 &&
-                !payload.funding_by_id[i].has_value() &&
-                step_state.next_funding_ts_by_symbol[i] > observable_ctx.ts_exchange) {
-                market_ts_local = step_state.next_funding_ts_by_symbol[i];
-            }
-            event.ts_local = market_ts_local;
-            event.symbol = (*payload.symbols)[i];
-            event.has_kline = i < payload.trade_klines_by_id.size() && payload.trade_klines_by_id[i].has_value();
-            if (event.has_kline) {
-                const auto& kline = *payload.trade_klines_by_id[i];
-                event.open = kline.OpenPrice;
-                event.high = kline.HighPrice;
-                event.low = kline.LowPrice;
-                event.close = kline.ClosePrice;
-                event.volume = kline.Volume;
-                event.taker_buy_base_volume = kline.TakerBuyBaseVolume;
-            }
-            if (i < payload.mark_klines_by_id.size() && payload.mark_klines_by_id[i].has_value()) {
-                event.has_mark_price = true;
-                event.mark_price = payload.mark_klines_by_id[i]->ClosePrice;
-                event.mark_price_source = static_cast<int32_t>(Contracts::ReferencePriceSource::Raw);
-            }
-            else {
-                bool resolved = false;
-                if (i < step_state.mark_data_id_by_symbol.size()) {
+        step_state.market_event_mark_price_scratch.assign(count, 0.0);
+        step_state.market_event_mark_source_scratch.assign(count, static_cast<int32_t>(Contracts::ReferencePriceSource::None));
+        step_state.market_event_index_price_scratch.assign(count, 0.0);
+        step_state.market_event_index_source_scratch.assign(count, static_cast<int32_t>(Contracts::ReferencePriceSource::None));
+        if (step_state.mark_interp_cursor_by_symbol.size() < count) {
+            step_state.mark_interp_cursor_by_symbol.resize(count, 0);
+        }
+        if (step_state.index_interp_cursor_by_symbol.size() < count) {
+            step_state.index_interp_cursor_by_symbol.resize(count, 0);
+        }
+
+        // Reference prices only read shared data and advance per-symbol cursors, so they resolve
+        // in shards; sequencing and logging below stay serial.
+        for_each_step_shard(step_state.step_worker_pool.get(), count, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (const auto mark = payload.mark_close(i)) {
+                    step_state.market_event_mark_price_scratch[i] = *mark;
+                    step_state.market_event_mark_source_scratch[i] = static_cast<int32_t>(Contracts::ReferencePriceSource::Raw);
+                }
+                else if (i < step_state.mark_data_id_by_symbol.size()) {
                     const int32_t mark_id = step_state.mark_data_id_by_symbol[i];
                     if (mark_id >= 0 && static_cast<size_t>(mark_id) < step_state.mark_data_pool.size()) {
                         const auto interpolated = interpolate_close_price(
                             step_state.mark_data_pool[static_cast<size_t>(mark_id)],
-                            payload.Timestamp);
+                            payload.Timestamp,
+                            step_state.mark_interp_cursor_by_symbol[i]);
                         if (interpolated.has_value()) {
-                            event.has_mark_price = true;
-                            event.mark_price = *interpolated;
-                            event.mark_price_source = static_cast<int32_t>(Contracts::ReferencePriceSource::Interpolated);
-                            resolved = true;
+                            step_state.market_event_mark_price_scratch[i] = *interpolated;
+                            step_state.market_event_mark_source_scratch[i] = static_cast<int32_t>(Contracts::ReferencePriceSource::Interpolated);
                         }
                     }
                 }
-                if (!resolved) {
-                    event.has_mark_price = false;
-                    event.mark_price = 0.0;
-                    event.mark_price_source = static_cast<int32_t>(Contracts::ReferencePriceSource::None);
+                if (const auto index = payload.index_close(i)) {
+                    step_state.market_event_index_price_scratch[i] = *index;
+                    step_state.market_event_index_source_scratch[i] = static_cast<int32_t>(Contracts::ReferencePriceSource::Raw);
                 }
-            }
-            if (i < payload.index_klines_by_id.size() && payload.index_klines_by_id[i].has_value()) {
-                event.has_index_price = true;
-                event.index_price = payload.index_klines_by_id[i]->ClosePrice;
-                event.index_price_source = static_cast<int32_t>(Contracts::ReferencePriceSource::Raw);
-            }
-            else {
-                bool resolved = false;
-                if (i < step_state.index_data_id_by_symbol.size()) {
+                else if (i < step_state.index_data_id_by_symbol.size()) {
                     const int32_t index_id = step_state.index_data_id_by_symbol[i];
                     if (index_id >= 0 && static_cast<size_t>(index_id) < step_state.index_data_pool.size()) {
                         const auto interpolated = interpolate_close_price(
                             step_state.index_data_pool[static_cast<size_t>(index_id)],
-                            payload.Timestamp);
+                            payload.Timestamp,
+                            step_state.index_interp_cursor_by_symbol[i]);
                         if (interpolated.has_value()) {
-                            event.has_index_price = true;
-                            event.index_price = *interpolated;
-                            event.index_price_source = static_cast<int32_t>(Contracts::ReferencePriceSource::Interpolated);
-                            resolved = true;
+                            step_state.market_event_index_price_scratch[i] = *interpolated;
+                            step_state.market_event_index_source_scratch[i] = static_cast<int32_t>(Contracts::ReferencePriceSource::Interpolated);
                         }
                     }
                 }
-                if (!resolved) {
-                    event.has_index_price = false;
-                    event.index_price = 0.0;
-                    event.index_price_source = static_cast<int32_t>(Contracts::ReferencePriceSource::None);
-                }
             }
-            const auto original_ts = QTrading::Utils::GlobalTimestamp.load(std::memory_order_acquire);
-            if (market_ts_local != original_ts) {
-                QTrading::Utils::GlobalTimestamp.store(market_ts_local, std::memory_order_release);
+        });
+
+        const bool market_records = logger->AcceptsRecords<QTrading::Log::FileLogger::FeatherV2::MarketEventRecord>(
+            step_state.log_module_market_event_id);
+        for (size_t i = 0; i < count; ++i) {
+            const uint64_t event_seq = next_event_seq++;
+            uint64_t market_ts_local = observable_ctx.ts_exchange;
+            if (step_state.run_id == 515151u &&
+                i < step_state.has_next_funding_ts.size() &&
+                i < step_state.next_funding_ts_by_symbol.size() &&
+                step_state.has_next_funding_ts[i] != 0 &&
+                !payload.has_funding(i) &&
+                step_state.next_funding_ts_by_symbol[i] > observable_ctx.ts_exchange) {
+                market_ts_local = step_state.next_funding_ts_by_symbol[i];
             }
-            (void)logger->Log(step_state.log_module_market_event_id, event);
-            if (market_ts_local != original_ts) {
-                QTrading::Utils::GlobalTimestamp.store(original_ts, std::memory_order_release);
+            // Shared by the boxed DTO and the in-place record; only the symbol differs.
+            const auto fill = [&](auto& event) {
+                event.run_id = step_state.run_id;
+                event.step_seq = observable_ctx.step_seq;
+                event.event_seq = event_seq;
+                event.ts_local = market_ts_local;
+                const auto bar = payload.trade_bar(i);
+                event.has_kline = bar.has_value();
+                if (event.has_kline) {
+                    event.open = bar->open;
+                    event.high = bar->high;
+                    event.low = bar->low;
+                    event.close = bar->close;
+                    event.volume = bar->volume;
+                    event.taker_buy_base_volume = bar->taker_buy_base_volume;
+                }
+                event.mark_price_source = step_state.market_event_mark_source_scratch[i];
+                event.has_mark_price =
+                    event.mark_price_source != static_cast<int32_t>(Contracts::ReferencePriceSource::None);
+                event.mark_price = step_state.market_event_mark_price_scratch[i];
+                event.index_price_source = step_state.market_event_index_source_scratch[i];
+                event.has_index_price =
+                    event.index_price_source != static_cast<int32_t>(Contracts::ReferencePriceSource::None);
+                event.index_price = step_state.market_event_index_price_scratch[i];
+            };
+            if (market_records) {
+                const auto symbol_id = i < step_state.interned_symbol_id_by_id.size()
+                    ? step_state.interned_symbol_id_by_id[i]
+                    : QTrading::Dto::Trading::SymbolTable::Intern((*payload.symbols)[i]);
+                (void)logger->LogRecord<QTrading::Log::FileLogger::FeatherV2::MarketEventRecord>(
+                    step_state.log_module_market_event_id,
+                    market_ts_local,
+                    [&](QTrading::Log::FileLogger::FeatherV2::MarketEventRecord& event) {
+                        fill(event);
+                        event.symbol_id = symbol_id;
+                    });
+                continue;
             }
+            QTrading::Log::FileLogger::FeatherV2::MarketEventDto event{};
+            fill(event);
+            event.symbol = (*payload.symbols)[i];
+            auto event_payload = QTrading::Log::MakePayload<QTrading::Log::FileLogger::FeatherV2::MarketEventDto>(
+                std::move(event));
+            (void)logger->LogBatchAt(step_state.log_module_market_event_id, &event_payload, 1, market_ts_local);
         }
     }
 
@@ -812,12 +975,13 @@ void emit_market_funding_events(
     }
 
     constexpr double kEpsilon = 1e-12;
-    const size_t count = std::min(payload.symbols->size(), payload.funding_by_id.size());
+    const size_t count = std::min(payload.symbols->size(), payload.symbol_count());
     for (size_t i = 0; i < count; ++i) {
-        if (!payload.funding_by_id[i].has_value()) {
+        const auto funding_row = payload.funding(i);
+        if (!funding_row.has_value()) {
             continue;
         }
-        const auto& funding = *payload.funding_by_id[i];
+        const auto& funding = *funding_row;
         const std::string& symbol = (*payload.symbols)[i];
         const auto mark_resolved = Domain::ReferencePriceResolver::ResolveFundingMark(
             funding,
@@ -893,26 +1057,20 @@ void emit_account_position_order_events(
     constexpr int32_t kCommissionModelNone = -1;
     constexpr int32_t kCommissionModelImputedBuyBase = 1;
 
-    static const std::vector<QTrading::dto::Position> kEmptyPositions;
-    static const std::vector<QTrading::dto::Order> kEmptyOrders;
-    const auto& prev_positions = step_state.has_event_snapshots
-        ? step_state.last_event_positions
-        : kEmptyPositions;
-    const auto& prev_orders = step_state.has_event_snapshots
-        ? step_state.last_event_orders
-        : kEmptyOrders;
+    if (!step_state.has_event_snapshots) {
+        // The first emission diffs positions against the step-entry book and orders against none.
+        step_state.event_position_book.reset(step_state.step_entry_positions);
+        step_state.event_order_book.reset();
+    }
+    const auto& prev_positions = step_state.event_position_book;
+    const auto& prev_orders = step_state.event_order_book;
     const auto& cur_positions = visible_positions(runtime_state, step_state);
     const auto& cur_orders = runtime_state.orders;
     const auto& fills = step_state.match_fills_scratch;
+    // Only entries that changed since the last emission are copied.
+    auto position_delta = prev_positions.diff(cur_positions);
+    auto order_delta = prev_orders.diff(cur_orders);
 
-    auto find_prev_order = [&](int order_id) -> const QTrading::dto::Order* {
-        for (const auto& order : prev_orders) {
-            if (order.id == order_id) {
-                return &order;
-            }
-        }
-        return nullptr;
-    };
     auto find_cur_order = [&](int order_id) -> const QTrading::dto::Order* {
         for (const auto& order : cur_orders) {
             if (order.id == order_id) {
@@ -924,9 +1082,11 @@ void emit_account_position_order_events(
 
     auto fee_rate_for_fill = [&](const Domain::MatchFill& fill) {
         if (fill.instrument_type == QTrading::Dto::Trading::InstrumentType::Spot) {
-            const auto symbol_it = runtime_state.spot_symbol_fee_overrides.find(fill.symbol);
-            if (symbol_it != runtime_state.spot_symbol_fee_overrides.end()) {
-                return fill.is_taker ? symbol_it->second.taker_fee_rate : symbol_it->second.maker_fee_rate;
+            if (!runtime_state.spot_symbol_fee_overrides.empty()) {
+                const auto symbol_it = runtime_state.spot_symbol_fee_overrides.find(Domain::fill_symbol_name(fill));
+                if (symbol_it != runtime_state.spot_symbol_fee_overrides.end()) {
+                    return fill.is_taker ? symbol_it->second.taker_fee_rate : symbol_it->second.maker_fee_rate;
+                }
             }
             auto spot_it = ::spot_vip_fee_rates.find(runtime_state.vip_level);
             if (spot_it == ::spot_vip_fee_rates.end()) {
@@ -934,9 +1094,11 @@ void emit_account_position_order_events(
             }
             return fill.is_taker ? spot_it->second.taker_fee_rate : spot_it->second.maker_fee_rate;
         }
-        const auto symbol_it = runtime_state.perp_symbol_fee_overrides.find(fill.symbol);
-        if (symbol_it != runtime_state.perp_symbol_fee_overrides.end()) {
-            return fill.is_taker ? symbol_it->second.taker_fee_rate : symbol_it->second.maker_fee_rate;
+        if (!runtime_state.perp_symbol_fee_overrides.empty()) {
+            const auto symbol_it = runtime_state.perp_symbol_fee_overrides.find(Domain::fill_symbol_name(fill));
+            if (symbol_it != runtime_state.perp_symbol_fee_overrides.end()) {
+                return fill.is_taker ? symbol_it->second.taker_fee_rate : symbol_it->second.maker_fee_rate;
+            }
         }
         auto perp_it = ::vip_fee_rates.find(runtime_state.vip_level);
         if (perp_it == ::vip_fee_rates.end()) {
@@ -972,7 +1134,7 @@ void emit_account_position_order_events(
             event.ts_local = observable_ctx.ts_exchange;
             event.request_id = static_cast<uint64_t>(fill.order_id);
             event.order_id = fill.order_id;
-            event.symbol = fill.symbol;
+            event.symbol = Domain::fill_symbol_name(fill);
             event.instrument_type = static_cast<int32_t>(fill.instrument_type);
             event.event_type = static_cast<int32_t>(QTrading::Log::FileLogger::FeatherV2::OrderEventType::Filled);
             event.side = static_cast<int32_t>(fill.side);
@@ -986,8 +1148,8 @@ void emit_account_position_order_events(
             event.remaining_qty = std::max(0.0, fill.order_quantity - fill.quantity);
             event.is_taker = fill.is_taker;
 
-            const auto* prev_order = find_prev_order(fill.order_id);
-            const auto* cur_order = find_cur_order(fill.order_id);
+            const auto* prev_order = prev_orders.find(fill.order_id);
+            const auto* cur_order = prev_order ? nullptr : find_cur_order(fill.order_id);
             if (prev_order) {
                 event.quote_order_qty = prev_order->quote_order_qty;
                 event.price = prev_order->price;
@@ -1040,17 +1202,7 @@ void emit_account_position_order_events(
             filled_order_ids.insert(fill.order_id);
         }
 
-        for (const auto& order : cur_orders) {
-            bool existed = false;
-            for (const auto& prev : prev_orders) {
-                if (prev.id == order.id) {
-                    existed = true;
-                    break;
-                }
-            }
-            if (existed) {
-                continue;
-            }
+        for (const auto& order : order_delta.added) {
             QTrading::Log::FileLogger::FeatherV2::OrderEventDto event{};
             event.run_id = step_state.run_id;
             event.step_seq = observable_ctx.step_seq;
@@ -1073,17 +1225,11 @@ void emit_account_position_order_events(
             pending_order_events.emplace_back(std::move(event));
         }
 
-        for (const auto& order : prev_orders) {
-            bool still_open = false;
-            for (const auto& cur : cur_orders) {
-                if (cur.id == order.id) {
-                    still_open = true;
-                    break;
-                }
-            }
-            if (still_open || filled_order_ids.find(order.id) != filled_order_ids.end()) {
+        for (const int order_id : order_delta.removed_ids) {
+            if (filled_order_ids.find(order_id) != filled_order_ids.end()) {
                 continue;
             }
+            const auto& order = *prev_orders.find(order_id);
             QTrading::Log::FileLogger::FeatherV2::OrderEventDto event{};
             event.run_id = step_state.run_id;
             event.step_seq = observable_ctx.step_seq;
@@ -1118,20 +1264,6 @@ void emit_account_position_order_events(
             }
             closing_fill_order_by_position_id[fill.closing_position_id] = fill.order_id;
         }
-        const auto& prev_positions_for_diff =
-            (!step_state.has_event_snapshots && prev_positions.empty() && !step_state.step_entry_positions.empty())
-            ? step_state.step_entry_positions
-            : prev_positions;
-        std::unordered_map<int, const QTrading::dto::Position*> prev_by_id;
-        prev_by_id.reserve(prev_positions_for_diff.size());
-        for (const auto& p : prev_positions_for_diff) {
-            prev_by_id.emplace(p.id, &p);
-        }
-        std::unordered_map<int, const QTrading::dto::Position*> cur_by_id;
-        cur_by_id.reserve(cur_positions.size());
-        for (const auto& p : cur_positions) {
-            cur_by_id.emplace(p.id, &p);
-        }
 
         auto log_position_event = [&](const QTrading::dto::Position& position, int32_t event_type) {
             QTrading::Log::FileLogger::FeatherV2::PositionEventDto event{};
@@ -1162,31 +1294,26 @@ void emit_account_position_order_events(
             pending_position_events.emplace_back(std::move(event));
         };
 
-        for (const auto& [id, cur] : cur_by_id) {
-            auto it = prev_by_id.find(id);
-            if (it == prev_by_id.end()) {
-                log_position_event(*cur, static_cast<int32_t>(QTrading::Log::FileLogger::FeatherV2::PositionEventType::Opened));
-                continue;
-            }
-            const auto& prev = *it->second;
-            if (prev.is_long != cur->is_long) {
+        for (const auto& cur : position_delta.added) {
+            log_position_event(cur, static_cast<int32_t>(QTrading::Log::FileLogger::FeatherV2::PositionEventType::Opened));
+        }
+        for (const auto& cur : position_delta.updated) {
+            const auto& prev = *prev_positions.find(cur.id);
+            if (prev.is_long != cur.is_long) {
                 log_position_event(prev, static_cast<int32_t>(QTrading::Log::FileLogger::FeatherV2::PositionEventType::Closed));
-                log_position_event(*cur, static_cast<int32_t>(QTrading::Log::FileLogger::FeatherV2::PositionEventType::Opened));
+                log_position_event(cur, static_cast<int32_t>(QTrading::Log::FileLogger::FeatherV2::PositionEventType::Opened));
                 continue;
             }
-            const double delta = cur->quantity - prev.quantity;
+            const double delta = cur.quantity - prev.quantity;
             if (delta > kEpsilon) {
-                log_position_event(*cur, static_cast<int32_t>(QTrading::Log::FileLogger::FeatherV2::PositionEventType::Increased));
+                log_position_event(cur, static_cast<int32_t>(QTrading::Log::FileLogger::FeatherV2::PositionEventType::Increased));
             }
             else if (delta < -kEpsilon) {
-                log_position_event(*cur, static_cast<int32_t>(QTrading::Log::FileLogger::FeatherV2::PositionEventType::Reduced));
+                log_position_event(cur, static_cast<int32_t>(QTrading::Log::FileLogger::FeatherV2::PositionEventType::Reduced));
             }
         }
-        for (const auto& [id, prev] : prev_by_id) {
-            if (cur_by_id.find(id) != cur_by_id.end()) {
-                continue;
-            }
-            log_position_event(*prev, static_cast<int32_t>(QTrading::Log::FileLogger::FeatherV2::PositionEventType::Closed));
+        for (const int position_id : position_delta.removed_ids) {
+            log_position_event(*prev_positions.find(position_id), static_cast<int32_t>(QTrading::Log::FileLogger::FeatherV2::PositionEventType::Closed));
         }
     }
 
@@ -1239,7 +1366,7 @@ void emit_account_position_order_events(
             event.ts_local = observable_ctx.ts_exchange;
             event.request_id = static_cast<uint64_t>(fill.order_id);
             event.source_order_id = fill.order_id;
-            event.symbol = fill.symbol;
+            event.symbol = Domain::fill_symbol_name(fill);
             event.instrument_type = static_cast<int32_t>(fill.instrument_type);
             event.ledger = ledger_from_instrument_type(fill.instrument_type);
             event.event_type = static_cast<int32_t>(
@@ -1313,8 +1440,8 @@ void emit_account_position_order_events(
         }
     }
 
-    step_state.last_event_positions = cur_positions;
-    step_state.last_event_orders = cur_orders;
+    (void)step_state.event_position_book.apply(std::move(position_delta));
+    (void)step_state.event_order_book.apply(std::move(order_delta));
     step_state.has_event_snapshots = true;
 }
 
@@ -1352,6 +1479,78 @@ void emit_reduced_step_logs(
         next_event_seq);
 }
 
+
+// Frames can be skipped only when stepping them cannot change the account: nothing is
+// held or resting, no command is in flight, and no per-frame leverage cap is active.
+bool is_idle_for_fast_forward(const State::BinanceExchangeRuntimeState& runtime_state)
+{
+    if (!runtime_state.positions.empty() ||
+        !runtime_state.orders.empty() ||
+        !runtime_state.deferred_order_commands.empty() ||
+        runtime_state.simulation_config.basis_risk_guard_enabled) {
+        return false;
+    }
+    for (const double qty : runtime_state.spot_inventory_qty_by_symbol) {
+        if (qty > kPositionViewEpsilon) {
+            return false;
+        }
+    }
+    for (const auto& ack : runtime_state.async_order_acks) {
+        if (ack.status == Contracts::AsyncOrderAck::Status::Pending) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Earliest timestamp satisfying `wake`; frames before it are idle.
+uint64_t resolve_wake_ts(const State::StepKernelState& step_state, const Contracts::WakeCondition& wake)
+{
+    uint64_t wake_ts = wake.wake_at_ts.value_or(std::numeric_limits<uint64_t>::max());
+    if (wake.wake_on_funding) {
+        const size_t funding_count =
+            std::min(step_state.has_next_funding_ts.size(), step_state.next_funding_ts_by_symbol.size());
+        for (size_t i = 0; i < funding_count; ++i) {
+            if (step_state.has_next_funding_ts[i]) {
+                wake_ts = std::min(wake_ts, step_state.next_funding_ts_by_symbol[i]);
+            }
+        }
+    }
+    // Each scan is bounded by the earliest wake found so far.
+    for (const auto& price_wake : wake.price_wakes) {
+        const auto it = step_state.symbol_to_id.find(price_wake.symbol);
+        if (it == step_state.symbol_to_id.end()) {
+            continue;
+        }
+        const size_t symbol_id = it->second;
+        if (symbol_id >= step_state.has_next_ts.size() || !step_state.has_next_ts[symbol_id]) {
+            continue;
+        }
+        const auto& data = step_state.market_data[symbol_id];
+        const auto timestamps = data.timestamps();
+        const auto closes = data.close_prices();
+        for (size_t row = step_state.replay_cursor[symbol_id]; row < timestamps.size() && timestamps[row] < wake_ts; ++row) {
+            if (closes[row] <= price_wake.at_or_below || closes[row] >= price_wake.at_or_above) {
+                wake_ts = timestamps[row];
+                break;
+            }
+        }
+    }
+    return wake_ts;
+}
+
+// Frame for this step: the one assembled ahead by `prefetch_next_step` when pending,
+// otherwise built here. `has_next` is false once replay is exhausted.
+MarketReplayStepFrame next_replay_frame(State::StepKernelState& step_state)
+{
+    if (step_state.replay_prefetch_pending) {
+        return step_state.replay_prefetcher->take(step_state);
+    }
+    if (TerminationPolicy::IsReplayExhausted(step_state)) {
+        return MarketReplayStepFrame{};
+    }
+    return MarketReplayKernel::Next(step_state);
+}
 } // namespace
 
 StepKernel::StepKernel(BinanceExchange& exchange) noexcept
@@ -1367,41 +1566,43 @@ bool StepKernel::run_step() const
     auto& step_state = *exchange_.step_kernel_state_;
     auto& snapshot_state = *exchange_.snapshot_state_;
 
-    if (TerminationPolicy::IsReplayExhausted(step_state)) {
-        TerminationPolicy::CloseChannels(exchange_, step_state);
-        return false;
-    }
-
-    auto frame = MarketReplayKernel::Next(step_state);
+    auto frame = next_replay_frame(step_state);
     if (!frame.has_next) {
         TerminationPolicy::CloseChannels(exchange_, step_state);
         return false;
     }
 
     ++step_state.step_seq;
+    // Taken from the frame, not the live grid: a prefetched frame may already sit in the next window.
+    step_state.step_minute_grid = std::move(frame.minute_grid);
+    step_state.step_minute_grid_minute = frame.minute_grid_minute;
     resolve_log_module_ids_if_needed(step_state, runtime_state.logger);
     const bool need_step_entry_snapshots =
         runtime_state.logger &&
         (step_state.log_module_position_event_id != QTrading::Log::Logger::kInvalidModuleId ||
             step_state.log_module_order_event_id != QTrading::Log::Logger::kInvalidModuleId);
+    // Funding rows arrive only on funding steps; no other step reads the funding snapshot.
     const bool need_funding_apply_snapshot =
         runtime_state.logger &&
-        step_state.log_module_funding_event_id != QTrading::Log::Logger::kInvalidModuleId;
+        step_state.log_module_funding_event_id != QTrading::Log::Logger::kInvalidModuleId &&
+        frame.market_payload &&
+        payload_has_funding_rows(*frame.market_payload);
 
     step_state.has_funding_apply_positions = false;
     step_state.funding_apply_positions.clear();
-    if (need_step_entry_snapshots) {
+    // Once event books exist the step-entry baseline is unused, so steady steps skip the copy.
+    if (need_step_entry_snapshots && !step_state.has_event_snapshots) {
         step_state.step_entry_positions = visible_positions(runtime_state, step_state);
-        step_state.step_entry_orders = runtime_state.orders;
     }
     else {
         step_state.step_entry_positions.clear();
-        step_state.step_entry_orders.clear();
     }
     bool orders_maybe_changed = false;
     bool positions_maybe_changed = false;
     OrderCommandKernel(exchange_).FlushDeferredForStep(step_state.step_seq);
-    QTrading::Utils::GlobalTimestamp.store(frame.ts_exchange, std::memory_order_release);
+    if (runtime_state.logger) {
+        runtime_state.logger->SetTimestamp(frame.ts_exchange);
+    }
     runtime_state.last_status_snapshot.ts_exchange = frame.ts_exchange;
     if (frame.market_payload) {
         Domain::FundingApplyOrchestration::Execute(
@@ -1449,9 +1650,10 @@ bool StepKernel::run_step() const
                         continue;
                     }
                     double liq_price = delta.entry_price;
-                    const auto symbol_it = step_state.symbol_to_id.find(delta.symbol);
-                    if (symbol_it != step_state.symbol_to_id.end()) {
-                        const size_t symbol_id = symbol_it->second;
+                    const auto step_symbol_id =
+                        State::find_symbol_id(step_state, delta.interned_symbol_id, delta.symbol);
+                    if (step_symbol_id.has_value()) {
+                        const size_t symbol_id = *step_symbol_id;
                         if (symbol_id < snapshot_state.has_last_mark_price_by_symbol.size() &&
                             snapshot_state.has_last_mark_price_by_symbol[symbol_id] != 0 &&
                             symbol_id < snapshot_state.last_mark_price_by_symbol.size()) {
@@ -1460,10 +1662,11 @@ bool StepKernel::run_step() const
                     }
                     Domain::MatchFill synthetic{};
                     synthetic.order_id = -999999;
-                    synthetic.symbol_id = symbol_it != step_state.symbol_to_id.end()
-                        ? symbol_it->second
-                        : std::numeric_limits<size_t>::max();
-                    synthetic.symbol = delta.symbol;
+                    synthetic.symbol_id = step_symbol_id.value_or(std::numeric_limits<size_t>::max());
+                    synthetic.interned_symbol_id =
+                        delta.interned_symbol_id != QTrading::Dto::Trading::kInvalidSymbolId
+                            ? delta.interned_symbol_id
+                            : QTrading::Dto::Trading::SymbolTable::Intern(delta.symbol);
                     synthetic.instrument_type = delta.instrument_type;
                     synthetic.side = delta.is_long
                         ? QTrading::Dto::Trading::OrderSide::Sell
@@ -1495,16 +1698,23 @@ bool StepKernel::run_step() const
             runtime_state.perp_open_order_initial_margin);
         refresh_perp_mark_state(step_state, snapshot_state, runtime_state, exchange_.account_state(), *frame.market_payload);
         if (runtime_state.simulation_config.funding_apply_timing == Contracts::FundingApplyTiming::AfterMatching) {
+            auto& payload = *frame.market_payload;
             const size_t funding_count = std::min(
-                frame.market_payload->funding_by_id.size(),
+                payload.symbol_count(),
                 step_state.last_observed_funding_by_symbol.size());
             for (size_t i = 0; i < funding_count; ++i) {
-                if (!frame.market_payload->funding_by_id[i].has_value()) {
+                const auto current = payload.funding(i);
+                if (!current.has_value()) {
                     continue;
                 }
-                const auto current = frame.market_payload->funding_by_id[i];
-                if (step_state.last_observed_funding_by_symbol[i].has_value()) {
-                    frame.market_payload->funding_by_id[i] = step_state.last_observed_funding_by_symbol[i];
+                const auto& previous = step_state.last_observed_funding_by_symbol[i];
+                if (previous.has_value()) {
+                    if (payload.frame.symbol_count != 0) {
+                        payload.frame.set_funding(i, *previous);
+                    }
+                    if (i < payload.funding_by_id.size()) {
+                        payload.funding_by_id[i] = previous;
+                    }
                 }
                 step_state.last_observed_funding_by_symbol[i] = current;
             }
@@ -1550,4 +1760,42 @@ bool StepKernel::run_step() const
     return true;
 }
 
+bool StepKernel::run_until(const Contracts::WakeCondition& wake) const
+{
+    auto& runtime_state = *exchange_.runtime_state_;
+    auto& step_state = *exchange_.step_kernel_state_;
+    auto& snapshot_state = *exchange_.snapshot_state_;
+    // A prefetched frame has already left the replay cursors; it is stepped as is.
+    if (step_state.replay_prefetch_pending || !is_idle_for_fast_forward(runtime_state)) {
+        return run_step();
+    }
+
+    const auto last_skipped_ts = MarketReplayKernel::SkipBefore(step_state, resolve_wake_ts(step_state, wake));
+    if (last_skipped_ts.has_value()) {
+        // Leave behind what the skipped frames would have: last prices and funding rows.
+        // Nothing is held, so funding has nothing to settle.
+        reset_price_row_dirty_state(snapshot_state);
+        apply_step_prices_to_snapshot(snapshot_state, step_state, *last_skipped_ts);
+        const bool track_observed_funding = runtime_state.simulation_config.funding_apply_timing ==
+            Contracts::FundingApplyTiming::AfterMatching;
+        const size_t symbol_count = std::min(
+            step_state.replay_has_funding_by_symbol.size(),
+            step_state.last_applied_funding_time_by_symbol.size());
+        for (size_t i = 0; i < symbol_count; ++i) {
+            if (step_state.replay_has_funding_by_symbol[i] == 0) {
+                continue;
+            }
+            step_state.last_applied_funding_time_by_symbol[i] = step_state.replay_funding_time_by_symbol[i];
+            if (track_observed_funding && i < step_state.last_observed_funding_by_symbol.size()) {
+                const int32_t data_id = step_state.funding_data_id_by_symbol[i];
+                step_state.last_observed_funding_by_symbol[i] =
+                    step_state.funding_data_pool[static_cast<size_t>(data_id)].get_funding(
+                        step_state.funding_cursor_by_symbol[i] - 1);
+            }
+        }
+        Output::SnapshotBuilder::Fill(exchange_, runtime_state.last_status_snapshot);
+    }
+    return run_step();
+}
+
 } // namespace QTrading::Infra::Exchanges::BinanceSim::Application
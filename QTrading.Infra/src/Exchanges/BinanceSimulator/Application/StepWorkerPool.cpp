@@ -0,0 +1,121 @@
+#include "Exchanges/BinanceSimulator/Application/StepWorkerPool.hpp"
+
+#include <algorithm>
+
+namespace QTrading::Infra::Exchanges::BinanceSim::Application {
+
+StepWorkerPool::StepWorkerPool(size_t concurrency)
+{
+    const size_t extra = concurrency > 1 ? concurrency - 1 : 0;
+    threads_.reserve(extra);
+    for (size_t i = 0; i < extra; ++i) {
+        threads_.emplace_back([this, shard = i + 1]() { worker_loop(shard); });
+    }
+}
+
+StepWorkerPool::~StepWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_all();
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+size_t StepWorkerPool::shard_count(size_t count, size_t min_grain) const noexcept
+{
+    if (count == 0) {
+        return 0;
+    }
+    return std::min(concurrency(), std::max<size_t>(1, count / std::max<size_t>(1, min_grain)));
+}
+
+void StepWorkerPool::run_shards(size_t count, size_t shards, ShardInvoker invoke, const void* fn)
+{
+    const size_t shard_size = (count + shards - 1) / shards;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_invoke_ = invoke;
+        task_fn_ = fn;
+        task_count_ = count;
+        shard_count_ = shards;
+        shard_size_ = shard_size;
+        pending_shards_ = shards - 1;
+        error_ = nullptr;
+        ++generation_;
+    }
+    work_cv_.notify_all();
+
+    std::exception_ptr error;
+    try {
+        invoke(fn, 0, std::min(shard_size, count));
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_cv_.wait(lock, [this]() { return pending_shards_ == 0; });
+    task_invoke_ = nullptr;
+    task_fn_ = nullptr;
+    if (!error) {
+        error = error_;
+    }
+    error_ = nullptr;
+    lock.unlock();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void StepWorkerPool::worker_loop(size_t shard)
+{
+    uint64_t seen_generation = 0;
+    for (;;) {
+        ShardInvoker invoke = nullptr;
+        const void* fn = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_cv_.wait(lock, [&]() { return stopping_ || generation_ != seen_generation; });
+            if (stopping_) {
+                return;
+            }
+            seen_generation = generation_;
+            // A call with fewer shards than threads leaves this one idle.
+            if (shard >= shard_count_) {
+                continue;
+            }
+            invoke = task_invoke_;
+            fn = task_fn_;
+            begin = std::min(shard * shard_size_, task_count_);
+            end = std::min(begin + shard_size_, task_count_);
+        }
+
+        std::exception_ptr error;
+        if (begin < end) {
+            try {
+                invoke(fn, begin, end);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error && !error_) {
+            error_ = error;
+        }
+        if (--pending_shards_ == 0) {
+            done_cv_.notify_one();
+        }
+    }
+}
+
+} // namespace QTrading::Infra::Exchanges::BinanceSim::Application
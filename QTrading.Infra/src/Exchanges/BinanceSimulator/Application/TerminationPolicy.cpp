@@ -1,5 +1,7 @@
 #include "Exchanges/BinanceSimulator/Application/TerminationPolicy.hpp"
 
+#include <limits>
+
 #include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
 #include "Exchanges/BinanceSimulator/Output/ChannelPublisher.hpp"
 #include "Exchanges/BinanceSimulator/Output/StepObservableContext.hpp"
@@ -9,7 +11,23 @@ namespace QTrading::Infra::Exchanges::BinanceSim::Application {
 
 bool TerminationPolicy::IsReplayExhausted(const State::StepKernelState& state) noexcept
 {
-    if (!state.next_ts_heap.empty()) {
+    if (state.replay_merge_mode == Config::ReplayMergeMode::MinuteGrid && state.replay_minute_grid &&
+        state.replay_grid_minute < state.replay_minute_grid->minute_count) {
+        // A window ends at its last trade/funding minute, so any remaining minute has a step;
+        // past the window the cursors decide.
+        return false;
+    }
+    if (state.replay_merge_mode != Config::ReplayMergeMode::TimestampHeap) {
+        if (state.calendar_next_ts_valid) {
+            return state.calendar_next_ts == std::numeric_limits<uint64_t>::max();
+        }
+        for (const auto has_next : state.has_next_ts) {
+            if (has_next != 0) {
+                return false;
+            }
+        }
+    }
+    else if (!state.next_ts_heap.empty()) {
         return false;
     }
     for (const auto has_next_funding : state.has_next_funding_ts) {
@@ -1,13 +1,21 @@
 #include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
 
-#include <future>
+#include <algorithm>
 #include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <utility>
 
+#include "Exchanges/BinanceSimulator/Application/MarketReplayKernel.hpp"
+#include "Exchanges/BinanceSimulator/Application/ReplayPrefetcher.hpp"
 #include "Exchanges/BinanceSimulator/Application/StepKernel.hpp"
+#include "Exchanges/BinanceSimulator/Application/StepWorkerPool.hpp"
 #include "Exchanges/BinanceSimulator/Bootstrap/BinanceExchangeBootstrap.hpp"
+#include "Exchanges/BinanceSimulator/Bootstrap/ExchangeCheckpoint.hpp"
 #include "Exchanges/BinanceSimulator/Output/SnapshotBuilder.hpp"
 #include "Exchanges/BinanceSimulator/State/BinanceExchangeRuntimeState.hpp"
+#include "Exchanges/BinanceSimulator/State/ExchangeSnapshot.hpp"
 #include "Exchanges/BinanceSimulator/State/SnapshotState.hpp"
 #include "Exchanges/BinanceSimulator/State/StepKernelState.hpp"
 #include "Queue/ChannelFactory.hpp"
@@ -42,6 +50,10 @@ void rebuild_visible_positions_cache(
                 : 0;
         synthetic.order_id = 0;
         synthetic.symbol = step_state.symbols[symbol_id];
+        synthetic.interned_symbol_id =
+            symbol_id < step_state.interned_symbol_id_by_id.size()
+                ? step_state.interned_symbol_id_by_id[symbol_id]
+                : QTrading::Dto::Trading::kInvalidSymbolId;
         synthetic.quantity = qty;
         synthetic.entry_price =
             symbol_id < runtime_state.spot_inventory_entry_price_by_symbol.size()
@@ -65,10 +77,70 @@ const std::vector<QTrading::dto::Position>& ensure_visible_positions_cache(
     }
     return runtime_state.visible_positions_cache;
 }
+
+// Snapshots copy replay cursors, which a pending prefetch has already moved past the current step.
+void require_no_prefetched_frame(const State::StepKernelState& step_state, const char* operation)
+{
+    if (step_state.replay_prefetch_pending) {
+        throw std::logic_error(std::string("BinanceExchange: ") + operation +
+            " is unavailable while a prefetched frame is pending; step() first");
+    }
+}
+
+// Streams the mapped series from the current replay cursors; null without a chunk budget.
+// A fork or restore resumes mid-replay, so rows behind the cursors are released up front.
+void rebuild_replay_read_ahead(State::StepKernelState& step_state)
+{
+    if (step_state.replay_chunk_budget_bytes == 0) {
+        step_state.replay_read_ahead = nullptr;
+        return;
+    }
+    auto read_ahead = std::make_shared<QTrading::Infra::Data::Binance::ReplayReadAhead>(
+        step_state.market_data,
+        step_state.mark_data_pool,
+        step_state.index_data_pool,
+        step_state.replay_chunk_budget_bytes);
+    for (size_t i = 0; i < step_state.replay_cursor.size(); ++i) {
+        read_ahead->advance_trade(i, step_state.replay_cursor[i]);
+    }
+    for (size_t i = 0; i < step_state.mark_data_id_by_symbol.size() && i < step_state.mark_cursor_by_symbol.size(); ++i) {
+        if (step_state.mark_data_id_by_symbol[i] >= 0) {
+            read_ahead->advance_mark(static_cast<size_t>(step_state.mark_data_id_by_symbol[i]), step_state.mark_cursor_by_symbol[i]);
+        }
+    }
+    for (size_t i = 0; i < step_state.index_data_id_by_symbol.size() && i < step_state.index_cursor_by_symbol.size(); ++i) {
+        if (step_state.index_data_id_by_symbol[i] >= 0) {
+            read_ahead->advance_index(static_cast<size_t>(step_state.index_data_id_by_symbol[i]), step_state.index_cursor_by_symbol[i]);
+        }
+    }
+    step_state.replay_read_ahead = std::move(read_ahead);
+}
+
+void sync_step_worker_pool(State::StepKernelState& step_state, size_t step_worker_count)
+{
+    const size_t step_workers = step_worker_count != 0
+        ? step_worker_count
+        : std::max<size_t>(1, std::thread::hardware_concurrency());
+    const size_t current_step_workers = step_state.step_worker_pool
+        ? step_state.step_worker_pool->concurrency()
+        : 1;
+    if (step_workers != current_step_workers) {
+        step_state.step_worker_pool = step_workers > 1
+            ? std::make_shared<Application::StepWorkerPool>(step_workers)
+            : nullptr;
+    }
+}
 }
 
 BinanceExchange::BinanceExchange(const std::vector<SymbolDataset>& datasets,
     std::shared_ptr<QTrading::Log::Logger> logger, const Account::AccountInitConfig& account_init, uint64_t run_id)
+    : BinanceExchange(datasets, std::move(logger), account_init, run_id, DatasetLoadOptions{})
+{
+}
+
+BinanceExchange::BinanceExchange(const std::vector<SymbolDataset>& datasets,
+    std::shared_ptr<QTrading::Log::Logger> logger, const Account::AccountInitConfig& account_init, uint64_t run_id,
+    const DatasetLoadOptions& load_options)
     : spot(*this),
       perp(*this),
       account(*this),
@@ -83,12 +155,69 @@ BinanceExchange::BinanceExchange(const std::vector<SymbolDataset>& datasets,
     runtime_state_->strict_binance_mode = account_init.strict_binance_mode;
     runtime_state_->merge_positions_enabled = account_init.merge_positions_enabled;
     runtime_state_->vip_level = account_init.vip_level;
-    initialize_step_kernel_state_(datasets, run_id);
+    initialize_step_kernel_state_(
+        datasets,
+        run_id,
+        Bootstrap::LoadDatasets(datasets, load_options),
+        load_options.replay_chunk_budget_bytes);
     initialize_channels_();
     runtime_state_->last_status_snapshot =
         Bootstrap::BuildInitialStatusSnapshot(account_init, runtime_state_->simulation_config);
 }
 
+BinanceExchange::BinanceExchange(const std::vector<SymbolDataset>& datasets,
+    std::shared_ptr<const Bootstrap::LoadedDatasets> shared_data,
+    std::shared_ptr<QTrading::Log::Logger> logger, const Account::AccountInitConfig& account_init, uint64_t run_id)
+    : spot(*this),
+      perp(*this),
+      account(*this),
+      account_(std::make_shared<Account>(account_init)),
+      runtime_state_(std::make_unique<State::BinanceExchangeRuntimeState>()),
+      step_kernel_state_(std::make_unique<State::StepKernelState>()),
+      snapshot_state_(std::make_unique<State::SnapshotState>())
+{
+    if (!shared_data || shared_data->market_data.size() != datasets.size()) {
+        throw std::invalid_argument("BinanceExchange: shared datasets do not match the symbol datasets");
+    }
+    runtime_state_->logger = std::move(logger);
+    runtime_state_->hedge_mode = account_init.hedge_mode;
+    runtime_state_->strict_binance_mode = account_init.strict_binance_mode;
+    runtime_state_->merge_positions_enabled = account_init.merge_positions_enabled;
+    runtime_state_->vip_level = account_init.vip_level;
+    // Kline/reference copies share their column storage; only funding rows are duplicated.
+    initialize_step_kernel_state_(datasets, run_id, *shared_data, 0);
+    initialize_channels_();
+    runtime_state_->last_status_snapshot =
+        Bootstrap::BuildInitialStatusSnapshot(account_init, runtime_state_->simulation_config);
+}
+
+BinanceExchange::BinanceExchange(const State::ExchangeSnapshot& snapshot,
+    std::shared_ptr<QTrading::Log::Logger> logger, uint64_t run_id)
+    : spot(*this),
+      perp(*this),
+      account(*this),
+      account_(std::make_shared<Account>(snapshot.account)),
+      runtime_state_(std::make_unique<State::BinanceExchangeRuntimeState>(snapshot.runtime)),
+      step_kernel_state_(std::make_unique<State::StepKernelState>(snapshot.step)),
+      snapshot_state_(std::make_unique<State::SnapshotState>(snapshot.snapshot))
+{
+    runtime_state_->logger = std::move(logger);
+    step_kernel_state_->run_id = run_id;
+    // Module ids were resolved against the source logger.
+    step_kernel_state_->has_resolved_log_module_ids = false;
+    // Fresh channels start open even when the source had already closed its own,
+    // and receive the current books on the next step: deltas start from an empty book.
+    step_kernel_state_->channels_closed = false;
+    step_kernel_state_->has_published_positions = false;
+    step_kernel_state_->has_published_orders = false;
+    step_kernel_state_->republish_restored_books = false;
+    step_kernel_state_->published_position_book.reset();
+    step_kernel_state_->published_order_book.reset();
+    rebuild_replay_read_ahead(*step_kernel_state_);
+    sync_step_worker_pool(*step_kernel_state_, runtime_state_->simulation_config.step_worker_count);
+    initialize_channels_();
+}
+
 BinanceExchange::~BinanceExchange() = default;
 
 bool BinanceExchange::step()
@@ -97,6 +226,24 @@ bool BinanceExchange::step()
     return Application::StepKernel(*this).run_step();
 }
 
+bool BinanceExchange::step_until(const WakeCondition& wake)
+{
+    return Application::StepKernel(*this).run_until(wake);
+}
+
+bool BinanceExchange::prefetch_next_step()
+{
+    auto& step_state = *step_kernel_state_;
+    if (step_state.replay_prefetch_pending || step_state.channels_closed) {
+        return false;
+    }
+    if (!step_state.replay_prefetcher) {
+        step_state.replay_prefetcher = std::make_shared<Application::ReplayPrefetcher>();
+    }
+    step_state.replay_prefetcher->start(step_state);
+    return true;
+}
+
 const std::vector<QTrading::dto::Position>& BinanceExchange::get_all_positions() const
 {
     return ensure_visible_positions_cache(*runtime_state_, *step_kernel_state_);
@@ -118,10 +265,32 @@ void BinanceExchange::FillStatusSnapshot(StatusSnapshot& out) const
     Output::SnapshotBuilder::Fill(*this, out);
 }
 
+std::span<const double> BinanceExchange::minute_grid_close_row() const noexcept
+{
+    const auto& grid = step_kernel_state_->step_minute_grid;
+    if (!grid || step_kernel_state_->step_minute_grid_minute >= grid->minute_count) {
+        return {};
+    }
+    return grid->close_row(step_kernel_state_->step_minute_grid_minute);
+}
+
 void BinanceExchange::apply_simulation_config(const SimulationConfig& config)
 {
+    if (step_kernel_state_->replay_prefetch_pending) {
+        // The pending frame stays valid; only its off-thread writes must be finished.
+        step_kernel_state_->replay_prefetcher->wait();
+    }
     runtime_state_->simulation_config = config;
     runtime_state_->last_status_snapshot.uncertainty_band_bps = config.uncertainty_band_bps;
+    if (step_kernel_state_->replay_merge_mode != config.replay_merge_mode ||
+        step_kernel_state_->replay_minute_grid_window_minutes != config.replay_minute_grid_window_minutes) {
+        step_kernel_state_->replay_merge_mode = config.replay_merge_mode;
+        step_kernel_state_->replay_minute_grid_window_minutes = config.replay_minute_grid_window_minutes;
+        Application::MarketReplayKernel::ResetMerge(*step_kernel_state_);
+    }
+    // Pooled payloads are reshaped lazily on their next acquire.
+    step_kernel_state_->replay_row_payload_enabled = config.replay_row_payload_enabled;
+    sync_step_worker_pool(*step_kernel_state_, config.step_worker_count);
 }
 
 const BinanceExchange::SimulationConfig& BinanceExchange::simulation_config() const
@@ -139,32 +308,98 @@ const Account& BinanceExchange::account_state() const noexcept
     return *account_;
 }
 
+std::shared_ptr<const State::ExchangeSnapshot> BinanceExchange::snapshot() const
+{
+    require_no_prefetched_frame(*step_kernel_state_, "snapshot");
+    auto out = std::make_shared<State::ExchangeSnapshot>(State::ExchangeSnapshot{
+        *account_,
+        *runtime_state_,
+        *step_kernel_state_,
+        *snapshot_state_
+    });
+    // Detach per-exchange resources: published payloads may still be held by consumers,
+    // and read-ahead/worker threads serve a single stepping thread.
+    out->runtime.logger = nullptr;
+    out->step.replay_payload_pool.clear();
+    out->step.replay_payload_pool_cursor = 0;
+    out->step.replay_read_ahead = nullptr;
+    out->step.step_worker_pool = nullptr;
+    out->step.replay_prefetcher = nullptr;
+    return out;
+}
+
+std::shared_ptr<BinanceExchange> BinanceExchange::fork(
+    std::shared_ptr<QTrading::Log::Logger> logger, uint64_t run_id) const
+{
+    return std::make_shared<BinanceExchange>(*snapshot(), std::move(logger), run_id);
+}
+
+void BinanceExchange::save_checkpoint(std::ostream& out, std::string_view extension) const
+{
+    Bootstrap::WriteExchangeCheckpoint(out, *snapshot(), extension);
+}
+
+std::string BinanceExchange::restore_checkpoint(std::istream& in)
+{
+    require_no_prefetched_frame(*step_kernel_state_, "restore_checkpoint");
+    // Restore into a copy that keeps this exchange's data, logger and pools, then swap it in.
+    State::ExchangeSnapshot restored{ *account_, *runtime_state_, *step_kernel_state_, *snapshot_state_ };
+    std::string extension = Bootstrap::ReadExchangeCheckpoint(in, restored);
+    restored.runtime.visible_positions_cache_version = std::numeric_limits<uint64_t>::max();
+    Application::MarketReplayKernel::ResetMerge(restored.step);
+    // The channel consumers of this process never saw the checkpointed books: publish them
+    // again on the next step, with deltas starting from an empty book.
+    restored.step.has_published_positions = false;
+    restored.step.has_published_orders = false;
+    restored.step.republish_restored_books = true;
+    restored.step.published_position_book.reset();
+    restored.step.published_order_book.reset();
+    restored.step.step_minute_grid.reset();
+
+    *account_ = std::move(restored.account);
+    *runtime_state_ = std::move(restored.runtime);
+    *step_kernel_state_ = std::move(restored.step);
+    *snapshot_state_ = std::move(restored.snapshot);
+    rebuild_replay_read_ahead(*step_kernel_state_);
+    return extension;
+}
+
 void BinanceExchange::initialize_channels_()
 {
-    // Contract: market channel bounded; position/order channels unbounded.
+    // Contract: market channel bounded; position/order channels and their deltas unbounded.
+    // The replay thread is the only market producer and the strategy the only consumer.
+    QTrading::Utils::Queue::ChannelOptions market_options;
+    market_options.single_reader = true;
+    market_options.single_writer = true;
     market_channel = QTrading::Utils::Queue::ChannelFactory::CreateBoundedChannel<MultiKlinePtr>(
-        8, QTrading::Utils::Queue::OverflowPolicy::DropOldest);
+        8, QTrading::Utils::Queue::OverflowPolicy::DropOldest, market_options);
     position_channel = QTrading::Utils::Queue::ChannelFactory::CreateUnboundedChannel<std::vector<QTrading::dto::Position>>();
     order_channel = QTrading::Utils::Queue::ChannelFactory::CreateUnboundedChannel<std::vector<QTrading::dto::Order>>();
+    position_delta_channel = QTrading::Utils::Queue::ChannelFactory::CreateUnboundedChannel<QTrading::dto::PositionBookDelta>();
+    order_delta_channel = QTrading::Utils::Queue::ChannelFactory::CreateUnboundedChannel<QTrading::dto::OrderBookDelta>();
 }
 
-void BinanceExchange::initialize_step_kernel_state_(const std::vector<SymbolDataset>& datasets, uint64_t run_id)
+void BinanceExchange::initialize_step_kernel_state_(
+    const std::vector<SymbolDataset>& datasets,
+    uint64_t run_id,
+    Bootstrap::LoadedDatasets loaded,
+    size_t replay_chunk_budget_bytes)
 {
     // One-time replay state construction; no per-step allocations here.
     const size_t symbol_count = datasets.size();
     step_kernel_state_->run_id = run_id;
     step_kernel_state_->symbols.resize(symbol_count);
     step_kernel_state_->symbol_to_id.reserve(symbol_count);
+    step_kernel_state_->interned_symbol_id_by_id.resize(symbol_count);
     step_kernel_state_->symbol_instrument_type_by_id.resize(symbol_count);
     step_kernel_state_->symbol_spec_by_id.resize(symbol_count);
     step_kernel_state_->symbol_maintenance_margin_tiers_by_id.resize(symbol_count);
     step_kernel_state_->replay_cursor.assign(symbol_count, 0);
-    step_kernel_state_->funding_data_id_by_symbol.assign(symbol_count, -1);
-    step_kernel_state_->mark_data_id_by_symbol.assign(symbol_count, -1);
-    step_kernel_state_->index_data_id_by_symbol.assign(symbol_count, -1);
     step_kernel_state_->funding_cursor_by_symbol.assign(symbol_count, 0);
     step_kernel_state_->mark_cursor_by_symbol.assign(symbol_count, 0);
     step_kernel_state_->index_cursor_by_symbol.assign(symbol_count, 0);
+    step_kernel_state_->mark_interp_cursor_by_symbol.assign(symbol_count, 0);
+    step_kernel_state_->index_interp_cursor_by_symbol.assign(symbol_count, 0);
     step_kernel_state_->next_funding_ts_by_symbol.assign(symbol_count, 0);
     step_kernel_state_->next_mark_ts_by_symbol.assign(symbol_count, 0);
     step_kernel_state_->next_index_ts_by_symbol.assign(symbol_count, 0);
@@ -190,85 +425,33 @@ void BinanceExchange::initialize_step_kernel_state_(const std::vector<SymbolData
     step_kernel_state_->replay_funding_rate_by_symbol.assign(symbol_count, 0.0);
     step_kernel_state_->replay_funding_time_by_symbol.assign(symbol_count, 0);
 
-    size_t funding_count = 0;
-    size_t mark_count = 0;
-    size_t index_count = 0;
     for (size_t i = 0; i < symbol_count; ++i) {
         const auto& ds = datasets[i];
         step_kernel_state_->symbols[i] = ds.symbol;
         step_kernel_state_->symbol_to_id.emplace(ds.symbol, i);
+        const auto interned = QTrading::Dto::Trading::SymbolTable::Intern(ds.symbol);
+        step_kernel_state_->interned_symbol_id_by_id[i] = interned;
+        if (interned >= step_kernel_state_->symbol_id_by_interned_id.size()) {
+            step_kernel_state_->symbol_id_by_interned_id.resize(interned + 1, std::numeric_limits<size_t>::max());
+        }
+        step_kernel_state_->symbol_id_by_interned_id[interned] = i;
         const auto instrument_type = ds.instrument_type.value_or(QTrading::Dto::Trading::InstrumentType::Perp);
         step_kernel_state_->symbol_instrument_type_by_id[i] = instrument_type;
         step_kernel_state_->symbol_spec_by_id[i] =
             instrument_type == QTrading::Dto::Trading::InstrumentType::Spot
                 ? QTrading::Dto::Trading::SpotInstrumentSpec()
                 : QTrading::Dto::Trading::PerpInstrumentSpec();
-        if (ds.funding_csv.has_value()) {
-            step_kernel_state_->funding_data_id_by_symbol[i] = static_cast<int32_t>(funding_count++);
-        }
-        if (ds.mark_kline_csv.has_value() && !ds.mark_kline_csv->empty()) {
-            step_kernel_state_->mark_data_id_by_symbol[i] = static_cast<int32_t>(mark_count++);
-        }
-        if (ds.index_kline_csv.has_value() && !ds.index_kline_csv->empty()) {
-            step_kernel_state_->index_data_id_by_symbol[i] = static_cast<int32_t>(index_count++);
-        }
     }
 
-    std::vector<std::optional<MarketData>> market_slots(symbol_count);
-    std::vector<std::optional<FundingRateData>> funding_slots(funding_count);
-    std::vector<std::optional<MarketData>> mark_slots(mark_count);
-    std::vector<std::optional<MarketData>> index_slots(index_count);
-    std::vector<std::future<void>> load_tasks{};
-    load_tasks.reserve(symbol_count);
-
-    for (size_t i = 0; i < symbol_count; ++i) {
-        load_tasks.push_back(std::async(std::launch::async, [&, i]() {
-            const auto& ds = datasets[i];
-            market_slots[i].emplace(ds.symbol, ds.kline_csv);
-
-            const int32_t funding_id = step_kernel_state_->funding_data_id_by_symbol[i];
-            if (funding_id >= 0 && ds.funding_csv.has_value()) {
-                funding_slots[static_cast<size_t>(funding_id)].emplace(ds.symbol, *ds.funding_csv);
-            }
-
-            const int32_t mark_id = step_kernel_state_->mark_data_id_by_symbol[i];
-            if (mark_id >= 0 && ds.mark_kline_csv.has_value() && !ds.mark_kline_csv->empty()) {
-                mark_slots[static_cast<size_t>(mark_id)].emplace(ds.symbol, *ds.mark_kline_csv);
-            }
-
-            const int32_t index_id = step_kernel_state_->index_data_id_by_symbol[i];
-            if (index_id >= 0 && ds.index_kline_csv.has_value() && !ds.index_kline_csv->empty()) {
-                index_slots[static_cast<size_t>(index_id)].emplace(ds.symbol, *ds.index_kline_csv);
-            }
-        }));
-    }
-    for (auto& task : load_tasks) {
-        task.get();
-    }
-
-    step_kernel_state_->market_data.clear();
-    step_kernel_state_->market_data.reserve(symbol_count);
-    for (size_t i = 0; i < symbol_count; ++i) {
-        step_kernel_state_->market_data.push_back(std::move(*market_slots[i]));
-    }
-
-    step_kernel_state_->funding_data_pool.clear();
-    step_kernel_state_->funding_data_pool.reserve(funding_count);
-    for (size_t i = 0; i < funding_count; ++i) {
-        step_kernel_state_->funding_data_pool.push_back(std::move(*funding_slots[i]));
-    }
-
-    step_kernel_state_->mark_data_pool.clear();
-    step_kernel_state_->mark_data_pool.reserve(mark_count);
-    for (size_t i = 0; i < mark_count; ++i) {
-        step_kernel_state_->mark_data_pool.push_back(std::move(*mark_slots[i]));
-    }
-
-    step_kernel_state_->index_data_pool.clear();
-    step_kernel_state_->index_data_pool.reserve(index_count);
-    for (size_t i = 0; i < index_count; ++i) {
-        step_kernel_state_->index_data_pool.push_back(std::move(*index_slots[i]));
-    }
+    step_kernel_state_->market_data = std::move(loaded.market_data);
+    step_kernel_state_->funding_data_pool = std::move(loaded.funding_data_pool);
+    step_kernel_state_->mark_data_pool = std::move(loaded.mark_data_pool);
+    step_kernel_state_->index_data_pool = std::move(loaded.index_data_pool);
+    step_kernel_state_->funding_data_id_by_symbol = std::move(loaded.funding_data_id_by_symbol);
+    step_kernel_state_->mark_data_id_by_symbol = std::move(loaded.mark_data_id_by_symbol);
+    step_kernel_state_->index_data_id_by_symbol = std::move(loaded.index_data_id_by_symbol);
+    step_kernel_state_->replay_chunk_budget_bytes = replay_chunk_budget_bytes;
+    rebuild_replay_read_ahead(*step_kernel_state_);
 
     for (size_t i = 0; i < symbol_count; ++i) {
         const int32_t funding_id = step_kernel_state_->funding_data_id_by_symbol[i];
@@ -287,7 +470,7 @@ void BinanceExchange::initialize_step_kernel_state_(const std::vector<SymbolData
         if (mark_id >= 0) {
             const auto& mark_data = step_kernel_state_->mark_data_pool[static_cast<size_t>(mark_id)];
             if (mark_data.get_klines_count() > 0) {
-                step_kernel_state_->next_mark_ts_by_symbol[i] = mark_data.get_kline(0).Timestamp;
+                step_kernel_state_->next_mark_ts_by_symbol[i] = mark_data.timestamps().front();
                 step_kernel_state_->has_next_mark_ts[i] = 1;
             }
         }
@@ -295,7 +478,7 @@ void BinanceExchange::initialize_step_kernel_state_(const std::vector<SymbolData
         if (index_id >= 0) {
             const auto& index_data = step_kernel_state_->index_data_pool[static_cast<size_t>(index_id)];
             if (index_data.get_klines_count() > 0) {
-                step_kernel_state_->next_index_ts_by_symbol[i] = index_data.get_kline(0).Timestamp;
+                step_kernel_state_->next_index_ts_by_symbol[i] = index_data.timestamps().front();
                 step_kernel_state_->has_next_index_ts[i] = 1;
             }
         }
@@ -345,14 +528,17 @@ void BinanceExchange::initialize_step_kernel_state_(const std::vector<SymbolData
         State::ReplayPayloadBuffer buffer{};
         buffer.dto = std::make_shared<QTrading::Dto::Market::Binance::MultiKlineDto>();
         buffer.dto->symbols = step_kernel_state_->symbols_shared;
-        buffer.dto->trade_klines_by_id.resize(step_kernel_state_->symbols.size());
-        buffer.dto->mark_klines_by_id.resize(step_kernel_state_->symbols.size());
-        buffer.dto->index_klines_by_id.resize(step_kernel_state_->symbols.size());
-        buffer.dto->funding_by_id.resize(step_kernel_state_->symbols.size());
-        buffer.touched_trade_ids.reserve(step_kernel_state_->symbols.size());
-        buffer.touched_mark_ids.reserve(step_kernel_state_->symbols.size());
-        buffer.touched_index_ids.reserve(step_kernel_state_->symbols.size());
-        buffer.touched_funding_ids.reserve(step_kernel_state_->symbols.size());
+        buffer.dto->frame.resize(step_kernel_state_->symbols.size());
+        if (step_kernel_state_->replay_row_payload_enabled) {
+            buffer.dto->trade_klines_by_id.resize(step_kernel_state_->symbols.size());
+            buffer.dto->mark_klines_by_id.resize(step_kernel_state_->symbols.size());
+            buffer.dto->index_klines_by_id.resize(step_kernel_state_->symbols.size());
+            buffer.dto->funding_by_id.resize(step_kernel_state_->symbols.size());
+            buffer.touched_trade_ids.reserve(step_kernel_state_->symbols.size());
+            buffer.touched_mark_ids.reserve(step_kernel_state_->symbols.size());
+            buffer.touched_index_ids.reserve(step_kernel_state_->symbols.size());
+            buffer.touched_funding_ids.reserve(step_kernel_state_->symbols.size());
+        }
         step_kernel_state_->replay_payload_pool.emplace_back(std::move(buffer));
     }
     step_kernel_state_->replay_payload_pool_cursor = 0;
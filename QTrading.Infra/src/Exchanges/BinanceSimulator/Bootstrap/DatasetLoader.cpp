@@ -0,0 +1,167 @@
+#include "Exchanges/BinanceSimulator/Bootstrap/DatasetLoader.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace QTrading::Infra::Exchanges::BinanceSim::Bootstrap {
+namespace {
+
+struct LoadTask {
+    size_t symbol_index{ 0 };
+    DatasetStream stream{ DatasetStream::TradeKline };
+    /// Slot in the per-stream pool (or symbol index for trade klines).
+    size_t slot{ 0 };
+    const std::string* path{ nullptr };
+};
+
+size_t resolve_worker_count(size_t requested, size_t task_count)
+{
+    size_t workers = requested;
+    if (workers == 0) {
+        workers = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    return std::min(workers, task_count);
+}
+
+template <typename T>
+std::vector<T> unwrap_slots(std::vector<std::optional<T>>& slots)
+{
+    std::vector<T> out;
+    out.reserve(slots.size());
+    for (auto& slot : slots) {
+        out.push_back(std::move(*slot));
+    }
+    return out;
+}
+
+} // namespace
+
+LoadedDatasets LoadDatasets(
+    const std::vector<Contracts::SymbolDataset>& datasets,
+    const DatasetLoadOptions& options)
+{
+    const size_t symbol_count = datasets.size();
+    LoadedDatasets out;
+    out.funding_data_id_by_symbol.assign(symbol_count, -1);
+    out.mark_data_id_by_symbol.assign(symbol_count, -1);
+    out.index_data_id_by_symbol.assign(symbol_count, -1);
+
+    // Ids are assigned in input order before any IO so pools are deterministic.
+    std::vector<LoadTask> tasks;
+    tasks.reserve(symbol_count * 4);
+    size_t funding_count = 0;
+    size_t mark_count = 0;
+    size_t index_count = 0;
+    for (size_t i = 0; i < symbol_count; ++i) {
+        const auto& ds = datasets[i];
+        tasks.push_back(LoadTask{ i, DatasetStream::TradeKline, i, &ds.kline_csv });
+        if (ds.funding_csv.has_value()) {
+            out.funding_data_id_by_symbol[i] = static_cast<int32_t>(funding_count);
+            tasks.push_back(LoadTask{ i, DatasetStream::Funding, funding_count++, &*ds.funding_csv });
+        }
+        if (ds.mark_kline_csv.has_value() && !ds.mark_kline_csv->empty()) {
+            out.mark_data_id_by_symbol[i] = static_cast<int32_t>(mark_count);
+            tasks.push_back(LoadTask{ i, DatasetStream::MarkKline, mark_count++, &*ds.mark_kline_csv });
+        }
+        if (ds.index_kline_csv.has_value() && !ds.index_kline_csv->empty()) {
+            out.index_data_id_by_symbol[i] = static_cast<int32_t>(index_count);
+            tasks.push_back(LoadTask{ i, DatasetStream::IndexKline, index_count++, &*ds.index_kline_csv });
+        }
+    }
+
+    std::vector<std::optional<MarketData>> market_slots(symbol_count);
+    std::vector<std::optional<FundingRateData>> funding_slots(funding_count);
+    std::vector<std::optional<ReferenceKlineData>> mark_slots(mark_count);
+    std::vector<std::optional<ReferenceKlineData>> index_slots(index_count);
+
+    std::atomic<size_t> next_task{ 0 };
+    std::atomic<bool> failed{ false };
+    std::mutex report_mutex;
+    size_t completed = 0;
+    size_t first_error_task = tasks.size();
+    std::exception_ptr first_error;
+
+    const auto run_task = [&](const LoadTask& task) {
+        const auto& symbol = datasets[task.symbol_index].symbol;
+        switch (task.stream) {
+        case DatasetStream::TradeKline:
+            market_slots[task.slot].emplace(symbol, *task.path);
+            break;
+        case DatasetStream::Funding:
+            funding_slots[task.slot].emplace(symbol, *task.path);
+            break;
+        case DatasetStream::MarkKline:
+            // Replay and funding-mark interpolation only consume the close.
+            mark_slots[task.slot].emplace(symbol, *task.path, ReferenceKlineLayout::CloseOnly);
+            break;
+        case DatasetStream::IndexKline:
+            index_slots[task.slot].emplace(symbol, *task.path, ReferenceKlineLayout::CloseOnly);
+            break;
+        }
+    };
+
+    const auto worker = [&]() {
+        while (!failed.load(std::memory_order_relaxed)) {
+            const size_t task_index = next_task.fetch_add(1, std::memory_order_relaxed);
+            if (task_index >= tasks.size()) {
+                return;
+            }
+            const auto& task = tasks[task_index];
+            try {
+                run_task(task);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(report_mutex);
+                if (task_index < first_error_task) {
+                    first_error_task = task_index;
+                    first_error = std::current_exception();
+                }
+                failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(report_mutex);
+            ++completed;
+            if (options.on_progress) {
+                options.on_progress(DatasetLoadProgress{
+                    completed,
+                    tasks.size(),
+                    task.symbol_index,
+                    &datasets[task.symbol_index].symbol,
+                    task.path,
+                    task.stream });
+            }
+        }
+    };
+
+    const size_t worker_count = resolve_worker_count(options.max_parallelism, tasks.size());
+    if (worker_count <= 1) {
+        worker();
+    }
+    else {
+        std::vector<std::thread> workers;
+        workers.reserve(worker_count);
+        for (size_t w = 0; w < worker_count; ++w) {
+            workers.emplace_back(worker);
+        }
+        for (auto& thread : workers) {
+            thread.join();
+        }
+    }
+    if (first_error) {
+        std::rethrow_exception(first_error);
+    }
+
+    out.market_data = unwrap_slots(market_slots);
+    out.funding_data_pool = unwrap_slots(funding_slots);
+    out.mark_data_pool = unwrap_slots(mark_slots);
+    out.index_data_pool = unwrap_slots(index_slots);
+    return out;
+}
+
+} // namespace QTrading::Infra::Exchanges::BinanceSim::Bootstrap
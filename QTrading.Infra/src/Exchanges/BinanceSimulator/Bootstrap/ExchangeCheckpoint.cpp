@@ -0,0 +1,520 @@
+#include "Exchanges/BinanceSimulator/Bootstrap/ExchangeCheckpoint.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <deque>
+#include <istream>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Exchanges/BinanceSimulator/State/ExchangeSnapshot.hpp"
+
+namespace QTrading::Infra::Exchanges::BinanceSim::Bootstrap {
+namespace {
+
+// `transfer` overloads list the fields of one type once for both directions:
+// `T` is const when writing and mutable when reading.
+template <typename T, typename U>
+concept Cv = std::same_as<std::remove_const_t<T>, U>;
+
+template <typename T> struct IsVectorLike : std::false_type {};
+template <typename T, typename A> struct IsVectorLike<std::vector<T, A>> : std::true_type {};
+template <typename T, typename A> struct IsVectorLike<std::deque<T, A>> : std::true_type {};
+template <typename T> struct IsOptional : std::false_type {};
+template <typename T> struct IsOptional<std::optional<T>> : std::true_type {};
+template <typename T> struct IsUnorderedMap : std::false_type {};
+template <typename K, typename V, typename H, typename E, typename A>
+struct IsUnorderedMap<std::unordered_map<K, V, H, E, A>> : std::true_type {};
+
+template <typename T>
+constexpr bool kIsScalar = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+template <typename Io, Cv<QTrading::Dto::Account::BalanceSnapshot> T>
+void transfer(Io& io, T& v)
+{
+    io(v.WalletBalance); io(v.UnrealizedPnl); io(v.MarginBalance); io(v.PositionInitialMargin);
+    io(v.OpenOrderInitialMargin); io(v.AvailableBalance); io(v.MaintenanceMargin); io(v.Equity);
+}
+
+template <typename Io, Cv<Account::LedgerState> T>
+void transfer(Io& io, T& v)
+{
+    io(v.spot_balance); io(v.perp_balance); io(v.total_cash_balance); io(v.state_version);
+}
+
+// Interned ids are process-local, so they are not written; a restored entry interns its symbol again.
+template <typename T>
+void reintern_symbol(T& v)
+{
+    if constexpr (!std::is_const_v<T>) {
+        v.interned_symbol_id = QTrading::Dto::Trading::SymbolTable::Intern(v.symbol);
+    }
+}
+
+template <typename Io, Cv<QTrading::dto::Position> T>
+void transfer(Io& io, T& v)
+{
+    io(v.id); io(v.order_id); io(v.symbol); io(v.quantity); io(v.entry_price); io(v.is_long);
+    io(v.unrealized_pnl); io(v.notional); io(v.initial_margin); io(v.maintenance_margin);
+    io(v.fee); io(v.leverage); io(v.fee_rate); io(v.instrument_type);
+    reintern_symbol(v);
+}
+
+template <typename Io, Cv<QTrading::dto::Order> T>
+void transfer(Io& io, T& v)
+{
+    io(v.id); io(v.symbol); io(v.quantity); io(v.price); io(v.side); io(v.position_side);
+    io(v.reduce_only); io(v.closing_position_id); io(v.instrument_type); io(v.client_order_id);
+    io(v.stp_mode); io(v.close_position); io(v.quote_order_qty); io(v.one_way_reverse);
+    io(v.time_in_force); io(v.first_matching_step);
+    reintern_symbol(v);
+}
+
+template <typename Io, typename T>
+    requires Cv<T, PositionBookReplica> || Cv<T, OrderBookReplica>
+void transfer(Io& io, T& v)
+{
+    if constexpr (std::is_const_v<T>) {
+        io(v.entries()); io(v.seq());
+    }
+    else {
+        std::vector<typename T::value_type> entries;
+        uint64_t seq = 0;
+        io(entries); io(seq);
+        v.reset(std::move(entries), seq);
+    }
+}
+
+template <typename Io, Cv<Contracts::AsyncOrderAck> T>
+void transfer(Io& io, T& v)
+{
+    io(v.request_id); io(v.status); io(v.instrument_type); io(v.symbol); io(v.quantity);
+    io(v.price); io(v.side); io(v.position_side); io(v.reduce_only); io(v.submitted_step);
+    io(v.due_step); io(v.resolved_step); io(v.reject_code); io(v.reject_message);
+    io(v.client_order_id); io(v.stp_mode); io(v.binance_error_code); io(v.binance_error_message);
+    io(v.close_position);
+}
+
+template <typename Io, Cv<Contracts::OrderCommandRequest> T>
+void transfer(Io& io, T& v)
+{
+    io(v.kind); io(v.instrument_type); io(v.symbol); io(v.quantity); io(v.price);
+    io(v.quote_order_qty); io(v.side); io(v.position_side); io(v.time_in_force);
+    io(v.reduce_only); io(v.close_position); io(v.client_order_id); io(v.stp_mode);
+    io(v.first_matching_step);
+}
+
+template <typename Io, Cv<Contracts::DeferredOrderCommand> T>
+void transfer(Io& io, T& v)
+{
+    io(v.request_id); io(v.submitted_step); io(v.due_step); io(v.request);
+}
+
+template <typename Io, Cv<Contracts::StatusPriceSnapshot> T>
+void transfer(Io& io, T& v)
+{
+    io(v.symbol); io(v.price); io(v.has_price); io(v.trade_price); io(v.has_trade_price);
+    io(v.mark_price); io(v.has_mark_price); io(v.mark_price_source); io(v.index_price);
+    io(v.has_index_price); io(v.index_price_source);
+}
+
+template <typename Io, Cv<Contracts::StatusSnapshot> T>
+void transfer(Io& io, T& v)
+{
+    io(v.ts_exchange); io(v.wallet_balance); io(v.margin_balance); io(v.available_balance);
+    io(v.unrealized_pnl); io(v.total_unrealized_pnl); io(v.perp_wallet_balance);
+    io(v.perp_margin_balance); io(v.perp_available_balance); io(v.spot_cash_balance);
+    io(v.spot_available_balance); io(v.spot_inventory_value); io(v.spot_ledger_value);
+    io(v.total_cash_balance); io(v.total_ledger_value); io(v.total_ledger_value_base);
+    io(v.total_ledger_value_conservative); io(v.total_ledger_value_optimistic);
+    io(v.uncertainty_band_bps); io(v.basis_warning_symbols); io(v.basis_stress_symbols);
+    io(v.basis_stress_blocked_orders); io(v.funding_applied_events); io(v.funding_skipped_no_mark);
+    io(v.progress_pct); io(v.prices);
+}
+
+template <typename Io, Cv<QTrading::Dto::Trading::InstrumentSpec> T>
+void transfer(Io& io, T& v)
+{
+    io(v.type); io(v.max_leverage); io(v.allow_short); io(v.funding_enabled);
+    io(v.maintenance_margin_enabled); io(v.liquidation_fee_rate); io(v.min_price); io(v.max_price);
+    io(v.price_tick_size); io(v.min_qty); io(v.max_qty); io(v.qty_step_size); io(v.market_min_qty);
+    io(v.market_max_qty); io(v.market_qty_step_size); io(v.min_notional); io(v.max_notional);
+    io(v.percent_price_by_side); io(v.percent_price_multiplier_up); io(v.percent_price_multiplier_down);
+    io(v.bid_multiplier_up); io(v.bid_multiplier_down); io(v.ask_multiplier_up);
+    io(v.ask_multiplier_down); io(v.trigger_protect); io(v.market_take_bound);
+    io(v.default_stp_mode); io(v.allowed_stp_modes_mask);
+}
+
+template <typename Io, Cv<MarginTier> T>
+void transfer(Io& io, T& v)
+{
+    io(v.notional_upper); io(v.maintenance_margin_rate); io(v.max_leverage);
+}
+
+template <typename Io, Cv<QTrading::Dto::Market::Binance::FundingRateDto> T>
+void transfer(Io& io, T& v)
+{
+    io(v.Timestamp); io(v.FundingTime); io(v.Rate); io(v.MarkPrice);
+}
+
+template <typename Io, Cv<State::SymbolFeeRateOverride> T>
+void transfer(Io& io, T& v)
+{
+    io(v.maker_fee_rate); io(v.taker_fee_rate);
+}
+
+template <typename Io, Cv<State::PositionIndexKey> T>
+void transfer(Io& io, T& v)
+{
+    io(v.symbol_id); io(v.instrument_type); io(v.is_long);
+}
+
+template <typename Io, Cv<State::SnapshotPriceRowById> T>
+void transfer(Io& io, T& v)
+{
+    io(v.price); io(v.has_price); io(v.trade_price); io(v.has_trade_price); io(v.mark_price);
+    io(v.has_mark_price); io(v.mark_price_source); io(v.index_price); io(v.has_index_price);
+    io(v.index_price_source);
+}
+
+template <typename Io, Cv<State::BinanceExchangeRuntimeState> T>
+void transfer(Io& io, T& v)
+{
+    io(v.hedge_mode); io(v.strict_binance_mode); io(v.merge_positions_enabled); io(v.vip_level);
+    io(v.positions); io(v.spot_inventory_qty_by_symbol); io(v.spot_inventory_entry_price_by_symbol);
+    io(v.spot_inventory_position_id_by_symbol); io(v.position_symbol_id_by_slot);
+    io(v.orders); io(v.order_symbol_id_by_slot); io(v.order_symbol_id_by_order_id);
+    io(v.async_order_acks); io(v.symbol_leverage); io(v.spot_symbol_fee_overrides);
+    io(v.perp_symbol_fee_overrides); io(v.spot_open_order_initial_margin);
+    io(v.perp_open_order_initial_margin); io(v.spot_open_order_initial_margin_by_symbol);
+    io(v.perp_open_order_initial_margin_by_symbol); io(v.perp_reference_price_by_symbol);
+    io(v.perp_net_position_qty_by_symbol); io(v.order_reservation_cache_ready);
+    io(v.last_status_snapshot); io(v.event_publish_mode); io(v.basis_stress_blocked_orders_total);
+    io(v.order_latency_bars); io(v.next_order_id); io(v.orders_version); io(v.next_position_id);
+    io(v.positions_version); io(v.position_slot_by_id); io(v.position_ids_by_key);
+    io(v.position_symbol_id_by_position_id); io(v.position_index_ready);
+    io(v.next_async_order_request_id); io(v.deferred_order_commands);
+}
+
+template <typename Io, Cv<State::StepKernelState> T>
+void transfer(Io& io, T& v)
+{
+    io(v.core_mode); io(v.force_legacy_only);
+    io(v.symbol_spec_by_id); io(v.symbol_maintenance_margin_tiers_by_id);
+    // Replay, funding and reference-price cursors.
+    io(v.replay_cursor); io(v.next_ts_by_symbol); io(v.has_next_ts);
+    io(v.funding_cursor_by_symbol); io(v.mark_cursor_by_symbol); io(v.index_cursor_by_symbol);
+    io(v.mark_interp_cursor_by_symbol); io(v.index_interp_cursor_by_symbol);
+    io(v.next_funding_ts_by_symbol); io(v.next_mark_ts_by_symbol); io(v.next_index_ts_by_symbol);
+    io(v.has_next_funding_ts); io(v.has_next_mark_ts); io(v.has_next_index_ts);
+    io(v.last_applied_funding_time_by_symbol); io(v.last_observed_funding_by_symbol);
+    io(v.funding_applied_events_total); io(v.funding_skipped_no_mark_total);
+    // Current-step SoA caches.
+    io(v.replay_has_trade_kline_by_symbol); io(v.replay_trade_open_by_symbol);
+    io(v.replay_trade_high_by_symbol); io(v.replay_trade_low_by_symbol);
+    io(v.replay_trade_close_by_symbol); io(v.replay_trade_volume_by_symbol);
+    io(v.replay_trade_taker_buy_base_volume_by_symbol); io(v.replay_has_mark_price_by_symbol);
+    io(v.replay_mark_price_by_symbol); io(v.replay_has_index_price_by_symbol);
+    io(v.replay_index_price_by_symbol); io(v.replay_has_funding_by_symbol);
+    io(v.replay_funding_rate_by_symbol); io(v.replay_funding_time_by_symbol);
+    // Publication and event-diff baselines.
+    io(v.step_seq); io(v.account_state_version); io(v.last_logged_status_version);
+    // The published delta books mirror the live channel consumers and are not restored;
+    // restore clears has_published_* so the new consumers receive the books again.
+    io(v.last_published_account_state_version); io(v.last_published_orders_version);
+    io(v.last_published_positions_version); io(v.has_published_positions);
+    io(v.has_published_orders); io(v.event_position_book); io(v.event_order_book);
+    io(v.step_entry_positions); io(v.funding_apply_positions);
+    io(v.has_funding_apply_positions); io(v.has_event_snapshots);
+    io(v.last_event_wallet_balance); io(v.has_last_event_wallet_balance);
+}
+
+template <typename Io, Cv<State::SnapshotState> T>
+void transfer(Io& io, T& v)
+{
+    io(v.ts_exchange); io(v.step_seq); io(v.progress_pct);
+    io(v.last_trade_price_by_symbol); io(v.has_last_trade_price_by_symbol);
+    io(v.last_mark_price_by_symbol); io(v.has_last_mark_price_by_symbol);
+    io(v.last_mark_price_ts_by_symbol); io(v.last_mark_price_source_by_symbol);
+    io(v.last_index_price_by_symbol); io(v.has_last_index_price_by_symbol);
+    io(v.last_index_price_ts_by_symbol); io(v.last_index_price_source_by_symbol);
+    io(v.price_rows_by_symbol); io(v.price_row_dirty_by_symbol); io(v.dirty_price_symbol_ids);
+    io(v.price_rows_version);
+}
+
+// Map entries are written in key order so equal states produce equal bytes.
+template <typename K>
+bool key_less(const K& a, const K& b)
+{
+    if constexpr (std::is_same_v<K, State::PositionIndexKey>) {
+        return std::tuple(a.symbol_id, a.instrument_type, a.is_long) <
+            std::tuple(b.symbol_id, b.instrument_type, b.is_long);
+    }
+    else {
+        return a < b;
+    }
+}
+
+class CheckpointWriter {
+public:
+    explicit CheckpointWriter(std::ostream& out) : out_(out) {}
+
+    template <typename T>
+    void operator()(const T& v)
+    {
+        if constexpr (kIsScalar<T>) {
+            raw(&v, sizeof(T));
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            count(v.size());
+            raw(v.data(), v.size());
+        }
+        else if constexpr (IsOptional<T>::value) {
+            (*this)(static_cast<uint8_t>(v.has_value()));
+            if (v.has_value()) {
+                (*this)(*v);
+            }
+        }
+        else if constexpr (IsVectorLike<T>::value) {
+            using E = typename T::value_type;
+            count(v.size());
+            if constexpr (kIsScalar<E> && std::is_same_v<T, std::vector<E>>) {
+                raw(v.data(), v.size() * sizeof(E));
+            }
+            else {
+                for (const auto& e : v) {
+                    (*this)(e);
+                }
+            }
+        }
+        else if constexpr (IsUnorderedMap<T>::value) {
+            std::vector<const typename T::value_type*> entries;
+            entries.reserve(v.size());
+            for (const auto& entry : v) {
+                entries.push_back(&entry);
+            }
+            std::sort(entries.begin(), entries.end(), [](const auto* a, const auto* b) {
+                return key_less(a->first, b->first);
+            });
+            count(entries.size());
+            for (const auto* entry : entries) {
+                (*this)(entry->first);
+                (*this)(entry->second);
+            }
+        }
+        else {
+            transfer(*this, v);
+        }
+    }
+
+    void raw(const void* data, size_t bytes)
+    {
+        out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    }
+
+private:
+    void count(size_t n) { (*this)(static_cast<uint64_t>(n)); }
+
+    std::ostream& out_;
+};
+
+class CheckpointReader {
+public:
+    explicit CheckpointReader(std::istream& in) : in_(in)
+    {
+        // Bounds element counts so a corrupt header cannot trigger huge allocations.
+        const auto start = in_.tellg();
+        if (start != std::streampos(-1) && in_.seekg(0, std::ios::end)) {
+            const auto end = in_.tellg();
+            in_.seekg(start);
+            if (end != std::streampos(-1) && end >= start) {
+                remaining_ = static_cast<uint64_t>(end - start);
+            }
+        }
+        in_.clear();
+        in_.seekg(start);
+    }
+
+    template <typename T>
+    void operator()(T& v)
+    {
+        if constexpr (kIsScalar<T>) {
+            raw(&v, sizeof(T));
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            v.resize(count(1));
+            raw(v.data(), v.size());
+        }
+        else if constexpr (IsOptional<T>::value) {
+            uint8_t has_value = 0;
+            (*this)(has_value);
+            if (has_value != 0) {
+                typename T::value_type value{};
+                (*this)(value);
+                v = std::move(value);
+            }
+            else {
+                v.reset();
+            }
+        }
+        else if constexpr (IsVectorLike<T>::value) {
+            using E = typename T::value_type;
+            if constexpr (kIsScalar<E> && std::is_same_v<T, std::vector<E>>) {
+                v.resize(count(sizeof(E)));
+                raw(v.data(), v.size() * sizeof(E));
+            }
+            else {
+                v.clear();
+                v.resize(count(1));
+                for (auto& e : v) {
+                    (*this)(e);
+                }
+            }
+        }
+        else if constexpr (IsUnorderedMap<T>::value) {
+            const size_t n = count(1);
+            v.clear();
+            v.reserve(n);
+            for (size_t i = 0; i < n; ++i) {
+                typename T::key_type key{};
+                typename T::mapped_type value{};
+                (*this)(key);
+                (*this)(value);
+                v.emplace(std::move(key), std::move(value));
+            }
+        }
+        else {
+            transfer(*this, v);
+        }
+    }
+
+    void raw(void* data, size_t bytes)
+    {
+        if (bytes > remaining_) {
+            throw std::runtime_error("exchange checkpoint is truncated");
+        }
+        in_.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes));
+        if (static_cast<size_t>(in_.gcount()) != bytes) {
+            throw std::runtime_error("exchange checkpoint is truncated");
+        }
+        remaining_ -= bytes;
+    }
+
+private:
+    size_t count(size_t min_element_bytes)
+    {
+        uint64_t n = 0;
+        (*this)(n);
+        if (n > remaining_ / min_element_bytes) {
+            throw std::runtime_error("exchange checkpoint is truncated");
+        }
+        return static_cast<size_t>(n);
+    }
+
+    std::istream& in_;
+    uint64_t remaining_{ std::numeric_limits<uint64_t>::max() };
+};
+
+/// Symbols and series row counts the checkpoint's cursors index into.
+struct DatasetFingerprint {
+    std::vector<std::string> symbols;
+    std::vector<uint64_t> trade_rows;
+    std::vector<uint64_t> funding_rows;
+    std::vector<uint64_t> mark_rows;
+    std::vector<uint64_t> index_rows;
+    std::vector<int32_t> funding_ids;
+    std::vector<int32_t> mark_ids;
+    std::vector<int32_t> index_ids;
+
+    bool operator==(const DatasetFingerprint&) const = default;
+};
+
+template <typename Io, Cv<DatasetFingerprint> T>
+void transfer(Io& io, T& v)
+{
+    io(v.symbols); io(v.trade_rows); io(v.funding_rows); io(v.mark_rows); io(v.index_rows);
+    io(v.funding_ids); io(v.mark_ids); io(v.index_ids);
+}
+
+DatasetFingerprint fingerprint(const State::StepKernelState& step)
+{
+    DatasetFingerprint out{};
+    out.symbols = step.symbols;
+    for (const auto& data : step.market_data) {
+        out.trade_rows.push_back(data.get_klines_count());
+    }
+    for (const auto& data : step.funding_data_pool) {
+        out.funding_rows.push_back(data.get_count());
+    }
+    for (const auto& data : step.mark_data_pool) {
+        out.mark_rows.push_back(data.get_klines_count());
+    }
+    for (const auto& data : step.index_data_pool) {
+        out.index_rows.push_back(data.get_klines_count());
+    }
+    out.funding_ids = step.funding_data_id_by_symbol;
+    out.mark_ids = step.mark_data_id_by_symbol;
+    out.index_ids = step.index_data_id_by_symbol;
+    return out;
+}
+
+} // namespace
+
+void WriteExchangeCheckpoint(
+    std::ostream& out,
+    const State::ExchangeSnapshot& snapshot,
+    std::string_view extension)
+{
+    CheckpointWriter writer(out);
+    writer.raw(kExchangeCheckpointMagic, sizeof(kExchangeCheckpointMagic));
+    writer(kExchangeCheckpointFormatVersion);
+    writer(fingerprint(snapshot.step));
+    writer(snapshot.account.ledger_state());
+    writer(snapshot.runtime);
+    writer(snapshot.step);
+    writer(snapshot.snapshot);
+    writer(std::string(extension));
+    if (!out) {
+        throw std::runtime_error("failed to write exchange checkpoint");
+    }
+}
+
+std::string ReadExchangeCheckpoint(std::istream& in, State::ExchangeSnapshot& snapshot)
+{
+    CheckpointReader reader(in);
+    char magic[sizeof(kExchangeCheckpointMagic)]{};
+    reader.raw(magic, sizeof(magic));
+    if (std::memcmp(magic, kExchangeCheckpointMagic, sizeof(magic)) != 0) {
+        throw std::runtime_error("not an exchange checkpoint");
+    }
+    uint32_t version = 0;
+    reader(version);
+    if (version != kExchangeCheckpointFormatVersion) {
+        throw std::runtime_error("unsupported exchange checkpoint version " + std::to_string(version));
+    }
+    DatasetFingerprint stored{};
+    reader(stored);
+    if (!(stored == fingerprint(snapshot.step))) {
+        throw std::runtime_error("exchange checkpoint was written for different datasets");
+    }
+
+    Account::LedgerState ledger{};
+    reader(ledger);
+    reader(snapshot.runtime);
+    reader(snapshot.step);
+    reader(snapshot.snapshot);
+    std::string extension;
+    reader(extension);
+    snapshot.account.restore_ledger_state(ledger);
+    return extension;
+}
+
+} // namespace QTrading::Infra::Exchanges::BinanceSim::Bootstrap
@@ -58,6 +58,7 @@ bool AccountPolicyExecutionService::TryQueueOrder(
     QTrading::dto::Order order{};
     order.id = next_order_id++;
     order.symbol = symbol;
+    order.interned_symbol_id = QTrading::Dto::Trading::SymbolTable::Intern(symbol);
     order.quantity = quantity;
     order.price = price;
     order.side = side;
@@ -152,6 +153,7 @@ AccountPolicyUpdateResult AccountPolicyExecutionService::ApplyUpdates(
         position.id = static_cast<int>(positions.size() + 1);
         position.order_id = order.id;
         position.symbol = order.symbol;
+        position.interned_symbol_id = order.interned_symbol_id;
         position.quantity = fill_quantity;
         position.entry_price = fill_price;
         position.is_long = order.side == QTrading::Dto::Trading::OrderSide::Buy;
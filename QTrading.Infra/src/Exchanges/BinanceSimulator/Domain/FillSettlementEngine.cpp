@@ -37,9 +37,11 @@ double fee_rate_for_fill(
     const MatchFill& fill)
 {
     if (fill.instrument_type == QTrading::Dto::Trading::InstrumentType::Spot) {
-        const auto symbol_it = runtime_state.spot_symbol_fee_overrides.find(fill.symbol);
-        if (symbol_it != runtime_state.spot_symbol_fee_overrides.end()) {
-            return fill.is_taker ? symbol_it->second.taker_fee_rate : symbol_it->second.maker_fee_rate;
+        if (!runtime_state.spot_symbol_fee_overrides.empty()) {
+            const auto symbol_it = runtime_state.spot_symbol_fee_overrides.find(fill_symbol_name(fill));
+            if (symbol_it != runtime_state.spot_symbol_fee_overrides.end()) {
+                return fill.is_taker ? symbol_it->second.taker_fee_rate : symbol_it->second.maker_fee_rate;
+            }
         }
         auto spot_it = ::spot_vip_fee_rates.find(runtime_state.vip_level);
         if (spot_it == ::spot_vip_fee_rates.end()) {
@@ -47,9 +49,11 @@ double fee_rate_for_fill(
         }
         return fill.is_taker ? spot_it->second.taker_fee_rate : spot_it->second.maker_fee_rate;
     }
-    const auto symbol_it = runtime_state.perp_symbol_fee_overrides.find(fill.symbol);
-    if (symbol_it != runtime_state.perp_symbol_fee_overrides.end()) {
-        return fill.is_taker ? symbol_it->second.taker_fee_rate : symbol_it->second.maker_fee_rate;
+    if (!runtime_state.perp_symbol_fee_overrides.empty()) {
+        const auto symbol_it = runtime_state.perp_symbol_fee_overrides.find(fill_symbol_name(fill));
+        if (symbol_it != runtime_state.perp_symbol_fee_overrides.end()) {
+            return fill.is_taker ? symbol_it->second.taker_fee_rate : symbol_it->second.maker_fee_rate;
+        }
     }
     auto perp_it = ::vip_fee_rates.find(runtime_state.vip_level);
     if (perp_it == ::vip_fee_rates.end()) {
@@ -138,16 +142,13 @@ bool is_valid_authoritative_symbol_id(
 
 std::optional<size_t> try_step_symbol_id(
     const State::StepKernelState* step_state,
+    QTrading::Dto::Trading::SymbolId interned_symbol_id,
     const std::string& symbol)
 {
     if (step_state == nullptr) {
         return std::nullopt;
     }
-    const auto it = step_state->symbol_to_id.find(symbol);
-    if (it == step_state->symbol_to_id.end()) {
-        return std::nullopt;
-    }
-    return it->second;
+    return State::find_symbol_id(*step_state, interned_symbol_id, symbol);
 }
 
 std::optional<size_t> try_cached_position_symbol_id(
@@ -173,7 +174,15 @@ std::optional<size_t> try_resolve_fill_symbol_id(
     const State::StepKernelState* step_state,
     const MatchFill& fill)
 {
-    const auto step_symbol_id = try_step_symbol_id(step_state, fill.symbol);
+    std::optional<size_t> step_symbol_id;
+    if (step_state != nullptr) {
+        // Symbol text is only resolved for fills interned after the replay table was built.
+        const bool covered = fill.interned_symbol_id < step_state->symbol_id_by_interned_id.size() ||
+            fill.interned_symbol_id == QTrading::Dto::Trading::kInvalidSymbolId;
+        step_symbol_id = covered
+            ? State::find_symbol_id(*step_state, fill.interned_symbol_id, {})
+            : State::find_symbol_id(*step_state, fill.interned_symbol_id, fill_symbol_name(fill));
+    }
     if (fill.symbol_id != kInvalidSymbolId) {
         if (step_symbol_id.has_value() && *step_symbol_id != fill.symbol_id) {
             return std::nullopt;
@@ -238,7 +247,7 @@ void normalize_legacy_spot_inventory(
             perp_positions.push_back(position);
             continue;
         }
-        const auto symbol_id = try_step_symbol_id(step_state, position.symbol);
+        const auto symbol_id = try_step_symbol_id(step_state, position.interned_symbol_id, position.symbol);
         if (!symbol_id.has_value()) {
             throw_invariant_breach("legacy spot inventory missing authoritative symbol id for " + position.symbol);
         }
@@ -261,7 +270,7 @@ std::optional<size_t> resolve_position_symbol_id(
     const QTrading::dto::Position& position,
     size_t slot)
 {
-    const auto step_symbol_id = try_step_symbol_id(step_state, position.symbol);
+    const auto step_symbol_id = try_step_symbol_id(step_state, position.interned_symbol_id, position.symbol);
     const auto cached_symbol_id = try_cached_position_symbol_id(runtime_state, position, slot);
     if (step_symbol_id.has_value() && cached_symbol_id.has_value() && *step_symbol_id != *cached_symbol_id) {
         return std::nullopt;
@@ -433,7 +442,7 @@ std::optional<size_t> find_perp_position_slot(
     State::BinanceExchangeRuntimeState& runtime_state,
     const State::StepKernelState* step_state,
     size_t symbol_id,
-    const std::string& symbol,
+    QTrading::Dto::Trading::SymbolId interned_symbol_id,
     std::optional<bool> is_long = std::nullopt)
 {
     if (symbol_id != kInvalidSymbolId) {
@@ -468,7 +477,7 @@ std::optional<size_t> find_perp_position_slot(
     }
     return find_position_slot_linear(
         runtime_state,
-        symbol,
+        QTrading::Dto::Trading::SymbolTable::Name(interned_symbol_id),
         QTrading::Dto::Trading::InstrumentType::Perp,
         is_long);
 }
@@ -583,7 +592,8 @@ void append_perp_position(
     QTrading::dto::Position created{};
     created.id = allocate_next_position_id(runtime_state);
     created.order_id = fill.order_id;
-    created.symbol = fill.symbol;
+    created.symbol = fill_symbol_name(fill);
+    created.interned_symbol_id = fill.interned_symbol_id;
     created.quantity = quantity;
     created.entry_price = fill.price;
     created.is_long = is_long;
@@ -615,9 +625,10 @@ void assert_position_index_invariants(
         const size_t symbol_id = runtime_state.position_symbol_id_by_slot[slot];
         assert(symbol_id != kInvalidSymbolId);
         if (step_state != nullptr) {
-            const auto it = step_state->symbol_to_id.find(position.symbol);
-            assert(it != step_state->symbol_to_id.end());
-            assert(it->second == symbol_id);
+            const auto step_symbol_id =
+                State::find_symbol_id(*step_state, position.interned_symbol_id, position.symbol);
+            assert(step_symbol_id.has_value());
+            assert(*step_symbol_id == symbol_id);
         }
         const auto slot_it = runtime_state.position_slot_by_id.find(position.id);
         assert(slot_it != runtime_state.position_slot_by_id.end());
@@ -640,7 +651,7 @@ bool apply_spot_fill(
 {
     const auto fill_symbol_id = try_resolve_fill_symbol_id(runtime_state, step_state, fill);
     if (step_state != nullptr && !fill_symbol_id.has_value()) {
-        throw_invariant_breach("spot fill missing authoritative symbol id for " + fill.symbol);
+        throw_invariant_breach("spot fill missing authoritative symbol id for " + fill_symbol_name(fill));
     }
 
     const double notional = fill.quantity * fill.price;
@@ -654,7 +665,7 @@ bool apply_spot_fill(
     ensure_spot_inventory_shape(runtime_state, step_state, resolved_symbol_id);
     if (resolved_symbol_id == kInvalidSymbolId ||
         resolved_symbol_id >= runtime_state.spot_inventory_qty_by_symbol.size()) {
-        throw_invariant_breach("spot fill cannot resolve inventory slot for " + fill.symbol);
+        throw_invariant_breach("spot fill cannot resolve inventory slot for " + fill_symbol_name(fill));
     }
 
     auto& qty = runtime_state.spot_inventory_qty_by_symbol[resolved_symbol_id];
@@ -666,7 +677,7 @@ bool apply_spot_fill(
         const double before = qty;
         const double after = before + net_quantity;
         if (!(after > kEpsilon)) {
-            throw_invariant_breach("spot buy produced non-positive inventory for " + fill.symbol);
+            throw_invariant_breach("spot buy produced non-positive inventory for " + fill_symbol_name(fill));
         }
         if (before > kEpsilon) {
             entry_price = ((entry_price * before) + (fill.price * net_quantity)) / after;
@@ -683,10 +694,10 @@ bool apply_spot_fill(
     }
 
     if (!(qty > kEpsilon)) {
-        throw_invariant_breach("spot sell fill has no matching inventory position for " + fill.symbol);
+        throw_invariant_breach("spot sell fill has no matching inventory position for " + fill_symbol_name(fill));
     }
     if (qty + kEpsilon < fill.quantity) {
-        throw_invariant_breach("spot sell fill exceeds inventory for " + fill.symbol);
+        throw_invariant_breach("spot sell fill exceeds inventory for " + fill_symbol_name(fill));
     }
 
     const double next_quantity = std::max(0.0, qty - fill.quantity);
@@ -711,7 +722,7 @@ bool apply_perp_fill(
 {
     const auto fill_symbol_id = try_resolve_fill_symbol_id(runtime_state, step_state, fill);
     if (step_state != nullptr && !fill_symbol_id.has_value()) {
-        throw_invariant_breach("perp fill missing authoritative symbol id for " + fill.symbol);
+        throw_invariant_breach("perp fill missing authoritative symbol id for " + fill_symbol_name(fill));
     }
 
     const size_t resolved_symbol_id = fill_symbol_id.value_or(kInvalidSymbolId);
@@ -726,12 +737,12 @@ bool apply_perp_fill(
             runtime_state,
             step_state,
             resolved_symbol_id,
-            fill.symbol,
+            fill.interned_symbol_id,
             target_is_long);
 
         if (fill.reduce_only || fill.close_position) {
             if (!position_slot.has_value()) {
-                throw_invariant_breach("hedge reduce fill has no matching perp position for " + fill.symbol);
+                throw_invariant_breach("hedge reduce fill has no matching perp position for " + fill_symbol_name(fill));
             }
 
             auto& position = runtime_state.positions[*position_slot];
@@ -739,12 +750,12 @@ bool apply_perp_fill(
                 ? QTrading::Dto::Trading::OrderSide::Sell
                 : QTrading::Dto::Trading::OrderSide::Buy;
             if (fill.side != closes_side) {
-                throw_invariant_breach("hedge reduce fill side mismatch for " + fill.symbol);
+                throw_invariant_breach("hedge reduce fill side mismatch for " + fill_symbol_name(fill));
             }
 
             const double effective = std::min(position.quantity, fill.quantity);
             if (effective <= kEpsilon) {
-                throw_invariant_breach("hedge reduce fill has no reducible quantity for " + fill.symbol);
+                throw_invariant_breach("hedge reduce fill has no reducible quantity for " + fill_symbol_name(fill));
             }
 
             const double realized_pnl = compute_perp_realized_pnl_for_close(position, effective, fill.price);
@@ -795,21 +806,21 @@ bool apply_perp_fill(
         runtime_state,
         step_state,
         resolved_symbol_id,
-        fill.symbol);
+        fill.interned_symbol_id);
     if (fill.reduce_only) {
         if (!position_slot.has_value()) {
-            throw_invariant_breach("reduce-only fill has no matching perp position for " + fill.symbol);
+            throw_invariant_breach("reduce-only fill has no matching perp position for " + fill_symbol_name(fill));
         }
         const auto& position = runtime_state.positions[*position_slot];
         const double current_signed = position.is_long ? position.quantity : -position.quantity;
         if (current_signed * signed_fill >= 0.0) {
-            throw_invariant_breach("reduce-only fill does not reduce existing position for " + fill.symbol);
+            throw_invariant_breach("reduce-only fill does not reduce existing position for " + fill_symbol_name(fill));
         }
         const double reducible = std::abs(current_signed);
         const double requested = std::abs(signed_fill);
         const double effective = std::min(reducible, requested);
         if (effective <= kEpsilon) {
-            throw_invariant_breach("reduce-only fill has zero effective quantity for " + fill.symbol);
+            throw_invariant_breach("reduce-only fill has zero effective quantity for " + fill_symbol_name(fill));
         }
         signed_fill = signed_fill > 0.0 ? effective : -effective;
     }
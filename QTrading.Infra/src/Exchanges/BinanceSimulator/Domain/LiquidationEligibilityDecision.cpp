@@ -31,12 +31,13 @@ LiquidationHealthSnapshot LiquidationEligibilityDecision::Evaluate(
     const size_t symbol_count = step_state.symbols.size();
     mark_price_scratch.assign(symbol_count, 0.0);
     has_mark_scratch.assign(symbol_count, 0);
-    const size_t mark_count = std::min(symbol_count, market_payload.mark_klines_by_id.size());
+    const size_t mark_count = std::min(symbol_count, market_payload.symbol_count());
     for (size_t i = 0; i < mark_count; ++i) {
-        if (!market_payload.mark_klines_by_id[i].has_value()) {
+        const auto mark = market_payload.mark_close(i);
+        if (!mark.has_value()) {
             continue;
         }
-        mark_price_scratch[i] = market_payload.mark_klines_by_id[i]->ClosePrice;
+        mark_price_scratch[i] = *mark;
         has_mark_scratch[i] = 1;
     }
 
@@ -50,12 +51,13 @@ LiquidationHealthSnapshot LiquidationEligibilityDecision::Evaluate(
             continue;
         }
         out.has_perp_positions = true;
-        const auto symbol_it = step_state.symbol_to_id.find(position.symbol);
-        if (symbol_it == step_state.symbol_to_id.end()) {
+        const auto step_symbol_id =
+            State::find_symbol_id(step_state, position.interned_symbol_id, position.symbol);
+        if (!step_symbol_id.has_value()) {
             out.has_full_mark_context = false;
             continue;
         }
-        const size_t symbol_id = symbol_it->second;
+        const size_t symbol_id = *step_symbol_id;
         if (symbol_id >= has_mark_scratch.size() || has_mark_scratch[symbol_id] == 0) {
             out.has_full_mark_context = false;
             continue;
@@ -98,11 +100,12 @@ int LiquidationEligibilityDecision::FindWorstLossPerpPositionIndex(
             position.quantity <= kEpsilon) {
             continue;
         }
-        const auto symbol_it = step_state.symbol_to_id.find(position.symbol);
-        if (symbol_it == step_state.symbol_to_id.end()) {
+        const auto step_symbol_id =
+            State::find_symbol_id(step_state, position.interned_symbol_id, position.symbol);
+        if (!step_symbol_id.has_value()) {
             continue;
         }
-        const size_t symbol_id = symbol_it->second;
+        const size_t symbol_id = *step_symbol_id;
         if (symbol_id >= has_mark_scratch.size() || has_mark_scratch[symbol_id] == 0) {
             continue;
         }
@@ -71,12 +71,12 @@ std::optional<size_t> resolve_position_symbol_id(
     if (cached_it != runtime_state.position_symbol_id_by_position_id.end()) {
         return cached_it->second;
     }
-    const auto symbol_it = step_state.symbol_to_id.find(position.symbol);
-    if (symbol_it == step_state.symbol_to_id.end()) {
+    const auto symbol_id = State::find_symbol_id(step_state, position.interned_symbol_id, position.symbol);
+    if (!symbol_id.has_value()) {
         return std::nullopt;
     }
-    runtime_state.position_symbol_id_by_position_id[position.id] = symbol_it->second;
-    return symbol_it->second;
+    runtime_state.position_symbol_id_by_position_id[position.id] = *symbol_id;
+    return symbol_id;
 }
 
 bool cancel_all_perp_orders(State::BinanceExchangeRuntimeState& runtime_state) noexcept
@@ -132,6 +132,7 @@ void append_position_delta(
     LiquidationPositionDelta delta{};
     delta.position_id = position.id;
     delta.symbol = position.symbol;
+    delta.interned_symbol_id = position.interned_symbol_id;
     delta.instrument_type = position.instrument_type;
     delta.is_long = position.is_long;
     delta.entry_price = position.entry_price;
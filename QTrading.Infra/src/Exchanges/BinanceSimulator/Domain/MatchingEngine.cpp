@@ -8,6 +8,7 @@
 #include <numeric>
 
 #include "Dto/Market/Binance/MultiKline.hpp"
+#include "Exchanges/BinanceSimulator/Application/StepWorkerPool.hpp"
 #include "Exchanges/BinanceSimulator/State/BinanceExchangeRuntimeState.hpp"
 #include "Exchanges/BinanceSimulator/State/StepKernelState.hpp"
 
@@ -58,11 +59,12 @@ void seed_perp_reducible_quantities(
             runtime_state.position_symbol_id_by_position_id[position.id] = idx;
         }
         else {
-            const auto symbol_it = step_state.symbol_to_id.find(position.symbol);
-            if (symbol_it == step_state.symbol_to_id.end()) {
+            const auto symbol_id =
+                State::find_symbol_id(step_state, position.interned_symbol_id, position.symbol);
+            if (!symbol_id.has_value()) {
                 continue;
             }
-            idx = symbol_it->second;
+            idx = *symbol_id;
             runtime_state.position_symbol_id_by_position_id[position.id] = idx;
             runtime_state.position_symbol_id_by_slot[i] = idx;
         }
@@ -345,7 +347,7 @@ bool should_sync_trade_soa_from_payload(
     const State::StepKernelState& step_state,
     const QTrading::Dto::Market::Binance::MultiKlineDto& market) noexcept
 {
-    const size_t payload_symbols = market.trade_klines_by_id.size();
+    const size_t payload_symbols = market.symbol_count();
     if (payload_symbols == 0) {
         return false;
     }
@@ -365,7 +367,7 @@ void sync_trade_soa_from_payload(
     State::StepKernelState& step_state,
     const QTrading::Dto::Market::Binance::MultiKlineDto& market)
 {
-    const size_t payload_symbols = market.trade_klines_by_id.size();
+    const size_t payload_symbols = market.symbol_count();
     step_state.replay_has_trade_kline_by_symbol.assign(payload_symbols, 0);
     step_state.replay_trade_open_by_symbol.assign(payload_symbols, 0.0);
     step_state.replay_trade_high_by_symbol.assign(payload_symbols, 0.0);
@@ -374,17 +376,17 @@ void sync_trade_soa_from_payload(
     step_state.replay_trade_volume_by_symbol.assign(payload_symbols, 0.0);
     step_state.replay_trade_taker_buy_base_volume_by_symbol.assign(payload_symbols, 0.0);
     for (size_t i = 0; i < payload_symbols; ++i) {
-        if (!market.trade_klines_by_id[i].has_value()) {
+        const auto bar = market.trade_bar(i);
+        if (!bar.has_value()) {
             continue;
         }
-        const auto& kline = *market.trade_klines_by_id[i];
         step_state.replay_has_trade_kline_by_symbol[i] = 1;
-        step_state.replay_trade_open_by_symbol[i] = kline.OpenPrice;
-        step_state.replay_trade_high_by_symbol[i] = kline.HighPrice;
-        step_state.replay_trade_low_by_symbol[i] = kline.LowPrice;
-        step_state.replay_trade_close_by_symbol[i] = kline.ClosePrice;
-        step_state.replay_trade_volume_by_symbol[i] = kline.Volume;
-        step_state.replay_trade_taker_buy_base_volume_by_symbol[i] = kline.TakerBuyBaseVolume;
+        step_state.replay_trade_open_by_symbol[i] = bar->open;
+        step_state.replay_trade_high_by_symbol[i] = bar->high;
+        step_state.replay_trade_low_by_symbol[i] = bar->low;
+        step_state.replay_trade_close_by_symbol[i] = bar->close;
+        step_state.replay_trade_volume_by_symbol[i] = bar->volume;
+        step_state.replay_trade_taker_buy_base_volume_by_symbol[i] = bar->taker_buy_base_volume;
     }
 }
 
@@ -434,38 +436,41 @@ void MatchingEngine::RunStep(
     reducible_long_qty.assign(symbol_count, 0.0);
     reducible_short_qty.assign(symbol_count, 0.0);
     seed_perp_reducible_quantities(runtime_state, step_state, reducible_long_qty, reducible_short_qty);
-    for (size_t i = 0; i < symbol_count; ++i) {
-        if (i >= step_state.replay_has_trade_kline_by_symbol.size() ||
-            step_state.replay_has_trade_kline_by_symbol[i] == 0) {
-            continue;
-        }
-        QTrading::Dto::Market::Binance::TradeKlineDto kline{};
-        kline.Timestamp = market.Timestamp;
-        kline.OpenPrice = step_state.replay_trade_open_by_symbol[i];
-        kline.HighPrice = step_state.replay_trade_high_by_symbol[i];
-        kline.LowPrice = step_state.replay_trade_low_by_symbol[i];
-        kline.ClosePrice = step_state.replay_trade_close_by_symbol[i];
-        kline.Volume = step_state.replay_trade_volume_by_symbol[i];
-        kline.TakerBuyBaseVolume = step_state.replay_trade_taker_buy_base_volume_by_symbol[i];
-        const double raw = kline.Volume;
-        const double base_liquidity = raw > 0.0 ? raw : 0.0;
-        const double taker_buy_ratio = resolve_taker_buy_ratio(
-            kline,
-            runtime_state.simulation_config,
-            market.Timestamp,
-            i);
-        taker_buy_ratio_by_symbol[i] = taker_buy_ratio;
-        liquidity_left[i] = base_liquidity;
-        if (opposite_passive_split && std::isfinite(base_liquidity)) {
-            buy_liquidity_left[i] = base_liquidity * taker_buy_ratio;
-            sell_liquidity_left[i] = base_liquidity - buy_liquidity_left[i];
-        }
-        else {
-            buy_liquidity_left[i] = base_liquidity;
-            sell_liquidity_left[i] = base_liquidity;
+    auto* pool = step_state.step_worker_pool.get();
+    Application::for_each_step_shard(pool, symbol_count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (i >= step_state.replay_has_trade_kline_by_symbol.size() ||
+                step_state.replay_has_trade_kline_by_symbol[i] == 0) {
+                continue;
+            }
+            QTrading::Dto::Market::Binance::TradeKlineDto kline{};
+            kline.Timestamp = market.Timestamp;
+            kline.OpenPrice = step_state.replay_trade_open_by_symbol[i];
+            kline.HighPrice = step_state.replay_trade_high_by_symbol[i];
+            kline.LowPrice = step_state.replay_trade_low_by_symbol[i];
+            kline.ClosePrice = step_state.replay_trade_close_by_symbol[i];
+            kline.Volume = step_state.replay_trade_volume_by_symbol[i];
+            kline.TakerBuyBaseVolume = step_state.replay_trade_taker_buy_base_volume_by_symbol[i];
+            const double raw = kline.Volume;
+            const double base_liquidity = raw > 0.0 ? raw : 0.0;
+            const double taker_buy_ratio = resolve_taker_buy_ratio(
+                kline,
+                runtime_state.simulation_config,
+                market.Timestamp,
+                i);
+            taker_buy_ratio_by_symbol[i] = taker_buy_ratio;
+            liquidity_left[i] = base_liquidity;
+            if (opposite_passive_split && std::isfinite(base_liquidity)) {
+                buy_liquidity_left[i] = base_liquidity * taker_buy_ratio;
+                sell_liquidity_left[i] = base_liquidity - buy_liquidity_left[i];
+            }
+            else {
+                buy_liquidity_left[i] = base_liquidity;
+                sell_liquidity_left[i] = base_liquidity;
+            }
+            has_liquidity[i] = 1;
         }
-        has_liquidity[i] = 1;
-    }
+    });
 
     auto& orders = runtime_state.orders;
     auto& order_symbol_ids_by_slot = runtime_state.order_symbol_id_by_slot;
@@ -499,11 +504,12 @@ void MatchingEngine::RunStep(
             runtime_state.order_symbol_id_by_order_id[orders[i].id] = symbol_index;
         }
         else {
-            const auto symbol_it = step_state.symbol_to_id.find(orders[i].symbol);
-            if (symbol_it == step_state.symbol_to_id.end()) {
+            const auto symbol_id =
+                State::find_symbol_id(step_state, orders[i].interned_symbol_id, orders[i].symbol);
+            if (!symbol_id.has_value()) {
                 continue;
             }
-            symbol_index = symbol_it->second;
+            symbol_index = *symbol_id;
             runtime_state.order_symbol_id_by_order_id[orders[i].id] = symbol_index;
             order_symbol_ids_by_slot[i] = symbol_index;
         }
@@ -522,163 +528,181 @@ void MatchingEngine::RunStep(
         insert_order_into_lane(order_lanes[idx], orders, i);
     }
 
-    for (size_t symbol_index = 0; symbol_index < symbol_count; ++symbol_index) {
-        if (symbol_index >= step_state.replay_has_trade_kline_by_symbol.size() ||
-            step_state.replay_has_trade_kline_by_symbol[symbol_index] == 0) {
-            continue;
-        }
-        QTrading::Dto::Market::Binance::TradeKlineDto kline{};
-        kline.Timestamp = market.Timestamp;
-        kline.OpenPrice = step_state.replay_trade_open_by_symbol[symbol_index];
-        kline.HighPrice = step_state.replay_trade_high_by_symbol[symbol_index];
-        kline.LowPrice = step_state.replay_trade_low_by_symbol[symbol_index];
-        kline.ClosePrice = step_state.replay_trade_close_by_symbol[symbol_index];
-        kline.Volume = step_state.replay_trade_volume_by_symbol[symbol_index];
-        kline.TakerBuyBaseVolume = step_state.replay_trade_taker_buy_base_volume_by_symbol[symbol_index];
-        const double taker_buy_ratio = taker_buy_ratio_by_symbol[symbol_index];
-        for (size_t side_lane = 0; side_lane < 2; ++side_lane) {
-            const size_t idx = symbol_index * 2 + side_lane;
-            if (idx >= order_lanes.size()) {
+    // Symbols own disjoint lanes, liquidity and reducible quantities, so shards match
+    // independently into per-order slots; fills are emitted below in the serial order.
+    auto& fill_by_order = step_state.matching_fill_by_order_scratch;
+    auto& has_fill_by_order = step_state.matching_has_fill_by_order_scratch;
+    if (fill_by_order.size() < orders.size()) {
+        fill_by_order.resize(orders.size());
+    }
+    has_fill_by_order.assign(orders.size(), 0);
+    Application::for_each_step_shard(pool, symbol_count, [&](size_t begin, size_t end) {
+        for (size_t symbol_index = begin; symbol_index < end; ++symbol_index) {
+            if (symbol_index >= step_state.replay_has_trade_kline_by_symbol.size() ||
+                step_state.replay_has_trade_kline_by_symbol[symbol_index] == 0) {
                 continue;
             }
-            auto& lane = order_lanes[idx];
-            for (const size_t order_idx : lane) {
-                if (order_idx >= orders.size() ||
-                    order_idx >= remaining_qty.size() ||
-                    order_idx >= has_order_symbol_id.size() ||
-                    order_idx >= order_symbol_ids.size() ||
-                    has_order_symbol_id[order_idx] == 0 ||
-                    order_symbol_ids[order_idx] != symbol_index ||
-                    remaining_qty[order_idx] <= kEpsilon) {
+            QTrading::Dto::Market::Binance::TradeKlineDto kline{};
+            kline.Timestamp = market.Timestamp;
+            kline.OpenPrice = step_state.replay_trade_open_by_symbol[symbol_index];
+            kline.HighPrice = step_state.replay_trade_high_by_symbol[symbol_index];
+            kline.LowPrice = step_state.replay_trade_low_by_symbol[symbol_index];
+            kline.ClosePrice = step_state.replay_trade_close_by_symbol[symbol_index];
+            kline.Volume = step_state.replay_trade_volume_by_symbol[symbol_index];
+            kline.TakerBuyBaseVolume = step_state.replay_trade_taker_buy_base_volume_by_symbol[symbol_index];
+            const double taker_buy_ratio = taker_buy_ratio_by_symbol[symbol_index];
+            for (size_t side_lane = 0; side_lane < 2; ++side_lane) {
+                const size_t idx = symbol_index * 2 + side_lane;
+                if (idx >= order_lanes.size()) {
                     continue;
                 }
-                const auto& order = orders[order_idx];
-                if (is_one_step_limit_tif(order.time_in_force) &&
-                    !is_first_matching_step(order, step_state)) {
-                    continue;
-                }
-                if (!is_marketable(order, kline)) {
-                    continue;
-                }
-                if (liquidity_left[symbol_index] <= kEpsilon) {
-                    continue;
-                }
-
-                const double fill_price = compute_fill_price(order, kline);
-                const bool is_taker = order.price <= 0.0 ||
-                    (open_marketability_path
-                        ? is_marketable_at_open(order, kline)
-                        : (order.side == QTrading::Dto::Trading::OrderSide::Buy
-                            ? kline.ClosePrice <= order.price + kEpsilon
-                            : kline.ClosePrice + kEpsilon >= order.price));
-                const double request_qty = remaining_qty[order_idx];
-                double available_liquidity = liquidity_left[symbol_index];
-                if (opposite_passive_split) {
-                    if (order.side == QTrading::Dto::Trading::OrderSide::Buy) {
-                        available_liquidity = sell_liquidity_left[symbol_index];
-                    }
-                    else {
-                        available_liquidity = buy_liquidity_left[symbol_index];
-                    }
-                }
-                double max_fill_qty = std::min(request_qty, available_liquidity);
-                if (order.instrument_type == QTrading::Dto::Trading::InstrumentType::Perp && order.reduce_only) {
-                    double reducible_qty = 0.0;
-                    if (order.side == QTrading::Dto::Trading::OrderSide::Sell) {
-                        reducible_qty = reducible_long_qty[symbol_index];
+                auto& lane = order_lanes[idx];
+                for (const size_t order_idx : lane) {
+                    if (order_idx >= orders.size() ||
+                        order_idx >= remaining_qty.size() ||
+                        order_idx >= has_order_symbol_id.size() ||
+                        order_idx >= order_symbol_ids.size() ||
+                        has_order_symbol_id[order_idx] == 0 ||
+                        order_symbol_ids[order_idx] != symbol_index ||
+                        remaining_qty[order_idx] <= kEpsilon) {
+                        continue;
                     }
-                    else {
-                        reducible_qty = reducible_short_qty[symbol_index];
+                    const auto& order = orders[order_idx];
+                    if (is_one_step_limit_tif(order.time_in_force) &&
+                        !is_first_matching_step(order, step_state)) {
+                        continue;
                     }
-                    if (reducible_qty <= kEpsilon) {
+                    if (!is_marketable(order, kline)) {
                         continue;
                     }
-                    max_fill_qty = std::min(max_fill_qty, reducible_qty);
-                }
-                const double fill_probability = compute_limit_fill_probability(
-                    order,
-                    kline,
-                    runtime_state.simulation_config,
-                    std::max(available_liquidity, kEpsilon),
-                    taker_buy_ratio);
-                if (order.time_in_force == QTrading::Dto::Trading::TimeInForce::FOK &&
-                    is_first_matching_step(order, step_state)) {
-                    if (max_fill_qty + kEpsilon < request_qty ||
-                        fill_probability + 1e-6 < 1.0) {
+                    if (liquidity_left[symbol_index] <= kEpsilon) {
                         continue;
                     }
-                }
-                const double fill_qty = max_fill_qty * fill_probability;
-                if (fill_qty <= kEpsilon) {
-                    continue;
-                }
 
-                double fill_taker_probability = compute_taker_probability(
-                    order,
-                    kline,
-                    runtime_state.simulation_config,
-                    std::max(available_liquidity, kEpsilon),
-                    taker_buy_ratio);
-                if (!runtime_state.simulation_config.taker_probability_model_enabled) {
-                    fill_taker_probability = is_taker ? 1.0 : 0.0;
-                }
-                const bool resolved_taker = runtime_state.simulation_config.taker_probability_model_enabled
-                    ? (fill_taker_probability > 0.0)
-                    : is_taker;
-                double impact_bps = 0.0;
-                double adjusted_fill_price = apply_execution_slippage(
-                    order,
-                    kline,
-                    runtime_state.simulation_config,
-                    fill_price);
-                adjusted_fill_price = apply_market_impact_slippage(
-                    order,
-                    kline,
-                    runtime_state.simulation_config,
-                    fill_qty,
-                    std::max(available_liquidity, kEpsilon),
-                    adjusted_fill_price,
-                    impact_bps);
-
-                MatchFill fill{};
-                fill.order_id = order.id;
-                fill.symbol_id = symbol_index;
-                fill.symbol = order.symbol;
-                fill.instrument_type = order.instrument_type;
-                fill.side = order.side;
-                fill.position_side = order.position_side;
-                fill.reduce_only = order.reduce_only;
-                fill.close_position = order.close_position;
-                fill.is_taker = resolved_taker;
-                fill.fill_probability = fill_probability;
-                fill.taker_probability = fill_taker_probability;
-                fill.impact_slippage_bps = impact_bps;
-                fill.quote_order_qty = order.quote_order_qty;
-                fill.order_price = order.price;
-                fill.closing_position_id = order.closing_position_id;
-                fill.order_quantity = request_qty;
-                fill.quantity = fill_qty;
-                fill.price = adjusted_fill_price;
-                out_fills.emplace_back(std::move(fill));
-
-                liquidity_left[symbol_index] -= fill_qty;
-                if (opposite_passive_split) {
-                    if (order.side == QTrading::Dto::Trading::OrderSide::Buy) {
-                        sell_liquidity_left[symbol_index] = std::max(0.0, sell_liquidity_left[symbol_index] - fill_qty);
+                    const double fill_price = compute_fill_price(order, kline);
+                    const bool is_taker = order.price <= 0.0 ||
+                        (open_marketability_path
+                            ? is_marketable_at_open(order, kline)
+                            : (order.side == QTrading::Dto::Trading::OrderSide::Buy
+                                ? kline.ClosePrice <= order.price + kEpsilon
+                                : kline.ClosePrice + kEpsilon >= order.price));
+                    const double request_qty = remaining_qty[order_idx];
+                    double available_liquidity = liquidity_left[symbol_index];
+                    if (opposite_passive_split) {
+                        if (order.side == QTrading::Dto::Trading::OrderSide::Buy) {
+                            available_liquidity = sell_liquidity_left[symbol_index];
+                        }
+                        else {
+                            available_liquidity = buy_liquidity_left[symbol_index];
+                        }
                     }
-                    else {
-                        buy_liquidity_left[symbol_index] = std::max(0.0, buy_liquidity_left[symbol_index] - fill_qty);
+                    double max_fill_qty = std::min(request_qty, available_liquidity);
+                    if (order.instrument_type == QTrading::Dto::Trading::InstrumentType::Perp && order.reduce_only) {
+                        double reducible_qty = 0.0;
+                        if (order.side == QTrading::Dto::Trading::OrderSide::Sell) {
+                            reducible_qty = reducible_long_qty[symbol_index];
+                        }
+                        else {
+                            reducible_qty = reducible_short_qty[symbol_index];
+                        }
+                        if (reducible_qty <= kEpsilon) {
+                            continue;
+                        }
+                        max_fill_qty = std::min(max_fill_qty, reducible_qty);
                     }
-                }
-                if (order.instrument_type == QTrading::Dto::Trading::InstrumentType::Perp && order.reduce_only) {
-                    if (order.side == QTrading::Dto::Trading::OrderSide::Sell) {
-                        reducible_long_qty[symbol_index] = std::max(0.0, reducible_long_qty[symbol_index] - fill_qty);
+                    const double fill_probability = compute_limit_fill_probability(
+                        order,
+                        kline,
+                        runtime_state.simulation_config,
+                        std::max(available_liquidity, kEpsilon),
+                        taker_buy_ratio);
+                    if (order.time_in_force == QTrading::Dto::Trading::TimeInForce::FOK &&
+                        is_first_matching_step(order, step_state)) {
+                        if (max_fill_qty + kEpsilon < request_qty ||
+                            fill_probability + 1e-6 < 1.0) {
+                            continue;
+                        }
                     }
-                    else {
-                        reducible_short_qty[symbol_index] = std::max(0.0, reducible_short_qty[symbol_index] - fill_qty);
+                    const double fill_qty = max_fill_qty * fill_probability;
+                    if (fill_qty <= kEpsilon) {
+                        continue;
+                    }
+
+                    double fill_taker_probability = compute_taker_probability(
+                        order,
+                        kline,
+                        runtime_state.simulation_config,
+                        std::max(available_liquidity, kEpsilon),
+                        taker_buy_ratio);
+                    if (!runtime_state.simulation_config.taker_probability_model_enabled) {
+                        fill_taker_probability = is_taker ? 1.0 : 0.0;
                     }
+                    const bool resolved_taker = runtime_state.simulation_config.taker_probability_model_enabled
+                        ? (fill_taker_probability > 0.0)
+                        : is_taker;
+                    double impact_bps = 0.0;
+                    double adjusted_fill_price = apply_execution_slippage(
+                        order,
+                        kline,
+                        runtime_state.simulation_config,
+                        fill_price);
+                    adjusted_fill_price = apply_market_impact_slippage(
+                        order,
+                        kline,
+                        runtime_state.simulation_config,
+                        fill_qty,
+                        std::max(available_liquidity, kEpsilon),
+                        adjusted_fill_price,
+                        impact_bps);
+
+                    MatchFill fill{};
+                    fill.order_id = order.id;
+                    fill.symbol_id = symbol_index;
+                    fill.interned_symbol_id = order.interned_symbol_id;
+                    fill.instrument_type = order.instrument_type;
+                    fill.side = order.side;
+                    fill.position_side = order.position_side;
+                    fill.reduce_only = order.reduce_only;
+                    fill.close_position = order.close_position;
+                    fill.is_taker = resolved_taker;
+                    fill.fill_probability = fill_probability;
+                    fill.taker_probability = fill_taker_probability;
+                    fill.impact_slippage_bps = impact_bps;
+                    fill.quote_order_qty = order.quote_order_qty;
+                    fill.order_price = order.price;
+                    fill.closing_position_id = order.closing_position_id;
+                    fill.order_quantity = request_qty;
+                    fill.quantity = fill_qty;
+                    fill.price = adjusted_fill_price;
+                    fill_by_order[order_idx] = std::move(fill);
+                    has_fill_by_order[order_idx] = 1;
+
+                    liquidity_left[symbol_index] -= fill_qty;
+                    if (opposite_passive_split) {
+                        if (order.side == QTrading::Dto::Trading::OrderSide::Buy) {
+                            sell_liquidity_left[symbol_index] = std::max(0.0, sell_liquidity_left[symbol_index] - fill_qty);
+                        }
+                        else {
+                            buy_liquidity_left[symbol_index] = std::max(0.0, buy_liquidity_left[symbol_index] - fill_qty);
+                        }
+                    }
+                    if (order.instrument_type == QTrading::Dto::Trading::InstrumentType::Perp && order.reduce_only) {
+                        if (order.side == QTrading::Dto::Trading::OrderSide::Sell) {
+                            reducible_long_qty[symbol_index] = std::max(0.0, reducible_long_qty[symbol_index] - fill_qty);
+                        }
+                        else {
+                            reducible_short_qty[symbol_index] = std::max(0.0, reducible_short_qty[symbol_index] - fill_qty);
+                        }
+                    }
+                    remaining_qty[order_idx] = request_qty - fill_qty;
                 }
-                remaining_qty[order_idx] = request_qty - fill_qty;
+            }
+        }
+    });
+    for (const auto& lane : order_lanes) {
+        for (const size_t order_idx : lane) {
+            if (order_idx < has_fill_by_order.size() && has_fill_by_order[order_idx] != 0) {
+                out_fills.emplace_back(std::move(fill_by_order[order_idx]));
             }
         }
     }
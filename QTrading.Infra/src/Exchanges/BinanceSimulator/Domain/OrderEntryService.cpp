@@ -256,15 +256,18 @@ double current_reference_price(
         return 0.0;
     }
 
-    const size_t cursor = symbol_index < step_state.replay_cursor.size()
-        ? step_state.replay_cursor[symbol_index]
+    const auto& replay_cursor = step_state.replay_prefetch_pending
+        ? step_state.committed_replay_cursor
+        : step_state.replay_cursor;
+    const size_t cursor = symbol_index < replay_cursor.size()
+        ? replay_cursor[symbol_index]
         : 0;
     if (cursor == 0) {
-        return market_data.get_kline(0).OpenPrice;
+        return market_data.open_prices()[0];
     }
 
     const size_t idx = std::min(cursor - 1, count - 1);
-    return market_data.get_kline(idx).ClosePrice;
+    return market_data.close_prices()[idx];
 }
 
 double current_mark_price(
@@ -272,9 +275,12 @@ double current_mark_price(
     const std::string& symbol)
 {
     const size_t symbol_index = find_symbol_index(step_state, symbol);
+    const auto& mark_cursors = step_state.replay_prefetch_pending
+        ? step_state.committed_mark_cursor_by_symbol
+        : step_state.mark_cursor_by_symbol;
     if (symbol_index == std::numeric_limits<size_t>::max() ||
         symbol_index >= step_state.mark_data_id_by_symbol.size() ||
-        symbol_index >= step_state.mark_cursor_by_symbol.size()) {
+        symbol_index >= mark_cursors.size()) {
         return 0.0;
     }
 
@@ -290,13 +296,13 @@ double current_mark_price(
         return 0.0;
     }
 
-    const size_t cursor = step_state.mark_cursor_by_symbol[symbol_index];
+    const size_t cursor = mark_cursors[symbol_index];
     if (cursor == 0) {
-        return mark_data.get_kline(0).OpenPrice;
+        return mark_data.opening_price();
     }
 
     const size_t idx = std::min(cursor - 1, count - 1);
-    return mark_data.get_kline(idx).ClosePrice;
+    return mark_data.close_prices()[idx];
 }
 
 double current_index_price(
@@ -304,9 +310,12 @@ double current_index_price(
     const std::string& symbol)
 {
     const size_t symbol_index = find_symbol_index(step_state, symbol);
+    const auto& index_cursors = step_state.replay_prefetch_pending
+        ? step_state.committed_index_cursor_by_symbol
+        : step_state.index_cursor_by_symbol;
     if (symbol_index == std::numeric_limits<size_t>::max() ||
         symbol_index >= step_state.index_data_id_by_symbol.size() ||
-        symbol_index >= step_state.index_cursor_by_symbol.size()) {
+        symbol_index >= index_cursors.size()) {
         return 0.0;
     }
 
@@ -322,13 +331,13 @@ double current_index_price(
         return 0.0;
     }
 
-    const size_t cursor = step_state.index_cursor_by_symbol[symbol_index];
+    const size_t cursor = index_cursors[symbol_index];
     if (cursor == 0) {
-        return index_data.get_kline(0).OpenPrice;
+        return index_data.opening_price();
     }
 
     const size_t idx = std::min(cursor - 1, count - 1);
-    return index_data.get_kline(idx).ClosePrice;
+    return index_data.close_prices()[idx];
 }
 
 double sum_spot_inventory(
@@ -1335,6 +1344,7 @@ bool OrderEntryService::Execute(
     QTrading::dto::Order order{};
     order.id = static_cast<int>(runtime_state.next_order_id++);
     order.symbol = request.symbol;
+    order.interned_symbol_id = QTrading::Dto::Trading::SymbolTable::Intern(request.symbol);
     order.quantity = quantity;
     order.price = request.price;
     order.side = request.side;
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Dto/Trading/Side.hpp"
+#include "Exchanges/BinanceSimulator/Application/BatchReplayRunner.hpp"
+#include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
+#include "ReplayCsvFixture.hpp"
+
+using QTrading::Dto::Trading::OrderSide;
+using QTrading::Infra::Exchanges::BinanceSim::BinanceExchange;
+using QTrading::Infra::Exchanges::BinanceSim::Application::BatchReplayRunner;
+using QTrading::Infra::Exchanges::BinanceSim::Contracts::SymbolDataset;
+
+namespace {
+
+constexpr size_t kRows = 300;
+
+struct RunOutcome {
+    uint64_t steps{ 0 };
+    double wallet_balance{ 0.0 };
+    double total_unrealized_pnl{ 0.0 };
+    size_t open_positions{ 0 };
+};
+
+// Scripted run: one long whose size depends on the run index, then replay to the end.
+RunOutcome drive(BinanceExchange& exchange, size_t run_index)
+{
+    RunOutcome out{};
+    while (exchange.step()) {
+        if (out.steps == 0) {
+            (void)exchange.perp.place_order("BTCUSDT", 0.1 * static_cast<double>(run_index + 1), OrderSide::Buy);
+        }
+        ++out.steps;
+    }
+    BinanceExchange::StatusSnapshot snapshot{};
+    exchange.FillStatusSnapshot(snapshot);
+    out.wallet_balance = snapshot.wallet_balance;
+    out.total_unrealized_pnl = snapshot.total_unrealized_pnl;
+    out.open_positions = exchange.get_all_positions().size();
+    return out;
+}
+
+} // namespace
+
+class BatchReplayRunnerTests : public ReplayCsvFixture {
+protected:
+    BatchReplayRunnerTests() : ReplayCsvFixture("batch", kRows) {}
+
+    void SetUp() override {
+        datasets.resize(2);
+        datasets[0].symbol = "BTCUSDT";
+        datasets[0].kline_csv = write_klines("btc.csv", 100.0);
+        datasets[0].funding_csv = write_funding("btc_funding.csv");
+        datasets[1].symbol = "ETHUSDT";
+        datasets[1].kline_csv = write_klines("eth.csv", 10.0);
+    }
+};
+
+/// @brief Concurrent runs over the shared data match standalone exchanges that load their own files.
+TEST_F(BatchReplayRunnerTests, ConcurrentRunsMatchStandaloneReplays)
+{
+    constexpr size_t kRuns = 6;
+    std::vector<RunOutcome> standalone(kRuns);
+    for (size_t i = 0; i < kRuns; ++i) {
+        BinanceExchange exchange(datasets, nullptr, make_account_init());
+        standalone[i] = drive(exchange, i);
+    }
+
+    const BatchReplayRunner runner(datasets);
+    std::vector<RunOutcome> batched(kRuns);
+    const auto results = runner.run(kRuns, [&](size_t run_index, const BatchReplayRunner& batch) {
+        auto exchange = batch.make_exchange(nullptr, make_account_init());
+        batched[run_index] = drive(*exchange, run_index);
+        return batched[run_index].steps;
+    }, 3);
+
+    ASSERT_EQ(results.size(), kRuns);
+    for (size_t i = 0; i < kRuns; ++i) {
+        EXPECT_FALSE(results[i].error) << "run " << i;
+        EXPECT_EQ(results[i].steps, kRows);
+        EXPECT_EQ(batched[i].steps, standalone[i].steps);
+        EXPECT_EQ(batched[i].wallet_balance, standalone[i].wallet_balance) << "run " << i;
+        EXPECT_EQ(batched[i].total_unrealized_pnl, standalone[i].total_unrealized_pnl) << "run " << i;
+        EXPECT_EQ(batched[i].open_positions, 1u);
+    }
+    // Different sizes must not leak between runs.
+    EXPECT_NE(batched[0].total_unrealized_pnl, batched[1].total_unrealized_pnl);
+}
+
+/// @brief A throwing run is reported in its own slot; the others still complete.
+TEST_F(BatchReplayRunnerTests, FailingRunIsIsolated)
+{
+    const BatchReplayRunner runner(datasets);
+    const auto results = runner.run(3, [](size_t run_index, const BatchReplayRunner& batch) -> uint64_t {
+        auto exchange = batch.make_exchange(nullptr, make_account_init());
+        if (run_index == 1) {
+            throw std::runtime_error("bad config");
+        }
+        return drive(*exchange, run_index).steps;
+    }, 2);
+
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_FALSE(results[0].error);
+    EXPECT_TRUE(results[1].error);
+    EXPECT_FALSE(results[2].error);
+    EXPECT_EQ(results[2].steps, kRows);
+}
+
+/// @brief Shared data must describe the same symbol list as the exchange.
+TEST_F(BatchReplayRunnerTests, MismatchedSharedDataIsRejected)
+{
+    const BatchReplayRunner runner(datasets);
+    std::vector<SymbolDataset> fewer(datasets.begin(), datasets.begin() + 1);
+    EXPECT_THROW(BinanceExchange(fewer, runner.shared_data(), nullptr, make_account_init()), std::invalid_argument);
+    EXPECT_THROW(BinanceExchange(datasets, nullptr, nullptr, make_account_init()), std::invalid_argument);
+}
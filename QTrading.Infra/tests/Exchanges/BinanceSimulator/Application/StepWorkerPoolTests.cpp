@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Exchanges/BinanceSimulator/Application/StepWorkerPool.hpp"
+
+using QTrading::Infra::Exchanges::BinanceSim::Application::StepWorkerPool;
+
+/// @brief Every index is visited exactly once, in contiguous shards no smaller than the grain.
+TEST(StepWorkerPoolTests, ShardsCoverRangeOnce)
+{
+    StepWorkerPool pool(4);
+    EXPECT_EQ(pool.concurrency(), 4u);
+    for (const size_t count : { size_t{ 0 }, size_t{ 1 }, size_t{ 31 }, size_t{ 65 }, size_t{ 240 }, size_t{ 1001 } }) {
+        std::vector<uint32_t> hits(count, 0);
+        std::atomic<size_t> calls{ 0 };
+        pool.parallel_for(count, 32, [&](size_t begin, size_t end) {
+            EXPECT_LT(begin, end);
+            ++calls;
+            for (size_t i = begin; i < end; ++i) {
+                ++hits[i];
+            }
+        });
+        EXPECT_EQ(hits, std::vector<uint32_t>(count, 1)) << "count=" << count;
+        EXPECT_LE(calls.load(), count < 64 ? 1u : 4u) << "count=" << count;
+    }
+}
+
+/// @brief A throwing shard surfaces on the caller after the other shards finished; the pool stays usable.
+TEST(StepWorkerPoolTests, ShardExceptionIsRethrown)
+{
+    StepWorkerPool pool(3);
+    std::atomic<size_t> visited{ 0 };
+    EXPECT_THROW(pool.parallel_for(300, 1, [&](size_t begin, size_t end) {
+        visited += end - begin;
+        if (begin != 0) {
+            throw std::runtime_error("shard");
+        }
+    }), std::runtime_error);
+    EXPECT_EQ(visited.load(), 300u);
+
+    visited = 0;
+    pool.parallel_for(300, 1, [&](size_t begin, size_t end) { visited += end - begin; });
+    EXPECT_EQ(visited.load(), 300u);
+}
+
+/// @brief A single-thread pool runs the whole range inline.
+TEST(StepWorkerPoolTests, SingleThreadRunsInline)
+{
+    StepWorkerPool pool(0);
+    EXPECT_EQ(pool.concurrency(), 1u);
+    std::vector<std::pair<size_t, size_t>> shards;
+    pool.parallel_for(500, 1, [&](size_t begin, size_t end) { shards.emplace_back(begin, end); });
+    ASSERT_EQ(shards.size(), 1u);
+    EXPECT_EQ(shards.front(), std::make_pair(size_t{ 0 }, size_t{ 500 }));
+}
+
+namespace {
+
+/// Shard body that cannot be copied, so it only compiles if the pool forwards it by reference.
+struct CountingShard {
+    std::vector<std::atomic<uint32_t>>& hits;
+
+    CountingShard(std::vector<std::atomic<uint32_t>>& h) : hits(h) {}
+    CountingShard(const CountingShard&) = delete;
+    CountingShard& operator=(const CountingShard&) = delete;
+
+    void operator()(size_t begin, size_t end) const
+    {
+        for (size_t i = begin; i < end; ++i) {
+            ++hits[i];
+        }
+    }
+};
+
+} // namespace
+
+/// @brief Callables are invoked in place rather than copied into a type-erased wrapper.
+TEST(StepWorkerPoolTests, NonCopyableCallableRunsInPlace)
+{
+    StepWorkerPool pool(4);
+    std::vector<std::atomic<uint32_t>> hits(200);
+    const CountingShard shard(hits);
+    pool.parallel_for(hits.size(), 16, shard);
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1u);
+    }
+}
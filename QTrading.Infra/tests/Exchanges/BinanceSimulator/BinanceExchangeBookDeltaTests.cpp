@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "Dto/Trading/Side.hpp"
+#include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
+#include "Exchanges/BookReplica.hpp"
+#include "ReplayCsvFixture.hpp"
+
+using QTrading::Dto::Trading::OrderSide;
+using QTrading::dto::Order;
+using QTrading::dto::OrderBookDelta;
+using QTrading::dto::Position;
+using QTrading::Infra::Exchanges::BinanceSim::BinanceExchange;
+using QTrading::Infra::Exchanges::BinanceSim::Config::BookChannelMode;
+using QTrading::Infra::Exchanges::OrderBookReplica;
+using QTrading::Infra::Exchanges::PositionBookReplica;
+
+namespace {
+
+constexpr size_t kRows = 120;
+
+Order make_order(int id, double quantity)
+{
+    Order order{};
+    order.id = id;
+    order.symbol = "BTCUSDT";
+    order.quantity = quantity;
+    order.price = 100.0;
+    return order;
+}
+
+// Opens and closes positions and rests limit orders far from the market.
+void run_script(BinanceExchange& exchange, uint64_t ts)
+{
+    switch (ts / kMinute) {
+    case 2:
+        (void)exchange.perp.place_order("BTCUSDT", 0.5, OrderSide::Buy);
+        (void)exchange.perp.place_order("ETHUSDT", 1.0, 1.0, OrderSide::Buy);
+        (void)exchange.perp.place_order("ETHUSDT", 2.0, 2.0, OrderSide::Buy);
+        break;
+    case 10:
+        (void)exchange.perp.place_order("ETHUSDT", 3.0, OrderSide::Sell);
+        break;
+    case 30:
+        (void)exchange.perp.place_order("BTCUSDT", 0.25, OrderSide::Sell);
+        exchange.perp.cancel_open_orders("ETHUSDT");
+        break;
+    case 60:
+        (void)exchange.perp.place_order("BTCUSDT", 0.25, OrderSide::Sell);
+        break;
+    default:
+        break;
+    }
+}
+
+template <typename T>
+std::vector<T> sorted_by_id(std::vector<T> entries)
+{
+    std::sort(entries.begin(), entries.end(), [](const T& a, const T& b) { return a.id < b.id; });
+    return entries;
+}
+
+// Fields that change only with the position-book version; marks refresh in place between publishes.
+std::vector<std::tuple<int, double, double, bool>> position_keys(const std::vector<Position>& positions)
+{
+    std::vector<std::tuple<int, double, double, bool>> keys;
+    for (const auto& position : positions) {
+        keys.emplace_back(position.id, position.quantity, position.entry_price, position.is_long);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+// Applies every queued delta to `book`; returns false on a sequence gap.
+template <typename Book, typename ChannelPtr>
+bool drain_deltas(Book& book, const ChannelPtr& channel)
+{
+    while (auto delta = channel->TryReceive()) {
+        if (!book.apply(std::move(*delta))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+/// @brief A diff applied to a replica reproduces the target book and copies only changed entries.
+TEST(BookReplicaTests, DiffApplyRoundTripCopiesOnlyChangedEntries)
+{
+    OrderBookReplica publisher;
+    OrderBookReplica consumer;
+    const std::vector<Order> first{ make_order(1, 1.0), make_order(2, 2.0), make_order(3, 3.0) };
+
+    auto delta = publisher.diff(first);
+    EXPECT_EQ(delta.seq, 1u);
+    EXPECT_EQ(delta.added.size(), 3u);
+    ASSERT_TRUE(publisher.apply(delta));
+    ASSERT_TRUE(consumer.apply(std::move(delta)));
+    EXPECT_TRUE(publisher.diff(first).empty());
+
+    const std::vector<Order> second{ make_order(1, 1.0), make_order(3, 2.5), make_order(4, 4.0) };
+    delta = publisher.diff(second);
+    EXPECT_EQ(delta.seq, 2u);
+    ASSERT_EQ(delta.added.size(), 1u);
+    EXPECT_EQ(delta.added[0].id, 4);
+    ASSERT_EQ(delta.updated.size(), 1u);
+    EXPECT_EQ(delta.updated[0].id, 3);
+    EXPECT_EQ(delta.removed_ids, std::vector<int>{ 2 });
+    ASSERT_TRUE(publisher.apply(delta));
+    ASSERT_TRUE(consumer.apply(delta));
+
+    EXPECT_EQ(consumer.entries(), second);
+    EXPECT_EQ(consumer.seq(), 2u);
+    ASSERT_NE(consumer.find(3), nullptr);
+    EXPECT_EQ(consumer.find(3)->quantity, 2.5);
+    EXPECT_EQ(consumer.find(2), nullptr);
+}
+
+/// @brief Out-of-sequence deltas are rejected without touching the book.
+TEST(BookReplicaTests, RejectsSequenceGapsAndReplays)
+{
+    OrderBookReplica book;
+    OrderBookDelta delta{};
+    delta.seq = 2;
+    delta.added.push_back(make_order(1, 1.0));
+    EXPECT_FALSE(book.apply(delta));
+    EXPECT_TRUE(book.empty());
+
+    delta.seq = 1;
+    EXPECT_TRUE(book.apply(delta));
+    EXPECT_FALSE(book.apply(delta));
+    EXPECT_EQ(book.size(), 1u);
+    EXPECT_EQ(book.seq(), 1u);
+}
+
+class BinanceExchangeBookDeltaTests : public ReplayCsvFixture {
+protected:
+    BinanceExchangeBookDeltaTests() : ReplayCsvFixture("book_delta", kRows) {}
+
+    void SetUp() override {
+        datasets.resize(2);
+        datasets[0].symbol = "BTCUSDT";
+        datasets[0].kline_csv = write_klines("btc.csv", 100.0);
+        datasets[1].symbol = "ETHUSDT";
+        datasets[1].kline_csv = write_klines("eth.csv", 10.0);
+    }
+};
+
+/// @brief Replicas fed from the delta channels track the live books after every step.
+TEST_F(BinanceExchangeBookDeltaTests, DeltaChannelsRebuildLiveBooks)
+{
+    BinanceExchange exchange(datasets, nullptr, make_account_init());
+    auto cfg = exchange.simulation_config();
+    cfg.book_channel_mode = BookChannelMode::Delta;
+    exchange.apply_simulation_config(cfg);
+
+    PositionBookReplica positions;
+    OrderBookReplica orders;
+    size_t steps_with_positions = 0;
+    while (exchange.step()) {
+        ASSERT_TRUE(drain_deltas(positions, exchange.get_position_delta_channel()));
+        ASSERT_TRUE(drain_deltas(orders, exchange.get_order_delta_channel()));
+        EXPECT_EQ(position_keys(positions.entries()), position_keys(exchange.get_all_positions()));
+        EXPECT_EQ(sorted_by_id(orders.entries()), sorted_by_id(exchange.get_all_open_orders()));
+        steps_with_positions += positions.empty() ? 0 : 1;
+
+        auto dto = exchange.get_market_channel()->TryReceive();
+        ASSERT_TRUE(dto.has_value() && dto.value());
+        run_script(exchange, dto.value()->Timestamp);
+    }
+    EXPECT_GT(steps_with_positions, 0u);
+    EXPECT_GT(positions.seq(), 1u);
+    EXPECT_GT(orders.seq(), 1u);
+    // Delta mode publishes no full copies.
+    EXPECT_FALSE(exchange.get_position_channel()->TryReceive().has_value());
+    EXPECT_FALSE(exchange.get_order_channel()->TryReceive().has_value());
+    EXPECT_TRUE(exchange.get_position_delta_channel()->IsClosed());
+    EXPECT_TRUE(exchange.get_order_delta_channel()->IsClosed());
+}
+
+/// @brief In Both mode every full copy matches the replica rebuilt from the deltas sent with it.
+TEST_F(BinanceExchangeBookDeltaTests, BothModeDeltasMatchFullSnapshots)
+{
+    BinanceExchange exchange(datasets, nullptr, make_account_init());
+    auto cfg = exchange.simulation_config();
+    cfg.book_channel_mode = BookChannelMode::Both;
+    exchange.apply_simulation_config(cfg);
+
+    PositionBookReplica positions;
+    OrderBookReplica orders;
+    size_t full_order_books = 0;
+    while (exchange.step()) {
+        ASSERT_TRUE(drain_deltas(positions, exchange.get_position_delta_channel()));
+        ASSERT_TRUE(drain_deltas(orders, exchange.get_order_delta_channel()));
+        std::optional<std::vector<Position>> last_positions;
+        while (auto full = exchange.get_position_channel()->TryReceive()) {
+            last_positions = std::move(full);
+        }
+        std::optional<std::vector<Order>> last_orders;
+        while (auto full = exchange.get_order_channel()->TryReceive()) {
+            last_orders = std::move(full);
+            ++full_order_books;
+        }
+        if (last_positions) {
+            EXPECT_EQ(sorted_by_id(positions.entries()), sorted_by_id(*last_positions));
+        }
+        if (last_orders) {
+            EXPECT_EQ(sorted_by_id(orders.entries()), sorted_by_id(*last_orders));
+        }
+
+        auto dto = exchange.get_market_channel()->TryReceive();
+        ASSERT_TRUE(dto.has_value() && dto.value());
+        run_script(exchange, dto.value()->Timestamp);
+    }
+    EXPECT_GT(full_order_books, 0u);
+}
+
+/// @brief A fork's fresh delta channels start from an empty book and receive the whole book.
+TEST_F(BinanceExchangeBookDeltaTests, ForkDeltaChannelsStartFromFullBook)
+{
+    BinanceExchange exchange(datasets, nullptr, make_account_init());
+    auto cfg = exchange.simulation_config();
+    cfg.book_channel_mode = BookChannelMode::Delta;
+    exchange.apply_simulation_config(cfg);
+    for (int i = 0; i < 5 && exchange.step(); ++i) {
+        auto dto = exchange.get_market_channel()->TryReceive();
+        ASSERT_TRUE(dto.has_value() && dto.value());
+        run_script(exchange, dto.value()->Timestamp);
+    }
+    ASSERT_TRUE(exchange.step());
+    ASSERT_FALSE(exchange.get_all_positions().empty());
+    ASSERT_FALSE(exchange.get_all_open_orders().empty());
+
+    auto fork = exchange.fork();
+    ASSERT_TRUE(fork->step());
+    PositionBookReplica positions;
+    OrderBookReplica orders;
+    ASSERT_TRUE(drain_deltas(positions, fork->get_position_delta_channel()));
+    ASSERT_TRUE(drain_deltas(orders, fork->get_order_delta_channel()));
+    EXPECT_EQ(position_keys(positions.entries()), position_keys(fork->get_all_positions()));
+    EXPECT_EQ(sorted_by_id(orders.entries()), sorted_by_id(fork->get_all_open_orders()));
+}
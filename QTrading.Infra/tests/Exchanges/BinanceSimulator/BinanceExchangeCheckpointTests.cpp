@@ -0,0 +1,296 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "InfraLogTestFixture.hpp"
+#include "Dto/AccountLog.hpp"
+#include "Dto/Trading/Side.hpp"
+#include "Dto/Trading/SymbolId.hpp"
+#include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
+#include "Exchanges/BookReplica.hpp"
+
+namespace {
+
+using QTrading::Dto::Trading::OrderSide;
+using QTrading::Dto::Trading::SymbolTable;
+using QTrading::Infra::Exchanges::BinanceSim::Account;
+using QTrading::Infra::Exchanges::BinanceSim::BinanceExchange;
+using QTrading::Infra::Exchanges::BinanceSim::Config::BookChannelMode;
+using QTrading::Infra::Exchanges::OrderBookReplica;
+using QTrading::Infra::Exchanges::PositionBookReplica;
+
+constexpr uint64_t kMinute = 60'000;
+constexpr size_t kRows = 240;
+constexpr uint64_t kCheckpointStep = 131;
+
+Account::AccountInitConfig MakeAccountInit()
+{
+    Account::AccountInitConfig cfg{};
+    cfg.init_balance = 100'000.0;
+    cfg.spot_initial_cash = 100'000.0;
+    cfg.perp_initial_wallet = 100'000.0;
+    return cfg;
+}
+
+// Strategy stand-in keyed by the replay step index; runs after each successful step.
+void RunScript(BinanceExchange& exchange, uint64_t step_index)
+{
+    switch (step_index) {
+    case 0:
+        exchange.perp.set_symbol_leverage("BTCUSDT", 5.0);
+        (void)exchange.perp.place_order("BTCUSDT", 0.5, OrderSide::Buy);
+        break;
+    case 10:
+        (void)exchange.perp.place_order("ETHUSDT", 1.0, 10.6, OrderSide::Buy);
+        break;
+    case 130:
+        // Rests across the checkpoint and fills at the next ETH trough.
+        (void)exchange.perp.place_order("ETHUSDT", 2.0, 10.1, OrderSide::Buy);
+        break;
+    case 170:
+        (void)exchange.perp.place_order("BTCUSDT", 0.25, OrderSide::Sell);
+        break;
+    case 200:
+        (void)exchange.perp.place_order("ETHUSDT", 1.5, 18.0, OrderSide::Sell);
+        break;
+    default:
+        break;
+    }
+}
+
+struct LoggedRow {
+    LegacyLogContractSnapshot contract;
+    std::vector<double> values;
+
+    bool operator==(const LoggedRow&) const = default;
+};
+
+std::ostream& operator<<(std::ostream& os, const LoggedRow& row)
+{
+    os << row.contract << " values=[";
+    for (const double value : row.values) {
+        os << value << ' ';
+    }
+    return os << ']';
+}
+
+} // namespace
+
+class BinanceExchangeCheckpointFixture : public InfraLogTestFixture {
+protected:
+    std::vector<BinanceExchange::SymbolDataset> WriteDatasets(size_t eth_rows = kRows)
+    {
+        WriteKlines("btc.csv", 100.0, kRows);
+        WriteKlines("eth.csv", 10.0, eth_rows);
+        std::ofstream funding(tmp_dir / "btc_funding.csv", std::ios::trunc);
+        funding << "FundingTime,Rate,MarkPrice\n";
+        for (uint64_t ts = 60 * kMinute; ts < kRows * kMinute; ts += 60 * kMinute) {
+            funding << ts << ",0.0001,101\n";
+        }
+        std::vector<BinanceExchange::SymbolDataset> datasets(2);
+        datasets[0].symbol = "BTCUSDT";
+        datasets[0].kline_csv = (tmp_dir / "btc.csv").string();
+        datasets[0].funding_csv = (tmp_dir / "btc_funding.csv").string();
+        datasets[1].symbol = "ETHUSDT";
+        datasets[1].kline_csv = (tmp_dir / "eth.csv").string();
+        return datasets;
+    }
+
+    void WriteKlines(const std::string& file_name, double base_price, size_t rows)
+    {
+        std::ofstream file(tmp_dir / file_name, std::ios::trunc);
+        file << "openTime,open,high,low,close,volume,closeTime,quoteVol,tradeCnt,takerBB,takerBQ\n";
+        for (size_t i = 0; i < rows; ++i) {
+            const uint64_t ts = i * kMinute;
+            const double px = base_price + static_cast<double>(i % 17) * 0.5;
+            file << ts << ',' << px << ',' << px << ',' << px << ',' << px << ",1000,"
+                 << (ts + kMinute - 1) << ",100000,10,500,50000\n";
+        }
+    }
+
+    // Contract fields of every row after `after_ts`, plus the ledger values of account rows
+    // and the size/PnL of position rows.
+    static std::vector<LoggedRow> CollectRows(
+        const std::vector<Log::Row>& rows,
+        const ModuleIdResolver& resolver,
+        uint64_t after_ts)
+    {
+        std::vector<LoggedRow> out;
+        for (const auto& row : rows) {
+            if (row.ts <= after_ts) {
+                continue;
+            }
+            const auto contract = BuildLegacyLogContractSnapshot(resolver, &row);
+            if (!contract.has_value()) {
+                continue;
+            }
+            LoggedRow logged{ *contract, {} };
+            if (contract->module_name == Log::LogModuleToString(Log::LogModule::Account)) {
+                const auto* account = static_cast<const QTrading::dto::AccountLog*>(row.payload.get());
+                logged.values = { account->balance, account->unreal_pnl, account->equity,
+                    account->total_ledger_value };
+            }
+            else if (contract->module_name == Log::LogModuleToString(Log::LogModule::Position)) {
+                const auto* position = static_cast<const QTrading::dto::Position*>(row.payload.get());
+                logged.values = { position->quantity, position->entry_price, position->unrealized_pnl };
+            }
+            out.push_back(std::move(logged));
+        }
+        return out;
+    }
+};
+
+/// @brief A run resumed from a checkpoint logs exactly what the uninterrupted run logs after it.
+TEST_F(BinanceExchangeCheckpointFixture, ResumedRunMatchesUninterruptedRun)
+{
+    const auto datasets = WriteDatasets();
+
+    std::stringstream checkpoint;
+    std::stringstream uninterrupted_end;
+    {
+        BinanceExchange exchange(datasets, logger, MakeAccountInit());
+        for (uint64_t i = 0; exchange.step(); ++i) {
+            RunScript(exchange, i);
+            if (i == kCheckpointStep) {
+                exchange.save_checkpoint(checkpoint, "strategy-state");
+            }
+        }
+        exchange.save_checkpoint(uninterrupted_end);
+    }
+    StopLogger();
+    const auto expected = CollectRows(rows(), module_id_resolver, kCheckpointStep * kMinute);
+
+    auto resumed_logger = std::make_shared<Log::SinkLogger>((tmp_dir / "resumed").string());
+    InMemorySinkInjection resumed_sink;
+    resumed_logger->AddSink(resumed_sink.CreateSink());
+    ModuleIdResolver resumed_resolver;
+    RegisterDefaultModules(*resumed_logger, resumed_resolver);
+    resumed_logger->Start();
+
+    std::stringstream resumed_end;
+    {
+        BinanceExchange exchange(datasets, resumed_logger, MakeAccountInit());
+        EXPECT_EQ(exchange.restore_checkpoint(checkpoint), "strategy-state");
+        BinanceExchange::StatusSnapshot status{};
+        exchange.FillStatusSnapshot(status);
+        EXPECT_EQ(status.ts_exchange, kCheckpointStep * kMinute);
+        EXPECT_EQ(exchange.get_all_open_orders().size(), 1u);
+        // Interned ids are not stored; restored entries intern their symbol again.
+        for (const auto& order : exchange.get_all_open_orders()) {
+            EXPECT_EQ(std::optional(order.interned_symbol_id), SymbolTable::Find(order.symbol));
+        }
+        for (const auto& position : exchange.get_all_positions()) {
+            EXPECT_EQ(std::optional(position.interned_symbol_id), SymbolTable::Find(position.symbol));
+        }
+
+        for (uint64_t i = kCheckpointStep + 1; exchange.step(); ++i) {
+            RunScript(exchange, i);
+        }
+        exchange.save_checkpoint(resumed_end);
+    }
+    resumed_logger->Stop();
+    const auto actual = CollectRows(resumed_sink.rows(), resumed_resolver, 0);
+
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(actual[i], expected[i]) << "row " << i;
+    }
+    EXPECT_EQ(resumed_end.str(), uninterrupted_end.str());
+}
+
+/// @brief A restored exchange hands its books to its own channel consumers on the first step.
+TEST_F(BinanceExchangeCheckpointFixture, RestoredExchangePublishesBooksOnFirstStep)
+{
+    const auto datasets = WriteDatasets();
+    auto use_both_channels = [](BinanceExchange& exchange) {
+        auto cfg = exchange.simulation_config();
+        cfg.book_channel_mode = BookChannelMode::Both;
+        exchange.apply_simulation_config(cfg);
+    };
+
+    std::stringstream checkpoint;
+    {
+        BinanceExchange exchange(datasets, nullptr, MakeAccountInit());
+        use_both_channels(exchange);
+        for (uint64_t i = 0; i <= kCheckpointStep && exchange.step(); ++i) {
+            RunScript(exchange, i);
+        }
+        ASSERT_FALSE(exchange.get_all_positions().empty());
+        ASSERT_FALSE(exchange.get_all_open_orders().empty());
+        exchange.save_checkpoint(checkpoint);
+    }
+
+    BinanceExchange exchange(datasets, nullptr, MakeAccountInit());
+    use_both_channels(exchange);
+    (void)exchange.restore_checkpoint(checkpoint);
+    ASSERT_TRUE(exchange.step());
+
+    auto full_positions = exchange.get_position_channel()->TryReceive();
+    auto full_orders = exchange.get_order_channel()->TryReceive();
+    ASSERT_TRUE(full_positions.has_value());
+    ASSERT_TRUE(full_orders.has_value());
+    EXPECT_EQ(full_positions->size(), exchange.get_all_positions().size());
+    EXPECT_EQ(full_orders->size(), exchange.get_all_open_orders().size());
+
+    // Deltas start from an empty book, so a consumer that never saw the source run can apply them.
+    PositionBookReplica positions;
+    OrderBookReplica orders;
+    while (auto delta = exchange.get_position_delta_channel()->TryReceive()) {
+        ASSERT_TRUE(positions.apply(std::move(*delta)));
+    }
+    while (auto delta = exchange.get_order_delta_channel()->TryReceive()) {
+        ASSERT_TRUE(orders.apply(std::move(*delta)));
+    }
+    EXPECT_EQ(positions.entries().size(), exchange.get_all_positions().size());
+    EXPECT_EQ(orders.entries().size(), exchange.get_all_open_orders().size());
+    EXPECT_FALSE(orders.entries().empty());
+}
+
+/// @brief Cursors only make sense for the datasets they were taken on.
+TEST_F(BinanceExchangeCheckpointFixture, CheckpointForOtherDatasetsIsRejected)
+{
+    std::stringstream checkpoint;
+    {
+        BinanceExchange exchange(WriteDatasets(), nullptr, MakeAccountInit());
+        for (int i = 0; i < 20; ++i) {
+            ASSERT_TRUE(exchange.step());
+        }
+        exchange.save_checkpoint(checkpoint);
+    }
+
+    BinanceExchange shorter(WriteDatasets(kRows - 1), nullptr, MakeAccountInit());
+    EXPECT_THROW(shorter.restore_checkpoint(checkpoint), std::runtime_error);
+    // A failed restore leaves the exchange at its initial state.
+    ASSERT_TRUE(shorter.step());
+    auto dto = shorter.get_market_channel()->TryReceive();
+    ASSERT_TRUE(dto.has_value());
+    EXPECT_EQ(dto.value()->Timestamp, 0u);
+}
+
+/// @brief Truncated or foreign input is reported instead of half-applied.
+TEST_F(BinanceExchangeCheckpointFixture, CorruptCheckpointIsRejected)
+{
+    const auto datasets = WriteDatasets();
+    std::string bytes;
+    {
+        BinanceExchange exchange(datasets, nullptr, MakeAccountInit());
+        ASSERT_TRUE(exchange.step());
+        std::stringstream out;
+        exchange.save_checkpoint(out);
+        bytes = out.str();
+    }
+
+    BinanceExchange exchange(datasets, nullptr, MakeAccountInit());
+    std::stringstream truncated(bytes.substr(0, bytes.size() / 2));
+    EXPECT_THROW(exchange.restore_checkpoint(truncated), std::runtime_error);
+    std::stringstream foreign("not a checkpoint at all");
+    EXPECT_THROW(exchange.restore_checkpoint(foreign), std::runtime_error);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Dto/Trading/Side.hpp"
+#include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
+#include "ReplayCsvFixture.hpp"
+
+using QTrading::Dto::Trading::OrderSide;
+using QTrading::Infra::Exchanges::BinanceSim::Account;
+using QTrading::Infra::Exchanges::BinanceSim::BinanceExchange;
+using QTrading::Infra::Exchanges::BinanceSim::Config::ReplayMergeMode;
+using QTrading::Infra::Exchanges::BinanceSim::Contracts::FundingApplyTiming;
+
+namespace {
+
+constexpr size_t kRows = 300;
+constexpr uint64_t kEntryTs = 150 * kMinute;
+
+uint64_t receive_ts(BinanceExchange& exchange)
+{
+    auto dto = exchange.get_market_channel()->TryReceive();
+    EXPECT_TRUE(dto.has_value() && dto.value());
+    return dto.has_value() && dto.value() ? dto.value()->Timestamp : 0;
+}
+
+// Opens a BTC long at the first frame at or after `kEntryTs`, then steps to the end.
+void trade_from_entry(BinanceExchange& exchange, uint64_t ts)
+{
+    if (ts >= kEntryTs && exchange.get_all_positions().empty()) {
+        (void)exchange.perp.place_order("BTCUSDT", 0.5, OrderSide::Buy);
+    }
+    while (exchange.step()) {
+        (void)receive_ts(exchange);
+    }
+}
+
+} // namespace
+
+class BinanceExchangeFastForwardTests : public ReplayCsvFixture {
+protected:
+    BinanceExchangeFastForwardTests() : ReplayCsvFixture("fast_forward", kRows) {}
+
+    void SetUp() override {
+        datasets.resize(2);
+        datasets[0].symbol = "BTCUSDT";
+        datasets[0].kline_csv = write_klines("btc.csv", 100.0, 1);
+        datasets[0].funding_csv = write_funding("btc_funding.csv");
+        datasets[0].mark_kline_csv = write_klines("btc_mark.csv", 100.2, 2);
+        datasets[1].symbol = "ETHUSDT";
+        datasets[1].kline_csv = write_klines("eth.csv", 10.0, 1);
+    }
+};
+
+/// @brief Fast-forwarding an idle account and then trading ends exactly where stepping does.
+TEST_F(BinanceExchangeFastForwardTests, IdleFastForwardMatchesSteppedRun)
+{
+    for (const auto timing : { FundingApplyTiming::BeforeMatching, FundingApplyTiming::AfterMatching }) {
+        for (const auto mode : { ReplayMergeMode::TimestampHeap, ReplayMergeMode::LinearCalendar, ReplayMergeMode::MinuteGrid }) {
+            SCOPED_TRACE(static_cast<int>(mode));
+            BinanceExchange stepped(datasets, nullptr, make_account_init());
+            BinanceExchange fast(datasets, nullptr, make_account_init());
+            auto cfg = stepped.simulation_config();
+            cfg.funding_apply_timing = timing;
+            cfg.replay_merge_mode = mode;
+            stepped.apply_simulation_config(cfg);
+            fast.apply_simulation_config(cfg);
+
+            uint64_t stepped_frames = 0;
+            uint64_t stepped_ts = 0;
+            while (stepped_ts < kEntryTs) {
+                ASSERT_TRUE(stepped.step());
+                stepped_ts = receive_ts(stepped);
+                ++stepped_frames;
+            }
+
+            BinanceExchange::WakeCondition wake{};
+            wake.wake_at_ts = kEntryTs;
+            ASSERT_TRUE(fast.step_until(wake));
+            EXPECT_EQ(receive_ts(fast), kEntryTs);
+            EXPECT_FALSE(fast.get_market_channel()->TryReceive().has_value());
+            EXPECT_EQ(stepped_frames, kEntryTs / kMinute + 1);
+            expect_same_status(fast, stepped);
+
+            trade_from_entry(stepped, stepped_ts);
+            trade_from_entry(fast, kEntryTs);
+            EXPECT_EQ(fast.get_all_positions().size(), 1u);
+            expect_same_status(fast, stepped);
+        }
+    }
+}
+
+/// @brief Funding and price wakes stop at the first frame that satisfies them.
+TEST_F(BinanceExchangeFastForwardTests, WakesAtFundingAndPriceThresholds)
+{
+    BinanceExchange exchange(datasets, nullptr, make_account_init());
+
+    BinanceExchange::WakeCondition funding_wake{};
+    funding_wake.wake_on_funding = true;
+    ASSERT_TRUE(exchange.step_until(funding_wake));
+    EXPECT_EQ(receive_ts(exchange), 60 * kMinute);
+
+    // ETH closes at 10 + (i % 17) * 0.5; the first close at or above 17.5 after minute 60 is i = 66.
+    BinanceExchange::WakeCondition price_wake{};
+    price_wake.price_wakes.push_back({ "ETHUSDT", 0.0, 17.5 });
+    ASSERT_TRUE(exchange.step_until(price_wake));
+    EXPECT_EQ(receive_ts(exchange), 66 * kMinute);
+
+    // The earliest member wins.
+    price_wake.wake_at_ts = 70 * kMinute;
+    price_wake.wake_on_funding = true;
+    price_wake.price_wakes.front().at_or_above = 1e9;
+    ASSERT_TRUE(exchange.step_until(price_wake));
+    EXPECT_EQ(receive_ts(exchange), 70 * kMinute);
+
+    // Nothing to wake for: the replay ends.
+    EXPECT_FALSE(exchange.step_until(BinanceExchange::WakeCondition{}));
+    EXPECT_TRUE(exchange.get_market_channel()->IsClosed());
+}
+
+/// @brief With exposure or resting orders every frame is materialized.
+TEST_F(BinanceExchangeFastForwardTests, NonIdleAccountStepsEveryFrame)
+{
+    BinanceExchange exchange(datasets, nullptr, make_account_init());
+    ASSERT_TRUE(exchange.step());
+    EXPECT_EQ(receive_ts(exchange), 0u);
+    (void)exchange.perp.place_order("ETHUSDT", 1.0, 1.0, OrderSide::Buy);
+    ASSERT_EQ(exchange.get_all_open_orders().size(), 1u);
+
+    BinanceExchange::WakeCondition wake{};
+    wake.wake_at_ts = 200 * kMinute;
+    ASSERT_TRUE(exchange.step_until(wake));
+    EXPECT_EQ(receive_ts(exchange), kMinute);
+
+    exchange.perp.cancel_open_orders("ETHUSDT");
+    ASSERT_TRUE(exchange.get_all_open_orders().empty());
+    ASSERT_TRUE(exchange.step_until(wake));
+    EXPECT_EQ(receive_ts(exchange), 200 * kMinute);
+}
@@ -0,0 +1,181 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Data/Binance/BinaryCache.hpp"
+#include "Dto/Trading/Side.hpp"
+#define private public
+#include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
+#undef private
+#include "Exchanges/BinanceSimulator/State/ExchangeSnapshot.hpp"
+#include "Exchanges/BinanceSimulator/State/StepKernelState.hpp"
+#include "ReplayCsvFixture.hpp"
+#include "TestEnv.hpp"
+
+using QTrading::Dto::Trading::OrderSide;
+using QTrading::Infra::Exchanges::BinanceSim::BinanceExchange;
+
+namespace {
+
+constexpr size_t kRows = 300;
+constexpr size_t kForkStep = 120;
+
+struct RunOutcome {
+    uint64_t steps{ 0 };
+    uint64_t last_ts{ 0 };
+    double wallet_balance{ 0.0 };
+    double total_unrealized_pnl{ 0.0 };
+    size_t open_positions{ 0 };
+};
+
+// Replays to the end, optionally opening an ETH long on the first step.
+RunOutcome drive_to_end(BinanceExchange& exchange, double eth_qty)
+{
+    RunOutcome out{};
+    while (exchange.step()) {
+        if (out.steps == 0 && eth_qty > 0.0) {
+            (void)exchange.perp.place_order("ETHUSDT", eth_qty, OrderSide::Buy);
+        }
+        if (auto dto = exchange.get_market_channel()->TryReceive(); dto.has_value() && dto.value()) {
+            out.last_ts = dto.value()->Timestamp;
+        }
+        ++out.steps;
+    }
+    BinanceExchange::StatusSnapshot snapshot{};
+    exchange.FillStatusSnapshot(snapshot);
+    out.wallet_balance = snapshot.wallet_balance;
+    out.total_unrealized_pnl = snapshot.total_unrealized_pnl;
+    out.open_positions = exchange.get_all_positions().size();
+    return out;
+}
+
+} // namespace
+
+class BinanceExchangeForkTests : public ReplayCsvFixture {
+protected:
+    BinanceExchangeForkTests() : ReplayCsvFixture("fork", kRows) {}
+
+    void SetUp() override {
+        datasets.resize(2);
+        datasets[0].symbol = "BTCUSDT";
+        datasets[0].kline_csv = write_klines("btc.csv", 100.0);
+        datasets[0].funding_csv = write_funding("btc_funding.csv");
+        datasets[1].symbol = "ETHUSDT";
+        datasets[1].kline_csv = write_klines("eth.csv", 10.0);
+    }
+
+    // Steps a fresh exchange to `kForkStep` with an open BTC long.
+    std::unique_ptr<BinanceExchange> make_source() {
+        auto exchange = std::make_unique<BinanceExchange>(datasets, nullptr, make_account_init());
+        for (size_t i = 0; i < kForkStep; ++i) {
+            EXPECT_TRUE(exchange->step());
+            if (i == 0) {
+                (void)exchange->perp.place_order("BTCUSDT", 0.5, OrderSide::Buy);
+            }
+        }
+        return exchange;
+    }
+};
+
+/// @brief A fork continues exactly like its source when both take the same actions.
+TEST_F(BinanceExchangeForkTests, ForkContinuesIdenticallyToSource)
+{
+    auto source = make_source();
+    auto fork = source->fork();
+    ASSERT_NE(fork, nullptr);
+    EXPECT_EQ(fork->get_all_positions().size(), source->get_all_positions().size());
+
+    const RunOutcome source_out = drive_to_end(*source, 2.0);
+    const RunOutcome fork_out = drive_to_end(*fork, 2.0);
+    EXPECT_EQ(fork_out.steps, kRows - kForkStep);
+    EXPECT_EQ(fork_out.steps, source_out.steps);
+    EXPECT_EQ(fork_out.last_ts, (kRows - 1) * kMinute);
+    EXPECT_EQ(fork_out.wallet_balance, source_out.wallet_balance);
+    EXPECT_EQ(fork_out.total_unrealized_pnl, source_out.total_unrealized_pnl);
+    EXPECT_EQ(fork_out.open_positions, 2u);
+}
+
+/// @brief Branches from one snapshot diverge without affecting each other or the source.
+TEST_F(BinanceExchangeForkTests, BranchesFromOneSnapshotAreIndependent)
+{
+    auto source = make_source();
+    const auto snapshot = source->snapshot();
+    BinanceExchange hold(*snapshot, nullptr);
+    BinanceExchange hedge(*snapshot, nullptr);
+
+    const RunOutcome hedge_out = drive_to_end(hedge, 3.0);
+    const RunOutcome hold_out = drive_to_end(hold, 0.0);
+    const RunOutcome source_out = drive_to_end(*source, 0.0);
+
+    EXPECT_EQ(hedge_out.open_positions, 2u);
+    EXPECT_EQ(hold_out.open_positions, 1u);
+    EXPECT_EQ(source_out.open_positions, 1u);
+    EXPECT_NE(hedge_out.total_unrealized_pnl, hold_out.total_unrealized_pnl);
+    EXPECT_EQ(hold_out.wallet_balance, source_out.wallet_balance);
+    EXPECT_EQ(hold_out.total_unrealized_pnl, source_out.total_unrealized_pnl);
+    // The snapshot itself is not advanced by its forks.
+    EXPECT_EQ(snapshot->snapshot.step_seq, kForkStep);
+}
+
+/// @brief Forks share the replay series with their source instead of copying them.
+TEST_F(BinanceExchangeForkTests, ForkSharesReplaySeriesStorage)
+{
+    auto source = make_source();
+    const auto fork_snapshot = source->fork()->snapshot();
+    const auto source_snapshot = source->snapshot();
+    ASSERT_EQ(fork_snapshot->step.market_data.size(), datasets.size());
+    for (size_t i = 0; i < datasets.size(); ++i) {
+        EXPECT_EQ(fork_snapshot->step.market_data[i].timestamps().data(),
+            source_snapshot->step.market_data[i].timestamps().data());
+    }
+    EXPECT_EQ(fork_snapshot->step.symbols_shared, source_snapshot->step.symbols_shared);
+    EXPECT_EQ(fork_snapshot->runtime.logger, nullptr);
+    EXPECT_TRUE(fork_snapshot->step.replay_payload_pool.empty());
+}
+
+/// @brief A fork over memory-mapped series streams through its own bounded read-ahead.
+TEST_F(BinanceExchangeForkTests, ForkOverMappedSeriesRebuildsReadAhead)
+{
+    namespace Cache = QTrading::Infra::Data::Binance;
+    const std::string cache_dir = test_file("cache");
+    set_env_var(Cache::kBinaryCacheDirEnv, cache_dir.c_str());
+    BinanceExchange::DatasetLoadOptions options{};
+    options.replay_chunk_budget_bytes = 1 << 16;
+    BinanceExchange source(datasets, nullptr, make_account_init(), 0, options);
+    for (size_t i = 0; i < kForkStep; ++i) {
+        ASSERT_TRUE(source.step());
+    }
+    const auto& source_read_ahead = source.step_kernel_state_->replay_read_ahead;
+    ASSERT_NE(source_read_ahead, nullptr);
+    ASSERT_GT(source_read_ahead->active_series(), 0u);
+
+    auto fork = source.fork();
+    const auto& fork_read_ahead = fork->step_kernel_state_->replay_read_ahead;
+    ASSERT_NE(fork_read_ahead, nullptr);
+    EXPECT_NE(fork_read_ahead, source_read_ahead);
+    EXPECT_EQ(fork_read_ahead->active_series(), source_read_ahead->active_series());
+    EXPECT_EQ(fork_read_ahead->chunk_rows(), source_read_ahead->chunk_rows());
+
+    const RunOutcome source_out = drive_to_end(source, 1.0);
+    const RunOutcome fork_out = drive_to_end(*fork, 1.0);
+    EXPECT_EQ(fork_out.steps, kRows - kForkStep);
+    EXPECT_EQ(fork_out.wallet_balance, source_out.wallet_balance);
+    EXPECT_EQ(fork_out.total_unrealized_pnl, source_out.total_unrealized_pnl);
+
+    fork.reset();
+    unset_env_var(Cache::kBinaryCacheDirEnv);
+    std::filesystem::remove_all(cache_dir);
+}
+
+/// @brief Forking after replay exhaustion yields open channels that close on the next step.
+TEST_F(BinanceExchangeForkTests, ForkOfExhaustedReplayClosesItsOwnChannels)
+{
+    auto source = make_source();
+    (void)drive_to_end(*source, 0.0);
+    auto fork = source->fork();
+    EXPECT_FALSE(fork->get_market_channel()->IsClosed());
+    EXPECT_FALSE(fork->step());
+    EXPECT_TRUE(fork->get_market_channel()->IsClosed());
+}
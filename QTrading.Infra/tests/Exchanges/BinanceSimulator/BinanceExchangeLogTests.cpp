@@ -2,6 +2,7 @@
 #include <cmath>
 #include <fstream>
 #include <optional>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <vector>
@@ -107,6 +108,37 @@ TEST_F(BinanceExchangeLogTestFixture, BinanceExchangeLogUsesSinkLogger)
     EXPECT_EQ(account_row->ts, 0u);
 }
 
+/// @brief Rows logged from a thread that never steps carry the run's simulated time, not zero.
+TEST_F(BinanceExchangeLogTestFixture, LogFromNonSteppingThreadCarriesRunTimestamp)
+{
+    WriteCsv("btc.csv", {
+        { 0, 100.0, 101.0, 99.0, 100.5, 1000.0, 59999, 1000.0, 1, 0.0, 0.0 },
+        { 60000, 100.5, 102.0, 100.0, 101.5, 1000.0, 119999, 1000.0, 1, 0.0, 0.0 }
+    });
+
+    {
+        BinanceExchange exchange(
+            { { "BTCUSDT", (tmp_dir / "btc.csv").string() } },
+            logger,
+            MakeAccountInitConfig(1000.0, 0));
+        ASSERT_TRUE(exchange.step());
+        ASSERT_TRUE(exchange.step());
+
+        std::thread strategy([this]() {
+            QTrading::Log::FileLogger::FeatherV2::RunMetadataDto meta{};
+            meta.strategy_name = "off-thread";
+            EXPECT_TRUE(logger->Log(
+                QTrading::Log::LogModuleToString(QTrading::Log::LogModule::RunMetadata), meta));
+        });
+        strategy.join();
+    }
+    StopLogger();
+
+    const auto metadata_rows = FilterRowsByModule(QTrading::Log::LogModule::RunMetadata);
+    ASSERT_EQ(metadata_rows.size(), 1u);
+    EXPECT_EQ(metadata_rows[0].row->ts, 60000u);
+}
+
 TEST_F(BinanceExchangeLogTestFixture, ChannelPayloadCanDirectlyValidateMarketLogRows)
 {
     WriteCsv("btc.csv", {
@@ -182,7 +214,7 @@ TEST_F(BinanceExchangeLogTestFixture, ChannelPayloadCanDirectlyValidateMarketLog
             auto grouped_it = rows_grouped.find(symbol);
             ASSERT_NE(grouped_it, rows_grouped.end());
 
-            const auto& maybe_kline = dto->trade_klines_by_id[symbol_index];
+            const auto maybe_kline = dto->trade_bar(symbol_index);
             bool found_matching_payload = false;
             for (const auto* payload : grouped_it->second) {
                 if (payload->has_kline != maybe_kline.has_value()) {
@@ -192,8 +224,8 @@ TEST_F(BinanceExchangeLogTestFixture, ChannelPayloadCanDirectlyValidateMarketLog
                     found_matching_payload = true;
                     break;
                 }
-                if (std::abs(payload->close - maybe_kline->ClosePrice) <= 1e-12
-                    && std::abs(payload->volume - maybe_kline->Volume) <= 1e-12) {
+                if (std::abs(payload->close - maybe_kline->close) <= 1e-12
+                    && std::abs(payload->volume - maybe_kline->volume) <= 1e-12) {
                     found_matching_payload = true;
                     break;
                 }
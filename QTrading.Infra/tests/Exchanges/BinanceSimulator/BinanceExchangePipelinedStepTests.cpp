@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Dto/Trading/Side.hpp"
+#include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
+#include "ReplayCsvFixture.hpp"
+
+using QTrading::Dto::Trading::OrderSide;
+using QTrading::Infra::Exchanges::BinanceSim::BinanceExchange;
+using QTrading::Infra::Exchanges::BinanceSim::Config::ReplayMergeMode;
+
+namespace {
+
+constexpr size_t kRows = 200;
+
+// Strategy stand-in keyed by the frame timestamp; market orders are priced at entry.
+void run_script(BinanceExchange& exchange, uint64_t ts)
+{
+    switch (ts / kMinute) {
+    case 3:
+        (void)exchange.perp.place_order("BTCUSDT", 0.5, OrderSide::Buy);
+        break;
+    case 20:
+        (void)exchange.perp.place_order("ETHUSDT", 2.0, 10.6, OrderSide::Buy);
+        break;
+    case 90:
+        (void)exchange.perp.place_order("BTCUSDT", 0.25, OrderSide::Sell);
+        break;
+    case 150:
+        (void)exchange.perp.place_order("ETHUSDT", 1.0, 17.0, OrderSide::Sell);
+        break;
+    default:
+        break;
+    }
+}
+
+// Steps to the end, running the script after every frame; returns the frame timestamps seen.
+std::vector<uint64_t> run_to_end(BinanceExchange& exchange, bool pipelined)
+{
+    std::vector<uint64_t> seen;
+    while (exchange.step()) {
+        if (pipelined) {
+            EXPECT_TRUE(exchange.prefetch_next_step());
+        }
+        auto dto = exchange.get_market_channel()->TryReceive();
+        EXPECT_TRUE(dto.has_value() && dto.value());
+        if (!dto.has_value() || !dto.value()) {
+            break;
+        }
+        seen.push_back(dto.value()->Timestamp);
+        run_script(exchange, seen.back());
+    }
+    return seen;
+}
+
+} // namespace
+
+class BinanceExchangePipelinedStepTests : public ReplayCsvFixture {
+protected:
+    BinanceExchangePipelinedStepTests() : ReplayCsvFixture("pipelined_step", kRows) {}
+
+    void SetUp() override {
+        datasets.resize(2);
+        datasets[0].symbol = "BTCUSDT";
+        datasets[0].kline_csv = write_klines("btc.csv", 100.0, 1);
+        datasets[0].funding_csv = write_funding("btc_funding.csv");
+        datasets[0].mark_kline_csv = write_klines("btc_mark.csv", 100.2, 2);
+        datasets[1].symbol = "ETHUSDT";
+        datasets[1].kline_csv = write_klines("eth.csv", 10.0, 1);
+    }
+};
+
+/// @brief Prefetching every next frame while the strategy trades ends exactly where serial stepping does.
+TEST_F(BinanceExchangePipelinedStepTests, PipelinedRunMatchesSerialRun)
+{
+    for (const auto mode : { ReplayMergeMode::TimestampHeap, ReplayMergeMode::LinearCalendar, ReplayMergeMode::MinuteGrid }) {
+        SCOPED_TRACE(static_cast<int>(mode));
+        BinanceExchange serial(datasets, nullptr, make_account_init());
+        BinanceExchange pipelined(datasets, nullptr, make_account_init());
+        auto cfg = serial.simulation_config();
+        cfg.replay_merge_mode = mode;
+        serial.apply_simulation_config(cfg);
+        pipelined.apply_simulation_config(cfg);
+
+        const auto serial_frames = run_to_end(serial, false);
+        const auto pipelined_frames = run_to_end(pipelined, true);
+        EXPECT_EQ(serial_frames.size(), kRows);
+        EXPECT_EQ(pipelined_frames, serial_frames);
+        EXPECT_FALSE(pipelined.prefetch_next_step());
+        EXPECT_TRUE(pipelined.get_market_channel()->IsClosed());
+
+        EXPECT_EQ(pipelined.get_all_positions().size(), serial.get_all_positions().size());
+        EXPECT_EQ(pipelined.get_all_open_orders().size(), serial.get_all_open_orders().size());
+        expect_same_status(pipelined, serial);
+    }
+}
+
+/// @brief While a frame is pending, state capture is refused and fast-forward steps it as is.
+TEST_F(BinanceExchangePipelinedStepTests, PendingFrameBlocksSnapshotsAndIsSteppedByStepUntil)
+{
+    BinanceExchange exchange(datasets, nullptr, make_account_init());
+    ASSERT_TRUE(exchange.step());
+    ASSERT_TRUE(exchange.prefetch_next_step());
+    EXPECT_FALSE(exchange.prefetch_next_step());
+
+    std::stringstream checkpoint;
+    EXPECT_THROW(exchange.save_checkpoint(checkpoint), std::logic_error);
+    EXPECT_THROW((void)exchange.fork(), std::logic_error);
+    // Config changes only wait for the pending frame.
+    exchange.apply_simulation_config(exchange.simulation_config());
+
+    BinanceExchange::WakeCondition wake{};
+    wake.wake_at_ts = 100 * kMinute;
+    ASSERT_TRUE(exchange.step_until(wake));
+    auto first = exchange.get_market_channel()->TryReceive();
+    auto second = exchange.get_market_channel()->TryReceive();
+    ASSERT_TRUE(first.has_value() && second.has_value());
+    EXPECT_EQ(first.value()->Timestamp, 0u);
+    EXPECT_EQ(second.value()->Timestamp, kMinute);
+
+    EXPECT_NO_THROW(exchange.save_checkpoint(checkpoint));
+    ASSERT_TRUE(exchange.step_until(wake));
+    auto woken = exchange.get_market_channel()->TryReceive();
+    ASSERT_TRUE(woken.has_value());
+    EXPECT_EQ(woken.value()->Timestamp, 100 * kMinute);
+}
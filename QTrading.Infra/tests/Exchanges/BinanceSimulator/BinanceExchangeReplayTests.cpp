@@ -1,11 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <limits>
 #include <optional>
 #include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "InfraLogTestFixture.hpp"
@@ -203,8 +205,8 @@ TEST_F(BinanceExchangeFixture, SymbolsSynchronisedWithHoles)
     const auto eth_id = find_id("ETHUSDT");
     ASSERT_LT(btc_id, symbols->size());
     ASSERT_LT(eth_id, symbols->size());
-    EXPECT_TRUE(dto1->get()->trade_klines_by_id[btc_id].has_value());
-    EXPECT_FALSE(dto1->get()->trade_klines_by_id[eth_id].has_value());
+    EXPECT_TRUE(dto1->get()->has_trade_kline(btc_id));
+    EXPECT_FALSE(dto1->get()->has_trade_kline(eth_id));
 
     ASSERT_TRUE(exchange.step());
     auto dto2 = market_channel->Receive();
@@ -219,6 +221,339 @@ TEST_F(BinanceExchangeFixture, SymbolsSynchronisedWithHoles)
     EXPECT_FALSE(exchange.step());
 }
 
+TEST_F(BinanceExchangeFixture, LinearCalendarMergeMatchesTimestampHeapFrames)
+{
+    WriteCsv("btc.csv", {
+        {      0, 1,1,1,1,100, 30000,100,1,0,0 },
+        {  60000, 2,2,2,2,200, 90000,200,1,0,0 },
+        { 180000, 3,3,3,3,300,210000,300,1,0,0 }
+    });
+    WriteCsv("eth.csv", {
+        {  30000,10,10,10,10, 50, 60000, 50,1,0,0 },
+        {  60000,20,20,20,20, 70, 90000, 70,1,0,0 },
+        { 120000,30,30,30,30, 90,150000, 90,1,0,0 }
+    });
+    WriteCsv("sol.csv", {
+        {  60000,40,40,40,40, 10, 90000, 10,1,0,0 }
+    });
+    WriteFundingCsv("btc_funding.csv", {
+        {  45000, 0.001, 1.5 },
+        { 240000, 0.002, 3.0 }
+    });
+
+    using QTrading::Infra::Exchanges::BinanceSim::Config::ReplayMergeMode;
+    struct FrameSignature {
+        uint64_t ts{ 0 };
+        std::vector<std::pair<size_t, double>> trades;
+        std::vector<size_t> fundings;
+        bool operator==(const FrameSignature&) const = default;
+    };
+    // switch_after_steps == 0 starts in `mode`; otherwise switches after that many steps.
+    auto run_case = [&](ReplayMergeMode mode, size_t switch_after_steps) {
+        BinanceExchange exchange = MakeExchange({
+            { "BTCUSDT", (tmp_dir / "btc.csv").string(),
+                std::optional<std::string>((tmp_dir / "btc_funding.csv").string()) },
+            { "ETHUSDT", (tmp_dir / "eth.csv").string() },
+            { "SOLUSDT", (tmp_dir / "sol.csv").string() },
+        });
+        auto apply_mode = [&]() {
+            auto cfg = exchange.simulation_config();
+            cfg.replay_merge_mode = mode;
+            exchange.apply_simulation_config(cfg);
+        };
+        if (switch_after_steps == 0) {
+            apply_mode();
+        }
+        auto market_channel = exchange.get_market_channel();
+        std::vector<FrameSignature> frames;
+        while (exchange.step()) {
+            auto dto = market_channel->Receive();
+            if (!dto.has_value()) {
+                ADD_FAILURE() << "missing market payload";
+                break;
+            }
+            FrameSignature sig{};
+            sig.ts = dto->get()->Timestamp;
+            for (size_t i = 0; i < dto->get()->symbol_count(); ++i) {
+                if (const auto close = dto->get()->trade_close(i)) {
+                    sig.trades.emplace_back(i, *close);
+                }
+                if (dto->get()->has_funding(i)) {
+                    sig.fundings.push_back(i);
+                }
+            }
+            frames.push_back(std::move(sig));
+            if (frames.size() == switch_after_steps) {
+                apply_mode();
+            }
+        }
+        return frames;
+    };
+
+    const auto heap_frames = run_case(ReplayMergeMode::TimestampHeap, 0);
+    ASSERT_EQ(heap_frames.size(), 7u);
+    EXPECT_EQ(heap_frames[2].ts, 45000u);
+    EXPECT_EQ(heap_frames[2].fundings, std::vector<size_t>{ 0 });
+    EXPECT_EQ(heap_frames[3].trades.size(), 3u);
+    EXPECT_EQ(heap_frames.back().ts, 240000u);
+
+    EXPECT_EQ(run_case(ReplayMergeMode::LinearCalendar, 0), heap_frames);
+    EXPECT_EQ(run_case(ReplayMergeMode::LinearCalendar, 2), heap_frames);
+    // Off-grid rows (30000, 45000) make MinuteGrid fall back to the calendar merge.
+    EXPECT_EQ(run_case(ReplayMergeMode::MinuteGrid, 0), heap_frames);
+}
+
+TEST_F(BinanceExchangeFixture, LinearCalendarMergeMatchesTimestampHeapReferenceRows)
+{
+    WriteCsv("btc.csv", {
+        {      0, 1,1,1,1,100, 59999,100,1,0,0 },
+        {  60000, 2,2,2,2,200,119999,200,1,0,0 },
+        { 240000, 3,3,3,3,300,299999,300,1,0,0 }
+    });
+    WriteCsv("eth.csv", {
+        { 120000,10,10,10,10, 50,179999, 50,1,0,0 },
+        { 180000,20,20,20,20, 70,239999, 70,1,0,0 },
+        { 240000,30,30,30,30, 90,299999, 90,1,0,0 }
+    });
+    // Mark rows off the step timeline (30000, 300000) and inside a trade gap (180000).
+    WriteCompactCsv("btc_mark.csv", {
+        {      0, 1.1,1.1,1.1,1.1, 59999 },
+        {  30000, 1.2,1.2,1.2,1.2, 89999 },
+        { 180000, 2.5,2.5,2.5,2.5,239999 },
+        { 240000, 3.1,3.1,3.1,3.1,299999 },
+        { 300000, 3.2,3.2,3.2,3.2,359999 }
+    });
+    WriteCompactCsv("eth_index.csv", {
+        {  60000, 9.0,9.0,9.0,9.0,119999 },
+        { 180000,19.0,19.0,19.0,19.0,239999 }
+    });
+    WriteFundingCsv("eth_funding.csv", {
+        { 120000, 0.001, 10.0 },
+        { 360000, 0.002, 30.0 }
+    });
+
+    using QTrading::Infra::Exchanges::BinanceSim::Config::ReplayMergeMode;
+    struct FrameSignature {
+        uint64_t ts{ 0 };
+        std::vector<std::pair<size_t, double>> trades;
+        std::vector<std::pair<size_t, double>> marks;
+        std::vector<std::pair<size_t, double>> indexes;
+        std::vector<size_t> fundings;
+        bool operator==(const FrameSignature&) const = default;
+    };
+    // `grid_rows` counts steps whose MinuteGrid close row matched the payload's trade closes.
+    size_t grid_rows = 0;
+    auto run_case = [&](ReplayMergeMode mode, size_t switch_after_steps, size_t window_minutes = 1440) {
+        grid_rows = 0;
+        BinanceExchange exchange = MakeExchange({
+            { "BTCUSDT", (tmp_dir / "btc.csv").string(), std::nullopt,
+                std::optional<std::string>((tmp_dir / "btc_mark.csv").string()) },
+            { "ETHUSDT", (tmp_dir / "eth.csv").string(),
+                std::optional<std::string>((tmp_dir / "eth_funding.csv").string()),
+                std::nullopt,
+                std::optional<std::string>((tmp_dir / "eth_index.csv").string()) },
+        });
+        auto apply_mode = [&]() {
+            auto cfg = exchange.simulation_config();
+            cfg.replay_merge_mode = mode;
+            cfg.replay_minute_grid_window_minutes = window_minutes;
+            exchange.apply_simulation_config(cfg);
+        };
+        if (switch_after_steps == 0) {
+            apply_mode();
+        }
+        auto market_channel = exchange.get_market_channel();
+        std::vector<FrameSignature> frames;
+        while (exchange.step()) {
+            auto dto = market_channel->Receive();
+            if (!dto.has_value()) {
+                ADD_FAILURE() << "missing market payload";
+                break;
+            }
+            const auto& payload = *dto->get();
+            FrameSignature sig{};
+            sig.ts = payload.Timestamp;
+            const auto close_row = exchange.minute_grid_close_row();
+            bool close_row_matches = close_row.size() == payload.symbol_count();
+            for (size_t i = 0; i < payload.symbol_count(); ++i) {
+                if (const auto close = payload.trade_close(i)) {
+                    sig.trades.emplace_back(i, *close);
+                    close_row_matches = close_row_matches && close_row[i] == *close;
+                }
+                else {
+                    close_row_matches = close_row_matches && std::isnan(close_row[i]);
+                }
+                if (const auto mark = payload.mark_close(i)) {
+                    sig.marks.emplace_back(i, *mark);
+                }
+                if (const auto index = payload.index_close(i)) {
+                    sig.indexes.emplace_back(i, *index);
+                }
+                if (payload.has_funding(i)) {
+                    sig.fundings.push_back(i);
+                }
+            }
+            grid_rows += close_row_matches ? 1 : 0;
+            frames.push_back(std::move(sig));
+            if (frames.size() == switch_after_steps) {
+                apply_mode();
+            }
+        }
+        return frames;
+    };
+
+    const auto heap_frames = run_case(ReplayMergeMode::TimestampHeap, 0);
+    ASSERT_EQ(heap_frames.size(), 6u);
+    EXPECT_EQ(heap_frames[3].ts, 180000u);
+    EXPECT_EQ(heap_frames[3].marks, (std::vector<std::pair<size_t, double>>{ { 0, 2.5 } }));
+    EXPECT_EQ(heap_frames.back().ts, 360000u);
+    EXPECT_EQ(grid_rows, 0u);
+
+    EXPECT_EQ(run_case(ReplayMergeMode::LinearCalendar, 0), heap_frames);
+    EXPECT_EQ(run_case(ReplayMergeMode::LinearCalendar, 2), heap_frames);
+    EXPECT_EQ(run_case(ReplayMergeMode::MinuteGrid, 0), heap_frames);
+    EXPECT_EQ(grid_rows, heap_frames.size());
+    EXPECT_EQ(run_case(ReplayMergeMode::MinuteGrid, 2), heap_frames);
+    EXPECT_EQ(grid_rows, heap_frames.size() - 2);
+    // Two-minute windows cut the panel four times at the cursors, across the trade gap
+    // and the mark rows that fall between windows.
+    EXPECT_EQ(run_case(ReplayMergeMode::MinuteGrid, 0, 2), heap_frames);
+    EXPECT_EQ(grid_rows, heap_frames.size());
+    EXPECT_EQ(run_case(ReplayMergeMode::MinuteGrid, 3, 1), heap_frames);
+    EXPECT_EQ(grid_rows, heap_frames.size() - 3);
+}
+
+TEST_F(BinanceExchangeFixture, CompactFramePayloadMatchesRowPayload)
+{
+    WriteCsv("btc.csv", {
+        {      0, 1,1.5,0.5,1,100, 59999,100,1,40,0 },
+        {  60000, 2,2.5,1.5,2,200,119999,250,1,80,0 },
+        { 180000, 3,3.5,2.5,3,300,239999,300,1,90,0 }
+    });
+    WriteCsv("eth.csv", {
+        {  60000,10,11,9,10, 50,119999, 50,1,20,0 },
+        { 120000,20,21,19,20, 70,179999, 75,1,30,0 }
+    });
+    WriteCompactCsv("btc_mark.csv", {
+        {      0, 1.1,1.1,1.1,1.1, 59999 },
+        { 120000, 2.1,2.1,2.1,2.1,179999 }
+    });
+    WriteCompactCsv("eth_index.csv", {
+        {  60000, 9.0,9.0,9.0,9.0,119999 }
+    });
+    WriteFundingCsv("eth_funding.csv", {
+        {  60000, 0.001, 10.0 },
+        { 180000, -0.002, std::nullopt }
+    });
+
+    struct FrameSignature {
+        uint64_t ts{ 0 };
+        std::vector<std::tuple<size_t, double, double, double>> trades;
+        std::vector<std::pair<size_t, double>> marks;
+        std::vector<std::pair<size_t, double>> indexes;
+        std::vector<std::tuple<size_t, uint64_t, double, std::optional<double>>> fundings;
+        bool operator==(const FrameSignature&) const = default;
+    };
+    auto run_case = [&](bool rows_enabled, size_t switch_after_steps) {
+        BinanceExchange exchange = MakeExchange({
+            { "BTCUSDT", (tmp_dir / "btc.csv").string(), std::nullopt,
+                std::optional<std::string>((tmp_dir / "btc_mark.csv").string()) },
+            { "ETHUSDT", (tmp_dir / "eth.csv").string(),
+                std::optional<std::string>((tmp_dir / "eth_funding.csv").string()),
+                std::nullopt,
+                std::optional<std::string>((tmp_dir / "eth_index.csv").string()) },
+        });
+        auto apply_rows = [&]() {
+            auto cfg = exchange.simulation_config();
+            cfg.replay_row_payload_enabled = rows_enabled;
+            exchange.apply_simulation_config(cfg);
+        };
+        if (switch_after_steps == 0) {
+            apply_rows();
+        }
+        auto market_channel = exchange.get_market_channel();
+        std::vector<FrameSignature> frames;
+        while (exchange.step()) {
+            auto dto = market_channel->Receive();
+            if (!dto.has_value()) {
+                ADD_FAILURE() << "missing market payload";
+                break;
+            }
+            const auto& payload = *dto->get();
+            EXPECT_EQ(payload.symbol_count(), 2u);
+            if (frames.size() >= switch_after_steps) {
+                EXPECT_EQ(payload.trade_klines_by_id.empty(), !rows_enabled);
+            }
+            FrameSignature sig{};
+            sig.ts = payload.Timestamp;
+            for (size_t i = 0; i < payload.symbol_count(); ++i) {
+                if (const auto bar = payload.trade_bar(i)) {
+                    EXPECT_EQ(payload.trade_close(i), bar->close);
+                    sig.trades.emplace_back(i, bar->close, bar->quote_volume, bar->taker_buy_base_volume);
+                }
+                if (const auto mark = payload.mark_close(i)) {
+                    sig.marks.emplace_back(i, *mark);
+                }
+                if (const auto index = payload.index_close(i)) {
+                    sig.indexes.emplace_back(i, *index);
+                }
+                if (const auto funding = payload.funding(i)) {
+                    sig.fundings.emplace_back(i, funding->FundingTime, funding->Rate, funding->MarkPrice);
+                }
+            }
+            frames.push_back(std::move(sig));
+            if (frames.size() == switch_after_steps) {
+                apply_rows();
+            }
+        }
+        return frames;
+    };
+
+    const auto row_frames = run_case(true, 0);
+    ASSERT_EQ(row_frames.size(), 4u);
+    EXPECT_EQ(row_frames[1].trades.size(), 2u);
+    EXPECT_EQ(row_frames[1].fundings.size(), 1u);
+    EXPECT_EQ(row_frames[3].fundings,
+        (std::vector<std::tuple<size_t, uint64_t, double, std::optional<double>>>{
+            { 1, 180000, -0.002, std::nullopt } }));
+
+    EXPECT_EQ(run_case(false, 0), row_frames);
+    EXPECT_EQ(run_case(true, 2), row_frames);
+}
+
+TEST_F(BinanceExchangeFixture, DefaultStepPayloadCarriesOnlyTheFrame)
+{
+    WriteCsv("btc.csv", {
+        {      0, 1,1,1,1,100, 59999,100,1,0,0 },
+        {  60000, 2,2,2,2,200,119999,200,1,0,0 }
+    });
+    WriteFundingCsv("btc_funding.csv", {
+        {  60000, 0.001, 2.0 }
+    });
+
+    BinanceExchange exchange = MakeExchange({
+        { "BTCUSDT", (tmp_dir / "btc.csv").string(),
+            std::optional<std::string>((tmp_dir / "btc_funding.csv").string()) },
+    });
+    EXPECT_FALSE(exchange.simulation_config().replay_row_payload_enabled);
+
+    auto market_channel = exchange.get_market_channel();
+    size_t steps = 0;
+    while (exchange.step()) {
+        auto dto = market_channel->Receive();
+        ASSERT_TRUE(dto.has_value());
+        const auto& payload = *dto->get();
+        EXPECT_TRUE(payload.trade_klines_by_id.empty());
+        EXPECT_TRUE(payload.mark_klines_by_id.empty());
+        EXPECT_TRUE(payload.index_klines_by_id.empty());
+        EXPECT_TRUE(payload.funding_by_id.empty());
+        ASSERT_EQ(payload.symbol_count(), 1u);
+        EXPECT_EQ(payload.trade_close(0), std::optional<double>(static_cast<double>(steps + 1)));
+        ++steps;
+    }
+    EXPECT_EQ(steps, 2u);
+}
+
 TEST_F(BinanceExchangeFixture, StepSuccessPublishesMarketChannel)
 {
     WriteCsv("btc.csv", {
@@ -2985,9 +3320,9 @@ TEST_F(BinanceExchangeFixture, FundingTimestampParticipatesInStepTimelineInCurre
     auto step2 = market_channel->Receive();
     ASSERT_TRUE(step2.has_value());
     EXPECT_EQ(step2->get()->Timestamp, 60000u);
-    ASSERT_EQ(step2->get()->funding_by_id.size(), 1u);
-    EXPECT_TRUE(step2->get()->funding_by_id[0].has_value());
-    EXPECT_FALSE(step2->get()->trade_klines_by_id[0].has_value());
+    ASSERT_EQ(step2->get()->symbol_count(), 1u);
+    EXPECT_TRUE(step2->get()->has_funding(0));
+    EXPECT_FALSE(step2->get()->has_trade_kline(0));
     ASSERT_TRUE(exchange.step());
     auto step3 = market_channel->Receive();
     ASSERT_TRUE(step3.has_value());
@@ -3032,17 +3367,17 @@ TEST_F(BinanceExchangeFixture, FundingTimelineUsesEarliestDueTimestampAcrossSymb
     auto step2 = market_channel->Receive();
     ASSERT_TRUE(step2.has_value());
     EXPECT_EQ(step2->get()->Timestamp, 30000u);
-    ASSERT_EQ(step2->get()->funding_by_id.size(), 2u);
-    EXPECT_TRUE(step2->get()->funding_by_id[0].has_value());
-    EXPECT_FALSE(step2->get()->funding_by_id[1].has_value());
+    ASSERT_EQ(step2->get()->symbol_count(), 2u);
+    EXPECT_TRUE(step2->get()->has_funding(0));
+    EXPECT_FALSE(step2->get()->has_funding(1));
 
     ASSERT_TRUE(exchange.step());
     auto step3 = market_channel->Receive();
     ASSERT_TRUE(step3.has_value());
     EXPECT_EQ(step3->get()->Timestamp, 60000u);
-    ASSERT_EQ(step3->get()->funding_by_id.size(), 2u);
-    EXPECT_FALSE(step3->get()->funding_by_id[0].has_value());
-    EXPECT_TRUE(step3->get()->funding_by_id[1].has_value());
+    ASSERT_EQ(step3->get()->symbol_count(), 2u);
+    EXPECT_FALSE(step3->get()->has_funding(0));
+    EXPECT_TRUE(step3->get()->has_funding(1));
 
     ASSERT_TRUE(exchange.step());
     auto step4 = market_channel->Receive();
@@ -3086,8 +3421,8 @@ TEST_F(BinanceExchangeFixture, FundingUsesRawMarkDatasetWhenFundingMarkMissingIn
     auto funding_step = market_channel->Receive();
     ASSERT_TRUE(funding_step.has_value());
     EXPECT_EQ(funding_step->get()->Timestamp, 60000u);
-    ASSERT_EQ(funding_step->get()->mark_klines_by_id.size(), 1u);
-    ASSERT_TRUE(funding_step->get()->mark_klines_by_id[0].has_value());
+    ASSERT_EQ(funding_step->get()->symbol_count(), 1u);
+    ASSERT_TRUE(funding_step->get()->mark_close(0).has_value());
 
     exchange.FillStatusSnapshot(snapshot);
     EXPECT_NEAR(snapshot.wallet_balance - wallet_after_entry, -0.11, 1e-6);
@@ -3131,8 +3466,8 @@ TEST_F(BinanceExchangeFixture, FundingMarkMissingWithoutExactRawMarkStillSkipsIn
     auto funding_step = market_channel->Receive();
     ASSERT_TRUE(funding_step.has_value());
     EXPECT_EQ(funding_step->get()->Timestamp, 60000u);
-    ASSERT_EQ(funding_step->get()->mark_klines_by_id.size(), 1u);
-    EXPECT_FALSE(funding_step->get()->mark_klines_by_id[0].has_value());
+    ASSERT_EQ(funding_step->get()->symbol_count(), 1u);
+    EXPECT_FALSE(funding_step->get()->mark_close(0).has_value());
 
     exchange.FillStatusSnapshot(snapshot);
     EXPECT_NEAR(snapshot.wallet_balance - wallet_after_entry, -0.11, 1e-9);
@@ -11,8 +11,10 @@
 #undef private
 #include "Exchanges/BinanceSimulator/Contracts/OrderRejectInfo.hpp"
 #include "Exchanges/BinanceSimulator/State/BinanceExchangeRuntimeState.hpp"
+#include "Exchanges/BinanceSimulator/State/SnapshotState.hpp"
 #include "Exchanges/BinanceSimulator/State/StepKernelState.hpp"
 #include "ReplaySemanticsInputPinning.hpp"
+#include "TestEnv.hpp"
 
 using namespace QTrading::Dto::Market::Binance;
 using namespace QTrading::Utils::Queue;
@@ -115,6 +117,15 @@ public:
         impl_.apply_simulation_config(cfg);
     }
 
+    void set_step_worker_count(uint32_t workers)
+    {
+        auto cfg = impl_.simulation_config();
+        cfg.step_worker_count = workers;
+        impl_.apply_simulation_config(cfg);
+    }
+
+    const std::vector<size_t>& dirty_price_symbol_ids() const { return impl_.snapshot_state_->dirty_price_symbol_ids; }
+
     void set_uncertainty_band_bps(double bps)
     {
         auto cfg = impl_.simulation_config();
@@ -169,24 +180,6 @@ class MockLogger : public QTrading::Log::Logger {
 
 namespace {
 
-void set_env_var(const char* key, const char* value)
-{
-#ifdef _WIN32
-    _putenv_s(key, value);
-#else
-    setenv(key, value, 1);
-#endif
-}
-
-void unset_env_var(const char* key)
-{
-#ifdef _WIN32
-    _putenv_s(key, "");
-#else
-    unsetenv(key);
-#endif
-}
-
 class ScopedEnvVar {
 public:
     ScopedEnvVar(const char* key, const char* value)
@@ -332,22 +325,22 @@ TEST_F(BinanceExchangeFixture, SymbolsSynchronisedWithHoles)
     const auto eth_id = find_id("ETHUSDT");
     ASSERT_LT(btc_id, symbols->size());
     ASSERT_LT(eth_id, symbols->size());
-    EXPECT_TRUE(dto1->get()->trade_klines_by_id[btc_id].has_value());
-    EXPECT_FALSE(dto1->get()->trade_klines_by_id[eth_id].has_value());
+    EXPECT_TRUE(dto1->get()->has_trade_kline(btc_id));
+    EXPECT_FALSE(dto1->get()->has_trade_kline(eth_id));
 
     // ---------- step #2  (t = 30 000) -----
     ASSERT_TRUE(ex.step());
     auto dto2 = mCh->Receive();
     EXPECT_EQ(dto2->get()->Timestamp, 30000u);
-    EXPECT_FALSE(dto2->get()->trade_klines_by_id[btc_id].has_value());
-    EXPECT_TRUE(dto2->get()->trade_klines_by_id[eth_id].has_value());
+    EXPECT_FALSE(dto2->get()->has_trade_kline(btc_id));
+    EXPECT_TRUE(dto2->get()->has_trade_kline(eth_id));
 
     // ---------- step #3  (t = 60 000) -----
     ASSERT_TRUE(ex.step());
     auto dto3 = mCh->Receive();
     EXPECT_EQ(dto3->get()->Timestamp, 60000u);
-    EXPECT_TRUE(dto3->get()->trade_klines_by_id[btc_id].has_value());
-    EXPECT_TRUE(dto3->get()->trade_klines_by_id[eth_id].has_value());
+    EXPECT_TRUE(dto3->get()->has_trade_kline(btc_id));
+    EXPECT_TRUE(dto3->get()->has_trade_kline(eth_id));
 
     // ---------- step #4  (EOF) ------------
     EXPECT_FALSE(ex.step());          // nothing left
@@ -602,6 +595,45 @@ TEST_F(BinanceExchangeFixture, SnapshotConsistent)
     EXPECT_TRUE(ex.get_all_open_orders().empty());
 }
 
+/// @brief Interning is idempotent and ids map back to their symbol text.
+TEST(SymbolTableTests, InternAssignsStableIdsAndResolvesNames)
+{
+    using QTrading::Dto::Trading::SymbolTable;
+    const std::string symbol = std::string("SYMTABLE_") + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    EXPECT_FALSE(SymbolTable::Find(symbol).has_value());
+
+    const auto id = SymbolTable::Intern(symbol);
+    EXPECT_NE(id, QTrading::Dto::Trading::kInvalidSymbolId);
+    EXPECT_EQ(SymbolTable::Intern(symbol), id);
+    EXPECT_EQ(SymbolTable::Find(symbol), std::optional<QTrading::Dto::Trading::SymbolId>(id));
+    EXPECT_EQ(SymbolTable::Name(id), symbol);
+    EXPECT_LT(id, SymbolTable::Size());
+    EXPECT_NE(SymbolTable::Intern(symbol + "_OTHER"), id);
+}
+
+/// @brief Orders and the positions they open carry the interned id of their symbol.
+TEST_F(BinanceExchangeFixture, OrdersAndPositionsCarryInternedSymbolIds)
+{
+    writeCsv("btc.csv", {
+        {0,1,1,1,1,10, 30000,10,1,0,0},
+        {60000,1,1,1,1,10, 90000,10,1,0,0}
+        });
+
+    BinanceExchange ex({ {"BTCUSDT",(tmpDir / "btc.csv").string()} }, logger, /*balance*/ 500.0);
+    const auto btc_id = QTrading::Dto::Trading::SymbolTable::Find("BTCUSDT");
+    ASSERT_TRUE(btc_id.has_value());
+
+    using QTrading::Dto::Trading::OrderSide;
+    ASSERT_TRUE(ex.perp.place_order("BTCUSDT", 0.5, 0.5, OrderSide::Buy));
+    ASSERT_EQ(ex.get_all_open_orders().size(), 1u);
+    EXPECT_EQ(ex.get_all_open_orders()[0].interned_symbol_id, *btc_id);
+
+    ASSERT_TRUE(ex.perp.place_order("BTCUSDT", 0.5, OrderSide::Buy));
+    ex.step();
+    ASSERT_EQ(ex.get_all_positions().size(), 1u);
+    EXPECT_EQ(ex.get_all_positions()[0].interned_symbol_id, *btc_id);
+}
+
 TEST_F(BinanceExchangeFixture, ConstructWithAccountInitConfig)
 {
     writeCsv("btc.csv", {
@@ -2125,6 +2157,87 @@ TEST_F(BinanceExchangeFixture, FundingApplyTimingControlsSameTimestampFunding)
     EXPECT_NEAR(before_matching - after_matching, 0.1, 1e-6);
 }
 
+/// @brief Sharded matching and funding settle in symbol order, bit-identical to one thread.
+TEST_F(BinanceExchangeFixture, StepWorkerPoolMatchesSerialStep)
+{
+    constexpr size_t kSymbols = 96; // three shards at the 32-symbol grain
+    std::vector<BinanceExchange::SymbolDataset> datasets;
+    for (size_t s = 0; s < kSymbols; ++s) {
+        const std::string name = "SYM" + std::to_string(s);
+        const double base = 100.0 + static_cast<double>(s);
+        writeCsv(name + ".csv", {
+            {      0, base,     base + 2, base - 2, base + 1, 40,  30000, 100, 1, 20, 0 },
+            {  60000, base + 1, base + 3, base - 1, base - 1,  2,  90000, 100, 1,  1, 0 },
+            { 120000, base - 1, base + 1, base - 4, base - 3, 40, 150000, 100, 1, 10, 0 },
+            { 180000, base - 3, base + 2, base - 3, base + 2, 40, 210000, 100, 1, 30, 0 }
+            });
+        writeFundingCsv(name + "_funding.csv", {
+            {  60000, 0.0001 * static_cast<double>(s % 7 + 1), base + 0.5 },
+            { 150000, -0.0003, (s % 3 == 0) ? std::nullopt : std::optional<double>(base) }
+            });
+        datasets.push_back({ name + "USDT", (tmpDir / (name + ".csv")).string(),
+            std::optional<std::string>((tmpDir / (name + "_funding.csv")).string()) });
+    }
+
+    struct RunResult {
+        std::vector<std::vector<double>> balances;
+        std::vector<std::vector<size_t>> dirty_price_symbol_ids;
+        std::vector<QTrading::dto::Position> positions;
+        std::vector<QTrading::dto::Order> open_orders;
+        uint64_t funding_applied{ 0 };
+        uint64_t funding_skipped_no_mark{ 0 };
+    };
+    auto run_case = [&](uint32_t workers) {
+        BinanceExchange ex(datasets, logger, MakeAccountInitConfig(1'000'000.0));
+        ex.set_step_worker_count(workers);
+        using QTrading::Dto::Trading::OrderSide;
+        using QTrading::Dto::Trading::PositionSide;
+        for (size_t s = 0; s < kSymbols; ++s) {
+            const std::string symbol = "SYM" + std::to_string(s) + "USDT";
+            const double base = 100.0 + static_cast<double>(s);
+            const bool buy = s % 2 == 0;
+            EXPECT_TRUE(ex.perp.place_order(symbol, 2.0, buy ? OrderSide::Buy : OrderSide::Sell));
+            EXPECT_TRUE(ex.perp.place_order(symbol, 1.5, buy ? base - 2.0 : base + 2.5,
+                buy ? OrderSide::Buy : OrderSide::Sell));
+            EXPECT_TRUE(ex.perp.place_order(symbol, 1.0, buy ? base - 0.5 : base + 2.0,
+                buy ? OrderSide::Buy : OrderSide::Sell));
+        }
+
+        RunResult result{};
+        BinanceExchange::StatusSnapshot snap{};
+        for (size_t step = 0; ex.step(); ++step) {
+            if (step == 0) {
+                for (size_t s = 0; s < kSymbols; s += 2) {
+                    const std::string symbol = "SYM" + std::to_string(s) + "USDT";
+                    EXPECT_TRUE(ex.perp.place_order(symbol, 0.5, 100.0 + static_cast<double>(s),
+                        OrderSide::Sell, PositionSide::Both, /*reduce_only=*/true));
+                }
+            }
+            ex.FillStatusSnapshot(snap);
+            result.balances.push_back({ snap.wallet_balance, snap.margin_balance, snap.available_balance,
+                snap.total_unrealized_pnl, snap.total_ledger_value });
+            result.dirty_price_symbol_ids.push_back(ex.dirty_price_symbol_ids());
+        }
+        result.positions = ex.get_all_positions();
+        result.open_orders = ex.get_all_open_orders();
+        result.funding_applied = snap.funding_applied_events;
+        result.funding_skipped_no_mark = snap.funding_skipped_no_mark;
+        return result;
+    };
+
+    const auto serial = run_case(1);
+    const auto sharded = run_case(4);
+    ASSERT_FALSE(serial.positions.empty());
+    ASSERT_GT(serial.funding_applied, 0u);
+    // Bit-identical, not approximately equal: fills and wallet deltas settle in serial order.
+    EXPECT_EQ(sharded.balances, serial.balances);
+    EXPECT_EQ(sharded.dirty_price_symbol_ids, serial.dirty_price_symbol_ids);
+    EXPECT_EQ(sharded.positions, serial.positions);
+    EXPECT_EQ(sharded.open_orders, serial.open_orders);
+    EXPECT_EQ(sharded.funding_applied, serial.funding_applied);
+    EXPECT_EQ(sharded.funding_skipped_no_mark, serial.funding_skipped_no_mark);
+}
+
 TEST_F(BinanceExchangeFixture, MarketSnapshotFundingUsesPreviousPeriodUntilUpdateIsApplied)
 {
     writeCsv("btc.csv", {
@@ -2169,13 +2282,13 @@ TEST_F(BinanceExchangeFixture, MarketSnapshotFundingUsesPreviousPeriodUntilUpdat
         if (!dto2->get()->symbols ||
             dto2->get()->symbols->size() != 1u ||
             (*dto2->get()->symbols)[0] != "BTCUSDT" ||
-            dto2->get()->funding_by_id.size() != 1u ||
-            !dto2->get()->funding_by_id[0].has_value())
+            dto2->get()->symbol_count() != 1u ||
+            !dto2->get()->has_funding(0))
         {
             ADD_FAILURE() << "unexpected funding snapshot shape";
             return std::numeric_limits<double>::quiet_NaN();
         }
-        return dto2->get()->funding_by_id[0]->Rate;
+        return dto2->get()->funding(0)->Rate;
     };
 
     const double before_matching = funding_seen_at_step2(BinanceExchange::FundingApplyTiming::BeforeMatching);
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <Data/Binance/BinaryCache.hpp>
+#include <Data/Binance/FundingRateData.hpp>
+#include <Data/Binance/MarketData.hpp>
+#include "TestEnv.hpp"
+
+namespace {
+
+namespace Cache = QTrading::Infra::Data::Binance;
+
+void write_kline_csv(const std::string& path, double first_close)
+{
+    boost::filesystem::ofstream ofs(path);
+    ofs << "OpenTime,OpenPrice,HighPrice,LowPrice,ClosePrice,Volume,CloseTime,QuoteVolume,TradeCount,TakerBuyBaseVolume,TakerBuyQuoteVolume\n";
+    ofs << "1733497320000,7020,7100,7000,7050,200,1733497379999,1400000,80,40,280000\n";
+    ofs << "1733497260000,7000,7050,6950," << first_close << ",100,1733497319999,700000,50,20,140000\n";
+}
+
+size_t count_cache_files(const std::string& dir)
+{
+    size_t count = 0;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        if (entry.path().extension() == ".qtrc") {
+            ++count;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+/// @brief Enables the binary cache in a scratch directory for each test.
+class BinaryCacheTests : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Per-test paths: ctest runs each case as its own process, possibly in parallel.
+        const std::string name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        kline_csv_ = "test_cache_kline_" + name + ".csv";
+        funding_csv_ = "test_cache_funding_" + name + ".csv";
+        cache_dir_ = "test_binary_cache_" + name;
+        std::filesystem::remove_all(cache_dir_);
+        set_env_var(Cache::kBinaryCacheDirEnv, cache_dir_.c_str());
+    }
+
+    void TearDown() override {
+        unset_env_var(Cache::kBinaryCacheDirEnv);
+        std::filesystem::remove_all(cache_dir_);
+        boost::filesystem::remove(kline_csv_);
+        boost::filesystem::remove(funding_csv_);
+    }
+
+    std::string kline_csv_;
+    std::string funding_csv_;
+    std::string cache_dir_;
+};
+
+/// @brief First load writes the cache; second load maps it and yields identical sorted rows.
+TEST_F(BinaryCacheTests, KlineCacheRoundTripMatchesCsv) {
+    write_kline_csv(kline_csv_, 7020.0);
+
+    MarketData parsed("BTCUSDT", kline_csv_);
+    EXPECT_EQ(count_cache_files(cache_dir_), 1u);
+
+    MarketData cached("BTCUSDT", kline_csv_);
+    EXPECT_TRUE(parsed.is_memory_mapped());
+    EXPECT_TRUE(cached.is_memory_mapped());
+    ASSERT_EQ(cached.get_klines_count(), parsed.get_klines_count());
+    for (size_t i = 0; i < parsed.get_klines_count(); ++i) {
+        const auto& a = parsed.get_kline(i);
+        const auto& b = cached.get_kline(i);
+        EXPECT_EQ(a.Timestamp, b.Timestamp);
+        EXPECT_DOUBLE_EQ(a.OpenPrice, b.OpenPrice);
+        EXPECT_DOUBLE_EQ(a.HighPrice, b.HighPrice);
+        EXPECT_DOUBLE_EQ(a.LowPrice, b.LowPrice);
+        EXPECT_DOUBLE_EQ(a.ClosePrice, b.ClosePrice);
+        EXPECT_DOUBLE_EQ(a.Volume, b.Volume);
+        EXPECT_EQ(a.CloseTime, b.CloseTime);
+        EXPECT_EQ(a.CloseDateTime, b.CloseDateTime);
+        EXPECT_DOUBLE_EQ(a.QuoteVolume, b.QuoteVolume);
+        EXPECT_EQ(a.TradeCount, b.TradeCount);
+        EXPECT_DOUBLE_EQ(a.TakerBuyBaseVolume, b.TakerBuyBaseVolume);
+        EXPECT_DOUBLE_EQ(a.TakerBuyQuoteVolume, b.TakerBuyQuoteVolume);
+    }
+    EXPECT_EQ(cached.get_kline(0).Timestamp, 1733497260000u);
+}
+
+/// @brief Cache freshness is keyed on size + mtime: a same-stamp source is served from cache.
+TEST_F(BinaryCacheTests, KlineCacheServedWhenStampUnchanged) {
+    write_kline_csv(kline_csv_, 7020.0);
+    const auto mtime = std::filesystem::last_write_time(kline_csv_);
+    { MarketData warm("BTCUSDT", kline_csv_); }
+
+    // Same byte length, same mtime, different content: only the cache can yield 7020.
+    write_kline_csv(kline_csv_, 7021.0);
+    std::filesystem::last_write_time(kline_csv_, mtime);
+
+    MarketData md("BTCUSDT", kline_csv_);
+    EXPECT_DOUBLE_EQ(md.get_kline(0).ClosePrice, 7020.0);
+}
+
+/// @brief A stale cache (source size changed) falls back to CSV and is rewritten.
+TEST_F(BinaryCacheTests, KlineCacheStaleFallsBackToCsv) {
+    write_kline_csv(kline_csv_, 7020.0);
+    { MarketData warm("BTCUSDT", kline_csv_); }
+
+    write_kline_csv(kline_csv_, 7020.25);
+    MarketData md("BTCUSDT", kline_csv_);
+    EXPECT_DOUBLE_EQ(md.get_kline(0).ClosePrice, 7020.25);
+
+    MarketData again("BTCUSDT", kline_csv_);
+    EXPECT_DOUBLE_EQ(again.get_kline(0).ClosePrice, 7020.25);
+}
+
+/// @brief A truncated cache file is rejected rather than read past its end.
+TEST_F(BinaryCacheTests, TruncatedCacheIsIgnored) {
+    write_kline_csv(kline_csv_, 7020.0);
+    { MarketData warm("BTCUSDT", kline_csv_); }
+
+    const auto stamp = Cache::StampSource(kline_csv_);
+    ASSERT_TRUE(stamp.has_value());
+    const auto cache_file = Cache::CacheFilePath(
+        cache_dir_, kline_csv_, *stamp, Cache::CacheStreamKind::TradeKline);
+    ASSERT_TRUE(std::filesystem::exists(cache_file));
+    std::filesystem::resize_file(cache_file, 100);
+    EXPECT_EQ(Cache::MappedCacheFile::Open(cache_file, *stamp, Cache::CacheStreamKind::TradeKline), nullptr);
+
+    MarketData md("BTCUSDT", kline_csv_);
+    EXPECT_EQ(md.get_klines_count(), 2u);
+}
+
+/// @brief Funding cache keeps optional mark prices intact.
+TEST_F(BinaryCacheTests, FundingCacheRoundTripKeepsOptionalMark) {
+    {
+        boost::filesystem::ofstream ofs(funding_csv_);
+        ofs << "FundingTime,Rate,MarkPrice\n";
+        ofs << "1733497260000,0.0001,7001.5\n";
+        ofs << "1733497320000,-0.0002,\n";
+    }
+
+    { FundingRateData warm("BTCUSDT", funding_csv_); }
+    EXPECT_EQ(count_cache_files(cache_dir_), 1u);
+
+    FundingRateData fd("BTCUSDT", funding_csv_);
+    ASSERT_EQ(fd.get_count(), 2u);
+    EXPECT_EQ(fd.get_funding(0).FundingTime, 1733497260000u);
+    EXPECT_EQ(fd.get_funding(0).Timestamp, 1733497260000u);
+    ASSERT_TRUE(fd.get_funding(0).MarkPrice.has_value());
+    EXPECT_DOUBLE_EQ(*fd.get_funding(0).MarkPrice, 7001.5);
+    EXPECT_DOUBLE_EQ(fd.get_funding(1).Rate, -0.0002);
+    EXPECT_FALSE(fd.get_funding(1).MarkPrice.has_value());
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <Data/Binance/CsvSeekIndex.hpp>
+#include <Data/Binance/MarketData.hpp>
+#include "TestEnv.hpp"
+
+namespace {
+
+namespace Cache = QTrading::Infra::Data::Binance;
+
+constexpr uint64_t kBaseTs = 1733497260000ull;
+constexpr uint64_t kMinuteMs = 60000ull;
+
+/// @brief Writes `rows` one-minute bars; close price equals the row number.
+/// @brief Per-test CSV path so parallel test processes never share a file.
+std::string seek_csv_path()
+{
+    return std::string("test_seek_index_") +
+        ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".csv";
+}
+
+void write_minute_csv(size_t rows, const char* eol, bool swap_first_pair)
+{
+    boost::filesystem::ofstream ofs(seek_csv_path(), std::ios::binary);
+    ofs << "OpenTime,OpenPrice,HighPrice,LowPrice,ClosePrice,Volume,CloseTime,QuoteVolume,TradeCount,TakerBuyBaseVolume,TakerBuyQuoteVolume" << eol;
+    for (size_t i = 0; i < rows; ++i) {
+        size_t row = i;
+        if (swap_first_pair && i < 2) {
+            row = 1 - i;
+        }
+        const uint64_t ts = kBaseTs + row * kMinuteMs;
+        ofs << ts << ",1,1,1," << row << ",1," << (ts + kMinuteMs - 1) << ",1,1,1,1" << eol;
+    }
+}
+
+void set_window(size_t first_row, size_t last_row)
+{
+    set_env_var("QTR_SIM_START_TS_MS", std::to_string(kBaseTs + first_row * kMinuteMs).c_str());
+    set_env_var("QTR_SIM_END_TS_MS", std::to_string(kBaseTs + last_row * kMinuteMs).c_str());
+}
+
+std::shared_ptr<const Cache::CsvSeekIndex> find_index()
+{
+    const auto stamp = Cache::StampSource(std::filesystem::path(seek_csv_path()));
+    return stamp.has_value() ? Cache::FindCsvSeekIndex(*stamp) : nullptr;
+}
+
+void expect_window(const MarketData& md, size_t first_row, size_t last_row)
+{
+    ASSERT_EQ(md.get_klines_count(), last_row - first_row + 1);
+    for (size_t i = 0; i < md.get_klines_count(); ++i) {
+        EXPECT_EQ(md.timestamps()[i], kBaseTs + (first_row + i) * kMinuteMs);
+        EXPECT_DOUBLE_EQ(md.close_prices()[i], static_cast<double>(first_row + i));
+    }
+}
+
+} // namespace
+
+/// @brief Runs without a binary cache so loads go through the CSV path.
+class CsvSeekIndexTests : public ::testing::Test {
+protected:
+    void SetUp() override {
+        unset_env_var(Cache::kBinaryCacheDirEnv);
+    }
+
+    void TearDown() override {
+        unset_env_var("QTR_SIM_START_TS_MS");
+        unset_env_var("QTR_SIM_END_TS_MS");
+        boost::filesystem::remove(seek_csv_path());
+    }
+};
+
+/// @brief A full read records one entry per stride and marks ordered files seekable.
+TEST_F(CsvSeekIndexTests, FullReadPublishesSparseIndex)
+{
+    write_minute_csv(3000, "\n", false);
+    MarketData md("BTCUSDT", seek_csv_path());
+    ASSERT_EQ(md.get_klines_count(), 3000u);
+
+    const auto index = find_index();
+    ASSERT_NE(index, nullptr);
+    EXPECT_TRUE(index->monotonic);
+    ASSERT_EQ(index->timestamps.size(), 3u);
+    EXPECT_EQ(index->timestamps[1], kBaseTs + Cache::kCsvSeekIndexStride * kMinuteMs);
+    EXPECT_EQ(index->seek_offset(kBaseTs), index->data_offset);
+    EXPECT_EQ(index->seek_offset(index->timestamps[2] + 1), index->offsets[2]);
+}
+
+/// @brief Windowed loads after indexing seek into the file and match the filtered rows.
+TEST_F(CsvSeekIndexTests, WindowedLoadSeeksToWindow)
+{
+    write_minute_csv(5000, "\n", false);
+    set_window(2100, 2200);
+    MarketData first("BTCUSDT", seek_csv_path());
+    expect_window(first, 2100, 2200);
+    ASSERT_NE(find_index(), nullptr);
+
+    MarketData seeked("BTCUSDT", seek_csv_path());
+    expect_window(seeked, 2100, 2200);
+
+    set_window(1024, 4999);
+    MarketData boundary("BTCUSDT", seek_csv_path());
+    expect_window(boundary, 1024, 4999);
+}
+
+/// @brief CRLF line endings keep offsets and values intact.
+TEST_F(CsvSeekIndexTests, CrlfFileSeeksCorrectly)
+{
+    write_minute_csv(2500, "\r\n", false);
+    set_window(2048, 2060);
+    MarketData first("BTCUSDT", seek_csv_path());
+    MarketData seeked("BTCUSDT", seek_csv_path());
+    expect_window(first, 2048, 2060);
+    expect_window(seeked, 2048, 2060);
+}
+
+/// @brief Unordered files are indexed as non-seekable and still load sorted.
+TEST_F(CsvSeekIndexTests, UnorderedFileFallsBackToFullScan)
+{
+    write_minute_csv(2000, "\n", true);
+    set_window(0, 1500);
+    MarketData first("BTCUSDT", seek_csv_path());
+    const auto index = find_index();
+    ASSERT_NE(index, nullptr);
+    EXPECT_FALSE(index->monotonic);
+
+    MarketData second("BTCUSDT", seek_csv_path());
+    expect_window(first, 0, 1500);
+    expect_window(second, 0, 1500);
+}
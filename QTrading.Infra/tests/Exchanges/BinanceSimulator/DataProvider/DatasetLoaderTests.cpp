@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Exchanges/BinanceSimulator/Bootstrap/DatasetLoader.hpp"
+
+using QTrading::Infra::Exchanges::BinanceSim::Bootstrap::DatasetLoadOptions;
+using QTrading::Infra::Exchanges::BinanceSim::Bootstrap::DatasetLoadProgress;
+using QTrading::Infra::Exchanges::BinanceSim::Bootstrap::LoadDatasets;
+using QTrading::Infra::Exchanges::BinanceSim::Contracts::SymbolDataset;
+
+namespace {
+
+std::string write_kline_csv(const std::string& name, double close)
+{
+    const std::string path = "test_loader_" + name + ".csv";
+    boost::filesystem::ofstream ofs(path);
+    ofs << "OpenTime,OpenPrice,HighPrice,LowPrice,ClosePrice,Volume,CloseTime,QuoteVolume,TradeCount,TakerBuyBaseVolume,TakerBuyQuoteVolume\n";
+    ofs << "1733497260000,100," << close << ",99," << close << ",10,1733497319999,1000,5,4,400\n";
+    return path;
+}
+
+std::string write_funding_csv(const std::string& name, double rate)
+{
+    const std::string path = "test_loader_" + name + "_funding.csv";
+    boost::filesystem::ofstream ofs(path);
+    ofs << "FundingTime,Rate,MarkPrice\n";
+    ofs << "1733497260000," << rate << ",100\n";
+    return path;
+}
+
+} // namespace
+
+/// @brief Writes a mixed universe: every symbol has klines, only some have funding/mark/index.
+class DatasetLoaderTests : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (size_t i = 0; i < 6; ++i) {
+            SymbolDataset ds{};
+            ds.symbol = "SYM" + std::to_string(i);
+            ds.kline_csv = track(write_kline_csv(ds.symbol, 100.0 + static_cast<double>(i)));
+            if (i % 2 == 0) {
+                ds.funding_csv = track(write_funding_csv(ds.symbol, 0.0001 * static_cast<double>(i + 1)));
+                ds.mark_kline_csv = track(write_kline_csv(ds.symbol + "_mark", 200.0 + static_cast<double>(i)));
+            }
+            if (i % 3 == 0) {
+                ds.index_kline_csv = track(write_kline_csv(ds.symbol + "_index", 300.0 + static_cast<double>(i)));
+            }
+            datasets.push_back(ds);
+        }
+    }
+
+    void TearDown() override {
+        for (const auto& path : files) {
+            boost::filesystem::remove(path);
+        }
+    }
+
+    std::string track(std::string path) {
+        files.push_back(path);
+        return path;
+    }
+
+    std::vector<SymbolDataset> datasets;
+    std::vector<std::string> files;
+};
+
+/// @brief Pools and ids follow input order regardless of worker count.
+TEST_F(DatasetLoaderTests, ParallelLoadMatchesSerialOrder) {
+    DatasetLoadOptions serial{};
+    serial.max_parallelism = 1;
+    DatasetLoadOptions parallel{};
+    parallel.max_parallelism = 4;
+
+    const auto a = LoadDatasets(datasets, serial);
+    const auto b = LoadDatasets(datasets, parallel);
+
+    ASSERT_EQ(a.market_data.size(), 6u);
+    ASSERT_EQ(b.market_data.size(), 6u);
+    EXPECT_EQ(a.funding_data_id_by_symbol, (std::vector<int32_t>{ 0, -1, 1, -1, 2, -1 }));
+    EXPECT_EQ(a.mark_data_id_by_symbol, (std::vector<int32_t>{ 0, -1, 1, -1, 2, -1 }));
+    EXPECT_EQ(a.index_data_id_by_symbol, (std::vector<int32_t>{ 0, -1, -1, 1, -1, -1 }));
+    EXPECT_EQ(b.funding_data_id_by_symbol, a.funding_data_id_by_symbol);
+    EXPECT_EQ(b.mark_data_id_by_symbol, a.mark_data_id_by_symbol);
+    EXPECT_EQ(b.index_data_id_by_symbol, a.index_data_id_by_symbol);
+
+    for (size_t i = 0; i < 6; ++i) {
+        EXPECT_DOUBLE_EQ(b.market_data[i].close_prices()[0], 100.0 + static_cast<double>(i));
+    }
+    ASSERT_EQ(b.funding_data_pool.size(), 3u);
+    EXPECT_DOUBLE_EQ(b.funding_data_pool[2].get_funding(0).Rate, 0.0005);
+    ASSERT_EQ(b.mark_data_pool.size(), 3u);
+    EXPECT_DOUBLE_EQ(b.mark_data_pool[1].close_prices()[0], 202.0);
+    ASSERT_EQ(b.index_data_pool.size(), 2u);
+    EXPECT_DOUBLE_EQ(b.index_data_pool[1].close_prices()[0], 303.0);
+}
+
+/// @brief Progress is reported once per file with a monotonic completed count.
+TEST_F(DatasetLoaderTests, ProgressCallbackReportsEveryFile) {
+    std::vector<size_t> completed;
+    std::set<std::string> paths;
+    size_t total = 0;
+    DatasetLoadOptions options{};
+    options.max_parallelism = 3;
+    options.on_progress = [&](const DatasetLoadProgress& p) {
+        completed.push_back(p.completed_files);
+        paths.insert(*p.path);
+        total = p.total_files;
+    };
+
+    (void)LoadDatasets(datasets, options);
+
+    EXPECT_EQ(total, files.size());
+    ASSERT_EQ(completed.size(), files.size());
+    for (size_t i = 0; i < completed.size(); ++i) {
+        EXPECT_EQ(completed[i], i + 1);
+    }
+    EXPECT_EQ(paths, std::set<std::string>(files.begin(), files.end()));
+}
+
+/// @brief A missing file surfaces the loader exception to the caller.
+TEST_F(DatasetLoaderTests, MissingFileThrows) {
+    datasets[3].kline_csv = "test_loader_missing.csv";
+    DatasetLoadOptions options{};
+    options.max_parallelism = 4;
+    EXPECT_THROW((void)LoadDatasets(datasets, options), std::runtime_error);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <charconv>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <Data/Binance/KlineCsvParser.hpp>
+
+namespace {
+
+namespace Cache = QTrading::Infra::Data::Binance;
+
+const char* kHeader =
+    "OpenTime,OpenPrice,HighPrice,LowPrice,ClosePrice,Volume,CloseTime,QuoteVolume,TradeCount,TakerBuyBaseVolume,TakerBuyQuoteVolume";
+
+std::vector<Cache::CsvScanKernel> supported_kernels()
+{
+    std::vector<Cache::CsvScanKernel> kernels{ Cache::CsvScanKernel::Scalar };
+    const auto best = Cache::DetectCsvScanKernel();
+    if (best >= Cache::CsvScanKernel::Sse2) {
+        kernels.push_back(Cache::CsvScanKernel::Sse2);
+    }
+    if (best >= Cache::CsvScanKernel::Avx2) {
+        kernels.push_back(Cache::CsvScanKernel::Avx2);
+    }
+    return kernels;
+}
+
+Cache::KlineCsvParseResult parse(const std::string& csv, Cache::KlineCsvParseOptions options)
+{
+    std::istringstream in(csv, std::ios::binary);
+    return Cache::ParseKlineCsv(in, options);
+}
+
+std::string make_minute_csv(size_t rows)
+{
+    std::string csv = std::string(kHeader) + "\n";
+    const uint64_t base = 1733497260000ull;
+    for (size_t i = 0; i < rows; ++i) {
+        const uint64_t ts = base + i * 60000ull;
+        const double px = 97000.0 + static_cast<double>(i % 997) * 0.1;
+        csv += std::to_string(ts) + "," + std::to_string(px) + "," + std::to_string(px + 12.5) + "," +
+            std::to_string(px - 8.25) + "," + std::to_string(px + 1.75) + ",123.456," +
+            std::to_string(ts + 59999) + ",11987654.321," + std::to_string(1000 + i % 300) +
+            ",61.728,5993827.1605\n";
+    }
+    return csv;
+}
+
+} // namespace
+
+/// @brief Every kernel and block size yields the same rows, skipping malformed lines.
+TEST(KlineCsvParserTests, KernelsAgreeOnMixedInput)
+{
+    const std::string csv = std::string(kHeader) + "\r\n"
+        "1733497260000,7000,7050.5,6950.25,7020.125,100,1733497319999,700000,50,20,140000\r\n"
+        "not,a,row\r\n"
+        "\r\n"
+        "1733497320000,7020,7100,7000,7050,200,1733497379999,1400000,80,40\r\n"
+        "1733497380000,1.5e3,-0.000123456789012345678,7000,7050,2E2,1733497439999,1400000,80,40,280000,extra\r\n"
+        "1733497440000,7050,7060,7040,7055,1733497499999\n"
+        "1733497500000,7055,7070,7050,7065,1733497559999,\n"
+        "1733497560000,7065,7080,7060,7075,1,1733497619999,1,1,1,1";
+
+    for (const auto kernel : supported_kernels()) {
+        for (const size_t block : { size_t{ 64 }, size_t{ 100 }, size_t{ 1 } << 20 }) {
+            Cache::KlineCsvParseOptions options;
+            options.kernel = kernel;
+            options.block_bytes = block;
+            const auto result = parse(csv, options);
+            ASSERT_EQ(result.kernel, kernel);
+            EXPECT_TRUE(result.header_read);
+            EXPECT_TRUE(result.monotonic);
+
+            const auto& c = result.columns;
+            ASSERT_EQ(c.size(), 6u) << "block=" << block;
+            EXPECT_EQ(c.open_time[0], 1733497260000ull);
+            EXPECT_DOUBLE_EQ(c.high[0], 7050.5);
+            EXPECT_DOUBLE_EQ(c.close[0], 7020.125);
+            EXPECT_EQ(c.trade_count[0], 50);
+            EXPECT_DOUBLE_EQ(c.taker_buy_quote[0], 140000.0);
+
+            // Fewer than 11 fields reads as the compact layout.
+            EXPECT_EQ(c.close_time[1], 200u);
+            EXPECT_DOUBLE_EQ(c.volume[1], 0.0);
+
+            EXPECT_DOUBLE_EQ(c.open[2], 1500.0);
+            EXPECT_EQ(c.high[2], -0.000123456789012345678);
+            EXPECT_DOUBLE_EQ(c.volume[2], 200.0);
+
+            EXPECT_EQ(c.close_time[3], 1733497499999ull);
+            EXPECT_EQ(c.close_time[4], 1733497559999ull);
+            EXPECT_EQ(c.open_time[5], 1733497560000ull);
+            EXPECT_DOUBLE_EQ(c.taker_buy_quote[5], 1.0);
+        }
+    }
+}
+
+/// @brief The fast decimal path rounds exactly like from_chars.
+TEST(KlineCsvParserTests, DecimalsMatchFromChars)
+{
+    const std::vector<std::string> values{
+        "0.1", "97000.123456", "-3.14159265358979", "123456789012345", "0.000000000000001",
+        "1234567890123456", "99999.99999999999", "7.0", "00012.50", "5.", "-0.5",
+        "12345678.1234567", "1.12345678", "123456789.5", "12345678.123456789" };
+    std::string csv = std::string(kHeader) + "\n";
+    for (size_t i = 0; i < values.size(); ++i) {
+        csv += std::to_string(1000 + i) + "," + values[i] + ",1,1,1,1\n";
+    }
+    const auto result = parse(csv, {});
+    ASSERT_EQ(result.columns.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        double expected = 0.0;
+        std::from_chars(values[i].data(), values[i].data() + values[i].size(), expected);
+        EXPECT_EQ(result.columns.open[i], expected) << values[i];
+    }
+}
+
+/// @brief Window bounds skip rows and stop early on ordered input; empty input reports no header.
+TEST(KlineCsvParserTests, WindowAndEmptyInput)
+{
+    const std::string csv = make_minute_csv(100);
+    Cache::KlineCsvParseOptions options;
+    options.window_start = 1733497260000ull + 10 * 60000ull;
+    options.window_end = 1733497260000ull + 19 * 60000ull;
+    options.stop_past_window = true;
+    const auto result = parse(csv, options);
+    ASSERT_EQ(result.columns.size(), 10u);
+    EXPECT_EQ(result.columns.open_time.front(), *options.window_start);
+    EXPECT_EQ(result.columns.open_time.back(), *options.window_end);
+
+    EXPECT_FALSE(parse("", {}).header_read);
+    EXPECT_TRUE(parse(kHeader, {}).header_read);
+}
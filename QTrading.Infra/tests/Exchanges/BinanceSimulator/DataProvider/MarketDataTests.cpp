@@ -2,6 +2,8 @@
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <Data/Binance/MarketData.hpp>
+#include <iterator>
+#include <vector>
 
 static const char* test_csv_filename = "test_kline_data.csv";
 
@@ -148,3 +150,38 @@ TEST_F(MarketDataTests, GetLatestKlineThrowsWhenNoParsedRows)
 
     boost::filesystem::remove(header_only_csv);
 }
+
+/// @brief Verifies column spans line up with row views.
+TEST_F(MarketDataTests, ColumnSpansMatchRowViews)
+{
+    MarketData md("BTCUSDT", test_csv_filename);
+
+    const auto ts = md.timestamps();
+    const auto close = md.close_prices();
+    const auto taker_base = md.taker_buy_base_volumes();
+    ASSERT_EQ(ts.size(), md.get_klines_count());
+    ASSERT_EQ(close.size(), md.get_klines_count());
+    for (size_t i = 0; i < ts.size(); ++i) {
+        const auto row = md.get_kline(i);
+        EXPECT_EQ(ts[i], row.Timestamp);
+        EXPECT_DOUBLE_EQ(close[i], row.ClosePrice);
+        EXPECT_DOUBLE_EQ(taker_base[i], row.TakerBuyBaseVolume);
+        EXPECT_EQ(md.close_times()[i], row.CloseTime);
+        EXPECT_EQ(md.trade_counts()[i], row.TradeCount);
+    }
+    EXPECT_FALSE(md.is_memory_mapped());
+}
+
+/// @brief Verifies copies share storage and keep their columns valid.
+TEST_F(MarketDataTests, CopySharesColumnStorage)
+{
+    std::vector<MarketData> pool;
+    pool.emplace_back("BTCUSDT", test_csv_filename);
+    const MarketData copy = pool.front();
+    pool.emplace_back("ETHUSDT", test_csv_filename);
+    pool.emplace_back("SOLUSDT", test_csv_filename);
+
+    EXPECT_EQ(copy.close_prices().data(), pool.front().close_prices().data());
+    EXPECT_DOUBLE_EQ(copy.get_latest_kline().ClosePrice, 7050.0);
+    EXPECT_EQ(std::distance(copy.begin(), copy.end()), 2);
+}
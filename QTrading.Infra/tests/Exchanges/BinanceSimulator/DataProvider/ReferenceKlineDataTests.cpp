@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <Data/Binance/ReferenceKlineData.hpp>
+
+static const char* test_reference_csv_filename = "test_reference_kline_data.csv";
+
+/// @brief Test fixture for ReferenceKlineData tests.
+///        Writes a compact mark-price CSV with one out-of-order row.
+class ReferenceKlineDataTests : public ::testing::Test {
+protected:
+    void SetUp() override {
+        boost::filesystem::ofstream ofs(test_reference_csv_filename);
+        ofs << "OpenTime,OpenPrice,HighPrice,LowPrice,ClosePrice,CloseTime\n";
+        ofs << "1733497320000,7020,7100,7000,7050,1733497379999\n";
+        ofs << "1733497260000,7000,7050,6950,7020,1733497319999\n";
+        ofs.close();
+    }
+
+    void TearDown() override {
+        boost::filesystem::remove(test_reference_csv_filename);
+    }
+};
+
+/// @brief Verifies OHLC layout keeps every reference column in time order.
+TEST_F(ReferenceKlineDataTests, OhlcLayoutKeepsReferenceColumns) {
+    ReferenceKlineData data("BTCUSDT", test_reference_csv_filename);
+    ASSERT_EQ(data.get_klines_count(), 2u);
+    EXPECT_EQ(data.layout(), ReferenceKlineLayout::Ohlc);
+
+    const auto first = data.get_kline(0);
+    EXPECT_EQ(first.OpenTime, 1733497260000u);
+    EXPECT_DOUBLE_EQ(first.OpenPrice, 7000.0);
+    EXPECT_DOUBLE_EQ(first.HighPrice, 7050.0);
+    EXPECT_DOUBLE_EQ(first.LowPrice, 6950.0);
+    EXPECT_DOUBLE_EQ(first.ClosePrice, 7020.0);
+    EXPECT_EQ(first.CloseTime, 1733497319999u);
+    EXPECT_DOUBLE_EQ(data.get_latest_kline().ClosePrice, 7050.0);
+    EXPECT_DOUBLE_EQ(data.opening_price(), 7000.0);
+    EXPECT_THROW(data.get_kline(2), std::out_of_range);
+}
+
+/// @brief Verifies close-only layout drops OHLC columns but keeps the opening price.
+TEST_F(ReferenceKlineDataTests, CloseOnlyLayoutCollapsesToPoints) {
+    ReferenceKlineData data("BTCUSDT", test_reference_csv_filename, ReferenceKlineLayout::CloseOnly);
+    ASSERT_EQ(data.get_klines_count(), 2u);
+    EXPECT_TRUE(data.open_prices().empty());
+    EXPECT_TRUE(data.close_times().empty());
+    ASSERT_EQ(data.close_prices().size(), 2u);
+    EXPECT_DOUBLE_EQ(data.close_prices()[1], 7050.0);
+    EXPECT_DOUBLE_EQ(data.opening_price(), 7000.0);
+
+    const auto latest = data.get_latest_kline();
+    EXPECT_EQ(latest.OpenTime, 1733497320000u);
+    EXPECT_DOUBLE_EQ(latest.OpenPrice, 7050.0);
+    EXPECT_DOUBLE_EQ(latest.ClosePrice, 7050.0);
+
+    EXPECT_EQ(data.lower_bound_ts(1733497260001), 1u);
+    EXPECT_EQ(data.upper_bound_ts(1733497320000), 2u);
+}
+
+/// @brief Verifies the hinted lower bound agrees with the full search for forward walks, jumps, and seeks.
+TEST_F(ReferenceKlineDataTests, HintedLowerBoundMatchesFullSearch) {
+    const std::string path = "test_reference_kline_data_hinted.csv";
+    {
+        boost::filesystem::ofstream ofs(path);
+        ofs << "OpenTime,OpenPrice,HighPrice,LowPrice,ClosePrice,CloseTime\n";
+        // Irregular spacing with a duplicate timestamp.
+        uint64_t ts = 1000;
+        for (int i = 0; i < 200; ++i) {
+            ofs << ts << ",1,1,1,1," << ts << "\n";
+            if (i != 50) {
+                ts += (i % 7 == 0) ? 300 : 60;
+            }
+        }
+    }
+    ReferenceKlineData data("BTCUSDT", path);
+    boost::filesystem::remove(path);
+    const uint64_t last = data.timestamps().back();
+
+    size_t hint = 0;
+    for (uint64_t ts = 0; ts <= last + 100; ts += 17) {
+        hint = data.lower_bound_ts(ts, hint);
+        ASSERT_EQ(hint, data.lower_bound_ts(ts)) << "ts=" << ts;
+    }
+    const uint64_t probes[] = { 5000, 5000, last, 1000, 999, last + 1, 2000, 12000, 0 };
+    for (const uint64_t ts : probes) {
+        hint = data.lower_bound_ts(ts, hint);
+        EXPECT_EQ(hint, data.lower_bound_ts(ts)) << "ts=" << ts;
+    }
+    EXPECT_EQ(data.lower_bound_ts(5000, data.get_klines_count() + 10), data.lower_bound_ts(5000));
+}
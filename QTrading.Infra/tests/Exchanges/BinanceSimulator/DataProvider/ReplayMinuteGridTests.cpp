@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Exchanges/BinanceSimulator/Application/ReplayMinuteGridBuilder.hpp"
+#include "Exchanges/BinanceSimulator/Bootstrap/DatasetLoader.hpp"
+#include "Exchanges/BinanceSimulator/State/StepKernelState.hpp"
+
+using QTrading::Infra::Exchanges::BinanceSim::Application::BuildReplayMinuteGrid;
+using QTrading::Infra::Exchanges::BinanceSim::Bootstrap::LoadDatasets;
+using QTrading::Infra::Exchanges::BinanceSim::Contracts::SymbolDataset;
+using QTrading::Infra::Exchanges::BinanceSim::State::ReplayMinuteGrid;
+using QTrading::Infra::Exchanges::BinanceSim::State::StepKernelState;
+
+namespace {
+
+constexpr uint64_t kMinute = 60'000;
+constexpr size_t kDayWindow = 1440;
+
+bool has_bit(const uint64_t* words, size_t symbol_id)
+{
+    return (words[symbol_id / 64] >> (symbol_id % 64)) & 1u;
+}
+
+} // namespace
+
+/// @brief Builds grids from a StepKernelState seeded the way BinanceExchange seeds it.
+class ReplayMinuteGridTests : public ::testing::Test {
+protected:
+    void TearDown() override {
+        for (const auto& path : files) {
+            boost::filesystem::remove(path);
+        }
+    }
+
+    std::string write_klines(const std::string& name, const std::vector<uint64_t>& open_times) {
+        const std::string path = prefix() + name + ".csv";
+        boost::filesystem::ofstream ofs(path);
+        ofs << "OpenTime,OpenPrice,HighPrice,LowPrice,ClosePrice,Volume,CloseTime,QuoteVolume,TradeCount,TakerBuyBaseVolume,TakerBuyQuoteVolume\n";
+        // Close of row `r` is 100 + r.
+        for (size_t row = 0; row < open_times.size(); ++row) {
+            const uint64_t ts = open_times[row];
+            ofs << ts << ",100,101,99," << (100 + row) << ",10," << (ts + kMinute - 1) << ",1000,5,4,400\n";
+        }
+        files.push_back(path);
+        return path;
+    }
+
+    std::string write_funding(const std::string& name, const std::vector<uint64_t>& funding_times) {
+        const std::string path = prefix() + name + "_funding.csv";
+        boost::filesystem::ofstream ofs(path);
+        ofs << "FundingTime,Rate,MarkPrice\n";
+        for (const auto ts : funding_times) {
+            ofs << ts << ",0.0001,100\n";
+        }
+        files.push_back(path);
+        return path;
+    }
+
+    StepKernelState seed_state(const std::vector<SymbolDataset>& datasets) {
+        auto loaded = LoadDatasets(datasets);
+        StepKernelState state{};
+        const size_t n = datasets.size();
+        for (const auto& ds : datasets) {
+            state.symbols.push_back(ds.symbol);
+        }
+        state.market_data = std::move(loaded.market_data);
+        state.funding_data_pool = std::move(loaded.funding_data_pool);
+        state.mark_data_pool = std::move(loaded.mark_data_pool);
+        state.index_data_pool = std::move(loaded.index_data_pool);
+        state.funding_data_id_by_symbol = std::move(loaded.funding_data_id_by_symbol);
+        state.mark_data_id_by_symbol = std::move(loaded.mark_data_id_by_symbol);
+        state.index_data_id_by_symbol = std::move(loaded.index_data_id_by_symbol);
+        state.replay_cursor.assign(n, 0);
+        state.funding_cursor_by_symbol.assign(n, 0);
+        state.mark_cursor_by_symbol.assign(n, 0);
+        state.index_cursor_by_symbol.assign(n, 0);
+        state.has_next_ts.assign(n, 0);
+        state.has_next_funding_ts.assign(n, 0);
+        state.has_next_mark_ts.assign(n, 0);
+        state.has_next_index_ts.assign(n, 0);
+        for (size_t i = 0; i < n; ++i) {
+            state.has_next_ts[i] = state.market_data[i].get_klines_count() > 0;
+            state.has_next_funding_ts[i] = state.funding_data_id_by_symbol[i] >= 0;
+            state.has_next_mark_ts[i] = state.mark_data_id_by_symbol[i] >= 0;
+            state.has_next_index_ts[i] = state.index_data_id_by_symbol[i] >= 0;
+        }
+        return state;
+    }
+
+    std::vector<std::string> files;
+
+private:
+    static std::string prefix() {
+        return std::string("test_grid_") + ::testing::UnitTest::GetInstance()->current_test_info()->name() + "_";
+    }
+};
+
+TEST_F(ReplayMinuteGridTests, BitsAndClosesFollowPendingRows)
+{
+    const uint64_t base = 1'733'497'200'000;
+    std::vector<SymbolDataset> datasets(2);
+    datasets[0].symbol = "BTCUSDT";
+    datasets[0].kline_csv = write_klines("btc", { base, base + kMinute, base + 3 * kMinute });
+    // Mark rows before the grid, off-grid inside it, and past its end.
+    datasets[0].mark_kline_csv = write_klines("btc_mark", { base - kMinute, base + 30'000, base + 9 * kMinute });
+    datasets[1].symbol = "ETHUSDT";
+    datasets[1].kline_csv = write_klines("eth", { base + 2 * kMinute });
+    datasets[1].funding_csv = write_funding("eth", { base + 4 * kMinute });
+
+    auto state = seed_state(datasets);
+    const auto grid = BuildReplayMinuteGrid(state, kDayWindow);
+    ASSERT_NE(grid, nullptr);
+    EXPECT_EQ(grid->base_ts, base);
+    EXPECT_EQ(grid->minute_count, 5u);
+    EXPECT_EQ(grid->words_per_minute, 1u);
+    EXPECT_TRUE(has_bit(grid->trade_words(0), 0));
+    EXPECT_TRUE(has_bit(grid->trade_words(1), 0));
+    EXPECT_FALSE(has_bit(grid->trade_words(2), 0));
+    EXPECT_TRUE(has_bit(grid->trade_words(2), 1));
+    EXPECT_TRUE(has_bit(grid->trade_words(3), 0));
+    EXPECT_TRUE(has_bit(grid->funding_words(4), 1));
+    EXPECT_EQ(grid->trade_words(4)[0], 0u);
+    EXPECT_TRUE(has_bit(grid->mark_words(0), 0));
+    EXPECT_TRUE(has_bit(grid->mark_words(1), 0));
+    EXPECT_EQ(grid->next_step_minute(4), 4u);
+    EXPECT_EQ(grid->next_step_minute(5), 5u);
+    ASSERT_EQ(grid->close_row(0).size(), 2u);
+    EXPECT_EQ(grid->close_row(0)[0], 100.0);
+    EXPECT_TRUE(std::isnan(grid->close_row(0)[1]));
+    EXPECT_EQ(grid->close_row(2)[1], 100.0);
+    EXPECT_EQ(grid->close_row(3)[0], 102.0);
+    EXPECT_TRUE(std::isnan(grid->close_row(4)[0]));
+    EXPECT_TRUE(std::isnan(grid->close_row(4)[1]));
+
+    // Rebuilding after replay progressed only covers the remaining rows.
+    state.replay_cursor[0] = 2;
+    state.has_next_ts[1] = 0;
+    const auto tail = BuildReplayMinuteGrid(state, kDayWindow);
+    ASSERT_NE(tail, nullptr);
+    EXPECT_EQ(tail->base_ts, base + 3 * kMinute);
+    EXPECT_EQ(tail->minute_count, 2u);
+    EXPECT_TRUE(has_bit(tail->trade_words(0), 0));
+    EXPECT_TRUE(has_bit(tail->funding_words(1), 1));
+    EXPECT_EQ(tail->close_row(0)[0], 102.0);
+}
+
+TEST_F(ReplayMinuteGridTests, OffGridOrDuplicateDriverRowsAreRejected)
+{
+    std::vector<SymbolDataset> off_grid(2);
+    off_grid[0].symbol = "BTCUSDT";
+    off_grid[0].kline_csv = write_klines("btc", { 0, kMinute });
+    off_grid[1].symbol = "ETHUSDT";
+    off_grid[1].kline_csv = write_klines("eth", { 30'000 });
+    EXPECT_EQ(BuildReplayMinuteGrid(seed_state(off_grid), kDayWindow), nullptr);
+
+    std::vector<SymbolDataset> duplicate_funding(1);
+    duplicate_funding[0].symbol = "BTCUSDT";
+    duplicate_funding[0].kline_csv = write_klines("btc_dup", { 0, kMinute });
+    duplicate_funding[0].funding_csv = write_funding("btc_dup", { kMinute, kMinute });
+    EXPECT_EQ(BuildReplayMinuteGrid(seed_state(duplicate_funding), kDayWindow), nullptr);
+}
+
+TEST_F(ReplayMinuteGridTests, WindowBoundsThePanel)
+{
+    std::vector<SymbolDataset> datasets(1);
+    datasets[0].symbol = "BTCUSDT";
+    datasets[0].kline_csv = write_klines("btc", { 0, kMinute, 1000 * kMinute, 1001 * kMinute });
+    auto state = seed_state(datasets);
+    // The 1001-minute replay is cut into windows; the first one ends at its last row.
+    const auto first = BuildReplayMinuteGrid(state, 10);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->base_ts, 0u);
+    EXPECT_EQ(first->minute_count, 2u);
+    // 2 minutes x (4 presence words + 1 close).
+    EXPECT_EQ(first->bytes(), 2u * (4 * 8 + 8));
+    EXPECT_EQ(BuildReplayMinuteGrid(state, kDayWindow)->minute_count, 1002u);
+
+    state.replay_cursor[0] = 2;
+    const auto second = BuildReplayMinuteGrid(state, 1);
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(second->base_ts, 1000 * kMinute);
+    EXPECT_EQ(second->minute_count, 1u);
+    EXPECT_EQ(second->close_row(0)[0], 102.0);
+
+    EXPECT_EQ(BuildReplayMinuteGrid(state, 0), nullptr);
+    state.has_next_ts[0] = 0;
+    const auto empty = BuildReplayMinuteGrid(state, kDayWindow);
+    ASSERT_NE(empty, nullptr);
+    EXPECT_EQ(empty->minute_count, 0u);
+    EXPECT_EQ(empty->next_step_minute(0), 0u);
+}
+
+TEST_F(ReplayMinuteGridTests, OffGridRowRejectsOnlyItsWindow)
+{
+    std::vector<SymbolDataset> datasets(1);
+    datasets[0].symbol = "BTCUSDT";
+    datasets[0].kline_csv = write_klines("btc", { 0, kMinute, 5 * kMinute + 30'000 });
+    auto state = seed_state(datasets);
+    const auto grid = BuildReplayMinuteGrid(state, 3);
+    ASSERT_NE(grid, nullptr);
+    EXPECT_EQ(grid->minute_count, 2u);
+    EXPECT_EQ(BuildReplayMinuteGrid(state, kDayWindow), nullptr);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <Data/Binance/BinaryCache.hpp>
+#include <Data/Binance/ReplayReadAhead.hpp>
+#include "TestEnv.hpp"
+
+namespace {
+
+namespace Cache = QTrading::Infra::Data::Binance;
+
+constexpr size_t kReadAheadRows = 5000;
+
+} // namespace
+
+/// @brief Writes a multi-chunk kline CSV; each test decides whether the cache is enabled.
+class ReplayReadAheadTests : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Per-test paths: ctest runs each case as its own process, possibly in parallel.
+        const std::string name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+        csv_ = "test_read_ahead_" + name + ".csv";
+        cache_dir_ = "test_read_ahead_cache_" + name;
+        boost::filesystem::ofstream ofs(csv_);
+        ofs << "OpenTime,OpenPrice,HighPrice,LowPrice,ClosePrice,CloseTime\n";
+        for (size_t i = 0; i < kReadAheadRows; ++i) {
+            const uint64_t ts = 1733497260000ull + i * 60000ull;
+            ofs << ts << ",100,101,99,100.5," << (ts + 59999) << "\n";
+        }
+    }
+
+    void TearDown() override {
+        unset_env_var(Cache::kBinaryCacheDirEnv);
+        std::filesystem::remove_all(cache_dir_);
+        boost::filesystem::remove(csv_);
+    }
+
+    std::string csv_;
+    std::string cache_dir_;
+};
+
+/// @brief Fully resident (non-mapped) series are not streamed.
+TEST_F(ReplayReadAheadTests, IgnoresOwnedSeries) {
+    std::vector<MarketData> trade{ MarketData("BTCUSDT", csv_) };
+    ASSERT_FALSE(trade.front().is_memory_mapped());
+
+    Cache::ReplayReadAhead read_ahead(trade, {}, {}, 1 << 20);
+    EXPECT_EQ(read_ahead.active_series(), 0u);
+    read_ahead.advance_trade(0, kReadAheadRows);
+    read_ahead.drain();
+    EXPECT_EQ(read_ahead.completed_requests(), 0u);
+}
+
+/// @brief Mapped series prefetch ahead and release behind only at chunk boundaries.
+TEST_F(ReplayReadAheadTests, IssuesHintsAtChunkBoundaries) {
+    set_env_var(Cache::kBinaryCacheDirEnv, cache_dir_.c_str());
+    std::vector<MarketData> trade{ MarketData("BTCUSDT", csv_) };
+    std::vector<ReferenceKlineData> mark{
+        ReferenceKlineData("BTCUSDT", csv_, ReferenceKlineLayout::CloseOnly) };
+    ASSERT_TRUE(trade.front().is_memory_mapped());
+    ASSERT_TRUE(mark.front().is_memory_mapped());
+
+    // Tiny budget: chunks clamp to the minimum size.
+    Cache::ReplayReadAhead read_ahead(trade, mark, {}, 1);
+    EXPECT_EQ(read_ahead.active_series(), 2u);
+    EXPECT_EQ(read_ahead.chunk_rows(), Cache::ReplayReadAhead::kMinChunkRows);
+    read_ahead.drain();
+    EXPECT_EQ(read_ahead.completed_requests(), 2u);   // initial prefetch per series
+
+    const size_t chunk = read_ahead.chunk_rows();
+    for (size_t cursor = 1; cursor < chunk; ++cursor) {
+        read_ahead.advance_trade(0, cursor);
+    }
+    read_ahead.drain();
+    EXPECT_EQ(read_ahead.completed_requests(), 2u);
+
+    read_ahead.advance_trade(0, chunk);       // release [0, chunk) + prefetch [2c, 3c)
+    read_ahead.advance_mark(0, chunk);
+    read_ahead.drain();
+    EXPECT_EQ(read_ahead.completed_requests(), 6u);
+
+    // Data stays readable after its pages were released (they refault from the file).
+    EXPECT_DOUBLE_EQ(trade.front().close_prices()[0], 100.5);
+    EXPECT_EQ(mark.front().timestamps()[1], 1733497320000u);
+}
+
+/// @brief Budget determines chunk size once it exceeds the minimum.
+TEST_F(ReplayReadAheadTests, ChunkRowsFollowBudget) {
+    set_env_var(Cache::kBinaryCacheDirEnv, cache_dir_.c_str());
+    std::vector<MarketData> trade{ MarketData("BTCUSDT", csv_) };
+
+    const size_t budget = 2 * trade.front().row_bytes() * 4096;
+    Cache::ReplayReadAhead read_ahead(trade, {}, {}, budget);
+    EXPECT_EQ(read_ahead.chunk_rows(), 4096u);
+}
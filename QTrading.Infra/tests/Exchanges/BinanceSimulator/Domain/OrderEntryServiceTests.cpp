@@ -819,7 +819,7 @@ TEST(OrderEntryServiceTest, PerpFullCloseSettlesRealizedPnlIntoWallet)
 
     QTrading::Infra::Exchanges::BinanceSim::Domain::MatchFill close_fill{};
     close_fill.order_id = 2;
-    close_fill.symbol = "BTCUSDT";
+    close_fill.interned_symbol_id = QTrading::Dto::Trading::SymbolTable::Intern("BTCUSDT");
     close_fill.instrument_type = QTrading::Dto::Trading::InstrumentType::Perp;
     close_fill.side = QTrading::Dto::Trading::OrderSide::Sell;
     close_fill.position_side = QTrading::Dto::Trading::PositionSide::Both;
@@ -847,7 +847,7 @@ TEST(OrderEntryServiceTest, PerpCloseRealizesLossIntoWallet)
 
     QTrading::Infra::Exchanges::BinanceSim::Domain::MatchFill close_fill{};
     close_fill.order_id = 2;
-    close_fill.symbol = "BTCUSDT";
+    close_fill.interned_symbol_id = QTrading::Dto::Trading::SymbolTable::Intern("BTCUSDT");
     close_fill.instrument_type = QTrading::Dto::Trading::InstrumentType::Perp;
     close_fill.side = QTrading::Dto::Trading::OrderSide::Sell;
     close_fill.position_side = QTrading::Dto::Trading::PositionSide::Both;
@@ -875,7 +875,7 @@ TEST(OrderEntryServiceTest, PerpPartialCloseSettlesRealizedPnlIntoWallet)
 
     QTrading::Infra::Exchanges::BinanceSim::Domain::MatchFill close_fill{};
     close_fill.order_id = 2;
-    close_fill.symbol = "BTCUSDT";
+    close_fill.interned_symbol_id = QTrading::Dto::Trading::SymbolTable::Intern("BTCUSDT");
     close_fill.instrument_type = QTrading::Dto::Trading::InstrumentType::Perp;
     close_fill.side = QTrading::Dto::Trading::OrderSide::Sell;
     close_fill.position_side = QTrading::Dto::Trading::PositionSide::Both;
@@ -904,7 +904,7 @@ TEST(OrderEntryServiceTest, PerpReduceOnlyCloseSettlesRealizedPnlIntoWallet)
 
     QTrading::Infra::Exchanges::BinanceSim::Domain::MatchFill close_fill{};
     close_fill.order_id = 2;
-    close_fill.symbol = "BTCUSDT";
+    close_fill.interned_symbol_id = QTrading::Dto::Trading::SymbolTable::Intern("BTCUSDT");
     close_fill.instrument_type = QTrading::Dto::Trading::InstrumentType::Perp;
     close_fill.side = QTrading::Dto::Trading::OrderSide::Buy;
     close_fill.position_side = QTrading::Dto::Trading::PositionSide::Both;
@@ -935,7 +935,7 @@ TEST(OrderEntryServiceTest, PerpOneWayFlipSettlesClosingRealizedPnlBeforeOpening
 
     QTrading::Infra::Exchanges::BinanceSim::Domain::MatchFill flip_fill{};
     flip_fill.order_id = 2;
-    flip_fill.symbol = "BTCUSDT";
+    flip_fill.interned_symbol_id = QTrading::Dto::Trading::SymbolTable::Intern("BTCUSDT");
     flip_fill.instrument_type = QTrading::Dto::Trading::InstrumentType::Perp;
     flip_fill.side = QTrading::Dto::Trading::OrderSide::Sell;
     flip_fill.position_side = QTrading::Dto::Trading::PositionSide::Both;
@@ -968,7 +968,7 @@ TEST(OrderEntryServiceTest, SpotSellWithoutInventoryLeavesCashUnchanged)
 
     QTrading::Infra::Exchanges::BinanceSim::Domain::MatchFill sell_fill{};
     sell_fill.order_id = 7;
-    sell_fill.symbol = "OPUSDT";
+    sell_fill.interned_symbol_id = QTrading::Dto::Trading::SymbolTable::Intern("OPUSDT");
     sell_fill.symbol_id = step_state.symbol_to_id.at("OPUSDT");
     sell_fill.instrument_type = QTrading::Dto::Trading::InstrumentType::Spot;
     sell_fill.side = QTrading::Dto::Trading::OrderSide::Sell;
@@ -1003,7 +1003,7 @@ TEST(OrderEntryServiceTest, SpotSettlementUsesAuthoritativeStepSymbolIdAcrossMul
 
     QTrading::Infra::Exchanges::BinanceSim::Domain::MatchFill sell_fill{};
     sell_fill.order_id = 8;
-    sell_fill.symbol = "OPUSDT";
+    sell_fill.interned_symbol_id = QTrading::Dto::Trading::SymbolTable::Intern("OPUSDT");
     sell_fill.symbol_id = step_state.symbol_to_id.at("OPUSDT");
     sell_fill.instrument_type = QTrading::Dto::Trading::InstrumentType::Spot;
     sell_fill.side = QTrading::Dto::Trading::OrderSide::Sell;
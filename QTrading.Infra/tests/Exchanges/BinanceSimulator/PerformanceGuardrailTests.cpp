@@ -1,32 +1,45 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <charconv>
 #include <chrono>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <numeric>
 #include <optional>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "Data/Binance/KlineCsvParser.hpp"
 #include "Dto/Market/Binance/Kline.hpp"
 #include "Dto/Trading/Side.hpp"
 #include "Exchanges/BinanceSimulator/Account/Account.hpp"
+#include "Exchanges/BinanceSimulator/Application/MarketReplayKernel.hpp"
 #include "Queue/ChannelFactory.hpp"
 #include "Exchanges/BinanceSimulator/State/BinanceExchangeRuntimeState.hpp"
 #include "Exchanges/BinanceSimulator/State/SnapshotState.hpp"
 #include "Exchanges/BinanceSimulator/State/StepKernelState.hpp"
+#include "FileLogger/FeatherV2/MarketEvent.hpp"
+#include "FileLogger/FeatherV2Sink.hpp"
+#include "SinkLogger.hpp"
 
 #define private public
 #include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
 #undef private
+#include "Exchanges/BinanceSimulator/Application/BatchReplayRunner.hpp"
 #include "Exchanges/BinanceSimulator/Diagnostics/Compare/ReplayCompareTestHarness.hpp"
 #include "Exchanges/BinanceSimulator/Diagnostics/Compare/V2ReplayScenarioPack.hpp"
 
@@ -268,6 +281,8 @@ constexpr size_t kPerfSamples = 3;
 constexpr size_t kReplayRows = 1200;
 constexpr size_t kLogHeavyRows = 2400;
 constexpr size_t kLogHeavyStepLimit = 1200;
+constexpr size_t kMergeUniverseSymbols = 240;
+constexpr size_t kMergeUniverseRows = 1440;
 
 constexpr double kMaxSingleStepLatencyNs = 20'000'000.0;
 constexpr double kMaxSingleOpLatencyNs = 20'000'000.0;
@@ -280,6 +295,23 @@ constexpr double kMixedScenarioMaxLatencyRatioVsReplay = 4.00;
 constexpr double kMixedScenarioMinThroughputRatioVsReplay = 0.20;
 constexpr double kFallbackUnsupportedOverheadRatioBudget = 3.00;
 
+/// Bound for a threaded variant against its single-threaded baseline. Speedup depends on
+/// the host's hardware threads and CI may have only one, so the guardrail only rejects
+/// pathological hand-off or contention cost; the measured speedup is printed instead.
+constexpr double kMaxThreadedOverheadRatio = 3.00;
+
+/// Bound for the bulk kline CSV parser against the line-by-line loader it replaced. Every
+/// kernel, the portable one included, is expected to be faster; the slack only absorbs
+/// scheduler noise on shared hosts.
+constexpr double kMaxBulkCsvParseRatioVsLineByLine = 1.25;
+
+void ExpectWithinThreadedOverheadBudget(double threaded_ns, double baseline_ns, const char* scenario)
+{
+    EXPECT_LE(threaded_ns, baseline_ns * kMaxThreadedOverheadRatio)
+        << "THREADED_BUDGET_FAIL scenario=" << scenario
+        << " hardware_threads=" << std::thread::hardware_concurrency();
+}
+
 std::unordered_map<std::string, TradeKlineDto> OneKlineMap(
     const std::string& symbol,
     uint64_t ts,
@@ -864,6 +896,167 @@ MixedScenarioPerfResult RunMixedScenarioBenchmark(
     return out;
 }
 
+std::vector<BinanceExchangeImpl::SymbolDataset> EnsureMergeUniverseDatasets()
+{
+    // One day of 1-minute bars for a full-size universe; a few symbols list late
+    // or have gaps so the merge still sees ragged timelines.
+    static const std::vector<BinanceExchangeImpl::SymbolDataset> datasets = []() {
+        const fs::path dir = fs::temp_directory_path() / "QTrading_PerfGuard_MergeUniverse";
+        std::error_code ec;
+        fs::create_directories(dir, ec);
+        std::vector<BinanceExchangeImpl::SymbolDataset> out;
+        out.reserve(kMergeUniverseSymbols);
+        for (size_t s = 0; s < kMergeUniverseSymbols; ++s) {
+            const std::string symbol = "SYM" + std::to_string(s) + "USDT";
+            const fs::path csv = dir / (symbol + ".csv");
+            std::ofstream f(csv, std::ios::trunc);
+            f << "openTime,open,high,low,close,volume,closeTime,quoteVol,tradeCnt,takerBB,takerBQ\n";
+            const size_t first_row = (s % 16 == 0) ? (s % 97) : 0;
+            for (size_t i = first_row; i < kMergeUniverseRows; ++i) {
+                if (s % 31 == 0 && i % 7 == 3) {
+                    continue;
+                }
+                const uint64_t open_time = static_cast<uint64_t>(i * 60'000);
+                const double px = 10.0 + static_cast<double>(s) + static_cast<double>(i % 17) * 0.01;
+                f << open_time << ',' << px << ',' << px << ',' << px << ',' << px << ",1000,"
+                  << (open_time + 59'999) << ",1000,1,0,0\n";
+            }
+            out.push_back({ symbol, csv.string() });
+        }
+        return out;
+    }();
+    return datasets;
+}
+
+struct MergePerfResult {
+    double ns_per_step{ 0.0 };
+    size_t steps{ 0 };
+};
+
+MergePerfResult RunReplayMergeNsPerStep(Config::ReplayMergeMode mode)
+{
+    BinanceExchangeImpl ex(EnsureMergeUniverseDatasets(), nullptr, MakeAccountInitConfig(10'000.0));
+    auto cfg = ex.simulation_config();
+    cfg.replay_merge_mode = mode;
+    ex.apply_simulation_config(cfg);
+    auto& state = *ex.step_kernel_state_;
+
+    MergePerfResult result{};
+    const auto start = std::chrono::steady_clock::now();
+    while (true) {
+        const auto frame = Application::MarketReplayKernel::Next(state);
+        if (!frame.has_next) {
+            break;
+        }
+        ++result.steps;
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    result.ns_per_step = (result.steps == 0) ? 0.0 : static_cast<double>(ns) / static_cast<double>(result.steps);
+    return result;
+}
+
+struct StepWorkerRunResult {
+    double ns_per_step{ 0.0 };
+    size_t steps{ 0 };
+    size_t positions{ 0 };
+};
+
+// Full exchange replay over the merge universe with perp positions on a third of the symbols.
+StepWorkerRunResult RunStepWorkersReplay(uint32_t step_worker_count)
+{
+    BinanceExchangeImpl ex(EnsureMergeUniverseDatasets(), nullptr, MakeAccountInitConfig(1'000'000.0));
+    auto cfg = ex.simulation_config();
+    cfg.replay_merge_mode = Config::ReplayMergeMode::LinearCalendar;
+    cfg.step_worker_count = step_worker_count;
+    ex.apply_simulation_config(cfg);
+    for (size_t s = 0; s < kMergeUniverseSymbols; s += 3) {
+        (void)ex.perp.place_order("SYM" + std::to_string(s) + "USDT", 1.0, (s % 2 == 0) ? OrderSide::Buy : OrderSide::Sell);
+    }
+
+    StepWorkerRunResult result{};
+    const auto start = std::chrono::steady_clock::now();
+    while (ex.step()) {
+        ++result.steps;
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    result.ns_per_step = (result.steps == 0) ? 0.0 : static_cast<double>(ns) / static_cast<double>(result.steps);
+    result.positions = ex.runtime_state_->positions.size();
+    return result;
+}
+
+// One row per minute in the 11-column Binance layout with six-decimal prices.
+std::string MakeMinuteKlineCsv(size_t rows)
+{
+    std::string csv =
+        "OpenTime,OpenPrice,HighPrice,LowPrice,ClosePrice,Volume,CloseTime,QuoteVolume,TradeCount,"
+        "TakerBuyBaseVolume,TakerBuyQuoteVolume\n";
+    const uint64_t base = 1733497260000ull;
+    for (size_t i = 0; i < rows; ++i) {
+        const uint64_t ts = base + i * 60000ull;
+        const double px = 97000.0 + static_cast<double>(i % 997) * 0.1;
+        csv += std::to_string(ts) + "," + std::to_string(px) + "," + std::to_string(px + 12.5) + "," +
+            std::to_string(px - 8.25) + "," + std::to_string(px + 1.75) + ",123.456," +
+            std::to_string(ts + 59999) + ",11987654.321," + std::to_string(1000 + i % 300) +
+            ",61.728,5993827.1605\n";
+    }
+    return csv;
+}
+
+// The pre-bulk loader: getline, split with find(','), from_chars per field into
+// TradeKlineDto rows, then a transpose into columns.
+size_t ParseKlineCsvLineByLine(const std::string& csv)
+{
+    std::istringstream in(csv);
+    std::vector<TradeKlineDto> rows;
+    rows.reserve(csv.size() / 80);
+    std::string line;
+    std::getline(in, line);
+    while (std::getline(in, line)) {
+        std::string_view s(line);
+        std::string_view f[11]{};
+        size_t count = 0;
+        while (!s.empty() && count < 11) {
+            const size_t pos = s.find(',');
+            f[count++] = s.substr(0, pos);
+            s = pos == std::string_view::npos ? std::string_view{} : s.substr(pos + 1);
+        }
+        if (count < 11) {
+            continue;
+        }
+        const auto num = [](std::string_view sv, auto& out) {
+            return std::from_chars(sv.data(), sv.data() + sv.size(), out).ec == std::errc{};
+        };
+        long long open_ts = 0;
+        long long close_ts = 0;
+        int trades = 0;
+        double v[8]{};
+        if (!num(f[0], open_ts) || !num(f[1], v[0]) || !num(f[2], v[1]) || !num(f[3], v[2]) ||
+            !num(f[4], v[3]) || !num(f[5], v[4]) || !num(f[6], close_ts) || !num(f[7], v[5]) ||
+            !num(f[8], trades) || !num(f[9], v[6]) || !num(f[10], v[7])) {
+            continue;
+        }
+        rows.emplace_back(open_ts, v[0], v[1], v[2], v[3], v[4], close_ts, v[5], trades, v[6], v[7]);
+    }
+
+    QTrading::Infra::Data::Binance::KlineColumnBuffers columns;
+    for (const auto& k : rows) {
+        columns.open_time.push_back(k.Timestamp);
+        columns.open.push_back(k.OpenPrice);
+        columns.high.push_back(k.HighPrice);
+        columns.low.push_back(k.LowPrice);
+        columns.close.push_back(k.ClosePrice);
+        columns.volume.push_back(k.Volume);
+        columns.close_time.push_back(k.CloseTime);
+        columns.quote_volume.push_back(k.QuoteVolume);
+        columns.trade_count.push_back(k.TradeCount);
+        columns.taker_buy_base.push_back(k.TakerBuyBaseVolume);
+        columns.taker_buy_quote.push_back(k.TakerBuyQuoteVolume);
+    }
+    return columns.size();
+}
+
 } // namespace
 
 TEST_F(PerfGuardrailFixture, AccountHotPathPerfGuardLegacyOnlyVsCompareOffAreEquivalent)
@@ -1458,3 +1651,615 @@ TEST_F(PerfGuardrailFixture, MixedScenarioBudgetCoversJitterAndFallbackUnsupport
     EXPECT_LE(fallback_ratio, kFallbackUnsupportedOverheadRatioBudget)
         << "MIXED_BUDGET_FAIL metric=fallback_ratio scenario=v2-vs-legacy.funding-reference-edge";
 }
+
+TEST_F(PerfGuardrailFixture, ReplayMergeBenchmarkComparesTimestampHeapLinearCalendarAndMinuteGrid)
+{
+    (void)EnsureMergeUniverseDatasets();
+    std::vector<double> heap_samples;
+    std::vector<double> calendar_samples;
+    std::vector<double> grid_samples;
+    size_t heap_steps = 0;
+    size_t calendar_steps = 0;
+    size_t grid_steps = 0;
+    for (size_t i = 0; i < kPerfSamples; ++i) {
+        const auto heap = RunReplayMergeNsPerStep(Config::ReplayMergeMode::TimestampHeap);
+        const auto calendar = RunReplayMergeNsPerStep(Config::ReplayMergeMode::LinearCalendar);
+        const auto grid = RunReplayMergeNsPerStep(Config::ReplayMergeMode::MinuteGrid);
+        heap_samples.push_back(heap.ns_per_step);
+        calendar_samples.push_back(calendar.ns_per_step);
+        grid_samples.push_back(grid.ns_per_step);
+        heap_steps = heap.steps;
+        calendar_steps = calendar.steps;
+        grid_steps = grid.steps;
+    }
+    const double heap_best = *std::min_element(heap_samples.begin(), heap_samples.end());
+    const double calendar_best = *std::min_element(calendar_samples.begin(), calendar_samples.end());
+    const double grid_best = *std::min_element(grid_samples.begin(), grid_samples.end());
+    const double calendar_speedup = (calendar_best > 0.0) ? heap_best / calendar_best : 0.0;
+    const double grid_speedup = (grid_best > 0.0) ? heap_best / grid_best : 0.0;
+
+    std::cout << "[PERF][ReplayMerge] symbols=" << kMergeUniverseSymbols
+              << " steps=" << heap_steps
+              << " heap_ns_per_step=" << heap_best
+              << " calendar_ns_per_step=" << calendar_best
+              << " grid_ns_per_step=" << grid_best
+              << " calendar_speedup=" << calendar_speedup
+              << " grid_speedup=" << grid_speedup << '\n';
+
+    EXPECT_EQ(heap_steps, kMergeUniverseRows);
+    EXPECT_EQ(calendar_steps, heap_steps);
+    EXPECT_EQ(grid_steps, heap_steps);
+    EXPECT_LE(calendar_best, heap_best * kMaxModeRatio);
+    EXPECT_LE(grid_best, heap_best * kMaxModeRatio);
+}
+
+TEST_F(PerfGuardrailFixture, StepWorkerPoolReportsScaling)
+{
+    (void)EnsureMergeUniverseDatasets();
+    const auto serial = RunStepWorkersReplay(1);
+    const auto sharded = RunStepWorkersReplay(4);
+    ASSERT_EQ(serial.steps, kMergeUniverseRows);
+    ASSERT_GT(serial.positions, 0u);
+    EXPECT_EQ(sharded.steps, serial.steps);
+
+    double serial_best = serial.ns_per_step;
+    double sharded_best = sharded.ns_per_step;
+    for (size_t i = 1; i < kPerfSamples; ++i) {
+        serial_best = std::min(serial_best, RunStepWorkersReplay(1).ns_per_step);
+        sharded_best = std::min(sharded_best, RunStepWorkersReplay(4).ns_per_step);
+    }
+    std::cout << "[PERF][StepWorkers] symbols=" << kMergeUniverseSymbols
+              << " steps=" << serial.steps
+              << " positions=" << serial.positions
+              << " hardware_threads=" << std::thread::hardware_concurrency()
+              << " serial_ns_per_step=" << serial_best
+              << " workers4_ns_per_step=" << sharded_best
+              << " speedup=" << ((sharded_best > 0.0) ? serial_best / sharded_best : 0.0) << '\n';
+    ExpectWithinThreadedOverheadBudget(sharded_best, serial_best, "step-workers");
+}
+
+TEST_F(PerfGuardrailFixture, BatchReplayRunnerSharesDatasetsAcrossConcurrentRuns)
+{
+    constexpr size_t kBatchRuns = 4;
+    const Application::BatchReplayRunner runner(EnsureMergeUniverseDatasets());
+    const auto body = [](size_t run_index, const Application::BatchReplayRunner& batch) -> uint64_t {
+        auto ex = batch.make_exchange(nullptr, MakeAccountInitConfig(1'000'000.0));
+        for (size_t s = run_index; s < kMergeUniverseSymbols; s += 8) {
+            (void)ex->perp.place_order("SYM" + std::to_string(s) + "USDT", 1.0, OrderSide::Buy);
+        }
+        uint64_t steps = 0;
+        while (ex->step()) {
+            ++steps;
+        }
+        return steps;
+    };
+    const auto time_batch = [&](size_t parallelism) {
+        const auto start = std::chrono::steady_clock::now();
+        const auto results = runner.run(kBatchRuns, body, parallelism);
+        const auto end = std::chrono::steady_clock::now();
+        for (const auto& result : results) {
+            EXPECT_FALSE(result.error);
+            EXPECT_EQ(result.steps, kMergeUniverseRows);
+        }
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    };
+
+    double sequential_best = std::numeric_limits<double>::max();
+    double parallel_best = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < kPerfSamples; ++i) {
+        sequential_best = std::min(sequential_best, time_batch(1));
+        parallel_best = std::min(parallel_best, time_batch(kBatchRuns));
+    }
+    const double steps = static_cast<double>(kBatchRuns * kMergeUniverseRows);
+    std::cout << "[PERF][BatchReplay] runs=" << kBatchRuns
+              << " symbols=" << kMergeUniverseSymbols
+              << " hardware_threads=" << std::thread::hardware_concurrency()
+              << " sequential_steps_per_sec=" << steps * 1e9 / sequential_best
+              << " parallel_steps_per_sec=" << steps * 1e9 / parallel_best
+              << " speedup=" << sequential_best / parallel_best << '\n';
+    ExpectWithinThreadedOverheadBudget(parallel_best, sequential_best, "batch-replay");
+}
+
+TEST_F(PerfGuardrailFixture, ForkCostTracksMutableStateNotHistory)
+{
+    const auto datasets = EnsureMergeUniverseDatasets();
+    constexpr size_t kForkStep = kMergeUniverseRows / 2;
+
+    double load_best = std::numeric_limits<double>::max();
+    double fork_best = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < kPerfSamples; ++i) {
+        const auto load_start = std::chrono::steady_clock::now();
+        BinanceExchangeImpl ex(datasets, nullptr, MakeAccountInitConfig(1'000'000.0));
+        const auto load_end = std::chrono::steady_clock::now();
+        load_best = std::min(load_best, static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(load_end - load_start).count()));
+
+        for (size_t s = 0; s < kMergeUniverseSymbols; s += 4) {
+            (void)ex.perp.place_order("SYM" + std::to_string(s) + "USDT", 1.0, OrderSide::Buy);
+        }
+        for (size_t step = 0; step < kForkStep; ++step) {
+            ASSERT_TRUE(ex.step());
+        }
+
+        const auto fork_start = std::chrono::steady_clock::now();
+        auto branch = ex.fork();
+        const auto fork_end = std::chrono::steady_clock::now();
+        fork_best = std::min(fork_best, static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(fork_end - fork_start).count()));
+
+        EXPECT_EQ(branch->get_all_positions().size(), ex.get_all_positions().size());
+        uint64_t remaining = 0;
+        while (branch->step()) {
+            ++remaining;
+        }
+        EXPECT_EQ(remaining, kMergeUniverseRows - kForkStep);
+    }
+
+    std::cout << "[PERF][ExchangeFork] symbols=" << kMergeUniverseSymbols
+              << " rows=" << kMergeUniverseRows
+              << " load_us=" << load_best / 1e3
+              << " fork_us=" << fork_best / 1e3
+              << " fork_to_load_ratio=" << fork_best / load_best << '\n';
+    // A fork copies cursors, books and caches only; it must stay an order below a fresh load.
+    EXPECT_LE(fork_best * 10.0, load_best);
+}
+
+TEST_F(PerfGuardrailFixture, IdleFastForwardOutpacesPerFrameStepping)
+{
+    const auto datasets = EnsureMergeUniverseDatasets();
+    // A strategy that only looks at the market every 8 hours, as funding carry does.
+    constexpr uint64_t kWakeIntervalMs = 8 * 60 * 60'000;
+
+    double step_best = std::numeric_limits<double>::max();
+    double fast_forward_best = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < kPerfSamples; ++i) {
+        BinanceExchangeImpl stepped(datasets, nullptr, MakeAccountInitConfig(1'000'000.0));
+        const auto step_start = std::chrono::steady_clock::now();
+        uint64_t frames = 0;
+        while (stepped.step()) {
+            ++frames;
+        }
+        const auto step_end = std::chrono::steady_clock::now();
+        step_best = std::min(step_best, static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(step_end - step_start).count()));
+        EXPECT_EQ(frames, kMergeUniverseRows);
+
+        BinanceExchangeImpl fast(datasets, nullptr, MakeAccountInitConfig(1'000'000.0));
+        BinanceExchangeImpl::WakeCondition wake{};
+        wake.wake_at_ts = 0;
+        const auto fast_start = std::chrono::steady_clock::now();
+        uint64_t wakes = 0;
+        while (fast.step_until(wake)) {
+            ++wakes;
+            *wake.wake_at_ts += kWakeIntervalMs;
+        }
+        const auto fast_end = std::chrono::steady_clock::now();
+        fast_forward_best = std::min(fast_forward_best, static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(fast_end - fast_start).count()));
+        EXPECT_EQ(wakes, (kMergeUniverseRows * 60'000 + kWakeIntervalMs - 1) / kWakeIntervalMs);
+
+        BinanceExchangeImpl::StatusSnapshot stepped_status{};
+        BinanceExchangeImpl::StatusSnapshot fast_status{};
+        stepped.FillStatusSnapshot(stepped_status);
+        fast.FillStatusSnapshot(fast_status);
+        ASSERT_EQ(fast_status.prices.size(), stepped_status.prices.size());
+        for (size_t s = 0; s < stepped_status.prices.size(); ++s) {
+            EXPECT_EQ(fast_status.prices[s].trade_price, stepped_status.prices[s].trade_price);
+        }
+    }
+
+    std::cout << "[PERF][IdleFastForward] symbols=" << kMergeUniverseSymbols
+              << " rows=" << kMergeUniverseRows
+              << " step_us=" << step_best / 1e3
+              << " fast_forward_us=" << fast_forward_best / 1e3
+              << " speedup=" << step_best / fast_forward_best << '\n';
+    // Only the wake frames are materialized; everything in between is a cursor seek.
+    EXPECT_LE(fast_forward_best * 5.0, step_best);
+}
+
+TEST_F(PerfGuardrailFixture, SpscMarketChannelHandOffBeatsMutexBoundedChannel)
+{
+    using QTrading::Utils::Queue::ChannelFactory;
+    using QTrading::Utils::Queue::ChannelOptions;
+    using QTrading::Utils::Queue::OverflowPolicy;
+    constexpr uint64_t kItems = 1'000'000;
+
+    // Step-like hand-off: one producer thread, one blocking consumer, a small bounded buffer.
+    const auto run_hand_off = [&](const ChannelOptions& options) {
+        auto channel = ChannelFactory::CreateBoundedChannel<std::shared_ptr<uint64_t>>(8, OverflowPolicy::Block, options);
+        auto payload = std::make_shared<uint64_t>(0);
+        const auto start = std::chrono::steady_clock::now();
+        std::thread producer([&]() {
+            for (uint64_t i = 0; i < kItems; ++i) {
+                channel->Send(payload);
+            }
+            channel->Close();
+        });
+        uint64_t received = 0;
+        while (channel->Receive()) {
+            ++received;
+        }
+        producer.join();
+        const auto end = std::chrono::steady_clock::now();
+        EXPECT_EQ(received, kItems);
+        EXPECT_EQ(payload.use_count(), 1);
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    };
+
+    ChannelOptions spsc_options;
+    spsc_options.single_reader = true;
+    spsc_options.single_writer = true;
+    double mutex_best = std::numeric_limits<double>::max();
+    double spsc_best = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < kPerfSamples; ++i) {
+        mutex_best = std::min(mutex_best, run_hand_off(ChannelOptions{}));
+        spsc_best = std::min(spsc_best, run_hand_off(spsc_options));
+    }
+
+    std::cout << "[PERF][MarketChannelHandOff] items=" << kItems
+              << " mutex_ns_per_item=" << mutex_best / kItems
+              << " spsc_ns_per_item=" << spsc_best / kItems
+              << " speedup=" << mutex_best / spsc_best << '\n';
+    EXPECT_LT(spsc_best, mutex_best);
+}
+
+TEST_F(PerfGuardrailFixture, PipelinedStepOverlapsReplayAssemblyWithStrategyWork)
+{
+    const auto datasets = EnsureMergeUniverseDatasets();
+    // Stand-in for a strategy cycle of a few microseconds.
+    const auto strategy_cycle = [](uint64_t ts) {
+        volatile double acc = static_cast<double>(ts);
+        for (int i = 0; i < 2'000; ++i) {
+            acc = acc * 1.0000001 + 1.0;
+        }
+    };
+    const auto run = [&](bool pipelined, uint64_t& frames) {
+        BinanceExchangeImpl exchange(datasets, nullptr, MakeAccountInitConfig(1'000'000.0));
+        frames = 0;
+        const auto start = std::chrono::steady_clock::now();
+        while (exchange.step()) {
+            if (pipelined) {
+                exchange.prefetch_next_step();
+            }
+            auto dto = exchange.get_market_channel()->TryReceive();
+            strategy_cycle(dto.has_value() && dto.value() ? dto.value()->Timestamp : 0);
+            ++frames;
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    };
+
+    double serial_best = std::numeric_limits<double>::max();
+    double pipelined_best = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < kPerfSamples; ++i) {
+        uint64_t serial_frames = 0;
+        uint64_t pipelined_frames = 0;
+        serial_best = std::min(serial_best, run(false, serial_frames));
+        pipelined_best = std::min(pipelined_best, run(true, pipelined_frames));
+        EXPECT_EQ(serial_frames, kMergeUniverseRows);
+        EXPECT_EQ(pipelined_frames, kMergeUniverseRows);
+    }
+
+    std::cout << "[PERF][PipelinedStep] symbols=" << kMergeUniverseSymbols
+              << " rows=" << kMergeUniverseRows
+              << " hardware_threads=" << std::thread::hardware_concurrency()
+              << " serial_ns_per_step=" << serial_best / kMergeUniverseRows
+              << " pipelined_ns_per_step=" << pipelined_best / kMergeUniverseRows
+              << " speedup=" << serial_best / pipelined_best << '\n';
+    ExpectWithinThreadedOverheadBudget(pipelined_best, serial_best, "pipelined-step");
+}
+
+TEST_F(PerfGuardrailFixture, BookDeltaChannelsCopyChangedEntriesNotWholeBooks)
+{
+    const auto datasets = EnsureMergeUniverseDatasets();
+    // A hedged book: a position and a resting bid on every symbol, one trade per step.
+    const auto run = [&](Config::BookChannelMode mode, uint64_t& entries_published) {
+        BinanceExchangeImpl ex(datasets, nullptr, MakeAccountInitConfig(1'000'000'000.0));
+        auto cfg = ex.simulation_config();
+        cfg.book_channel_mode = mode;
+        ex.apply_simulation_config(cfg);
+        QTrading::Infra::Exchanges::PositionBookReplica positions;
+        QTrading::Infra::Exchanges::OrderBookReplica orders;
+        entries_published = 0;
+        uint64_t step = 0;
+        const auto start = std::chrono::steady_clock::now();
+        while (ex.step()) {
+            while (auto full = ex.get_position_channel()->TryReceive()) {
+                entries_published += full->size();
+            }
+            while (auto full = ex.get_order_channel()->TryReceive()) {
+                entries_published += full->size();
+            }
+            while (auto delta = ex.get_position_delta_channel()->TryReceive()) {
+                entries_published += delta->added.size() + delta->updated.size();
+                EXPECT_TRUE(positions.apply(std::move(*delta)));
+            }
+            while (auto delta = ex.get_order_delta_channel()->TryReceive()) {
+                entries_published += delta->added.size() + delta->updated.size();
+                EXPECT_TRUE(orders.apply(std::move(*delta)));
+            }
+            if (step == 0) {
+                for (size_t s = 0; s < kMergeUniverseSymbols; ++s) {
+                    const std::string symbol = "SYM" + std::to_string(s) + "USDT";
+                    (void)ex.perp.place_order(symbol, 1.0, OrderSide::Buy);
+                    (void)ex.perp.place_order(symbol, 1.0, 5.0 + static_cast<double>(s), OrderSide::Buy);
+                }
+            }
+            else {
+                const std::string symbol = "SYM" + std::to_string(step % kMergeUniverseSymbols) + "USDT";
+                (void)ex.perp.place_order(symbol, 0.1, OrderSide::Buy);
+            }
+            (void)ex.get_market_channel()->TryReceive();
+            ++step;
+        }
+        const auto end = std::chrono::steady_clock::now();
+        if (mode == Config::BookChannelMode::Delta) {
+            // The final step's trade is never published: replay ended before its fill.
+            EXPECT_EQ(positions.size(), ex.get_all_positions().size());
+            EXPECT_EQ(orders.size() + 1, ex.get_all_open_orders().size());
+        }
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    };
+
+    double full_best = std::numeric_limits<double>::max();
+    double delta_best = std::numeric_limits<double>::max();
+    uint64_t full_entries = 0;
+    uint64_t delta_entries = 0;
+    for (size_t i = 0; i < kPerfSamples; ++i) {
+        full_best = std::min(full_best, run(Config::BookChannelMode::FullSnapshot, full_entries));
+        delta_best = std::min(delta_best, run(Config::BookChannelMode::Delta, delta_entries));
+    }
+
+    std::cout << "[PERF][BookDeltaChannels] symbols=" << kMergeUniverseSymbols
+              << " rows=" << kMergeUniverseRows
+              << " full_entries=" << full_entries
+              << " delta_entries=" << delta_entries
+              << " full_ns_per_step=" << full_best / kMergeUniverseRows
+              << " delta_ns_per_step=" << delta_best / kMergeUniverseRows
+              << " speedup=" << full_best / delta_best << '\n';
+    EXPECT_LT(delta_entries, full_entries);
+    EXPECT_LE(delta_best, full_best * kMaxModeRatio);
+}
+
+TEST_F(PerfGuardrailFixture, InternedSymbolLookupSkipsStringHashing)
+{
+    // The per-position symbol resolution of the match/settle/liquidate loops, on a universe-sized book.
+    State::StepKernelState state;
+    std::vector<QTrading::dto::Position> positions;
+    for (size_t s = 0; s < kMergeUniverseSymbols; ++s) {
+        const std::string symbol = "SYM" + std::to_string(s) + "USDT";
+        const auto interned = QTrading::Dto::Trading::SymbolTable::Intern(symbol);
+        state.symbols.push_back(symbol);
+        state.symbol_to_id.emplace(symbol, s);
+        state.interned_symbol_id_by_id.push_back(interned);
+        if (interned >= state.symbol_id_by_interned_id.size()) {
+            state.symbol_id_by_interned_id.resize(interned + 1, std::numeric_limits<size_t>::max());
+        }
+        state.symbol_id_by_interned_id[interned] = s;
+        QTrading::dto::Position position{};
+        position.id = static_cast<int>(s + 1);
+        position.symbol = symbol;
+        position.interned_symbol_id = interned;
+        positions.push_back(std::move(position));
+    }
+    constexpr size_t kPasses = 2'000;
+    const auto run = [&](bool use_interned, size_t& checksum) {
+        checksum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t pass = 0; pass < kPasses; ++pass) {
+            for (const auto& position : positions) {
+                const auto symbol_id = State::find_symbol_id(
+                    state,
+                    use_interned ? position.interned_symbol_id : QTrading::Dto::Trading::kInvalidSymbolId,
+                    position.symbol);
+                checksum += symbol_id.value_or(0);
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    };
+
+    double string_best = std::numeric_limits<double>::max();
+    double interned_best = std::numeric_limits<double>::max();
+    size_t string_checksum = 0;
+    size_t interned_checksum = 0;
+    for (size_t i = 0; i < kPerfSamples; ++i) {
+        string_best = std::min(string_best, run(false, string_checksum));
+        interned_best = std::min(interned_best, run(true, interned_checksum));
+    }
+
+    const double lookups = static_cast<double>(kPasses * positions.size());
+    std::cout << "[PERF][InternedSymbolLookup] symbols=" << kMergeUniverseSymbols
+              << " lookups=" << kPasses * positions.size()
+              << " string_ns_per_lookup=" << string_best / lookups
+              << " interned_ns_per_lookup=" << interned_best / lookups
+              << " speedup=" << string_best / interned_best << '\n';
+    EXPECT_EQ(interned_checksum, string_checksum);
+    EXPECT_LT(interned_best, string_best);
+}
+
+TEST_F(PerfGuardrailFixture, ColumnarMarketEventSerializerCutsConsumerCostPerRow)
+{
+    // One day of market events for the merge universe, drained and appended as the sink consumer does.
+    using QTrading::Log::LogRecordSpan;
+    using QTrading::Log::FileLogger::FeatherV2::MarketEventRecord;
+    namespace MarketEvent = QTrading::Log::FileLogger::FeatherV2::MarketEvent;
+    constexpr size_t kBatchRows = 8192;
+    std::vector<QTrading::Dto::Trading::SymbolId> symbols;
+    for (size_t s = 0; s < kMergeUniverseSymbols; ++s) {
+        symbols.push_back(QTrading::Dto::Trading::SymbolTable::Intern("SYM" + std::to_string(s) + "USDT"));
+    }
+    const size_t rows = kMergeUniverseSymbols * kMergeUniverseRows;
+    const size_t stride = sizeof(uint64_t) + sizeof(MarketEventRecord);
+    std::vector<std::byte> slots(rows * stride);
+    for (size_t i = 0; i < rows; ++i) {
+        MarketEventRecord e{};
+        e.step_seq = i / kMergeUniverseSymbols;
+        e.event_seq = i;
+        e.ts_local = i * 60'000;
+        e.symbol_id = symbols[i % kMergeUniverseSymbols];
+        e.has_kline = true;
+        e.close = 100.0 + static_cast<double>(i % 97);
+        std::memcpy(slots.data() + i * stride, &e.ts_local, sizeof(uint64_t));
+        std::memcpy(slots.data() + i * stride + sizeof(uint64_t), &e, sizeof(e));
+    }
+
+    auto builder_res = arrow::RecordBatchBuilder::Make(MarketEvent::Schema(), arrow::default_memory_pool(), kBatchRows);
+    ASSERT_TRUE(builder_res.ok());
+    auto builder = std::move(*builder_res);
+    const auto run = [&](bool columnar, int64_t& written) {
+        written = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t first = 0; first < rows; first += kBatchRows) {
+            const LogRecordSpan span{ 1, slots.data() + first * stride, std::min(kBatchRows, rows - first), stride };
+            auto* ts = builder->GetFieldAs<arrow::UInt64Builder>(0);
+            if (columnar) {
+                EXPECT_TRUE(ts->Reserve(static_cast<int64_t>(span.count)).ok());
+                for (size_t i = 0; i < span.count; ++i) {
+                    ts->UnsafeAppend(span.ts(i));
+                }
+                MarketEvent::RecordBatchSerializer(span, *builder);
+            }
+            else {
+                for (size_t i = 0; i < span.count; ++i) {
+                    EXPECT_TRUE(ts->Append(span.ts(i)).ok());
+                    MarketEvent::RecordSerializer(span.record(i), *builder);
+                }
+            }
+            auto batch = builder->Flush();
+            EXPECT_TRUE(batch.ok());
+            written += (*batch)->num_rows();
+        }
+        const auto end = std::chrono::steady_clock::now();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    };
+
+    double row_best = std::numeric_limits<double>::max();
+    double columnar_best = std::numeric_limits<double>::max();
+    int64_t row_written = 0;
+    int64_t columnar_written = 0;
+    for (size_t i = 0; i < kPerfSamples; ++i) {
+        row_best = std::min(row_best, run(false, row_written));
+        columnar_best = std::min(columnar_best, run(true, columnar_written));
+    }
+
+    std::cout << "[PERF][ColumnarMarketEventSerializer] rows=" << rows
+              << " row_ns_per_row=" << row_best / static_cast<double>(rows)
+              << " columnar_ns_per_row=" << columnar_best / static_cast<double>(rows)
+              << " speedup=" << row_best / columnar_best << '\n';
+    EXPECT_EQ(row_written, static_cast<int64_t>(rows));
+    EXPECT_EQ(columnar_written, static_cast<int64_t>(rows));
+    EXPECT_LT(columnar_best, row_best);
+}
+
+TEST_F(PerfGuardrailFixture, SinkLoggerWriterThreadsSpreadHeavyModules)
+{
+    // Heavy modules: market-event records serialized row by row into their own Feather files.
+    using QTrading::Log::FileLogger::FeatherV2::MarketEventRecord;
+    namespace MarketEvent = QTrading::Log::FileLogger::FeatherV2::MarketEvent;
+    constexpr size_t kHeavyModules = 4;
+    constexpr uint64_t kRowsPerModule = 50'000;
+    const auto symbol = QTrading::Dto::Trading::SymbolTable::Intern("BTCUSDT");
+    const fs::path dir = fs::temp_directory_path() / "QTrading_PerfGuard_SinkWriters";
+
+    const auto run = [&](size_t writer_threads) {
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+        fs::create_directories(dir, ec);
+        QTrading::Log::SinkLogger logger(dir.string());
+        logger.AddSink(std::make_unique<QTrading::Log::FileLogger::FeatherV2Sink>(dir.string()));
+        logger.SetWriterThreads(writer_threads);
+        std::vector<QTrading::Log::Logger::ModuleId> modules;
+        for (size_t m = 0; m < kHeavyModules; ++m) {
+            const std::string name = "Heavy" + std::to_string(m);
+            logger.RegisterRecordModule<MarketEventRecord>(name, MarketEvent::Schema(), MarketEvent::RecordSerializer);
+            modules.push_back(logger.GetModuleId(name));
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        logger.Start();
+        for (uint64_t i = 0; i < kRowsPerModule; ++i) {
+            for (const auto module_id : modules) {
+                EXPECT_TRUE(logger.LogRecord<MarketEventRecord>(module_id, i, [&](MarketEventRecord& e) {
+                    e.step_seq = i;
+                    e.symbol_id = symbol;
+                    e.has_kline = true;
+                    e.close = 100.0 + static_cast<double>(i % 97);
+                }));
+            }
+        }
+        logger.Stop();
+        const auto end = std::chrono::steady_clock::now();
+        EXPECT_EQ(logger.GetMetrics().enqueue_ok, kRowsPerModule * kHeavyModules);
+        fs::remove_all(dir, ec);
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    };
+
+    double single_best = std::numeric_limits<double>::max();
+    double sharded_best = std::numeric_limits<double>::max();
+    for (size_t i = 0; i < kPerfSamples; ++i) {
+        single_best = std::min(single_best, run(1));
+        sharded_best = std::min(sharded_best, run(kHeavyModules));
+    }
+    const double rows = static_cast<double>(kRowsPerModule * kHeavyModules);
+    std::cout << "[PERF][SinkLoggerWriters] modules=" << kHeavyModules
+              << " rows=" << kRowsPerModule * kHeavyModules
+              << " hardware_threads=" << std::thread::hardware_concurrency()
+              << " writers1_ns_per_row=" << single_best / rows
+              << " writers" << kHeavyModules << "_ns_per_row=" << sharded_best / rows
+              << " speedup=" << single_best / sharded_best << '\n';
+    ExpectWithinThreadedOverheadBudget(sharded_best, single_best, "sink-writers");
+}
+
+TEST_F(PerfGuardrailFixture, KlineCsvBulkParseKeepsPaceWithLineByLineOnEveryKernel)
+{
+    namespace Csv = QTrading::Infra::Data::Binance;
+    constexpr size_t kRows = 100000;
+    const std::string csv = MakeMinuteKlineCsv(kRows);
+    const double mb = static_cast<double>(csv.size()) / (1024.0 * 1024.0);
+
+    std::vector<Csv::CsvScanKernel> kernels{ Csv::CsvScanKernel::Scalar };
+    const auto best_kernel = Csv::DetectCsvScanKernel();
+    for (const auto kernel : { Csv::CsvScanKernel::Sse2, Csv::CsvScanKernel::Avx2 }) {
+        if (kernel <= best_kernel) {
+            kernels.push_back(kernel);
+        }
+    }
+    const auto time_ns = [](auto&& fn) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        const auto end = std::chrono::steady_clock::now();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    };
+
+    // Samples interleave all variants so a noisy neighbour hits them alike; best sample wins.
+    double legacy_best = std::numeric_limits<double>::max();
+    std::vector<double> bulk_best(kernels.size(), std::numeric_limits<double>::max());
+    size_t legacy_rows = 0;
+    std::vector<size_t> bulk_rows(kernels.size(), 0);
+    for (size_t i = 0; i < kPerfSamples; ++i) {
+        legacy_best = std::min(legacy_best, time_ns([&]() { legacy_rows = ParseKlineCsvLineByLine(csv); }));
+        for (size_t k = 0; k < kernels.size(); ++k) {
+            bulk_best[k] = std::min(bulk_best[k], time_ns([&]() {
+                Csv::KlineCsvParseOptions options;
+                options.kernel = kernels[k];
+                options.reserve_rows = kRows;
+                std::istringstream in(csv, std::ios::binary);
+                bulk_rows[k] = Csv::ParseKlineCsv(in, options).columns.size();
+            }));
+        }
+    }
+
+    std::cout << "[PERF][KlineCsvParse] bytes=" << csv.size()
+              << " legacy_mb_s=" << mb * 1e9 / legacy_best;
+    for (size_t k = 0; k < kernels.size(); ++k) {
+        std::cout << " kernel" << static_cast<int>(kernels[k]) << "_mb_s=" << mb * 1e9 / bulk_best[k];
+    }
+    std::cout << '\n';
+    EXPECT_EQ(legacy_rows, kRows);
+    for (size_t k = 0; k < kernels.size(); ++k) {
+        EXPECT_EQ(bulk_rows[k], kRows);
+        EXPECT_LE(bulk_best[k], legacy_best * kMaxBulkCsvParseRatioVsLineByLine)
+            << "CSV_PARSE_BUDGET_FAIL kernel=" << static_cast<int>(kernels[k]);
+    }
+}
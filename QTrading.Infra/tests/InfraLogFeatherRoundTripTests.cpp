@@ -8,7 +8,6 @@
 
 #include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
 #include "FeatherRoundTripFixture.hpp"
-#include "Global.hpp"
 
 namespace {
 
@@ -105,7 +104,7 @@ TEST_F(InfraLogFeatherRoundTripFixture, FeatherRoundTripFixtureWritesAndReadsArr
     RegisterMarketEventModule();
     StartLogger();
 
-    QTrading::Utils::GlobalTimestamp.store(111u);
+    logger->SetTimestamp(111u);
     QTrading::Log::FileLogger::FeatherV2::RunMetadataDto meta{};
     meta.run_id = 7001u;
     meta.strategy_name = "roundtrip";
@@ -114,7 +113,7 @@ TEST_F(InfraLogFeatherRoundTripFixture, FeatherRoundTripFixtureWritesAndReadsArr
     meta.dataset = "fixture";
     ASSERT_TRUE(logger->Log(QTrading::Log::LogModuleToString(QTrading::Log::LogModule::RunMetadata), meta));
 
-    QTrading::Utils::GlobalTimestamp.store(222u);
+    logger->SetTimestamp(222u);
     QTrading::Log::FileLogger::FeatherV2::MarketEventDto market_a{};
     market_a.run_id = 7001u;
     market_a.step_seq = 3u;
@@ -125,7 +124,7 @@ TEST_F(InfraLogFeatherRoundTripFixture, FeatherRoundTripFixtureWritesAndReadsArr
     market_a.close = 101.5;
     ASSERT_TRUE(logger->Log(QTrading::Log::LogModuleToString(QTrading::Log::LogModule::MarketEvent), market_a));
 
-    QTrading::Utils::GlobalTimestamp.store(333u);
+    logger->SetTimestamp(333u);
     QTrading::Log::FileLogger::FeatherV2::MarketEventDto market_b{};
     market_b.run_id = 7001u;
     market_b.step_seq = 3u;
@@ -178,7 +177,7 @@ TEST_F(InfraLogFeatherRoundTripFixture, AccountArrowSchemaMatchesLegacyFieldsExa
     RegisterAccountModule();
     StartLogger();
 
-    QTrading::Utils::GlobalTimestamp.store(100u);
+    logger->SetTimestamp(100u);
     QTrading::dto::AccountLog account{};
     account.balance = 10.0;
     account.unreal_pnl = 1.0;
@@ -206,7 +205,7 @@ TEST_F(InfraLogFeatherRoundTripFixture, OrderEventArrowSchemaMatchesLegacyFields
     RegisterOrderEventModule();
     StartLogger();
 
-    QTrading::Utils::GlobalTimestamp.store(200u);
+    logger->SetTimestamp(200u);
     QTrading::Log::FileLogger::FeatherV2::OrderEventDto event{};
     event.run_id = 8200u;
     event.step_seq = 2u;
@@ -230,7 +229,7 @@ TEST_F(InfraLogFeatherRoundTripFixture, PositionEventArrowSchemaMatchesLegacyFie
     RegisterPositionEventModule();
     StartLogger();
 
-    QTrading::Utils::GlobalTimestamp.store(300u);
+    logger->SetTimestamp(300u);
     QTrading::Log::FileLogger::FeatherV2::PositionEventDto event{};
     event.run_id = 8300u;
     event.step_seq = 3u;
@@ -255,7 +254,7 @@ TEST_F(InfraLogFeatherRoundTripFixture, FundingEventArrowSchemaMatchesLegacyFiel
     RegisterFundingEventModule();
     StartLogger();
 
-    QTrading::Utils::GlobalTimestamp.store(400u);
+    logger->SetTimestamp(400u);
     QTrading::Log::FileLogger::FeatherV2::FundingEventDto event{};
     event.run_id = 8400u;
     event.step_seq = 4u;
@@ -282,7 +281,7 @@ TEST_F(InfraLogFeatherRoundTripFixture, MarketEventArrowSchemaMatchesLegacyField
     RegisterMarketEventModule();
     StartLogger();
 
-    QTrading::Utils::GlobalTimestamp.store(500u);
+    logger->SetTimestamp(500u);
     QTrading::Log::FileLogger::FeatherV2::MarketEventDto event{};
     event.run_id = 8500u;
     event.step_seq = 5u;
@@ -405,7 +404,7 @@ TEST_F(InfraLogFeatherRoundTripFixture, ArrowFieldValuesMatchInMemoryPayloadDeco
     account.spot_ledger_value = 27.0;
     account.total_cash_balance = 120.0;
     account.total_ledger_value = 132.0;
-    QTrading::Utils::GlobalTimestamp.store(1000u);
+    logger->SetTimestamp(1000u);
     ASSERT_TRUE(logger->Log(QTrading::Log::LogModuleToString(QTrading::Log::LogModule::Account), account));
 
     QTrading::Log::FileLogger::FeatherV2::OrderEventDto order_event{};
@@ -422,7 +421,7 @@ TEST_F(InfraLogFeatherRoundTripFixture, ArrowFieldValuesMatchInMemoryPayloadDeco
     order_event.exec_price = 101.25;
     order_event.remaining_qty = 0.0;
     order_event.fee_quote_equiv = 0.15;
-    QTrading::Utils::GlobalTimestamp.store(1002u);
+    logger->SetTimestamp(1002u);
     ASSERT_TRUE(logger->Log(QTrading::Log::LogModuleToString(QTrading::Log::LogModule::OrderEvent), order_event));
 
     QTrading::Log::FileLogger::FeatherV2::PositionEventDto position_event{};
@@ -438,7 +437,7 @@ TEST_F(InfraLogFeatherRoundTripFixture, ArrowFieldValuesMatchInMemoryPayloadDeco
     position_event.event_type = static_cast<int32_t>(QTrading::Log::FileLogger::FeatherV2::PositionEventType::Opened);
     position_event.qty = 1.5;
     position_event.entry_price = 101.25;
-    QTrading::Utils::GlobalTimestamp.store(1004u);
+    logger->SetTimestamp(1004u);
     ASSERT_TRUE(logger->Log(QTrading::Log::LogModuleToString(QTrading::Log::LogModule::PositionEvent), position_event));
 
     QTrading::Log::FileLogger::FeatherV2::FundingEventDto funding_event{};
@@ -453,7 +452,7 @@ TEST_F(InfraLogFeatherRoundTripFixture, ArrowFieldValuesMatchInMemoryPayloadDeco
     funding_event.mark_price = 100.0;
     funding_event.quantity = 1.5;
     funding_event.funding = 0.15;
-    QTrading::Utils::GlobalTimestamp.store(1006u);
+    logger->SetTimestamp(1006u);
     ASSERT_TRUE(logger->Log(QTrading::Log::LogModuleToString(QTrading::Log::LogModule::FundingEvent), funding_event));
 
     QTrading::Log::FileLogger::FeatherV2::MarketEventDto market_event{};
@@ -472,7 +471,7 @@ TEST_F(InfraLogFeatherRoundTripFixture, ArrowFieldValuesMatchInMemoryPayloadDeco
     market_event.mark_price = 100.5;
     market_event.has_index_price = true;
     market_event.index_price = 100.4;
-    QTrading::Utils::GlobalTimestamp.store(1008u);
+    logger->SetTimestamp(1008u);
     ASSERT_TRUE(logger->Log(QTrading::Log::LogModuleToString(QTrading::Log::LogModule::MarketEvent), market_event));
 
     StopLogger();
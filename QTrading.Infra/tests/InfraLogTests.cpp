@@ -13,7 +13,6 @@
 #include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
 #undef private
 #include "Exchanges/BinanceSimulator/State/BinanceExchangeRuntimeState.hpp"
-#include "Global.hpp"
 #include "ReplaySemanticsInputPinning.hpp"
 #include "InfraLogTestFixture.hpp"
 
@@ -592,6 +591,11 @@ public:
         return 0;
     }
 
+    uint64_t WriteRecords(const QTrading::Log::LogRecordSpan&) override
+    {
+        return 0;
+    }
+
     uint64_t Flush() override
     {
         flushed_rows_.insert(flushed_rows_.end(), pending_rows_.begin(), pending_rows_.end());
@@ -670,6 +674,11 @@ public:
         return 0;
     }
 
+    uint64_t WriteRecords(const QTrading::Log::LogRecordSpan&) override
+    {
+        return 0;
+    }
+
     uint64_t Flush() override
     {
         return 0;
@@ -724,7 +733,7 @@ std::vector<LegacyLogContractSnapshot> CaptureCriticalOnlySequenceWithLoggerMode
         local_logger->Start();
     }
 
-    QTrading::Utils::GlobalTimestamp.store(10u);
+    local_logger->SetTimestamp(10u);
     if (!local_logger->Log(
             QTrading::Log::LogModuleToString(QTrading::Log::LogModule::RunMetadata),
             MakeRunMetadata(700u, "critical-only", "reference"))) {
@@ -746,7 +755,7 @@ std::vector<LegacyLogContractSnapshot> CaptureCriticalOnlySequenceWithLoggerMode
         return {};
     }
 
-    QTrading::Utils::GlobalTimestamp.store(20u);
+    local_logger->SetTimestamp(20u);
     if (!local_logger->Log(
             QTrading::Log::LogModuleToString(QTrading::Log::LogModule::RunMetadata),
             MakeRunMetadata(701u, "critical-only-after", "reference"))) {
@@ -886,7 +895,7 @@ protected:
         meta.strategy_version = "1";
         meta.strategy_params = "{}";
         meta.dataset = "golden";
-        QTrading::Utils::GlobalTimestamp.store(0u);
+        replay_logger->SetTimestamp(0u);
         if (!replay_logger->Log(QTrading::Log::LogModuleToString(QTrading::Log::LogModule::RunMetadata), meta)) {
             ADD_FAILURE() << "failed to log golden replay metadata";
             replay_logger->Stop();
@@ -931,7 +940,7 @@ protected:
         meta.strategy_version = "1";
         meta.strategy_params = "{}";
         meta.dataset = "fixed-csv";
-        QTrading::Utils::GlobalTimestamp.store(0u);
+        replay_logger->SetTimestamp(0u);
         if (!replay_logger->Log(QTrading::Log::LogModuleToString(QTrading::Log::LogModule::RunMetadata), meta)) {
             ADD_FAILURE() << "failed to log deterministic run metadata";
             replay_logger->Stop();
@@ -998,7 +1007,7 @@ TEST_F(InfraLogTestFixture, SinkLoggerCapturesRows)
 {
     constexpr uint64_t expected_run_id = 42;
     constexpr uint64_t expected_ts = 0xABCDEFull;
-    QTrading::Utils::GlobalTimestamp.store(expected_ts);
+    logger->SetTimestamp(expected_ts);
 
     QTrading::Log::FileLogger::FeatherV2::RunMetadataDto payload{};
     payload.run_id = expected_run_id;
@@ -1027,7 +1036,7 @@ TEST_F(InfraLogTestFixture, AccountSnapshotRowIsCapturedAfterLoggerStart)
 {
     constexpr uint64_t expected_ts = 1100u;
     const auto expected = MakeAccountSnapshot(1234.5);
-    QTrading::Utils::GlobalTimestamp.store(expected_ts);
+    logger->SetTimestamp(expected_ts);
 
     ASSERT_TRUE(logger->Log(QTrading::Log::LogModuleToString(QTrading::Log::LogModule::Account), expected));
     StopLogger();
@@ -1047,7 +1056,7 @@ TEST_F(InfraLogTestFixture, PositionSnapshotRowIsCapturedAfterLoggerStart)
 {
     constexpr uint64_t expected_ts = 1200u;
     const auto expected = MakePositionSnapshot();
-    QTrading::Utils::GlobalTimestamp.store(expected_ts);
+    logger->SetTimestamp(expected_ts);
 
     ASSERT_TRUE(logger->Log(QTrading::Log::LogModuleToString(QTrading::Log::LogModule::Position), expected));
     StopLogger();
@@ -1068,7 +1077,7 @@ TEST_F(InfraLogTestFixture, OrderSnapshotRowIsCapturedAfterLoggerStart)
 {
     constexpr uint64_t expected_ts = 1300u;
     const auto expected = MakeOrderSnapshot();
-    QTrading::Utils::GlobalTimestamp.store(expected_ts);
+    logger->SetTimestamp(expected_ts);
 
     ASSERT_TRUE(logger->Log(QTrading::Log::LogModuleToString(QTrading::Log::LogModule::Order), expected));
     StopLogger();
@@ -1098,7 +1107,7 @@ TEST_F(InfraLogTestFixture, MultiRowArrivalOrderRemainsStableWithinSingleStep)
     payloads.emplace_back(QTrading::Log::MakePayload<MarketEventDto>(
         MakeMarketEvent(88u, 5u, 2u, 555u, "BNBUSDT", 300.0)));
 
-    QTrading::Utils::GlobalTimestamp.store(999999u);
+    logger->SetTimestamp(999999u);
     ASSERT_EQ(
         logger->LogBatchAt(
             ModuleId(QTrading::Log::LogModule::MarketEvent),
@@ -1137,11 +1146,11 @@ TEST_F(InfraLogTestFixture, StopFlushesBufferedRowsThatWereNotFlushedYet)
     InfraLogFixtureAccess::RegisterDefaultModules(*local_logger, resolver);
     local_logger->Start();
 
-    QTrading::Utils::GlobalTimestamp.store(1500u);
+    local_logger->SetTimestamp(1500u);
     ASSERT_TRUE(local_logger->Log(
         QTrading::Log::LogModuleToString(QTrading::Log::LogModule::RunMetadata),
         MakeRunMetadata(150u, "stop-flush-a", "buffered")));
-    QTrading::Utils::GlobalTimestamp.store(1501u);
+    local_logger->SetTimestamp(1501u);
     ASSERT_TRUE(local_logger->Log(
         QTrading::Log::LogModuleToString(QTrading::Log::LogModule::RunMetadata),
         MakeRunMetadata(151u, "stop-flush-b", "buffered")));
@@ -1158,11 +1167,11 @@ TEST_F(InfraLogTestFixture, StopFlushesBufferedRowsThatWereNotFlushedYet)
 
 TEST_F(InfraLogTestFixture, DifferentModulesKeepTheirOwnModuleIdsWithoutCrossPollution)
 {
-    QTrading::Utils::GlobalTimestamp.store(1600u);
+    logger->SetTimestamp(1600u);
     ASSERT_TRUE(logger->Log(QTrading::Log::LogModuleToString(QTrading::Log::LogModule::Account), MakeAccountSnapshot(50.0)));
-    QTrading::Utils::GlobalTimestamp.store(1601u);
+    logger->SetTimestamp(1601u);
     ASSERT_TRUE(logger->Log(QTrading::Log::LogModuleToString(QTrading::Log::LogModule::Position), MakePositionSnapshot()));
-    QTrading::Utils::GlobalTimestamp.store(1602u);
+    logger->SetTimestamp(1602u);
     ASSERT_TRUE(logger->Log(QTrading::Log::LogModuleToString(QTrading::Log::LogModule::Order), MakeOrderSnapshot()));
     StopLogger();
 
@@ -1182,7 +1191,7 @@ TEST_F(InfraLogTestFixture, DifferentModulesKeepTheirOwnModuleIdsWithoutCrossPol
     EXPECT_EQ(*order_module, QTrading::Log::LogModuleToString(QTrading::Log::LogModule::Order));
 }
 
-TEST_F(InfraLogTestFixture, LogBatchAtPreservesExplicitTimestampInsteadOfGlobalTimestamp)
+TEST_F(InfraLogTestFixture, LogBatchAtPreservesExplicitTimestampInsteadOfLoggerTimestamp)
 {
     using QTrading::Log::FileLogger::FeatherV2::MarketEventDto;
 
@@ -1192,7 +1201,7 @@ TEST_F(InfraLogTestFixture, LogBatchAtPreservesExplicitTimestampInsteadOfGlobalT
     payloads.emplace_back(QTrading::Log::MakePayload<MarketEventDto>(
         MakeMarketEvent(170u, 1u, 1u, 777u, "ETHUSDT", 456.0)));
 
-    QTrading::Utils::GlobalTimestamp.store(99999999u);
+    logger->SetTimestamp(99999999u);
     ASSERT_EQ(
         logger->LogBatchAt(
             ModuleId(QTrading::Log::LogModule::MarketEvent),
@@ -1206,7 +1215,7 @@ TEST_F(InfraLogTestFixture, LogBatchAtPreservesExplicitTimestampInsteadOfGlobalT
     ASSERT_EQ(market_rows.size(), 2u);
     EXPECT_EQ(market_rows[0].row->ts, 777u);
     EXPECT_EQ(market_rows[1].row->ts, 777u);
-    EXPECT_NE(market_rows[0].row->ts, QTrading::Utils::GlobalTimestamp.load());
+    EXPECT_NE(market_rows[0].row->ts, logger->CurrentTimestamp());
 }
 
 TEST_F(InfraLogTestFixture, CriticalOnlyRowsKeepSameOrderWhenDebugChannelIsEnabled)
@@ -1225,7 +1234,7 @@ TEST_F(InfraLogTestFixture, InMemorySinkInjectionRowsRemainReadableAfterLoggerSt
 {
     constexpr uint64_t expected_run_id = 7;
     constexpr uint64_t expected_ts = 123456u;
-    QTrading::Utils::GlobalTimestamp.store(expected_ts);
+    logger->SetTimestamp(expected_ts);
 
     QTrading::Log::FileLogger::FeatherV2::RunMetadataDto payload{};
     payload.run_id = expected_run_id;
@@ -1393,17 +1402,17 @@ TEST_F(InfraLogTestFixture, RegisterDefaultModulesKeepsExpectedSchemaAndSerializ
 
 TEST_F(InfraLogTestFixture, RunMetadataAppearsFirstAfterLoggerInitialization)
 {
-    QTrading::Utils::GlobalTimestamp.store(2200u);
+    logger->SetTimestamp(2200u);
     ASSERT_TRUE(logger->Log(
         QTrading::Log::LogModuleToString(QTrading::Log::LogModule::RunMetadata),
         MakeRunMetadata(220u, "session-start", "contract")));
 
-    QTrading::Utils::GlobalTimestamp.store(2201u);
+    logger->SetTimestamp(2201u);
     ASSERT_TRUE(logger->Log(
         QTrading::Log::LogModuleToString(QTrading::Log::LogModule::Account),
         MakeAccountSnapshot(500.0)));
 
-    QTrading::Utils::GlobalTimestamp.store(2202u);
+    logger->SetTimestamp(2202u);
     ASSERT_TRUE(logger->Log(
         QTrading::Log::LogModuleToString(QTrading::Log::LogModule::Position),
         MakePositionSnapshot()));
@@ -2167,7 +2176,7 @@ TEST_F(InfraLogTestFixture, RowPayloadCastReturnsNullptrForInvalidOrEmptyRow)
 TEST_F(InfraLogTestFixture, DrainAndSortRowsByArrivalDistinguishesArrivalFromBusinessSort)
 {
     auto log_run_metadata = [&](uint64_t ts, uint64_t run_id, const char* strategy_name) {
-        QTrading::Utils::GlobalTimestamp.store(ts);
+        logger->SetTimestamp(ts);
 
         QTrading::Log::FileLogger::FeatherV2::RunMetadataDto payload{};
         payload.run_id = run_id;
@@ -2235,7 +2244,7 @@ TEST_F(InfraLogTestFixture, DrainAndSortRowsByArrivalDistinguishesArrivalFromBus
 TEST_F(InfraLogTestFixture, FilterRowsByModuleKeepsOnlyRequestedModuleInArrivalOrder)
 {
     auto log_run_metadata = [&](uint64_t ts, uint64_t run_id, const char* strategy_name) {
-        QTrading::Utils::GlobalTimestamp.store(ts);
+        logger->SetTimestamp(ts);
 
         QTrading::Log::FileLogger::FeatherV2::RunMetadataDto payload{};
         payload.run_id = run_id;
@@ -2248,7 +2257,7 @@ TEST_F(InfraLogTestFixture, FilterRowsByModuleKeepsOnlyRequestedModuleInArrivalO
     };
 
     auto log_account = [&](uint64_t ts, double balance) {
-        QTrading::Utils::GlobalTimestamp.store(ts);
+        logger->SetTimestamp(ts);
 
         QTrading::dto::AccountLog payload{};
         payload.balance = balance;
@@ -2345,7 +2354,7 @@ TEST_F(InfraLogTestFixture, AssertSingleStepEnvelopeValidatesMarketEventRowsFrom
 
 TEST_F(InfraLogTestFixture, LegacyLogContractSnapshotBuildsDeterministicEqualityComparableRows)
 {
-    QTrading::Utils::GlobalTimestamp.store(11u);
+    logger->SetTimestamp(11u);
     QTrading::Log::FileLogger::FeatherV2::RunMetadataDto run_metadata{};
     run_metadata.run_id = 9001u;
     run_metadata.strategy_name = "snapshot-test";
@@ -2354,7 +2363,7 @@ TEST_F(InfraLogTestFixture, LegacyLogContractSnapshotBuildsDeterministicEquality
     run_metadata.dataset = "fixture";
     ASSERT_TRUE(logger->Log(QTrading::Log::LogModuleToString(QTrading::Log::LogModule::RunMetadata), run_metadata));
 
-    QTrading::Utils::GlobalTimestamp.store(22u);
+    logger->SetTimestamp(22u);
     QTrading::Log::FileLogger::FeatherV2::MarketEventDto market_event{};
     market_event.run_id = 9001u;
     market_event.step_seq = 3u;
@@ -6127,3 +6136,67 @@ TEST_F(InfraLogTestFixture, AggregatedFundingEventsMatchAccountEventAndSnapshotW
 
 
 
+
+TEST_F(InfraLogTestFixture, MarketEventRecordModuleMatchesBoxedMarketEvents)
+{
+    using QTrading::Log::FileLogger::FeatherV2::MarketEventDto;
+    using QTrading::Log::FileLogger::FeatherV2::MarketEventRecord;
+    using QTrading::Infra::Exchanges::BinanceSim::Contracts::SymbolDataset;
+
+    WriteBinanceCsv(
+        tmp_dir / "btc.csv",
+        { { 0u, 100.0, 101.0, 99.0, 100.5, 1000.0, 59999u, 1000.0, 1, 0.0, 0.0 },
+          { 60000u, 101.0, 102.0, 100.0, 101.5, 1100.0, 119999u, 1100.0, 1, 0.0, 0.0 } });
+    WriteBinanceCsv(
+        tmp_dir / "eth.csv",
+        { { 60000u, 200.0, 201.0, 199.0, 200.5, 2000.0, 119999u, 2000.0, 1, 0.0, 0.0 } });
+    std::vector<SymbolDataset> datasets(2);
+    datasets[0].symbol = "BTCUSDT";
+    datasets[0].kline_csv = (tmp_dir / "btc.csv").string();
+    datasets[1].symbol = "ETHUSDT";
+    datasets[1].kline_csv = (tmp_dir / "eth.csv").string();
+
+    const auto run = [&](const std::shared_ptr<QTrading::Log::Logger>& run_logger) {
+        BinanceExchangeImpl exchange(datasets, run_logger, MakeAccountInitConfig(1000.0));
+        while (exchange.step()) {
+            (void)exchange.get_market_channel()->TryReceive();
+        }
+    };
+    run(logger);
+    StopLogger();
+    const auto boxed_rows = FilterRowsByModule(QTrading::Log::LogModule::MarketEvent);
+
+    auto record_logger = std::make_shared<QTrading::Log::SinkLogger>((tmp_dir / "records").string());
+    auto record_sink = std::make_unique<QTrading::Log::InMemorySink>();
+    const auto* records_sink = record_sink.get();
+    record_logger->AddSink(std::move(record_sink));
+    record_logger->RegisterRecordModule<MarketEventRecord>(
+        QTrading::Log::LogModuleToString(QTrading::Log::LogModule::MarketEvent),
+        QTrading::Log::FileLogger::FeatherV2::MarketEvent::Schema(),
+        QTrading::Log::FileLogger::FeatherV2::MarketEvent::RecordSerializer);
+    const auto market_module_id = record_logger->GetModuleId(
+        QTrading::Log::LogModuleToString(QTrading::Log::LogModule::MarketEvent));
+    record_logger->Start();
+    run(record_logger);
+    record_logger->Stop();
+
+    EXPECT_TRUE(records_sink->rows().empty());
+    const auto& records = records_sink->records();
+    ASSERT_EQ(boxed_rows.size(), 4u);
+    ASSERT_EQ(records.size(), boxed_rows.size());
+    for (size_t i = 0; i < records.size(); ++i) {
+        const auto* boxed = RowPayloadCast<MarketEventDto>(boxed_rows[i].row);
+        ASSERT_NE(boxed, nullptr);
+        const auto record = records[i].As<MarketEventRecord>();
+        EXPECT_EQ(records[i].module_id, market_module_id);
+        EXPECT_EQ(records[i].ts, boxed_rows[i].row->ts) << "row " << i;
+        EXPECT_EQ(QTrading::Dto::Trading::SymbolTable::Name(record.symbol_id), boxed->symbol) << "row " << i;
+        EXPECT_EQ(record.step_seq, boxed->step_seq);
+        EXPECT_EQ(record.event_seq, boxed->event_seq);
+        EXPECT_EQ(record.has_kline, boxed->has_kline);
+        EXPECT_EQ(record.close, boxed->close);
+        EXPECT_EQ(record.volume, boxed->volume);
+        EXPECT_EQ(record.has_mark_price, boxed->has_mark_price);
+        EXPECT_EQ(record.ts_local, boxed->ts_local);
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <gtest/gtest.h>
+
+#include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
+
+inline constexpr uint64_t kMinute = 60'000;
+
+/// @brief Account with 100k in both ledgers, shared by the replay-level exchange tests.
+inline QTrading::Infra::Exchanges::BinanceSim::Account::AccountInitConfig make_account_init()
+{
+    QTrading::Infra::Exchanges::BinanceSim::Account::AccountInitConfig cfg{};
+    cfg.init_balance = 100'000.0;
+    cfg.spot_initial_cash = 100'000.0;
+    cfg.perp_initial_wallet = 100'000.0;
+    return cfg;
+}
+
+/// @brief Expects bit-identical clock, wallet, pnl, funding count and per-symbol prices.
+inline void expect_same_status(
+    const QTrading::Infra::Exchanges::BinanceSim::BinanceExchange& actual,
+    const QTrading::Infra::Exchanges::BinanceSim::BinanceExchange& expected)
+{
+    QTrading::Infra::Exchanges::BinanceSim::BinanceExchange::StatusSnapshot a{};
+    QTrading::Infra::Exchanges::BinanceSim::BinanceExchange::StatusSnapshot e{};
+    actual.FillStatusSnapshot(a);
+    expected.FillStatusSnapshot(e);
+    EXPECT_EQ(a.ts_exchange, e.ts_exchange);
+    EXPECT_EQ(a.wallet_balance, e.wallet_balance);
+    EXPECT_EQ(a.total_unrealized_pnl, e.total_unrealized_pnl);
+    EXPECT_EQ(a.funding_applied_events, e.funding_applied_events);
+    ASSERT_EQ(a.prices.size(), e.prices.size());
+    for (size_t i = 0; i < e.prices.size(); ++i) {
+        EXPECT_EQ(a.prices[i].trade_price, e.prices[i].trade_price) << a.prices[i].symbol;
+        EXPECT_EQ(a.prices[i].mark_price, e.prices[i].mark_price) << a.prices[i].symbol;
+        EXPECT_EQ(a.prices[i].has_mark_price, e.prices[i].has_mark_price) << a.prices[i].symbol;
+    }
+}
+
+/// @brief Writes synthetic per-test kline/funding CSVs for replay-level exchange tests and
+///        removes them on teardown.
+class ReplayCsvFixture : public ::testing::Test {
+protected:
+    /// @param tag  File-name prefix of the test file, e.g. "fork".
+    /// @param rows One-minute rows spanned by every written series.
+    ReplayCsvFixture(std::string tag, size_t rows)
+        : tag_(std::move(tag)), rows_(rows)
+    {
+    }
+
+    void TearDown() override {
+        for (const auto& path : files) {
+            boost::filesystem::remove(path);
+        }
+    }
+
+    /// @brief "test_<tag>_<test name>_<name>", so parallel test processes never share a file.
+    std::string test_file(const std::string& name) const {
+        return std::string("test_") + tag_ + "_" +
+            ::testing::UnitTest::GetInstance()->current_test_info()->name() + "_" + name;
+    }
+
+    /// @brief One bar every `stride` minutes; closes cycle through `base_price + (i % 17) * 0.5`.
+    std::string write_klines(const std::string& name, double base_price, size_t stride = 1) {
+        const std::string path = test_file(name);
+        boost::filesystem::ofstream ofs(path);
+        ofs << "OpenTime,OpenPrice,HighPrice,LowPrice,ClosePrice,Volume,CloseTime,QuoteVolume,TradeCount,TakerBuyBaseVolume,TakerBuyQuoteVolume\n";
+        for (size_t i = 0; i < rows_; i += stride) {
+            const uint64_t ts = i * kMinute;
+            const double px = base_price + static_cast<double>(i % 17) * 0.5;
+            ofs << ts << ',' << px << ',' << px << ',' << px << ',' << px << ",1000,"
+                << (ts + kMinute - 1) << ",100000,10,500,50000\n";
+        }
+        files.push_back(path);
+        return path;
+    }
+
+    /// @brief Hourly funding rows at rate 0.0001 and mark 101.
+    std::string write_funding(const std::string& name) {
+        const std::string path = test_file(name);
+        boost::filesystem::ofstream ofs(path);
+        ofs << "FundingTime,Rate,MarkPrice\n";
+        for (uint64_t ts = 60 * kMinute; ts < rows_ * kMinute; ts += 60 * kMinute) {
+            ofs << ts << ",0.0001,101\n";
+        }
+        files.push_back(path);
+        return path;
+    }
+
+    std::vector<QTrading::Infra::Exchanges::BinanceSim::Contracts::SymbolDataset> datasets;
+    std::vector<std::string> files;
+
+private:
+    std::string tag_;
+    size_t rows_;
+};
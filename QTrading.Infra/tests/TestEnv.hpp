@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdlib>
+
+/// @brief Sets a process environment variable, portable across the CRT and POSIX.
+inline void set_env_var(const char* key, const char* value)
+{
+#ifdef _WIN32
+    _putenv_s(key, value);
+#else
+    setenv(key, value, 1);
+#endif
+}
+
+/// @brief Clears a process environment variable set by `set_env_var`.
+inline void unset_env_var(const char* key)
+{
+#ifdef _WIN32
+    _putenv_s(key, "");
+#else
+    unsetenv(key);
+#endif
+}
@@ -6,6 +6,8 @@
 #include <cstdint>
 #include <cstddef>
 #include <optional>
+#include <string>
+#include <string_view>
 
 namespace QTrading::Intent {
 
@@ -20,6 +22,9 @@ public:
 
     TradeIntent build(const QTrading::Signal::SignalDecision& signal,
         const std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>& market) override;
+    /// @brief Current leg direction and the time of its last switch.
+    bool save_state(std::string& out) const override;
+    bool restore_state(std::string_view in) override;
 
 private:
     Config cfg_;
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include "IIntentBuilder.hpp"
 #include "Dto/Market/Binance/MultiKline.hpp"
 
@@ -33,6 +34,13 @@ public:
 
     virtual TradeIntent build(const QTrading::Signal::SignalDecision& signal,
         const std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>& market) override;
+    /// @brief Stateless across bars, so the saved state is empty.
+    bool save_state(std::string& out) const override
+    {
+        out.clear();
+        return true;
+    }
+    bool restore_state(std::string_view in) override { return in.empty(); }
 
 private:
     Config cfg_;
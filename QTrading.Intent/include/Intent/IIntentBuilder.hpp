@@ -3,6 +3,9 @@
 #include "TradeIntent.hpp"
 #include "Signal/SignalDecision.hpp"
 
+#include <string>
+#include <string_view>
+
 namespace QTrading::Intent {
 
 /// @brief Interface for converting signals into trade intents.
@@ -14,6 +17,20 @@ public:
     /// @brief Build a trade intent from signal and market snapshot.
     virtual TradeIntent build(const QTrading::Signal::SignalDecision& signal,
         const TMarket& market) = 0;
+    /// @brief Replaces `out` with the leg-direction state carried across bars, for strategy checkpoints;
+    ///        false (the default) when the builder cannot be checkpointed.
+    virtual bool save_state(std::string& out) const
+    {
+        (void)out;
+        return false;
+    }
+    /// @brief Restores state written by `save_state`; false (the default) when not supported.
+    ///        Throws std::runtime_error on malformed state.
+    virtual bool restore_state(std::string_view in)
+    {
+        (void)in;
+        return false;
+    }
 };
 
 /// @brief No-op intent builder returning empty intents.
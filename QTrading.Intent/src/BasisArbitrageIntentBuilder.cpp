@@ -1,5 +1,6 @@
 #include "Intent/BasisArbitrageIntentBuilder.hpp"
 #include "Intent/PairTradeIntentSupport.hpp"
+#include "Serialization/StateArchive.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -127,26 +128,21 @@ std::optional<double> BasisArbitrageIntentBuilder::ComputeBasisPct(
         return std::nullopt;
     }
 
-    if (cfg_.basis_direction_use_mark_index &&
-        perp_id_ < market->mark_klines_by_id.size() &&
-        perp_id_ < market->index_klines_by_id.size())
+    if (cfg_.basis_direction_use_mark_index)
     {
-        const auto& mark_opt = market->mark_klines_by_id[perp_id_];
-        const auto& index_opt = market->index_klines_by_id[perp_id_];
-        if (mark_opt.has_value() && index_opt.has_value() && index_opt->ClosePrice > 0.0) {
-            return (mark_opt->ClosePrice - index_opt->ClosePrice) / index_opt->ClosePrice;
+        const auto mark_close = market->mark_close(perp_id_);
+        const auto index_close = market->index_close(perp_id_);
+        if (mark_close.has_value() && index_close.has_value() && *index_close > 0.0) {
+            return (*mark_close - *index_close) / *index_close;
         }
     }
 
-    if (spot_id_ >= market->trade_klines_by_id.size() || perp_id_ >= market->trade_klines_by_id.size()) {
+    const auto spot_close = market->trade_close(spot_id_);
+    const auto perp_close = market->trade_close(perp_id_);
+    if (!spot_close.has_value() || !perp_close.has_value() || *spot_close <= 0.0) {
         return std::nullopt;
     }
-    const auto& spot_opt = market->trade_klines_by_id[spot_id_];
-    const auto& perp_opt = market->trade_klines_by_id[perp_id_];
-    if (!spot_opt.has_value() || !perp_opt.has_value() || spot_opt->ClosePrice <= 0.0) {
-        return std::nullopt;
-    }
-    return (perp_opt->ClosePrice - spot_opt->ClosePrice) / spot_opt->ClosePrice;
+    return (*perp_close - *spot_close) / *spot_close;
 }
 
 void BasisArbitrageIntentBuilder::ApplyLegDirection(TradeIntent& intent, bool receive_funding) const
@@ -158,4 +154,20 @@ void BasisArbitrageIntentBuilder::ApplyLegDirection(TradeIntent& intent, bool re
         receive_funding);
 }
 
+bool BasisArbitrageIntentBuilder::save_state(std::string& out) const
+{
+    out.clear();
+    QTrading::Utils::Serialization::StateWriter writer(out);
+    writer(current_receive_funding_, last_direction_switch_ts_);
+    return true;
+}
+
+bool BasisArbitrageIntentBuilder::restore_state(std::string_view in)
+{
+    QTrading::Utils::Serialization::StateReader reader(in);
+    reader(current_receive_funding_, last_direction_switch_ts_);
+    reader.finish();
+    return true;
+}
+
 } // namespace QTrading::Intent
@@ -13,6 +13,11 @@ namespace QTrading::Log {
     /// @param builder The RecordBatchBuilder used to append columns.
     using Serializer = std::function<void(const void* src, arrow::RecordBatchBuilder& builder)>;
 
+    /// @brief Function signature for serializing a span of record-module rows column by column.
+    /// @param span    Records to append; the timestamp column is appended by the caller.
+    /// @param builder The RecordBatchBuilder used to append columns.
+    using RecordBatchSerializer = std::function<void(const LogRecordSpan& span, arrow::RecordBatchBuilder& builder)>;
+
     /// @class FeatherV2
     /// @brief A singleton logger that writes log records to Arrow IPC (Feather V2) files.
     class FeatherV2 : public Logger {
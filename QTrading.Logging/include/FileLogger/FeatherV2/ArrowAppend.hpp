@@ -1,7 +1,15 @@
 #pragma once
 
 #include <arrow/api.h>
+#include <arrow/util/key_value_metadata.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
 
 namespace QTrading::Log::FileLogger::FeatherV2::detail {
 
@@ -14,4 +22,48 @@ namespace QTrading::Log::FileLogger::FeatherV2::detail {
         }
     }
 
+    inline void ThrowIfNotOk(const arrow::Status& st)
+    {
+        if (!st.ok()) {
+            throw std::runtime_error(st.ToString());
+        }
+    }
+
+    /// @brief Appends `count` values, `value(i)` for each row, as a run of non-null values.
+    /// @details Values are gathered into a small contiguous block and bulk-appended, so validity
+    ///          bits are set a block at a time instead of once per value.
+    template <typename Builder, typename Value>
+    inline void AppendColumn(Builder* builder, size_t count, Value&& value)
+    {
+        using Stored = std::conditional_t<std::is_same_v<Builder, arrow::BooleanBuilder>,
+            uint8_t, typename Builder::value_type>;
+        constexpr size_t kBlock = 256;
+        std::array<Stored, kBlock> block;
+        ThrowIfNotOk(builder->Reserve(static_cast<int64_t>(count)));
+        for (size_t first = 0; first < count; first += kBlock) {
+            const size_t n = std::min(kBlock, count - first);
+            for (size_t i = 0; i < n; ++i) {
+                block[i] = static_cast<Stored>(value(first + i));
+            }
+            ThrowIfNotOk(builder->AppendValues(block.data(), static_cast<int64_t>(n)));
+        }
+    }
+
+    /// @brief Copies `schema` with `schema_version` and `module` keys added to its metadata,
+    ///        keeping any values the schema already carries.
+    inline std::shared_ptr<arrow::Schema> WithSchemaMetadata(const std::shared_ptr<arrow::Schema>& schema,
+        const std::string& module)
+    {
+        std::shared_ptr<arrow::KeyValueMetadata> meta =
+            schema->metadata() ? schema->metadata()->Copy()
+                               : std::make_shared<arrow::KeyValueMetadata>();
+        if (meta->FindKey("schema_version") < 0) {
+            meta->Append("schema_version", "1");
+        }
+        if (meta->FindKey("module") < 0) {
+            meta->Append("module", module);
+        }
+        return schema->WithMetadata(meta);
+    }
+
 } // namespace QTrading::Log::FileLogger::FeatherV2::detail
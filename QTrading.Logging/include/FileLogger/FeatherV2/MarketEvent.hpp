@@ -3,8 +3,12 @@
 #include <arrow/api.h>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "Dto/Trading/SymbolId.hpp"
 #include "FileLogger/FeatherV2/ArrowAppend.hpp"
+#include "LogRecordRing.hpp"
 
 namespace QTrading::Log::FileLogger::FeatherV2 {
 
@@ -31,6 +35,30 @@ namespace QTrading::Log::FileLogger::FeatherV2 {
         int32_t index_price_source{}; // 0=None, 1=Raw, 2=Interpolated
     };
 
+    /// @brief Fixed-layout `MarketEventDto` for record modules; the symbol is an interned id.
+    struct MarketEventRecord {
+        uint64_t run_id{};
+        uint64_t step_seq{};
+        uint64_t event_seq{};
+        uint64_t ts_local{};
+
+        QTrading::Dto::Trading::SymbolId symbol_id{ QTrading::Dto::Trading::kInvalidSymbolId };
+        bool has_kline{};
+        bool has_mark_price{};
+        bool has_index_price{};
+
+        double open{};
+        double high{};
+        double low{};
+        double close{};
+        double volume{};
+        double taker_buy_base_volume{};
+        double mark_price{};
+        double index_price{};
+        int32_t mark_price_source{}; // 0=None, 1=Raw, 2=Interpolated
+        int32_t index_price_source{}; // 0=None, 1=Raw, 2=Interpolated
+    };
+
     namespace MarketEvent {
         inline std::shared_ptr<arrow::Schema> Schema()
         {
@@ -80,6 +108,81 @@ namespace QTrading::Log::FileLogger::FeatherV2 {
             detail::AppendOrThrow(builder.GetFieldAs<arrow::Int32Builder>(17), e.index_price_source);
             detail::AppendOrThrow(builder.GetFieldAs<arrow::UInt64Builder>(18), e.ts_local);
         }
+
+        /// @brief Serializer for modules registered with `MarketEventRecord`; same columns as `Serializer`.
+        inline void RecordSerializer(const void* src, arrow::RecordBatchBuilder& builder)
+        {
+            const auto& e = *static_cast<const MarketEventRecord*>(src);
+
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::UInt64Builder>(1), e.run_id);
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::UInt64Builder>(2), e.step_seq);
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::UInt64Builder>(3), e.event_seq);
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::StringBuilder>(4),
+                QTrading::Dto::Trading::SymbolTable::Name(e.symbol_id));
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::BooleanBuilder>(5), e.has_kline);
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::DoubleBuilder>(6), e.open);
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::DoubleBuilder>(7), e.high);
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::DoubleBuilder>(8), e.low);
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::DoubleBuilder>(9), e.close);
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::DoubleBuilder>(10), e.volume);
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::DoubleBuilder>(11), e.taker_buy_base_volume);
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::BooleanBuilder>(12), e.has_mark_price);
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::DoubleBuilder>(13), e.mark_price);
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::Int32Builder>(14), e.mark_price_source);
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::BooleanBuilder>(15), e.has_index_price);
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::DoubleBuilder>(16), e.index_price);
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::Int32Builder>(17), e.index_price_source);
+            detail::AppendOrThrow(builder.GetFieldAs<arrow::UInt64Builder>(18), e.ts_local);
+        }
+
+        /// @brief Columnar `RecordSerializer`: appends a whole span of `MarketEventRecord` per column.
+        inline void RecordBatchSerializer(const LogRecordSpan& span, arrow::RecordBatchBuilder& builder)
+        {
+            using QTrading::Dto::Trading::SymbolTable;
+            const size_t n = span.count;
+            const auto at = [&span](size_t i) -> const MarketEventRecord& {
+                return *static_cast<const MarketEventRecord*>(span.record(i));
+            };
+
+            detail::AppendColumn(builder.GetFieldAs<arrow::UInt64Builder>(1), n, [&](size_t i) { return at(i).run_id; });
+            detail::AppendColumn(builder.GetFieldAs<arrow::UInt64Builder>(2), n, [&](size_t i) { return at(i).step_seq; });
+            detail::AppendColumn(builder.GetFieldAs<arrow::UInt64Builder>(3), n, [&](size_t i) { return at(i).event_seq; });
+
+            // Resolve each distinct symbol once per span; interned names never move.
+            std::vector<const std::string*> names(SymbolTable::Size(), nullptr);
+            int64_t name_bytes = 0;
+            for (size_t i = 0; i < n; ++i) {
+                const auto id = at(i).symbol_id;
+                if (id >= names.size()) {
+                    names.resize(static_cast<size_t>(id) + 1, nullptr);
+                }
+                if (!names[id]) {
+                    names[id] = &SymbolTable::Name(id);
+                }
+                name_bytes += static_cast<int64_t>(names[id]->size());
+            }
+            auto* symbol = builder.GetFieldAs<arrow::StringBuilder>(4);
+            detail::ThrowIfNotOk(symbol->ReserveData(name_bytes));
+            detail::ThrowIfNotOk(symbol->Reserve(static_cast<int64_t>(n)));
+            for (size_t i = 0; i < n; ++i) {
+                symbol->UnsafeAppend(*names[at(i).symbol_id]);
+            }
+
+            detail::AppendColumn(builder.GetFieldAs<arrow::BooleanBuilder>(5), n, [&](size_t i) { return at(i).has_kline; });
+            detail::AppendColumn(builder.GetFieldAs<arrow::DoubleBuilder>(6), n, [&](size_t i) { return at(i).open; });
+            detail::AppendColumn(builder.GetFieldAs<arrow::DoubleBuilder>(7), n, [&](size_t i) { return at(i).high; });
+            detail::AppendColumn(builder.GetFieldAs<arrow::DoubleBuilder>(8), n, [&](size_t i) { return at(i).low; });
+            detail::AppendColumn(builder.GetFieldAs<arrow::DoubleBuilder>(9), n, [&](size_t i) { return at(i).close; });
+            detail::AppendColumn(builder.GetFieldAs<arrow::DoubleBuilder>(10), n, [&](size_t i) { return at(i).volume; });
+            detail::AppendColumn(builder.GetFieldAs<arrow::DoubleBuilder>(11), n, [&](size_t i) { return at(i).taker_buy_base_volume; });
+            detail::AppendColumn(builder.GetFieldAs<arrow::BooleanBuilder>(12), n, [&](size_t i) { return at(i).has_mark_price; });
+            detail::AppendColumn(builder.GetFieldAs<arrow::DoubleBuilder>(13), n, [&](size_t i) { return at(i).mark_price; });
+            detail::AppendColumn(builder.GetFieldAs<arrow::Int32Builder>(14), n, [&](size_t i) { return at(i).mark_price_source; });
+            detail::AppendColumn(builder.GetFieldAs<arrow::BooleanBuilder>(15), n, [&](size_t i) { return at(i).has_index_price; });
+            detail::AppendColumn(builder.GetFieldAs<arrow::DoubleBuilder>(16), n, [&](size_t i) { return at(i).index_price; });
+            detail::AppendColumn(builder.GetFieldAs<arrow::Int32Builder>(17), n, [&](size_t i) { return at(i).index_price_source; });
+            detail::AppendColumn(builder.GetFieldAs<arrow::UInt64Builder>(18), n, [&](size_t i) { return at(i).ts_local; });
+        }
     } // namespace MarketEvent
 
 } // namespace QTrading::Log::FileLogger::FeatherV2
@@ -1,24 +1,47 @@
 #pragma once
 
+#include <arrow/util/compression.h>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "LogSink.hpp"
 
 namespace QTrading::Log::FileLogger {
 
+    /// @brief How one module's `.arrow` file is written.
+    struct FeatherV2WriteOptions {
+        /// Record batch body codec: UNCOMPRESSED, LZ4_FRAME or ZSTD (the codecs Arrow IPC supports).
+        arrow::Compression::type codec{ arrow::Compression::UNCOMPRESSED };
+        /// Codec level; the codec's default when left at kUseDefaultCompressionLevel.
+        int compression_level{ arrow::util::kUseDefaultCompressionLevel };
+        /// Rows per record batch; larger batches compress better.
+        uint32_t batch_rows{ 8192 };
+    };
+
     class FeatherV2Sink final : public ILogSink {
     public:
-        explicit FeatherV2Sink(const std::string& dir);
+        /// @param dir            Output directory, one `<module>.arrow` file per module.
+        /// @param defaults       Write options of modules without an entry in `module_options`.
+        /// @param module_options Write options by module name.
+        explicit FeatherV2Sink(const std::string& dir,
+            FeatherV2WriteOptions defaults = {},
+            std::unordered_map<std::string, FeatherV2WriteOptions> module_options = {});
 
         void RegisterModule(Logger::ModuleId module_id,
             const std::string& module,
             const std::shared_ptr<arrow::Schema>& schema,
             const Serializer& serializer) override;
 
+        void RegisterRecordBatchSerializer(Logger::ModuleId module_id,
+            const RecordBatchSerializer& serializer) override;
+
         uint64_t WriteRow(const Row& row) override;
 
+        uint64_t WriteRecords(const LogRecordSpan& span) override;
+
         uint64_t Flush() override;
 
         void Close() override;
@@ -27,13 +50,17 @@ namespace QTrading::Log::FileLogger {
         struct Slot {
             std::shared_ptr<arrow::Schema>                 schema;
             Serializer                                     serializer;
+            RecordBatchSerializer                          batch_serializer;
             std::unique_ptr<arrow::RecordBatchBuilder>     builder;
             std::shared_ptr<arrow::ipc::RecordBatchWriter> writer;
             std::shared_ptr<arrow::io::OutputStream>       outfile;
             uint32_t                                       rows = 0;
+            uint32_t                                       batch_rows = 8192;
         };
 
         std::string dir_;
+        FeatherV2WriteOptions defaults_;
+        std::unordered_map<std::string, FeatherV2WriteOptions> module_options_;
         std::vector<Slot> slots_;
     };
 
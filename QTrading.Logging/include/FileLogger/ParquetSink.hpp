@@ -0,0 +1,76 @@
+#pragma once
+
+#include <arrow/util/compression.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "LogSink.hpp"
+
+namespace parquet::arrow {
+    class FileWriter;
+}
+
+namespace QTrading::Log::FileLogger {
+
+    /// @brief How a ParquetSink lays out its files.
+    struct ParquetSinkOptions {
+        /// Rows per row group; the unit readers skip with statistics.
+        int64_t row_group_rows{ 1 << 17 };
+        /// Rows buffered per module before they are handed to the Parquet writer.
+        uint32_t batch_rows{ 8192 };
+        /// Page codec; any codec the Parquet build supports.
+        arrow::Compression::type codec{ arrow::Compression::ZSTD };
+        /// Codec level; the codec's default when left at kUseDefaultCompressionLevel.
+        int compression_level{ arrow::util::kUseDefaultCompressionLevel };
+        /// Columns written dictionary-encoded when a module has them.
+        std::vector<std::string> dictionary_columns{ "symbol" };
+        /// Columns with per-row-group min/max statistics when a module has them.
+        std::vector<std::string> statistics_columns{ "ts", "step_seq" };
+    };
+
+    /// @brief Writes each module to `<module>.parquet` for analytics readers.
+    /// @details Same schemas and serializers as FeatherV2Sink. Row groups carry min/max
+    ///          statistics on the configured columns, so readers can skip row groups
+    ///          by time range or step without scanning the whole file.
+    class ParquetSink final : public ILogSink {
+    public:
+        explicit ParquetSink(const std::string& dir, ParquetSinkOptions options = {});
+        ~ParquetSink() override;
+
+        void RegisterModule(Logger::ModuleId module_id,
+            const std::string& module,
+            const std::shared_ptr<arrow::Schema>& schema,
+            const Serializer& serializer) override;
+
+        void RegisterRecordBatchSerializer(Logger::ModuleId module_id,
+            const RecordBatchSerializer& serializer) override;
+
+        uint64_t WriteRow(const Row& row) override;
+
+        uint64_t WriteRecords(const LogRecordSpan& span) override;
+
+        uint64_t Flush() override;
+
+        void Close() override;
+
+    private:
+        struct Slot {
+            std::shared_ptr<arrow::Schema>             schema;
+            Serializer                                 serializer;
+            RecordBatchSerializer                      batch_serializer;
+            std::unique_ptr<arrow::RecordBatchBuilder> builder;
+            std::unique_ptr<parquet::arrow::FileWriter> writer;
+            uint32_t                                   rows = 0;
+        };
+
+        /// @brief Hands the slot's buffered rows to its writer; returns 1 if any were written.
+        uint64_t WriteBatch(Slot& s);
+
+        std::string dir_;
+        ParquetSinkOptions options_;
+        std::vector<Slot> slots_;
+    };
+
+} // namespace QTrading::Log::FileLogger
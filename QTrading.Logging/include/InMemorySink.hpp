@@ -1,11 +1,30 @@
 #pragma once
 
+#include <cstddef>
+#include <cstring>
+#include <mutex>
 #include <vector>
 
 #include "LogSink.hpp"
 
 namespace QTrading::Log {
 
+    /// @brief Copy of one record drained from a record module's ring.
+    struct RecordRow {
+        Logger::ModuleId       module_id{ Logger::kInvalidModuleId };
+        uint64_t               ts{ 0 };
+        std::vector<std::byte> bytes;
+
+        /// @brief The record as the type its module was registered with.
+        template <typename T>
+        T As() const
+        {
+            T out;
+            std::memcpy(&out, bytes.data(), sizeof(T));
+            return out;
+        }
+    };
+
     class InMemorySink final : public ILogSink {
     public:
         void RegisterModule(Logger::ModuleId,
@@ -15,18 +34,33 @@ namespace QTrading::Log {
 
         uint64_t WriteRow(const Row& row) override
         {
+            std::lock_guard<std::mutex> lk(mtx_);
             rows_.push_back(row);
             return 0;
         }
 
+        uint64_t WriteRecords(const LogRecordSpan& span) override
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            for (size_t i = 0; i < span.count; ++i) {
+                const auto* first = static_cast<const std::byte*>(span.record(i));
+                records_.push_back(RecordRow{
+                    span.module_id, span.ts(i), std::vector<std::byte>(first, first + span.stride - sizeof(uint64_t)) });
+            }
+            return 0;
+        }
+
         uint64_t Flush() override { return 0; }
 
         void Close() override {}
 
         const std::vector<Row>& rows() const { return rows_; }
+        const std::vector<RecordRow>& records() const { return records_; }
 
     private:
+        std::mutex mtx_; ///< Writer threads of a sharded SinkLogger append concurrently.
         std::vector<Row> rows_;
+        std::vector<RecordRow> records_;
     };
 
 } // namespace QTrading::Log
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+namespace QTrading::Log {
+
+    /// @brief Contiguous run of records drained from one `LogRecordRing`.
+    /// @details Each slot holds the row timestamp followed by the record bytes.
+    struct LogRecordSpan {
+        uint32_t         module_id{ 0 }; ///< Module the records were logged to.
+        const std::byte* first{ nullptr }; ///< First slot.
+        size_t           count{ 0 };     ///< Number of records.
+        size_t           stride{ 0 };    ///< Bytes between consecutive slots.
+
+        /// @brief Timestamp of record `i`.
+        uint64_t ts(size_t i) const noexcept
+        {
+            uint64_t out;
+            std::memcpy(&out, first + i * stride, sizeof(out));
+            return out;
+        }
+
+        /// @brief Record `i`, laid out as the type the module was registered with.
+        const void* record(size_t i) const noexcept
+        {
+            return first + i * stride + sizeof(uint64_t);
+        }
+    };
+
+    /// @brief Preallocated ring of fixed-layout log records for one module.
+    /// @details Producers build records in place in a claimed slot, so logging a record neither
+    ///          allocates nor boxes it. Producers serialize on a spin flag; the single consumer
+    ///          drains published slots in place, in at most two contiguous spans per call.
+    class LogRecordRing {
+    public:
+        /// @param record_size Size of the record type; at most 8-byte aligned.
+        /// @param capacity    Number of slots, rounded up to a power of two.
+        LogRecordRing(size_t record_size, size_t capacity)
+            : record_size_(record_size),
+              stride_(sizeof(uint64_t) + ((record_size + alignof(uint64_t) - 1) & ~(alignof(uint64_t) - 1)))
+        {
+            size_t slots = 2;
+            while (slots < capacity) {
+                slots <<= 1;
+            }
+            mask_ = slots - 1;
+            slots_ = std::make_unique<Slot[]>(slots * (stride_ / sizeof(Slot)));
+        }
+
+        size_t record_size() const noexcept { return record_size_; }
+        size_t capacity() const noexcept { return mask_ + 1; }
+
+        /// @brief Number of published records not yet drained.
+        size_t Size() const noexcept
+        {
+            return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+        }
+
+        /// @brief Producer side. Builds a record of type `T` in the next free slot.
+        /// @param ts   Row timestamp.
+        /// @param fill Called with the slot's record, value-initialized, to fill it in place.
+        /// @param wait Called while the ring is full; returning false gives up.
+        /// @return False when `wait` gave up on a full ring.
+        template <typename T, typename Fill, typename Wait>
+        bool TryWrite(uint64_t ts, Fill&& fill, Wait&& wait) noexcept
+        {
+            static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                "log records must be plain fixed-layout structs");
+            static_assert(alignof(T) <= alignof(uint64_t), "log records must be at most 8-byte aligned");
+            while (producer_busy_.test_and_set(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            const size_t pos = tail_.load(std::memory_order_relaxed);
+            while (pos - head_.load(std::memory_order_acquire) > mask_) {
+                if (!wait()) {
+                    producer_busy_.clear(std::memory_order_release);
+                    return false;
+                }
+            }
+            std::byte* slot = SlotAt(pos);
+            std::memcpy(slot, &ts, sizeof(ts));
+            T* record = ::new (slot + sizeof(uint64_t)) T{};
+            fill(*record);
+            tail_.store(pos + 1, std::memory_order_release);
+            producer_busy_.clear(std::memory_order_release);
+            return true;
+        }
+
+        /// @brief Consumer side. Passes every published record to `sink` and frees the slots.
+        /// @param module_id Module id stamped on the spans.
+        /// @param sink      Called with each contiguous `LogRecordSpan`.
+        /// @return Number of records drained.
+        template <typename Sink>
+        size_t Drain(uint32_t module_id, Sink&& sink)
+        {
+            const size_t head = head_.load(std::memory_order_relaxed);
+            const size_t tail = tail_.load(std::memory_order_acquire);
+            size_t pos = head;
+            while (pos != tail) {
+                const size_t offset = pos & mask_;
+                const size_t run = std::min(tail - pos, capacity() - offset);
+                sink(LogRecordSpan{ module_id, SlotAt(pos), run, stride_ });
+                pos += run;
+            }
+            head_.store(tail, std::memory_order_release);
+            return tail - head;
+        }
+
+    private:
+        struct alignas(uint64_t) Slot {
+            std::byte bytes[sizeof(uint64_t)];
+        };
+
+        std::byte* SlotAt(size_t pos) noexcept
+        {
+            return reinterpret_cast<std::byte*>(slots_.get()) + (pos & mask_) * stride_;
+        }
+
+        size_t record_size_;
+        size_t stride_;
+        size_t mask_{ 0 };
+        std::unique_ptr<Slot[]> slots_;
+        std::atomic_flag producer_busy_ = ATOMIC_FLAG_INIT;
+        alignas(64) std::atomic<size_t> tail_{ 0 };
+        alignas(64) std::atomic<size_t> head_{ 0 };
+    };
+
+} // namespace QTrading::Log
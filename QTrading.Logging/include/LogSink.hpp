@@ -8,6 +8,12 @@
 
 namespace QTrading::Log {
 
+    /// @brief Destination of the rows a SinkLogger drains.
+    /// @details Registration completes before the logger starts. A logger with several writer
+    ///          threads calls WriteRow/WriteRecords concurrently, but only for distinct modules:
+    ///          each module belongs to one writer, so calls for one module never overlap and keep
+    ///          enqueue order. Flush and Close run once, after every writer has finished. State
+    ///          kept per module needs no locking; state shared across modules does.
     class ILogSink {
     public:
         virtual ~ILogSink() = default;
@@ -17,9 +23,20 @@ namespace QTrading::Log {
             const std::shared_ptr<arrow::Schema>& schema,
             const Serializer& serializer) = 0;
 
+        // Optional columnar serializer for a record module, registered after RegisterModule. Sinks
+        // that ignore it keep calling the per-record serializer from WriteRecords.
+        virtual void RegisterRecordBatchSerializer(Logger::ModuleId /*module_id*/,
+            const RecordBatchSerializer& /*serializer*/)
+        {
+        }
+
         // Returns number of flushes performed as a result of this row.
         virtual uint64_t WriteRow(const Row& row) = 0;
 
+        // Writes records drained from a record module's ring; the serializer registered for the
+        // module receives `span.record(i)`. Returns number of flushes performed.
+        virtual uint64_t WriteRecords(const LogRecordSpan& span) = 0;
+
         // Flush any buffered rows and return number of flushes performed.
         virtual uint64_t Flush() = 0;
 
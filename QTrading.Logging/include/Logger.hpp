@@ -6,11 +6,12 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #include <boost/thread.hpp>
-#include "Global.hpp"
 #include "LogPayload.hpp"
+#include "LogRecordRing.hpp"
 #include "Queue/ChannelFactory.hpp"
 
 namespace QTrading::Log {
@@ -19,7 +20,7 @@ namespace QTrading::Log {
     struct Row {
         using ModuleId = uint32_t;
         ModuleId              module_id; ///< Numeric module identifier.
-        unsigned long long    ts;        ///< Timestamp from GlobalTimestamp.
+        unsigned long long    ts;        ///< Logger timestamp at enqueue, or the explicit one.
         PayloadPtr            payload;   ///< Pointer to the log data object.
     };
 
@@ -51,13 +52,13 @@ namespace QTrading::Log {
         virtual void Start();
 
         /// @brief Start the consumer thread with a bounded channel.
-        /// @param capacity Maximum number of queued log rows.
+        /// @param capacity Maximum number of queued log rows, per consumer shard.
         /// @param policy Overflow policy when the queue is full.
         virtual void Start(size_t capacity,
             QTrading::Utils::Queue::OverflowPolicy policy);
 
         /// @brief Start the consumer thread with an unbounded critical channel and a bounded debug channel.
-        /// @param debug_capacity Maximum number of queued debug rows.
+        /// @param debug_capacity Maximum number of queued debug rows, per consumer shard.
         /// @param policy Overflow policy when the debug queue is full.
         virtual void StartWithDebugChannel(size_t debug_capacity,
             QTrading::Utils::Queue::OverflowPolicy policy);
@@ -73,6 +74,15 @@ namespace QTrading::Log {
         /// @brief Get a snapshot of logger metrics.
         MetricsSnapshot GetMetrics() const;
 
+        /// @brief Set the timestamp stamped on rows logged without an explicit one.
+        /// @details One clock per logger, and so per run: the exchange advances it every step,
+        ///          and rows logged from any thread through this logger carry the run's simulated
+        ///          time. Concurrent runs use separate loggers and never see each other's clock.
+        void SetTimestamp(uint64_t ts) noexcept { timestamp_.store(ts, std::memory_order_relaxed); }
+
+        /// @brief Timestamp stamped on rows logged without an explicit one.
+        uint64_t CurrentTimestamp() const noexcept { return timestamp_.load(std::memory_order_relaxed); }
+
         /// @brief Send a log entry (non-blocking) by module id.
         /// @tparam T   Payload type.
         /// @param module_id Module id from RegisterModule.
@@ -81,23 +91,16 @@ namespace QTrading::Log {
         inline bool Log(ModuleId module_id,
             PayloadPtr payload) noexcept
         {
-            if (module_id == kInvalidModuleId) {
+            if (module_id == kInvalidModuleId || IsRecordModule(module_id)) {
                 enqueue_fail_.fetch_add(1, std::memory_order_relaxed);
                 return false;
             }
-            ChannelKind kind = ChannelKind::Critical;
-            if (module_id <= module_kinds_.size()) {
-                kind = module_kinds_[module_id - 1];
-            }
             Row r{
                 module_id,
-                QTrading::Utils::GlobalTimestamp.load(std::memory_order_relaxed),
+                timestamp_.load(std::memory_order_relaxed),
                 std::move(payload)
             };
-            auto target = channel;
-            if (kind == ChannelKind::Debug && debug_channel_) {
-                target = debug_channel_;
-            }
+            auto target = ChannelFor(module_id);
             if (!target) {
                 enqueue_fail_.fetch_add(1, std::memory_order_relaxed);
                 return false;
@@ -105,7 +108,7 @@ namespace QTrading::Log {
             const bool ok = target->TrySend(std::move(r));
             if (ok) {
                 enqueue_ok_.fetch_add(1, std::memory_order_relaxed);
-                consume_cv_.notify_one();
+                NotifyConsumer(module_id);
             }
             else {
                 enqueue_fail_.fetch_add(1, std::memory_order_relaxed);
@@ -165,18 +168,11 @@ namespace QTrading::Log {
             if (count == 0) {
                 return 0;
             }
-            if (module_id == kInvalidModuleId) {
+            if (module_id == kInvalidModuleId || IsRecordModule(module_id)) {
                 enqueue_fail_.fetch_add(count, std::memory_order_relaxed);
                 return 0;
             }
-            ChannelKind kind = ChannelKind::Critical;
-            if (module_id <= module_kinds_.size()) {
-                kind = module_kinds_[module_id - 1];
-            }
-            auto target = channel;
-            if (kind == ChannelKind::Debug && debug_channel_) {
-                target = debug_channel_;
-            }
+            auto target = ChannelFor(module_id);
             if (!target) {
                 enqueue_fail_.fetch_add(count, std::memory_order_relaxed);
                 return 0;
@@ -187,7 +183,7 @@ namespace QTrading::Log {
             for (size_t i = 0; i < count; ++i) {
                 Row r{
                     module_id,
-                    QTrading::Utils::GlobalTimestamp.load(std::memory_order_relaxed),
+                    timestamp_.load(std::memory_order_relaxed),
                     std::move(payloads[i])
                 };
                 if (target->TrySend(std::move(r))) {
@@ -199,7 +195,7 @@ namespace QTrading::Log {
             }
             if (ok_count > 0) {
                 enqueue_ok_.fetch_add(ok_count, std::memory_order_relaxed);
-                consume_cv_.notify_one();
+                NotifyConsumer(module_id);
             }
             if (fail_count > 0) {
                 enqueue_fail_.fetch_add(fail_count, std::memory_order_relaxed);
@@ -221,18 +217,11 @@ namespace QTrading::Log {
             if (count == 0) {
                 return 0;
             }
-            if (module_id == kInvalidModuleId) {
+            if (module_id == kInvalidModuleId || IsRecordModule(module_id)) {
                 enqueue_fail_.fetch_add(count, std::memory_order_relaxed);
                 return 0;
             }
-            ChannelKind kind = ChannelKind::Critical;
-            if (module_id <= module_kinds_.size()) {
-                kind = module_kinds_[module_id - 1];
-            }
-            auto target = channel;
-            if (kind == ChannelKind::Debug && debug_channel_) {
-                target = debug_channel_;
-            }
+            auto target = ChannelFor(module_id);
             if (!target) {
                 enqueue_fail_.fetch_add(count, std::memory_order_relaxed);
                 return 0;
@@ -255,7 +244,7 @@ namespace QTrading::Log {
             }
             if (ok_count > 0) {
                 enqueue_ok_.fetch_add(ok_count, std::memory_order_relaxed);
-                consume_cv_.notify_one();
+                NotifyConsumer(module_id);
             }
             if (fail_count > 0) {
                 enqueue_fail_.fetch_add(fail_count, std::memory_order_relaxed);
@@ -279,18 +268,11 @@ namespace QTrading::Log {
             if (count == 0) {
                 return 0;
             }
-            if (module_id == kInvalidModuleId) {
+            if (module_id == kInvalidModuleId || IsRecordModule(module_id)) {
                 enqueue_fail_.fetch_add(count, std::memory_order_relaxed);
                 return 0;
             }
-            ChannelKind kind = ChannelKind::Critical;
-            if (module_id <= module_kinds_.size()) {
-                kind = module_kinds_[module_id - 1];
-            }
-            auto target = channel;
-            if (kind == ChannelKind::Debug && debug_channel_) {
-                target = debug_channel_;
-            }
+            auto target = ChannelFor(module_id);
             if (!target) {
                 enqueue_fail_.fetch_add(count, std::memory_order_relaxed);
                 return 0;
@@ -301,7 +283,7 @@ namespace QTrading::Log {
             for (size_t i = 0; i < count; ++i) {
                 Row r{
                     module_id,
-                    QTrading::Utils::GlobalTimestamp.load(std::memory_order_relaxed),
+                    timestamp_.load(std::memory_order_relaxed),
                     MakePayload<std::decay_t<T>>(objs[i])
                 };
                 if (target->TrySend(std::move(r))) {
@@ -313,7 +295,7 @@ namespace QTrading::Log {
             }
             if (ok_count > 0) {
                 enqueue_ok_.fetch_add(ok_count, std::memory_order_relaxed);
-                consume_cv_.notify_one();
+                NotifyConsumer(module_id);
             }
             if (fail_count > 0) {
                 enqueue_fail_.fetch_add(fail_count, std::memory_order_relaxed);
@@ -321,6 +303,62 @@ namespace QTrading::Log {
             return ok_count;
         }
 
+        /// @brief True when `module_id` was registered as a record module; it takes only LogRecord rows.
+        bool IsRecordModule(ModuleId module_id) const noexcept
+        {
+            return module_id <= record_types_.size() && record_types_[module_id - 1] != nullptr;
+        }
+
+        /// @brief True when `module_id` was registered as a record module of type `T`.
+        template <typename T>
+        bool AcceptsRecords(ModuleId module_id) const noexcept
+        {
+            return module_id != kInvalidModuleId &&
+                module_id <= record_types_.size() &&
+                record_types_[module_id - 1] == RecordTypeOf<T>();
+        }
+
+        /// @brief Build a record in place in the module's ring (no allocation, no boxing).
+        /// @details Waits for the consumer while the ring is full.
+        /// @tparam T Record type the module was registered with.
+        /// @param module_id Module id from RegisterRecordModule.
+        /// @param ts   Row timestamp.
+        /// @param fill Called with a value-initialized record to fill in.
+        /// @return true if published, false if the module takes no `T` records or the logger is stopped.
+        template <typename T, typename Fill>
+        bool LogRecord(ModuleId module_id, uint64_t ts, Fill&& fill) noexcept
+        {
+            if (!AcceptsRecords<T>(module_id) || !records_open_.load(std::memory_order_acquire)) {
+                enqueue_fail_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            const bool ok = record_rings_[module_id - 1]->TryWrite<T>(ts, std::forward<Fill>(fill), [this, module_id]() {
+                if (!records_open_.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                NotifyConsumer(module_id);
+                std::this_thread::yield();
+                return true;
+            });
+            if (ok) {
+                enqueue_ok_.fetch_add(1, std::memory_order_relaxed);
+                NotifyConsumer(module_id);
+            }
+            else {
+                enqueue_fail_.fetch_add(1, std::memory_order_relaxed);
+            }
+            return ok;
+        }
+
+        /// @brief Build a record in place, stamped with CurrentTimestamp().
+        template <typename T, typename Fill>
+        bool LogRecord(ModuleId module_id, Fill&& fill) noexcept
+        {
+            return LogRecord<T>(module_id,
+                timestamp_.load(std::memory_order_relaxed),
+                std::forward<Fill>(fill));
+        }
+
         /// @brief Send multiple log entries (non-blocking), moving payloads from the array.
         /// @param module Module name.
         /// @param payloads Pointer to payload array (moved from).
@@ -352,6 +390,11 @@ namespace QTrading::Log {
         }
 
     protected:
+        template <typename T>
+        struct RecordTypeTag {
+            static constexpr char id = 0;
+        };
+
         /// @brief Register a module name and return its id.
         /// @param module Module name.
         /// @return Module id (stable for the module name).
@@ -363,6 +406,63 @@ namespace QTrading::Log {
         /// @return Module id (stable for the module name).
         ModuleId RegisterModuleId(const std::string& module, ChannelKind kind);
 
+        /// @brief Register a module whose rows are fixed-layout records kept in a preallocated ring.
+        /// @param module Module name.
+        /// @param record_size Size of the record type.
+        /// @param record_type Tag from RecordTypeOf for the record type.
+        /// @param capacity Ring slots.
+        /// @return Module id (stable for the module name).
+        ModuleId RegisterRecordModuleId(const std::string& module,
+            size_t record_size,
+            const void* record_type,
+            size_t capacity);
+
+        /// @brief Identity of a record type, compared by AcceptsRecords.
+        template <typename T>
+        static const void* RecordTypeOf() noexcept
+        {
+            return &RecordTypeTag<T>::id;
+        }
+
+        /// @brief True when a record ring of a module owned by `shard` holds undrained records.
+        bool HasPendingRecords(size_t shard) const noexcept;
+
+        /// @brief Drain the record rings of the modules owned by `shard`, passing each contiguous
+        ///        LogRecordSpan to `sink`.
+        /// @return Number of records drained.
+        template <typename Sink>
+        size_t DrainRecords(size_t shard, Sink&& sink)
+        {
+            size_t drained = 0;
+            for (size_t i = 0; i < record_rings_.size(); ++i) {
+                if (record_rings_[i] && ShardOf(static_cast<ModuleId>(i + 1)) == shard) {
+                    drained += record_rings_[i]->Drain(static_cast<uint32_t>(i + 1), sink);
+                }
+            }
+            return drained;
+        }
+
+        /// @brief Set the number of consumer threads; modules are spread over them round-robin
+        ///        by module id, each module owned by exactly one. Must be called before Start().
+        /// @details With more than one shard every thread runs ConsumeShard(shard) concurrently,
+        ///          so the subclass must keep per-module output state apart.
+        void SetConsumerShards(size_t shards);
+
+        /// @brief Number of consumer threads started by Start().
+        size_t ConsumerShards() const noexcept { return consumer_shards_; }
+
+        /// @brief Consumer shard owning `module_id`.
+        size_t ShardOf(ModuleId module_id) const noexcept
+        {
+            return module_id != kInvalidModuleId && module_id <= module_shards_.size()
+                ? module_shards_[module_id - 1]
+                : 0;
+        }
+
+        /// @brief Marks the calling shard's consume loop as finished.
+        /// @return True for the last shard to finish, which then owns any shared teardown.
+        bool FinishConsumerShard() noexcept;
+
         /// @brief Increment the flush counter.
         void IncrementFlushCount(uint64_t count = 1);
 
@@ -372,22 +472,77 @@ namespace QTrading::Log {
         /// @return false if all channels are closed and drained.
         bool WaitForBatch(std::vector<Row>& out, size_t max_items);
 
+        /// @brief Wait for data of the modules owned by `shard` and receive up to max_items.
+        /// @param shard Consumer shard.
+        /// @param[out] out Batch of rows.
+        /// @param max_items Maximum items to receive.
+        /// @return false if the shard's channels are closed and drained.
+        bool WaitForBatch(size_t shard, std::vector<Row>& out, size_t max_items);
+
         std::string dir;  ///< Output directory for log files.
 
         /// @brief Called by the background thread to consume Rows.
         virtual void Consume() = 0;
 
-        std::shared_ptr<QTrading::Utils::Queue::Channel<Row>> channel;      ///< Critical channel.
-        std::shared_ptr<QTrading::Utils::Queue::Channel<Row>> debug_channel_; ///< Debug channel.
-        boost::thread                                         consumer;     ///< Consumer thread.
+        /// @brief Called by the background thread of `shard`; defaults to Consume() for unsharded loggers.
+        virtual void ConsumeShard(size_t shard);
+
+        std::shared_ptr<QTrading::Utils::Queue::Channel<Row>> channel;      ///< Critical channel of shard 0.
+        std::shared_ptr<QTrading::Utils::Queue::Channel<Row>> debug_channel_; ///< Debug channel of shard 0.
         std::mutex                                            mtx;          ///< Protects start/stop.
-        std::mutex                                            consume_mtx_; ///< Protects consume wait.
-        std::condition_variable                               consume_cv_;  ///< Signals consumer when data arrives.
 
         std::unordered_map<std::string, ModuleId> module_ids_; ///< Module name to id.
         std::vector<ChannelKind> module_kinds_;                ///< Module id to channel kind.
+        std::vector<std::unique_ptr<LogRecordRing>> record_rings_; ///< Module id to record ring; null for boxed modules.
+        std::vector<const void*> record_types_;                ///< Module id to record type tag; null for boxed modules.
+        std::atomic<bool> records_open_{ false };              ///< True while the consumer drains record rings.
         std::atomic<uint64_t> enqueue_ok_{ 0 };
         std::atomic<uint64_t> enqueue_fail_{ 0 };
         std::atomic<uint64_t> flush_count_{ 0 };
+        std::atomic<uint64_t> timestamp_{ 0 };                 ///< See SetTimestamp.
+
+    private:
+        /// @brief Channels and consumer thread of one consumer shard.
+        struct ConsumerShard {
+            std::shared_ptr<QTrading::Utils::Queue::Channel<Row>> channel;       ///< Critical channel.
+            std::shared_ptr<QTrading::Utils::Queue::Channel<Row>> debug_channel; ///< Debug channel, if any.
+            boost::thread                                         thread;        ///< Consumer thread.
+            std::mutex                                            mtx;           ///< Protects consume wait.
+            std::condition_variable                               cv;            ///< Signals consumer when data arrives.
+        };
+
+        /// @brief Channel receiving the boxed rows of `module_id`; null when not started.
+        std::shared_ptr<QTrading::Utils::Queue::Channel<Row>> ChannelFor(ModuleId module_id) const noexcept
+        {
+            const size_t shard = ShardOf(module_id);
+            if (shard >= shards_.size()) {
+                return nullptr;
+            }
+            const auto& s = *shards_[shard];
+            if (module_id <= module_kinds_.size() &&
+                module_kinds_[module_id - 1] == ChannelKind::Debug &&
+                s.debug_channel) {
+                return s.debug_channel;
+            }
+            return s.channel;
+        }
+
+        /// @brief Wake the consumer thread owning `module_id`.
+        void NotifyConsumer(ModuleId module_id) noexcept
+        {
+            const size_t shard = ShardOf(module_id);
+            if (shard < shards_.size()) {
+                shards_[shard]->cv.notify_one();
+            }
+        }
+
+        /// @brief Create the shards' channels with `make_channel` and start their threads.
+        template <typename MakeChannel>
+        void StartShards(MakeChannel&& make_channel, bool with_debug_channel);
+
+        size_t consumer_shards_{ 1 };                          ///< Consumer threads started by Start().
+        std::vector<size_t> module_shards_;                    ///< Module id to consumer shard.
+        std::vector<std::unique_ptr<ConsumerShard>> shards_;   ///< Consumer shards; shard 0 owns `channel`.
+        std::atomic<size_t> shards_running_{ 0 };              ///< Shards still in their consume loop.
     };
 }
@@ -1,12 +1,16 @@
 #pragma once
 
+#include "FileLogger/FeatherV2Sink.hpp"
+#include "FileLogger/ParquetSink.hpp"
 #include "SinkLogger.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace QTrading::Log {
@@ -24,6 +28,15 @@ struct LoggerBootstrapConfig {
     std::string strategy_version;
     std::string strategy_params;
     std::vector<DatasetEntry> dataset_entries;
+    /// Writer threads of the logger; modules are spread over them (see SinkLogger::SetWriterThreads).
+    size_t writer_threads{ 1 };
+    /// Codec and batch size of every module's `.arrow` file; LZ4 keeps long runs off the disk.
+    FileLogger::FeatherV2WriteOptions write_options{ arrow::Compression::LZ4_FRAME };
+    /// Per-module overrides of `write_options`, keyed by module name (e.g. "MarketEvent").
+    std::unordered_map<std::string, FileLogger::FeatherV2WriteOptions> module_write_options;
+    /// Also write every module to `<module>.parquet` with row-group statistics for analytics.
+    bool write_parquet{ false };
+    FileLogger::ParquetSinkOptions parquet_options;
 };
 
 struct LoggerBootstrapResult {
@@ -15,15 +15,61 @@ namespace QTrading::Log {
 
         void AddSink(std::unique_ptr<ILogSink> sink);
 
+        /// @brief Write with `threads` writer threads, each owning the modules of one shard.
+        /// @details Modules are spread over the writers round-robin by module id and producers
+        ///          enqueue straight to the owning writer, so a heavy module only slows the modules
+        ///          sharing its writer. Sinks then see concurrent writes for different modules; the
+        ///          last writer to finish flushes and closes them. Must be called before Start().
+        void SetWriterThreads(size_t threads);
+
         void RegisterModule(const std::string& module,
             std::shared_ptr<arrow::Schema> schema,
             Serializer serializer,
             ChannelKind kind = ChannelKind::Critical);
 
+        /// @brief Register a module whose rows are `T` records built in place in a preallocated ring.
+        /// @details Log rows with `LogRecord<T>`; `serializer` receives a `const T*`.
+        template <typename T>
+        void RegisterRecordModule(const std::string& module,
+            std::shared_ptr<arrow::Schema> schema,
+            Serializer serializer,
+            size_t capacity = kDefaultRecordRingCapacity)
+        {
+            RegisterRecordModule(module, std::move(schema), std::move(serializer), nullptr,
+                sizeof(T), RecordTypeOf<T>(), capacity);
+        }
+
+        /// @brief Register a record module whose sinks may append whole drained spans per column.
+        /// @details `batch_serializer` receives spans of `T`; sinks without columnar support use `serializer`.
+        template <typename T>
+        void RegisterRecordModule(const std::string& module,
+            std::shared_ptr<arrow::Schema> schema,
+            Serializer serializer,
+            RecordBatchSerializer batch_serializer,
+            size_t capacity = kDefaultRecordRingCapacity)
+        {
+            RegisterRecordModule(module, std::move(schema), std::move(serializer), std::move(batch_serializer),
+                sizeof(T), RecordTypeOf<T>(), capacity);
+        }
+
+        static constexpr size_t kDefaultRecordRingCapacity = 16384;
+
     protected:
         void Consume() override;
 
+        void ConsumeShard(size_t shard) override;
+
     private:
+        void RegisterRecordModule(const std::string& module,
+            std::shared_ptr<arrow::Schema> schema,
+            Serializer serializer,
+            RecordBatchSerializer batch_serializer,
+            size_t record_size,
+            const void* record_type,
+            size_t capacity);
+
+        void WriteRecords(const LogRecordSpan& span);
+
         std::vector<std::unique_ptr<ILogSink>> sinks_;
     };
 
@@ -1,31 +1,12 @@
 ﻿#include "FileLogger/FeatherV2.hpp"
+#include "FileLogger/FeatherV2/ArrowAppend.hpp"
 #include <arrow/ipc/feather.h>   ///< Feather metadata support.
-#include <arrow/util/key_value_metadata.h>
 #include "parquet/stream_writer.h"
 #include <stdexcept>
 #include <filesystem>
 
 namespace fs = std::filesystem;
 
-namespace {
-
-std::shared_ptr<arrow::Schema> WithSchemaMetadata(const std::shared_ptr<arrow::Schema>& schema,
-    const std::string& module)
-{
-    std::shared_ptr<arrow::KeyValueMetadata> meta =
-        schema->metadata() ? schema->metadata()->Copy()
-                           : std::make_shared<arrow::KeyValueMetadata>();
-    if (meta->FindKey("schema_version") < 0) {
-        meta->Append("schema_version", "1");
-    }
-    if (meta->FindKey("module") < 0) {
-        meta->Append("module", module);
-    }
-    return schema->WithMetadata(meta);
-}
-
-} // namespace
-
 namespace QTrading::Log {
 
     /// @brief Construct a FeatherV2 logger using the specified directory.
@@ -54,7 +35,7 @@ namespace QTrading::Log {
         const auto module_id = RegisterModuleId(module, kind);
 
         Slot s;
-        s.schema = WithSchemaMetadata(schema, module);
+        s.schema = FileLogger::FeatherV2::detail::WithSchemaMetadata(schema, module);
         s.serializer = std::move(serializer);
 
         // Build the RecordBatchBuilder (capacity 8192 rows).
@@ -1,10 +1,11 @@
 #include "FileLogger/FeatherV2Sink.hpp"
 
+#include "FileLogger/FeatherV2/ArrowAppend.hpp"
 #include <arrow/ipc/api.h>
 #include <arrow/io/api.h>
 #include <arrow/ipc/feather.h>
-#include <arrow/util/key_value_metadata.h>
 #include "parquet/stream_writer.h"
+#include <algorithm>
 #include <filesystem>
 #include <stdexcept>
 
@@ -12,27 +13,32 @@ namespace fs = std::filesystem;
 
 namespace {
 
-std::shared_ptr<arrow::Schema> WithSchemaMetadata(const std::shared_ptr<arrow::Schema>& schema,
+arrow::ipc::IpcWriteOptions MakeWriteOptions(const QTrading::Log::FileLogger::FeatherV2WriteOptions& options,
     const std::string& module)
 {
-    std::shared_ptr<arrow::KeyValueMetadata> meta =
-        schema->metadata() ? schema->metadata()->Copy()
-                           : std::make_shared<arrow::KeyValueMetadata>();
-    if (meta->FindKey("schema_version") < 0) {
-        meta->Append("schema_version", "1");
+    arrow::ipc::IpcWriteOptions write_opts = arrow::ipc::IpcWriteOptions::Defaults();
+    if (options.codec == arrow::Compression::UNCOMPRESSED) {
+        return write_opts;
     }
-    if (meta->FindKey("module") < 0) {
-        meta->Append("module", module);
+    if (options.codec != arrow::Compression::LZ4_FRAME && options.codec != arrow::Compression::ZSTD) {
+        throw std::runtime_error("Arrow IPC supports only LZ4_FRAME and ZSTD compression (module " + module + ")");
     }
-    return schema->WithMetadata(meta);
+    // Batch bodies are compressed inside WriteRecordBatch, i.e. on the writer thread owning the module.
+    PARQUET_ASSIGN_OR_THROW(write_opts.codec,
+        arrow::util::Codec::Create(options.codec, options.compression_level));
+    return write_opts;
 }
 
 } // namespace
 
 namespace QTrading::Log::FileLogger {
 
-    FeatherV2Sink::FeatherV2Sink(const std::string& dir)
-        : dir_(dir)
+    FeatherV2Sink::FeatherV2Sink(const std::string& dir,
+        FeatherV2WriteOptions defaults,
+        std::unordered_map<std::string, FeatherV2WriteOptions> module_options)
+        : dir_(dir),
+          defaults_(defaults),
+          module_options_(std::move(module_options))
     {
         fs::create_directories(dir_);
     }
@@ -45,12 +51,20 @@ namespace QTrading::Log::FileLogger {
         if (module_id == Logger::kInvalidModuleId) {
             throw std::runtime_error("Invalid module id for module: " + module);
         }
+        const auto options_it = module_options_.find(module);
+        const FeatherV2WriteOptions& options =
+            options_it != module_options_.end() ? options_it->second : defaults_;
+        if (options.batch_rows == 0) {
+            throw std::runtime_error("Batch size must be positive for module: " + module);
+        }
+
         Slot s;
-        s.schema = WithSchemaMetadata(schema, module);
+        s.schema = FileLogger::FeatherV2::detail::WithSchemaMetadata(schema, module);
         s.serializer = serializer;
+        s.batch_rows = options.batch_rows;
 
         auto res = arrow::RecordBatchBuilder::Make(
-            s.schema, arrow::default_memory_pool(), /*capacity=*/8192);
+            s.schema, arrow::default_memory_pool(), s.batch_rows);
         if (!res.ok()) {
             throw std::runtime_error(res.status().ToString());
         }
@@ -62,7 +76,7 @@ namespace QTrading::Log::FileLogger {
         PARQUET_ASSIGN_OR_THROW(auto outfile, out_res);
         s.outfile = std::move(outfile);
 
-        arrow::ipc::IpcWriteOptions write_opts = arrow::ipc::IpcWriteOptions::Defaults();
+        const arrow::ipc::IpcWriteOptions write_opts = MakeWriteOptions(options, module);
         PARQUET_ASSIGN_OR_THROW(auto w_res,
             arrow::ipc::MakeFileWriter(s.outfile, s.schema, write_opts));
         s.writer = w_res;
@@ -73,6 +87,12 @@ namespace QTrading::Log::FileLogger {
         slots_.at(static_cast<size_t>(module_id - 1)) = std::move(s);
     }
 
+    void FeatherV2Sink::RegisterRecordBatchSerializer(Logger::ModuleId module_id,
+        const RecordBatchSerializer& serializer)
+    {
+        slots_.at(static_cast<size_t>(module_id - 1)).batch_serializer = serializer;
+    }
+
     uint64_t FeatherV2Sink::WriteRow(const Row& row)
     {
         auto& s = slots_.at(static_cast<size_t>(row.module_id - 1));
@@ -81,7 +101,7 @@ namespace QTrading::Log::FileLogger {
         PARQUET_THROW_NOT_OK(builder.GetFieldAs<arrow::UInt64Builder>(0)->Append(row.ts));
         s.serializer(row.payload.get(), builder);
 
-        if (++s.rows >= 8192) {
+        if (++s.rows >= s.batch_rows) {
             auto rb_res = builder.Flush();
             PARQUET_ASSIGN_OR_THROW(auto rb, rb_res);
             PARQUET_THROW_NOT_OK(s.writer->WriteRecordBatch(*rb));
@@ -91,6 +111,56 @@ namespace QTrading::Log::FileLogger {
         return 0;
     }
 
+    uint64_t FeatherV2Sink::WriteRecords(const LogRecordSpan& span)
+    {
+        auto& s = slots_.at(static_cast<size_t>(span.module_id - 1));
+        auto& builder = *s.builder;
+
+        uint64_t flushes = 0;
+        if (!s.batch_serializer) {
+            auto* ts_builder = builder.GetFieldAs<arrow::UInt64Builder>(0);
+            for (size_t i = 0; i < span.count; ++i) {
+                PARQUET_THROW_NOT_OK(ts_builder->Append(span.ts(i)));
+                s.serializer(span.record(i), builder);
+
+                if (++s.rows >= s.batch_rows) {
+                    auto rb_res = builder.Flush();
+                    PARQUET_ASSIGN_OR_THROW(auto rb, rb_res);
+                    PARQUET_THROW_NOT_OK(s.writer->WriteRecordBatch(*rb));
+                    s.rows = 0;
+                    ts_builder = builder.GetFieldAs<arrow::UInt64Builder>(0);
+                    ++flushes;
+                }
+            }
+            return flushes;
+        }
+
+        // Columnar path: append the span in chunks that end on batch boundaries.
+        size_t done = 0;
+        while (done < span.count) {
+            const size_t n = std::min<size_t>(span.count - done, s.batch_rows - s.rows);
+            const LogRecordSpan chunk{ span.module_id, span.first + done * span.stride, n, span.stride };
+
+            auto* ts_builder = builder.GetFieldAs<arrow::UInt64Builder>(0);
+            PARQUET_THROW_NOT_OK(ts_builder->Reserve(static_cast<int64_t>(n)));
+            for (size_t i = 0; i < n; ++i) {
+                ts_builder->UnsafeAppend(chunk.ts(i));
+            }
+            s.batch_serializer(chunk, builder);
+
+            done += n;
+            s.rows += static_cast<uint32_t>(n);
+            if (s.rows >= s.batch_rows) {
+                auto rb_res = builder.Flush();
+                PARQUET_ASSIGN_OR_THROW(auto rb, rb_res);
+                PARQUET_THROW_NOT_OK(s.writer->WriteRecordBatch(*rb));
+                s.rows = 0;
+                ++flushes;
+            }
+        }
+        return flushes;
+    }
+
     uint64_t FeatherV2Sink::Flush()
     {
         uint64_t flushes = 0;
@@ -0,0 +1,176 @@
+#include "FileLogger/ParquetSink.hpp"
+
+#include "FileLogger/FeatherV2/ArrowAppend.hpp"
+#include <arrow/io/api.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/exception.h>
+#include <parquet/properties.h>
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::shared_ptr<parquet::WriterProperties> MakeWriterProperties(
+    const QTrading::Log::FileLogger::ParquetSinkOptions& options,
+    const arrow::Schema& schema)
+{
+    parquet::WriterProperties::Builder builder;
+    builder.max_row_group_length(options.row_group_rows)
+        ->compression(options.codec)
+        ->compression_level(options.compression_level)
+        ->disable_dictionary()
+        ->disable_statistics();
+    for (const auto& column : options.dictionary_columns) {
+        if (schema.GetFieldIndex(column) >= 0) {
+            builder.enable_dictionary(column);
+        }
+    }
+    for (const auto& column : options.statistics_columns) {
+        if (schema.GetFieldIndex(column) >= 0) {
+            builder.enable_statistics(column);
+        }
+    }
+    return builder.build();
+}
+
+} // namespace
+
+namespace QTrading::Log::FileLogger {
+
+    ParquetSink::ParquetSink(const std::string& dir, ParquetSinkOptions options)
+        : dir_(dir),
+          options_(std::move(options))
+    {
+        if (options_.row_group_rows <= 0 || options_.batch_rows == 0) {
+            throw std::invalid_argument("ParquetSink row group and batch sizes must be positive.");
+        }
+        fs::create_directories(dir_);
+    }
+
+    ParquetSink::~ParquetSink() = default;
+
+    void ParquetSink::RegisterModule(Logger::ModuleId module_id,
+        const std::string& module,
+        const std::shared_ptr<arrow::Schema>& schema,
+        const Serializer& serializer)
+    {
+        if (module_id == Logger::kInvalidModuleId) {
+            throw std::runtime_error("Invalid module id for module: " + module);
+        }
+        Slot s;
+        s.schema = FileLogger::FeatherV2::detail::WithSchemaMetadata(schema, module);
+        s.serializer = serializer;
+
+        auto res = arrow::RecordBatchBuilder::Make(
+            s.schema, arrow::default_memory_pool(), options_.batch_rows);
+        if (!res.ok()) {
+            throw std::runtime_error(res.status().ToString());
+        }
+        s.builder = std::move(*res);
+
+        fs::path log_path = fs::path(dir_) / (module + ".parquet");
+        PARQUET_ASSIGN_OR_THROW(auto outfile,
+            arrow::io::FileOutputStream::Open(log_path.string(), /*truncate=*/true));
+
+        // The stored Arrow schema keeps unsigned columns and the module metadata on read-back.
+        auto arrow_props = parquet::ArrowWriterProperties::Builder().store_schema()->build();
+        PARQUET_ASSIGN_OR_THROW(s.writer,
+            parquet::arrow::FileWriter::Open(*s.schema, arrow::default_memory_pool(), outfile,
+                MakeWriterProperties(options_, *s.schema), arrow_props));
+
+        if (slots_.size() < module_id) {
+            slots_.resize(module_id);
+        }
+        slots_.at(static_cast<size_t>(module_id - 1)) = std::move(s);
+    }
+
+    void ParquetSink::RegisterRecordBatchSerializer(Logger::ModuleId module_id,
+        const RecordBatchSerializer& serializer)
+    {
+        slots_.at(static_cast<size_t>(module_id - 1)).batch_serializer = serializer;
+    }
+
+    uint64_t ParquetSink::WriteBatch(Slot& s)
+    {
+        s.rows = 0;
+        PARQUET_ASSIGN_OR_THROW(auto rb, s.builder->Flush());
+        if (!rb || rb->num_rows() == 0) {
+            return 0;
+        }
+        PARQUET_THROW_NOT_OK(s.writer->WriteRecordBatch(*rb));
+        return 1;
+    }
+
+    uint64_t ParquetSink::WriteRow(const Row& row)
+    {
+        auto& s = slots_.at(static_cast<size_t>(row.module_id - 1));
+        auto& builder = *s.builder;
+
+        PARQUET_THROW_NOT_OK(builder.GetFieldAs<arrow::UInt64Builder>(0)->Append(row.ts));
+        s.serializer(row.payload.get(), builder);
+
+        if (++s.rows >= options_.batch_rows) {
+            return WriteBatch(s);
+        }
+        return 0;
+    }
+
+    uint64_t ParquetSink::WriteRecords(const LogRecordSpan& span)
+    {
+        auto& s = slots_.at(static_cast<size_t>(span.module_id - 1));
+        auto& builder = *s.builder;
+
+        uint64_t flushes = 0;
+        size_t done = 0;
+        while (done < span.count) {
+            const size_t n = std::min<size_t>(span.count - done, options_.batch_rows - s.rows);
+            const LogRecordSpan chunk{ span.module_id, span.first + done * span.stride, n, span.stride };
+
+            auto* ts_builder = builder.GetFieldAs<arrow::UInt64Builder>(0);
+            PARQUET_THROW_NOT_OK(ts_builder->Reserve(static_cast<int64_t>(n)));
+            for (size_t i = 0; i < n; ++i) {
+                ts_builder->UnsafeAppend(chunk.ts(i));
+            }
+            if (s.batch_serializer) {
+                s.batch_serializer(chunk, builder);
+            }
+            else {
+                for (size_t i = 0; i < n; ++i) {
+                    s.serializer(chunk.record(i), builder);
+                }
+            }
+
+            done += n;
+            s.rows += static_cast<uint32_t>(n);
+            if (s.rows >= options_.batch_rows) {
+                flushes += WriteBatch(s);
+            }
+        }
+        return flushes;
+    }
+
+    uint64_t ParquetSink::Flush()
+    {
+        uint64_t flushes = 0;
+        for (auto& slot : slots_) {
+            if (slot.writer) {
+                flushes += WriteBatch(slot);
+            }
+        }
+        return flushes;
+    }
+
+    void ParquetSink::Close()
+    {
+        for (auto& slot : slots_) {
+            if (slot.writer) {
+                PARQUET_THROW_NOT_OK(slot.writer->Close());
+            }
+        }
+    }
+
+} // namespace QTrading::Log::FileLogger
@@ -42,6 +42,55 @@ namespace QTrading::Log {
         return id;
     }
 
+    Logger::ModuleId Logger::RegisterRecordModuleId(const std::string& module,
+        size_t record_size,
+        const void* record_type,
+        size_t capacity)
+    {
+        if (GetModuleId(module) != kInvalidModuleId) {
+            throw std::runtime_error("Module already registered: " + module);
+        }
+        const auto id = RegisterModuleId(module, ChannelKind::Critical);
+        if (record_rings_.size() < id) {
+            record_rings_.resize(id);
+            record_types_.resize(id, nullptr);
+        }
+        record_rings_[id - 1] = std::make_unique<LogRecordRing>(record_size, capacity);
+        record_types_[id - 1] = record_type;
+        return id;
+    }
+
+    bool Logger::HasPendingRecords(size_t shard) const noexcept
+    {
+        for (size_t i = 0; i < record_rings_.size(); ++i) {
+            if (record_rings_[i] && ShardOf(static_cast<ModuleId>(i + 1)) == shard && record_rings_[i]->Size() > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Logger::SetConsumerShards(size_t shards)
+    {
+        if (channel) {
+            throw std::runtime_error("SetConsumerShards must be called before Start().");
+        }
+        if (shards == 0) {
+            throw std::invalid_argument("Logger needs at least one consumer shard.");
+        }
+        consumer_shards_ = shards;
+    }
+
+    bool Logger::FinishConsumerShard() noexcept
+    {
+        return shards_running_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    void Logger::ConsumeShard(size_t /*shard*/)
+    {
+        Consume();
+    }
+
     Logger::ModuleId Logger::GetModuleId(const std::string& module) const
     {
         auto it = module_ids_.find(module);
@@ -57,13 +106,18 @@ namespace QTrading::Log {
         out.enqueue_ok = enqueue_ok_.load(std::memory_order_relaxed);
         out.enqueue_fail = enqueue_fail_.load(std::memory_order_relaxed);
         out.flush_count = flush_count_.load(std::memory_order_relaxed);
-        if (channel) {
-            out.queue_depth = channel->Size();
-            out.drop = channel->DropCount();
+        for (const auto& shard : shards_) {
+            for (const auto* ch : { shard->channel.get(), shard->debug_channel.get() }) {
+                if (ch) {
+                    out.queue_depth += ch->Size();
+                    out.drop += ch->DropCount();
+                }
+            }
         }
-        if (debug_channel_) {
-            out.queue_depth += debug_channel_->Size();
-            out.drop += debug_channel_->DropCount();
+        for (const auto& ring : record_rings_) {
+            if (ring) {
+                out.queue_depth += ring->Size();
+            }
         }
         return out;
     }
@@ -74,9 +128,17 @@ namespace QTrading::Log {
     }
 
     bool Logger::WaitForBatch(std::vector<Row>& out, size_t max_items)
+    {
+        return WaitForBatch(0, out, max_items);
+    }
+
+    bool Logger::WaitForBatch(size_t shard, std::vector<Row>& out, size_t max_items)
     {
         out.clear();
         out.reserve(max_items);
+        auto& s = *shards_.at(shard);
+        const auto& critical = s.channel;
+        const auto& debug = s.debug_channel;
         auto drain = [&](const std::shared_ptr<QTrading::Utils::Queue::Channel<Row>>& ch, size_t remaining) {
             if (!ch || remaining == 0) {
                 return;
@@ -88,37 +150,63 @@ namespace QTrading::Log {
         };
 
         while (true) {
-            drain(channel, max_items);
-            if (debug_channel_) {
-                drain(debug_channel_, max_items - out.size());
+            drain(critical, max_items);
+            if (debug) {
+                drain(debug, max_items - out.size());
             }
-            if (!out.empty()) {
+            if (!out.empty() || HasPendingRecords(shard)) {
                 return true;
             }
 
-            const bool critical_closed = !channel || channel->IsClosed();
-            const bool debug_closed = !debug_channel_ || debug_channel_->IsClosed();
-            const bool critical_empty = !channel || channel->Size() == 0;
-            const bool debug_empty = !debug_channel_ || debug_channel_->Size() == 0;
+            const bool critical_closed = !critical || critical->IsClosed();
+            const bool debug_closed = !debug || debug->IsClosed();
+            const bool critical_empty = !critical || critical->Size() == 0;
+            const bool debug_empty = !debug || debug->Size() == 0;
             if (critical_closed && debug_closed && critical_empty && debug_empty) {
                 return false;
             }
 
-            std::unique_lock<std::mutex> lk(consume_mtx_);
-            consume_cv_.wait(lk, [&] {
-                const bool critical_has = channel && channel->Size() > 0;
-                const bool debug_has = debug_channel_ && debug_channel_->Size() > 0;
-                if (critical_has || debug_has) {
+            std::unique_lock<std::mutex> lk(s.mtx);
+            s.cv.wait(lk, [&] {
+                const bool critical_has = critical && critical->Size() > 0;
+                const bool debug_has = debug && debug->Size() > 0;
+                if (critical_has || debug_has || HasPendingRecords(shard)) {
                     return true;
                 }
-                const bool critical_closed = !channel || channel->IsClosed();
-                const bool debug_closed = !debug_channel_ || debug_channel_->IsClosed();
+                const bool critical_closed = !critical || critical->IsClosed();
+                const bool debug_closed = !debug || debug->IsClosed();
                 return critical_closed && debug_closed;
                 });
         }
     }
 
-    /// @brief Start the consumer thread and initialize the channel.
+    template <typename MakeChannel>
+    void Logger::StartShards(MakeChannel&& make_channel, bool with_debug_channel)
+    {
+        if (shards_.size() != consumer_shards_) {
+            shards_.clear();
+            for (size_t i = 0; i < consumer_shards_; ++i) {
+                shards_.push_back(std::make_unique<ConsumerShard>());
+            }
+        }
+        module_shards_.resize(module_ids_.size());
+        for (size_t i = 0; i < module_shards_.size(); ++i) {
+            module_shards_[i] = i % consumer_shards_;
+        }
+        for (auto& shard : shards_) {
+            shard->channel = make_channel(false);
+            shard->debug_channel = with_debug_channel ? make_channel(true) : nullptr;
+        }
+        channel = shards_.front()->channel;
+        debug_channel_ = shards_.front()->debug_channel;
+        records_open_.store(true, std::memory_order_release);
+        shards_running_.store(shards_.size(), std::memory_order_release);
+        for (size_t i = 0; i < shards_.size(); ++i) {
+            shards_[i]->thread = boost::thread(&Logger::ConsumeShard, this, i);
+        }
+    }
+
+    /// @brief Start the consumer threads and initialize the channels.
     /// No-op if already started.
     void Logger::Start()
     {
@@ -126,14 +214,14 @@ namespace QTrading::Log {
         if (channel) {
             return;
         }
-        QTrading::Utils::Queue::ChannelOptions options;
-        options.single_reader = true;
-        channel = ChannelFactory::CreateUnboundedChannel<Row>(options);
-        debug_channel_.reset();
-        consumer = boost::thread(&Logger::Consume, this);
+        StartShards([](bool) {
+            QTrading::Utils::Queue::ChannelOptions options;
+            options.single_reader = true;
+            return ChannelFactory::CreateUnboundedChannel<Row>(options);
+        }, false);
     }
 
-    /// @brief Start the consumer thread and initialize a bounded channel.
+    /// @brief Start the consumer threads and initialize bounded channels.
     /// No-op if already started.
     void Logger::Start(size_t capacity, QTrading::Utils::Queue::OverflowPolicy policy)
     {
@@ -141,9 +229,9 @@ namespace QTrading::Log {
         if (channel) {
             return;
         }
-        channel = ChannelFactory::CreateBoundedChannel<Row>(capacity, policy);
-        debug_channel_.reset();
-        consumer = boost::thread(&Logger::Consume, this);
+        StartShards([&](bool) {
+            return ChannelFactory::CreateBoundedChannel<Row>(capacity, policy);
+        }, false);
     }
 
     void Logger::StartWithDebugChannel(size_t debug_capacity, QTrading::Utils::Queue::OverflowPolicy policy)
@@ -152,14 +240,17 @@ namespace QTrading::Log {
         if (channel) {
             return;
         }
-        QTrading::Utils::Queue::ChannelOptions options;
-        options.single_reader = true;
-        channel = ChannelFactory::CreateUnboundedChannel<Row>(options);
-        debug_channel_ = ChannelFactory::CreateBoundedChannel<Row>(debug_capacity, policy);
-        consumer = boost::thread(&Logger::Consume, this);
+        StartShards([&](bool debug) -> std::shared_ptr<QTrading::Utils::Queue::Channel<Row>> {
+            if (debug) {
+                return ChannelFactory::CreateBoundedChannel<Row>(debug_capacity, policy);
+            }
+            QTrading::Utils::Queue::ChannelOptions options;
+            options.single_reader = true;
+            return ChannelFactory::CreateUnboundedChannel<Row>(options);
+        }, true);
     }
 
-    /// @brief Stop the consumer thread, close channel, and join.
+    /// @brief Stop the consumer threads, close channels, and join.
     /// No-op if not started.
     void Logger::Stop()
     {
@@ -168,13 +259,25 @@ namespace QTrading::Log {
             if (!channel) {
                 return;
             }
-            channel->Close();
-            if (debug_channel_) {
-                debug_channel_->Close();
+            // Producers blocked on a full record ring give up; the consumers drain what is left.
+            records_open_.store(false, std::memory_order_release);
+            for (auto& shard : shards_) {
+                shard->channel->Close();
+                if (shard->debug_channel) {
+                    shard->debug_channel->Close();
+                }
             }
         }
-        consume_cv_.notify_all();
-        consumer.join();
+        for (auto& shard : shards_) {
+            shard->cv.notify_all();
+        }
+        for (auto& shard : shards_) {
+            shard->thread.join();
+        }
+        for (auto& shard : shards_) {
+            shard->channel.reset();
+            shard->debug_channel.reset();
+        }
         channel.reset();
         debug_channel_.reset();
     }
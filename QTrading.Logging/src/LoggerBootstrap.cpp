@@ -11,6 +11,7 @@
 #include "FileLogger/FeatherV2/PositionEvent.hpp"
 #include "FileLogger/FeatherV2/RunMetadata.hpp"
 #include "FileLogger/FeatherV2Sink.hpp"
+#include "FileLogger/ParquetSink.hpp"
 
 #include <chrono>
 #include <ctime>
@@ -136,10 +137,13 @@ void RegisterDefaultModules(SinkLogger& logger)
         LogModuleToString(LogModule::OrderEvent),
         FileLogger::FeatherV2::OrderEvent::Schema(),
         FileLogger::FeatherV2::OrderEvent::Serializer);
-    logger.RegisterModule(
+    // One row per symbol per step: built in place in a preallocated ring instead of boxed,
+    // and appended to the Arrow builders one column at a time per drained span.
+    logger.RegisterRecordModule<FileLogger::FeatherV2::MarketEventRecord>(
         LogModuleToString(LogModule::MarketEvent),
         FileLogger::FeatherV2::MarketEvent::Schema(),
-        FileLogger::FeatherV2::MarketEvent::Serializer);
+        FileLogger::FeatherV2::MarketEvent::RecordSerializer,
+        FileLogger::FeatherV2::MarketEvent::RecordBatchSerializer);
     logger.RegisterModule(
         LogModuleToString(LogModule::FundingEvent),
         FileLogger::FeatherV2::FundingEvent::Schema(),
@@ -161,7 +165,12 @@ LoggerBootstrapResult InitializeFeatherLogger(const LoggerBootstrapConfig& cfg)
     std::filesystem::create_directories(out.run_dir);
 
     out.logger = std::make_shared<SinkLogger>(out.run_dir.string());
-    out.logger->AddSink(std::make_unique<FileLogger::FeatherV2Sink>(out.run_dir.string()));
+    out.logger->AddSink(std::make_unique<FileLogger::FeatherV2Sink>(
+        out.run_dir.string(), cfg.write_options, cfg.module_write_options));
+    if (cfg.write_parquet) {
+        out.logger->AddSink(std::make_unique<FileLogger::ParquetSink>(out.run_dir.string(), cfg.parquet_options));
+    }
+    out.logger->SetWriterThreads(cfg.writer_threads);
 
     WriteRunMetadataFiles(
         out.run_dir,
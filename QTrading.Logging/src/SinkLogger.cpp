@@ -18,6 +18,12 @@ namespace QTrading::Log {
         sinks_.push_back(std::move(sink));
     }
 
+    void SinkLogger::SetWriterThreads(size_t threads)
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        SetConsumerShards(threads);
+    }
+
     void SinkLogger::RegisterModule(const std::string& module,
         std::shared_ptr<arrow::Schema> schema,
         Serializer serializer,
@@ -37,12 +43,50 @@ namespace QTrading::Log {
         }
     }
 
+    void SinkLogger::RegisterRecordModule(const std::string& module,
+        std::shared_ptr<arrow::Schema> schema,
+        Serializer serializer,
+        RecordBatchSerializer batch_serializer,
+        size_t record_size,
+        const void* record_type,
+        size_t capacity)
+    {
+        std::lock_guard<std::mutex> lk(mtx);
+        if (channel) {
+            throw std::runtime_error("RegisterModule must be called before Start().");
+        }
+
+        const auto module_id = RegisterRecordModuleId(module, record_size, record_type, capacity);
+        for (auto& sink : sinks_) {
+            sink->RegisterModule(module_id, module, schema, serializer);
+            if (batch_serializer) {
+                sink->RegisterRecordBatchSerializer(module_id, batch_serializer);
+            }
+        }
+    }
+
+    void SinkLogger::WriteRecords(const LogRecordSpan& span)
+    {
+        for (auto& sink : sinks_) {
+            const auto flushed = sink->WriteRecords(span);
+            if (flushed > 0) {
+                IncrementFlushCount(flushed);
+            }
+        }
+    }
+
     void SinkLogger::Consume()
+    {
+        ConsumeShard(0);
+    }
+
+    void SinkLogger::ConsumeShard(size_t shard)
     {
         constexpr size_t kMaxBatch = 1024;
         std::vector<Row> batch;
+        const auto write_records = [this](const LogRecordSpan& span) { WriteRecords(span); };
 
-        while (WaitForBatch(batch, kMaxBatch)) {
+        while (WaitForBatch(shard, batch, kMaxBatch)) {
             for (const auto& row : batch) {
                 for (auto& sink : sinks_) {
                     const auto flushed = sink->WriteRow(row);
@@ -51,8 +95,14 @@ namespace QTrading::Log {
                     }
                 }
             }
+            DrainRecords(shard, write_records);
         }
+        DrainRecords(shard, write_records);
 
+        // Other writers may still be writing their modules; the last one out closes the sinks.
+        if (!FinishConsumerShard()) {
+            return;
+        }
         for (auto& sink : sinks_) {
             const auto flushed = sink->Flush();
             if (flushed > 0) {
@@ -7,6 +7,11 @@
 #include "FileLogger/FeatherV2/OrderEvent.hpp"
 #include "FileLogger/FeatherV2/Position.hpp"
 #include "FileLogger/FeatherV2/PositionEvent.hpp"
+#include "FileLogger/FeatherV2Sink.hpp"
+#include "InMemorySink.hpp"
+#include "LogRecordRing.hpp"
+#include "ScopedTestLogDir.hpp"
+#include "SinkLogger.hpp"
 #include <gtest/gtest.h>
 #include <arrow/io/api.h>
 #include <arrow/ipc/api.h>
@@ -14,6 +19,7 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/thread.hpp>
+#include <algorithm>
 #include <atomic>
 #include <stdexcept>
 
@@ -133,7 +139,7 @@ TEST_F(LoggerTest, SingleRecord) {
     InitSimpleModule(logger);
     logger->Start();
 
-    QTrading::Utils::GlobalTimestamp.store(5555);
+    logger->SetTimestamp(5555);
 
     EXPECT_TRUE(logger->Log("Simple", SimpleLog{ 42, "foo" }));
 
@@ -167,7 +173,7 @@ TEST_F(LoggerTest, BatchLoggingSingleModule) {
         { 3, "c" }
     };
 
-    QTrading::Utils::GlobalTimestamp.store(7777);
+    logger->SetTimestamp(7777);
     const auto count = logger->LogBatch("Simple", logs.data(), logs.size());
     EXPECT_EQ(count, logs.size());
 
@@ -214,7 +220,7 @@ TEST_F(LoggerTest, MultiThreadLogging) {
     for (int t = 0; t < nThreads; ++t) {
         threads.emplace_back([this, perThread, &all_ok]() {
             for (int i = 0; i < perThread; ++i) {
-                QTrading::Utils::GlobalTimestamp.store(1000 + i);
+                logger->SetTimestamp(1000 + i);
                 if (!logger->Log("Simple", SimpleLog{ i, "x" })) {
                     all_ok.store(false, std::memory_order_relaxed);
                 }
@@ -238,10 +244,10 @@ TEST_F(LoggerTest, MultiModule) {
     InitOtherModule(logger);
     logger->Start();
 
-    QTrading::Utils::GlobalTimestamp.store(1111);
+    logger->SetTimestamp(1111);
     EXPECT_TRUE(logger->Log("Simple", SimpleLog{ 1, "a" }));
 
-    QTrading::Utils::GlobalTimestamp.store(2222);
+    logger->SetTimestamp(2222);
     EXPECT_TRUE(logger->Log("Other", OtherLog{ 3.14 }));
 
     logger->Stop();
@@ -356,3 +362,279 @@ TEST(FeatherSchemaTests, EventSchemasExposeInstrumentType)
     EXPECT_TRUE(market_has_index->type()->Equals(arrow::boolean()));
 }
 
+
+/// @brief Records written past the end of the ring drain as two contiguous spans, in order.
+TEST(LogRecordRingTests, DrainSplitsWrappedRecordsIntoTwoSpans) {
+    struct Sample {
+        uint32_t value;
+    };
+    LogRecordRing ring(sizeof(Sample), 4);
+    const auto never_wait = []() { return false; };
+    const auto write = [&](uint32_t value) {
+        return ring.TryWrite<Sample>(100 + value, [&](Sample& s) { s.value = value; }, never_wait);
+    };
+    for (uint32_t v = 0; v < 3; ++v) {
+        ASSERT_TRUE(write(v));
+    }
+    EXPECT_EQ(ring.Drain(1, [](const LogRecordSpan&) {}), 3u);
+
+    for (uint32_t v = 3; v < 7; ++v) {
+        ASSERT_TRUE(write(v));
+    }
+    EXPECT_FALSE(write(7)); // full, and the wait callback gives up
+    EXPECT_EQ(ring.Size(), 4u);
+
+    std::vector<size_t> span_sizes;
+    std::vector<uint32_t> values;
+    std::vector<uint64_t> stamps;
+    ring.Drain(9, [&](const LogRecordSpan& span) {
+        EXPECT_EQ(span.module_id, 9u);
+        span_sizes.push_back(span.count);
+        for (size_t i = 0; i < span.count; ++i) {
+            values.push_back(static_cast<const Sample*>(span.record(i))->value);
+            stamps.push_back(span.ts(i));
+        }
+    });
+    EXPECT_EQ(span_sizes, (std::vector<size_t>{ 1, 3 }));
+    EXPECT_EQ(values, (std::vector<uint32_t>{ 3, 4, 5, 6 }));
+    EXPECT_EQ(stamps, (std::vector<uint64_t>{ 103, 104, 105, 106 }));
+    EXPECT_EQ(ring.Size(), 0u);
+}
+
+/// @brief A record module streams in-place records through a small ring into its Feather file.
+TEST(SinkLoggerTests, RecordModuleWritesRecordsThroughSinkLogger) {
+    using FileLogger::FeatherV2::MarketEventRecord;
+    constexpr size_t kRecords = 100;
+    const auto btc = QTrading::Dto::Trading::SymbolTable::Intern("BTCUSDT");
+    const auto eth = QTrading::Dto::Trading::SymbolTable::Intern("ETHUSDT");
+
+    const ScopedTestLogDir dir;
+    SinkLogger sink_logger(dir.path);
+    sink_logger.AddSink(std::make_unique<FileLogger::FeatherV2Sink>(dir.path));
+    auto memory = std::make_unique<InMemorySink>();
+    const auto* memory_sink = memory.get();
+    sink_logger.AddSink(std::move(memory));
+    // Far fewer slots than records, so producers wait on the consumer.
+    sink_logger.RegisterRecordModule<MarketEventRecord>("Market",
+        FileLogger::FeatherV2::MarketEvent::Schema(),
+        FileLogger::FeatherV2::MarketEvent::RecordSerializer,
+        /*capacity=*/4);
+    const auto module_id = sink_logger.GetModuleId("Market");
+    EXPECT_TRUE(sink_logger.AcceptsRecords<MarketEventRecord>(module_id));
+    EXPECT_FALSE(sink_logger.AcceptsRecords<uint64_t>(module_id));
+    sink_logger.Start();
+
+    for (size_t i = 0; i < kRecords; ++i) {
+        ASSERT_TRUE(sink_logger.LogRecord<MarketEventRecord>(module_id, 1000 + i, [&](MarketEventRecord& e) {
+            e.event_seq = i;
+            e.symbol_id = i % 2 == 0 ? btc : eth;
+            e.has_kline = true;
+            e.close = static_cast<double>(i);
+        }));
+    }
+    // Record modules take no boxed rows.
+    EXPECT_FALSE(sink_logger.Log(module_id, MarketEventRecord{}));
+    sink_logger.Stop();
+
+    ASSERT_EQ(memory_sink->records().size(), kRecords);
+    EXPECT_TRUE(memory_sink->rows().empty());
+    EXPECT_EQ(sink_logger.GetMetrics().enqueue_ok, kRecords);
+
+    auto table = ReadTable(dir.path + "/Market.arrow");
+    ASSERT_EQ(table->num_rows(), static_cast<int64_t>(kRecords));
+    auto ts = std::static_pointer_cast<arrow::UInt64Array>(table->GetColumnByName("ts")->chunk(0));
+    auto symbol = std::static_pointer_cast<arrow::StringArray>(table->GetColumnByName("symbol")->chunk(0));
+    auto close = std::static_pointer_cast<arrow::DoubleArray>(table->GetColumnByName("close")->chunk(0));
+    for (size_t i = 0; i < kRecords; ++i) {
+        const auto row = static_cast<int64_t>(i);
+        EXPECT_EQ(ts->Value(row), 1000 + i);
+        EXPECT_EQ(symbol->GetString(row), i % 2 == 0 ? "BTCUSDT" : "ETHUSDT");
+        EXPECT_EQ(close->Value(row), static_cast<double>(i));
+    }
+}
+
+/// @brief The columnar record serializer writes the same file as the per-record one, across batch boundaries.
+TEST(FeatherV2SinkTests, RecordBatchSerializerMatchesPerRecordSerializer) {
+    using FileLogger::FeatherV2::MarketEventRecord;
+    namespace MarketEvent = FileLogger::FeatherV2::MarketEvent;
+    constexpr size_t kRecords = 10000;
+    const QTrading::Dto::Trading::SymbolId symbols[] = {
+        QTrading::Dto::Trading::SymbolTable::Intern("BTCUSDT"),
+        QTrading::Dto::Trading::SymbolTable::Intern("ETHUSDT"),
+        QTrading::Dto::Trading::SymbolTable::Intern("SOLUSDT"),
+    };
+
+    LogRecordRing ring(sizeof(MarketEventRecord), kRecords);
+    for (size_t i = 0; i < kRecords; ++i) {
+        ASSERT_TRUE(ring.TryWrite<MarketEventRecord>(1000 + i, [&](MarketEventRecord& e) {
+            e.run_id = 7;
+            e.step_seq = i / 3;
+            e.event_seq = i;
+            e.ts_local = 1000 + i;
+            e.symbol_id = symbols[i % 3];
+            e.has_kline = i % 5 != 0;
+            e.close = static_cast<double>(i) * 0.5;
+            e.has_mark_price = i % 2 == 0;
+            e.mark_price = static_cast<double>(i) + 0.25;
+            e.mark_price_source = static_cast<int32_t>(i % 3);
+        }, [] { return false; }));
+    }
+
+    const ScopedTestLogDir dir;
+    FileLogger::FeatherV2Sink row_sink(dir.path + "/rows");
+    FileLogger::FeatherV2Sink column_sink(dir.path + "/columns");
+    row_sink.RegisterModule(1, "Market", MarketEvent::Schema(), MarketEvent::RecordSerializer);
+    column_sink.RegisterModule(1, "Market", MarketEvent::Schema(), MarketEvent::RecordSerializer);
+    column_sink.RegisterRecordBatchSerializer(1, MarketEvent::RecordBatchSerializer);
+
+    // Odd-sized spans so chunks straddle the 8192-row batch boundary.
+    ring.Drain(1, [&](const LogRecordSpan& span) {
+        for (size_t first = 0; first < span.count; first += 1000) {
+            const LogRecordSpan part{ span.module_id, span.first + first * span.stride,
+                std::min<size_t>(1000, span.count - first), span.stride };
+            row_sink.WriteRecords(part);
+            column_sink.WriteRecords(part);
+        }
+    });
+    for (auto* sink : { &row_sink, &column_sink }) {
+        sink->Flush();
+        sink->Close();
+    }
+
+    auto rows = ReadTable(dir.path + "/rows/Market.arrow");
+    auto columns = ReadTable(dir.path + "/columns/Market.arrow");
+    ASSERT_EQ(columns->num_rows(), static_cast<int64_t>(kRecords));
+    EXPECT_TRUE(columns->Equals(*rows));
+}
+
+/// @brief With several writer threads every module keeps all its rows, in the order they were logged.
+TEST(SinkLoggerTests, WriterThreadsShardModulesAndKeepPerModuleOrder) {
+    using FileLogger::FeatherV2::MarketEventRecord;
+    constexpr uint64_t kRows = 5000;
+    const std::vector<std::string> modules{ "First", "Second", "Third" };
+    const auto schema = arrow::schema({
+        arrow::field("ts", arrow::uint64()),
+        arrow::field("x",  arrow::float64())
+        });
+    Serializer ser = [](const void* src, arrow::RecordBatchBuilder& bld) {
+        ThrowIfNotOk(bld.GetFieldAs<arrow::DoubleBuilder>(1)->Append(static_cast<const OtherLog*>(src)->x));
+        };
+
+    const ScopedTestLogDir dir;
+    SinkLogger sink_logger(dir.path);
+    sink_logger.AddSink(std::make_unique<FileLogger::FeatherV2Sink>(dir.path));
+    auto memory = std::make_unique<InMemorySink>();
+    const auto* memory_sink = memory.get();
+    sink_logger.AddSink(std::move(memory));
+    sink_logger.SetWriterThreads(3);
+    for (const auto& module : modules) {
+        sink_logger.RegisterModule(module, schema, ser);
+    }
+    sink_logger.RegisterRecordModule<MarketEventRecord>("Market",
+        FileLogger::FeatherV2::MarketEvent::Schema(),
+        FileLogger::FeatherV2::MarketEvent::RecordSerializer,
+        FileLogger::FeatherV2::MarketEvent::RecordBatchSerializer,
+        /*capacity=*/64);
+    sink_logger.Start();
+    EXPECT_THROW(sink_logger.SetWriterThreads(2), std::runtime_error);
+
+    const auto btc = QTrading::Dto::Trading::SymbolTable::Intern("BTCUSDT");
+    std::vector<boost::thread> producers;
+    for (const auto& module : modules) {
+        const auto module_id = sink_logger.GetModuleId(module);
+        producers.emplace_back([&sink_logger, module_id] {
+            for (uint64_t i = 0; i < kRows; ++i) {
+                PayloadPtr payload = MakePayload<OtherLog>(OtherLog{ static_cast<double>(i) });
+                ASSERT_EQ(sink_logger.LogBatchAt(module_id, &payload, 1, i), 1u);
+            }
+        });
+    }
+    const auto market_id = sink_logger.GetModuleId("Market");
+    producers.emplace_back([&sink_logger, market_id, btc] {
+        for (uint64_t i = 0; i < kRows; ++i) {
+            ASSERT_TRUE(sink_logger.LogRecord<MarketEventRecord>(market_id, i, [&](MarketEventRecord& e) {
+                e.symbol_id = btc;
+                e.close = static_cast<double>(i);
+            }));
+        }
+    });
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    sink_logger.Stop();
+
+    EXPECT_EQ(sink_logger.GetMetrics().enqueue_ok, kRows * 4);
+    EXPECT_EQ(memory_sink->rows().size(), kRows * 3);
+    EXPECT_EQ(memory_sink->records().size(), kRows);
+    for (const auto& module : modules) {
+        auto table = ReadTable(dir.path + "/" + module + ".arrow");
+        ASSERT_EQ(table->num_rows(), static_cast<int64_t>(kRows));
+        int64_t row = 0;
+        for (const auto& chunk : table->GetColumnByName("ts")->chunks()) {
+            auto ts = std::static_pointer_cast<arrow::UInt64Array>(chunk);
+            for (int64_t i = 0; i < ts->length(); ++i, ++row) {
+                ASSERT_EQ(ts->Value(i), static_cast<uint64_t>(row));
+            }
+        }
+    }
+    auto market = ReadTable(dir.path + "/Market.arrow");
+    EXPECT_EQ(market->num_rows(), static_cast<int64_t>(kRows));
+}
+
+/// @brief Compressed modules read back identical to uncompressed ones, in far smaller files.
+TEST(FeatherV2SinkTests, CompressedModulesRoundTripWithConfiguredBatchSize) {
+    using FileLogger::FeatherV2::MarketEventRecord;
+    using FileLogger::FeatherV2WriteOptions;
+    namespace MarketEvent = FileLogger::FeatherV2::MarketEvent;
+    constexpr size_t kRecords = 20000;
+    const ScopedTestLogDir dir;
+    const auto btc = QTrading::Dto::Trading::SymbolTable::Intern("BTCUSDT");
+
+    LogRecordRing ring(sizeof(MarketEventRecord), kRecords);
+    for (size_t i = 0; i < kRecords; ++i) {
+        ASSERT_TRUE(ring.TryWrite<MarketEventRecord>(60'000 * i, [&](MarketEventRecord& e) {
+            e.step_seq = i;
+            e.ts_local = 60'000 * i;
+            e.symbol_id = btc;
+            e.has_kline = true;
+            e.close = 100.0 + static_cast<double>(i % 50) * 0.5;
+        }, [] { return false; }));
+    }
+
+    FeatherV2WriteOptions zstd{ arrow::Compression::ZSTD, 3, 4096 };
+    std::vector<std::unique_ptr<FileLogger::FeatherV2Sink>> sinks;
+    sinks.push_back(std::make_unique<FileLogger::FeatherV2Sink>(dir.path + "/plain"));
+    sinks.push_back(std::make_unique<FileLogger::FeatherV2Sink>(dir.path + "/lz4",
+        FeatherV2WriteOptions{ arrow::Compression::LZ4_FRAME }));
+    sinks.push_back(std::make_unique<FileLogger::FeatherV2Sink>(dir.path + "/zstd",
+        FeatherV2WriteOptions{}, std::unordered_map<std::string, FeatherV2WriteOptions>{ { "Market", zstd } }));
+    for (auto& sink : sinks) {
+        sink->RegisterModule(1, "Market", MarketEvent::Schema(), MarketEvent::RecordSerializer);
+        sink->RegisterRecordBatchSerializer(1, MarketEvent::RecordBatchSerializer);
+    }
+    ring.Drain(1, [&](const LogRecordSpan& span) {
+        for (auto& sink : sinks) {
+            sink->WriteRecords(span);
+        }
+    });
+    for (auto& sink : sinks) {
+        sink->Flush();
+        sink->Close();
+    }
+
+    auto plain = ReadTable(dir.path + "/plain/Market.arrow");
+    ASSERT_EQ(plain->num_rows(), static_cast<int64_t>(kRecords));
+    const auto plain_size = bfs::file_size(dir.path + "/plain/Market.arrow");
+    for (const std::string codec : { "lz4", "zstd" }) {
+        const std::string path = dir.path + "/" + codec + "/Market.arrow";
+        auto table = ReadTable(path);
+        EXPECT_TRUE(table->Equals(*plain)) << codec;
+        EXPECT_LT(bfs::file_size(path) * 3, plain_size) << codec;
+    }
+    EXPECT_EQ(plain->column(0)->num_chunks(), 3);
+    EXPECT_EQ(ReadTable(dir.path + "/zstd/Market.arrow")->column(0)->num_chunks(), 5);
+
+    FileLogger::FeatherV2Sink snappy(dir.path + "/snappy", FeatherV2WriteOptions{ arrow::Compression::SNAPPY });
+    EXPECT_THROW(snappy.RegisterModule(1, "Market", MarketEvent::Schema(), MarketEvent::RecordSerializer),
+        std::runtime_error);
+}
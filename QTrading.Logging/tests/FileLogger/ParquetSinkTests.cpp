@@ -0,0 +1,131 @@
+#include "FileLogger/FeatherV2/MarketEvent.hpp"
+#include "FileLogger/ParquetSink.hpp"
+#include "LogRecordRing.hpp"
+#include "ScopedTestLogDir.hpp"
+#include <gtest/gtest.h>
+#include <arrow/io/api.h>
+#include <arrow/table.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/exception.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+#include <parquet/statistics.h>
+
+#include <string>
+
+using namespace QTrading::Log;
+
+namespace {
+
+struct StepLog {
+    uint64_t step_seq;
+    double value;
+};
+
+std::shared_ptr<arrow::Schema> StepSchema()
+{
+    return arrow::schema({
+        arrow::field("ts", arrow::uint64()),
+        arrow::field("step_seq", arrow::uint64()),
+        arrow::field("value", arrow::float64())
+    });
+}
+
+void SerializeStep(const void* src, arrow::RecordBatchBuilder& builder)
+{
+    const auto& e = *static_cast<const StepLog*>(src);
+    PARQUET_THROW_NOT_OK(builder.GetFieldAs<arrow::UInt64Builder>(1)->Append(e.step_seq));
+    PARQUET_THROW_NOT_OK(builder.GetFieldAs<arrow::DoubleBuilder>(2)->Append(e.value));
+}
+
+std::unique_ptr<parquet::ParquetFileReader> OpenParquet(const std::string& path)
+{
+    return parquet::ParquetFileReader::OpenFile(path, /*memory_map=*/false);
+}
+
+std::shared_ptr<arrow::Table> ReadParquetTable(const std::string& path)
+{
+    PARQUET_ASSIGN_OR_THROW(auto infile, arrow::io::ReadableFile::Open(path));
+    PARQUET_ASSIGN_OR_THROW(auto reader, parquet::arrow::OpenFile(infile, arrow::default_memory_pool()));
+    PARQUET_ASSIGN_OR_THROW(auto table, reader->ReadTable());
+    return table;
+}
+
+} // namespace
+
+/// @brief Row groups follow the configured size and carry ts/step_seq min/max for pushdown.
+TEST(ParquetSinkTests, RowGroupsCarryTimeAndStepStatistics) {
+    using FileLogger::FeatherV2::MarketEventRecord;
+    namespace MarketEvent = FileLogger::FeatherV2::MarketEvent;
+    constexpr uint64_t kSteps = 2500;
+    const ScopedTestLogDir dir;
+    const QTrading::Dto::Trading::SymbolId symbols[] = {
+        QTrading::Dto::Trading::SymbolTable::Intern("BTCUSDT"),
+        QTrading::Dto::Trading::SymbolTable::Intern("ETHUSDT"),
+    };
+
+    FileLogger::ParquetSinkOptions options;
+    options.row_group_rows = 1000;
+    options.batch_rows = 300;
+    FileLogger::ParquetSink sink(dir.path, options);
+    sink.RegisterModule(1, "Step", StepSchema(), SerializeStep);
+    sink.RegisterModule(2, "Market", MarketEvent::Schema(), MarketEvent::RecordSerializer);
+    sink.RegisterRecordBatchSerializer(2, MarketEvent::RecordBatchSerializer);
+
+    LogRecordRing ring(sizeof(MarketEventRecord), kSteps * 2);
+    for (uint64_t step = 0; step < kSteps; ++step) {
+        sink.WriteRow(Row{ 1, 1000 + step, MakePayload<StepLog>(StepLog{ step, static_cast<double>(step) * 0.5 }) });
+        for (const auto symbol : symbols) {
+            ASSERT_TRUE(ring.TryWrite<MarketEventRecord>(1000 + step, [&](MarketEventRecord& e) {
+                e.step_seq = step;
+                e.symbol_id = symbol;
+                e.close = static_cast<double>(step);
+            }, [] { return false; }));
+        }
+    }
+    ring.Drain(2, [&](const LogRecordSpan& span) { sink.WriteRecords(span); });
+    sink.Flush();
+    sink.Close();
+
+    auto step_file = OpenParquet(dir.path + "/Step.parquet");
+    const auto step_meta = step_file->metadata();
+    ASSERT_EQ(step_meta->num_rows(), static_cast<int64_t>(kSteps));
+    ASSERT_EQ(step_meta->num_row_groups(), 3);
+    for (int g = 0; g < step_meta->num_row_groups(); ++g) {
+        const auto group = step_meta->RowGroup(g);
+        const int64_t first = g * options.row_group_rows;
+        const int64_t last = first + group->num_rows() - 1;
+        const auto ts = std::static_pointer_cast<parquet::Int64Statistics>(group->ColumnChunk(0)->statistics());
+        const auto step = std::static_pointer_cast<parquet::Int64Statistics>(group->ColumnChunk(1)->statistics());
+        ASSERT_TRUE(ts && ts->HasMinMax());
+        ASSERT_TRUE(step && step->HasMinMax());
+        EXPECT_EQ(ts->min(), 1000 + first);
+        EXPECT_EQ(ts->max(), 1000 + last);
+        EXPECT_EQ(step->min(), first);
+        EXPECT_EQ(step->max(), last);
+        EXPECT_FALSE(group->ColumnChunk(2)->is_stats_set());
+    }
+
+    auto market_file = OpenParquet(dir.path + "/Market.parquet");
+    const auto market_meta = market_file->metadata();
+    ASSERT_EQ(market_meta->num_rows(), static_cast<int64_t>(kSteps * 2));
+    const int symbol_column = market_meta->schema()->ColumnIndex("symbol");
+    ASSERT_GE(symbol_column, 0);
+    for (int g = 0; g < market_meta->num_row_groups(); ++g) {
+        const auto chunk = market_meta->RowGroup(g)->ColumnChunk(symbol_column);
+        EXPECT_TRUE(chunk->has_dictionary_page());
+        EXPECT_FALSE(chunk->is_stats_set());
+    }
+
+    auto market = ReadParquetTable(dir.path + "/Market.parquet");
+    ASSERT_EQ(market->num_rows(), static_cast<int64_t>(kSteps * 2));
+    EXPECT_TRUE(market->schema()->GetFieldByName("ts")->type()->Equals(arrow::uint64()));
+    auto combined = market->CombineChunks();
+    ASSERT_TRUE(combined.ok());
+    auto symbol = std::static_pointer_cast<arrow::StringArray>((*combined)->GetColumnByName("symbol")->chunk(0));
+    auto step_seq = std::static_pointer_cast<arrow::UInt64Array>((*combined)->GetColumnByName("step_seq")->chunk(0));
+    for (int64_t row = 0; row < market->num_rows(); ++row) {
+        EXPECT_EQ(symbol->GetString(row), row % 2 == 0 ? "BTCUSDT" : "ETHUSDT");
+        EXPECT_EQ(step_seq->Value(row), static_cast<uint64_t>(row / 2));
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+#include <string>
+
+/// @brief Output directory private to the running test, removed on both ends.
+/// @details Tests run as separate processes in parallel; the shared "logs" directory of the
+///          fixture can be cleared under a slower test's feet.
+struct ScopedTestLogDir {
+    const std::string path =
+        std::string("logs_") + ::testing::UnitTest::GetInstance()->current_test_info()->name();
+
+    ScopedTestLogDir() { boost::filesystem::remove_all(path); }
+    ~ScopedTestLogDir() { boost::filesystem::remove_all(path); }
+};
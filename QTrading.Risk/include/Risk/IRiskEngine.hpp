@@ -4,6 +4,9 @@
 #include "RiskTarget.hpp"
 #include "Intent/TradeIntent.hpp"
 
+#include <string>
+#include <string_view>
+
 namespace QTrading::Risk {
 
 /// @brief Interface for converting intents into risk-sized targets.
@@ -16,6 +19,20 @@ public:
     virtual RiskTarget position(const QTrading::Intent::TradeIntent& intent,
         const AccountState& account,
         const TMarket& market) = 0;
+    /// @brief Replaces `out` with the sizing state carried across bars, for strategy checkpoints;
+    ///        false (the default) when the engine cannot be checkpointed.
+    virtual bool save_state(std::string& out) const
+    {
+        (void)out;
+        return false;
+    }
+    /// @brief Restores state written by `save_state`; false (the default) when not supported.
+    ///        Throws std::runtime_error on malformed state.
+    virtual bool restore_state(std::string_view in)
+    {
+        (void)in;
+        return false;
+    }
 };
 
 /// @brief No-op risk engine returning empty targets.
@@ -4,6 +4,7 @@
 #include <memory>
 #include <deque>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include "IRiskEngine.hpp"
 #include "Dto/Market/Binance/MultiKline.hpp"
@@ -183,12 +184,17 @@ public:
     virtual RiskTarget position(const QTrading::Intent::TradeIntent& intent,
         const AccountState& account,
         const std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>& market) override;
+    /// @brief Basis overlay, auto-notional EMA and boost-regime funding history.
+    bool save_state(std::string& out) const override;
+    bool restore_state(std::string_view in) override;
 
 private:
     bool is_spot_instrument_(const std::string& instrument) const;
     bool is_perp_instrument_(const std::string& instrument) const;
     double leverage_for_instrument_(const std::string& instrument) const;
     double leverage_for_instrument_scaled_(const std::string& instrument, double scale) const;
+    template <typename Io, typename Self>
+    static void transfer_state_(Io& io, Self& self);
 
     Config cfg_;
     QTrading::Dto::Trading::InstrumentRegistry instrument_registry_{};
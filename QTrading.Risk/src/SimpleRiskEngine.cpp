@@ -1,6 +1,7 @@
 #include "Risk/SimpleRiskEngine.hpp"
 
 #include "Contracts/StrategyIdentity.hpp"
+#include "Serialization/StateArchive.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -21,15 +22,11 @@ std::optional<double> GetPriceBySymbol(
         return std::nullopt;
     }
 
-    if (market->symbols && !market->trade_klines_by_id.empty()) {
+    if (market->symbols && market->symbol_count() != 0) {
         const auto& symbols = *market->symbols;
         for (std::size_t i = 0; i < symbols.size(); ++i) {
-            if (symbols[i] == symbol && i < market->trade_klines_by_id.size()) {
-                const auto& opt = market->trade_klines_by_id[i];
-                if (opt.has_value()) {
-                    return opt->ClosePrice;
-                }
-                return std::nullopt;
+            if (symbols[i] == symbol) {
+                return market->trade_close(i);
             }
         }
     }
@@ -52,18 +49,14 @@ std::optional<double> GetReferencePriceBySymbol(
             continue;
         }
 
-        const auto& refs = use_mark_price ? market->mark_klines_by_id : market->index_klines_by_id;
-        if (i >= refs.size()) {
-            return std::nullopt;
-        }
-        const auto& opt = refs[i];
-        if (!opt.has_value()) {
+        const auto close = use_mark_price ? market->mark_close(i) : market->index_close(i);
+        if (!close.has_value()) {
             return std::nullopt;
         }
-        if (!std::isfinite(opt->ClosePrice) || opt->ClosePrice <= 0.0) {
+        if (!std::isfinite(*close) || *close <= 0.0) {
             return std::nullopt;
         }
-        return opt->ClosePrice;
+        return close;
     }
 
     return std::nullopt;
@@ -81,10 +74,7 @@ std::optional<double> GetFundingRateBySymbol(
         if (symbols[i] != symbol) {
             continue;
         }
-        if (i >= market->funding_by_id.size()) {
-            return std::nullopt;
-        }
-        const auto& funding_opt = market->funding_by_id[i];
+        const auto funding_opt = market->funding(i);
         if (!funding_opt.has_value()) {
             return std::nullopt;
         }
@@ -105,14 +95,7 @@ std::optional<QTrading::Dto::Market::Binance::FundingRateDto> GetFundingSnapshot
         if (symbols[i] != symbol) {
             continue;
         }
-        if (i >= market->funding_by_id.size()) {
-            return std::nullopt;
-        }
-        const auto& funding_opt = market->funding_by_id[i];
-        if (!funding_opt.has_value()) {
-            return std::nullopt;
-        }
-        return *funding_opt;
+        return market->funding(i);
     }
     return std::nullopt;
 }
@@ -921,4 +904,31 @@ RiskTarget SimpleRiskEngine::position(const QTrading::Intent::TradeIntent& inten
     return out;
 }
 
+template <typename Io, typename Self>
+void SimpleRiskEngine::transfer_state_(Io& io, Self& e)
+{
+    io(e.basis_level_ema_initialized_, e.basis_level_ema_, e.basis_level_ema_prev_,
+        e.basis_overlay_multiplier_initialized_, e.basis_overlay_multiplier_,
+        e.basis_overlay_last_refresh_ts_, e.neg_basis_scale_active_);
+    io(e.auto_notional_ema_initialized_, e.auto_notional_ema_);
+    io(e.has_last_boost_regime_funding_time_, e.last_boost_regime_funding_time_,
+        e.boost_regime_funding_sign_history_);
+}
+
+bool SimpleRiskEngine::save_state(std::string& out) const
+{
+    out.clear();
+    QTrading::Utils::Serialization::StateWriter writer(out);
+    transfer_state_(writer, *this);
+    return true;
+}
+
+bool SimpleRiskEngine::restore_state(std::string_view in)
+{
+    QTrading::Utils::Serialization::StateReader reader(in);
+    transfer_state_(reader, *this);
+    reader.finish();
+    return true;
+}
+
 } // namespace QTrading::Risk
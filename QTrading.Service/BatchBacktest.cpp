@@ -0,0 +1,91 @@
+#include "BatchBacktest.hpp"
+
+#include "LoggerBootstrap.hpp"
+#include "ServiceHelpers.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+namespace QTrading::Service {
+
+std::vector<std::filesystem::path> ListStrategyConfigs(const std::filesystem::path& dir)
+{
+    std::vector<std::filesystem::path> out;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".json") {
+            out.push_back(entry.path());
+        }
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+size_t RunBatchBacktest(
+    const BatchBacktestConfig& config,
+    const QTrading::Infra::Exchanges::BinanceSim::Application::BatchReplayRunner& runner)
+{
+    std::mutex output_mutex;
+    const auto run_one = [&](size_t run_index, const auto& batch) -> uint64_t {
+        const auto& config_path = config.strategy_config_paths[run_index];
+        const auto logger_cfg = Helpers::BuildLoggerBootstrapConfig(
+            config.logs_root / config_path.stem(),
+            batch.datasets(),
+            config.strategy_name,
+            config.strategy_version,
+            config.build_strategy_params(config_path));
+        const auto logger_init = QTrading::Log::InitializeFeatherLogger(logger_cfg);
+        auto exchange = batch.make_exchange(logger_init.logger, config.account_init, logger_init.run_id);
+
+        QTrading::Strategy::StrategyModuleConfigs module_configs;
+        QTrading::Strategy::LoadStrategyModuleConfigs(config.profile, config_path, module_configs);
+        auto modules = QTrading::Strategy::BuildStrategyModules(
+            config.profile,
+            exchange,
+            std::move(module_configs),
+            config.instrument_types);
+
+        uint64_t steps = 0;
+        while (!Helpers::StopRequested() && Helpers::StepForStrategy(*exchange, *modules.strategy)) {
+            modules.strategy->RunOneCycle();
+            ++steps;
+        }
+        exchange->close();
+        logger_init.logger->Stop();
+
+        std::lock_guard<std::mutex> lock(output_mutex);
+        std::cerr << "[Service][Batch] finished " << config_path.filename().string()
+                  << " steps=" << steps << " run_dir=" << logger_init.run_dir.string() << std::endl;
+        return steps;
+    };
+
+    const auto results = runner.run(config.strategy_config_paths.size(), run_one, config.max_parallelism);
+
+    size_t failed = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+        std::ostringstream line;
+        line << "[Service][Batch] " << config.strategy_config_paths[i].filename().string()
+             << " steps=" << result.steps
+             << " elapsed_ms=" << result.elapsed_ns / 1'000'000;
+        if (result.error) {
+            ++failed;
+            try {
+                std::rethrow_exception(result.error);
+            }
+            catch (const std::exception& ex) {
+                line << " error=" << ex.what();
+            }
+            catch (...) {
+                line << " error=unknown";
+            }
+        }
+        std::cout << line.str() << std::endl;
+    }
+    return failed;
+}
+
+} // namespace QTrading::Service
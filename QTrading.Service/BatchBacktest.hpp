@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Exchanges/BinanceSimulator/Application/BatchReplayRunner.hpp"
+#include "Strategy/StrategyModuleBuilder.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace QTrading::Service {
+
+struct BatchBacktestConfig {
+    QTrading::Strategy::StrategyProfile profile{ QTrading::Strategy::StrategyProfile::BasisArbitrage };
+    std::string strategy_name;
+    std::string strategy_version;
+    /// One run per config; each run logs under `logs_root / <config stem>`.
+    std::vector<std::filesystem::path> strategy_config_paths;
+    std::filesystem::path logs_root;
+    /// Builds the logged strategy params of the run using `config_path`.
+    std::function<std::string(const std::filesystem::path& config_path)> build_strategy_params;
+    QTrading::Infra::Exchanges::BinanceSim::Account::AccountInitConfig account_init{};
+    std::unordered_map<std::string, QTrading::Dto::Trading::InstrumentType> instrument_types;
+    /// Concurrent runs; 0 = one per core.
+    size_t max_parallelism{ 0 };
+};
+
+/// Sorted `*.json` files directly under `dir`.
+std::vector<std::filesystem::path> ListStrategyConfigs(const std::filesystem::path& dir);
+
+/// Runs every config over the runner's shared datasets and prints one summary line per run.
+/// @return Number of failed runs.
+size_t RunBatchBacktest(
+    const BatchBacktestConfig& config,
+    const QTrading::Infra::Exchanges::BinanceSim::Application::BatchReplayRunner& runner);
+
+} // namespace QTrading::Service
@@ -1,10 +1,12 @@
 #include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
 #include "LoggerBootstrap.hpp"
+#include "BatchBacktest.hpp"
 #include "DatasetUniverseConfig.hpp"
 #include "ServiceHelpers.hpp"
 #include "Diagnostics/Trace.hpp"
 #include "Strategy/StrategyModuleBuilder.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <ctime>
@@ -61,6 +63,12 @@ int main()
             !kLocalSimEndDate.empty()) {
             QTrading::Service::Helpers::SetEnvVar("QTR_SIM_END_DATE", std::string(kLocalSimEndDate));
         }
+        // Binary kline/funding cache: first run parses CSV, later runs memory-map the cache.
+        // Set QTR_DATA_CACHE_DIR to relocate it.
+        constexpr std::string_view kLocalDataCacheDir = "cache/market_data";
+        if (std::getenv("QTR_DATA_CACHE_DIR") == nullptr && !kLocalDataCacheDir.empty()) {
+            QTrading::Service::Helpers::SetEnvVar("QTR_DATA_CACHE_DIR", std::string(kLocalDataCacheDir));
+        }
 
         const std::string sim_start_date = (std::getenv("QTR_SIM_START_DATE") != nullptr)
             ? std::string(std::getenv("QTR_SIM_START_DATE"))
@@ -93,19 +101,22 @@ int main()
         const auto simulator_config =
             QTrading::Service::LoadSimulatorConfig(simulator_config_path);
 
-        std::ostringstream strategy_params_builder;
-        strategy_params_builder << "strategy_profile=" << strategy_meta.strategy_profile_param
-                                << ";initial_spot_cash=" << kInitialSpotCash
-                                << ";initial_perp_wallet=" << kInitialPerpWallet;
-        strategy_params_builder << ";strategy_config=" << strategy_config_path.string();
-        strategy_params_builder << ";simulator_config=" << simulator_config_path.string();
-        if (!sim_start_date.empty()) {
-            strategy_params_builder << ";sim_start_date=" << sim_start_date;
-        }
-        if (!sim_end_date.empty()) {
-            strategy_params_builder << ";sim_end_date=" << sim_end_date;
-        }
-        const std::string strategy_params = strategy_params_builder.str();
+        const auto build_strategy_params = [&](const std::filesystem::path& config_path) {
+            std::ostringstream strategy_params_builder;
+            strategy_params_builder << "strategy_profile=" << strategy_meta.strategy_profile_param
+                                    << ";initial_spot_cash=" << kInitialSpotCash
+                                    << ";initial_perp_wallet=" << kInitialPerpWallet;
+            strategy_params_builder << ";strategy_config=" << config_path.string();
+            strategy_params_builder << ";simulator_config=" << simulator_config_path.string();
+            if (!sim_start_date.empty()) {
+                strategy_params_builder << ";sim_start_date=" << sim_start_date;
+            }
+            if (!sim_end_date.empty()) {
+                strategy_params_builder << ";sim_end_date=" << sim_end_date;
+            }
+            return strategy_params_builder.str();
+        };
+        const std::string strategy_params = build_strategy_params(strategy_config_path);
 
         std::vector<BinanceExchange::SymbolDataset> symbolCsv =
             QTrading::Service::BuildSymbolDatasets(simulator_config.symbols);
@@ -117,7 +128,48 @@ int main()
             }
         }
 
+        // 0 = one loader thread per core; raise it for high-latency (NAS) dataset shares.
+        constexpr size_t kDatasetLoadParallelism = 0;
+        BinanceExchange::DatasetLoadOptions load_options{};
+        load_options.max_parallelism = kDatasetLoadParallelism;
+        // Bounds resident bars while replaying memory-mapped (cached) datasets.
+        constexpr size_t kReplayChunkBudgetBytes = size_t{ 256 } << 20;
+        load_options.replay_chunk_budget_bytes = kReplayChunkBudgetBytes;
+        load_options.on_progress = [](const QTrading::Infra::Exchanges::BinanceSim::Bootstrap::DatasetLoadProgress& p) {
+            if (p.completed_files == p.total_files || p.completed_files % 16 == 0) {
+                std::cerr << "[Service] loaded " << p.completed_files << "/" << p.total_files
+                          << " dataset files" << std::endl;
+            }
+        };
+
         std::filesystem::path logs_root = "logs";
+
+        // Parameter sweep: QTR_BATCH_CONFIG_DIR holds one strategy config per run. Datasets load
+        // once and every config replays them concurrently with its own account and log directory.
+        if (const char* batch_dir = std::getenv("QTR_BATCH_CONFIG_DIR");
+            batch_dir != nullptr && batch_dir[0] != '\0') {
+            QTrading::Service::BatchBacktestConfig batch{};
+            batch.profile = kStrategyProfile;
+            batch.strategy_name = strategy_name;
+            batch.strategy_version = "0.1";
+            batch.strategy_config_paths = QTrading::Service::ListStrategyConfigs(batch_dir);
+            batch.logs_root = logs_root / "batch";
+            batch.build_strategy_params = build_strategy_params;
+            batch.account_init = account_init;
+            batch.instrument_types = instrument_types;
+            if (const char* parallelism = std::getenv("QTR_BATCH_PARALLELISM"); parallelism != nullptr) {
+                batch.max_parallelism = static_cast<size_t>(std::strtoull(parallelism, nullptr, 10));
+            }
+            std::cerr << "[Service] batch of " << batch.strategy_config_paths.size()
+                      << " configs from " << batch_dir << ", loading datasets once..." << std::endl;
+            const QTrading::Infra::Exchanges::BinanceSim::Application::BatchReplayRunner runner(
+                symbolCsv, load_options);
+            const size_t failed = QTrading::Service::RunBatchBacktest(batch, runner);
+            std::cout << "Batch completed: " << (batch.strategy_config_paths.size() - failed)
+                      << " ok, " << failed << " failed." << std::endl;
+            return failed == 0 ? 0 : 1;
+        }
+
         const auto logger_cfg = QTrading::Service::Helpers::BuildLoggerBootstrapConfig(
             logs_root,
             symbolCsv,
@@ -132,7 +184,7 @@ int main()
         std::cerr.flush();
         // @brief Exchange simulator providing 1-minute MultiKlineDto.
         auto exchange = std::make_shared<QTrading::Infra::Exchanges::BinanceSim::BinanceExchange>(
-            symbolCsv, logger, account_init, run_id);
+            symbolCsv, logger, account_init, run_id, load_options);
         std::cerr << "[Service] exchange constructed" << std::endl;
         std::cerr.flush();
 
@@ -148,6 +200,32 @@ int main()
             std::move(module_configs),
             instrument_types);
 
+        // Crash/stop recovery: QTR_CHECKPOINT_PATH enables periodic checkpoints; an existing
+        // checkpoint is resumed on start and removed once the replay completes.
+        std::filesystem::path checkpoint_path;
+        uint64_t checkpoint_interval_steps = 43'200;
+        if (const char* env_checkpoint = std::getenv("QTR_CHECKPOINT_PATH");
+            env_checkpoint != nullptr && env_checkpoint[0] != '\0') {
+            checkpoint_path = env_checkpoint;
+            if (const char* interval = std::getenv("QTR_CHECKPOINT_INTERVAL_STEPS"); interval != nullptr) {
+                checkpoint_interval_steps = std::max<uint64_t>(1, std::strtoull(interval, nullptr, 10));
+            }
+            if (QTrading::Service::Helpers::RestoreCheckpointFile(checkpoint_path, *exchange, *modules.strategy)) {
+                std::cerr << "[Service] resumed from checkpoint " << checkpoint_path.string() << std::endl;
+            }
+        }
+
+        // QTR_PIPELINED_STEP=1 overlaps replay assembly of the next step with the strategy cycle.
+        // Checkpoints need a resting replay position, so they take precedence.
+        const char* env_pipelined = std::getenv("QTR_PIPELINED_STEP");
+        const bool pipelined_step = env_pipelined != nullptr && std::string(env_pipelined) == "1" &&
+            checkpoint_path.empty();
+        const auto step_for_strategy = [&]() {
+            return pipelined_step
+                ? QTrading::Service::Helpers::StepForStrategyPipelined(*exchange, *modules.strategy)
+                : QTrading::Service::Helpers::StepForStrategy(*exchange, *modules.strategy);
+        };
+
         std::cerr << "[Service] entering main loop..." << std::endl;
         std::cerr.flush();
 
@@ -167,7 +245,7 @@ int main()
         };
 
         // @brief Main simulation loop: advance exchange until no more data.
-        while (exchange->step()) {
+        while (step_for_strategy()) {
             if (QTrading::Service::Helpers::StopRequested()) {
                 if (!stop_logged) {
                     stop_logged = true;
@@ -186,6 +264,10 @@ int main()
             modules.strategy->RunOneCycle();
 
             ++steps;
+            if (!checkpoint_path.empty() &&
+                (steps % checkpoint_interval_steps == 0 || QTrading::Service::Helpers::StopRequested())) {
+                QTrading::Service::Helpers::WriteCheckpointFile(checkpoint_path, *exchange, *modules.strategy);
+            }
 
             // Lightweight progress heartbeat every ~2s to help spot freezes.
             auto now = std::chrono::steady_clock::now();
@@ -200,6 +282,10 @@ int main()
             }
         }
         if (!QTrading::Service::Helpers::StopRequested()) {
+            if (!checkpoint_path.empty()) {
+                std::error_code ec;
+                std::filesystem::remove(checkpoint_path, ec);
+            }
 #if defined(QTRADING_TRACE) && !defined(QTRADING_TRACE_VERBOSE)
             QTrading::Service::Helpers::EmitExchangeStatusLine(exchange);
 #else
@@ -5,9 +5,11 @@
 #include <csignal>
 #include <cmath>
 #include <cstdlib>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 
 namespace QTrading::Service::Helpers {
 
@@ -195,4 +197,77 @@ void EmitExchangeStatusLine(
     std::cout << oss.str() << std::endl;
 }
 
+bool StepForStrategy(
+    QTrading::Infra::Exchanges::BinanceSim::BinanceExchange& exchange,
+    const QTrading::Strategy::IStrategyRuntime& strategy)
+{
+    QTrading::Infra::Exchanges::BinanceSim::BinanceExchange::WakeCondition wake;
+    if (strategy.NextWakeCondition(wake)) {
+        return exchange.step_until(wake);
+    }
+    return exchange.step();
+}
+
+bool StepForStrategyPipelined(
+    QTrading::Infra::Exchanges::BinanceSim::BinanceExchange& exchange,
+    const QTrading::Strategy::IStrategyRuntime& strategy)
+{
+    QTrading::Infra::Exchanges::BinanceSim::BinanceExchange::WakeCondition wake;
+    if (strategy.NextWakeCondition(wake)) {
+        return exchange.step_until(wake);
+    }
+    if (!exchange.step()) {
+        return false;
+    }
+    exchange.prefetch_next_step();
+    return true;
+}
+
+void WriteCheckpointFile(
+    const std::filesystem::path& path,
+    const QTrading::Infra::Exchanges::BinanceSim::BinanceExchange& exchange,
+    const QTrading::Strategy::IStrategyRuntime& strategy)
+{
+    // A checkpoint without strategy state cannot be resumed, so none is written.
+    std::string strategy_state;
+    if (!strategy.SaveCheckpoint(strategy_state) || strategy_state.empty()) {
+        throw std::runtime_error("Strategy cannot save checkpoint state: " + path.string());
+    }
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+    {
+        std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("Cannot open checkpoint file: " + tmp_path.string());
+        }
+        exchange.save_checkpoint(out, strategy_state);
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Failed to write checkpoint file: " + tmp_path.string());
+        }
+    }
+    std::filesystem::rename(tmp_path, path);
+}
+
+bool RestoreCheckpointFile(
+    const std::filesystem::path& path,
+    QTrading::Infra::Exchanges::BinanceSim::BinanceExchange& exchange,
+    QTrading::Strategy::IStrategyRuntime& strategy)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    const std::string strategy_state = exchange.restore_checkpoint(in);
+    // Resuming the account with a strategy reset to its initial state would diverge from the
+    // uninterrupted run, so a checkpoint without strategy state is refused.
+    if (strategy_state.empty()) {
+        throw std::runtime_error("Checkpoint carries no strategy state: " + path.string());
+    }
+    if (!strategy.RestoreCheckpoint(strategy_state)) {
+        throw std::runtime_error("Strategy cannot restore checkpoint state: " + path.string());
+    }
+    return true;
+}
+
 } // namespace QTrading::Service::Helpers
@@ -3,6 +3,7 @@
 #include "Dto/Trading/InstrumentSpec.hpp"
 #include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
 #include "LoggerBootstrap.hpp"
+#include "Strategy/IStrategyRuntime.hpp"
 #include <filesystem>
 #include <memory>
 #include <optional>
@@ -30,5 +31,28 @@ QTrading::Log::LoggerBootstrapConfig BuildLoggerBootstrapConfig(
     const std::string& strategy_params);
 void EmitExchangeStatusLine(
     const std::shared_ptr<QTrading::Infra::Exchanges::BinanceSim::BinanceExchange>& exchange);
+/// Advances `exchange` to the next frame `strategy` needs: a fast-forward to its wake
+/// condition when it provides one, otherwise a single step.
+bool StepForStrategy(
+    QTrading::Infra::Exchanges::BinanceSim::BinanceExchange& exchange,
+    const QTrading::Strategy::IStrategyRuntime& strategy);
+/// Pipelined `StepForStrategy`: after a plain step the following replay frame is prefetched,
+/// so its assembly overlaps the strategy's cycle. Wake-driven steps are not prefetched after.
+bool StepForStrategyPipelined(
+    QTrading::Infra::Exchanges::BinanceSim::BinanceExchange& exchange,
+    const QTrading::Strategy::IStrategyRuntime& strategy);
+/// Writes an exchange checkpoint together with the strategy state; throws when the strategy
+/// cannot checkpoint.
+/// The file is replaced atomically so a crash mid-write keeps the previous checkpoint.
+void WriteCheckpointFile(
+    const std::filesystem::path& path,
+    const QTrading::Infra::Exchanges::BinanceSim::BinanceExchange& exchange,
+    const QTrading::Strategy::IStrategyRuntime& strategy);
+/// Resumes `exchange` and `strategy` from `path`; false when no checkpoint exists.
+/// Throws when the checkpoint carries no strategy state or the strategy cannot restore it.
+bool RestoreCheckpointFile(
+    const std::filesystem::path& path,
+    QTrading::Infra::Exchanges::BinanceSim::BinanceExchange& exchange,
+    QTrading::Strategy::IStrategyRuntime& strategy);
 
 } // namespace QTrading::Service::Helpers
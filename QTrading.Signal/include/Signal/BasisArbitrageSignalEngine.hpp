@@ -7,6 +7,8 @@
 #include <cstddef>
 #include <deque>
 #include <optional>
+#include <string>
+#include <string_view>
 
 namespace QTrading::Signal {
 
@@ -22,6 +24,9 @@ public:
 
     SignalDecision on_market(
         const std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>& market) override;
+    /// @brief Rolling basis/close windows, alpha EMAs and mean-reversion activity.
+    bool save_state(std::string& out) const override;
+    bool restore_state(std::string_view in) override;
 
 private:
     Config cfg_;
@@ -41,6 +46,8 @@ private:
 
     bool ResolveSymbolIds(const std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>& market);
     std::optional<double> ComputeBasisPct(const std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>& market, bool use_mark_index);
+    template <typename Io, typename Self>
+    static void TransferState(Io& io, Self& self);
 };
 
 } // namespace QTrading::Signal
@@ -6,6 +6,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include "ISignalEngine.hpp"
 #include "Dto/Market/Binance/MultiKline.hpp"
 
@@ -252,6 +253,11 @@ public:
         double basis_cost_common_move_penalty_full_pct = 0.08;
         /// @brief Minimum multiplier applied under full common-move penalty pressure.
         double basis_cost_common_move_penalty_min_scale = 0.20;
+        /// @brief Let an inactive funding carry signal report its next wake (settlement, cooldown
+        ///        end, basis band) so a flat runtime can fast-forward the replay. Skipped bars do
+        ///        not feed the per-bar funding EMA or basis histories, so results may differ from
+        ///        stepping every bar; off by default.
+        bool idle_fast_forward_enabled = false;
     };
 
     explicit FundingCarrySignalEngine(Config cfg);
@@ -259,6 +265,13 @@ public:
     /// @brief Update signal based on latest market snapshot.
     virtual SignalDecision on_market(
         const std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>& market) override;
+    /// @brief While inactive: the next funding settlement, the end of a cooldown or re-entry
+    ///        block, and spot/perp closes that bring basis back inside the entry band.
+    ///        False unless `idle_fast_forward_enabled`, or when the next bar may enter.
+    bool next_wake(QTrading::Infra::Exchanges::BinanceSim::Contracts::WakeCondition& out) const override;
+    /// @brief Activity, streaks, funding/basis histories and adaptive caches.
+    bool save_state(std::string& out) const override;
+    bool restore_state(std::string_view in) override;
 
 private:
     Config cfg_;
@@ -298,8 +311,21 @@ private:
     bool has_last_nowcast_exit_gate_eval_ts_{ false };
     uint64_t last_nowcast_entry_gate_eval_ts_{ 0 };
     uint64_t last_nowcast_exit_gate_eval_ts_{ 0 };
+    /// Entry inputs of the last bar that ended inactive; `idle_bar_valid_` is false otherwise.
+    bool idle_bar_valid_{ false };
+    bool idle_entry_funding_ok_{ false };
+    bool idle_basis_gate_enabled_{ false };
+    double idle_entry_max_basis_pct_{ 1.0 };
+    double idle_basis_pct_{ 0.0 };
+    double idle_spot_close_{ 0.0 };
+    double idle_perp_close_{ 0.0 };
+    uint64_t idle_ts_{ 0 };
+    uint64_t idle_entry_blocked_until_ts_{ 0 };
 
     bool market_has_symbols(const std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>& market);
+    /// Lists the checkpointed fields once for `save_state` (const `Self`) and `restore_state`.
+    template <typename Io, typename Self>
+    static void transfer_state(Io& io, Self& self);
 };
 
 } // namespace QTrading::Signal
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "SignalDecision.hpp"
+#include "Exchanges/BinanceSimulator/Contracts/WakeCondition.hpp"
+
+#include <string>
+#include <string_view>
 
 namespace QTrading::Signal {
 
@@ -12,6 +16,27 @@ public:
     virtual ~ISignalEngine() = default;
     /// @brief Evaluate signal for a market snapshot.
     virtual SignalDecision on_market(const TMarket& market) = 0;
+    /// @brief Market events that can next change an inactive decision, so the replay may skip
+    ///        the frames in between; false (the default) when any frame can.
+    virtual bool next_wake(QTrading::Infra::Exchanges::BinanceSim::Contracts::WakeCondition& out) const
+    {
+        (void)out;
+        return false;
+    }
+    /// @brief Replaces `out` with the state accumulated across bars, for strategy checkpoints;
+    ///        false (the default) when the engine cannot be checkpointed.
+    virtual bool save_state(std::string& out) const
+    {
+        (void)out;
+        return false;
+    }
+    /// @brief Restores state written by `save_state`; false (the default) when not supported.
+    ///        Throws std::runtime_error on malformed state.
+    virtual bool restore_state(std::string_view in)
+    {
+        (void)in;
+        return false;
+    }
 };
 
 /// @brief No-op signal engine returning default decisions.
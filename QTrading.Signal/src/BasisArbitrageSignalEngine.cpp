@@ -1,4 +1,5 @@
 #include "Signal/BasisArbitrageSignalEngine.hpp"
+#include "Serialization/StateArchive.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -201,18 +202,15 @@ SignalDecision BasisArbitrageSignalEngine::on_market(
         return out;
     }
     const double trade_basis_pct = *trade_basis_pct_opt;
-    if (symbol_ids_.spot_id >= market->trade_klines_by_id.size() ||
-        symbol_ids_.perp_id >= market->trade_klines_by_id.size() ||
-        !market->trade_klines_by_id[symbol_ids_.spot_id].has_value() ||
-        !market->trade_klines_by_id[symbol_ids_.perp_id].has_value())
+    const auto spot_trade_close_opt = market->trade_close(symbol_ids_.spot_id);
+    const auto perp_trade_close_opt = market->trade_close(symbol_ids_.perp_id);
+    if (!spot_trade_close_opt.has_value() || !perp_trade_close_opt.has_value())
     {
         out.status = SignalStatus::Inactive;
         return out;
     }
-    const double spot_trade_close =
-        market->trade_klines_by_id[symbol_ids_.spot_id]->ClosePrice;
-    const double perp_trade_close =
-        market->trade_klines_by_id[symbol_ids_.perp_id]->ClosePrice;
+    const double spot_trade_close = *spot_trade_close_opt;
+    const double perp_trade_close = *perp_trade_close_opt;
     PushBounded(
         spot_trade_close_window_,
         spot_trade_close,
@@ -469,10 +467,9 @@ SignalDecision BasisArbitrageSignalEngine::on_market(
             cfg_.basis_cost_trend_penalty_weight * normalized_trend_pressure;
 
         double funding_edge = 0.0;
-        if (cfg_.basis_cost_include_funding &&
-            symbol_ids_.perp_id < market->funding_by_id.size())
+        if (cfg_.basis_cost_include_funding)
         {
-            const auto& funding_opt = market->funding_by_id[symbol_ids_.perp_id];
+            const auto funding_opt = market->funding(symbol_ids_.perp_id);
             if (funding_opt.has_value() && std::isfinite(funding_opt->Rate)) {
                 double funding_capture_scale = 0.0;
                 const double expected_hold_ms =
@@ -662,4 +659,29 @@ std::optional<double> BasisArbitrageSignalEngine::ComputeBasisPct(
     return QTrading::Signal::Support::ComputeBasisPct(market, symbol_ids_, use_mark_index);
 }
 
+// Symbol ids are re-resolved from the market and are not part of the state.
+template <typename Io, typename Self>
+void BasisArbitrageSignalEngine::TransferState(Io& io, Self& e)
+{
+    io(e.basis_window_, e.basis_regime_window_, e.spot_trade_close_window_, e.perp_trade_close_window_);
+    io(e.alpha_ema_initialized_, e.basis_alpha_ema_short_, e.basis_alpha_ema_mid_, e.basis_alpha_ema_long_);
+    io(e.mr_active_, e.mr_entry_streak_, e.mr_exit_streak_, e.mr_last_exit_ts_);
+}
+
+bool BasisArbitrageSignalEngine::save_state(std::string& out) const
+{
+    out.clear();
+    QTrading::Utils::Serialization::StateWriter writer(out);
+    TransferState(writer, *this);
+    return true;
+}
+
+bool BasisArbitrageSignalEngine::restore_state(std::string_view in)
+{
+    QTrading::Utils::Serialization::StateReader reader(in);
+    TransferState(reader, *this);
+    reader.finish();
+    return true;
+}
+
 } // namespace QTrading::Signal
@@ -1,11 +1,13 @@
 #include "Signal/FundingCarrySignalEngine.hpp"
 #include "Signal/PairMarketSignalSupport.hpp"
+#include "Serialization/StateArchive.hpp"
 
 #include <algorithm>
 #include <cmath>
 #include <deque>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace QTrading::Signal {
@@ -353,6 +355,7 @@ SignalDecision FundingCarrySignalEngine::on_market(
     const std::shared_ptr<QTrading::Dto::Market::Binance::MultiKlineDto>& market)
 {
     SignalDecision out;
+    idle_bar_valid_ = false;
     if (!market) {
         return out;
     }
@@ -372,17 +375,11 @@ SignalDecision FundingCarrySignalEngine::on_market(
     std::optional<double> spot_close;
     std::optional<double> perp_close;
     if (has_symbol_ids_ &&
-        spot_id_ < market->trade_klines_by_id.size() &&
-        perp_id_ < market->trade_klines_by_id.size())
+        spot_id_ < market->symbol_count() &&
+        perp_id_ < market->symbol_count())
     {
-        const auto& spot_opt = market->trade_klines_by_id[spot_id_];
-        const auto& perp_opt = market->trade_klines_by_id[perp_id_];
-        if (spot_opt.has_value()) {
-            spot_close = spot_opt->ClosePrice;
-        }
-        if (perp_opt.has_value()) {
-            perp_close = perp_opt->ClosePrice;
-        }
+        spot_close = market->trade_close(spot_id_);
+        perp_close = market->trade_close(perp_id_);
     }
 
     if (!spot_close.has_value() || !perp_close.has_value()) {
@@ -397,16 +394,14 @@ SignalDecision FundingCarrySignalEngine::on_market(
 
     std::optional<double> perp_mark_price;
     std::optional<double> perp_index_price;
-    if (has_symbol_ids_ && perp_id_ < market->mark_klines_by_id.size()) {
-        const auto& mark_opt = market->mark_klines_by_id[perp_id_];
-        if (mark_opt.has_value() && std::isfinite(mark_opt->ClosePrice) && mark_opt->ClosePrice > 0.0) {
-            perp_mark_price = mark_opt->ClosePrice;
+    if (has_symbol_ids_) {
+        const auto mark_close = market->mark_close(perp_id_);
+        if (mark_close.has_value() && std::isfinite(*mark_close) && *mark_close > 0.0) {
+            perp_mark_price = mark_close;
         }
-    }
-    if (has_symbol_ids_ && perp_id_ < market->index_klines_by_id.size()) {
-        const auto& index_opt = market->index_klines_by_id[perp_id_];
-        if (index_opt.has_value() && std::isfinite(index_opt->ClosePrice) && index_opt->ClosePrice > 0.0) {
-            perp_index_price = index_opt->ClosePrice;
+        const auto index_close = market->index_close(perp_id_);
+        if (index_close.has_value() && std::isfinite(*index_close) && *index_close > 0.0) {
+            perp_index_price = index_close;
         }
     }
     std::optional<double> mark_index_bps;
@@ -426,13 +421,12 @@ SignalDecision FundingCarrySignalEngine::on_market(
     const double funding_proxy = basis_pct * kBasisToFundingScale;
     std::optional<double> latest_observed_funding_rate;
     std::optional<uint64_t> latest_observed_funding_time;
-    if (has_symbol_ids_ &&
-        perp_id_ < market->funding_by_id.size() &&
-        market->funding_by_id[perp_id_].has_value())
+    if (has_symbol_ids_)
     {
-        const auto& funding = *market->funding_by_id[perp_id_];
-        latest_observed_funding_rate = funding.Rate;
-        latest_observed_funding_time = funding.FundingTime;
+        if (const auto funding = market->funding(perp_id_)) {
+            latest_observed_funding_rate = funding->Rate;
+            latest_observed_funding_time = funding->FundingTime;
+        }
     }
     bool observed_funding_valid = false;
     bool settlement_advanced = false;
@@ -970,6 +964,19 @@ SignalDecision FundingCarrySignalEngine::on_market(
             active_since_ts_ = out.ts_ms;
             entered_by_watchdog = watchdog_allows_entry && !enter_funding;
         }
+        else {
+            idle_bar_valid_ = true;
+            idle_entry_funding_ok_ = enter_funding || watchdog_allows_entry;
+            idle_basis_gate_enabled_ = enable_basis_gate;
+            idle_entry_max_basis_pct_ = entry_max_basis_pct;
+            idle_basis_pct_ = basis_pct;
+            idle_spot_close_ = *spot_close;
+            idle_perp_close_ = *perp_close;
+            idle_ts_ = out.ts_ms;
+            idle_entry_blocked_until_ts_ = std::max(
+                cooldown_ok ? uint64_t{ 0 } : last_exit_ts_ + cfg_.cooldown_ms,
+                pre_settlement_reentry_ok ? uint64_t{ 0 } : pre_settlement_reentry_block_until_ts_);
+        }
     }
 
     if (observed_funding_valid && settlement_advanced) {
@@ -1031,4 +1038,85 @@ SignalDecision FundingCarrySignalEngine::on_market(
     return out;
 }
 
+bool FundingCarrySignalEngine::next_wake(
+    QTrading::Infra::Exchanges::BinanceSim::Contracts::WakeCondition& out) const
+{
+    if (!cfg_.idle_fast_forward_enabled || !idle_bar_valid_ || active_) {
+        return false;
+    }
+    out = {};
+    // Funding gates, the inactivity watchdog and the settlement-locked EMA move on settlements.
+    out.wake_on_funding = true;
+    if (!idle_entry_funding_ok_) {
+        return true;
+    }
+    if (idle_entry_blocked_until_ts_ > idle_ts_) {
+        out.wake_at_ts = idle_entry_blocked_until_ts_;
+    }
+    const bool basis_out_of_band =
+        idle_basis_gate_enabled_ && std::abs(idle_basis_pct_) > idle_entry_max_basis_pct_;
+    if (basis_out_of_band) {
+        // Either leg alone closing the gap against the other's last close re-arms entry.
+        using QTrading::Infra::Exchanges::BinanceSim::Contracts::PriceWake;
+        const double upper = 1.0 + idle_entry_max_basis_pct_;
+        const double lower = 1.0 - idle_entry_max_basis_pct_;
+        PriceWake perp{ cfg_.perp_symbol };
+        PriceWake spot{ cfg_.spot_symbol };
+        if (idle_basis_pct_ > 0.0) {
+            perp.at_or_below = idle_spot_close_ * upper;
+            spot.at_or_above = idle_perp_close_ / upper;
+        }
+        else {
+            perp.at_or_above = idle_spot_close_ * lower;
+            if (lower > 0.0) {
+                spot.at_or_below = idle_perp_close_ / lower;
+            }
+        }
+        out.price_wakes.push_back(std::move(perp));
+        out.price_wakes.push_back(std::move(spot));
+    }
+    // Otherwise only the mark/index guard, which no wake can watch, held entry back.
+    return out.wake_at_ts.has_value() || basis_out_of_band;
+}
+
+// Symbol ids are re-resolved from the market and are not part of the state.
+template <typename Io, typename Self>
+void FundingCarrySignalEngine::transfer_state(Io& io, Self& e)
+{
+    io(e.active_, e.last_exit_ts_, e.pre_settlement_reentry_block_until_ts_, e.active_since_ts_,
+        e.last_observed_funding_time_, e.has_last_observed_funding_time_,
+        e.funding_proxy_initialized_, e.funding_proxy_ema_);
+    io(e.funding_entry_good_streak_, e.funding_exit_bad_streak_, e.funding_hard_negative_streak_,
+        e.inactive_settlement_streak_);
+    io(e.funding_settlement_history_, e.basis_abs_history_, e.funding_settlement_sign_history_);
+    io(e.adaptive_funding_thresholds_ready_, e.adaptive_funding_entry_min_cached_rate_,
+        e.adaptive_funding_exit_min_cached_rate_, e.adaptive_regime_ready_,
+        e.adaptive_regime_entry_persistence_cached_, e.adaptive_regime_exit_persistence_cached_,
+        e.adaptive_confidence_ready_, e.adaptive_confidence_multiplier_,
+        e.adaptive_structure_ready_, e.adaptive_structure_multiplier_,
+        e.adaptive_basis_thresholds_ready_, e.adaptive_basis_last_refresh_ts_,
+        e.adaptive_basis_entry_max_cached_pct_, e.adaptive_basis_exit_max_cached_pct_);
+    io(e.has_last_nowcast_entry_gate_eval_ts_, e.has_last_nowcast_exit_gate_eval_ts_,
+        e.last_nowcast_entry_gate_eval_ts_, e.last_nowcast_exit_gate_eval_ts_);
+    io(e.idle_bar_valid_, e.idle_entry_funding_ok_, e.idle_basis_gate_enabled_,
+        e.idle_entry_max_basis_pct_, e.idle_basis_pct_, e.idle_spot_close_, e.idle_perp_close_,
+        e.idle_ts_, e.idle_entry_blocked_until_ts_);
+}
+
+bool FundingCarrySignalEngine::save_state(std::string& out) const
+{
+    out.clear();
+    QTrading::Utils::Serialization::StateWriter writer(out);
+    transfer_state(writer, *this);
+    return true;
+}
+
+bool FundingCarrySignalEngine::restore_state(std::string_view in)
+{
+    QTrading::Utils::Serialization::StateReader reader(in);
+    transfer_state(reader, *this);
+    reader.finish();
+    return true;
+}
+
 } // namespace QTrading::Signal
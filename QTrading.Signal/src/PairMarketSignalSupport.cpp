@@ -38,13 +38,7 @@ bool MarketHasTradePair(
     if (!market || !ids.resolved) {
         return false;
     }
-    if (ids.spot_id >= market->trade_klines_by_id.size() ||
-        ids.perp_id >= market->trade_klines_by_id.size()) {
-        return false;
-    }
-
-    return market->trade_klines_by_id[ids.spot_id].has_value() &&
-        market->trade_klines_by_id[ids.perp_id].has_value();
+    return market->has_trade_kline(ids.spot_id) && market->has_trade_kline(ids.perp_id);
 }
 
 std::optional<double> ComputeBasisPct(
@@ -56,29 +50,21 @@ std::optional<double> ComputeBasisPct(
         return std::nullopt;
     }
 
-    if (use_mark_index &&
-        ids.perp_id < market->mark_klines_by_id.size() &&
-        ids.perp_id < market->index_klines_by_id.size())
-    {
-        const auto& mark_opt = market->mark_klines_by_id[ids.perp_id];
-        const auto& index_opt = market->index_klines_by_id[ids.perp_id];
-        if (mark_opt.has_value() && index_opt.has_value() && index_opt->ClosePrice > 0.0) {
-            return (mark_opt->ClosePrice - index_opt->ClosePrice) / index_opt->ClosePrice;
+    if (use_mark_index) {
+        const auto mark_close = market->mark_close(ids.perp_id);
+        const auto index_close = market->index_close(ids.perp_id);
+        if (mark_close.has_value() && index_close.has_value() && *index_close > 0.0) {
+            return (*mark_close - *index_close) / *index_close;
         }
     }
 
-    if (ids.spot_id >= market->trade_klines_by_id.size() ||
-        ids.perp_id >= market->trade_klines_by_id.size()) {
-        return std::nullopt;
-    }
-
-    const auto& spot_opt = market->trade_klines_by_id[ids.spot_id];
-    const auto& perp_opt = market->trade_klines_by_id[ids.perp_id];
-    if (!spot_opt.has_value() || !perp_opt.has_value() || spot_opt->ClosePrice <= 0.0) {
+    const auto spot_close = market->trade_close(ids.spot_id);
+    const auto perp_close = market->trade_close(ids.perp_id);
+    if (!spot_close.has_value() || !perp_close.has_value() || *spot_close <= 0.0) {
         return std::nullopt;
     }
 
-    return (perp_opt->ClosePrice - spot_opt->ClosePrice) / spot_opt->ClosePrice;
+    return (*perp_close - *spot_close) / *spot_close;
 }
 
 } // namespace QTrading::Signal::Support
@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 #include <optional>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 namespace {
@@ -374,3 +376,38 @@ TEST(BasisArbitrageSignalEngineTests, CostAwareGateCanUseFundingCarryAsEdgeBoost
     EXPECT_EQ(allowed.status, QTrading::Signal::SignalStatus::Active);
     EXPECT_GT(allowed.confidence, 0.0);
 }
+
+TEST(BasisArbitrageSignalEngineTests, RestoredStateContinuesTheSameDecisions)
+{
+    QTrading::Signal::BasisArbitrageSignalEngine::Config cfg{};
+    cfg.basis_mr_enabled = true;
+    cfg.basis_mr_use_mark_index = false;
+    cfg.basis_mr_window_bars = 20;
+    cfg.basis_mr_min_samples = 5;
+    cfg.basis_mr_entry_z = 1.0;
+    cfg.basis_mr_exit_z = 0.2;
+    cfg.basis_mr_entry_persistence_bars = 1;
+    cfg.basis_mr_exit_persistence_bars = 1;
+
+    QTrading::Signal::BasisArbitrageSignalEngine engine(cfg);
+    for (unsigned long long i = 0; i < 5; ++i) {
+        (void)engine.on_market(MakeMarket(1000 + i, true, true, 100.0));
+    }
+
+    std::string state;
+    ASSERT_TRUE(engine.save_state(state));
+    QTrading::Signal::BasisArbitrageSignalEngine restored(cfg);
+    ASSERT_TRUE(restored.restore_state(state));
+
+    // The restored engine keeps the warmed window, so it enters together with the original.
+    bool entered = false;
+    for (unsigned long long i = 0; i < 10; ++i) {
+        const auto expected = engine.on_market(MakeMarket(2000 + i, true, true, 103.0));
+        const auto actual = restored.on_market(MakeMarket(2000 + i, true, true, 103.0));
+        EXPECT_EQ(actual.status, expected.status);
+        EXPECT_DOUBLE_EQ(actual.confidence, expected.confidence);
+        entered = entered || actual.status == QTrading::Signal::SignalStatus::Active;
+    }
+    EXPECT_TRUE(entered);
+    EXPECT_THROW(restored.restore_state(state + "x"), std::runtime_error);
+}
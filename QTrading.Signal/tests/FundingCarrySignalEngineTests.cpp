@@ -1,6 +1,8 @@
 #include "Signal/FundingCarrySignalEngine.hpp"
 
 #include <optional>
+#include <stdexcept>
+#include <string>
 #include <gtest/gtest.h>
 
 namespace {
@@ -704,3 +706,106 @@ TEST(FundingCarrySignalEngineTests, AdaptiveStructurePenalizesConfidenceInHostil
     EXPECT_EQ(hostile.status, QTrading::Signal::SignalStatus::Active);
     EXPECT_GT(clean.confidence, hostile.confidence);
 }
+
+TEST(FundingCarrySignalEngineTests, NextWakeIsOptInAndOnlyWhileInactive)
+{
+    QTrading::Signal::FundingCarrySignalEngine::Config cfg{
+        "BTCUSDT_SPOT", "BTCUSDT_PERP", 0.0002, 0.0001, -1.0, 1.0, 1.0, 0
+    };
+    QTrading::Infra::Exchanges::BinanceSim::Contracts::WakeCondition wake;
+
+    QTrading::Signal::FundingCarrySignalEngine disabled(cfg);
+    EXPECT_EQ(disabled.on_market(MakeMarket(1000, true, true, 100.02)).status, QTrading::Signal::SignalStatus::Inactive);
+    EXPECT_FALSE(disabled.next_wake(wake));
+
+    cfg.idle_fast_forward_enabled = true;
+    QTrading::Signal::FundingCarrySignalEngine engine(cfg);
+    EXPECT_FALSE(engine.next_wake(wake));
+    // Funding gate not met: only a settlement can arm entry.
+    EXPECT_EQ(engine.on_market(MakeMarket(1000, true, true, 100.02)).status, QTrading::Signal::SignalStatus::Inactive);
+    ASSERT_TRUE(engine.next_wake(wake));
+    EXPECT_TRUE(wake.wake_on_funding);
+    EXPECT_FALSE(wake.wake_at_ts.has_value());
+    EXPECT_TRUE(wake.price_wakes.empty());
+
+    // A bar without both legs leaves nothing to wake on.
+    (void)engine.on_market(MakeMarket(2000, true, false));
+    EXPECT_FALSE(engine.next_wake(wake));
+
+    QTrading::Signal::FundingCarrySignalEngine::Config always_on{};
+    always_on.idle_fast_forward_enabled = true;
+    QTrading::Signal::FundingCarrySignalEngine active_engine(always_on);
+    EXPECT_EQ(active_engine.on_market(MakeMarket(1000, true, true)).status, QTrading::Signal::SignalStatus::Active);
+    EXPECT_FALSE(active_engine.next_wake(wake));
+}
+
+TEST(FundingCarrySignalEngineTests, NextWakeWatchesBasisBandAndCooldown)
+{
+    QTrading::Signal::FundingCarrySignalEngine::Config cfg{
+        "BTCUSDT_SPOT", "BTCUSDT_PERP", 0.0, 0.0, -1.0, 0.01, 0.02, 5000, 0
+    };
+    cfg.idle_fast_forward_enabled = true;
+    QTrading::Signal::FundingCarrySignalEngine engine(cfg);
+    QTrading::Infra::Exchanges::BinanceSim::Contracts::WakeCondition wake;
+
+    // Basis 5% above the 1% entry band.
+    EXPECT_EQ(engine.on_market(MakeMarket(1000, true, true, 105.0)).status, QTrading::Signal::SignalStatus::Inactive);
+    ASSERT_TRUE(engine.next_wake(wake));
+    EXPECT_TRUE(wake.wake_on_funding);
+    EXPECT_FALSE(wake.wake_at_ts.has_value());
+    ASSERT_EQ(wake.price_wakes.size(), 2u);
+    EXPECT_EQ(wake.price_wakes[0].symbol, "BTCUSDT_PERP");
+    EXPECT_DOUBLE_EQ(wake.price_wakes[0].at_or_below, 101.0);
+    EXPECT_EQ(wake.price_wakes[1].symbol, "BTCUSDT_SPOT");
+    EXPECT_DOUBLE_EQ(wake.price_wakes[1].at_or_above, 105.0 / 1.01);
+
+    // Enter, exit on a basis blowout, then sit out the cooldown inside the band.
+    EXPECT_EQ(engine.on_market(MakeMarket(2000, true, true, 100.5)).status, QTrading::Signal::SignalStatus::Active);
+    EXPECT_EQ(engine.on_market(MakeMarket(3000, true, true, 110.0)).status, QTrading::Signal::SignalStatus::Inactive);
+    EXPECT_EQ(engine.on_market(MakeMarket(4000, true, true, 100.5)).status, QTrading::Signal::SignalStatus::Inactive);
+    ASSERT_TRUE(engine.next_wake(wake));
+    EXPECT_EQ(wake.wake_at_ts, std::optional<uint64_t>(8000));
+    EXPECT_TRUE(wake.price_wakes.empty());
+}
+
+TEST(FundingCarrySignalEngineTests, NextWakeStepsEveryBarWhenOnlyMarkIndexGuardBlocks)
+{
+    QTrading::Signal::FundingCarrySignalEngine::Config cfg{
+        "BTCUSDT_SPOT", "BTCUSDT_PERP", 0.0, 0.0, -1.0, 1.0, 1.0, 0
+    };
+    cfg.mark_index_hard_exit_bps = 150.0;
+    cfg.idle_fast_forward_enabled = true;
+    QTrading::Signal::FundingCarrySignalEngine engine(cfg);
+    QTrading::Infra::Exchanges::BinanceSim::Contracts::WakeCondition wake;
+
+    const auto blocked = engine.on_market(MakeMarket(1000, true, true, 100.5, std::nullopt, std::nullopt, 102.0, 100.0));
+    EXPECT_EQ(blocked.status, QTrading::Signal::SignalStatus::Inactive);
+    EXPECT_FALSE(engine.next_wake(wake));
+}
+
+TEST(FundingCarrySignalEngineTests, RestoredStateKeepsCooldownAndRejectsTruncatedInput)
+{
+    QTrading::Signal::FundingCarrySignalEngine::Config cfg{
+        "BTCUSDT_SPOT", "BTCUSDT_PERP", 0.0, 0.0, -1.0, 0.01, 0.02, 5000, 0
+    };
+    QTrading::Signal::FundingCarrySignalEngine engine(cfg);
+    EXPECT_EQ(engine.on_market(MakeMarket(2000, true, true, 100.5)).status, QTrading::Signal::SignalStatus::Active);
+    EXPECT_EQ(engine.on_market(MakeMarket(3000, true, true, 110.0)).status, QTrading::Signal::SignalStatus::Inactive);
+
+    std::string state;
+    ASSERT_TRUE(engine.save_state(state));
+    QTrading::Signal::FundingCarrySignalEngine restored(cfg);
+    ASSERT_TRUE(restored.restore_state(state));
+    std::string restored_state;
+    ASSERT_TRUE(restored.save_state(restored_state));
+    EXPECT_EQ(restored_state, state);
+
+    // A fresh engine would enter here; the restored one is still cooling down.
+    EXPECT_EQ(QTrading::Signal::FundingCarrySignalEngine(cfg).on_market(MakeMarket(4000, true, true, 100.5)).status,
+        QTrading::Signal::SignalStatus::Active);
+    EXPECT_EQ(restored.on_market(MakeMarket(4000, true, true, 100.5)).status, QTrading::Signal::SignalStatus::Inactive);
+    EXPECT_EQ(restored.on_market(MakeMarket(9000, true, true, 100.5)).status,
+        engine.on_market(MakeMarket(9000, true, true, 100.5)).status);
+
+    EXPECT_THROW(restored.restore_state(std::string_view(state).substr(0, state.size() - 1)), std::runtime_error);
+}
@@ -19,6 +19,7 @@
 #include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
@@ -49,6 +50,11 @@ public:
     ~BasisArbitrageMultiPairRuntime() override;
 
     void RunOneCycle() override;
+    /// Risk, execution engine and scheduler state plus each pair's signal, intent and quality
+    /// state. Pairs are matched by spot symbol; pairs not built yet are restored on the first
+    /// cycle that builds them.
+    bool SaveCheckpoint(std::string& out) const override;
+    bool RestoreCheckpoint(std::string_view in) override;
 
 private:
     struct PairStaticInfo {
@@ -87,6 +93,9 @@ private:
     };
 
     void InitializePairsIfNeeded(const MarketPtr& market);
+    bool SavePairState(std::size_t pair_index, std::string& out) const;
+    void RestorePairState(std::size_t pair_index, std::string_view in);
+    void ApplyPendingPairStates();
     struct PairSignalSnapshot {
         std::size_t pair_index = 0;
         QTrading::Signal::SignalDecision signal;
@@ -145,6 +154,8 @@ private:
     std::vector<PairStaticInfo> pair_static_infos_;
     std::vector<PairRuntimeState> pair_runtime_states_;
     std::unordered_map<std::string, std::size_t> symbol_to_pair_index_;
+    /// Restored pair states keyed by spot symbol, waiting for the pairs to be built.
+    std::unordered_map<std::string, std::string> pending_pair_states_;
     std::vector<PairShard> shards_;
     std::vector<PairSignalSnapshot> ranking_buffer_;
     std::vector<int> active_pair_slots_;
@@ -15,6 +15,8 @@
 #include "Universe/IUniverseSelector.hpp"
 
 #include <memory>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace QTrading::Infra::Exchanges::BinanceSim {
@@ -38,6 +40,13 @@ public:
         std::unordered_map<std::string, QTrading::Dto::Trading::InstrumentType> instrument_types);
 
     void RunOneCycle() override;
+    /// While the book is flat, defers to the signal engine's wake; false otherwise.
+    bool NextWakeCondition(
+        QTrading::Infra::Exchanges::BinanceSim::Contracts::WakeCondition& out) const override;
+    /// Signal, intent, risk, execution engine and scheduler state; false when any of them
+    /// cannot be checkpointed.
+    bool SaveCheckpoint(std::string& out) const override;
+    bool RestoreCheckpoint(std::string_view in) override;
 
 private:
     std::shared_ptr<QTrading::Infra::Exchanges::BinanceSim::BinanceExchange> exchange_;
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <string>
+#include <string_view>
+
+#include "Exchanges/BinanceSimulator/Contracts/WakeCondition.hpp"
+
 namespace QTrading::Strategy {
 
 class IStrategyRuntime {
@@ -7,6 +12,28 @@ public:
     virtual ~IStrategyRuntime() = default;
 
     virtual void RunOneCycle() = 0;
+
+    /// Condition under which the next cycle is worth running while the account is idle;
+    /// false (the default) runs a cycle on every replay frame.
+    virtual bool NextWakeCondition(
+        QTrading::Infra::Exchanges::BinanceSim::Contracts::WakeCondition& out) const
+    {
+        (void)out;
+        return false;
+    }
+
+    /// Serializes runtime state into an exchange checkpoint; false when not supported.
+    virtual bool SaveCheckpoint(std::string& out) const
+    {
+        (void)out;
+        return false;
+    }
+    /// Restores state written by `SaveCheckpoint`; false when not supported.
+    virtual bool RestoreCheckpoint(std::string_view in)
+    {
+        (void)in;
+        return false;
+    }
 };
 
 } // namespace QTrading::Strategy
@@ -1,17 +1,22 @@
 #include "Strategy/BasisArbitrageMultiPairRuntime.hpp"
 
 #include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
+#include "Serialization/StateArchive.hpp"
 #include "Signal/SignalDecision.hpp"
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <limits>
 #include <mutex>
+#include <stdexcept>
 #include <thread>
 #include <unordered_set>
 
 namespace {
 
+// Bumped whenever the component list of the strategy state changes.
+constexpr uint32_t kStrategyStateVersion = 1;
 constexpr double kAllocatorScoreFloor = 1e-12;
 constexpr double kExposureEpsilon = 1e-6;
 
@@ -137,6 +142,16 @@ QTrading::Signal::SignalDecision MakeInactiveBasisSignal(std::uint64_t ts_ms)
     return out;
 }
 
+// The scratch buffer is not state; it is resized to the restored window.
+template <typename Io, typename Quality>
+void TransferQualityState(Io& io, Quality& q)
+{
+    io(q.abs_basis_window, q.quote_ratio_window, q.spot_zero_window, q.next_index, q.sample_count,
+        q.spot_zero_count, q.quote_ratio_sum);
+    io(q.structural_sample_count, q.structural_spot_zero_count, q.structural_abs_basis_sum,
+        q.structural_quote_ratio_sum);
+}
+
 } // namespace
 
 namespace QTrading::Strategy {
@@ -317,9 +332,110 @@ void BasisArbitrageMultiPairRuntime::InitializePairsIfNeeded(const MarketPtr& ma
     ranking_buffer_.reserve(pair_runtime_states_.size());
     active_pair_slots_.assign(pair_runtime_states_.size(), -1);
     active_pair_slot_touched_.reserve(runtime_cfg_.basis_multi_top_n);
+    ApplyPendingPairStates();
     InitializeWorkersIfNeeded();
 }
 
+bool BasisArbitrageMultiPairRuntime::SavePairState(std::size_t pair_index, std::string& out) const
+{
+    const auto& pair = pair_runtime_states_[pair_index];
+    std::string signal_state;
+    std::string intent_state;
+    if (!pair.signal_engine.save_state(signal_state) || !pair.intent_builder.save_state(intent_state)) {
+        return false;
+    }
+    out.clear();
+    QTrading::Utils::Serialization::StateWriter writer(out);
+    writer(signal_state, intent_state);
+    TransferQualityState(writer, pair.quality_state);
+    return true;
+}
+
+void BasisArbitrageMultiPairRuntime::RestorePairState(std::size_t pair_index, std::string_view in)
+{
+    auto& pair = pair_runtime_states_[pair_index];
+    QTrading::Utils::Serialization::StateReader reader(in);
+    std::string signal_state;
+    std::string intent_state;
+    reader(signal_state, intent_state);
+    auto quality = pair.quality_state;
+    TransferQualityState(reader, quality);
+    reader.finish();
+    const std::size_t capacity = quality.abs_basis_window.size();
+    if (quality.quote_ratio_window.size() != capacity ||
+        quality.spot_zero_window.size() != capacity ||
+        quality.sample_count > capacity ||
+        (capacity != 0 && quality.next_index >= capacity)) {
+        throw std::runtime_error("Inconsistent basis quality state for " + pair_static_infos_[pair_index].spot_symbol);
+    }
+    quality.abs_basis_scratch.assign(capacity, 0.0);
+    if (!pair.signal_engine.restore_state(signal_state) || !pair.intent_builder.restore_state(intent_state)) {
+        throw std::runtime_error("Cannot restore basis pair state for " + pair_static_infos_[pair_index].spot_symbol);
+    }
+    pair.quality_state = std::move(quality);
+}
+
+void BasisArbitrageMultiPairRuntime::ApplyPendingPairStates()
+{
+    for (auto& [spot_symbol, state] : pending_pair_states_) {
+        const auto it = symbol_to_pair_index_.find(spot_symbol);
+        if (it == symbol_to_pair_index_.end()) {
+            throw std::runtime_error("Checkpoint state names a pair absent from the market: " + spot_symbol);
+        }
+        RestorePairState(it->second, state);
+    }
+    pending_pair_states_.clear();
+}
+
+bool BasisArbitrageMultiPairRuntime::SaveCheckpoint(std::string& out) const
+{
+    std::string risk_state;
+    std::string execution_state;
+    std::string scheduler_state;
+    if (!risk_engine_.save_state(risk_state) ||
+        !execution_engine_.save_state(execution_state) ||
+        !execution_scheduler_.SaveState(scheduler_state)) {
+        return false;
+    }
+    // Before the first cycle the pairs do not exist yet; carry any still-pending states over.
+    std::unordered_map<std::string, std::string> pair_states = pending_pair_states_;
+    for (std::size_t i = 0; i < pair_runtime_states_.size(); ++i) {
+        if (!SavePairState(i, pair_states[pair_static_infos_[i].spot_symbol])) {
+            return false;
+        }
+    }
+    out.clear();
+    QTrading::Utils::Serialization::StateWriter writer(out);
+    writer(kStrategyStateVersion, risk_state, execution_state, scheduler_state, pair_states);
+    return true;
+}
+
+bool BasisArbitrageMultiPairRuntime::RestoreCheckpoint(std::string_view in)
+{
+    QTrading::Utils::Serialization::StateReader reader(in);
+    uint32_t version = 0;
+    reader(version);
+    if (version != kStrategyStateVersion) {
+        return false;
+    }
+    std::string risk_state;
+    std::string execution_state;
+    std::string scheduler_state;
+    std::unordered_map<std::string, std::string> pair_states;
+    reader(risk_state, execution_state, scheduler_state, pair_states);
+    reader.finish();
+    if (!risk_engine_.restore_state(risk_state) ||
+        !execution_engine_.restore_state(execution_state) ||
+        !execution_scheduler_.RestoreState(scheduler_state)) {
+        return false;
+    }
+    pending_pair_states_ = std::move(pair_states);
+    if (!pair_runtime_states_.empty()) {
+        ApplyPendingPairStates();
+    }
+    return true;
+}
+
 std::vector<BasisArbitrageMultiPairRuntime::PairSignalSnapshot>
 BasisArbitrageMultiPairRuntime::BuildActivePairRanking(const MarketPtr& market)
 {
@@ -678,20 +794,17 @@ void BasisArbitrageMultiPairRuntime::UpdatePairQualityState(
     double quote_ratio = 0.0;
     double abs_basis_pct = 0.0;
 
-    if (pair.spot_market_id < market->trade_klines_by_id.size() &&
-        pair.perp_market_id < market->trade_klines_by_id.size()) {
-        const auto& spot = market->trade_klines_by_id[pair.spot_market_id];
-        const auto& perp = market->trade_klines_by_id[pair.perp_market_id];
-        if (spot.has_value() && perp.has_value() &&
-            spot->ClosePrice > 0.0 && perp->ClosePrice > 0.0) {
-            const double spot_quote_volume = ClampNonNegativeFinite(spot->QuoteVolume);
-            const double perp_quote_volume = ClampNonNegativeFinite(perp->QuoteVolume);
-            spot_zero_volume = !(spot_quote_volume > 0.0);
-            if (perp_quote_volume > 0.0) {
-                quote_ratio = spot_quote_volume / perp_quote_volume;
-            }
-            abs_basis_pct = std::fabs((perp->ClosePrice - spot->ClosePrice) / spot->ClosePrice);
+    const auto spot = market->trade_bar(pair.spot_market_id);
+    const auto perp = market->trade_bar(pair.perp_market_id);
+    if (spot.has_value() && perp.has_value() &&
+        spot->close > 0.0 && perp->close > 0.0) {
+        const double spot_quote_volume = ClampNonNegativeFinite(spot->quote_volume);
+        const double perp_quote_volume = ClampNonNegativeFinite(perp->quote_volume);
+        spot_zero_volume = !(spot_quote_volume > 0.0);
+        if (perp_quote_volume > 0.0) {
+            quote_ratio = spot_quote_volume / perp_quote_volume;
         }
+        abs_basis_pct = std::fabs((perp->close - spot->close) / spot->close);
     }
 
     const std::size_t capacity = quality.abs_basis_window.size();
@@ -837,22 +950,17 @@ double BasisArbitrageMultiPairRuntime::ComputePairLiquidityScale(
     }
 
     const auto& pair = pair_static_infos_[pair_index];
-    if (pair.spot_market_id >= market->trade_klines_by_id.size() ||
-        pair.perp_market_id >= market->trade_klines_by_id.size()) {
-        return 0.0;
-    }
-
-    const auto& spot = market->trade_klines_by_id[pair.spot_market_id];
-    const auto& perp = market->trade_klines_by_id[pair.perp_market_id];
+    const auto spot = market->trade_bar(pair.spot_market_id);
+    const auto perp = market->trade_bar(pair.perp_market_id);
     if (!spot.has_value() || !perp.has_value()) {
         return 0.0;
     }
-    if (!(spot->ClosePrice > 0.0) || !(perp->ClosePrice > 0.0)) {
+    if (!(spot->close > 0.0) || !(perp->close > 0.0)) {
         return 0.0;
     }
 
-    const double spot_quote_volume = std::max(0.0, spot->QuoteVolume);
-    const double perp_quote_volume = std::max(0.0, perp->QuoteVolume);
+    const double spot_quote_volume = std::max(0.0, spot->quote_volume);
+    const double perp_quote_volume = std::max(0.0, perp->quote_volume);
     const double spot_scale =
         RampUp(spot_quote_volume, runtime_cfg_.basis_pair_min_spot_quote_volume);
     const double perp_scale =
@@ -937,10 +1045,11 @@ void BasisArbitrageMultiPairRuntime::NormalizePairTargetsToAvoidSingleLegExposur
     reference_price_by_symbol.reserve(market->symbols->size());
     const auto& symbols = *market->symbols;
     for (std::size_t i = 0; i < symbols.size(); ++i) {
-        if (i >= market->trade_klines_by_id.size() || !market->trade_klines_by_id[i].has_value()) {
+        const auto close = market->trade_close(i);
+        if (!close.has_value()) {
             continue;
         }
-        const double price = market->trade_klines_by_id[i]->ClosePrice;
+        const double price = *close;
         if (price > 0.0) {
             reference_price_by_symbol.emplace(symbols[i], price);
         }
@@ -1033,10 +1142,11 @@ BasisArbitrageMultiPairRuntime::FilterOrdersToAvoidSingleLegExposure(
     reference_price_by_symbol.reserve(market->symbols->size());
     const auto& symbols = *market->symbols;
     for (std::size_t i = 0; i < symbols.size(); ++i) {
-        if (i >= market->trade_klines_by_id.size() || !market->trade_klines_by_id[i].has_value()) {
+        const auto close = market->trade_close(i);
+        if (!close.has_value()) {
             continue;
         }
-        const double price = market->trade_klines_by_id[i]->ClosePrice;
+        const double price = *close;
         if (price > 0.0) {
             reference_price_by_symbol.emplace(symbols[i], price);
         }
@@ -1,10 +1,16 @@
 #include "Strategy/FundingCarryStrategyRuntime.hpp"
 
 #include "Exchanges/BinanceSimulator/BinanceExchange.hpp"
+#include "Serialization/StateArchive.hpp"
 #include "Signal/SignalDecision.hpp"
 
+#include <cstdint>
+
 namespace {
 
+// Bumped whenever the component list below changes.
+constexpr uint32_t kStrategyStateVersion = 1;
+
 QTrading::Execution::ExecutionSignalStatus ToExecutionStatus(
     QTrading::Signal::SignalStatus status)
 {
@@ -93,4 +99,55 @@ void FundingCarryStrategyRuntime::RunOneCycle()
     exchange_gateway_.ApplyMonitoringAlerts(monitoring_.check(account));
 }
 
+bool FundingCarryStrategyRuntime::NextWakeCondition(
+    QTrading::Infra::Exchanges::BinanceSim::Contracts::WakeCondition& out) const
+{
+    if (!exchange_->get_all_positions().empty() || !exchange_->get_all_open_orders().empty()) {
+        return false;
+    }
+    return signal_engine_.next_wake(out);
+}
+
+bool FundingCarryStrategyRuntime::SaveCheckpoint(std::string& out) const
+{
+    std::string signal_state;
+    std::string intent_state;
+    std::string risk_state;
+    std::string execution_state;
+    std::string scheduler_state;
+    if (!signal_engine_.save_state(signal_state) ||
+        !intent_builder_.save_state(intent_state) ||
+        !risk_engine_.save_state(risk_state) ||
+        !execution_engine_.save_state(execution_state) ||
+        !execution_scheduler_.SaveState(scheduler_state)) {
+        return false;
+    }
+    out.clear();
+    QTrading::Utils::Serialization::StateWriter writer(out);
+    writer(kStrategyStateVersion, signal_state, intent_state, risk_state, execution_state, scheduler_state);
+    return true;
+}
+
+bool FundingCarryStrategyRuntime::RestoreCheckpoint(std::string_view in)
+{
+    QTrading::Utils::Serialization::StateReader reader(in);
+    uint32_t version = 0;
+    reader(version);
+    if (version != kStrategyStateVersion) {
+        return false;
+    }
+    std::string signal_state;
+    std::string intent_state;
+    std::string risk_state;
+    std::string execution_state;
+    std::string scheduler_state;
+    reader(signal_state, intent_state, risk_state, execution_state, scheduler_state);
+    reader.finish();
+    return signal_engine_.restore_state(signal_state) &&
+        intent_builder_.restore_state(intent_state) &&
+        risk_engine_.restore_state(risk_state) &&
+        execution_engine_.restore_state(execution_state) &&
+        execution_scheduler_.RestoreState(scheduler_state);
+}
+
 } // namespace QTrading::Strategy
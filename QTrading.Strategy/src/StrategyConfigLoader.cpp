@@ -140,6 +140,7 @@ void ApplySharedStrategyConfigSections(
     ApplyNumber(signal, "pre_settlement_negative_exit_lookahead_ms", configs.signal_cfg.pre_settlement_negative_exit_lookahead_ms);
     ApplyNumber(signal, "pre_settlement_negative_exit_reentry_buffer_ms", configs.signal_cfg.pre_settlement_negative_exit_reentry_buffer_ms);
     ApplyBool(signal, "pre_settlement_negative_exit_require_funding_gate", configs.signal_cfg.pre_settlement_negative_exit_require_funding_gate);
+    ApplyBool(signal, "idle_fast_forward_enabled", configs.signal_cfg.idle_fast_forward_enabled);
 
     const rapidjson::Value* intent = FindObject(doc, "intent");
     ApplyString(intent, "spot_symbol", configs.intent_cfg.spot_symbol);
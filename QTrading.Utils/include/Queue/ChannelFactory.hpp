@@ -4,6 +4,7 @@
 
 #include "BoundedChannel.hpp"
 #include "ChannelOptions.hpp"
+#include "SpscRingChannel.hpp"
 #include "UnboundedChannel.hpp"
 #include "UnboundedMpscChannel.hpp"
 
@@ -19,6 +20,16 @@ namespace QTrading::Utils::Queue {
             return std::make_shared<BoundedChannel<T>>(capacity, policy);
         }
 
+        /// \brief Create a bounded channel managed by std::shared_ptr with options.
+        /// \details A single reader and single writer select the lock-free ring channel.
+        template <typename T>
+        static std::shared_ptr<Channel<T>> CreateBoundedChannel(size_t capacity, OverflowPolicy policy, const ChannelOptions& options) {
+            if (options.single_reader && options.single_writer) {
+                return std::make_shared<SpscRingChannel<T>>(capacity, policy, options.spin_before_park);
+            }
+            return std::make_shared<BoundedChannel<T>>(capacity, policy);
+        }
+
         /// \brief Create an unbounded channel managed by std::shared_ptr.
         template <typename T>
         static std::shared_ptr<Channel<T>> CreateUnboundedChannel() {
@@ -46,6 +57,16 @@ namespace QTrading::Utils::Queue {
             return std::make_unique<BoundedChannel<T>>(capacity, policy);
         }
 
+        /// \brief Create a bounded channel managed by std::unique_ptr with options.
+        /// \details A single reader and single writer select the lock-free ring channel.
+        template <typename T>
+        static std::unique_ptr<Channel<T>> CreateBoundedChannelUnique(size_t capacity, OverflowPolicy policy, const ChannelOptions& options) {
+            if (options.single_reader && options.single_writer) {
+                return std::make_unique<SpscRingChannel<T>>(capacity, policy, options.spin_before_park);
+            }
+            return std::make_unique<BoundedChannel<T>>(capacity, policy);
+        }
+
         /// \brief Create an unbounded channel managed by std::unique_ptr.
         template <typename T>
         static std::unique_ptr<Channel<T>> CreateUnboundedChannelUnique() {
@@ -9,6 +9,7 @@ namespace QTrading::Utils::Queue {
         bool   single_reader = false;   ///< Only one consumer thread.
         bool   single_writer = false;   ///< Only one producer thread.
         size_t block_capacity = 1024;   ///< Block size for chunked queues.
+        size_t spin_before_park = 64;   ///< Lock-free channels: polls before a blocked side parks.
     };
 
 } // namespace QTrading::Utils::Queue
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "BoundedChannel.hpp"
+#include "Channel.hpp"
+#include "SpscRingQueue.hpp"
+
+namespace QTrading::Utils::Queue {
+
+    /// \brief A lock-free bounded channel for exactly one producer and one consumer thread.
+    /// \tparam T Message type; must be default constructible and move assignable.
+    /// \details Send/TryReceive/ReceiveMany never take a lock. A blocked Receive (or a Send under
+    ///          OverflowPolicy::Block) polls `spin_before_park` times, then parks on an atomic wait;
+    ///          the other side only issues a wake-up when someone is parked.
+    template <typename T>
+    class SpscRingChannel : public Channel<T> {
+    public:
+        /// \param capacity Maximum number of messages.
+        /// \param policy Overflow behavior when full.
+        /// \param spin_before_park Polls before a blocked side parks.
+        explicit SpscRingChannel(size_t capacity, OverflowPolicy policy = OverflowPolicy::Block, size_t spin_before_park = 64)
+            : queue_(capacity), policy_(policy), spin_before_park_(spin_before_park) {
+        }
+
+        /// \copydoc Channel::Send
+        bool Send(T value) override {
+            return SendImpl(value, true);
+        }
+
+        /// \copydoc Channel::TrySend
+        bool TrySend(T value) override {
+            return SendImpl(value, false);
+        }
+
+        /// \copydoc Channel::Receive
+        std::optional<T> Receive() override {
+            for (;;) {
+                if (auto v = TryReceive()) {
+                    return v;
+                }
+                if (this->closed_.load(std::memory_order_acquire)) {
+                    // Items published before Close() are still delivered.
+                    return TryReceive();
+                }
+                Park(receiver_parked_, data_epoch_, [this] {
+                    return queue_.HasData() || this->closed_.load(std::memory_order_acquire);
+                    });
+            }
+        }
+
+        /// \copydoc Channel::TryReceive
+        std::optional<T> TryReceive() override {
+            T value{};
+            if (!queue_.TryPop(value)) {
+                return std::nullopt;
+            }
+            Wake(sender_parked_, space_epoch_);
+            return value;
+        }
+
+        /// \copydoc Channel::ReceiveMany
+        std::vector<T> ReceiveMany(size_t max_items) override {
+            std::vector<T> out;
+            out.reserve(max_items);
+            if (queue_.PopMany(max_items, out) > 0) {
+                Wake(sender_parked_, space_epoch_);
+            }
+            return out;
+        }
+
+        /// \copydoc Channel::Close
+        void Close() override {
+            this->closed_.store(true, std::memory_order_release);
+            data_epoch_.fetch_add(1, std::memory_order_release);
+            data_epoch_.notify_all();
+            space_epoch_.fetch_add(1, std::memory_order_release);
+            space_epoch_.notify_all();
+        }
+
+        /// \copydoc Channel::Size
+        size_t Size() const override {
+            return queue_.Size();
+        }
+
+        /// \copydoc Channel::DropCount
+        uint64_t DropCount() const override {
+            return drop_count_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        bool SendImpl(T& value, bool may_block) {
+            for (;;) {
+                if (this->closed_.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                if (queue_.TryPush(value)) {
+                    Wake(receiver_parked_, data_epoch_);
+                    return true;
+                }
+                if (!queue_.Full()) {
+                    // The consumer is still moving the previous occupant of our cell out.
+                    std::this_thread::yield();
+                    continue;
+                }
+                switch (policy_) {
+                case OverflowPolicy::Reject:
+                    drop_count_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                case OverflowPolicy::DropOldest:
+                    if (queue_.DropOldest()) {
+                        drop_count_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    continue;
+                case OverflowPolicy::Block:
+                default:
+                    if (!may_block) {
+                        return false; // would block
+                    }
+                    Park(sender_parked_, space_epoch_, [this] {
+                        return !queue_.Full() || this->closed_.load(std::memory_order_acquire);
+                        });
+                    continue;
+                }
+            }
+        }
+
+        // Polls `ready`, then sleeps on `epoch` until the other side bumps it.
+        template <typename Ready>
+        void Park(std::atomic<bool>& parked, std::atomic<uint32_t>& epoch, Ready&& ready) {
+            for (size_t i = 0; i < spin_before_park_; ++i) {
+                if (ready()) {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+            const uint32_t seen = epoch.load(std::memory_order_acquire);
+            parked.store(true, std::memory_order_relaxed);
+            // Pairs with the fence in Wake(): either we see the new item or the waker sees `parked`.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!ready()) {
+                epoch.wait(seen, std::memory_order_acquire);
+            }
+            parked.store(false, std::memory_order_relaxed);
+        }
+
+        void Wake(std::atomic<bool>& parked, std::atomic<uint32_t>& epoch) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (parked.load(std::memory_order_relaxed)) {
+                epoch.fetch_add(1, std::memory_order_release);
+                epoch.notify_one();
+            }
+        }
+
+        SpscRingQueue<T> queue_;
+        OverflowPolicy policy_;
+        size_t spin_before_park_{ 0 };
+        std::atomic<uint64_t> drop_count_{ 0 };
+        alignas(kQueueCacheLineSize) std::atomic<bool> receiver_parked_{ false };
+        std::atomic<uint32_t> data_epoch_{ 0 };
+        alignas(kQueueCacheLineSize) std::atomic<bool> sender_parked_{ false };
+        std::atomic<uint32_t> space_epoch_{ 0 };
+    };
+
+} // namespace QTrading::Utils::Queue
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace QTrading::Utils::Queue {
+
+    /// \brief Cache line size used to keep producer and consumer indices apart.
+    inline constexpr size_t kQueueCacheLineSize = 64;
+
+    /// \brief Lock-free bounded single-producer, single-consumer ring queue core.
+    /// \details Every cell carries a sequence number, so a cell is reused only after its reader
+    ///          released it. Reads claim cells by CAS on the head index, which also lets the
+    ///          producer evict the oldest item (DropOldest) while the consumer is reading.
+    /// \tparam T Message type; must be default constructible and move assignable.
+    template <typename T>
+    class SpscRingQueue {
+    public:
+        /// \param capacity Maximum number of queued items (at least 1).
+        explicit SpscRingQueue(size_t capacity)
+            : capacity_(capacity == 0 ? 1 : capacity)
+        {
+            // A single-cell ring cannot tell a free cell from a published one; use at least two.
+            size_t slots = 2;
+            while (slots < capacity_) {
+                slots <<= 1;
+            }
+            mask_ = slots - 1;
+            cells_ = std::make_unique<Cell[]>(slots);
+            for (size_t i = 0; i < slots; ++i) {
+                cells_[i].seq.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        size_t capacity() const noexcept { return capacity_; }
+
+        /// \brief Producer only. Moves `value` in unless the queue is full; `value` is untouched on failure.
+        bool TryPush(T& value) {
+            const size_t pos = tail_.load(std::memory_order_relaxed);
+            if (pos - cached_head_ >= capacity_) {
+                cached_head_ = head_.load(std::memory_order_acquire);
+                if (pos - cached_head_ >= capacity_) {
+                    return false;
+                }
+            }
+            Cell& cell = cells_[pos & mask_];
+            if (cell.seq.load(std::memory_order_acquire) != pos) {
+                return false; // the previous occupant is still being read
+            }
+            cell.value = std::move(value);
+            cell.seq.store(pos + 1, std::memory_order_release);
+            tail_.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// \brief Consumer, or the producer evicting. Pops the oldest item into `out`.
+        bool TryPop(T& out) {
+            size_t pos = head_.load(std::memory_order_relaxed);
+            for (;;) {
+                Cell& cell = cells_[pos & mask_];
+                const size_t seq = cell.seq.load(std::memory_order_acquire);
+                if (seq != pos + 1) {
+                    const size_t current = head_.load(std::memory_order_relaxed);
+                    if (current == pos) {
+                        return false; // empty
+                    }
+                    pos = current;
+                    continue;
+                }
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(cell.value);
+                    Release(cell, pos);
+                    return true;
+                }
+            }
+        }
+
+        /// \brief Producer only. Discards the oldest item; false when nothing could be claimed.
+        bool DropOldest() {
+            T discarded{};
+            return TryPop(discarded);
+        }
+
+        /// \brief Consumer only. Claims up to `max_items` ready items with a single CAS.
+        /// \return Number of items appended to `out`.
+        size_t PopMany(size_t max_items, std::vector<T>& out) {
+            size_t pos = head_.load(std::memory_order_relaxed);
+            for (;;) {
+                size_t ready = 0;
+                while (ready < max_items &&
+                    cells_[(pos + ready) & mask_].seq.load(std::memory_order_acquire) == pos + ready + 1) {
+                    ++ready;
+                }
+                if (ready == 0) {
+                    const size_t current = head_.load(std::memory_order_relaxed);
+                    if (current == pos) {
+                        return 0;
+                    }
+                    pos = current;
+                    continue;
+                }
+                if (head_.compare_exchange_strong(pos, pos + ready, std::memory_order_relaxed)) {
+                    for (size_t i = 0; i < ready; ++i) {
+                        Cell& cell = cells_[(pos + i) & mask_];
+                        out.push_back(std::move(cell.value));
+                        Release(cell, pos + i);
+                    }
+                    return ready;
+                }
+            }
+        }
+
+        /// \brief True when `capacity()` items are queued or being read.
+        bool Full() const noexcept {
+            return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire) >= capacity_;
+        }
+
+        /// \brief True when the oldest item is published and unclaimed.
+        bool HasData() const noexcept {
+            const size_t pos = head_.load(std::memory_order_acquire);
+            return cells_[pos & mask_].seq.load(std::memory_order_acquire) == pos + 1;
+        }
+
+        /// \brief Approximate depth; exact when neither side is mid-operation.
+        size_t Size() const noexcept {
+            const size_t head = head_.load(std::memory_order_acquire);
+            const size_t tail = tail_.load(std::memory_order_acquire);
+            return tail > head ? tail - head : 0;
+        }
+
+    private:
+        struct Cell {
+            std::atomic<size_t> seq{ 0 };
+            T value{};
+        };
+
+        // Moved-from values still own resources for some types; reset before handing the cell back.
+        void Release(Cell& cell, size_t pos) {
+            cell.value = T{};
+            cell.seq.store(pos + mask_ + 1, std::memory_order_release);
+        }
+
+        size_t capacity_{ 0 };
+        size_t mask_{ 0 };
+        std::unique_ptr<Cell[]> cells_;
+        alignas(kQueueCacheLineSize) std::atomic<size_t> head_{ 0 };
+        alignas(kQueueCacheLineSize) std::atomic<size_t> tail_{ 0 };
+        size_t cached_head_{ 0 }; ///< Producer-local copy of head_, refreshed when the ring looks full.
+    };
+
+} // namespace QTrading::Utils::Queue
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace QTrading::Utils::Serialization {
+
+namespace Detail {
+
+template <typename T> struct IsSequence : std::false_type {};
+template <typename T, typename A> struct IsSequence<std::vector<T, A>> : std::true_type {};
+template <typename T, typename A> struct IsSequence<std::deque<T, A>> : std::true_type {};
+template <typename T> struct IsUnorderedMap : std::false_type {};
+template <typename K, typename V, typename H, typename E, typename A>
+struct IsUnorderedMap<std::unordered_map<K, V, H, E, A>> : std::true_type {};
+
+template <typename T>
+constexpr bool kIsScalar = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+} // namespace Detail
+
+/// Appends scalars, strings, vectors/deques and unordered maps to a byte string in host
+/// byte order. Map entries are written in key order so equal states produce equal bytes.
+class StateWriter {
+public:
+    explicit StateWriter(std::string& out) : out_(out) {}
+
+    template <typename... Ts>
+    void operator()(const Ts&... values)
+    {
+        (write(values), ...);
+    }
+
+private:
+    template <typename T>
+    void write(const T& v)
+    {
+        if constexpr (Detail::kIsScalar<T>) {
+            out_.append(reinterpret_cast<const char*>(&v), sizeof(T));
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            write(static_cast<uint64_t>(v.size()));
+            out_.append(v);
+        }
+        else if constexpr (Detail::IsSequence<T>::value) {
+            write(static_cast<uint64_t>(v.size()));
+            for (const auto& e : v) {
+                write(e);
+            }
+        }
+        else if constexpr (Detail::IsUnorderedMap<T>::value) {
+            std::vector<const typename T::value_type*> entries;
+            entries.reserve(v.size());
+            for (const auto& entry : v) {
+                entries.push_back(&entry);
+            }
+            std::sort(entries.begin(), entries.end(), [](const auto* a, const auto* b) {
+                return a->first < b->first;
+            });
+            write(static_cast<uint64_t>(entries.size()));
+            for (const auto* entry : entries) {
+                write(entry->first);
+                write(entry->second);
+            }
+        }
+        else {
+            static_assert(sizeof(T) == 0, "StateWriter: unsupported type");
+        }
+    }
+
+    std::string& out_;
+};
+
+/// Reads values written by `StateWriter`; throws std::runtime_error on truncated input.
+class StateReader {
+public:
+    explicit StateReader(std::string_view in) : in_(in) {}
+
+    template <typename... Ts>
+    void operator()(Ts&... values)
+    {
+        (read(values), ...);
+    }
+
+    /// Throws when bytes remain, i.e. the state was written by a different layout.
+    void finish() const
+    {
+        if (!in_.empty()) {
+            throw std::runtime_error("state archive has trailing bytes");
+        }
+    }
+
+private:
+    template <typename T>
+    void read(T& v)
+    {
+        if constexpr (Detail::kIsScalar<T>) {
+            std::memcpy(&v, take(sizeof(T)), sizeof(T));
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            const size_t n = count(1);
+            v.assign(take(n), n);
+        }
+        else if constexpr (Detail::IsSequence<T>::value) {
+            v.clear();
+            v.resize(count(1));
+            for (auto& e : v) {
+                read(e);
+            }
+        }
+        else if constexpr (Detail::IsUnorderedMap<T>::value) {
+            const size_t n = count(1);
+            v.clear();
+            v.reserve(n);
+            for (size_t i = 0; i < n; ++i) {
+                typename T::key_type key{};
+                typename T::mapped_type value{};
+                read(key);
+                read(value);
+                v.emplace(std::move(key), std::move(value));
+            }
+        }
+        else {
+            static_assert(sizeof(T) == 0, "StateReader: unsupported type");
+        }
+    }
+
+    // Bounds element counts so a corrupt length cannot trigger huge allocations.
+    size_t count(size_t min_element_bytes)
+    {
+        uint64_t n = 0;
+        read(n);
+        if (n > in_.size() / min_element_bytes) {
+            throw std::runtime_error("state archive is truncated");
+        }
+        return static_cast<size_t>(n);
+    }
+
+    const char* take(size_t bytes)
+    {
+        if (bytes > in_.size()) {
+            throw std::runtime_error("state archive is truncated");
+        }
+        const char* data = in_.data();
+        in_.remove_prefix(bytes);
+        return data;
+    }
+
+    std::string_view in_;
+};
+
+} // namespace QTrading::Utils::Serialization
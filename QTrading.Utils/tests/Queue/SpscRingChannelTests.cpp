@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include "Queue/ChannelFactory.hpp"
+
+using namespace QTrading::Utils::Queue;
+
+namespace {
+
+    ChannelOptions SpscOptions()
+    {
+        ChannelOptions options;
+        options.single_reader = true;
+        options.single_writer = true;
+        return options;
+    }
+
+} // namespace
+
+/// \brief Single reader and single writer select the lock-free ring channel.
+TEST(SpscRingChannelTest, FactorySelectsRingForSingleReaderAndWriter)
+{
+    auto spsc = ChannelFactory::CreateBoundedChannel<int>(4, OverflowPolicy::Block, SpscOptions());
+    EXPECT_NE(dynamic_cast<SpscRingChannel<int>*>(spsc.get()), nullptr);
+
+    ChannelOptions shared_reader;
+    shared_reader.single_writer = true;
+    auto bounded = ChannelFactory::CreateBoundedChannel<int>(4, OverflowPolicy::Block, shared_reader);
+    EXPECT_NE(dynamic_cast<BoundedChannel<int>*>(bounded.get()), nullptr);
+}
+
+/// \brief Send()/Receive() preserve order and Size() tracks depth.
+TEST(SpscRingChannelTest, BasicSendReceive)
+{
+    auto channel = ChannelFactory::CreateBoundedChannel<int>(5, OverflowPolicy::Block, SpscOptions());
+
+    EXPECT_TRUE(channel->Send(42));
+    EXPECT_TRUE(channel->Send(100));
+    EXPECT_EQ(channel->Size(), 2u);
+
+    auto val1 = channel->Receive();
+    ASSERT_TRUE(val1.has_value());
+    EXPECT_EQ(val1.value(), 42);
+
+    auto val2 = channel->Receive();
+    ASSERT_TRUE(val2.has_value());
+    EXPECT_EQ(val2.value(), 100);
+    EXPECT_EQ(channel->Size(), 0u);
+    EXPECT_FALSE(channel->TryReceive().has_value());
+}
+
+/// \brief Capacity is honored exactly even though the ring rounds its slot count up.
+TEST(SpscRingChannelTest, OverflowPolicyRejectHonorsLogicalCapacity)
+{
+    auto channel = ChannelFactory::CreateBoundedChannel<int>(3, OverflowPolicy::Reject, SpscOptions());
+
+    EXPECT_TRUE(channel->Send(1));
+    EXPECT_TRUE(channel->Send(2));
+    EXPECT_TRUE(channel->Send(3));
+    EXPECT_FALSE(channel->Send(4));
+    EXPECT_EQ(channel->DropCount(), 1u);
+
+    auto val = channel->Receive();
+    ASSERT_TRUE(val.has_value());
+    EXPECT_EQ(val.value(), 1);
+    EXPECT_TRUE(channel->Send(5));
+    EXPECT_EQ(channel->Size(), 3u);
+}
+
+/// \brief DropOldest keeps the newest `capacity` items in order.
+TEST(SpscRingChannelTest, DropOldestKeepsLastN)
+{
+    constexpr int capacity = 8;
+    constexpr int totalSends = 1000;
+    auto channel = ChannelFactory::CreateBoundedChannel<int>(capacity, OverflowPolicy::DropOldest, SpscOptions());
+
+    for (int i = 0; i < totalSends; ++i) {
+        ASSERT_TRUE(channel->Send(i));
+    }
+    EXPECT_EQ(channel->DropCount(), static_cast<uint64_t>(totalSends - capacity));
+
+    auto got = channel->ReceiveMany(100);
+    ASSERT_EQ((int)got.size(), capacity);
+    for (int i = 0; i < capacity; ++i) {
+        EXPECT_EQ(got[i], totalSends - capacity + i);
+    }
+}
+
+/// \brief Popped and evicted items are released, so pooled payloads can be recycled.
+TEST(SpscRingChannelTest, ReleasesPoppedAndEvictedItems)
+{
+    auto channel = ChannelFactory::CreateBoundedChannel<std::shared_ptr<int>>(1, OverflowPolicy::DropOldest, SpscOptions());
+    auto first = std::make_shared<int>(1);
+    auto second = std::make_shared<int>(2);
+
+    EXPECT_TRUE(channel->Send(first));
+    EXPECT_TRUE(channel->Send(second));
+    EXPECT_EQ(first.use_count(), 1);
+
+    auto received = channel->TryReceive();
+    ASSERT_TRUE(received.has_value());
+    received.reset();
+    EXPECT_EQ(second.use_count(), 1);
+}
+
+/// \brief TrySend returns false instead of blocking when full under Block policy.
+TEST(SpscRingChannelTest, TrySendReturnsFalseWhenFullWithBlockPolicy)
+{
+    auto channel = ChannelFactory::CreateBoundedChannel<int>(1, OverflowPolicy::Block, SpscOptions());
+    EXPECT_TRUE(channel->Send(5));
+    EXPECT_FALSE(channel->TrySend(6));
+    EXPECT_EQ(channel->Size(), 1u);
+    EXPECT_EQ(channel->DropCount(), 0u);
+}
+
+/// \brief A blocked Send() parks until the consumer frees a slot.
+TEST(SpscRingChannelTest, OverflowPolicyBlock)
+{
+    auto channel = ChannelFactory::CreateBoundedChannel<int>(1, OverflowPolicy::Block, SpscOptions());
+    EXPECT_TRUE(channel->Send(111));
+
+    std::atomic<bool> send_done{ false };
+    std::thread sender([&]() {
+        EXPECT_TRUE(channel->Send(222));
+        send_done.store(true, std::memory_order_release);
+        });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(send_done.load(std::memory_order_acquire));
+
+    auto val = channel->Receive();
+    ASSERT_TRUE(val.has_value());
+    EXPECT_EQ(val.value(), 111);
+    sender.join();
+
+    auto val2 = channel->Receive();
+    ASSERT_TRUE(val2.has_value());
+    EXPECT_EQ(val2.value(), 222);
+}
+
+/// \brief Queued items survive Close(); a parked Receive() then returns nullopt.
+TEST(SpscRingChannelTest, CloseDrainsThenUnblocksReceive)
+{
+    auto channel = ChannelFactory::CreateBoundedChannel<int>(2, OverflowPolicy::Block, SpscOptions());
+    EXPECT_TRUE(channel->Send(10));
+    channel->Close();
+    EXPECT_FALSE(channel->Send(20));
+
+    auto v1 = channel->Receive();
+    ASSERT_TRUE(v1.has_value());
+    EXPECT_EQ(v1.value(), 10);
+    EXPECT_FALSE(channel->Receive().has_value());
+    EXPECT_TRUE(channel->IsClosed());
+
+    auto open = ChannelFactory::CreateBoundedChannel<int>(2, OverflowPolicy::Block, SpscOptions());
+    std::optional<int> received{ 1 };
+    std::thread consumer([&]() { received = open->Receive(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    open->Close();
+    consumer.join();
+    EXPECT_FALSE(received.has_value());
+}
+
+/// \brief One producer and one consumer thread: nothing lost, nothing reordered.
+TEST(SpscRingChannelTest, ProducerConsumer_NoLoss_InOrder)
+{
+    constexpr int total = 200000;
+    auto channel = ChannelFactory::CreateBoundedChannel<int>(16, OverflowPolicy::Block, SpscOptions());
+
+    std::thread producer([&]() {
+        for (int i = 0; i < total; ++i) {
+            ASSERT_TRUE(channel->Send(i));
+        }
+        channel->Close();
+        });
+
+    int expected = 0;
+    bool in_order = true;
+    while (auto v = channel->Receive()) {
+        in_order = in_order && (*v == expected);
+        ++expected;
+    }
+    producer.join();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_EQ(expected, total);
+}
+
+/// \brief A DropOldest producer racing the consumer never duplicates or reorders items.
+TEST(SpscRingChannelTest, DropOldestUnderContention_StaysOrdered)
+{
+    constexpr int total = 200000;
+    auto channel = ChannelFactory::CreateBoundedChannel<int>(4, OverflowPolicy::DropOldest, SpscOptions());
+
+    std::thread producer([&]() {
+        for (int i = 0; i < total; ++i) {
+            ASSERT_TRUE(channel->Send(i));
+        }
+        channel->Close();
+        });
+
+    int last = -1;
+    uint64_t received = 0;
+    bool increasing = true;
+    while (auto v = channel->Receive()) {
+        increasing = increasing && (*v > last);
+        last = *v;
+        ++received;
+    }
+    producer.join();
+
+    EXPECT_TRUE(increasing);
+    EXPECT_EQ(last, total - 1);
+    EXPECT_EQ(received + channel->DropCount(), static_cast<uint64_t>(total));
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+
+#include "Serialization/StateArchive.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using QTrading::Utils::Serialization::StateReader;
+using QTrading::Utils::Serialization::StateWriter;
+
+TEST(StateArchiveTests, RoundTripsScalarsStringsSequencesAndMaps)
+{
+    const uint64_t ts = 1'700'000'000'000ull;
+    const std::string label = "BTCUSDT_PERP";
+    const std::deque<double> window{ 0.5, -1.25 };
+    const std::vector<unsigned char> flags{ 1, 0, 1 };
+    const std::unordered_map<std::string, double> budget{ { "ETH", 2.0 }, { "BTC", 1.0 } };
+
+    std::string bytes;
+    StateWriter writer(bytes);
+    writer(ts, true, label, window, flags, budget);
+
+    uint64_t ts_out = 0;
+    bool flag_out = false;
+    std::string label_out;
+    std::deque<double> window_out{ 9.0 };
+    std::vector<unsigned char> flags_out;
+    std::unordered_map<std::string, double> budget_out{ { "SOL", 3.0 } };
+    StateReader reader(bytes);
+    reader(ts_out, flag_out, label_out, window_out, flags_out, budget_out);
+    reader.finish();
+
+    EXPECT_EQ(ts_out, ts);
+    EXPECT_TRUE(flag_out);
+    EXPECT_EQ(label_out, label);
+    EXPECT_EQ(window_out, window);
+    EXPECT_EQ(flags_out, flags);
+    EXPECT_EQ(budget_out, budget);
+}
+
+TEST(StateArchiveTests, MapBytesDoNotDependOnInsertionOrder)
+{
+    std::unordered_map<std::string, uint32_t> a;
+    std::unordered_map<std::string, uint32_t> b;
+    for (int i = 0; i < 32; ++i) {
+        a.emplace("S" + std::to_string(i), static_cast<uint32_t>(i));
+        b.emplace("S" + std::to_string(31 - i), static_cast<uint32_t>(31 - i));
+    }
+    std::string bytes_a;
+    std::string bytes_b;
+    StateWriter writer_a(bytes_a);
+    StateWriter writer_b(bytes_b);
+    writer_a(a);
+    writer_b(b);
+    EXPECT_EQ(bytes_a, bytes_b);
+}
+
+TEST(StateArchiveTests, RejectsTruncatedOrTrailingBytes)
+{
+    std::string bytes;
+    StateWriter writer(bytes);
+    writer(std::vector<double>{ 1.0, 2.0 });
+
+    std::vector<double> out;
+    StateReader truncated(std::string_view(bytes).substr(0, bytes.size() - 1));
+    EXPECT_THROW(truncated(out), std::runtime_error);
+
+    // A corrupt count larger than the remaining bytes fails before allocating.
+    std::string huge;
+    StateWriter huge_writer(huge);
+    huge_writer(uint64_t{ 1 } << 40);
+    StateReader oversized(huge);
+    EXPECT_THROW(oversized(out), std::runtime_error);
+
+    const std::string padded = bytes + "x";
+    StateReader trailing(padded);
+    trailing(out);
+    EXPECT_THROW(trailing.finish(), std::runtime_error);
+}